@@ -39,6 +39,10 @@ using uint = unsigned int;
 #define MESH_BUFFER_MAXNUM             100000                    /* @brief Ray Tracing Renderer Maximum mesh desc buffer count.  */
 #define DIRECTIONALLIGHT_BUFFER_MAXNUM 100                       /* @brief Maximum number of Directional lights.                 */
 #define POINTLIGHT_BUFFER_MAXNUM       10000                     /* @brief Maximum number of Point lights.                       */
+#define LIGHT_CLUSTER_X                16                        /* @brief Light cluster grid tiles count in screen x.           */
+#define LIGHT_CLUSTER_Y                9                         /* @brief Light cluster grid tiles count in screen y.           */
+#define LIGHT_CLUSTER_Z                24                        /* @brief Light cluster grid exponential depth slices count.    */
+#define LIGHT_CLUSTER_INDEX_MAXNUM     1048576                   /* @brief Maximum number of light indices of all clusters.      */
 #define MESHLET_NVERTICES              64                        /* @brief Maximum number of Meshlet's nVertices.                */
 #define MESHLET_NPRIMITIVES            124                       /* @brief Maximum number of Meshlet's nPrimitives.              */
 
@@ -175,6 +179,27 @@ struct PointLight
 	float quadratic;           /* @brief Quadratic of PointLight.      */
 };
 
+/**
+* @brief This struct defines a light cluster, a range of light index buffer.
+*/
+struct LightCluster
+{
+	uint  offset;              /* @brief First index in light index buffer. */
+	uint  count;               /* @brief Number of PointLight.              */
+};
+
+/**
+* @brief This struct defines light cluster grid data.
+* Depth slice of view depth z is floor(log(z) * sliceScale - sliceBias).
+*/
+struct LightClusterInfo
+{
+	float sliceScale;          /* @brief Slice scale.                       */
+	float sliceBias;           /* @brief Slice bias.                        */
+	uint  lightCount;          /* @brief Number of PointLight binned.       */
+	uint  indexCount;          /* @brief Number of light indices.           */
+};
+
 /*****************************************************************************************/
 
 
@@ -196,10 +221,21 @@ struct MeshDesc
 	uint64_t primitiveLocationsAddress;       /* @brief Address of the PrimitiveLocationsAddress buffer.  */
 	uint64_t materialParameterAddress;        /* @brief Address of the Material Parameter buffer.         */
 	uint64_t meshletsAddress;                 /* @brief Address of the Meshlet Buffer.                    */
+	uint64_t instancesAddress;                /* @brief Address of the MeshInstances buffer, or 0.        */
 	uint     nMeshlets;                       /* @brief Meshlets Count.                                   */
 	uint     entityID;                        /* @brief EntityId, cast from entt::entity.                 */
 };
 
+/**
+* @brief Mesh Instance Struct, per instance data of an instanced draw.
+*/
+struct MeshInstance
+{
+	uint64_t modelAddress;                    /* @brief Address of the Model Matrix buffer of entity.     */
+	uint     entityID;                        /* @brief EntityId, cast from entt::entity.                 */
+	uint     padding;                         /* @brief Keep stride 16 bytes in c++ and scalar layout.    */
+};
+
 /**
 * @brief Ray Tracing Shader Data Location 0. 
 */
@@ -33,6 +33,14 @@ layout(buffer_reference, scalar, buffer_reference_align = 8) buffer Models
 };
 mat4 model;
 
+/**
+* @brief Mesh Instances Buffer.
+*/
+layout(buffer_reference, scalar, buffer_reference_align = 8) buffer MeshInstances
+{
+    MeshInstance i[];         /* @see MeshInstance. */
+};
+
 /**
 * @brief Positions Buffer.
 */
@@ -144,6 +152,20 @@ void ExplainMeshDesciption(in uint64_t meshDescAddress)
 
 }
 
+/**
+* @brief Explain Mesh Instance of an instanced draw, replace model and entityID.
+* Must be called after ExplainMeshDesciption, does nothing if not instanced.
+* @param[in] instanceIndex Instance index in the draw.
+*/
+void ExplainMeshInstance(in uint instanceIndex)
+{
+    if(desc.instancesAddress == 0) return;
+
+    MeshInstance instance = MeshInstances(desc.instancesAddress).i[instanceIndex];
+    model                 = Models(instance.modelAddress).i[0];
+    desc.entityID         = instance.entityID;
+}
+
 /**
 * @brief Get Vertices from PrimitiveVerteces.
 * @param[in] primitiveID Primitive index.
@@ -43,6 +43,7 @@ struct MaterialParameter
 */
 layout(location = 0) in flat uint primitiveId;         /* @brief Primitive ID.            */
 layout(location = 1) in flat uint meshletId;           /* @brief Meshlet ID.              */
+layout(location = 2) in flat uint instanceId;          /* @brief Instance ID.             */
 
 /*****************************************************************************************/
 
@@ -80,6 +81,7 @@ push;
 void main()
 {
     ExplainMeshDesciption(push.descAddress);
+    ExplainMeshInstance(instanceId);
     Pixel pixel = GetPixelUsingPrimitiveBarycentric(primitiveId, gl_BaryCoordEXT);
 
     uint  primitiveSeed  = primitiveId;
@@ -78,6 +78,25 @@ layout(set = 3, binding = 1, scalar) readonly buffer PLightBuffer
 } 
 pLightBuffer;
 
+/**
+* @brief PointLight Clusters of camera frustum.
+*/
+layout(set = 3, binding = 2, scalar) readonly buffer LightClusterBuffer 
+{
+	LightClusterInfo info;  /* @see LightClusterInfo. */
+	LightCluster     i[];   /* @see LightCluster.     */
+} 
+lightClusterBuffer;
+
+/**
+* @brief PointLight Indices of all Clusters.
+*/
+layout(set = 3, binding = 3, scalar) readonly buffer LightIndexBuffer 
+{
+	uint i[];               /* @brief Index of pLightBuffer. */
+} 
+lightIndexBuffer;
+
 /*****************************************************************************************/
 
 /******************************************Functions**************************************/
@@ -89,6 +108,13 @@ pLightBuffer;
 */
 GBufferPixel GetGBufferPixel();
 
+/**
+* @brief Get the PointLight Cluster of a world position.
+* @param[in] position World position.
+* @return Returns the index of cluster.
+*/
+uint GetLightCluster(in vec3 position);
+
 /*****************************************************************************************/
 
 /**********************************Shader Entry*******************************************/
@@ -102,10 +128,11 @@ void main()
     
     vec3 col = BRDF_Diffuse_Lambert(gbp.albedo) * PI;
     
-    for(int i = 0; i < pLightBuffer.i.length(); i++)
+    LightCluster cluster = lightClusterBuffer.i[GetLightCluster(gbp.position)];
+    
+    for(uint i = 0; i < cluster.count; i++)
     {
-    	PointLight light = pLightBuffer.i[i];
-    	if(light.intensity < -500.0f) break;
+    	PointLight light = pLightBuffer.i[lightIndexBuffer.i[cluster.offset + i]];
     	 
     	vec3 lpos = light.position;
         vec3 L = normalize(lpos - gbp.position);
@@ -142,4 +169,18 @@ GBufferPixel GetGBufferPixel()
 	gbp.position    = subpassLoad(GBuffer[POSITION]).xyz;
 	
 	return gbp;
+}
+
+uint GetLightCluster(in vec3 position)
+{
+	vec3  vpos = (view.view * vec4(position, 1.0f)).xyz;
+	float z    = max(vpos.z, 1.0e-4f);
+	
+	vec2  ndc  = vpos.xy * vec2(view.projection[0][0], view.projection[1][1]) / z;
+	uvec2 tile = uvec2(clamp((ndc * 0.5f + 0.5f) * vec2(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y), vec2(0.0f), vec2(LIGHT_CLUSTER_X - 1, LIGHT_CLUSTER_Y - 1)));
+	
+	LightClusterInfo info = lightClusterBuffer.info;
+	uint slice = uint(clamp(floor(log(z) * info.sliceScale - info.sliceBias), 0.0f, float(LIGHT_CLUSTER_Z - 1)));
+	
+	return (slice * LIGHT_CLUSTER_Y + tile.y) * LIGHT_CLUSTER_X + tile.x;
 }
\ No newline at end of file
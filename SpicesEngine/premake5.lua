@@ -157,6 +157,20 @@ project "SpicesEngine"
 	filter "files:vendor/meshoptimizer/src/**.cpp"
 	flags { "NoPCH" }
 
+	-- BatchMath SSE4.1 kernels use a different instruction set from PreCompiler Header.
+	filter "files:src/Core/Math/BatchMathSSE41.cpp"
+	flags { "NoPCH" }
+	vectorextensions "SSE4.1"
+
+	-- BatchMath AVX2 kernels use a different instruction set from PreCompiler Header.
+	filter "files:src/Core/Math/BatchMathAVX2.cpp"
+	flags { "NoPCH" }
+	vectorextensions "AVX2"
+
+	-- BatchMath AVX2 kernels use FMA, which gcc and clang do not enable with AVX2.
+	filter { "files:src/Core/Math/BatchMathAVX2.cpp", "toolset:gcc or clang" }
+	buildoptions { "-mfma" }
+
 	-- Platform: Windows
 	filter "system:windows"
 		systemversion   "latest"              -- Use Lastest WindowSDK
@@ -17,6 +17,9 @@
 #include "Systems/ResourceSystem.h"
 #include "Systems/SlateSystem.h"
 #include "Core/Thread/ThreadPool.h"
+#include "Core/Library/FileLibrary.h"
+#include "Core/Library/AsyncIOService.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem.h"
 
 namespace Spices {
 
@@ -35,6 +38,11 @@ namespace Spices {
 		ThreadPool::Get()->SetMode(PoolMode::MODE_FIXED);
 		ThreadPool::Get()->Start(4);
 
+		/**
+		* @brief Init AsyncIOService, callbacks run on General ThreadPool.
+		*/
+		AsyncIOService::Get()->Start(2, ThreadPool::Get().get());
+
 		/**
 		* @brief Init all Systems.
 		* @attention SystemManager Class did not Constructor, it returns Null.
@@ -65,6 +73,11 @@ namespace Spices {
 		.PopSystem("RenderSystem")
 		.PopSystem("NativeScriptSystem");
 
+		/**
+		* @brief Stop AsyncIOService before ThreadPool.
+		*/
+		AsyncIOService::Get()->Stop();
+
 		/**
 		* @brief Shutdown Log Class.
 		*/
@@ -83,7 +96,18 @@ namespace Spices {
 		* @brief World OnPreActivate.
 		* @todo Remove.
 		*/
-		FrameInfo::Get().m_World->OnPreActivate();
+		{
+			const uint64_t statCount    = FileLibrary::FileLibrary_StatCount();
+			const uint64_t resolveCount = VirtualFileSystem::GetStats().resolves;
+
+			FrameInfo::Get().m_World->OnPreActivate();
+
+			std::stringstream ss;
+			ss << "World OnPreActivate: " << FileLibrary::FileLibrary_StatCount() - statCount << " file stat calls, " 
+			   << VirtualFileSystem::GetStats().resolves - resolveCount << " vfs resolves.";
+
+			SPICES_CORE_INFO(ss.str());
+		}
 
 		/**
 		* @brief Init Golbal TimeStep Class.
@@ -0,0 +1,224 @@
+/**
+* @file BlockPool.cpp.
+* @brief The block_pool Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "BlockPool.h"
+
+namespace scl {
+
+	namespace {
+
+		/**
+		* @brief Pools a thread caches blocks of at once.
+		*/
+		constexpr size_t thread_cache_slots = 8;
+
+		/**
+		* @brief Pool id counter, 0 means unused cache.
+		*/
+		std::atomic<uint64_t> pool_ids = 1;
+	}
+
+	block_pool::block_pool(
+		size_t block_size      ,
+		size_t block_align     ,
+		size_t blocks_per_page
+	)
+		: block_align_(std::max(block_align, alignof(void*)))
+		, blocks_per_page_(std::max<size_t>(blocks_per_page, batch_size))
+		, id_(pool_ids.fetch_add(1, std::memory_order_relaxed))
+		, epoch_(0)
+		, live_(0)
+	{
+		/**
+		* @brief A free block stores next pointer, blocks are aligned in a page.
+		*/
+		block_size_ = std::max(block_size, sizeof(void*));
+		block_size_ = (block_size_ + block_align_ - 1) / block_align_ * block_align_;
+	}
+
+	block_pool::~block_pool()
+	{
+		release();
+	}
+
+	void* block_pool::allocate()
+	{
+		thread_cache& cache = get_cache();
+
+		if (!cache.head)
+		{
+			refill(cache);
+		}
+
+		void* p    = cache.head;
+		cache.head = next(p);
+		cache.count--;
+
+		live_.fetch_add(1, std::memory_order_relaxed);
+
+		return p;
+	}
+
+	void block_pool::deallocate(void* p)
+	{
+		if (!p) return;
+
+		thread_cache& cache = get_cache();
+
+		next(p)    = cache.head;
+		cache.head = p;
+		cache.count++;
+
+		live_.fetch_sub(1, std::memory_order_relaxed);
+
+		if (cache.count >= 2 * batch_size)
+		{
+			flush(cache);
+		}
+	}
+
+	void block_pool::reset()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		epoch_.fetch_add(1, std::memory_order_release);
+
+		free_list_   = nullptr;
+		page_index_  = 0;
+		page_cursor_ = 0;
+
+		live_.store(0, std::memory_order_relaxed);
+	}
+
+	void block_pool::release()
+	{
+		SPICES_PROFILE_ZONE;
+
+		reset();
+
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		for (std::byte* page : pages_)
+		{
+			::operator delete(page, std::align_val_t(block_align_));
+		}
+
+		pages_.clear();
+	}
+
+	size_t block_pool::capacity() const
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		return pages_.size() * blocks_per_page_;
+	}
+
+	size_t block_pool::page_count() const
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		return pages_.size();
+	}
+
+	block_pool::thread_cache& block_pool::get_cache()
+	{
+		thread_local std::array<thread_cache, thread_cache_slots> caches;
+		thread_local size_t                                       victim = 0;
+
+		const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+
+		thread_cache* cache = nullptr;
+		for (auto& slot : caches)
+		{
+			if (slot.id == id_)
+			{
+				cache = &slot;
+				break;
+			}
+
+			if (!cache && slot.id == 0) cache = &slot;
+		}
+
+		/**
+		* @brief Evict a cache of another pool, its blocks are reclaimed by that pool's reset.
+		*/
+		if (!cache)
+		{
+			cache  = &caches[victim];
+			victim = (victim + 1) % thread_cache_slots;
+		}
+
+		if (cache->id != id_ || cache->epoch != epoch)
+		{
+			*cache = thread_cache{ id_, epoch, nullptr, 0 };
+		}
+
+		return *cache;
+	}
+
+	void block_pool::refill(thread_cache& cache)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		/**
+		* @brief Recycled blocks first.
+		*/
+		while (free_list_ && cache.count < batch_size)
+		{
+			void* p    = free_list_;
+			free_list_ = next(p);
+
+			next(p)    = cache.head;
+			cache.head = p;
+			cache.count++;
+		}
+
+		/**
+		* @brief Then cut blocks from pages, pages are added as needed.
+		*/
+		while (cache.count < batch_size)
+		{
+			if (page_index_ == pages_.size())
+			{
+				pages_.push_back(static_cast<std::byte*>(::operator new(block_size_ * blocks_per_page_, std::align_val_t(block_align_))));
+			}
+
+			void* p = pages_[page_index_] + page_cursor_ * block_size_;
+
+			if (++page_cursor_ == blocks_per_page_)
+			{
+				page_index_++;
+				page_cursor_ = 0;
+			}
+
+			next(p)    = cache.head;
+			cache.head = p;
+			cache.count++;
+		}
+	}
+
+	void block_pool::flush(thread_cache& cache)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(mutex_);
+
+		for (uint32_t i = 0; i < batch_size && cache.head; i++)
+		{
+			void* p    = cache.head;
+			cache.head = next(p);
+			cache.count--;
+
+			next(p)    = free_list_;
+			free_list_ = p;
+		}
+	}
+}
@@ -0,0 +1,320 @@
+/**
+* @file BlockPool.h.
+* @brief The block_pool Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <mutex>
+#include <atomic>
+
+namespace scl {
+
+	/**
+	* @brief Pool of fixed size blocks, used by node based containers.
+	* Blocks are cut from pages and recycled through a free list, each thread keeps a small cache
+	* of free blocks so allocate and deallocate do not lock in most cases.
+	* reset() frees all blocks at once and keeps the pages for reuse.
+	*/
+	class block_pool
+	{
+	public:
+
+		/**
+		* @brief Blocks moved between a thread cache and the shared free list at once.
+		*/
+		static constexpr uint32_t batch_size = 32;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] block_size Bytes of a block.
+		* @param[in] block_align Alignment of a block.
+		* @param[in] blocks_per_page Blocks of a page.
+		*/
+		explicit block_pool(
+			size_t block_size                                 ,
+			size_t block_align     = alignof(std::max_align_t),
+			size_t blocks_per_page = 256
+		);
+
+		/**
+		* @brief Destructor Function.
+		* Frees all pages, blocks must not be used after.
+		*/
+		virtual ~block_pool();
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		block_pool(const block_pool&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		block_pool& operator=(const block_pool&) = delete;
+
+		/**
+		* @brief Allocate a block, thread safe.
+		* @return Returns the block.
+		*/
+		void* allocate();
+
+		/**
+		* @brief Return a block, thread safe.
+		* @param[in] p The block.
+		*/
+		void deallocate(void* p);
+
+		/**
+		* @brief Free all blocks at once, pages are kept.
+		* @attention No thread may use the pool or its blocks during and after reset.
+		*/
+		void reset();
+
+		/**
+		* @brief Free all blocks and pages.
+		* @attention No thread may use the pool or its blocks during and after release.
+		*/
+		void release();
+
+		/**
+		* @brief Get bytes of a block.
+		* @return Returns bytes of a block.
+		*/
+		size_t block_size() const { return block_size_; }
+
+		/**
+		* @brief Get alignment of a block.
+		* @return Returns alignment of a block.
+		*/
+		size_t block_align() const { return block_align_; }
+
+		/**
+		* @brief Get blocks allocated and not returned.
+		* @return Returns blocks count.
+		*/
+		size_t size() const { return live_.load(std::memory_order_relaxed); }
+
+		/**
+		* @brief Get blocks of all pages.
+		* @return Returns blocks count.
+		*/
+		size_t capacity() const;
+
+		/**
+		* @brief Get pages count.
+		* @return Returns pages count.
+		*/
+		size_t page_count() const;
+
+	private:
+
+		/**
+		* @brief Free blocks of a pool owned by a thread.
+		*/
+		struct thread_cache
+		{
+			uint64_t id    = 0;          /* @brief Pool id, 0 if unused.           */
+			uint64_t epoch = 0;          /* @brief Pool epoch when cached.         */
+			void*    head  = nullptr;    /* @brief First free block.               */
+			uint32_t count = 0;          /* @brief Free blocks count.              */
+		};
+
+		/**
+		* @brief Get this thread's cache of this pool.
+		* A cache of another pool or of a previous epoch is dropped, its blocks are reclaimed by reset.
+		* @return Returns the cache.
+		*/
+		thread_cache& get_cache();
+
+		/**
+		* @brief Fill a cache with a batch from free list or pages.
+		* @param[in] cache The cache.
+		*/
+		void refill(thread_cache& cache);
+
+		/**
+		* @brief Move a batch from a cache to free list.
+		* @param[in] cache The cache.
+		*/
+		void flush(thread_cache& cache);
+
+		/**
+		* @brief Next block stored in a free block.
+		* @param[in] p The free block.
+		* @return Returns reference of next block.
+		*/
+		static void*& next(void* p) { return *static_cast<void**>(p); }
+
+	private:
+
+		/**
+		* @brief Bytes of a block.
+		*/
+		size_t block_size_;
+
+		/**
+		* @brief Alignment of a block.
+		*/
+		size_t block_align_;
+
+		/**
+		* @brief Blocks of a page.
+		*/
+		size_t blocks_per_page_;
+
+		/**
+		* @brief Unique id of this pool, keys thread caches.
+		*/
+		uint64_t id_;
+
+		/**
+		* @brief Increased by reset, invalidates all thread caches.
+		*/
+		std::atomic<uint64_t> epoch_;
+
+		/**
+		* @brief Blocks allocated and not returned.
+		*/
+		std::atomic<size_t> live_;
+
+		/**
+		* @brief Mutex of free list and pages.
+		*/
+		mutable std::mutex mutex_;
+
+		/**
+		* @brief Shared free list.
+		*/
+		void* free_list_ = nullptr;
+
+		/**
+		* @brief Pages.
+		*/
+		std::vector<std::byte*> pages_;
+
+		/**
+		* @brief Page blocks are cut from.
+		*/
+		size_t page_index_ = 0;
+
+		/**
+		* @brief Next uncut block in current page.
+		*/
+		size_t page_cursor_ = 0;
+	};
+
+	/**
+	* @brief Standard allocator of single objects from a block_pool.
+	* Arrays and types not fitting the block fall back to operator new.
+	* @tparam T Value type.
+	*/
+	template<typename T>
+	class pool_allocator
+	{
+	public:
+
+		using value_type = T;
+
+		/**
+		* @brief Rebind to another type, used by containers allocating nodes.
+		*/
+		template<typename U>
+		struct rebind
+		{
+			using other = pool_allocator<U>;
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* Use the pool shared by all allocators of T.
+		*/
+		pool_allocator() noexcept : pool_(&shared_pool()) {}
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] pool The pool.
+		*/
+		explicit pool_allocator(block_pool* pool) noexcept : pool_(pool) {}
+
+		/**
+		* @brief Copy Constructor Function from rebind.
+		* @param[in] other Allocator of U.
+		*/
+		template<typename U>
+		pool_allocator(const pool_allocator<U>& other) noexcept : pool_(other.pool()) {}
+
+		/**
+		* @brief Allocate objects.
+		* @param[in] n Objects count.
+		* @return Returns the memory.
+		*/
+		T* allocate(size_t n)
+		{
+			if (use_pool(n)) return static_cast<T*>(pool_->allocate());
+
+			return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+		}
+
+		/**
+		* @brief Deallocate objects.
+		* @param[in] p The memory.
+		* @param[in] n Objects count.
+		*/
+		void deallocate(T* p, size_t n)
+		{
+			if (use_pool(n)) return pool_->deallocate(p);
+
+			::operator delete(p, std::align_val_t(alignof(T)));
+		}
+
+		/**
+		* @brief Get the pool.
+		* @return Returns the pool.
+		*/
+		block_pool* pool() const noexcept { return pool_; }
+
+		/**
+		* @brief Get the pool shared by all allocators of T.
+		* @return Returns the pool.
+		*/
+		static block_pool& shared_pool()
+		{
+			static block_pool pool(sizeof(T), alignof(T));
+			return pool;
+		}
+
+		template<typename U>
+		bool operator==(const pool_allocator<U>& other) const noexcept { return pool_ == other.pool(); }
+
+		template<typename U>
+		bool operator!=(const pool_allocator<U>& other) const noexcept { return pool_ != other.pool(); }
+
+	private:
+
+		/**
+		* @brief Whether n objects are allocated from the pool.
+		* @param[in] n Objects count.
+		* @return Returns true if from the pool.
+		*/
+		bool use_pool(size_t n) const noexcept
+		{
+			return n == 1 && sizeof(T) <= pool_->block_size() && alignof(T) <= pool_->block_align();
+		}
+
+	private:
+
+		/**
+		* @brief The pool.
+		*/
+		block_pool* pool_;
+	};
+}
@@ -9,6 +9,17 @@
 
 namespace scl {
 
+	directed_acyclic_graph::~directed_acyclic_graph()
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (directed_acyclic_node* node : m_OwnedNodes)
+		{
+			std::allocator_traits<node_allocator>::destroy(m_Allocator, node);
+			std::allocator_traits<node_allocator>::deallocate(m_Allocator, node, 1);
+		}
+	}
+
 	void directed_acyclic_graph::add_node(directed_acyclic_node* node)
 	{
 		SPICES_PROFILE_ZONE;
@@ -16,6 +27,19 @@ namespace scl {
 		m_Nodes[node->m_Name] = node;
 	}
 
+	directed_acyclic_node* directed_acyclic_graph::emplace_node(std::string name, std::vector<std::string> dependencies, std::function<void()> func)
+	{
+		SPICES_PROFILE_ZONE;
+
+		directed_acyclic_node* node = std::allocator_traits<node_allocator>::allocate(m_Allocator, 1);
+		std::allocator_traits<node_allocator>::construct(m_Allocator, node, std::move(name), std::move(dependencies), std::move(func));
+
+		m_OwnedNodes.push_back(node);
+		add_node(node);
+
+		return node;
+	}
+
 	void directed_acyclic_graph::execute()
 	{
 		SPICES_PROFILE_ZONE;
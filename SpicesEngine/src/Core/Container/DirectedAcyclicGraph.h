@@ -6,6 +6,7 @@
 
 #pragma once
 #include "Core/Core.h"
+#include "BlockPool.h"
 
 namespace scl {
 
@@ -66,24 +67,56 @@ namespace scl {
 	*/
 	class directed_acyclic_graph
 	{
+	public:
+
+		/**
+		* @brief Allocator of nodes created by emplace_node.
+		*/
+		using node_allocator = pool_allocator<directed_acyclic_node>;
+
 	public:
 
 		/**
 		* @brief Constructor Function.
+		* @param[in] allocator Allocator of nodes created by emplace_node.
 		*/
-		directed_acyclic_graph() = default;
+		explicit directed_acyclic_graph(const node_allocator& allocator = node_allocator())
+			: m_Allocator(allocator)
+		{}
 
 		/**
 		* @brief Destructor Function.
+		* Destroy nodes created by emplace_node.
 		*/
-		virtual ~directed_acyclic_graph() = default;
+		virtual ~directed_acyclic_graph();
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		directed_acyclic_graph(const directed_acyclic_graph&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		directed_acyclic_graph& operator=(const directed_acyclic_graph&) = delete;
 
 		/**
 		* @brief Add a node to this graph.
-		* @param[in] node directed_acyclic_node.
+		* @param[in] node directed_acyclic_node, owned by caller.
 		*/
 		void add_node(directed_acyclic_node* node);
 
+		/**
+		* @brief Create a node owned by this graph and add it.
+		* @param[in] name Node name.
+		* @param[in] dependencies Node dependencies name.
+		* @param[in] func Node function.
+		* @return Returns the node.
+		*/
+		directed_acyclic_node* emplace_node(std::string name, std::vector<std::string> dependencies, std::function<void()> func);
+
 		/**
 		* @brief Execute all node function by order.
 		*/
@@ -106,6 +139,16 @@ namespace scl {
 
 	private:
 
+		/**
+		* @brief Allocator of owned nodes.
+		*/
+		node_allocator m_Allocator;
+
+		/**
+		* @brief Nodes created by emplace_node.
+		*/
+		std::vector<directed_acyclic_node*> m_OwnedNodes;
+
 		/**
 		* @brief Graph Nodes.
 		*/
@@ -21,8 +21,9 @@ namespace scl {
 	* The hyperplane direction is chosen in the following way: it is perpendicular to the axis 
 	* corresponding to the depth of the node (modulo k).
 	* The tree is balanced when constructed with points that are uniformly distributed.
+	* Nodes are allocated by Allocator rebound to Node, e.g. scl::pool_allocator.
 	*/
-	template<uint32_t K>
+	template<uint32_t K, typename Allocator = std::allocator<std::array<float, K>>>
 	class kd_tree
 	{
 	public:
@@ -49,8 +50,9 @@ namespace scl {
 
 			/**
 			* @brief Destructor Function.
+			* Children are destroyed by kd_tree.
 			*/
-			virtual ~Node();
+			virtual ~Node() = default;
 
 			/**
 			* @brief Array to store the coordinates.
@@ -68,8 +70,18 @@ namespace scl {
 			Node* m_Right;
 		};
 
+		/**
+		* @brief Allocator of nodes.
+		*/
+		using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+
 	private:
 
+		/**
+		* @brief Allocator of nodes.
+		*/
+		node_allocator m_Allocator;
+
 		/**
 		* @brief Pointer to the root node of the tree.
 		*/
@@ -82,6 +94,19 @@ namespace scl {
 
 	private:
 
+		/**
+		* @brief Allocate and construct a node, thread safe if allocator is.
+		* @param[in] pt Points.
+		* @return Returns the node.
+		*/
+		Node* create_node(const item& pt);
+
+		/**
+		* @brief Recursive function to destroy and deallocate nodes.
+		* @param[in] node recursive node.
+		*/
+		void destroy_recursive(Node* node);
+
 		/**
 		* @brief Recursive function to insert a point into the kd_tree.
 		* @param[in] node recursive node.
@@ -148,9 +173,11 @@ namespace scl {
 
 		/**
 		* @brief Constructor to initialize the kd_tree with a null root.
+		* @param[in] allocator Allocator of nodes.
 		*/
-		kd_tree()
-			: m_Root(nullptr) 
+		explicit kd_tree(const Allocator& allocator = Allocator())
+			: m_Allocator(allocator)
+			, m_Root(nullptr) 
 			, m_Size(0)
 		{}
 
@@ -228,8 +255,8 @@ namespace scl {
 		size_t size() const { return m_Size.load(); }
 	};
 
-	template<uint32_t K>
-	inline void kd_tree<K>::insert_recursive(
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::insert_recursive(
 		Node*&                             node  , 
 		std::shared_ptr<std::vector<item>> points,
 		int                                depth
@@ -273,7 +300,7 @@ namespace scl {
 		*/
 		if (node == nullptr)
 		{
-			node = new Node((*points)[centerit->second]);
+			node = create_node((*points)[centerit->second]);
 			++m_Size;
 		}
 		else
@@ -307,8 +334,8 @@ namespace scl {
 		insert_recursive(node->m_Right, rightPoints, depth + 1);
 	}
 
-	template<uint32_t K>
-	inline void kd_tree<K>::insert_recursive_async(
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::insert_recursive_async(
 		Node*&                             node       , 
 		std::shared_ptr<std::vector<item>> points     ,
 		Spices::ThreadPool*                threadPool ,
@@ -367,7 +394,7 @@ namespace scl {
 		*/
 		if (node == nullptr)
 		{
-			node = new Node((*points)[centerit->second]);
+			node = create_node((*points)[centerit->second]);
 			++m_Size;
 		}
 		else
@@ -408,8 +435,8 @@ namespace scl {
 		}, centerit->first, centerit->second);
 	}
 
-	template<uint32_t K>
-	inline bool kd_tree<K>::search_recursive(
+	template<uint32_t K, typename Allocator>
+	inline bool kd_tree<K, Allocator>::search_recursive(
 		Node*       node  , 
 		const item& point , 
 		int         depth
@@ -452,8 +479,8 @@ namespace scl {
 		}
 	}
 
-	template<uint32_t K>
-	inline void kd_tree<K>::range_search_recursive(
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::range_search_recursive(
 		Node*              node        , 
 		const item&        point       , 
 		const item&        condition   , 
@@ -518,8 +545,8 @@ namespace scl {
 		}
 	}
 
-	template<uint32_t K>
-	inline void kd_tree<K>::print_recursive(Node* node, int depth) const
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::print_recursive(Node* node, int depth) const
 	{
 		SPICES_PROFILE_ZONE;
 
@@ -554,46 +581,46 @@ namespace scl {
 		print_recursive(node->m_Right, depth + 1);
 	}
 
-	template<uint32_t K>
-	inline kd_tree<K>::Node::~Node()
+	template<uint32_t K, typename Allocator>
+	inline auto kd_tree<K, Allocator>::create_node(const item& pt) -> Node*
 	{
-		SPICES_PROFILE_ZONE;
+		Node* node = std::allocator_traits<node_allocator>::allocate(m_Allocator, 1);
+		std::allocator_traits<node_allocator>::construct(m_Allocator, node, pt);
 
-		if (m_Left)
-		{
-			delete m_Left;
-			m_Left = nullptr;
-		}
+		return node;
+	}
 
-		if (m_Right)
-		{
-			delete m_Right;
-			m_Right = nullptr;
-		}
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::destroy_recursive(Node* node)
+	{
+		if (node == nullptr) return;
+
+		destroy_recursive(node->m_Left);
+		destroy_recursive(node->m_Right);
+
+		std::allocator_traits<node_allocator>::destroy(m_Allocator, node);
+		std::allocator_traits<node_allocator>::deallocate(m_Allocator, node, 1);
 	}
 
-	template<uint32_t K>
-	inline kd_tree<K>::~kd_tree()
+	template<uint32_t K, typename Allocator>
+	inline kd_tree<K, Allocator>::~kd_tree()
 	{
 		SPICES_PROFILE_ZONE;
 
-		if (m_Root)
-		{
-			delete m_Root;
-			m_Root = nullptr;
-		}
+		destroy_recursive(m_Root);
+		m_Root = nullptr;
 	}
 
-	template<uint32_t K>
-	inline void kd_tree<K>::insert(const std::vector<item>& points)
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::insert(const std::vector<item>& points)
 	{
 		SPICES_PROFILE_ZONE;
 
 		insert_recursive(m_Root, std::make_shared<std::vector<item>>(points), 0);
 	}
 
-	template<uint32_t K>
-	inline void kd_tree<K>::insert_async(const std::vector<item>& points, Spices::ThreadPool* threadPool)
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::insert_async(const std::vector<item>& points, Spices::ThreadPool* threadPool)
 	{
 		SPICES_PROFILE_ZONE;
 
@@ -609,24 +636,24 @@ namespace scl {
 		threadPool->Wait();
 	}
 
-	template<uint32_t K>
-	inline bool kd_tree<K>::search(const item& point) const
+	template<uint32_t K, typename Allocator>
+	inline bool kd_tree<K, Allocator>::search(const item& point) const
 	{
 		SPICES_PROFILE_ZONE;
 
 		return search_recursive(m_Root, point, 0);
 	}
 
-	template<uint32_t K>
-	inline auto kd_tree<K>::nearest_neighbour_search(
+	template<uint32_t K, typename Allocator>
+	inline auto kd_tree<K, Allocator>::nearest_neighbour_search(
 		const item& point, 
 		const item& condition
 	)
-		const -> kd_tree<K>::item
+		const -> kd_tree<K, Allocator>::item
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::vector<kd_tree<K>::item> rangePoints;
+		std::vector<kd_tree<K, Allocator>::item> rangePoints;
 		range_search_recursive(m_Root, point, condition, rangePoints, 0);
 
 		if (rangePoints.size() == 0) return {};
@@ -650,22 +677,22 @@ namespace scl {
 		return rangePoints[nearIndex];
 	}
 
-	template<uint32_t K>
-	inline auto kd_tree<K>::range_search(
+	template<uint32_t K, typename Allocator>
+	inline auto kd_tree<K, Allocator>::range_search(
 		const item& point, 
 		const item& condition
 	) 
-		const -> std::vector<kd_tree<K>::item>
+		const -> std::vector<kd_tree<K, Allocator>::item>
 	{
 		SPICES_PROFILE_ZONE;
 		
-		std::vector<kd_tree<K>::item> rangePoints;
+		std::vector<kd_tree<K, Allocator>::item> rangePoints;
 		range_search_recursive(m_Root, point, condition, rangePoints, 0);
 		return rangePoints;
 	}
 
-	template<uint32_t K>
-	inline void kd_tree<K>::print() const
+	template<uint32_t K, typename Allocator>
+	inline void kd_tree<K, Allocator>::print() const
 	{
 		SPICES_PROFILE_ZONE;
 
@@ -6,9 +6,27 @@
 
 #include "Pchheader.h"
 #include "RuntimeMemoryBlock.h"
-#include "Core/Reflect/TypeReflect.h"
+
+#include <utility>
 
 namespace scl {
+
+    runtime_memory_block::runtime_memory_block(std::shared_ptr<const runtime_memory_layout> layout)
+        : bytes_(layout->bytes())
+        , layout_(std::move(layout))
+    {
+        SPICES_PROFILE_ZONE;
+
+        /**
+        * @brief Name lookup is kept for by name access.
+        */
+        for (const auto& field : layout_->fields())
+        {
+            object_[field.name] = field.offset;
+        }
+
+        begin_ = calloc(1, bytes_ ? bytes_ : 1);
+    }
     
     runtime_memory_block::~runtime_memory_block()
     {
@@ -20,6 +38,28 @@ namespace scl {
         if (begin_) free(begin_);
     }
 
+    runtime_memory_block::runtime_memory_block(runtime_memory_block&& other) noexcept
+        : begin_(std::exchange(other.begin_, nullptr))
+        , bytes_(std::exchange(other.bytes_, 0))
+        , object_(std::move(other.object_))
+        , layout_(std::move(other.layout_))
+    {}
+
+    runtime_memory_block& runtime_memory_block::operator=(runtime_memory_block&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (begin_) free(begin_);
+
+            begin_  = std::exchange(other.begin_, nullptr);
+            bytes_  = std::exchange(other.bytes_, 0);
+            object_ = std::move(other.object_);
+            layout_ = std::move(other.layout_);
+        }
+
+        return *this;
+    }
+
     void runtime_memory_block::add_element(const std::string& name, const std::string& type)
     {
         SPICES_PROFILE_ZONE;
@@ -37,14 +77,37 @@ namespace scl {
         }
 
         /**
-        * @brief Recording current parameter's position to object_.
+        * @brief A compiled layout is immutable.
+        */
+        if (layout_)
+        {
+            std::stringstream ss;
+            ss << "runtime_memory_block:: add failed: block is built from a layout: " << name;
+
+            SPICES_CORE_WARN(ss.str());
+            return;
+        }
+
+        const memory_field_type fieldType = to_memory_field_type(type);
+        if (fieldType == memory_field_type::Count)
+        {
+            std::stringstream ss;
+            ss << "runtime_memory_block:: add failed: not supported type: " << type;
+
+            SPICES_CORE_ERROR(ss.str());
+            return;
+        }
+
+        /**
+        * @brief Recording current parameter's aligned position to object_.
         */
-        object_[name] = bytes_;
+        const size_t alignment = memory_field_align(fieldType, memory_layout_rule::Scalar);
+        object_[name] = (bytes_ + alignment - 1) / alignment * alignment;
 
         /**
         * @brief Add to bytes_ with parameter type.
         */
-        bytes_ += Spices::StrType2Size(type);
+        bytes_ = object_[name] + memory_field_size(fieldType);
     }
 
     void runtime_memory_block::build()
@@ -57,9 +120,23 @@ namespace scl {
         if(begin_) free(begin_);
 
         /**
-        * @brief Malloc memory to begin_ with bytes_.
+        * @brief Malloc zeroed memory to begin_ with bytes_.
         */
-        begin_ = malloc(bytes_);
+        begin_ = calloc(1, bytes_ ? bytes_ : 1);
+    }
+
+    void runtime_memory_block::set_value(uint32_t index, const void* data)
+    {
+        if (!layout_ || index >= layout_->size())
+        {
+            std::stringstream ss;
+            ss << "runtime_memory_block:: set_value failed: without the element: " << index;
+
+            throw std::runtime_error(ss.str());
+        }
+
+        const memory_field& field = layout_->field(index);
+        std::memcpy(static_cast<char*>(begin_) + field.offset, data, field.size);
     }
 
     void runtime_memory_block::for_each(std::function<bool(const std::string& name, void* pt)> fn) const
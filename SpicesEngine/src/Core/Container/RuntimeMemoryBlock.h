@@ -6,12 +6,16 @@
 
 #pragma once
 #include "Core/Core.h"
+#include "RuntimeMemoryLayout.h"
+
+#include <cstring>
 
 namespace scl {
 
     /**
     * @brief The container is wrapper of a continue memory block.
     * Used in Material::BuildMaterial(), helps to update buffer.
+    * Elements are placed with scalar block layout, a block built from runtime_memory_layout is written by field index.
     */
     class runtime_memory_block
     {
@@ -32,6 +36,11 @@ namespace scl {
         * Data: parameter name - parameter position offset with begin_.
         */
         std::unordered_map<std::string, size_t> object_;
+
+        /**
+        * @brief The compiled layout, nullptr if elements are added by add_element().
+        */
+        std::shared_ptr<const runtime_memory_layout> layout_;
         
     public:
 
@@ -40,11 +49,43 @@ namespace scl {
         */
         runtime_memory_block() = default;
 
+        /**
+        * @brief Constructor Function.
+        * Build a zeroed block of a compiled layout, no element can be added after.
+        * @param[in] layout The compiled layout.
+        */
+        explicit runtime_memory_block(std::shared_ptr<const runtime_memory_layout> layout);
+
         /**
         * @brief Destructor Function.
         */
         virtual ~runtime_memory_block();
 
+        /**
+        * @brief Copy Constructor Function.
+        * @note This Class not allowed copy behaves.
+        */
+        runtime_memory_block(const runtime_memory_block&) = delete;
+
+        /**
+        * @brief Copy Assignment Operation.
+        * @note This Class not allowed copy behaves.
+        */
+        runtime_memory_block& operator=(const runtime_memory_block&) = delete;
+
+        /**
+        * @brief Move Constructor Function.
+        * @param[in] other Another block.
+        */
+        runtime_memory_block(runtime_memory_block&& other) noexcept;
+
+        /**
+        * @brief Move Assignment Operation.
+        * @param[in] other Another block.
+        * @return Returns this block.
+        */
+        runtime_memory_block& operator=(runtime_memory_block&& other) noexcept;
+
         /**
         * @brief Add a element to object_, means a memory block will be occupied with given param type.
         * @param[in] name The name of parameter.
@@ -81,6 +122,37 @@ namespace scl {
         */
         template<typename T>
         T& get_value(const std::string& name);
+
+        /**
+        * @brief Copy a field's data into block by index.
+        * @param[in] index Field index in layout.
+        * @param[in] data Field data, bytes of the field are copied.
+        */
+        void set_value(uint32_t index, const void* data);
+
+        /**
+        * @brief Fill in a field by index.
+        * @tparam T The type of field, must be same bytes with the field.
+        * @param[in] index Field index in layout.
+        * @param[in] value The value of field.
+        */
+        template<typename T>
+        void set_value(uint32_t index, const T& value);
+
+        /**
+        * @brief Get value of a field by index.
+        * @tparam T The type of field, must be same bytes with the field.
+        * @param[in] index Field index in layout.
+        * @return Returns the value of field.
+        */
+        template<typename T>
+        T& get_value(uint32_t index);
+
+        /**
+        * @brief Get the compiled layout.
+        * @return Returns the layout, nullptr if not built from a layout.
+        */
+        const std::shared_ptr<const runtime_memory_layout>& get_layout() const { return layout_; }
         
         /**
         * @brief Get the begin_.
@@ -165,4 +237,34 @@ namespace scl {
 
         return *static_cast<T*>(mem);
     }
+
+    template <typename T>
+    void runtime_memory_block::set_value(uint32_t index, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "runtime_memory_block:: set_value needs a trivially copyable type.");
+
+        if (!layout_ || index >= layout_->size() || layout_->field(index).size != sizeof(T))
+        {
+            std::stringstream ss;
+            ss << "runtime_memory_block:: set_value failed: element " << index << " is not " << sizeof(T) << " bytes.";
+
+            throw std::runtime_error(ss.str());
+        }
+
+        std::memcpy(static_cast<char*>(begin_) + layout_->field(index).offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T& runtime_memory_block::get_value(uint32_t index)
+    {
+        if (!layout_ || index >= layout_->size() || layout_->field(index).size != sizeof(T))
+        {
+            std::stringstream ss;
+            ss << "runtime_memory_block:: get_value failed: element " << index << " is not " << sizeof(T) << " bytes.";
+
+            throw std::runtime_error(ss.str());
+        }
+
+        return *reinterpret_cast<T*>(static_cast<char*>(begin_) + layout_->field(index).offset);
+    }
 }
@@ -0,0 +1,205 @@
+/**
+* @file RuntimeMemoryLayout.cpp.
+* @brief The runtime_memory_layout Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "RuntimeMemoryLayout.h"
+
+namespace scl {
+
+	namespace {
+
+		/**
+		* @brief Compiled layouts, key: signature, value: layout.
+		* Layouts are owned by blocks using them.
+		*/
+		std::unordered_map<std::string, std::weak_ptr<const runtime_memory_layout>> layout_cache;
+
+		/**
+		* @brief Mutex of layout_cache.
+		*/
+		std::mutex layout_cache_mutex;
+
+		/**
+		* @brief Round up to alignment.
+		* @param[in] value The value.
+		* @param[in] alignment The alignment.
+		* @return Returns aligned value.
+		*/
+		uint32_t align_up(uint32_t value, uint32_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	memory_field_type to_memory_field_type(const std::string& type)
+	{
+		if      (type == "float4") return memory_field_type::Float4;
+		else if (type == "float3") return memory_field_type::Float3;
+		else if (type == "float2") return memory_field_type::Float2;
+		else if (type == "float")  return memory_field_type::Float;
+		else if (type == "int")    return memory_field_type::Int;
+		else if (type == "uint")   return memory_field_type::UInt;
+		else if (type == "bool")   return memory_field_type::Bool;
+
+		return memory_field_type::Count;
+	}
+
+	uint32_t memory_field_size(memory_field_type type)
+	{
+		switch (type)
+		{
+			case memory_field_type::Float4: return 16;
+			case memory_field_type::Float3: return 12;
+			case memory_field_type::Float2: return 8;
+			case memory_field_type::Float:
+			case memory_field_type::Int:
+			case memory_field_type::UInt:
+			case memory_field_type::Bool:   return 4;
+			default:                        return 0;
+		}
+	}
+
+	uint32_t memory_field_align(memory_field_type type, memory_layout_rule rule)
+	{
+		/**
+		* @brief Scalar layout aligns to component, std430 aligns vec3 as vec4.
+		*/
+		if (rule == memory_layout_rule::Scalar) return 4;
+
+		switch (type)
+		{
+			case memory_field_type::Float4:
+			case memory_field_type::Float3: return 16;
+			case memory_field_type::Float2: return 8;
+			default:                        return 4;
+		}
+	}
+
+	uint32_t runtime_memory_layout::find(const std::string& name) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (uint32_t i = 0; i < fields_.size(); i++)
+		{
+			if (fields_[i].name == name) return i;
+		}
+
+		return npos;
+	}
+
+	runtime_memory_layout_compiler::runtime_memory_layout_compiler(memory_layout_rule rule)
+		: rule_(rule)
+	{
+		signature_ = std::to_string(static_cast<int>(rule));
+	}
+
+	bool runtime_memory_layout_compiler::add(const std::string& name, memory_field_type type)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (type >= memory_field_type::Count)
+		{
+			std::stringstream ss;
+			ss << "runtime_memory_layout_compiler:: add failed: not supported type of element: " << name;
+
+			SPICES_CORE_WARN(ss.str());
+			return false;
+		}
+
+		for (const auto& [n, t] : fields_)
+		{
+			if (n == name)
+			{
+				std::stringstream ss;
+				ss << "runtime_memory_layout_compiler:: add failed: already has the element: " << name;
+
+				SPICES_CORE_WARN(ss.str());
+				return false;
+			}
+		}
+
+		fields_.emplace_back(name, type);
+
+		signature_ += '|';
+		signature_ += name;
+		signature_ += ':';
+		signature_ += std::to_string(static_cast<int>(type));
+
+		return true;
+	}
+
+	bool runtime_memory_layout_compiler::add(const std::string& name, const std::string& type)
+	{
+		return add(name, to_memory_field_type(type));
+	}
+
+	std::shared_ptr<const runtime_memory_layout> runtime_memory_layout_compiler::compile() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(layout_cache_mutex);
+
+		/**
+		* @brief Return the compiled one if alive.
+		*/
+		auto& cached = layout_cache[signature_];
+		if (auto layout = cached.lock())
+		{
+			return layout;
+		}
+
+		auto layout    = std::make_shared<runtime_memory_layout>();
+		layout->rule_  = rule_;
+		layout->fields_.reserve(fields_.size());
+
+		uint32_t offset = 0;
+		for (const auto& [name, type] : fields_)
+		{
+			const uint32_t alignment = memory_field_align(type, rule_);
+
+			memory_field field;
+			field.name   = name;
+			field.type   = type;
+			field.offset = align_up(offset, alignment);
+			field.size   = memory_field_size(type);
+
+			offset             = field.offset + field.size;
+			layout->alignment_ = std::max(layout->alignment_, alignment);
+
+			layout->fields_.push_back(std::move(field));
+		}
+
+		/**
+		* @brief Pad to alignment, same as array stride of the struct on GPU.
+		*/
+		layout->bytes_ = align_up(offset, layout->alignment_);
+
+		cached = layout;
+
+		return layout;
+	}
+
+	size_t runtime_memory_layout_compiler::cache_size()
+	{
+		std::unique_lock<std::mutex> lock(layout_cache_mutex);
+
+		size_t count = 0;
+		for (auto it = layout_cache.begin(); it != layout_cache.end();)
+		{
+			if (it->second.expired())
+			{
+				it = layout_cache.erase(it);
+			}
+			else
+			{
+				++count;
+				++it;
+			}
+		}
+
+		return count;
+	}
+}
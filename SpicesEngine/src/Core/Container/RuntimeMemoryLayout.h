@@ -0,0 +1,217 @@
+/**
+* @file RuntimeMemoryLayout.h.
+* @brief The runtime_memory_layout Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <mutex>
+
+namespace scl {
+
+	/**
+	* @brief Type of a field in runtime_memory_layout, same as the type string in .material file.
+	*/
+	enum class memory_field_type : uint8_t
+	{
+		Float  = 0,
+		Float2 = 1,
+		Float3 = 2,
+		Float4 = 3,
+		Int    = 4,
+		UInt   = 5,
+		Bool   = 6,
+		Count  = 7,
+	};
+
+	/**
+	* @brief Rules of field alignment, same as the GLSL block layout.
+	*/
+	enum class memory_layout_rule : uint8_t
+	{
+		Scalar = 0,        /* @brief GL_EXT_scalar_block_layout, used by MaterialParameters. */
+		Std430 = 1,        /* @brief std430.                                                  */
+	};
+
+	/**
+	* @brief Get field type from type string.
+	* @param[in] type Type string, float4, float3, float2, float, int, uint or bool.
+	* @return Returns the field type, Count if not supported.
+	*/
+	memory_field_type to_memory_field_type(const std::string& type);
+
+	/**
+	* @brief Get bytes of a field type on GPU.
+	* @param[in] type The field type.
+	* @return Returns bytes, bool is 4 bytes.
+	*/
+	uint32_t memory_field_size(memory_field_type type);
+
+	/**
+	* @brief Get alignment of a field type on GPU.
+	* @param[in] type The field type.
+	* @param[in] rule The layout rule.
+	* @return Returns alignment.
+	*/
+	uint32_t memory_field_align(memory_field_type type, memory_layout_rule rule);
+
+	/**
+	* @brief A field of runtime_memory_layout.
+	*/
+	struct memory_field
+	{
+		std::string       name;                                /* @brief Field name.             */
+		memory_field_type type   = memory_field_type::Count;   /* @brief Field type.             */
+		uint32_t          offset = 0;                          /* @brief Offset from block begin. */
+		uint32_t          size   = 0;                          /* @brief Bytes of field.         */
+	};
+
+	/**
+	* @brief Immutable aligned layout of a memory block, compiled by runtime_memory_layout_compiler.
+	* Fields are addressed by index, in the order they are added.
+	*/
+	class runtime_memory_layout
+	{
+	public:
+
+		/**
+		* @brief Index returned by find() if not found.
+		*/
+		static constexpr uint32_t npos = UINT32_MAX;
+
+	public:
+
+		/**
+		* @brief Get all fields.
+		* @return Returns all fields.
+		*/
+		const std::vector<memory_field>& fields() const { return fields_; }
+
+		/**
+		* @brief Get a field.
+		* @param[in] index Field index.
+		* @return Returns the field.
+		*/
+		const memory_field& field(uint32_t index) const { return fields_[index]; }
+
+		/**
+		* @brief Get fields count.
+		* @return Returns fields count.
+		*/
+		uint32_t size() const { return static_cast<uint32_t>(fields_.size()); }
+
+		/**
+		* @brief Get bytes of the block, padded to alignment.
+		* @return Returns bytes of the block.
+		*/
+		uint32_t bytes() const { return bytes_; }
+
+		/**
+		* @brief Get alignment of the block.
+		* @return Returns alignment of the block.
+		*/
+		uint32_t alignment() const { return alignment_; }
+
+		/**
+		* @brief Get the layout rule.
+		* @return Returns the layout rule.
+		*/
+		memory_layout_rule rule() const { return rule_; }
+
+		/**
+		* @brief Find a field by name, only used when building, not in per write path.
+		* @param[in] name Field name.
+		* @return Returns field index, npos if not found.
+		*/
+		uint32_t find(const std::string& name) const;
+
+	private:
+
+		/**
+		* @brief Allow compiler build this class.
+		*/
+		friend class runtime_memory_layout_compiler;
+
+		/**
+		* @brief Fields.
+		*/
+		std::vector<memory_field> fields_;
+
+		/**
+		* @brief Bytes of the block.
+		*/
+		uint32_t bytes_ = 0;
+
+		/**
+		* @brief Alignment of the block.
+		*/
+		uint32_t alignment_ = 4;
+
+		/**
+		* @brief Layout rule.
+		*/
+		memory_layout_rule rule_ = memory_layout_rule::Scalar;
+	};
+
+	/**
+	* @brief Compiles fields to a runtime_memory_layout.
+	* Same fields with same rule compile to the same shared layout, so a layout is built once per material template.
+	*/
+	class runtime_memory_layout_compiler
+	{
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] rule The layout rule.
+		*/
+		explicit runtime_memory_layout_compiler(memory_layout_rule rule = memory_layout_rule::Scalar);
+
+		/**
+		* @brief Add a field.
+		* @param[in] name Field name.
+		* @param[in] type Field type.
+		* @return Returns false if name is added or type is not supported.
+		*/
+		bool add(const std::string& name, memory_field_type type);
+
+		/**
+		* @brief Add a field.
+		* @param[in] name Field name.
+		* @param[in] type Field type string.
+		* @return Returns false if name is added or type is not supported.
+		*/
+		bool add(const std::string& name, const std::string& type);
+
+		/**
+		* @brief Compile the layout.
+		* @return Returns the shared layout.
+		*/
+		std::shared_ptr<const runtime_memory_layout> compile() const;
+
+		/**
+		* @brief Get count of compiled layouts alive in cache.
+		* @return Returns count of layouts.
+		*/
+		static size_t cache_size();
+
+	private:
+
+		/**
+		* @brief Layout rule.
+		*/
+		memory_layout_rule rule_;
+
+		/**
+		* @brief Fields added.
+		*/
+		std::vector<std::pair<std::string, memory_field_type>> fields_;
+
+		/**
+		* @brief Key of compiled layouts cache, rule and fields.
+		*/
+		std::string signature_;
+	};
+}
@@ -0,0 +1,325 @@
+/**
+* @file TLSFAllocator.cpp.
+* @brief The tlsf_allocator Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "TLSFAllocator.h"
+
+namespace scl {
+
+	namespace {
+
+		/**
+		* @brief Index of highest set bit.
+		* @param[in] value Not zero value.
+		* @return Returns bit index.
+		*/
+		uint32_t highest_bit(uint32_t value)
+		{
+			uint32_t bit = 0;
+			while (value >>= 1) bit++;
+
+			return bit;
+		}
+
+		/**
+		* @brief Index of lowest set bit.
+		* @param[in] value Not zero value.
+		* @return Returns bit index.
+		*/
+		uint32_t lowest_bit(uint32_t value)
+		{
+			uint32_t bit = 0;
+			while (!(value & 1u)) { value >>= 1; bit++; }
+
+			return bit;
+		}
+	}
+
+	tlsf_allocator::tlsf_allocator(uint32_t capacity, uint32_t granularity)
+		: granularity_(granularity)
+		, capacity_(capacity / granularity)
+	{
+		assert(granularity && !(granularity & (granularity - 1)));
+
+		reset();
+	}
+
+	tlsf_allocator::allocation tlsf_allocator::allocate(uint32_t bytes)
+	{
+		const uint32_t size = std::max<uint32_t>((bytes + granularity_ - 1) / granularity_, 1);
+
+		uint32_t fl, sl;
+		mapping_search(size, fl, sl);
+
+		uint32_t index = npos;
+		if (find_bin(fl, sl))
+		{
+			index = heads_[fl][sl];
+		}
+
+		/**
+		* @brief The bin of size itself may hold a block large enough, scan it before failing.
+		*/
+		else
+		{
+			mapping_insert(size, fl, sl);
+
+			for (uint32_t it = heads_[fl][sl]; it != npos; it = nodes_[it].next_free)
+			{
+				if (nodes_[it].size >= size) { index = it; break; }
+			}
+
+			if (index == npos) return allocation{};
+		}
+
+		remove_free(index);
+
+		/**
+		* @brief Split the tail into a free block.
+		*/
+		if (nodes_[index].size > size)
+		{
+			const uint32_t tail = new_node();
+
+			node& block = nodes_[index];
+			node& rest  = nodes_[tail];
+
+			rest.offset    = block.offset + size;
+			rest.size      = block.size - size;
+			rest.prev_phys = index;
+			rest.next_phys = block.next_phys;
+
+			if (block.next_phys != npos) nodes_[block.next_phys].prev_phys = tail;
+
+			block.next_phys = tail;
+			block.size      = size;
+
+			insert_free(tail);
+		}
+
+		used_ += size;
+		allocations_++;
+
+		return allocation{ nodes_[index].offset * granularity_, index };
+	}
+
+	void tlsf_allocator::free(const allocation& alloc)
+	{
+		if (!alloc.valid()) return;
+
+		uint32_t index = alloc.node;
+
+		assert(index < nodes_.size() && !nodes_[index].free);
+
+		used_ -= nodes_[index].size;
+		allocations_--;
+
+		/**
+		* @brief Merge with left neighbour.
+		*/
+		const uint32_t prev = nodes_[index].prev_phys;
+		if (prev != npos && nodes_[prev].free)
+		{
+			remove_free(prev);
+
+			nodes_[prev].size     += nodes_[index].size;
+			nodes_[prev].next_phys = nodes_[index].next_phys;
+
+			if (nodes_[index].next_phys != npos) nodes_[nodes_[index].next_phys].prev_phys = prev;
+
+			delete_node(index);
+			index = prev;
+		}
+
+		/**
+		* @brief Merge with right neighbour.
+		*/
+		const uint32_t next = nodes_[index].next_phys;
+		if (next != npos && nodes_[next].free)
+		{
+			remove_free(next);
+
+			nodes_[index].size     += nodes_[next].size;
+			nodes_[index].next_phys = nodes_[next].next_phys;
+
+			if (nodes_[next].next_phys != npos) nodes_[nodes_[next].next_phys].prev_phys = index;
+
+			delete_node(next);
+		}
+
+		insert_free(index);
+	}
+
+	void tlsf_allocator::reset()
+	{
+		SPICES_PROFILE_ZONE;
+
+		nodes_.clear();
+		free_nodes_.clear();
+
+		for (auto& heads : heads_) heads.fill(npos);
+		sl_bitmap_.fill(0);
+
+		fl_bitmap_   = 0;
+		used_        = 0;
+		allocations_ = 0;
+		free_blocks_ = 0;
+
+		if (capacity_ == 0) return;
+
+		const uint32_t index = new_node();
+		nodes_[index].size   = capacity_;
+
+		insert_free(index);
+	}
+
+	uint32_t tlsf_allocator::allocation_size(const allocation& alloc) const
+	{
+		if (!alloc.valid()) return 0;
+
+		return nodes_[alloc.node].size * granularity_;
+	}
+
+	uint32_t tlsf_allocator::largest_free_block() const
+	{
+		if (!fl_bitmap_) return 0;
+
+		const uint32_t fl = highest_bit(fl_bitmap_);
+		const uint32_t sl = highest_bit(sl_bitmap_[fl]);
+
+		/**
+		* @brief Blocks of a bin differ in size, so scan the highest bin.
+		*/
+		uint32_t largest = 0;
+		for (uint32_t index = heads_[fl][sl]; index != npos; index = nodes_[index].next_free)
+		{
+			largest = std::max(largest, nodes_[index].size);
+		}
+
+		return largest * granularity_;
+	}
+
+	void tlsf_allocator::mapping_insert(uint32_t size, uint32_t& fl, uint32_t& sl)
+	{
+		if (size < sl_count)
+		{
+			fl = 0;
+			sl = size;
+			return;
+		}
+
+		const uint32_t bit = highest_bit(size);
+
+		fl = bit - sl_bits + 1;
+		sl = (size >> (bit - sl_bits)) & (sl_count - 1);
+	}
+
+	void tlsf_allocator::mapping_search(uint32_t size, uint32_t& fl, uint32_t& sl)
+	{
+		/**
+		* @brief Round up to next bin, so any block of the found bin fits.
+		*/
+		uint64_t rounded = size;
+		if (size >= sl_count)
+		{
+			rounded += (1ull << (highest_bit(size) - sl_bits)) - 1;
+		}
+
+		if (rounded > UINT32_MAX)
+		{
+			fl = fl_count;
+			sl = 0;
+			return;
+		}
+
+		mapping_insert(static_cast<uint32_t>(rounded), fl, sl);
+	}
+
+	bool tlsf_allocator::find_bin(uint32_t& fl, uint32_t& sl) const
+	{
+		if (fl >= fl_count) return false;
+
+		uint32_t sl_map = sl_bitmap_[fl] & (~0u << sl);
+
+		if (!sl_map)
+		{
+			const uint32_t fl_map = fl + 1 < fl_count ? fl_bitmap_ & (~0u << (fl + 1)) : 0;
+			if (!fl_map) return false;
+
+			fl     = lowest_bit(fl_map);
+			sl_map = sl_bitmap_[fl];
+		}
+
+		sl = lowest_bit(sl_map);
+
+		return true;
+	}
+
+	void tlsf_allocator::insert_free(uint32_t index)
+	{
+		uint32_t fl, sl;
+		mapping_insert(nodes_[index].size, fl, sl);
+
+		node& block     = nodes_[index];
+		block.free      = true;
+		block.prev_free = npos;
+		block.next_free = heads_[fl][sl];
+
+		if (block.next_free != npos) nodes_[block.next_free].prev_free = index;
+
+		heads_[fl][sl]  = index;
+		sl_bitmap_[fl] |= 1u << sl;
+		fl_bitmap_     |= 1u << fl;
+
+		free_blocks_++;
+	}
+
+	void tlsf_allocator::remove_free(uint32_t index)
+	{
+		uint32_t fl, sl;
+		mapping_insert(nodes_[index].size, fl, sl);
+
+		node& block = nodes_[index];
+
+		if (block.prev_free != npos) nodes_[block.prev_free].next_free = block.next_free;
+		else                         heads_[fl][sl]                    = block.next_free;
+
+		if (block.next_free != npos) nodes_[block.next_free].prev_free = block.prev_free;
+
+		if (heads_[fl][sl] == npos)
+		{
+			sl_bitmap_[fl] &= ~(1u << sl);
+			if (!sl_bitmap_[fl]) fl_bitmap_ &= ~(1u << fl);
+		}
+
+		block.free      = false;
+		block.prev_free = npos;
+		block.next_free = npos;
+
+		free_blocks_--;
+	}
+
+	uint32_t tlsf_allocator::new_node()
+	{
+		if (!free_nodes_.empty())
+		{
+			const uint32_t index = free_nodes_.back();
+			free_nodes_.pop_back();
+
+			nodes_[index] = node{};
+			return index;
+		}
+
+		nodes_.emplace_back();
+		return static_cast<uint32_t>(nodes_.size() - 1);
+	}
+
+	void tlsf_allocator::delete_node(uint32_t index)
+	{
+		nodes_[index] = node{};
+		free_nodes_.push_back(index);
+	}
+}
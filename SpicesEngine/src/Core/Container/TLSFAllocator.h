@@ -0,0 +1,240 @@
+/**
+* @file TLSFAllocator.h.
+* @brief The tlsf_allocator Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+namespace scl {
+
+	/**
+	* @brief Two level segregated fit allocator of offsets in a range, no memory is touched.
+	* Used to sub-allocate a large buffer, allocate and free are O(1) and free blocks are merged with neighbours.
+	* Sizes are rounded up to granularity, so every offset is aligned to granularity.
+	*/
+	class tlsf_allocator
+	{
+	public:
+
+		/**
+		* @brief Second level bins of a first level bin, 2^sl_bits.
+		*/
+		static constexpr uint32_t sl_bits  = 3;
+		static constexpr uint32_t sl_count = 1u << sl_bits;
+
+		/**
+		* @brief First level bins.
+		*/
+		static constexpr uint32_t fl_count = 32;
+
+		/**
+		* @brief Invalid node or offset.
+		*/
+		static constexpr uint32_t npos = UINT32_MAX;
+
+		/**
+		* @brief An allocation, node is needed to free it.
+		*/
+		struct allocation
+		{
+			uint32_t offset = npos;     /* @brief Offset in bytes. */
+			uint32_t node   = npos;     /* @brief Block node.      */
+
+			bool valid() const { return node != npos; }
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] capacity Bytes of the range.
+		* @param[in] granularity Alignment and size unit, power of two.
+		*/
+		explicit tlsf_allocator(uint32_t capacity, uint32_t granularity = 16);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~tlsf_allocator() = default;
+
+		/**
+		* @brief Allocate a range.
+		* @param[in] bytes Bytes of the range.
+		* @return Returns the allocation, invalid if no free block fits.
+		*/
+		allocation allocate(uint32_t bytes);
+
+		/**
+		* @brief Free a range, merged with free neighbours.
+		* @param[in] alloc The allocation.
+		*/
+		void free(const allocation& alloc);
+
+		/**
+		* @brief Free all ranges at once.
+		*/
+		void reset();
+
+		/**
+		* @brief Get bytes of an allocation, rounded up to granularity.
+		* @param[in] alloc The allocation.
+		* @return Returns bytes.
+		*/
+		uint32_t allocation_size(const allocation& alloc) const;
+
+		/**
+		* @brief Get bytes of the range.
+		* @return Returns bytes of the range.
+		*/
+		uint32_t capacity() const { return capacity_ * granularity_; }
+
+		/**
+		* @brief Get bytes allocated.
+		* @return Returns bytes allocated.
+		*/
+		uint32_t used() const { return used_ * granularity_; }
+
+		/**
+		* @brief Get live allocations count.
+		* @return Returns allocations count.
+		*/
+		uint32_t allocation_count() const { return allocations_; }
+
+		/**
+		* @brief Get free blocks count.
+		* @return Returns free blocks count.
+		*/
+		uint32_t free_block_count() const { return free_blocks_; }
+
+		/**
+		* @brief Get bytes of largest free block.
+		* @return Returns bytes of largest free block.
+		*/
+		uint32_t largest_free_block() const;
+
+		/**
+		* @brief Get the granularity.
+		* @return Returns the granularity.
+		*/
+		uint32_t granularity() const { return granularity_; }
+
+	private:
+
+		/**
+		* @brief A block of the range, free or used.
+		* Sizes and offsets are in granularity units.
+		*/
+		struct node
+		{
+			uint32_t offset    = 0;        /* @brief Offset.                  */
+			uint32_t size      = 0;        /* @brief Size.                    */
+			uint32_t prev_phys = npos;     /* @brief Left neighbour block.    */
+			uint32_t next_phys = npos;     /* @brief Right neighbour block.   */
+			uint32_t prev_free = npos;     /* @brief Previous block of bin.   */
+			uint32_t next_free = npos;     /* @brief Next block of bin.       */
+			bool     free      = false;    /* @brief Is in a bin.             */
+		};
+
+		/**
+		* @brief Get bin a size belongs to.
+		* @param[in] size Size.
+		* @param[out] fl First level.
+		* @param[out] sl Second level.
+		*/
+		static void mapping_insert(uint32_t size, uint32_t& fl, uint32_t& sl);
+
+		/**
+		* @brief Get first bin whose blocks all fit a size.
+		* @param[in] size Size.
+		* @param[out] fl First level.
+		* @param[out] sl Second level.
+		*/
+		static void mapping_search(uint32_t size, uint32_t& fl, uint32_t& sl);
+
+		/**
+		* @brief Find a non-empty bin at or above a bin.
+		* @param[in,out] fl First level.
+		* @param[in,out] sl Second level.
+		* @return Returns false if none.
+		*/
+		bool find_bin(uint32_t& fl, uint32_t& sl) const;
+
+		/**
+		* @brief Insert a block into its bin.
+		* @param[in] index Node index.
+		*/
+		void insert_free(uint32_t index);
+
+		/**
+		* @brief Remove a block from its bin.
+		* @param[in] index Node index.
+		*/
+		void remove_free(uint32_t index);
+
+		/**
+		* @brief Get a node from node pool.
+		* @return Returns node index.
+		*/
+		uint32_t new_node();
+
+		/**
+		* @brief Return a node to node pool.
+		* @param[in] index Node index.
+		*/
+		void delete_node(uint32_t index);
+
+	private:
+
+		/**
+		* @brief Bytes of a unit.
+		*/
+		uint32_t granularity_;
+
+		/**
+		* @brief Units of the range.
+		*/
+		uint32_t capacity_;
+
+		/**
+		* @brief Units allocated.
+		*/
+		uint32_t used_ = 0;
+
+		/**
+		* @brief Live allocations.
+		*/
+		uint32_t allocations_ = 0;
+
+		/**
+		* @brief Free blocks.
+		*/
+		uint32_t free_blocks_ = 0;
+
+		/**
+		* @brief Bit of a first level is set if any of its bins is not empty.
+		*/
+		uint32_t fl_bitmap_ = 0;
+
+		/**
+		* @brief Bit of a second level is set if its bin is not empty.
+		*/
+		std::array<uint32_t, fl_count> sl_bitmap_{};
+
+		/**
+		* @brief First free block of bins.
+		*/
+		std::array<std::array<uint32_t, sl_count>, fl_count> heads_;
+
+		/**
+		* @brief Node pool.
+		*/
+		std::vector<node> nodes_;
+
+		/**
+		* @brief Unused nodes of node pool.
+		*/
+		std::vector<uint32_t> free_nodes_;
+	};
+}
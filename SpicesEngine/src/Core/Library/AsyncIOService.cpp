@@ -0,0 +1,713 @@
+/**
+* @file AsyncIOService.cpp.
+* @brief The AsyncIOService Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "AsyncIOService.h"
+#include "FileLibrary.h"
+#include "Core/Thread/ThreadPool.h"
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace Spices {
+
+	std::shared_ptr<AsyncIOService> AsyncIOService::m_AsyncIOService = std::make_shared<AsyncIOService>();
+
+#if defined(__linux__)
+
+	/**
+	* @brief io_uring submission and completion rings, mapped from kernel.
+	* Only the submitter thread touches them, so ring indices need no lock.
+	*/
+	struct AsyncIOService::Uring
+	{
+		int            fd         = -1;
+		unsigned*      sqHead     = nullptr;
+		unsigned*      sqTail     = nullptr;
+		unsigned*      sqMask     = nullptr;
+		unsigned*      sqArray    = nullptr;
+		unsigned*      cqHead     = nullptr;
+		unsigned*      cqTail     = nullptr;
+		unsigned*      cqMask     = nullptr;
+		io_uring_sqe*  sqes       = nullptr;
+		io_uring_cqe*  cqes       = nullptr;
+		void*          sqRing     = MAP_FAILED;
+		void*          cqRing     = MAP_FAILED;
+		size_t         sqRingSize = 0;
+		size_t         cqRingSize = 0;
+		size_t         sqesSize   = 0;
+		unsigned       toSubmit   = 0;
+
+		~Uring() { Release(); }
+
+		/**
+		* @brief Create the ring and map it.
+		* @param[in] depth Submission queue depth.
+		* @return Returns false if io_uring is unavailable.
+		*/
+		bool Init(unsigned depth)
+		{
+			io_uring_params params{};
+
+			fd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+			if (fd < 0) return false;
+
+			sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cqRingSize = params.cq_off.cqes  + params.cq_entries * sizeof(io_uring_cqe);
+			sqesSize   = params.sq_entries * sizeof(io_uring_sqe);
+
+			const bool isSingleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+			if (isSingleMap)
+			{
+				sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+			}
+
+			sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+			if (sqRing == MAP_FAILED) { Release(); return false; }
+
+			cqRing = isSingleMap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+			if (cqRing == MAP_FAILED) { Release(); return false; }
+
+			void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+			if (sqesMap == MAP_FAILED) { Release(); return false; }
+
+			char* sq = static_cast<char*>(sqRing);
+			char* cq = static_cast<char*>(cqRing);
+
+			sqHead  = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+			sqTail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+			sqMask  = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+			sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+			cqHead  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+			cqTail  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+			cqMask  = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+			cqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+			sqes    = static_cast<io_uring_sqe*>(sqesMap);
+
+			return true;
+		}
+
+		/**
+		* @brief UnMap the ring and close it.
+		*/
+		void Release()
+		{
+			if (sqes)                                       munmap(sqes, sqesSize);
+			if (cqRing != MAP_FAILED && cqRing != sqRing)   munmap(cqRing, cqRingSize);
+			if (sqRing != MAP_FAILED)                       munmap(sqRing, sqRingSize);
+			if (fd >= 0)                                    close(fd);
+
+			fd     = -1;
+			sqes   = nullptr;
+			sqRing = MAP_FAILED;
+			cqRing = MAP_FAILED;
+		}
+
+		/**
+		* @brief Queue a readv.
+		* @param[in] file File descriptor.
+		* @param[in] iov Destination, alive until completion.
+		* @param[in] offset File offset.
+		* @param[in] userData Returned with completion.
+		*/
+		void PushRead(int file, const iovec* iov, uint64_t offset, uint64_t userData)
+		{
+			const unsigned tail  = *sqTail;
+			const unsigned index = tail & *sqMask;
+
+			io_uring_sqe* sqe = &sqes[index];
+			std::memset(sqe, 0, sizeof(io_uring_sqe));
+
+			sqe->opcode    = IORING_OP_READV;
+			sqe->fd        = file;
+			sqe->addr      = reinterpret_cast<uint64_t>(iov);
+			sqe->len       = 1;
+			sqe->off       = offset;
+			sqe->user_data = userData;
+
+			sqArray[index] = index;
+
+			__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+			toSubmit++;
+		}
+
+		/**
+		* @brief Submit queued reads and wait at least one completion.
+		* @return Returns false if io_uring_enter failed.
+		*/
+		bool SubmitAndWait()
+		{
+			for (;;)
+			{
+				const int submitted = static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+				if (submitted >= 0)
+				{
+					toSubmit -= std::min(toSubmit, static_cast<unsigned>(submitted));
+					return true;
+				}
+
+				if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+			}
+		}
+
+		/**
+		* @brief Wait at least one completion without submitting.
+		* @return Returns false if io_uring_enter failed.
+		*/
+		bool WaitCompletion()
+		{
+			for (;;)
+			{
+				if (syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) >= 0) return true;
+
+				if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+			}
+		}
+
+		/**
+		* @brief Take back reads queued but not consumed by kernel, kernel only consumes them in io_uring_enter.
+		* @return Returns count of reads taken back.
+		*/
+		unsigned Retract()
+		{
+			const unsigned tail  = *sqTail;
+			const unsigned count = tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+
+			__atomic_store_n(sqTail, tail - count, __ATOMIC_RELEASE);
+			toSubmit = 0;
+
+			return count;
+		}
+
+		/**
+		* @brief Take a completion.
+		* @param[out] userData User data of the read.
+		* @param[out] res Read bytes, or negative errno.
+		* @return Returns false if no completion.
+		*/
+		bool PopCompletion(uint64_t& userData, int& res)
+		{
+			const unsigned head = *cqHead;
+			if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) return false;
+
+			const io_uring_cqe& cqe = cqes[head & *cqMask];
+			userData = cqe.user_data;
+			res      = cqe.res;
+
+			__atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+			return true;
+		}
+	};
+
+#else
+
+	/**
+	* @brief io_uring is Linux only.
+	*/
+	struct AsyncIOService::Uring {};
+
+#endif
+
+	AsyncIOService::AsyncIOService() = default;
+
+	AsyncIOService::~AsyncIOService()
+	{
+		Stop();
+	}
+
+	void AsyncIOService::Start(uint32_t nThreads, ThreadPool* completionPool, bool isUseIoUring)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Stop();
+
+		m_CompletionPool = completionPool;
+		m_Backend        = Backend::Thread;
+
+#if defined(__linux__)
+
+		if (isUseIoUring)
+		{
+			auto uring = std::make_unique<Uring>();
+			if (uring->Init(BatchSize))
+			{
+				m_Uring   = std::move(uring);
+				m_Backend = Backend::IoUring;
+			}
+			else
+			{
+				SPICES_CORE_WARN("AsyncIOService: io_uring is unavailable, fall back to IO threads.");
+			}
+		}
+
+#endif
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_IsRunning = true;
+		}
+
+		if (m_Backend == Backend::IoUring)
+		{
+			m_Threads.emplace_back(&AsyncIOService::UringFunc, this);
+		}
+		else
+		{
+			for (uint32_t i = 0; i < std::max(nThreads, 1u); i++)
+			{
+				m_Threads.emplace_back(&AsyncIOService::ThreadFunc, this);
+			}
+		}
+
+		std::stringstream ss;
+		ss << "AsyncIOService: started " << m_Threads.size() << " IO threads, backend: " << (m_Backend == Backend::IoUring ? "io_uring." : "FileLibrary.");
+
+		SPICES_CORE_INFO(ss.str());
+	}
+
+	void AsyncIOService::Stop()
+	{
+		SPICES_PROFILE_ZONE;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_IsRunning = false;
+		}
+
+		m_NotEmpty.notify_all();
+
+		for (auto& thread : m_Threads)
+		{
+			if (thread.joinable()) thread.join();
+		}
+		m_Threads.clear();
+
+		Wait();
+
+		m_Uring.reset();
+		m_Backend = Backend::Thread;
+	}
+
+	void AsyncIOService::Submit(IORequest request)
+	{
+		std::vector<IORequest> requests;
+		requests.push_back(std::move(request));
+
+		Submit(requests);
+	}
+
+	void AsyncIOService::Submit(std::vector<IORequest>& requests)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (requests.empty()) return;
+
+		bool isQueued = false;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+
+			m_InFlight += requests.size();
+			isQueued    = m_IsRunning;
+
+			if (isQueued)
+			{
+				for (auto& request : requests)
+				{
+					m_Queues[static_cast<size_t>(request.priority)].push_back(std::move(request));
+				}
+			}
+		}
+
+		m_Submitted.fetch_add(requests.size(), std::memory_order_relaxed);
+
+		if (isQueued)
+		{
+			m_NotEmpty.notify_all();
+		}
+		else
+		{
+			ReadBatch(requests);
+		}
+
+		requests.clear();
+	}
+
+	void AsyncIOService::Wait()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_Idle.wait(lock, [&]() { return m_InFlight == 0; });
+	}
+
+	bool AsyncIOService::IsRunning() const
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		return m_IsRunning;
+	}
+
+	AsyncIOService::Stats AsyncIOService::GetStats() const
+	{
+		Stats stats;
+		stats.submitted = m_Submitted.load(std::memory_order_relaxed);
+		stats.completed = m_Completed.load(std::memory_order_relaxed);
+		stats.failed    = m_Failed   .load(std::memory_order_relaxed);
+		stats.bytes     = m_Bytes    .load(std::memory_order_relaxed);
+		stats.batches   = m_Batches  .load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	bool AsyncIOService::PopBatch(std::vector<IORequest>& outBatch)
+	{
+		SPICES_PROFILE_ZONE;
+
+		outBatch.clear();
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		m_NotEmpty.wait(lock, [&]() {
+			return !m_IsRunning || std::any_of(m_Queues.begin(), m_Queues.end(), [](const auto& queue) { return !queue.empty(); });
+		});
+
+		/**
+		* @brief Fill the batch from high priority queue to low.
+		*/
+		for (auto& queue : m_Queues)
+		{
+			while (!queue.empty() && outBatch.size() < BatchSize)
+			{
+				outBatch.push_back(std::move(queue.front()));
+				queue.pop_front();
+			}
+		}
+
+		return !outBatch.empty();
+	}
+
+	void AsyncIOService::ThreadFunc()
+	{
+		std::vector<IORequest> batch;
+		batch.reserve(BatchSize);
+
+		while (PopBatch(batch))
+		{
+			ReadBatch(batch);
+		}
+	}
+
+	void AsyncIOService::ReadBatch(std::vector<IORequest>& batch)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Batches.fetch_add(1, std::memory_order_relaxed);
+
+		/**
+		* @brief Sort by priority, path and offset, so a file is opened once and read forward.
+		*/
+		std::vector<uint32_t> order(batch.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](uint32_t l, uint32_t r) {
+			return std::tie(batch[l].priority, batch[l].path, batch[l].offset) < std::tie(batch[r].priority, batch[r].path, batch[r].offset);
+		});
+
+		FileHandle  f;
+		std::string openPath;
+		bool        isOpen   = false;
+		uint64_t    fileSize = 0;
+
+		for (const uint32_t i : order)
+		{
+			IORequest& request = batch[i];
+
+			if (!isOpen || openPath != request.path)
+			{
+				if (isOpen) FileLibrary::FileLibrary_Close(&f);
+
+				openPath = request.path;
+				fileSize = 0;
+				isOpen   = FileLibrary::FileLibrary_Open(request.path.c_str(), FILE_MODE_READ, true, &f) &&
+				           FileLibrary::FileLibrary_Size(&f, &fileSize);
+			}
+
+			IOResult result;
+			result.path   = request.path;
+			result.offset = request.offset;
+
+			if (isOpen && request.offset <= fileSize)
+			{
+				const uint64_t size = request.size == IORequest::WholeFile ? fileSize - request.offset : request.size;
+
+				if (size <= fileSize - request.offset)
+				{
+					result.data.resize(size);
+
+					uint64_t readed = 0;
+					result.isSucceed = size == 0 || (
+						FileLibrary::FileLibrary_Seek(&f, request.offset) &&
+						FileLibrary::FileLibrary_Read(&f, size, result.data.data(), &readed)
+					);
+				}
+			}
+
+			Complete(request, std::move(result));
+		}
+
+		if (isOpen) FileLibrary::FileLibrary_Close(&f);
+	}
+
+	void AsyncIOService::UringFunc()
+	{
+		std::vector<IORequest> batch;
+		batch.reserve(BatchSize);
+
+		while (PopBatch(batch))
+		{
+			UringReadBatch(batch);
+		}
+	}
+
+#if defined(__linux__)
+
+	void AsyncIOService::UringReadBatch(std::vector<IORequest>& batch)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Batches.fetch_add(1, std::memory_order_relaxed);
+
+		/**
+		* @brief Reads in the ring, a short read is queued again for the rest.
+		*/
+		struct Pending
+		{
+			int      file = -1;
+			uint64_t size = 0;
+			uint64_t done = 0;
+			iovec    iov{};
+			IOResult result;
+			bool     isDone = false;
+		};
+
+		std::vector<Pending> pendings(batch.size());
+		std::unordered_map<std::string, std::pair<int, uint64_t>> files;
+
+		uint32_t inRing = 0;
+
+		const auto complete = [&](uint32_t i, bool isSucceed) {
+			Pending& pending = pendings[i];
+
+			pending.isDone           = true;
+			pending.result.isSucceed = isSucceed;
+			if (!isSucceed) pending.result.data.clear();
+
+			Complete(batch[i], std::move(pending.result));
+		};
+
+		const auto pushRead = [&](uint32_t i) {
+			Pending& pending = pendings[i];
+
+			pending.iov.iov_base = pending.result.data.data() + pending.done;
+			pending.iov.iov_len  = static_cast<size_t>(std::min<uint64_t>(pending.size - pending.done, 1ull << 30));
+
+			m_Uring->PushRead(pending.file, &pending.iov, batch[i].offset + pending.done, i);
+			inRing++;
+		};
+
+		for (uint32_t i = 0; i < batch.size(); i++)
+		{
+			IORequest& request = batch[i];
+			Pending&   pending = pendings[i];
+
+			pending.result.path   = request.path;
+			pending.result.offset = request.offset;
+
+			auto it = files.find(request.path);
+			if (it == files.end())
+			{
+				const int file = open(request.path.c_str(), O_RDONLY | O_CLOEXEC);
+
+				struct stat st {};
+				const uint64_t fileSize = file >= 0 && fstat(file, &st) == 0 ? static_cast<uint64_t>(st.st_size) : 0;
+
+				it = files.emplace(request.path, std::make_pair(file, fileSize)).first;
+			}
+
+			const auto [file, fileSize] = it->second;
+
+			if (file < 0 || request.offset > fileSize)
+			{
+				complete(i, false);
+				continue;
+			}
+
+			pending.file = file;
+			pending.size = request.size == IORequest::WholeFile ? fileSize - request.offset : request.size;
+
+			if (pending.size > fileSize - request.offset)
+			{
+				complete(i, false);
+				continue;
+			}
+
+			pending.result.data.resize(pending.size);
+
+			if (pending.size == 0)
+			{
+				complete(i, true);
+				continue;
+			}
+
+			pushRead(i);
+		}
+
+		while (inRing > 0)
+		{
+			uint64_t userData = 0;
+			int      res      = 0;
+
+			if (!m_Uring->SubmitAndWait())
+			{
+				std::stringstream ss;
+				ss << "AsyncIOService: io_uring_enter failed: " << std::strerror(errno);
+
+				SPICES_CORE_ERROR(ss.str());
+
+				/**
+				* @brief Reads never submitted are taken back, submitted ones still write into pendings,
+				* so wait them before their buffers are freed.
+				*/
+				inRing -= m_Uring->Retract();
+
+				while (inRing > 0)
+				{
+					if (!m_Uring->WaitCompletion())
+					{
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+					}
+
+					while (m_Uring->PopCompletion(userData, res))
+					{
+						inRing--;
+					}
+				}
+
+				break;
+			}
+
+			while (m_Uring->PopCompletion(userData, res))
+			{
+				inRing--;
+
+				const uint32_t i       = static_cast<uint32_t>(userData);
+				Pending&       pending = pendings[i];
+
+				if (res == -EINTR || res == -EAGAIN)
+				{
+					pushRead(i);
+					continue;
+				}
+
+				/**
+				* @brief Error or file truncated since fstat.
+				*/
+				if (res <= 0)
+				{
+					complete(i, false);
+					continue;
+				}
+
+				pending.done += static_cast<uint64_t>(res);
+
+				if (pending.done < pending.size)
+				{
+					pushRead(i);
+					continue;
+				}
+
+				complete(i, true);
+			}
+		}
+
+		/**
+		* @brief Ring failed and drained, the reads not finished are completed as failed.
+		*/
+		for (uint32_t i = 0; i < batch.size(); i++)
+		{
+			if (!pendings[i].isDone) complete(i, false);
+		}
+
+		for (const auto& [path, file] : files)
+		{
+			if (file.first >= 0) close(file.first);
+		}
+	}
+
+#else
+
+	void AsyncIOService::UringReadBatch(std::vector<IORequest>& batch)
+	{
+		ReadBatch(batch);
+	}
+
+#endif
+
+	void AsyncIOService::Complete(IORequest& request, IOResult&& result)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (result.isSucceed)
+		{
+			m_Completed.fetch_add(1, std::memory_order_relaxed);
+			m_Bytes.fetch_add(result.data.size(), std::memory_order_relaxed);
+		}
+		else
+		{
+			m_Failed.fetch_add(1, std::memory_order_relaxed);
+
+			std::stringstream ss;
+			ss << "AsyncIOService: failed to read " << result.path << ".";
+
+			SPICES_CORE_WARN(ss.str());
+		}
+
+		if (!request.callback)
+		{
+			Finish();
+			return;
+		}
+
+		if (m_CompletionPool && m_CompletionPool->IsPoolRunning())
+		{
+			auto task = std::make_shared<std::pair<std::function<void(IOResult&)>, IOResult>>(std::move(request.callback), std::move(result));
+
+			m_CompletionPool->SubmitPoolTask([this, task]() {
+				task->first(task->second);
+				Finish();
+			});
+
+			return;
+		}
+
+		request.callback(result);
+		Finish();
+	}
+
+	void AsyncIOService::Finish()
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		if (--m_InFlight == 0) m_Idle.notify_all();
+	}
+}
@@ -0,0 +1,293 @@
+/**
+* @file AsyncIOService.h.
+* @brief The AsyncIOService Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <functional>
+#include <condition_variable>
+#include <deque>
+
+namespace Spices {
+
+	/**
+	* @brief Forward declare.
+	*/
+	class ThreadPool;
+
+	/**
+	* @brief Priority of a read request, High is read first.
+	*/
+	enum class IOPriority : uint8_t
+	{
+		High = 0,
+		Normal,
+		Low,
+		Count,
+	};
+
+	/**
+	* @brief Result of a read request.
+	*/
+	struct IOResult
+	{
+		std::string       path;                 /* @brief File path.                        */
+		uint64_t          offset    = 0;        /* @brief Offset of read bytes in file.     */
+		std::vector<char> data;                 /* @brief Read bytes.                       */
+		bool              isSucceed = false;    /* @brief True if all bytes are read.       */
+	};
+
+	/**
+	* @brief A read request.
+	*/
+	struct IORequest
+	{
+		/**
+		* @brief Read from offset to end of file.
+		*/
+		static constexpr uint64_t WholeFile = UINT64_MAX;
+
+		std::string                    path;                            /* @brief File path.                              */
+		uint64_t                       offset   = 0;                    /* @brief Offset of first byte.                   */
+		uint64_t                       size     = WholeFile;            /* @brief Count of bytes.                         */
+		IOPriority                     priority = IOPriority::Normal;   /* @brief Priority.                               */
+		std::function<void(IOResult&)> callback;                        /* @brief Called with result, on completion pool. */
+	};
+
+	/**
+	* @brief Reads files in background, so disk reads overlap decoding on the calling threads.
+	* Requests are queued by priority and taken in batches, a batch is sorted by path and offset,
+	* so requests of one file are read with the file opened once.
+	* On Linux batches are submitted to an io_uring, elsewhere or if io_uring is unavailable
+	* IO threads read them with FileLibrary.
+	* Callbacks are dispatched to a ThreadPool, or called on the IO thread if no pool is running.
+	*/
+	class AsyncIOService
+	{
+	public:
+
+		/**
+		* @brief Read backend.
+		*/
+		enum class Backend : uint8_t
+		{
+			Thread,      /* @brief IO threads with blocking reads.       */
+			IoUring,     /* @brief Linux io_uring, one submitter thread. */
+		};
+
+		/**
+		* @brief Statistics.
+		*/
+		struct Stats
+		{
+			uint64_t submitted = 0;     /* @brief Submitted requests.    */
+			uint64_t completed = 0;     /* @brief Completed requests.    */
+			uint64_t failed    = 0;     /* @brief Failed requests.       */
+			uint64_t bytes     = 0;     /* @brief Read bytes.            */
+			uint64_t batches   = 0;     /* @brief Read batches.          */
+		};
+
+		/**
+		* @brief Max requests of a batch, also io_uring queue depth.
+		*/
+		static constexpr uint32_t BatchSize = 32;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		AsyncIOService();
+
+		/**
+		* @brief Destructor Function.
+		* Stop IO threads.
+		*/
+		virtual ~AsyncIOService();
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		AsyncIOService(const AsyncIOService&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		AsyncIOService& operator=(const AsyncIOService&) = delete;
+
+		/**
+		* @brief Get AsyncIOService Single Instance.
+		* @return Returns AsyncIOService Single Instance.
+		*/
+		static std::shared_ptr<AsyncIOService>& Get() { return m_AsyncIOService; }
+
+		/**
+		* @brief Start IO threads.
+		* @param[in] nThreads IO threads count of Thread backend.
+		* @param[in] completionPool The pool callbacks are dispatched to, nullptr for IO threads.
+		* @param[in] isUseIoUring Try io_uring backend.
+		*/
+		void Start(uint32_t nThreads = 2, ThreadPool* completionPool = nullptr, bool isUseIoUring = true);
+
+		/**
+		* @brief Read all queued requests, wait all callbacks and stop IO threads.
+		*/
+		void Stop();
+
+		/**
+		* @brief Submit a request.
+		* If the service is not running, it is read and completed on the calling thread.
+		* @param[in] request The request.
+		*/
+		void Submit(IORequest request);
+
+		/**
+		* @brief Submit requests under one lock.
+		* @param[in] requests The requests, moved from.
+		*/
+		void Submit(std::vector<IORequest>& requests);
+
+		/**
+		* @brief Wait all submitted requests completed and their callbacks returned.
+		* @note Do not call it from a callback.
+		*/
+		void Wait();
+
+		/**
+		* @brief Get the running backend.
+		* @return Returns the backend.
+		*/
+		Backend GetBackend() const { return m_Backend; }
+
+		/**
+		* @brief Determine whether IO threads are running.
+		* @return Returns true if running.
+		*/
+		bool IsRunning() const;
+
+		/**
+		* @brief Get statistics.
+		* @return Returns statistics.
+		*/
+		Stats GetStats() const;
+
+	private:
+
+		/**
+		* @brief Take a batch, highest priority first.
+		* @param[out] outBatch The batch.
+		* @return Returns false if stopped and no request is queued.
+		*/
+		bool PopBatch(std::vector<IORequest>& outBatch);
+
+		/**
+		* @brief Thread backend IO thread function.
+		*/
+		void ThreadFunc();
+
+		/**
+		* @brief IoUring backend submitter thread function.
+		*/
+		void UringFunc();
+
+		/**
+		* @brief Read a batch with FileLibrary.
+		* @param[in] batch The batch.
+		*/
+		void ReadBatch(std::vector<IORequest>& batch);
+
+		/**
+		* @brief Read a batch with io_uring.
+		* @param[in] batch The batch.
+		*/
+		void UringReadBatch(std::vector<IORequest>& batch);
+
+		/**
+		* @brief Count a result and dispatch its callback.
+		* @param[in] request The request.
+		* @param[in] result The result.
+		*/
+		void Complete(IORequest& request, IOResult&& result);
+
+		/**
+		* @brief Finish a request after its callback returned.
+		*/
+		void Finish();
+
+	private:
+
+		/**
+		* @brief io_uring rings, defined in cpp.
+		*/
+		struct Uring;
+
+		/**
+		* @brief AsyncIOService Single Instance.
+		*/
+		static std::shared_ptr<AsyncIOService> m_AsyncIOService;
+
+		/**
+		* @brief Queues of requests, one per priority.
+		*/
+		std::array<std::deque<IORequest>, static_cast<size_t>(IOPriority::Count)> m_Queues;
+
+		/**
+		* @brief Mutex of queues and in-flight count.
+		*/
+		mutable std::mutex m_Mutex;
+
+		/**
+		* @brief Notify IO threads of requests or stop.
+		*/
+		std::condition_variable m_NotEmpty;
+
+		/**
+		* @brief Notify Wait all requests finished.
+		*/
+		std::condition_variable m_Idle;
+
+		/**
+		* @brief Submitted requests whose callback has not returned.
+		*/
+		uint64_t m_InFlight = 0;
+
+		/**
+		* @brief True if IO threads are running.
+		*/
+		bool m_IsRunning = false;
+
+		/**
+		* @brief IO threads.
+		*/
+		std::vector<std::thread> m_Threads;
+
+		/**
+		* @brief Callbacks pool.
+		*/
+		ThreadPool* m_CompletionPool = nullptr;
+
+		/**
+		* @brief Running backend.
+		*/
+		Backend m_Backend = Backend::Thread;
+
+		/**
+		* @brief io_uring rings, nullptr on Thread backend.
+		*/
+		std::unique_ptr<Uring> m_Uring;
+
+		/**
+		* @brief Statistics counters.
+		*/
+		std::atomic<uint64_t> m_Submitted = 0;
+		std::atomic<uint64_t> m_Completed = 0;
+		std::atomic<uint64_t> m_Failed    = 0;
+		std::atomic<uint64_t> m_Bytes     = 0;
+		std::atomic<uint64_t> m_Batches   = 0;
+	};
+}
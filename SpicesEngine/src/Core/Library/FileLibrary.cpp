@@ -9,16 +9,38 @@
 
 #include <commdlg.h>
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace Spices {
 
+	namespace {
+
+		/**
+		* @brief Count of stat calls.
+		*/
+		std::atomic<uint64_t> statCount = 0;
+	}
+
 	bool FileLibrary::FileLibrary_Exists(const char* path)
 	{
 		SPICES_PROFILE_ZONE;
 
+		statCount.fetch_add(1, std::memory_order_relaxed);
+
 		struct _stat buffer {};
 		return _stat (path, &buffer) == 0;
 	}
 
+	uint64_t FileLibrary::FileLibrary_StatCount()
+	{
+		return statCount.load(std::memory_order_relaxed);
+	}
+
 	bool FileLibrary::FileLibrary_Open(const char* path, FileModes mode, bool binary, FileHandle* out_handle)
 	{
 		SPICES_PROFILE_ZONE;
@@ -79,16 +101,50 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		if (handle->handle) 
+		if (handle->handle && out_size) 
 		{
-			auto state = fseek(static_cast<FILE*>(handle->handle), 0, SEEK_END);
-			*out_size = ftell(static_cast<FILE*>(handle->handle));
-			rewind(static_cast<FILE*>(handle->handle));	
+			FILE* file = static_cast<FILE*>(handle->handle);
+
+			/**
+			* @brief 64 bit offsets, ftell is 32 bit long on Windows.
+			*/
+#if defined(_WIN32)
+			const bool isSeek = _fseeki64(file, 0, SEEK_END) == 0;
+			const int64_t size = isSeek ? _ftelli64(file) : -1;
+#else
+			const bool isSeek = fseeko(file, 0, SEEK_END) == 0;
+			const int64_t size = isSeek ? static_cast<int64_t>(ftello(file)) : -1;
+#endif
+
+			rewind(file);
+
+			if (size < 0)
+			{
+				*out_size = 0;
+				return false;
+			}
+
+			*out_size = static_cast<uint64_t>(size);
 			return true;
 		}
 		return false;
 	}
 
+	bool FileLibrary::FileLibrary_Seek(const FileHandle* handle, uint64_t offset)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (handle->handle) 
+		{
+#if defined(_WIN32)
+			return _fseeki64(static_cast<FILE*>(handle->handle), static_cast<int64_t>(offset), SEEK_SET) == 0;
+#else
+			return fseeko(static_cast<FILE*>(handle->handle), static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+		}
+		return false;
+	}
+
 	bool FileLibrary::FileLibrary_Read(const FileHandle* handle, uint64_t data_size, void* out_data, uint64_t* out_bytes_read)
 	{
 		SPICES_PROFILE_ZONE;
@@ -139,6 +195,112 @@ namespace Spices {
 		return false;
 	}
 
+	bool FileLibrary::FileLibrary_Map(const char* path, MappedFileHandle* out_handle)
+	{
+		SPICES_PROFILE_ZONE;
+
+		*out_handle = MappedFileHandle{};
+
+#if defined(_WIN32)
+
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			std::stringstream ss;
+			ss << "Error mapping file: " << path;
+
+			SPICES_CORE_WARN(ss.str().c_str());
+			return false;
+		}
+
+		LARGE_INTEGER size{};
+		GetFileSizeEx(file, &size);
+
+		out_handle->file = file;
+		out_handle->size = static_cast<uint64_t>(size.QuadPart);
+
+		/**
+		* @brief Empty file can not be mapped.
+		*/
+		if (out_handle->size > 0)
+		{
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			void*  view    = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+			if (!view)
+			{
+				if (mapping) CloseHandle(mapping);
+				CloseHandle(file);
+
+				*out_handle = MappedFileHandle{};
+				return false;
+			}
+
+			out_handle->mapping = mapping;
+			out_handle->data    = static_cast<const char*>(view);
+		}
+
+#else
+
+		const int file = open(path, O_RDONLY);
+		if (file < 0)
+		{
+			std::stringstream ss;
+			ss << "Error mapping file: " << path;
+
+			SPICES_CORE_WARN(ss.str().c_str());
+			return false;
+		}
+
+		struct stat status {};
+		fstat(file, &status);
+
+		out_handle->file = reinterpret_cast<void*>(static_cast<intptr_t>(file));
+		out_handle->size = static_cast<uint64_t>(status.st_size);
+
+		if (out_handle->size > 0)
+		{
+			void* view = mmap(nullptr, out_handle->size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (view == MAP_FAILED)
+			{
+				close(file);
+
+				*out_handle = MappedFileHandle{};
+				return false;
+			}
+
+			out_handle->data = static_cast<const char*>(view);
+		}
+
+#endif
+
+		out_handle->is_valid = true;
+
+		return true;
+	}
+
+	void FileLibrary::FileLibrary_UnMap(MappedFileHandle* handle)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!handle->is_valid) return;
+
+#if defined(_WIN32)
+
+		if (handle->data)    UnmapViewOfFile(handle->data);
+		if (handle->mapping) CloseHandle(static_cast<HANDLE>(handle->mapping));
+		CloseHandle(static_cast<HANDLE>(handle->file));
+
+#else
+
+		if (handle->data) munmap(const_cast<char*>(handle->data), handle->size);
+		close(static_cast<int>(reinterpret_cast<intptr_t>(handle->file)));
+
+#endif
+
+		*handle = MappedFileHandle{};
+	}
+
 	bool FileLibrary::FileLibrary_Write(const FileHandle* handle, uint64_t data_size, const void* data, uint64_t* out_bytes_written)
 	{
 		SPICES_PROFILE_ZONE;
@@ -26,6 +26,39 @@ namespace Spices {
         bool is_valid;
     };
 
+    /**
+    * @brief This Struct is read only memory mapped file Wrapper.
+    */
+    struct MappedFileHandle {
+
+        /**
+        * @brief Mapped bytes, nullptr if file is empty.
+        */
+        const char* data = nullptr;
+
+        /**
+        * @brief Bytes of file.
+        */
+        uint64_t size = 0;
+
+        /**
+        * @brief OS file handle.
+        * Need cast while use.
+        */
+        void* file = nullptr;
+
+        /**
+        * @brief OS mapping handle.
+        * Need cast while use.
+        */
+        void* mapping = nullptr;
+
+        /**
+        * @brief Is this handle Valid.
+        */
+        bool is_valid = false;
+    };
+
     /**
     * @brief file mode
     */
@@ -56,6 +89,12 @@ namespace Spices {
         */
         static bool FileLibrary_Exists(const char* path);
 
+        /**
+        * @brief Get count of file stat calls made by FileLibrary_Exists.
+        * @return Returns count of stat calls.
+        */
+        static uint64_t FileLibrary_StatCount();
+
         /**
         * @brief Open the file using given string.
         * @param[in] path The file path.
@@ -81,10 +120,19 @@ namespace Spices {
         * @brief Calculate The file size.
         * @param[in] handle The file handle.
         * @param[out] out_size The file size(byte).
-        * @return true if file handle is valid.
+        * @return true if file handle is valid and the size is known.
+        * @note The file pointer is rewound to the beginning.
         */
         static bool FileLibrary_Size(const FileHandle* handle, uint64_t* out_size);
 
+        /**
+        * @brief Move the file pointer to a offset from the beginning.
+        * @param[in] handle The file handle.
+        * @param[in] offset The offset(byte).
+        * @return true if file handle is valid and seek succeed.
+        */
+        static bool FileLibrary_Seek(const FileHandle* handle, uint64_t offset);
+
         /**
         * @brief Read Specific size of data form the current file handle pointer, and move pointer the same size.
         * @param[in] handle The file handle.
@@ -124,6 +172,20 @@ namespace Spices {
         */
         static bool FileLibrary_Read_all_bytes(const FileHandle* handle, char* out_bytes, uint64_t* out_bytes_read);
 
+        /**
+        * @brief Map a whole file read only, pages are loaded by OS on first access.
+        * @param[in] path The file path.
+        * @param[out] out_handle Out The mapped file handle pointer.
+        * @return true if map the file succeed.
+        */
+        static bool FileLibrary_Map(const char* path, MappedFileHandle* out_handle);
+
+        /**
+        * @brief UnMap the file by the mapped file handle.
+        * @param[in] handle The mapped file handle.
+        */
+        static void FileLibrary_UnMap(MappedFileHandle* handle);
+
         /**
         * @brief Write given data to the file handle pointer.
         * @param[in] handle The file handle.
@@ -0,0 +1,454 @@
+/**
+* @file AsyncLogger.cpp.
+* @brief The AsyncLogger Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "AsyncLogger.h"
+
+#include <spdlog/sinks/sink.h>
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Ids of AsyncLogger, never reused.
+		*/
+		std::atomic<uint64_t> s_NextLoggerId { 1 };
+
+		/**
+		* @brief Minimum bytes of a ring.
+		*/
+		constexpr uint64_t s_MinRingBytes = 4096;
+
+		/**
+		* @brief Background thread sleeps this long if no records.
+		*/
+		constexpr auto s_IdleWait = std::chrono::milliseconds(2);
+	}
+
+	AsyncLogger::AsyncLogger(
+		std::vector<spdlog::sink_ptr> sinks     ,
+		uint32_t                      ringBytes ,
+		OverflowPolicy                policy
+	)
+		: m_Id(s_NextLoggerId.fetch_add(1, std::memory_order_relaxed))
+		, m_Sinks(std::move(sinks))
+		, m_RingBytes(s_MinRingBytes)
+		, m_Policy(policy)
+		, m_Level(spdlog::level::trace)
+		, m_Written(0)
+		, m_DroppedReported(0)
+		, m_FlushRequested(0)
+		, m_FlushCompleted(0)
+		, m_IsRunning(true)
+	{
+		SPICES_PROFILE_ZONE;
+
+		while (m_RingBytes < ringBytes) m_RingBytes <<= 1;
+
+		m_Thread = std::thread([this]() { Run(); });
+	}
+
+	AsyncLogger::~AsyncLogger()
+	{
+		SPICES_PROFILE_ZONE;
+
+		{
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+			m_IsRunning.store(false, std::memory_order_release);
+		}
+
+		m_WakeCondition.notify_all();
+		m_FlushCondition.notify_all();
+
+		if (m_Thread.joinable()) m_Thread.join();
+	}
+
+	void AsyncLogger::Flush()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_WakeMutex);
+
+		const uint64_t ticket = ++m_FlushRequested;
+		m_WakeCondition.notify_all();
+
+		m_FlushCondition.wait(lock, [&]() {
+			return m_FlushCompleted >= ticket || !m_IsRunning.load(std::memory_order_acquire);
+		});
+	}
+
+	AsyncLogger::Stats AsyncLogger::GetStats() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_RingsMutex);
+
+		Stats stats = m_Retired;
+
+		for (const auto& ring : m_Rings)
+		{
+			stats.pushed  += ring->pushed .load(std::memory_order_relaxed);
+			stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+			stats.blocked += ring->blocked.load(std::memory_order_relaxed);
+		}
+
+		stats.written = m_Written.load(std::memory_order_relaxed);
+		stats.threads = m_Rings.size();
+
+		return stats;
+	}
+
+	AsyncLogger::Ring* AsyncLogger::GetRing()
+	{
+		/**
+		* @brief Rings of calling thread, marked not alive on thread exit.
+		*/
+		struct ThreadRings
+		{
+			std::vector<std::pair<uint64_t, std::shared_ptr<Ring>>> rings;
+
+			~ThreadRings()
+			{
+				for (auto& ring : rings) ring.second->isAlive.store(false, std::memory_order_release);
+			}
+		};
+
+		static thread_local ThreadRings threadRings;
+
+		for (auto& ring : threadRings.rings)
+		{
+			if (ring.first == m_Id) return ring.second.get();
+		}
+
+		/**
+		* @brief Forget rings of destroyed loggers.
+		*/
+		auto& rings = threadRings.rings;
+		rings.erase(std::remove_if(rings.begin(), rings.end(), [](const auto& ring) {
+			return ring.second->isOrphan.load(std::memory_order_acquire);
+		}), rings.end());
+
+		auto ring = std::make_shared<Ring>(m_RingBytes);
+
+		{
+			std::unique_lock<std::mutex> lock(m_RingsMutex);
+			m_Rings.push_back(ring);
+		}
+
+		rings.emplace_back(m_Id, ring);
+
+		return ring.get();
+	}
+
+	char* AsyncLogger::Reserve(uint64_t size, Ring*& outRing)
+	{
+		Ring* ring = GetRing();
+		outRing = ring;
+
+		if (size > ring->capacity / 4)
+		{
+			ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		const uint64_t head       = ring->head.load(std::memory_order_relaxed);
+		const uint64_t offset     = head & (ring->capacity - 1);
+		const uint64_t contiguous = ring->capacity - offset;
+
+		/**
+		* @brief A record never wraps, the rest of ring is skipped.
+		*/
+		const uint64_t padding = contiguous < size ? contiguous : 0;
+
+		bool isBlocked = false;
+		while (head + padding + size - ring->tail.load(std::memory_order_acquire) > ring->capacity)
+		{
+			if (m_Policy == OverflowPolicy::Drop || !m_IsRunning.load(std::memory_order_acquire))
+			{
+				ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			if (!isBlocked)
+			{
+				isBlocked = true;
+				ring->blocked.store(ring->blocked.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			}
+
+			m_WakeCondition.notify_one();
+			std::this_thread::yield();
+		}
+
+		/**
+		* @brief Padding record, background thread skips it. Less than a header is skipped implicitly.
+		*/
+		if (padding >= sizeof(Record))
+		{
+			Record record {};
+			record.size   = static_cast<uint32_t>(padding);
+			record.format = nullptr;
+
+			std::memcpy(ring->Bytes() + offset, &record, sizeof(Record));
+		}
+
+		ring->pending = head + padding + size;
+
+		return ring->Bytes() + ((head + padding) & (ring->capacity - 1));
+	}
+
+	void AsyncLogger::Commit(Ring* ring)
+	{
+		ring->pushed.store(ring->pushed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		ring->head.store(ring->pending, std::memory_order_release);
+	}
+
+	void AsyncLogger::Run()
+	{
+		bool isDirty = false;
+
+		while (m_IsRunning.load(std::memory_order_acquire))
+		{
+			const uint64_t written = Drain();
+			isDirty |= written > 0;
+
+			/**
+			* @brief Serve flush requests.
+			*/
+			std::unique_lock<std::mutex> lock(m_WakeMutex);
+
+			const uint64_t ticket = m_FlushRequested;
+			if (ticket != m_FlushCompleted)
+			{
+				lock.unlock();
+
+				Drain();
+				FlushSinks();
+				isDirty = false;
+
+				lock.lock();
+				m_FlushCompleted = ticket;
+				m_FlushCondition.notify_all();
+
+				continue;
+			}
+
+			if (written > 0) continue;
+
+			/**
+			* @brief Flush sinks once idle.
+			*/
+			if (isDirty)
+			{
+				lock.unlock();
+
+				FlushSinks();
+				isDirty = false;
+
+				continue;
+			}
+
+			m_WakeCondition.wait_for(lock, s_IdleWait);
+		}
+
+		Drain();
+		FlushSinks();
+
+		/**
+		* @brief Rings may still be cached by threads.
+		*/
+		std::unique_lock<std::mutex> lock(m_RingsMutex);
+		for (auto& ring : m_Rings) ring->isOrphan.store(true, std::memory_order_release);
+	}
+
+	uint64_t AsyncLogger::Drain()
+	{
+		SPICES_PROFILE_ZONE;
+
+		{
+			std::unique_lock<std::mutex> lock(m_RingsMutex);
+			m_Draining = m_Rings;
+		}
+
+		std::vector<Cursor>& cursors = m_Cursors;
+		cursors.clear();
+
+		for (auto& ring : m_Draining)
+		{
+			const bool isAlive = ring->isAlive.load(std::memory_order_acquire);
+
+			Cursor cursor;
+			cursor.ring   = ring.get();
+			cursor.tail   = ring->tail.load(std::memory_order_relaxed);
+			cursor.head   = ring->head.load(std::memory_order_acquire);
+			cursor.record = nullptr;
+
+			if (cursor.tail == cursor.head && !isAlive)
+			{
+				RetireRing(ring);
+				continue;
+			}
+
+			cursors.push_back(cursor);
+		}
+
+		m_Draining.clear();
+
+		/**
+		* @brief Next record of a cursor, skipping padding.
+		*/
+		const auto peek = [](Cursor& cursor) {
+			Ring* ring = cursor.ring;
+
+			while (cursor.tail < cursor.head)
+			{
+				const uint64_t offset = cursor.tail & (ring->capacity - 1);
+
+				if (ring->capacity - offset < sizeof(Record))
+				{
+					cursor.tail += ring->capacity - offset;
+					continue;
+				}
+
+				const Record* record = reinterpret_cast<const Record*>(ring->Bytes() + offset);
+				if (!record->format)
+				{
+					cursor.tail += record->size;
+					continue;
+				}
+
+				cursor.record = record;
+				return;
+			}
+
+			cursor.record = nullptr;
+			ring->tail.store(cursor.tail, std::memory_order_release);
+		};
+
+		for (auto& cursor : cursors) peek(cursor);
+
+		/**
+		* @brief Merge rings by time, so records of threads interleave as logged.
+		*/
+		uint64_t written = 0;
+		while (true)
+		{
+			Cursor* next = nullptr;
+			for (auto& cursor : cursors)
+			{
+				if (cursor.record && (!next || cursor.record->time < next->record->time)) next = &cursor;
+			}
+
+			if (!next) break;
+
+			const Record& record = *next->record;
+			const char*   bytes  = reinterpret_cast<const char*>(&record) + sizeof(Record);
+
+			std::string_view fmt;
+			if (record.fmt)
+			{
+				fmt = std::string_view(record.fmt, record.fmtSize);
+			}
+			else
+			{
+				fmt = std::string_view(bytes, record.fmtSize);
+				bytes += record.fmtSize;
+			}
+
+			m_Buffer.clear();
+			record.format(fmt, bytes, m_Buffer);
+
+			/**
+			* @brief Sinks may read payload as a c string.
+			*/
+			m_Buffer.push_back('\0');
+
+			WriteToSinks(record.logger, static_cast<spdlog::level::level_enum>(record.level), record.time, std::string_view(m_Buffer.data(), m_Buffer.size() - 1));
+			written++;
+
+			next->tail += record.size;
+			next->ring->tail.store(next->tail, std::memory_order_release);
+
+			peek(*next);
+		}
+
+		m_Written.fetch_add(written, std::memory_order_relaxed);
+
+		ReportDropped();
+
+		return written;
+	}
+
+	void AsyncLogger::RetireRing(const std::shared_ptr<Ring>& ring)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_RingsMutex);
+
+		const auto it = std::find(m_Rings.begin(), m_Rings.end(), ring);
+		if (it == m_Rings.end()) return;
+
+		m_Retired.pushed  += ring->pushed .load(std::memory_order_relaxed);
+		m_Retired.dropped += ring->dropped.load(std::memory_order_relaxed);
+		m_Retired.blocked += ring->blocked.load(std::memory_order_relaxed);
+
+		m_Rings.erase(it);
+	}
+
+	void AsyncLogger::ReportDropped()
+	{
+		const uint64_t dropped = GetStats().dropped;
+		if (dropped <= m_DroppedReported) return;
+
+		std::stringstream ss;
+		ss << "AsyncLogger dropped " << dropped - m_DroppedReported << " records, ring is full.";
+
+		m_DroppedReported = dropped;
+
+		const std::string message = ss.str();
+		WriteToSinks("AsyncLogger", spdlog::level::warn, spdlog::log_clock::now().time_since_epoch().count(), message);
+	}
+
+	void AsyncLogger::WriteToSinks(const char* logger, spdlog::level::level_enum level, int64_t time, std::string_view message)
+	{
+		const spdlog::details::log_msg msg(
+			spdlog::log_clock::time_point(spdlog::log_clock::duration(time)) ,
+			spdlog::source_loc{}                                             ,
+			spdlog::string_view_t(logger)                                    ,
+			level                                                            ,
+			spdlog::string_view_t(message.data(), message.size())
+		);
+
+		for (auto& sink : m_Sinks)
+		{
+			if (!sink->should_log(level)) continue;
+
+			try
+			{
+				sink->log(msg);
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "AsyncLogger: sink failed: " << e.what() << std::endl;
+			}
+		}
+	}
+
+	void AsyncLogger::FlushSinks()
+	{
+		for (auto& sink : m_Sinks)
+		{
+			try
+			{
+				sink->flush();
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "AsyncLogger: sink flush failed: " << e.what() << std::endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,552 @@
+/**
+* @file AsyncLogger.h
+* @brief The AsyncLogger Class Definitions and Implementation.
+* @author Spices.
+*/
+
+#pragma once
+
+#pragma warning(push, 0)
+#include <spdlog/spdlog.h>
+#pragma warning(pop)
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Spices {
+
+	/**
+	* @brief Logger writing records to per-thread lock-free ring buffers, formatted by a background thread.
+	* A log call copies a record (time, level, format string pointer, raw arguments) into the calling thread's
+	* single producer single consumer ring, the background thread merges rings by time, formats records
+	* and fans them out to spdlog sinks.
+	* A const char array format string is kept by pointer, it must be a string literal, other format strings are copied.
+	* Arithmetic, enum and pointer arguments are copied raw, string arguments are copied as bytes,
+	* other arguments are formatted on the calling thread.
+	* A record not fitting its ring is dropped (Drop) or waits for the background thread (Block),
+	* dropped records are counted and reported through sinks.
+	*/
+	class AsyncLogger
+	{
+	public:
+
+		/**
+		* @brief What a log call does if its ring is full.
+		*/
+		enum class OverflowPolicy : uint8_t
+		{
+			Drop  = 0,     /* @brief Drop the record, never waits.               */
+			Block = 1,     /* @brief Wait until the background thread frees room. */
+		};
+
+		/**
+		* @brief Statistics.
+		*/
+		struct Stats
+		{
+			uint64_t pushed  = 0;    /* @brief Records pushed to rings.          */
+			uint64_t dropped = 0;    /* @brief Records dropped.                  */
+			uint64_t blocked = 0;    /* @brief Log calls waited for room.        */
+			uint64_t written = 0;    /* @brief Records written to sinks.         */
+			uint64_t threads = 0;    /* @brief Rings alive.                      */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* Start the background thread.
+		* @param[in] sinks Sinks records are written to.
+		* @param[in] ringBytes Bytes of a thread's ring, rounded up to power of 2.
+		* @param[in] policy What a log call does if its ring is full.
+		*/
+		AsyncLogger(
+			std::vector<spdlog::sink_ptr> sinks                             ,
+			uint32_t                      ringBytes = 1 << 20               ,
+			OverflowPolicy                policy    = OverflowPolicy::Drop
+		);
+
+		/**
+		* @brief Destructor Function.
+		* Write all pushed records and stop the background thread.
+		*/
+		virtual ~AsyncLogger();
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		AsyncLogger(const AsyncLogger&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+		/**
+		* @brief Push a record.
+		* @param[in] logger Logger name, must outlive this AsyncLogger.
+		* @param[in] level Record level.
+		* @param[in] fmt Format string, or the message if no args.
+		* @param[in] args Format arguments.
+		* @return Returns false if filtered or dropped.
+		*/
+		template<typename Fmt, typename... Args>
+		bool Log(const char* logger, spdlog::level::level_enum level, Fmt&& fmt, const Args&... args);
+
+		/**
+		* @brief Wait until records pushed before are written, then flush sinks.
+		*/
+		void Flush();
+
+		/**
+		* @brief Set minimum level written.
+		* @param[in] level The level.
+		*/
+		void SetLevel(spdlog::level::level_enum level) { m_Level.store(level, std::memory_order_relaxed); }
+
+		/**
+		* @brief Determine whether a level is written.
+		* @param[in] level The level.
+		* @return Returns true if written.
+		*/
+		bool ShouldLog(spdlog::level::level_enum level) const { return level >= m_Level.load(std::memory_order_relaxed); }
+
+		/**
+		* @brief Get statistics.
+		* @return Returns statistics.
+		*/
+		Stats GetStats() const;
+
+	private:
+
+		/**
+		* @brief Formats a record's payload.
+		*/
+		using FormatFunc = void(*)(std::string_view fmt, const char* args, spdlog::memory_buf_t& out);
+
+		/**
+		* @brief Record header in ring, followed by the copied format string and arguments.
+		*/
+		struct Record
+		{
+			uint32_t    size;          /* @brief Bytes of record, 8 aligned.              */
+			uint32_t    fmtSize;       /* @brief Bytes of format string.                  */
+			FormatFunc  format;        /* @brief Format function, nullptr if padding.     */
+			const char* logger;        /* @brief Logger name.                             */
+			const char* fmt;           /* @brief Format string, nullptr if copied.        */
+			int64_t     time;          /* @brief Log time, log_clock ticks.               */
+			int32_t     level;         /* @brief Record level.                            */
+			uint32_t    reserved;      /* @brief Reserved.                                */
+		};
+
+		/**
+		* @brief A thread's single producer single consumer ring.
+		*/
+		struct Ring
+		{
+			explicit Ring(uint64_t capacity) : data(capacity / sizeof(uint64_t)), capacity(capacity) {}
+
+			std::vector<uint64_t>             data;                 /* @brief Bytes, 8 aligned.                     */
+			uint64_t                          capacity;             /* @brief Bytes, power of 2.                    */
+			alignas(64) std::atomic<uint64_t> head    { 0 };        /* @brief Written by producer.                  */
+			alignas(64) std::atomic<uint64_t> tail    { 0 };        /* @brief Written by background thread.         */
+			alignas(64) std::atomic<uint64_t> pushed  { 0 };        /* @brief Records pushed, producer only.        */
+			std::atomic<uint64_t>             dropped { 0 };        /* @brief Records dropped, producer only.       */
+			std::atomic<uint64_t>             blocked { 0 };        /* @brief Log calls waited, producer only.      */
+			std::atomic<bool>                 isAlive { true };     /* @brief False once producer thread exits.     */
+			std::atomic<bool>                 isOrphan{ false };    /* @brief True once AsyncLogger is destroyed.   */
+			uint64_t                          pending = 0;          /* @brief Head after reserved record.           */
+
+			char* Bytes() { return reinterpret_cast<char*>(data.data()); }
+		};
+
+		/**
+		* @brief Records of a ring visible when a drain starts.
+		*/
+		struct Cursor
+		{
+			Ring*         ring;          /* @brief The ring.                       */
+			uint64_t      tail;          /* @brief Next record.                    */
+			uint64_t      head;          /* @brief End of visible records.         */
+			const Record* record;        /* @brief Next record, nullptr if none.   */
+		};
+
+		/**
+		* @brief Get calling thread's ring, created on first use.
+		* @return Returns the ring.
+		*/
+		Ring* GetRing();
+
+		/**
+		* @brief Reserve bytes of a record in calling thread's ring.
+		* @param[in] size Bytes of record, 8 aligned.
+		* @param[out] outRing The ring.
+		* @return Returns the record bytes, nullptr if dropped.
+		*/
+		char* Reserve(uint64_t size, Ring*& outRing);
+
+		/**
+		* @brief Publish a reserved record.
+		* @param[in] ring The ring.
+		*/
+		void Commit(Ring* ring);
+
+		/**
+		* @brief Background thread.
+		*/
+		void Run();
+
+		/**
+		* @brief Write all records visible to background thread.
+		* @return Returns count of records written.
+		*/
+		uint64_t Drain();
+
+		/**
+		* @brief Remove a drained ring of a exited thread.
+		* @param[in] ring The ring.
+		*/
+		void RetireRing(const std::shared_ptr<Ring>& ring);
+
+		/**
+		* @brief Write a warn to sinks if records were dropped since last report.
+		*/
+		void ReportDropped();
+
+		/**
+		* @brief Write a formatted message to sinks.
+		* @param[in] logger Logger name.
+		* @param[in] level Record level.
+		* @param[in] time Log time, log_clock ticks.
+		* @param[in] message The message.
+		*/
+		void WriteToSinks(const char* logger, spdlog::level::level_enum level, int64_t time, std::string_view message);
+
+		/**
+		* @brief Flush all sinks.
+		*/
+		void FlushSinks();
+
+	private:
+
+		/**
+		* @brief Argument stored in ring.
+		* Strings are stored as bytes, enums as underlying type, others not copied raw are formatted.
+		*/
+		template<typename T, typename = void>
+		struct Stored { using Type = std::string; };
+
+		template<typename T>
+		struct Stored<T, std::enable_if_t<std::is_arithmetic_v<T>>> { using Type = T; };
+
+		template<typename T>
+		struct Stored<T, std::enable_if_t<std::is_enum_v<T>>> { using Type = std::underlying_type_t<T>; };
+
+		template<typename T>
+		struct Stored<T, std::enable_if_t<std::is_pointer_v<T>>> { using Type = const void*; };
+
+		/**
+		* @brief True if T is stored as bytes.
+		*/
+		template<typename T>
+		static constexpr bool IsString =
+			std::is_same_v<std::decay_t<T>, std::string>       ||
+			std::is_same_v<std::decay_t<T>, std::string_view>  ||
+			std::is_same_v<std::decay_t<T>, const char*>       ||
+			std::is_same_v<std::decay_t<T>, char*>;
+
+		template<typename T>
+		using StoredT = std::conditional_t<IsString<T>, std::string, typename Stored<std::decay_t<T>>::Type>;
+
+		/**
+		* @brief Bytes of a argument in ring.
+		*/
+		template<typename T>
+		static uint64_t ArgSize(const T& arg);
+
+		/**
+		* @brief Copy a argument to ring.
+		*/
+		template<typename T>
+		static char* WriteArg(char* dst, const T& arg);
+
+		/**
+		* @brief Read a argument from ring.
+		*/
+		template<typename S>
+		static auto ReadArg(const char*& src);
+
+		/**
+		* @brief Format function of a argument list.
+		*/
+		template<typename... S>
+		static void Format(std::string_view fmt, const char* args, spdlog::memory_buf_t& out);
+
+		/**
+		* @brief Arguments formatted on calling thread.
+		*/
+		template<typename T>
+		static decltype(auto) Prepare(const T& arg);
+
+	private:
+
+		/**
+		* @brief Unique id of this logger, tells thread cached rings apart.
+		*/
+		uint64_t m_Id;
+
+		/**
+		* @brief Sinks.
+		*/
+		std::vector<spdlog::sink_ptr> m_Sinks;
+
+		/**
+		* @brief Bytes of a ring.
+		*/
+		uint64_t m_RingBytes;
+
+		/**
+		* @brief Overflow policy.
+		*/
+		OverflowPolicy m_Policy;
+
+		/**
+		* @brief Minimum level written.
+		*/
+		std::atomic<int> m_Level;
+
+		/**
+		* @brief Rings of all threads.
+		*/
+		std::vector<std::shared_ptr<Ring>> m_Rings;
+
+		/**
+		* @brief Mutex of m_Rings.
+		*/
+		mutable std::mutex m_RingsMutex;
+
+		/**
+		* @brief Statistics of retired rings.
+		*/
+		Stats m_Retired;
+
+		/**
+		* @brief Rings drained by background thread, reused.
+		*/
+		std::vector<std::shared_ptr<Ring>> m_Draining;
+
+		/**
+		* @brief Cursors of drained rings, reused.
+		*/
+		std::vector<Cursor> m_Cursors;
+
+		/**
+		* @brief Format buffer of background thread.
+		*/
+		spdlog::memory_buf_t m_Buffer;
+
+		/**
+		* @brief Records written.
+		*/
+		std::atomic<uint64_t> m_Written;
+
+		/**
+		* @brief Dropped records reported.
+		*/
+		uint64_t m_DroppedReported;
+
+		/**
+		* @brief Wakes background thread.
+		*/
+		std::mutex              m_WakeMutex;
+		std::condition_variable m_WakeCondition;
+
+		/**
+		* @brief Flush tickets.
+		*/
+		uint64_t                m_FlushRequested;
+		uint64_t                m_FlushCompleted;
+		std::condition_variable m_FlushCondition;
+
+		/**
+		* @brief True while background thread runs.
+		*/
+		std::atomic<bool> m_IsRunning;
+
+		/**
+		* @brief Background thread.
+		*/
+		std::thread m_Thread;
+	};
+
+	template<typename T>
+	inline decltype(auto) AsyncLogger::Prepare(const T& arg)
+	{
+		if constexpr (IsString<T> || !std::is_same_v<StoredT<T>, std::string>)
+		{
+			return (arg);
+		}
+		else
+		{
+			return fmt::format("{}", arg);
+		}
+	}
+
+	template<typename T>
+	inline uint64_t AsyncLogger::ArgSize(const T& arg)
+	{
+		if constexpr (std::is_same_v<std::decay_t<T>, std::string> || std::is_same_v<std::decay_t<T>, std::string_view>)
+		{
+			return sizeof(uint32_t) + arg.size();
+		}
+		else if constexpr (IsString<T>)
+		{
+			return sizeof(uint32_t) + (arg ? std::strlen(arg) : 0);
+		}
+		else
+		{
+			return sizeof(StoredT<T>);
+		}
+	}
+
+	template<typename T>
+	inline char* AsyncLogger::WriteArg(char* dst, const T& arg)
+	{
+		if constexpr (IsString<T>)
+		{
+			std::string_view str;
+			if constexpr (std::is_pointer_v<std::decay_t<T>>) str = arg ? std::string_view(arg) : std::string_view();
+			else                                              str = arg;
+
+			const uint32_t size = static_cast<uint32_t>(str.size());
+			std::memcpy(dst, &size, sizeof(size));
+			std::memcpy(dst + sizeof(size), str.data(), size);
+
+			return dst + sizeof(size) + size;
+		}
+		else
+		{
+			const StoredT<T> value = static_cast<StoredT<T>>(arg);
+			std::memcpy(dst, &value, sizeof(value));
+
+			return dst + sizeof(value);
+		}
+	}
+
+	template<typename S>
+	inline auto AsyncLogger::ReadArg(const char*& src)
+	{
+		if constexpr (std::is_same_v<S, std::string>)
+		{
+			uint32_t size = 0;
+			std::memcpy(&size, src, sizeof(size));
+
+			const fmt::string_view str(src + sizeof(size), size);
+			src += sizeof(size) + size;
+
+			return str;
+		}
+		else
+		{
+			S value;
+			std::memcpy(&value, src, sizeof(value));
+			src += sizeof(value);
+
+			return value;
+		}
+	}
+
+	template<typename... S>
+	inline void AsyncLogger::Format(std::string_view fmt, const char* args, spdlog::memory_buf_t& out)
+	{
+		if constexpr (sizeof...(S) == 0)
+		{
+			out.append(fmt.data(), fmt.data() + fmt.size());
+		}
+		else
+		{
+			/**
+			* @brief Braced init list keeps reading order.
+			*/
+			std::tuple<decltype(ReadArg<S>(args))...> values{ ReadArg<S>(args)... };
+
+			try
+			{
+				std::apply([&](auto&... v) {
+					fmt::vformat_to(std::back_inserter(out), fmt::string_view(fmt.data(), fmt.size()), fmt::make_format_args(v...));
+				}, values);
+			}
+			catch (const std::exception& e)
+			{
+				out.clear();
+				out.append(fmt.data(), fmt.data() + fmt.size());
+
+				const std::string_view error = " [format error: ";
+				out.append(error.data(), error.data() + error.size());
+				out.append(e.what(), e.what() + std::strlen(e.what()));
+				out.push_back(']');
+			}
+		}
+	}
+
+	template<typename Fmt, typename... Args>
+	inline bool AsyncLogger::Log(const char* logger, spdlog::level::level_enum level, Fmt&& fmt, const Args&... args)
+	{
+		if (!ShouldLog(level)) return false;
+
+		const int64_t time = spdlog::log_clock::now().time_since_epoch().count();
+
+		/**
+		* @brief A string literal is kept by pointer.
+		*/
+		using F = std::remove_reference_t<Fmt>;
+		constexpr bool isLiteral = std::is_array_v<F> && std::is_same_v<std::remove_extent_t<F>, const char>;
+
+		std::string_view format;
+		if constexpr (std::is_array_v<F>)                      format = std::string_view(fmt, std::char_traits<char>::length(fmt));
+		else if constexpr (std::is_pointer_v<std::decay_t<F>>) format = fmt ? std::string_view(fmt) : std::string_view();
+		else                                                   format = std::string_view(fmt);
+
+		return [&](const auto&... prepared) {
+			uint64_t size = sizeof(Record) + (isLiteral ? 0 : format.size());
+			((size += ArgSize(prepared)), ...);
+			size = (size + 7) & ~uint64_t(7);
+
+			Ring* ring = nullptr;
+			char* dst  = Reserve(size, ring);
+			if (!dst) return false;
+
+			Record record;
+			record.size     = static_cast<uint32_t>(size);
+			record.fmtSize  = static_cast<uint32_t>(format.size());
+			record.format   = &Format<StoredT<Args>...>;
+			record.logger   = logger;
+			record.fmt      = isLiteral ? format.data() : nullptr;
+			record.time     = time;
+			record.level    = static_cast<int32_t>(level);
+			record.reserved = 0;
+
+			std::memcpy(dst, &record, sizeof(Record));
+
+			char* cursor = dst + sizeof(Record);
+			if (!isLiteral)
+			{
+				std::memcpy(cursor, format.data(), format.size());
+				cursor += format.size();
+			}
+			((cursor = WriteArg(cursor, prepared)), ...);
+
+			Commit(ring);
+			return true;
+		}(Prepare(args)...);
+	}
+}
@@ -6,75 +6,12 @@
 
 #pragma once
 #include "Core/Core.h"
+#include "ConsoleStore.h"
 
-#include <spdlog/sinks/basic_file_sink.h>
-#include <deque>
+#include <spdlog/sinks/base_sink.h>
 
 namespace Spices {
 
-	/**
-	* @brief Help data of specific level of information.
-	*/
-	struct InfoLevelHelper
-	{
-		/**
-		* @brief Info information.
-		*/
-		std::string str;
-
-		/**
-		* @brief specific level of this information.
-		*/
-		std::string level;
-
-		/**
-		* @brief specific color of this information.
-		*/
-		glm::vec4 color;
-	};
-
-	/**
-	* @brief Console Information Data.
-	*/
-	struct InfoData
-	{
-		/**
-		* @brief trace deque.
-		*/
-		std::deque<InfoLevelHelper> m_TraceLogInfos;
-
-		/**
-		* @brief info deque.
-		*/
-		std::deque<InfoLevelHelper> m_InfoLogInfos;
-
-		/**
-		* @brief warn deque.
-		*/
-		std::deque<InfoLevelHelper> m_WarnLogInfos;
-
-		/**
-		* @brief error deque.
-		*/
-		std::deque<InfoLevelHelper> m_ErrorLogInfos;
-
-		/**
-		* @brief critical deque.
-		*/
-		std::deque<InfoLevelHelper> m_CriticalLogInfos;
-
-		void Clear() 
-		{
-			SPICES_PROFILE_ZONE;
-
-			m_TraceLogInfos.clear();
-			m_InfoLogInfos.clear();
-			m_WarnLogInfos.clear();
-			m_ErrorLogInfos.clear();
-			m_CriticalLogInfos.clear();
-		}
-	};
-
 	/**
 	* @brief Console Entity Class.
 	*/
@@ -85,9 +22,9 @@ namespace Spices {
 		/**
 		* @brief Constructor Function.
 		* @param[in] filePath Console output file.
-		* @param[in] maxInfos Maxiumn Num of Informations.
+		* @param[in] maxLines Maxiumn Num of lines kept.
 		*/
-		Console(const std::string& filePath, uint32_t maxInfos = 50);
+		Console(const std::string& filePath, uint64_t maxLines = ConsoleStore::DefaultMaxLines);
 
 		/**
 		* @brief Destructor Function.
@@ -98,21 +35,30 @@ namespace Spices {
 		* @brief Registry a console to ConsolePool.
 		* @param[in] name ConsoleName.
 		* @param[in] filePath Console output file.
+		* @param[in] maxLines Maxiumn Num of lines kept, used if not registried yet.
 		* @return Returns Registried Console form Pool.
 		*/
 		static std::shared_ptr<Console> Registry(
 			const std::string& name, 
-			const std::string& filePath = ""
+			const std::string& filePath = "",
+			uint64_t           maxLines = ConsoleStore::DefaultMaxLines
 		);
 
 		/**
-		* @brief Get Console Infos.
-		* @return Returns Console Infos.
+		* @brief Get Console lines.
+		* @return Returns Console lines.
+		* @attention Lock() while reading it, lines are pushed from logger thread.
 		*/
-		const InfoData& GetInfos() const { return m_InfoData; }
+		const ConsoleStore& GetStore() const { return m_Store; }
 
 		/**
-		* @brief Clear Console Infos.
+		* @brief Lock Console lines.
+		* @return Returns the lock.
+		*/
+		std::unique_lock<std::mutex> Lock() { return std::unique_lock<std::mutex>(mutex_); }
+
+		/**
+		* @brief Clear Console lines.
 		*/
 		void Clear();
 
@@ -139,8 +85,9 @@ namespace Spices {
 
 		/**
 		* @brief Inherited from spdlog, run when spdlog flush.
+		* Lines are kept, flush runs whenever AsyncLogger is idle.
 		*/
-		virtual void flush_() override { Clear(); }
+		virtual void flush_() override {}
 
 	protected:
 
@@ -150,13 +97,8 @@ namespace Spices {
 		std::string m_FilePath;
 
 		/**
-		* @brief Maxiumn Num of Informations.
-		*/
-		uint32_t m_MaxInfos;
-
-		/**
-		* @brief Console Information.
+		* @brief Console lines.
 		*/
-		InfoData m_InfoData;
+		ConsoleStore m_Store;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+* @file ConsoleFilter.cpp.
+* @brief The ConsoleFilter Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "ConsoleFilter.h"
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Determine whether a string contains a token.
+		*/
+		bool Contains(std::string_view str, const std::string& token)
+		{
+			return str.find(token) != std::string_view::npos;
+		}
+	}
+
+	ConsoleFilter::ConsoleFilter(const ConsoleStore& store)
+		: m_Store(store)
+	{}
+
+	void ConsoleFilter::SetQuery(uint32_t levelMask, const std::string& text)
+	{
+		SPICES_PROFILE_ZONE;
+
+		levelMask &= AllLevels;
+
+		std::vector<std::string> includes;
+		std::vector<std::string> excludes;
+
+		std::stringstream ss(text);
+		std::string token;
+		while (ss >> token)
+		{
+			if (token.size() > 1 && token[0] == '-') excludes.push_back(token.substr(1));
+			else                                     includes.push_back(token);
+		}
+
+		if (levelMask == m_LevelMask && includes == m_Includes && excludes == m_Excludes) return;
+
+		/**
+		* @brief Answered by store.
+		*/
+		if (includes.empty() && excludes.empty() && (levelMask == AllLevels || (levelMask & (levelMask - 1)) == 0) && levelMask != 0)
+		{
+			m_Mode = levelMask == AllLevels ? Mode::All : Mode::Level;
+
+			for (uint32_t i = 0; i < ConsoleStore::LevelCount; i++)
+			{
+				if (levelMask == 1u << i) m_Level = static_cast<spdlog::level::level_enum>(i);
+			}
+
+			m_Rows.clear();
+			m_Candidates.clear();
+		}
+
+		/**
+		* @brief Lines passing this query are in index, test them again.
+		*/
+		else if (m_Mode == Mode::Index && IsNarrowing(levelMask, includes, excludes))
+		{
+			m_Candidates.insert(m_Candidates.end(), m_Rows.begin(), m_Rows.end());
+			m_Rows.clear();
+		}
+
+		/**
+		* @brief Rebuild index.
+		*/
+		else
+		{
+			m_Mode = Mode::Index;
+
+			m_Rows.clear();
+			m_Candidates.clear();
+
+			m_Back  = m_Store.GetEnd();
+			m_Front = m_Store.GetEnd();
+		}
+
+		m_LevelMask = levelMask;
+		m_Includes  = std::move(includes);
+		m_Excludes  = std::move(excludes);
+	}
+
+	void ConsoleFilter::Update(uint64_t budget)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (m_Mode != Mode::Index) return;
+
+		const uint64_t begin = m_Store.GetBegin();
+		const uint64_t end   = m_Store.GetEnd();
+
+		/**
+		* @brief Forget dropped lines.
+		*/
+		while (!m_Rows.empty()       && m_Rows.front()       < begin) m_Rows.pop_front();
+		while (!m_Candidates.empty() && m_Candidates.front() < begin) m_Candidates.pop_front();
+
+		m_Back  = std::max(m_Back,  begin);
+		m_Front = std::max(m_Front, begin);
+
+		/**
+		* @brief Lines pushed since last Update.
+		*/
+		for (; budget > 0 && m_Front < end; budget--, m_Front++)
+		{
+			if (IsMatch(m_Front)) m_Rows.push_back(m_Front);
+		}
+
+		/**
+		* @brief Lines passing last query, newest first.
+		*/
+		for (; budget > 0 && !m_Candidates.empty(); budget--)
+		{
+			const uint64_t line = m_Candidates.back();
+			m_Candidates.pop_back();
+
+			if (IsMatch(line)) m_Rows.push_front(line);
+		}
+
+		/**
+		* @brief Lines not tested, newest first.
+		*/
+		for (; budget > 0 && m_Back > begin; budget--)
+		{
+			m_Back--;
+
+			if (IsMatch(m_Back)) m_Rows.push_front(m_Back);
+		}
+	}
+
+	bool ConsoleFilter::IsComplete() const
+	{
+		if (m_Mode != Mode::Index) return true;
+
+		return m_Front >= m_Store.GetEnd() && m_Candidates.empty() && m_Back <= m_Store.GetBegin();
+	}
+
+	uint64_t ConsoleFilter::GetRowCount() const
+	{
+		switch (m_Mode)
+		{
+			case Mode::All:   return m_Store.GetSize();
+			case Mode::Level: return m_Store.GetLevelCount(m_Level);
+			default:          return m_Rows.size();
+		}
+	}
+
+	uint64_t ConsoleFilter::GetRow(uint64_t row) const
+	{
+		switch (m_Mode)
+		{
+			case Mode::All:   return m_Store.GetBegin() + row;
+			case Mode::Level: return m_Store.GetLevelLines(m_Level)[row];
+			default:          return m_Rows[row];
+		}
+	}
+
+	bool ConsoleFilter::IsMatch(uint64_t line) const
+	{
+		const ConsoleStore::LineView view = m_Store.GetLine(line);
+
+		if ((m_LevelMask & (1u << view.level)) == 0) return false;
+
+		for (const auto& token : m_Includes)
+		{
+			if (!Contains(view.text, token) && !Contains(view.logger, token)) return false;
+		}
+
+		for (const auto& token : m_Excludes)
+		{
+			if (Contains(view.text, token) || Contains(view.logger, token)) return false;
+		}
+
+		return true;
+	}
+
+	bool ConsoleFilter::IsNarrowing(uint32_t levelMask, const std::vector<std::string>& includes, const std::vector<std::string>& excludes) const
+	{
+		if ((levelMask & ~m_LevelMask) != 0) return false;
+
+		/**
+		* @brief A line containing a new token contains the old token it contains.
+		*/
+		for (const auto& old : m_Includes)
+		{
+			if (std::none_of(includes.begin(), includes.end(), [&](const std::string& token) { return Contains(token, old); })) return false;
+		}
+
+		/**
+		* @brief A line containing a old excluded token contains a new excluded token it contains.
+		*/
+		for (const auto& old : m_Excludes)
+		{
+			if (std::none_of(excludes.begin(), excludes.end(), [&](const std::string& token) { return Contains(old, token); })) return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,158 @@
+/**
+* @file ConsoleFilter.h
+* @brief The ConsoleFilter Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "ConsoleStore.h"
+
+namespace Spices {
+
+	/**
+	* @brief Lines of a ConsoleStore passing a query, as rows of a view.
+	* A query is a level mask and space separated tokens, a line passes if its level is in the mask,
+	* its text or logger contains every token and none of the tokens beginning with '-'.
+	* A query of all levels or a single level without tokens is answered by the store directly,
+	* other queries are answered by a index of passing lines, updated incrementally:
+	* Update() tests lines pushed since last Update(), then rebuilds the rest of the index newest first,
+	* both within a budget of lines per call, so the cost of a frame does not depend on lines of store.
+	* A query narrowing the last one (more characters typed, a token added) rebuilds from the last index.
+	* @attention Not thread safe, lock the store's Console while using it.
+	*/
+	class ConsoleFilter
+	{
+	public:
+
+		/**
+		* @brief Level mask of all levels.
+		*/
+		static constexpr uint32_t AllLevels = (1u << ConsoleStore::LevelCount) - 1;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] store The store filtered, must outlive this filter.
+		*/
+		explicit ConsoleFilter(const ConsoleStore& store);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~ConsoleFilter() = default;
+
+		/**
+		* @brief Set the query, the index is rebuilt by Update().
+		* @param[in] levelMask Bits of levels passing.
+		* @param[in] text Space separated tokens.
+		*/
+		void SetQuery(uint32_t levelMask, const std::string& text);
+
+		/**
+		* @brief Update the index.
+		* @param[in] budget Maxiumn Num of lines tested.
+		*/
+		void Update(uint64_t budget = 1 << 18);
+
+		/**
+		* @brief Determine whether all lines of store are tested.
+		* @return Returns true if index is complete.
+		*/
+		bool IsComplete() const;
+
+		/**
+		* @brief Get Num of rows, lines passing found so far.
+		* @return Returns Num of rows.
+		*/
+		uint64_t GetRowCount() const;
+
+		/**
+		* @brief Get line of a row, rows are in ascending line order.
+		* @param[in] row Row, less than GetRowCount().
+		* @return Returns number of line.
+		*/
+		uint64_t GetRow(uint64_t row) const;
+
+		/**
+		* @brief Determine whether a line passes the query.
+		* @param[in] line Number of line.
+		* @return Returns true if passing.
+		*/
+		bool IsMatch(uint64_t line) const;
+
+	private:
+
+		/**
+		* @brief How rows are found.
+		*/
+		enum class Mode
+		{
+			All   = 0,     /* @brief All lines of store.              */
+			Level = 1,     /* @brief Lines of a level in store.       */
+			Index = 2,     /* @brief Lines in m_Rows.                 */
+		};
+
+		/**
+		* @brief Determine whether lines passing a query all pass the current query.
+		* @param[in] levelMask Level mask of the query.
+		* @param[in] includes Tokens of the query.
+		* @param[in] excludes Excluded tokens of the query.
+		* @return Returns true if the query narrows the current query.
+		*/
+		bool IsNarrowing(uint32_t levelMask, const std::vector<std::string>& includes, const std::vector<std::string>& excludes) const;
+
+	private:
+
+		/**
+		* @brief The store filtered.
+		*/
+		const ConsoleStore& m_Store;
+
+		/**
+		* @brief How rows are found.
+		*/
+		Mode m_Mode = Mode::All;
+
+		/**
+		* @brief Level of Mode::Level.
+		*/
+		spdlog::level::level_enum m_Level = spdlog::level::trace;
+
+		/**
+		* @brief Level mask of query.
+		*/
+		uint32_t m_LevelMask = AllLevels;
+
+		/**
+		* @brief Tokens of query.
+		*/
+		std::vector<std::string> m_Includes;
+
+		/**
+		* @brief Excluded tokens of query.
+		*/
+		std::vector<std::string> m_Excludes;
+
+		/**
+		* @brief Lines passing found so far, ascending.
+		*/
+		std::deque<uint64_t> m_Rows;
+
+		/**
+		* @brief Lines passing last query, tested again from back if narrowing, ascending.
+		*/
+		std::deque<uint64_t> m_Candidates;
+
+		/**
+		* @brief Lines under this are not tested yet, tested from back.
+		*/
+		uint64_t m_Back = 0;
+
+		/**
+		* @brief Lines from this are not tested yet, tested from front.
+		*/
+		uint64_t m_Front = 0;
+	};
+}
@@ -0,0 +1,189 @@
+/**
+* @file ConsoleStore.cpp.
+* @brief The ConsoleStore Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "ConsoleStore.h"
+
+#include <spdlog/details/os.h>
+
+namespace Spices {
+
+	ConsoleStore::ConsoleStore(uint64_t maxLines, uint32_t chunkLines)
+		: m_ChunkLines(std::max(chunkLines, 1u))
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_MaxChunks = std::max<uint64_t>((maxLines + m_ChunkLines - 1) / m_ChunkLines, 1);
+	}
+
+	uint64_t ConsoleStore::Push(
+		spdlog::level::level_enum level  ,
+		std::string_view          logger ,
+		int64_t                   time   ,
+		std::string_view          text
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (level >= LevelCount) level = spdlog::level::critical;
+
+		/**
+		* @brief Start a new chunk, drop the oldest chunk if full.
+		*/
+		if (m_Chunks.empty() || m_Chunks.back()->lines.size() == m_ChunkLines)
+		{
+			if (m_Chunks.size() == m_MaxChunks)
+			{
+				m_SpareChunk = std::move(m_Chunks.front());
+				m_Chunks.pop_front();
+
+				m_Begin += m_ChunkLines;
+
+				for (auto& lines : m_LevelLines)
+				{
+					while (!lines.empty() && lines.front() < m_Begin) lines.pop_front();
+				}
+			}
+
+			std::unique_ptr<Chunk> chunk = std::move(m_SpareChunk);
+			if (chunk)
+			{
+				chunk->lines.clear();
+				chunk->text.clear();
+			}
+			else
+			{
+				chunk = std::make_unique<Chunk>();
+				chunk->lines.reserve(m_ChunkLines);
+			}
+
+			m_Chunks.push_back(std::move(chunk));
+		}
+
+		Chunk& chunk = *m_Chunks.back();
+
+		Line l;
+		l.time   = time;
+		l.offset = static_cast<uint32_t>(chunk.text.size());
+		l.level  = static_cast<uint8_t>(level);
+		l.logger = GetLoggerIndex(logger);
+
+		chunk.lines.push_back(l);
+		chunk.text.insert(chunk.text.end(), text.begin(), text.end());
+
+		m_LevelLines[level].push_back(m_End);
+
+		return m_End++;
+	}
+
+	void ConsoleStore::Clear()
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_Chunks.empty())
+		{
+			m_SpareChunk = std::move(m_Chunks.back());
+			m_Chunks.clear();
+		}
+
+		for (auto& lines : m_LevelLines) lines.clear();
+
+		m_Begin = m_End;
+	}
+
+	ConsoleStore::LineView ConsoleStore::GetLine(uint64_t line) const
+	{
+		uint32_t index = 0;
+		const Chunk& chunk = GetChunk(line, index);
+		const Line&  l     = chunk.lines[index];
+
+		const uint32_t end = index + 1 < chunk.lines.size() ? chunk.lines[index + 1].offset : static_cast<uint32_t>(chunk.text.size());
+
+		LineView view;
+		view.time   = l.time;
+		view.level  = static_cast<spdlog::level::level_enum>(l.level);
+		view.logger = m_Loggers[l.logger];
+		view.text   = std::string_view(chunk.text.data() + l.offset, end - l.offset);
+
+		return view;
+	}
+
+	spdlog::level::level_enum ConsoleStore::GetLevel(uint64_t line) const
+	{
+		uint32_t index = 0;
+		const Chunk& chunk = GetChunk(line, index);
+
+		return static_cast<spdlog::level::level_enum>(chunk.lines[index].level);
+	}
+
+	void ConsoleStore::Format(uint64_t line, std::string& out) const
+	{
+		const LineView view = GetLine(line);
+
+		const auto   time = spdlog::log_clock::time_point(spdlog::log_clock::duration(view.time));
+		const std::tm tm  = spdlog::details::os::localtime(spdlog::log_clock::to_time_t(time));
+
+		char times[32];
+		const size_t nTimes = std::strftime(times, sizeof(times), "%Y-%m-%d %H:%M:%S", &tm);
+
+		const std::string_view level = GetLevelName(view.level);
+
+		out.reserve(out.size() + nTimes + view.logger.size() + level.size() + view.text.size() + 8);
+		out += '[';
+		out.append(times, nTimes);
+		out += "] [";
+		out.append(view.logger.data(), view.logger.size());
+		out += "] [";
+		out.append(level.data(), level.size());
+		out += "] ";
+		out.append(view.text.data(), view.text.size());
+	}
+
+	std::string_view ConsoleStore::GetLevelName(spdlog::level::level_enum level)
+	{
+		switch (level)
+		{
+			case spdlog::level::trace:    return "trace";
+			case spdlog::level::debug:    return "debug";
+			case spdlog::level::info:     return "info";
+			case spdlog::level::warn:     return "warn";
+			case spdlog::level::err:      return "error";
+			case spdlog::level::critical: return "critical";
+			default:                      return "off";
+		}
+	}
+
+	const ConsoleStore::Chunk& ConsoleStore::GetChunk(uint64_t line, uint32_t& outIndex) const
+	{
+		assert(line >= m_Begin && line < m_End);
+
+		const uint64_t offset = line - m_Begin;
+		outIndex = static_cast<uint32_t>(offset % m_ChunkLines);
+
+		return *m_Chunks[offset / m_ChunkLines];
+	}
+
+	uint8_t ConsoleStore::GetLoggerIndex(std::string_view logger)
+	{
+		for (size_t i = 0; i < m_Loggers.size(); i++)
+		{
+			if (m_Loggers[i] == logger) return static_cast<uint8_t>(i);
+		}
+
+		/**
+		* @brief Loggers past the last index share it.
+		*/
+		if (m_Loggers.size() == UINT8_MAX + 1)
+		{
+			m_Loggers.back() = "...";
+			return UINT8_MAX;
+		}
+
+		m_Loggers.emplace_back(logger);
+
+		return static_cast<uint8_t>(m_Loggers.size() - 1);
+	}
+}
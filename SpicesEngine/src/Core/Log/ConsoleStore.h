@@ -0,0 +1,221 @@
+/**
+* @file ConsoleStore.h
+* @brief The ConsoleStore Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <deque>
+#include <string_view>
+
+namespace Spices {
+
+	/**
+	* @brief Store of console lines, a ring of fixed count chunks.
+	* Lines are numbered from 0 in push order and never renumbered, the store keeps lines [GetBegin(), GetEnd()),
+	* once full the oldest chunk is dropped at once. A line is kept unformatted (time, level, logger, text)
+	* and formatted only if it is shown.
+	* Lines of each level are indexed, so a level is shown without scanning.
+	* @attention Not thread safe, Console locks it.
+	*/
+	class ConsoleStore
+	{
+	public:
+
+		/**
+		* @brief Count of levels, trace to critical.
+		*/
+		static constexpr uint32_t LevelCount = spdlog::level::off;
+
+		/**
+		* @brief Default Maxiumn Num of lines kept, 1M lines of a long session.
+		*/
+		static constexpr uint64_t DefaultMaxLines = 1 << 20;
+
+		/**
+		* @brief A line.
+		*/
+		struct LineView
+		{
+			int64_t                   time;      /* @brief Log time, log_clock ticks.   */
+			spdlog::level::level_enum level;     /* @brief Log level.                   */
+			std::string_view          logger;    /* @brief Logger name.                 */
+			std::string_view          text;      /* @brief Message.                     */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] maxLines Maxiumn Num of lines kept, rounded up to chunks.
+		* @param[in] chunkLines Num of lines of a chunk.
+		*/
+		ConsoleStore(uint64_t maxLines = DefaultMaxLines, uint32_t chunkLines = 1 << 16);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~ConsoleStore() = default;
+
+		/**
+		* @brief Push a line.
+		* @param[in] level Log level.
+		* @param[in] logger Logger name.
+		* @param[in] time Log time, log_clock ticks.
+		* @param[in] text Message.
+		* @return Returns number of the line.
+		*/
+		uint64_t Push(
+			spdlog::level::level_enum level  ,
+			std::string_view          logger ,
+			int64_t                   time   ,
+			std::string_view          text
+		);
+
+		/**
+		* @brief Drop all lines, numbers are not reused.
+		*/
+		void Clear();
+
+		/**
+		* @brief Get number of oldest line kept.
+		* @return Returns number of oldest line.
+		*/
+		uint64_t GetBegin() const { return m_Begin; }
+
+		/**
+		* @brief Get number of next line pushed.
+		* @return Returns number of next line.
+		*/
+		uint64_t GetEnd() const { return m_End; }
+
+		/**
+		* @brief Get Num of lines kept.
+		* @return Returns Num of lines.
+		*/
+		uint64_t GetSize() const { return m_End - m_Begin; }
+
+		/**
+		* @brief Get a line.
+		* @param[in] line Number of line, in [GetBegin(), GetEnd()).
+		* @return Returns the line, valid until next Push or Clear.
+		*/
+		LineView GetLine(uint64_t line) const;
+
+		/**
+		* @brief Get level of a line.
+		* @param[in] line Number of line, in [GetBegin(), GetEnd()).
+		* @return Returns level of the line.
+		*/
+		spdlog::level::level_enum GetLevel(uint64_t line) const;
+
+		/**
+		* @brief Get numbers of lines of a level, ascending.
+		* @param[in] level Log level.
+		* @return Returns numbers of lines.
+		*/
+		const std::deque<uint64_t>& GetLevelLines(spdlog::level::level_enum level) const { return m_LevelLines[level]; }
+
+		/**
+		* @brief Get Num of lines of a level.
+		* @param[in] level Log level.
+		* @return Returns Num of lines.
+		*/
+		uint64_t GetLevelCount(spdlog::level::level_enum level) const { return m_LevelLines[level].size(); }
+
+		/**
+		* @brief Format a line as "[time] [logger] [level] text".
+		* @param[in] line Number of line, in [GetBegin(), GetEnd()).
+		* @param[in,out] out String appended to.
+		*/
+		void Format(uint64_t line, std::string& out) const;
+
+		/**
+		* @brief Get name of a level.
+		* @param[in] level Log level.
+		* @return Returns name of level.
+		*/
+		static std::string_view GetLevelName(spdlog::level::level_enum level);
+
+	private:
+
+		/**
+		* @brief A line in chunk, its text ends at next line's offset.
+		*/
+		struct Line
+		{
+			int64_t  time;       /* @brief Log time, log_clock ticks.   */
+			uint32_t offset;     /* @brief Offset of text in chunk.     */
+			uint8_t  level;      /* @brief Log level.                   */
+			uint8_t  logger;     /* @brief Index of logger name.        */
+		};
+
+		/**
+		* @brief A chunk of lines.
+		*/
+		struct Chunk
+		{
+			std::vector<Line> lines;    /* @brief Lines.              */
+			std::vector<char> text;     /* @brief Texts of lines.     */
+		};
+
+		/**
+		* @brief Get chunk of a line.
+		* @param[in] line Number of line.
+		* @param[out] outIndex Index of line in chunk.
+		* @return Returns the chunk.
+		*/
+		const Chunk& GetChunk(uint64_t line, uint32_t& outIndex) const;
+
+		/**
+		* @brief Get index of a logger name, added if new.
+		* @param[in] logger Logger name.
+		* @return Returns index of logger name.
+		*/
+		uint8_t GetLoggerIndex(std::string_view logger);
+
+	private:
+
+		/**
+		* @brief Num of lines of a chunk.
+		*/
+		uint32_t m_ChunkLines;
+
+		/**
+		* @brief Maxiumn Num of chunks.
+		*/
+		uint64_t m_MaxChunks;
+
+		/**
+		* @brief Chunks, oldest first, all but last are full.
+		*/
+		std::deque<std::unique_ptr<Chunk>> m_Chunks;
+
+		/**
+		* @brief A dropped chunk, reused by next chunk.
+		*/
+		std::unique_ptr<Chunk> m_SpareChunk;
+
+		/**
+		* @brief Number of oldest line kept, first line of m_Chunks.front().
+		*/
+		uint64_t m_Begin = 0;
+
+		/**
+		* @brief Number of next line pushed.
+		*/
+		uint64_t m_End = 0;
+
+		/**
+		* @brief Numbers of lines of each level.
+		*/
+		std::array<std::deque<uint64_t>, LevelCount> m_LevelLines;
+
+		/**
+		* @brief Logger names.
+		*/
+		std::vector<std::string> m_Loggers;
+	};
+}
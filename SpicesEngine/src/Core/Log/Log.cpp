@@ -18,6 +18,7 @@ namespace Spices {
 
 	std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 	std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
+	std::shared_ptr<AsyncLogger>    Log::s_AsyncLogger;
 
 	void Log::Init()
 	{
@@ -73,12 +74,22 @@ namespace Spices {
 
 		s_ClientLogger = std::make_shared<spdlog::logger>("Game", begin(sinks), end(sinks));
 		s_ClientLogger->set_level(spdlog::level::trace);
+
+		/**
+		* @brief Records of Stage Loggers are formatted and written by AsyncLogger thread.
+		*/
+		s_AsyncLogger = std::make_shared<AsyncLogger>(sinks);
 	}
 
 	void Log::ShutDown()
 	{
 		SPICES_PROFILE_ZONE;
 
+		/**
+		* @brief Write all pushed records before sinks are released.
+		*/
+		s_AsyncLogger.reset();
+
 		s_CoreLogger.reset();
 		s_ClientLogger.reset();
 		spdlog::drop_all();
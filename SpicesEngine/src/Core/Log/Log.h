@@ -16,6 +16,8 @@
 #include <spdlog/fmt/ostr.h>
 #pragma warning(pop)
 
+#include "AsyncLogger.h"
+
 namespace Spices {
 
 	/**
@@ -47,6 +49,12 @@ namespace Spices {
 		*/
 		static std::shared_ptr<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
 
+		/**
+		* @brief Get AsyncLogger records of Stage Loggers are pushed to.
+		* @return Returns AsyncLogger, nullptr if not initialized.
+		*/
+		static std::shared_ptr<AsyncLogger>& GetAsyncLogger() { return s_AsyncLogger; }
+
 	public:
 
 		/**
@@ -63,6 +71,17 @@ namespace Spices {
 		template <typename... Args>
 		static void PostHandle(format_string_t<Args...> fmt, Args &&...args);
 
+		/**
+		* @brief Write a record of a Stage Logger.
+		* Pushed to AsyncLogger and formatted on its thread, written by the Stage Logger if AsyncLogger is not initialized.
+		* @param[in] logger Stage Logger.
+		* @param[in] level Record level.
+		* @param[in] fmt format string, checked by PostHandle.
+		* @param[in] args any param.
+		*/
+		template <typename Fmt, typename... Args>
+		static void Write(const std::shared_ptr<spdlog::logger>& logger, spdlog::level::level_enum level, Fmt&& fmt, Args &&...args);
+
 	private:
 
 		/**
@@ -74,6 +93,11 @@ namespace Spices {
 		* @brief Game Stage Logger.
 		*/
 		static std::shared_ptr<spdlog::logger> s_ClientLogger;
+
+		/**
+		* @brief AsyncLogger of Stage Loggers.
+		*/
+		static std::shared_ptr<AsyncLogger> s_AsyncLogger;
 	};
 
 	template<typename ...Args>
@@ -81,6 +105,25 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 	}
+
+	template<typename Fmt, typename ...Args>
+	inline void Log::Write(const std::shared_ptr<spdlog::logger>& logger, spdlog::level::level_enum level, Fmt&& fmt, Args && ...args)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (s_AsyncLogger)
+		{
+			s_AsyncLogger->Log(logger->name().c_str(), level, std::forward<Fmt>(fmt), args...);
+		}
+		else if constexpr (sizeof...(Args) == 0)
+		{
+			logger->log(level, spdlog::string_view_t(fmt));
+		}
+		else
+		{
+			logger->log(level, fmt::runtime(fmt), std::forward<Args>(args)...);
+		}
+	}
 }
 
 template<typename OStream, glm::length_t L, typename T, glm::qualifier Q>
@@ -104,18 +147,18 @@ inline OStream& operator<<(OStream& os, glm::qua<T, Q> quaternion)
 #ifdef SPICES_DEBUG
 
 // Core log macros
-#define SPICES_CORE_TRACE(...)    ::Spices::Log::GetCoreLogger()->trace      (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
-#define SPICES_CORE_INFO(...)     ::Spices::Log::GetCoreLogger()->info       (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
-#define SPICES_CORE_WARN(...)     ::Spices::Log::GetCoreLogger()->warn       (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
-#define SPICES_CORE_ERROR(...)    ::Spices::Log::GetCoreLogger()->error      (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
-#define SPICES_CORE_CRITICAL(...) ::Spices::Log::GetCoreLogger()->critical   (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
+#define SPICES_CORE_TRACE(...)    ::Spices::Log::Write(::Spices::Log::GetCoreLogger(), spdlog::level::trace, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
+#define SPICES_CORE_INFO(...)     ::Spices::Log::Write(::Spices::Log::GetCoreLogger(), spdlog::level::info, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
+#define SPICES_CORE_WARN(...)     ::Spices::Log::Write(::Spices::Log::GetCoreLogger(), spdlog::level::warn, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
+#define SPICES_CORE_ERROR(...)    ::Spices::Log::Write(::Spices::Log::GetCoreLogger(), spdlog::level::err, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
+#define SPICES_CORE_CRITICAL(...) ::Spices::Log::Write(::Spices::Log::GetCoreLogger(), spdlog::level::critical, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
 																																	
 // Client log macros																												
-#define SPICES_TRACE(...)         ::Spices::Log::GetClientLogger()->trace    (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
-#define SPICES_INFO(...)          ::Spices::Log::GetClientLogger()->info     (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
-#define SPICES_WARN(...)          ::Spices::Log::GetClientLogger()->warn     (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
-#define SPICES_ERROR(...)         ::Spices::Log::GetClientLogger()->error    (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
-#define SPICES_CRITICAL(...)      ::Spices::Log::GetClientLogger()->critical (__VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
+#define SPICES_TRACE(...)         ::Spices::Log::Write(::Spices::Log::GetClientLogger(), spdlog::level::trace, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
+#define SPICES_INFO(...)          ::Spices::Log::Write(::Spices::Log::GetClientLogger(), spdlog::level::info, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
+#define SPICES_WARN(...)          ::Spices::Log::Write(::Spices::Log::GetClientLogger(), spdlog::level::warn, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__)
+#define SPICES_ERROR(...)         ::Spices::Log::Write(::Spices::Log::GetClientLogger(), spdlog::level::err, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
+#define SPICES_CRITICAL(...)      ::Spices::Log::Write(::Spices::Log::GetClientLogger(), spdlog::level::critical, __VA_ARGS__)   ;   ::Spices::Log::PostHandle(__VA_ARGS__);  //throw std::runtime_error(__VA_ARGS__)
 
 #endif // SPICES_DEBUG
 
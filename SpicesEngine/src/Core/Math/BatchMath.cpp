@@ -0,0 +1,332 @@
+/**
+* @file BatchMath.cpp.
+* @brief The BatchMath Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "BatchMath.h"
+#include "BatchMathKernels.h"
+#include "BatchMathLanes.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SPICES_BATCHMATH_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace Spices {
+
+	namespace {
+
+#ifdef SPICES_BATCHMATH_X86
+
+		/**
+		* @brief Query cpuid leaf.
+		*/
+		void CpuId(int leaf, int subLeaf, int regs[4])
+		{
+#if defined(_MSC_VER)
+			__cpuidex(regs, leaf, subLeaf);
+#else
+			unsigned int a, b, c, d;
+			__cpuid_count(leaf, subLeaf, a, b, c, d);
+			regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+#endif
+		}
+
+		/**
+		* @brief Query which register states the os saves on context switch.
+		*/
+		uint64_t XGetBV()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			unsigned int a, d;
+			__asm__ volatile("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+			return (static_cast<uint64_t>(d) << 32) | a;
+#endif
+		}
+
+#endif
+
+		static_assert(sizeof(glm::mat4)     == sizeof(float) * 16, "Lane kernels read glm::mat4 as 16 floats.");
+		static_assert(sizeof(FrustumPlanes) == sizeof(float) * 24, "Lane kernels write FrustumPlanes as 24 floats.");
+		static_assert(detail::FrustumPlaneEpsilon == detail::LaneFrustumPlaneEpsilon, "Lane and scalar kernels must agree.");
+
+		/**
+		* @brief Kernel table of an instruction set, over its lane kernels.
+		* Lane kernels process whole lanes, tails are processed by the scalar reference here,
+		* so no glm code is compiled with the code generation flags of the instruction set.
+		* @tparam GetLanes Getter of lane kernels.
+		*/
+		template<const detail::BatchMathLaneKernels* (*GetLanes)()>
+		struct LaneKernels
+		{
+			/**
+			* @brief Count of elements processed by lane kernels.
+			*/
+			static size_t Whole(size_t count)
+			{
+				return count - count % GetLanes()->width;
+			}
+
+			static float*       Floats(glm::mat4* m)       { return reinterpret_cast<float*>(m); }
+			static const float* Floats(const glm::mat4* m) { return reinterpret_cast<const float*>(m); }
+
+			static void ComposeTRS(const TRSSoA& trs, glm::mat4* out, size_t count)
+			{
+				const size_t n = Whole(count);
+				const float* const streams[10] = { trs.px, trs.py, trs.pz, trs.qx, trs.qy, trs.qz, trs.qw, trs.sx, trs.sy, trs.sz };
+
+				GetLanes()->ComposeTRS(streams, Floats(out), n);
+				detail::ComposeTRS_Scalar(detail::Offset(trs, n), out + n, count - n);
+			}
+
+			static void MulMat4(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+			{
+				const size_t n = Whole(count);
+
+				GetLanes()->MulMat4(Floats(a), Floats(b), Floats(out), n);
+				detail::MulMat4_Scalar(a + n, b + n, out + n, count - n);
+			}
+
+			static void InverseAffine(const glm::mat4* in, glm::mat4* out, size_t count)
+			{
+				const size_t n = Whole(count);
+
+				GetLanes()->InverseAffine(Floats(in), Floats(out), n);
+				detail::InverseAffine_Scalar(in + n, out + n, count - n);
+			}
+
+			static void TransformSpheres(const glm::mat4* matrices, const SphereSoA& in, const SphereSoA& out, size_t count)
+			{
+				const size_t n = Whole(count);
+				const float* const inStreams[4]  = { in.x,  in.y,  in.z,  in.r  };
+				float* const       outStreams[4] = { out.x, out.y, out.z, out.r };
+
+				GetLanes()->TransformSpheres(Floats(matrices), inStreams, outStreams, n);
+				detail::TransformSpheres_Scalar(matrices + n, detail::Offset(in, n), detail::Offset(out, n), count - n);
+			}
+
+			static void TransformAABBs(const glm::mat4* matrices, const AABBSoA& in, const AABBSoA& out, size_t count)
+			{
+				const size_t n = Whole(count);
+				const float* const inStreams[6]  = { in.minX,  in.minY,  in.minZ,  in.maxX,  in.maxY,  in.maxZ  };
+				float* const       outStreams[6] = { out.minX, out.minY, out.minZ, out.maxX, out.maxY, out.maxZ };
+
+				GetLanes()->TransformAABBs(Floats(matrices), inStreams, outStreams, n);
+				detail::TransformAABBs_Scalar(matrices + n, detail::Offset(in, n), detail::Offset(out, n), count - n);
+			}
+
+			static void ExtractFrustumPlanes(const glm::mat4* viewProjections, FrustumPlanes* out, size_t count)
+			{
+				const size_t n = Whole(count);
+
+				GetLanes()->ExtractFrustumPlanes(Floats(viewProjections), reinterpret_cast<float*>(out), n);
+				detail::ExtractFrustumPlanes_Scalar(viewProjections + n, out + n, count - n);
+			}
+
+			static uint32_t CullSpheres(const FrustumPlanes& frustum, const SphereSoA& spheres, uint8_t* outVisible, size_t count)
+			{
+				const size_t n = Whole(count);
+				const float* const streams[4] = { spheres.x, spheres.y, spheres.z, spheres.r };
+
+				const uint32_t visible = GetLanes()->CullSpheres(reinterpret_cast<const float*>(&frustum), streams, outVisible, n);
+				return visible + detail::CullSpheres_Scalar(frustum, detail::Offset(spheres, n), outVisible + n, count - n);
+			}
+
+			/**
+			* @brief Get the kernel table.
+			* @param[in] set Instruction set.
+			* @return Returns nullptr if lane kernels are not compiled for this target.
+			*/
+			static const BatchMathKernels* Get(SIMDInstructionSet set)
+			{
+				if (!GetLanes()) return nullptr;
+
+				static const BatchMathKernels kernels = {
+					set,
+					&ComposeTRS,
+					&MulMat4,
+					&InverseAffine,
+					&TransformSpheres,
+					&TransformAABBs,
+					&ExtractFrustumPlanes,
+					&CullSpheres,
+				};
+
+				return &kernels;
+			}
+		};
+
+		/**
+		* @brief Check whether the running cpu can execute an instruction set.
+		* @param[in] set Instruction set.
+		* @return Returns true if supported.
+		*/
+		bool IsSupported(SIMDInstructionSet set)
+		{
+			switch (set)
+			{
+			case SIMDInstructionSet::Scalar:
+				return true;
+
+#ifdef SPICES_BATCHMATH_X86
+
+			case SIMDInstructionSet::SSE41:
+			{
+				int regs[4];
+				CpuId(1, 0, regs);
+				return (regs[2] & (1 << 19)) != 0;
+			}
+			case SIMDInstructionSet::AVX2:
+			{
+				int regs[4];
+				CpuId(0, 0, regs);
+				if (regs[0] < 7) return false;
+
+				CpuId(1, 0, regs);
+				const bool osxsave = (regs[2] & (1 << 27)) != 0;
+				const bool avx     = (regs[2] & (1 << 28)) != 0;
+				const bool fma     = (regs[2] & (1 << 12)) != 0;
+				if (!osxsave || !avx || !fma) return false;
+
+				/**
+				* @brief xmm and ymm state must be enabled by the os.
+				*/
+				if ((XGetBV() & 0x6) != 0x6) return false;
+
+				CpuId(7, 0, regs);
+				return (regs[1] & (1 << 5)) != 0;
+			}
+
+#endif
+
+			case SIMDInstructionSet::NEON:
+				return detail::GetBatchMathLaneKernels_NEON() != nullptr;
+
+			default:
+				return false;
+			}
+		}
+
+		/**
+		* @brief Select the widest kernel table once.
+		*/
+		const BatchMathKernels* SelectKernels()
+		{
+			const SIMDInstructionSet order[] = {
+				SIMDInstructionSet::AVX2,
+				SIMDInstructionSet::NEON,
+				SIMDInstructionSet::SSE41,
+			};
+
+			for (const auto set : order)
+			{
+				if (const auto* kernels = BatchMath::GetKernels(set))
+				{
+					return kernels;
+				}
+			}
+
+			return detail::GetBatchMathKernels_Scalar();
+		}
+	}
+
+	void BatchMath::ComposeTRS(const TRSSoA& trs, glm::mat4* out, size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Active().ComposeTRS(trs, out, count);
+	}
+
+	void BatchMath::MulMat4(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Active().MulMat4(a, b, out, count);
+	}
+
+	void BatchMath::InverseAffine(const glm::mat4* in, glm::mat4* out, size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Active().InverseAffine(in, out, count);
+	}
+
+	void BatchMath::TransformSpheres(const glm::mat4* matrices, const SphereSoA& in, const SphereSoA& out, size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Active().TransformSpheres(matrices, in, out, count);
+	}
+
+	void BatchMath::TransformAABBs(const glm::mat4* matrices, const AABBSoA& in, const AABBSoA& out, size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Active().TransformAABBs(matrices, in, out, count);
+	}
+
+	void BatchMath::ExtractFrustumPlanes(const glm::mat4* viewProjections, FrustumPlanes* out, size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Active().ExtractFrustumPlanes(viewProjections, out, count);
+	}
+
+	uint32_t BatchMath::CullSpheres(const FrustumPlanes& frustum, const SphereSoA& spheres, uint8_t* outVisible, size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		return Active().CullSpheres(frustum, spheres, outVisible, count);
+	}
+
+	const BatchMathKernels* BatchMath::GetKernels(SIMDInstructionSet set)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!IsSupported(set)) return nullptr;
+
+		switch (set)
+		{
+		case SIMDInstructionSet::Scalar: return detail::GetBatchMathKernels_Scalar();
+		case SIMDInstructionSet::SSE41:  return LaneKernels<&detail::GetBatchMathLaneKernels_SSE41>::Get(set);
+		case SIMDInstructionSet::AVX2:   return LaneKernels<&detail::GetBatchMathLaneKernels_AVX2>::Get(set);
+		case SIMDInstructionSet::NEON:   return LaneKernels<&detail::GetBatchMathLaneKernels_NEON>::Get(set);
+		default:                         return nullptr;
+		}
+	}
+
+	SIMDInstructionSet BatchMath::GetActiveInstructionSet()
+	{
+		SPICES_PROFILE_ZONE;
+
+		return Active().set;
+	}
+
+	const char* BatchMath::GetInstructionSetName(SIMDInstructionSet set)
+	{
+		SPICES_PROFILE_ZONE;
+
+		switch (set)
+		{
+		case SIMDInstructionSet::Scalar: return "Scalar";
+		case SIMDInstructionSet::SSE41:  return "SSE4.1";
+		case SIMDInstructionSet::AVX2:   return "AVX2";
+		case SIMDInstructionSet::NEON:   return "NEON";
+		default:                         return "Unknown";
+		}
+	}
+
+	const BatchMathKernels& BatchMath::Active()
+	{
+		static const BatchMathKernels* kernels = SelectKernels();
+		return *kernels;
+	}
+}
@@ -0,0 +1,197 @@
+/**
+* @file BatchMath.h.
+* @brief The BatchMath Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Spices {
+
+	/**
+	* @brief Instruction set a BatchMath kernel table is compiled for.
+	*/
+	enum class SIMDInstructionSet
+	{
+		Scalar = 0,   /* @brief Plain glm, the reference implementation. */
+		SSE41  = 1,   /* @brief x86 SSE4.1, 4 lanes.                     */
+		AVX2   = 2,   /* @brief x86 AVX2 + FMA, 8 lanes.                 */
+		NEON   = 3,   /* @brief ARM NEON, 4 lanes.                       */
+		Count  = 4,
+	};
+
+	/**
+	* @brief SoA view of translation, rotation(quaternion) and scale streams.
+	* Each pointer addresses count floats.
+	*/
+	struct TRSSoA
+	{
+		const float* px = nullptr;   /* @brief Translation x. */
+		const float* py = nullptr;   /* @brief Translation y. */
+		const float* pz = nullptr;   /* @brief Translation z. */
+		const float* qx = nullptr;   /* @brief Quaternion x.  */
+		const float* qy = nullptr;   /* @brief Quaternion y.  */
+		const float* qz = nullptr;   /* @brief Quaternion z.  */
+		const float* qw = nullptr;   /* @brief Quaternion w.  */
+		const float* sx = nullptr;   /* @brief Scale x.       */
+		const float* sy = nullptr;   /* @brief Scale y.       */
+		const float* sz = nullptr;   /* @brief Scale z.       */
+	};
+
+	/**
+	* @brief SoA view of bounding spheres.
+	*/
+	struct SphereSoA
+	{
+		float* x = nullptr;   /* @brief Center x. */
+		float* y = nullptr;   /* @brief Center y. */
+		float* z = nullptr;   /* @brief Center z. */
+		float* r = nullptr;   /* @brief Radius.   */
+	};
+
+	/**
+	* @brief SoA view of axis aligned bounding boxes.
+	*/
+	struct AABBSoA
+	{
+		float* minX = nullptr;   /* @brief Min x. */
+		float* minY = nullptr;   /* @brief Min y. */
+		float* minZ = nullptr;   /* @brief Min z. */
+		float* maxX = nullptr;   /* @brief Max x. */
+		float* maxY = nullptr;   /* @brief Max y. */
+		float* maxZ = nullptr;   /* @brief Max z. */
+	};
+
+	/**
+	* @brief Six normalized frustum planes (xyz: normal pointing inside, w: distance).
+	* Order: left, right, bottom, top, near, far.
+	*/
+	struct FrustumPlanes
+	{
+		glm::vec4 planes[6];
+	};
+
+	/**
+	* @brief Table of batch kernels compiled for one instruction set.
+	*/
+	struct BatchMathKernels
+	{
+		SIMDInstructionSet set;
+
+		void     (*ComposeTRS)          (const TRSSoA& trs, glm::mat4* out, size_t count);
+		void     (*MulMat4)             (const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count);
+		void     (*InverseAffine)       (const glm::mat4* in, glm::mat4* out, size_t count);
+		void     (*TransformSpheres)    (const glm::mat4* matrices, const SphereSoA& in, const SphereSoA& out, size_t count);
+		void     (*TransformAABBs)      (const glm::mat4* matrices, const AABBSoA& in, const AABBSoA& out, size_t count);
+		void     (*ExtractFrustumPlanes)(const glm::mat4* viewProjections, FrustumPlanes* out, size_t count);
+		uint32_t (*CullSpheres)         (const FrustumPlanes& frustum, const SphereSoA& spheres, uint8_t* outVisible, size_t count);
+	};
+
+	/**
+	* @brief Batch Math Static Function Library.
+	* Kernels over SoA streams used by culling, TLAS instance building and light assignment.
+	* Dispatches to the widest instruction set supported by both the build and the running cpu.
+	* All kernels handle any count, tails are processed by the scalar reference.
+	*/
+	class BatchMath
+	{
+	public:
+
+		/**
+		* @brief Compose model matrices as T * R * S, the same as TransformComponent.
+		* @param[in] trs Translation, rotation, scale streams.
+		* @param[out] out Model matrices.
+		* @param[in] count Number of elements.
+		*/
+		static void ComposeTRS(const TRSSoA& trs, glm::mat4* out, size_t count);
+
+		/**
+		* @brief Multiply matrices pairwise, out[i] = a[i] * b[i].
+		* @param[in] a Left matrices.
+		* @param[in] b Right matrices.
+		* @param[out] out Result matrices, may alias a or b.
+		* @param[in] count Number of elements.
+		*/
+		static void MulMat4(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count);
+
+		/**
+		* @brief Invert affine matrices (last row is 0, 0, 0, 1).
+		* @param[in] in Affine matrices.
+		* @param[out] out Inverted matrices, may alias in.
+		* @param[in] count Number of elements.
+		*/
+		static void InverseAffine(const glm::mat4* in, glm::mat4* out, size_t count);
+
+		/**
+		* @brief Transform local bounding spheres to world space.
+		* Radius is scaled by the largest axis scale.
+		* @param[in] matrices Per sphere model matrix.
+		* @param[in] in Local spheres.
+		* @param[out] out World spheres, may alias in.
+		* @param[in] count Number of elements.
+		*/
+		static void TransformSpheres(const glm::mat4* matrices, const SphereSoA& in, const SphereSoA& out, size_t count);
+
+		/**
+		* @brief Transform local aabbs to world space aabbs enclosing them.
+		* @param[in] matrices Per box model matrix.
+		* @param[in] in Local boxes.
+		* @param[out] out World boxes, may alias in.
+		* @param[in] count Number of elements.
+		*/
+		static void TransformAABBs(const glm::mat4* matrices, const AABBSoA& in, const AABBSoA& out, size_t count);
+
+		/**
+		* @brief Extract frustum planes from view projection matrices with [0, 1] clip depth.
+		* Works with reversed and infinite depth, degenerate planes are kept unnormalized.
+		* @param[in] viewProjections Projection * View matrices.
+		* @param[out] out Frustum planes.
+		* @param[in] count Number of elements.
+		*/
+		static void ExtractFrustumPlanes(const glm::mat4* viewProjections, FrustumPlanes* out, size_t count);
+
+		/**
+		* @brief Test spheres against a frustum.
+		* @param[in] frustum Frustum planes.
+		* @param[in] spheres World spheres.
+		* @param[out] outVisible 1 if sphere intersects frustum, 0 otherwise.
+		* @param[in] count Number of elements.
+		* @return Returns the number of visible spheres.
+		*/
+		static uint32_t CullSpheres(const FrustumPlanes& frustum, const SphereSoA& spheres, uint8_t* outVisible, size_t count);
+
+	public:
+
+		/**
+		* @brief Get kernel table for a specific instruction set.
+		* @param[in] set Instruction set.
+		* @return Returns nullptr if not compiled in or not supported by this cpu.
+		*/
+		static const BatchMathKernels* GetKernels(SIMDInstructionSet set);
+
+		/**
+		* @brief Get the instruction set used by dispatch.
+		* @return Returns the widest supported instruction set.
+		*/
+		static SIMDInstructionSet GetActiveInstructionSet();
+
+		/**
+		* @brief Get instruction set name.
+		* @param[in] set Instruction set.
+		* @return Returns instruction set name.
+		*/
+		static const char* GetInstructionSetName(SIMDInstructionSet set);
+
+	private:
+
+		/**
+		* @brief Get the kernel table used by dispatch.
+		* @return Returns kernel table.
+		*/
+		static const BatchMathKernels& Active();
+	};
+}
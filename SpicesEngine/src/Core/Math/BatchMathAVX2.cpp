@@ -0,0 +1,115 @@
+/**
+* @file BatchMathAVX2.cpp.
+* @brief The BatchMath AVX2 Kernels Implementation.
+* Compiled with AVX2 code generation and without PreCompiler Header, see SpicesEngine premake.
+* Includes nothing but intrinsics and BatchMathLanes.h, see there.
+* @author Spices.
+*/
+
+#include "BatchMathLanes.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+namespace Spices {
+
+	namespace detail {
+
+		namespace {
+
+			/**
+			* @brief 8 float lanes in a ymm register.
+			*/
+			struct LaneAVX2
+			{
+				static constexpr size_t Width = 8;
+
+				__m256 v;
+
+				static LaneAVX2 Set1(float f)                              { return { _mm256_set1_ps(f) }; }
+				static LaneAVX2 Load(const float* p)                       { return { _mm256_loadu_ps(p) }; }
+				static void     Store(float* p, LaneAVX2 a)                { _mm256_storeu_ps(p, a.v); }
+				static LaneAVX2 FMA(LaneAVX2 a, LaneAVX2 b, LaneAVX2 c)    { return { _mm256_fmadd_ps(a.v, b.v, c.v) }; }
+				static LaneAVX2 Min(LaneAVX2 a, LaneAVX2 b)                { return { _mm256_min_ps(a.v, b.v) }; }
+				static LaneAVX2 Max(LaneAVX2 a, LaneAVX2 b)                { return { _mm256_max_ps(a.v, b.v) }; }
+				static LaneAVX2 Abs(LaneAVX2 a)                            { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+				static LaneAVX2 Sqrt(LaneAVX2 a)                           { return { _mm256_sqrt_ps(a.v) }; }
+				static LaneAVX2 CmpGE(LaneAVX2 a, LaneAVX2 b)              { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+				static LaneAVX2 CmpGT(LaneAVX2 a, LaneAVX2 b)              { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+				static LaneAVX2 And(LaneAVX2 a, LaneAVX2 b)                { return { _mm256_and_ps(a.v, b.v) }; }
+				static LaneAVX2 Select(LaneAVX2 m, LaneAVX2 a, LaneAVX2 b) { return { _mm256_blendv_ps(b.v, a.v, m.v) }; }
+				static uint32_t MoveMask(LaneAVX2 m)                       { return static_cast<uint32_t>(_mm256_movemask_ps(m.v)); }
+
+				static void LoadMat4(const float* m, LaneAVX2 out[16])
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						__m128 a0 = _mm_loadu_ps(m + c * 4);
+						__m128 a1 = _mm_loadu_ps(m + 16 + c * 4);
+						__m128 a2 = _mm_loadu_ps(m + 32 + c * 4);
+						__m128 a3 = _mm_loadu_ps(m + 48 + c * 4);
+						__m128 b0 = _mm_loadu_ps(m + 64 + c * 4);
+						__m128 b1 = _mm_loadu_ps(m + 80 + c * 4);
+						__m128 b2 = _mm_loadu_ps(m + 96 + c * 4);
+						__m128 b3 = _mm_loadu_ps(m + 112 + c * 4);
+						_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+						_MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+						out[c * 4 + 0].v = _mm256_insertf128_ps(_mm256_castps128_ps256(a0), b0, 1);
+						out[c * 4 + 1].v = _mm256_insertf128_ps(_mm256_castps128_ps256(a1), b1, 1);
+						out[c * 4 + 2].v = _mm256_insertf128_ps(_mm256_castps128_ps256(a2), b2, 1);
+						out[c * 4 + 3].v = _mm256_insertf128_ps(_mm256_castps128_ps256(a3), b3, 1);
+					}
+				}
+
+				static void StoreMat4(float* m, const LaneAVX2 in[16])
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						__m128 a0 = _mm256_castps256_ps128(in[c * 4 + 0].v);
+						__m128 a1 = _mm256_castps256_ps128(in[c * 4 + 1].v);
+						__m128 a2 = _mm256_castps256_ps128(in[c * 4 + 2].v);
+						__m128 a3 = _mm256_castps256_ps128(in[c * 4 + 3].v);
+						__m128 b0 = _mm256_extractf128_ps(in[c * 4 + 0].v, 1);
+						__m128 b1 = _mm256_extractf128_ps(in[c * 4 + 1].v, 1);
+						__m128 b2 = _mm256_extractf128_ps(in[c * 4 + 2].v, 1);
+						__m128 b3 = _mm256_extractf128_ps(in[c * 4 + 3].v, 1);
+						_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+						_MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+						_mm_storeu_ps(m + c * 4, a0);
+						_mm_storeu_ps(m + 16 + c * 4, a1);
+						_mm_storeu_ps(m + 32 + c * 4, a2);
+						_mm_storeu_ps(m + 48 + c * 4, a3);
+						_mm_storeu_ps(m + 64 + c * 4, b0);
+						_mm_storeu_ps(m + 80 + c * 4, b1);
+						_mm_storeu_ps(m + 96 + c * 4, b2);
+						_mm_storeu_ps(m + 112 + c * 4, b3);
+					}
+				}
+			};
+
+			inline LaneAVX2 operator+(LaneAVX2 a, LaneAVX2 b) { return { _mm256_add_ps(a.v, b.v) }; }
+			inline LaneAVX2 operator-(LaneAVX2 a, LaneAVX2 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+			inline LaneAVX2 operator*(LaneAVX2 a, LaneAVX2 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+			inline LaneAVX2 operator/(LaneAVX2 a, LaneAVX2 b) { return { _mm256_div_ps(a.v, b.v) }; }
+		}
+
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_AVX2()
+		{
+			static constexpr BatchMathLaneKernels kernels = MakeBatchMathLaneKernels<LaneAVX2>();
+			return &kernels;
+		}
+	}
+}
+
+#else
+
+namespace Spices {
+
+	namespace detail {
+
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_AVX2() { return nullptr; }
+	}
+}
+
+#endif
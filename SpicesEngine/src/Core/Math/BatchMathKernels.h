@@ -0,0 +1,63 @@
+/**
+* @file BatchMathKernels.h.
+* @brief The BatchMath Kernels Definitions.
+* Internal header of the scalar reference and the dispatch, do not include it outside Core/Math,
+* nor in the per instruction set translation units, see BatchMathLanes.h.
+* @author Spices.
+*/
+
+#pragma once
+#include "BatchMath.h"
+
+#include <cstring>
+
+namespace Spices {
+
+	namespace detail {
+
+		/**
+		* @brief Get the kernel table of the scalar reference.
+		*/
+		const BatchMathKernels* GetBatchMathKernels_Scalar();
+
+		/**
+		* @brief Scalar reference kernels, used for tails and tests.
+		*/
+		void     ComposeTRS_Scalar          (const TRSSoA& trs, glm::mat4* out, size_t count);
+		void     MulMat4_Scalar             (const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count);
+		void     InverseAffine_Scalar       (const glm::mat4* in, glm::mat4* out, size_t count);
+		void     TransformSpheres_Scalar    (const glm::mat4* matrices, const SphereSoA& in, const SphereSoA& out, size_t count);
+		void     TransformAABBs_Scalar      (const glm::mat4* matrices, const AABBSoA& in, const AABBSoA& out, size_t count);
+		void     ExtractFrustumPlanes_Scalar(const glm::mat4* viewProjections, FrustumPlanes* out, size_t count);
+		uint32_t CullSpheres_Scalar         (const FrustumPlanes& frustum, const SphereSoA& spheres, uint8_t* outVisible, size_t count);
+
+		/**
+		* @brief Epsilon under which a frustum plane normal is treated as degenerate.
+		*/
+		constexpr float FrustumPlaneEpsilon = 1e-12f;
+
+		/**
+		* @brief Offset a TRSSoA view.
+		*/
+		inline TRSSoA Offset(const TRSSoA& v, size_t i)
+		{
+			return { v.px + i, v.py + i, v.pz + i, v.qx + i, v.qy + i, v.qz + i, v.qw + i, v.sx + i, v.sy + i, v.sz + i };
+		}
+
+		/**
+		* @brief Offset a SphereSoA view.
+		*/
+		inline SphereSoA Offset(const SphereSoA& v, size_t i)
+		{
+			return { v.x + i, v.y + i, v.z + i, v.r + i };
+		}
+
+		/**
+		* @brief Offset an AABBSoA view.
+		*/
+		inline AABBSoA Offset(const AABBSoA& v, size_t i)
+		{
+			return { v.minX + i, v.minY + i, v.minZ + i, v.maxX + i, v.maxY + i, v.maxZ + i };
+		}
+	}
+}
@@ -0,0 +1,361 @@
+/**
+* @file BatchMathLanes.h.
+* @brief The BatchMath Lane Kernels Definitions.
+* Internal header of the per instruction set translation units, do not include it outside Core/Math.
+* Those units are compiled with their own code generation flags, so this header must not include glm
+* or any other header with inline functions: the linker may keep a copy of a shared inline function compiled
+* for the wider instruction set and call it from everywhere, defeating the cpuid dispatch of BatchMath.
+* Lane kernels therefore work on raw floats and live in an anonymous namespace, one copy per unit.
+* @author Spices.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Spices {
+
+	namespace detail {
+
+		/**
+		* @brief Table of lane kernels compiled for one instruction set.
+		* Matrices are 16 floats, column major as glm::mat4, frustums are 24 floats as FrustumPlanes.
+		* TRS streams are px, py, pz, qx, qy, qz, qw, sx, sy, sz, spheres are x, y, z, r,
+		* boxes are minX, minY, minZ, maxX, maxY, maxZ.
+		* count must be a multiple of width, BatchMath processes tails with the scalar reference.
+		*/
+		struct BatchMathLaneKernels
+		{
+			size_t width;
+
+			void     (*ComposeTRS)          (const float* const trs[10], float* out, size_t count);
+			void     (*MulMat4)             (const float* a, const float* b, float* out, size_t count);
+			void     (*InverseAffine)       (const float* in, float* out, size_t count);
+			void     (*TransformSpheres)    (const float* matrices, const float* const in[4], float* const out[4], size_t count);
+			void     (*TransformAABBs)      (const float* matrices, const float* const in[6], float* const out[6], size_t count);
+			void     (*ExtractFrustumPlanes)(const float* viewProjections, float* out, size_t count);
+			uint32_t (*CullSpheres)         (const float* frustum, const float* const spheres[4], uint8_t* outVisible, size_t count);
+		};
+
+		/**
+		* @brief Get the lane kernel table of one instruction set.
+		* Returns nullptr if the translation unit is not compiled for this target.
+		*/
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_SSE41();
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_AVX2();
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_NEON();
+
+		namespace {
+
+			/**
+			* @brief Epsilon under which a frustum plane normal is treated as degenerate.
+			*/
+			constexpr float LaneFrustumPlaneEpsilon = 1e-12f;
+
+			/**
+			* @brief Lane kernels, written once against a lane type V.
+			* V provides: Width, Set1, Load, Store, + - * /, FMA, Min, Max, Abs, Sqrt,
+			* CmpGE, CmpGT, And, Select, MoveMask, LoadMat4, StoreMat4.
+			* LoadMat4 / StoreMat4 transpose Width matrices so that m[c * 4 + r] holds column c row r of every lane.
+			*/
+			template<typename V>
+			void ComposeTRS_Lanes(const float* const trs[10], float* out, size_t count)
+			{
+				constexpr size_t W = V::Width;
+
+				const V one  = V::Set1(1.0f);
+				const V two  = V::Set1(2.0f);
+				const V zero = V::Set1(0.0f);
+
+				for (size_t i = 0; i < count; i += W)
+				{
+					const V qx = V::Load(trs[3] + i);
+					const V qy = V::Load(trs[4] + i);
+					const V qz = V::Load(trs[5] + i);
+					const V qw = V::Load(trs[6] + i);
+					const V sx = V::Load(trs[7] + i);
+					const V sy = V::Load(trs[8] + i);
+					const V sz = V::Load(trs[9] + i);
+
+					const V xx = qx * qx, yy = qy * qy, zz = qz * qz;
+					const V xy = qx * qy, xz = qx * qz, yz = qy * qz;
+					const V wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+					V m[16];
+					m[0]  = (one - two * (yy + zz)) * sx;
+					m[1]  = (two * (xy + wz)) * sx;
+					m[2]  = (two * (xz - wy)) * sx;
+					m[3]  = zero;
+
+					m[4]  = (two * (xy - wz)) * sy;
+					m[5]  = (one - two * (xx + zz)) * sy;
+					m[6]  = (two * (yz + wx)) * sy;
+					m[7]  = zero;
+
+					m[8]  = (two * (xz + wy)) * sz;
+					m[9]  = (two * (yz - wx)) * sz;
+					m[10] = (one - two * (xx + yy)) * sz;
+					m[11] = zero;
+
+					m[12] = V::Load(trs[0] + i);
+					m[13] = V::Load(trs[1] + i);
+					m[14] = V::Load(trs[2] + i);
+					m[15] = one;
+
+					V::StoreMat4(out + i * 16, m);
+				}
+			}
+
+			template<typename V>
+			void MulMat4_Lanes(const float* a, const float* b, float* out, size_t count)
+			{
+				constexpr size_t W = V::Width;
+
+				for (size_t i = 0; i < count; i += W)
+				{
+					V ma[16], mb[16], mo[16];
+					V::LoadMat4(a + i * 16, ma);
+					V::LoadMat4(b + i * 16, mb);
+
+					for (int c = 0; c < 4; c++)
+					{
+						for (int r = 0; r < 4; r++)
+						{
+							V acc = ma[r] * mb[c * 4];
+							acc = V::FMA(ma[4  + r], mb[c * 4 + 1], acc);
+							acc = V::FMA(ma[8  + r], mb[c * 4 + 2], acc);
+							acc = V::FMA(ma[12 + r], mb[c * 4 + 3], acc);
+							mo[c * 4 + r] = acc;
+						}
+					}
+
+					V::StoreMat4(out + i * 16, mo);
+				}
+			}
+
+			template<typename V>
+			void InverseAffine_Lanes(const float* in, float* out, size_t count)
+			{
+				constexpr size_t W = V::Width;
+
+				const V zero = V::Set1(0.0f);
+				const V one  = V::Set1(1.0f);
+
+				for (size_t i = 0; i < count; i += W)
+				{
+					V m[16];
+					V::LoadMat4(in + i * 16, m);
+
+					/**
+					* @brief Rows of the inverse 3x3 are the cross products of the columns.
+					*/
+					const V r0x = m[5] * m[10] - m[6] * m[9];
+					const V r0y = m[6] * m[8]  - m[4] * m[10];
+					const V r0z = m[4] * m[9]  - m[5] * m[8];
+
+					const V r1x = m[9] * m[2]  - m[10] * m[1];
+					const V r1y = m[10] * m[0] - m[8]  * m[2];
+					const V r1z = m[8] * m[1]  - m[9]  * m[0];
+
+					const V r2x = m[1] * m[6]  - m[2] * m[5];
+					const V r2y = m[2] * m[4]  - m[0] * m[6];
+					const V r2z = m[0] * m[5]  - m[1] * m[4];
+
+					const V invDet = one / (m[0] * r0x + m[1] * r0y + m[2] * r0z);
+
+					V o[16];
+					o[0]  = r0x * invDet; o[4] = r0y * invDet; o[8]  = r0z * invDet;
+					o[1]  = r1x * invDet; o[5] = r1y * invDet; o[9]  = r1z * invDet;
+					o[2]  = r2x * invDet; o[6] = r2y * invDet; o[10] = r2z * invDet;
+					o[3]  = zero;         o[7] = zero;         o[11] = zero;
+
+					o[12] = zero - (o[0] * m[12] + o[4] * m[13] + o[8]  * m[14]);
+					o[13] = zero - (o[1] * m[12] + o[5] * m[13] + o[9]  * m[14]);
+					o[14] = zero - (o[2] * m[12] + o[6] * m[13] + o[10] * m[14]);
+					o[15] = one;
+
+					V::StoreMat4(out + i * 16, o);
+				}
+			}
+
+			template<typename V>
+			void TransformSpheres_Lanes(const float* matrices, const float* const in[4], float* const out[4], size_t count)
+			{
+				constexpr size_t W = V::Width;
+
+				for (size_t i = 0; i < count; i += W)
+				{
+					V m[16];
+					V::LoadMat4(matrices + i * 16, m);
+
+					const V x = V::Load(in[0] + i);
+					const V y = V::Load(in[1] + i);
+					const V z = V::Load(in[2] + i);
+					const V r = V::Load(in[3] + i);
+
+					const V wx = V::FMA(m[8],  z, V::FMA(m[4], y, V::FMA(m[0], x, m[12])));
+					const V wy = V::FMA(m[9],  z, V::FMA(m[5], y, V::FMA(m[1], x, m[13])));
+					const V wz = V::FMA(m[10], z, V::FMA(m[6], y, V::FMA(m[2], x, m[14])));
+
+					const V s0 = m[0] * m[0] + m[1] * m[1] + m[2]  * m[2];
+					const V s1 = m[4] * m[4] + m[5] * m[5] + m[6]  * m[6];
+					const V s2 = m[8] * m[8] + m[9] * m[9] + m[10] * m[10];
+
+					V::Store(out[0] + i, wx);
+					V::Store(out[1] + i, wy);
+					V::Store(out[2] + i, wz);
+					V::Store(out[3] + i, r * V::Sqrt(V::Max(s0, V::Max(s1, s2))));
+				}
+			}
+
+			template<typename V>
+			void TransformAABBs_Lanes(const float* matrices, const float* const in[6], float* const out[6], size_t count)
+			{
+				constexpr size_t W = V::Width;
+
+				const V half = V::Set1(0.5f);
+
+				for (size_t i = 0; i < count; i += W)
+				{
+					V m[16];
+					V::LoadMat4(matrices + i * 16, m);
+
+					const V minX = V::Load(in[0] + i), maxX = V::Load(in[3] + i);
+					const V minY = V::Load(in[1] + i), maxY = V::Load(in[4] + i);
+					const V minZ = V::Load(in[2] + i), maxZ = V::Load(in[5] + i);
+
+					const V cx = (minX + maxX) * half, ex = (maxX - minX) * half;
+					const V cy = (minY + maxY) * half, ey = (maxY - minY) * half;
+					const V cz = (minZ + maxZ) * half, ez = (maxZ - minZ) * half;
+
+					const V wcx = V::FMA(m[8],  cz, V::FMA(m[4], cy, V::FMA(m[0], cx, m[12])));
+					const V wcy = V::FMA(m[9],  cz, V::FMA(m[5], cy, V::FMA(m[1], cx, m[13])));
+					const V wcz = V::FMA(m[10], cz, V::FMA(m[6], cy, V::FMA(m[2], cx, m[14])));
+
+					const V wex = V::Abs(m[0]) * ex + V::Abs(m[4]) * ey + V::Abs(m[8])  * ez;
+					const V wey = V::Abs(m[1]) * ex + V::Abs(m[5]) * ey + V::Abs(m[9])  * ez;
+					const V wez = V::Abs(m[2]) * ex + V::Abs(m[6]) * ey + V::Abs(m[10]) * ez;
+
+					V::Store(out[0] + i, wcx - wex);
+					V::Store(out[1] + i, wcy - wey);
+					V::Store(out[2] + i, wcz - wez);
+					V::Store(out[3] + i, wcx + wex);
+					V::Store(out[4] + i, wcy + wey);
+					V::Store(out[5] + i, wcz + wez);
+				}
+			}
+
+			template<typename V>
+			void ExtractFrustumPlanes_Lanes(const float* viewProjections, float* out, size_t count)
+			{
+				constexpr size_t W = V::Width;
+
+				const V eps = V::Set1(LaneFrustumPlaneEpsilon);
+				const V one = V::Set1(1.0f);
+
+				for (size_t i = 0; i < count; i += W)
+				{
+					V m[16];
+					V::LoadMat4(viewProjections + i * 16, m);
+
+					/**
+					* @brief row k component c is m[c * 4 + k].
+					*/
+					V p[6][4];
+					for (int c = 0; c < 4; c++)
+					{
+						const V r0 = m[c * 4 + 0];
+						const V r1 = m[c * 4 + 1];
+						const V r2 = m[c * 4 + 2];
+						const V r3 = m[c * 4 + 3];
+
+						p[0][c] = r3 + r0;
+						p[1][c] = r3 - r0;
+						p[2][c] = r3 + r1;
+						p[3][c] = r3 - r1;
+						p[4][c] = r2;
+						p[5][c] = r3 - r2;
+					}
+
+					alignas(32) float lanes[W];
+					for (int k = 0; k < 6; k++)
+					{
+						const V len = V::Sqrt(p[k][0] * p[k][0] + p[k][1] * p[k][1] + p[k][2] * p[k][2]);
+						const V inv = V::Select(V::CmpGT(len, eps), one / len, one);
+
+						for (int c = 0; c < 4; c++)
+						{
+							V::Store(lanes, p[k][c] * inv);
+							for (size_t l = 0; l < W; l++)
+							{
+								out[(i + l) * 24 + k * 4 + c] = lanes[l];
+							}
+						}
+					}
+				}
+			}
+
+			template<typename V>
+			uint32_t CullSpheres_Lanes(const float* frustum, const float* const spheres[4], uint8_t* outVisible, size_t count)
+			{
+				constexpr size_t W = V::Width;
+
+				V pl[6][4];
+				for (int k = 0; k < 6; k++)
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						pl[k][c] = V::Set1(frustum[k * 4 + c]);
+					}
+				}
+
+				const V zero = V::Set1(0.0f);
+
+				uint32_t visible = 0;
+				for (size_t i = 0; i < count; i += W)
+				{
+					const V x = V::Load(spheres[0] + i);
+					const V y = V::Load(spheres[1] + i);
+					const V z = V::Load(spheres[2] + i);
+					const V r = V::Load(spheres[3] + i);
+
+					V inside = V::CmpGE(V::FMA(pl[0][0], x, V::FMA(pl[0][1], y, V::FMA(pl[0][2], z, pl[0][3] + r))), zero);
+					for (int k = 1; k < 6; k++)
+					{
+						const V d = V::FMA(pl[k][0], x, V::FMA(pl[k][1], y, V::FMA(pl[k][2], z, pl[k][3] + r)));
+						inside = V::And(inside, V::CmpGE(d, zero));
+					}
+
+					const uint32_t bits = V::MoveMask(inside);
+					for (size_t l = 0; l < W; l++)
+					{
+						const uint8_t v = static_cast<uint8_t>((bits >> l) & 1u);
+						outVisible[i + l] = v;
+						visible += v;
+					}
+				}
+
+				return visible;
+			}
+
+			/**
+			* @brief Build a lane kernel table from a lane type.
+			*/
+			template<typename V>
+			constexpr BatchMathLaneKernels MakeBatchMathLaneKernels()
+			{
+				return {
+					V::Width,
+					&ComposeTRS_Lanes<V>,
+					&MulMat4_Lanes<V>,
+					&InverseAffine_Lanes<V>,
+					&TransformSpheres_Lanes<V>,
+					&TransformAABBs_Lanes<V>,
+					&ExtractFrustumPlanes_Lanes<V>,
+					&CullSpheres_Lanes<V>,
+				};
+			}
+		}
+	}
+}
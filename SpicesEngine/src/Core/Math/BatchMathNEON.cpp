@@ -0,0 +1,115 @@
+/**
+* @file BatchMathNEON.cpp.
+* @brief The BatchMath NEON Kernels Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "BatchMathLanes.h"
+
+#if defined(_M_ARM64) || defined(__aarch64__)
+
+#include <arm_neon.h>
+
+namespace Spices {
+
+	namespace detail {
+
+		namespace {
+
+			/**
+			* @brief 4 float lanes in a q register.
+			*/
+			struct LaneNEON
+			{
+				static constexpr size_t Width = 4;
+
+				float32x4_t v;
+
+				static LaneNEON Set1(float f)                              { return { vdupq_n_f32(f) }; }
+				static LaneNEON Load(const float* p)                       { return { vld1q_f32(p) }; }
+				static void     Store(float* p, LaneNEON a)                { vst1q_f32(p, a.v); }
+				static LaneNEON FMA(LaneNEON a, LaneNEON b, LaneNEON c)    { return { vfmaq_f32(c.v, a.v, b.v) }; }
+				static LaneNEON Min(LaneNEON a, LaneNEON b)                { return { vminq_f32(a.v, b.v) }; }
+				static LaneNEON Max(LaneNEON a, LaneNEON b)                { return { vmaxq_f32(a.v, b.v) }; }
+				static LaneNEON Abs(LaneNEON a)                            { return { vabsq_f32(a.v) }; }
+				static LaneNEON Sqrt(LaneNEON a)                           { return { vsqrtq_f32(a.v) }; }
+				static LaneNEON CmpGE(LaneNEON a, LaneNEON b)              { return { vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v)) }; }
+				static LaneNEON CmpGT(LaneNEON a, LaneNEON b)              { return { vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)) }; }
+				static LaneNEON And(LaneNEON a, LaneNEON b)                { return { vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) }; }
+				static LaneNEON Select(LaneNEON m, LaneNEON a, LaneNEON b) { return { vbslq_f32(vreinterpretq_u32_f32(m.v), a.v, b.v) }; }
+
+				static uint32_t MoveMask(LaneNEON m)
+				{
+					static const uint32_t bits[4] = { 1, 2, 4, 8 };
+					return vaddvq_u32(vandq_u32(vreinterpretq_u32_f32(m.v), vld1q_u32(bits)));
+				}
+
+				static void Transpose(float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3)
+				{
+					const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+					const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+					r0 = vcombine_f32(vget_low_f32 (t01.val[0]), vget_low_f32 (t23.val[0]));
+					r1 = vcombine_f32(vget_low_f32 (t01.val[1]), vget_low_f32 (t23.val[1]));
+					r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+					r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+				}
+
+				static void LoadMat4(const float* m, LaneNEON out[16])
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						float32x4_t r0 = vld1q_f32(m + c * 4);
+						float32x4_t r1 = vld1q_f32(m + 16 + c * 4);
+						float32x4_t r2 = vld1q_f32(m + 32 + c * 4);
+						float32x4_t r3 = vld1q_f32(m + 48 + c * 4);
+						Transpose(r0, r1, r2, r3);
+						out[c * 4 + 0].v = r0;
+						out[c * 4 + 1].v = r1;
+						out[c * 4 + 2].v = r2;
+						out[c * 4 + 3].v = r3;
+					}
+				}
+
+				static void StoreMat4(float* m, const LaneNEON in[16])
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						float32x4_t r0 = in[c * 4 + 0].v;
+						float32x4_t r1 = in[c * 4 + 1].v;
+						float32x4_t r2 = in[c * 4 + 2].v;
+						float32x4_t r3 = in[c * 4 + 3].v;
+						Transpose(r0, r1, r2, r3);
+						vst1q_f32(m + c * 4, r0);
+						vst1q_f32(m + 16 + c * 4, r1);
+						vst1q_f32(m + 32 + c * 4, r2);
+						vst1q_f32(m + 48 + c * 4, r3);
+					}
+				}
+			};
+
+			inline LaneNEON operator+(LaneNEON a, LaneNEON b) { return { vaddq_f32(a.v, b.v) }; }
+			inline LaneNEON operator-(LaneNEON a, LaneNEON b) { return { vsubq_f32(a.v, b.v) }; }
+			inline LaneNEON operator*(LaneNEON a, LaneNEON b) { return { vmulq_f32(a.v, b.v) }; }
+			inline LaneNEON operator/(LaneNEON a, LaneNEON b) { return { vdivq_f32(a.v, b.v) }; }
+		}
+
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_NEON()
+		{
+			static constexpr BatchMathLaneKernels kernels = MakeBatchMathLaneKernels<LaneNEON>();
+			return &kernels;
+		}
+	}
+}
+
+#else
+
+namespace Spices {
+
+	namespace detail {
+
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_NEON() { return nullptr; }
+	}
+}
+
+#endif
@@ -0,0 +1,101 @@
+/**
+* @file BatchMathSSE41.cpp.
+* @brief The BatchMath SSE4.1 Kernels Implementation.
+* Compiled without PreCompiler Header, see SpicesEngine premake.
+* Includes nothing but intrinsics and BatchMathLanes.h, see there.
+* @author Spices.
+*/
+
+#include "BatchMathLanes.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+
+#include <smmintrin.h>
+
+namespace Spices {
+
+	namespace detail {
+
+		namespace {
+
+			/**
+			* @brief 4 float lanes in a xmm register.
+			*/
+			struct LaneSSE41
+			{
+				static constexpr size_t Width = 4;
+
+				__m128 v;
+
+				static LaneSSE41 Set1(float f)                                 { return { _mm_set1_ps(f) }; }
+				static LaneSSE41 Load(const float* p)                          { return { _mm_loadu_ps(p) }; }
+				static void      Store(float* p, LaneSSE41 a)                  { _mm_storeu_ps(p, a.v); }
+				static LaneSSE41 FMA(LaneSSE41 a, LaneSSE41 b, LaneSSE41 c)    { return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) }; }
+				static LaneSSE41 Min(LaneSSE41 a, LaneSSE41 b)                 { return { _mm_min_ps(a.v, b.v) }; }
+				static LaneSSE41 Max(LaneSSE41 a, LaneSSE41 b)                 { return { _mm_max_ps(a.v, b.v) }; }
+				static LaneSSE41 Abs(LaneSSE41 a)                              { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+				static LaneSSE41 Sqrt(LaneSSE41 a)                             { return { _mm_sqrt_ps(a.v) }; }
+				static LaneSSE41 CmpGE(LaneSSE41 a, LaneSSE41 b)               { return { _mm_cmpge_ps(a.v, b.v) }; }
+				static LaneSSE41 CmpGT(LaneSSE41 a, LaneSSE41 b)               { return { _mm_cmpgt_ps(a.v, b.v) }; }
+				static LaneSSE41 And(LaneSSE41 a, LaneSSE41 b)                 { return { _mm_and_ps(a.v, b.v) }; }
+				static LaneSSE41 Select(LaneSSE41 m, LaneSSE41 a, LaneSSE41 b) { return { _mm_blendv_ps(b.v, a.v, m.v) }; }
+				static uint32_t  MoveMask(LaneSSE41 m)                         { return static_cast<uint32_t>(_mm_movemask_ps(m.v)); }
+
+				static void LoadMat4(const float* m, LaneSSE41 out[16])
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						__m128 r0 = _mm_loadu_ps(m + c * 4);
+						__m128 r1 = _mm_loadu_ps(m + 16 + c * 4);
+						__m128 r2 = _mm_loadu_ps(m + 32 + c * 4);
+						__m128 r3 = _mm_loadu_ps(m + 48 + c * 4);
+						_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+						out[c * 4 + 0].v = r0;
+						out[c * 4 + 1].v = r1;
+						out[c * 4 + 2].v = r2;
+						out[c * 4 + 3].v = r3;
+					}
+				}
+
+				static void StoreMat4(float* m, const LaneSSE41 in[16])
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						__m128 r0 = in[c * 4 + 0].v;
+						__m128 r1 = in[c * 4 + 1].v;
+						__m128 r2 = in[c * 4 + 2].v;
+						__m128 r3 = in[c * 4 + 3].v;
+						_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+						_mm_storeu_ps(m + c * 4, r0);
+						_mm_storeu_ps(m + 16 + c * 4, r1);
+						_mm_storeu_ps(m + 32 + c * 4, r2);
+						_mm_storeu_ps(m + 48 + c * 4, r3);
+					}
+				}
+			};
+
+			inline LaneSSE41 operator+(LaneSSE41 a, LaneSSE41 b) { return { _mm_add_ps(a.v, b.v) }; }
+			inline LaneSSE41 operator-(LaneSSE41 a, LaneSSE41 b) { return { _mm_sub_ps(a.v, b.v) }; }
+			inline LaneSSE41 operator*(LaneSSE41 a, LaneSSE41 b) { return { _mm_mul_ps(a.v, b.v) }; }
+			inline LaneSSE41 operator/(LaneSSE41 a, LaneSSE41 b) { return { _mm_div_ps(a.v, b.v) }; }
+		}
+
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_SSE41()
+		{
+			static constexpr BatchMathLaneKernels kernels = MakeBatchMathLaneKernels<LaneSSE41>();
+			return &kernels;
+		}
+	}
+}
+
+#else
+
+namespace Spices {
+
+	namespace detail {
+
+		const BatchMathLaneKernels* GetBatchMathLaneKernels_SSE41() { return nullptr; }
+	}
+}
+
+#endif
@@ -0,0 +1,149 @@
+/**
+* @file BatchMathScalar.cpp.
+* @brief The BatchMath Scalar Kernels Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "BatchMathKernels.h"
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+
+namespace Spices {
+
+	namespace detail {
+
+		void ComposeTRS_Scalar(const TRSSoA& trs, glm::mat4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const glm::quat q(trs.qw[i], trs.qx[i], trs.qy[i], trs.qz[i]);
+
+				glm::mat4 m = glm::mat4_cast(q);
+				m[0] *= trs.sx[i];
+				m[1] *= trs.sy[i];
+				m[2] *= trs.sz[i];
+				m[3]  = glm::vec4(trs.px[i], trs.py[i], trs.pz[i], 1.0f);
+
+				out[i] = m;
+			}
+		}
+
+		void MulMat4_Scalar(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				out[i] = a[i] * b[i];
+			}
+		}
+
+		void InverseAffine_Scalar(const glm::mat4* in, glm::mat4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				out[i] = glm::affineInverse(in[i]);
+			}
+		}
+
+		void TransformSpheres_Scalar(const glm::mat4* matrices, const SphereSoA& in, const SphereSoA& out, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const glm::mat4& m = matrices[i];
+
+				const glm::vec4 c = m * glm::vec4(in.x[i], in.y[i], in.z[i], 1.0f);
+				const float s = glm::max(glm::dot(glm::vec3(m[0]), glm::vec3(m[0])),
+				                glm::max(glm::dot(glm::vec3(m[1]), glm::vec3(m[1])),
+				                         glm::dot(glm::vec3(m[2]), glm::vec3(m[2]))));
+
+				out.x[i] = c.x;
+				out.y[i] = c.y;
+				out.z[i] = c.z;
+				out.r[i] = in.r[i] * glm::sqrt(s);
+			}
+		}
+
+		void TransformAABBs_Scalar(const glm::mat4* matrices, const AABBSoA& in, const AABBSoA& out, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const glm::mat4& m = matrices[i];
+
+				const glm::vec3 min(in.minX[i], in.minY[i], in.minZ[i]);
+				const glm::vec3 max(in.maxX[i], in.maxY[i], in.maxZ[i]);
+
+				const glm::vec3 c = glm::vec3(m * glm::vec4((min + max) * 0.5f, 1.0f));
+				const glm::vec3 h = (max - min) * 0.5f;
+
+				const glm::mat3 a = glm::mat3(glm::abs(glm::vec3(m[0])), glm::abs(glm::vec3(m[1])), glm::abs(glm::vec3(m[2])));
+				const glm::vec3 e = a * h;
+
+				out.minX[i] = c.x - e.x; out.maxX[i] = c.x + e.x;
+				out.minY[i] = c.y - e.y; out.maxY[i] = c.y + e.y;
+				out.minZ[i] = c.z - e.z; out.maxZ[i] = c.z + e.z;
+			}
+		}
+
+		void ExtractFrustumPlanes_Scalar(const glm::mat4* viewProjections, FrustumPlanes* out, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				const glm::mat4 t = glm::transpose(viewProjections[i]);
+
+				glm::vec4* p = out[i].planes;
+				p[0] = t[3] + t[0];
+				p[1] = t[3] - t[0];
+				p[2] = t[3] + t[1];
+				p[3] = t[3] - t[1];
+				p[4] = t[2];
+				p[5] = t[3] - t[2];
+
+				for (int k = 0; k < 6; k++)
+				{
+					const float len = glm::length(glm::vec3(p[k]));
+					if (len > FrustumPlaneEpsilon)
+					{
+						p[k] /= len;
+					}
+				}
+			}
+		}
+
+		uint32_t CullSpheres_Scalar(const FrustumPlanes& frustum, const SphereSoA& spheres, uint8_t* outVisible, size_t count)
+		{
+			uint32_t visible = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				const glm::vec3 c(spheres.x[i], spheres.y[i], spheres.z[i]);
+
+				bool inside = true;
+				for (int k = 0; k < 6; k++)
+				{
+					const glm::vec4& p = frustum.planes[k];
+					inside &= glm::dot(glm::vec3(p), c) + p.w + spheres.r[i] >= 0.0f;
+				}
+
+				outVisible[i] = inside ? 1 : 0;
+				visible += inside ? 1 : 0;
+			}
+			return visible;
+		}
+
+		const BatchMathKernels* GetBatchMathKernels_Scalar()
+		{
+			static const BatchMathKernels kernels = {
+				SIMDInstructionSet::Scalar,
+				&ComposeTRS_Scalar,
+				&MulMat4_Scalar,
+				&InverseAffine_Scalar,
+				&TransformSpheres_Scalar,
+				&TransformAABBs_Scalar,
+				&ExtractFrustumPlanes_Scalar,
+				&CullSpheres_Scalar,
+			};
+
+			return &kernels;
+		}
+	}
+}
@@ -0,0 +1,155 @@
+/**
+* @file FrameAllocator.cpp
+* @brief The FrameAllocator Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "FrameAllocator.h"
+
+namespace Spices {
+
+	std::atomic<uint32_t> FrameAllocator::s_FrameIndex = 0;
+	std::atomic<uint64_t> FrameAllocator::s_Epoch      = 0;
+
+	std::atomic<uint64_t> AllocationCounter::s_Count   = 0;
+	std::atomic<uint64_t> AllocationCounter::s_Bytes   = 0;
+
+	namespace {
+
+		/**
+		* @brief Alignment of chunks from upstream.
+		*/
+		constexpr size_t ChunkAlignment = alignof(std::max_align_t);
+	}
+
+	LinearArena::LinearArena(size_t chunkSize)
+		: m_ChunkSize(std::max<size_t>(chunkSize, 256))
+	{}
+
+	LinearArena::~LinearArena()
+	{
+		FreeChunks();
+	}
+
+	void LinearArena::Reset()
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Merge chunks, the next frame of same usage fits in one chunk.
+		*/
+		if (m_Chunks.size() > 1)
+		{
+			const size_t capacity = m_Capacity;
+
+			FreeChunks();
+			AddChunk(capacity);
+		}
+		else if (!m_Chunks.empty())
+		{
+			m_Cursor = m_Chunks[0].data;
+			m_End    = m_Chunks[0].data + m_Chunks[0].bytes;
+		}
+
+		m_Used = 0;
+	}
+
+	void* LinearArena::do_allocate(size_t bytes, size_t alignment)
+	{
+		bytes = std::max<size_t>(bytes, 1);
+
+		auto align = [&](std::byte* p) {
+			const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+			return reinterpret_cast<std::byte*>((address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+		};
+
+		std::byte* p = m_Cursor ? align(m_Cursor) : nullptr;
+
+		if (!p || p + bytes > m_End)
+		{
+			AddChunk(std::max(bytes + alignment, m_ChunkSize));
+
+			p = align(m_Cursor);
+		}
+
+		m_Used  += (p + bytes) - m_Cursor;
+		m_Cursor = p + bytes;
+
+		return p;
+	}
+
+	void LinearArena::AddChunk(size_t bytes)
+	{
+		Chunk chunk;
+		chunk.data  = static_cast<std::byte*>(std::pmr::new_delete_resource()->allocate(bytes, ChunkAlignment));
+		chunk.bytes = bytes;
+
+		m_Chunks.push_back(chunk);
+
+		m_Cursor    = chunk.data;
+		m_End       = chunk.data + bytes;
+		m_Capacity += bytes;
+	}
+
+	void LinearArena::FreeChunks()
+	{
+		for (const auto& chunk : m_Chunks)
+		{
+			std::pmr::new_delete_resource()->deallocate(chunk.data, chunk.bytes, ChunkAlignment);
+		}
+
+		m_Chunks.clear();
+
+		m_Cursor   = nullptr;
+		m_End      = nullptr;
+		m_Capacity = 0;
+	}
+
+	void FrameAllocator::BeginFrame(uint32_t frameIndex)
+	{
+		SPICES_PROFILE_ZONE;
+
+		s_FrameIndex.store(frameIndex % MaxFrames, std::memory_order_relaxed);
+		s_Epoch.fetch_add(1, std::memory_order_release);
+	}
+
+	LinearArena& FrameAllocator::Get()
+	{
+		/**
+		* @brief Arenas of this thread, one per frame in flight.
+		*/
+		struct ThreadArenas
+		{
+			std::array<LinearArena, MaxFrames> arenas;
+			std::array<uint64_t,    MaxFrames> epochs{};
+		};
+
+		thread_local ThreadArenas threadArenas;
+
+		const uint32_t frameIndex = s_FrameIndex.load(std::memory_order_relaxed);
+		const uint64_t epoch      = s_Epoch.load(std::memory_order_acquire);
+
+		LinearArena& arena = threadArenas.arenas[frameIndex];
+
+		if (threadArenas.epochs[frameIndex] != epoch)
+		{
+			arena.Reset();
+			threadArenas.epochs[frameIndex] = epoch;
+		}
+
+		return arena;
+	}
+
+	void AllocationCounter::OnAllocate(size_t bytes) noexcept
+	{
+		s_Count.fetch_add(1,     std::memory_order_relaxed);
+		s_Bytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void AllocationCounter::Reset() noexcept
+	{
+		s_Count.store(0, std::memory_order_relaxed);
+		s_Bytes.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,252 @@
+/**
+* @file FrameAllocator.h
+* @brief The FrameAllocator Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <memory_resource>
+#include <atomic>
+#include <vector>
+
+namespace Spices {
+
+	/**
+	* @brief Bump allocator, memory is released all at once by Reset.
+	* Deallocate does nothing, so containers using it must not outlive a Reset.
+	*/
+	class LinearArena : public std::pmr::memory_resource
+	{
+	public:
+
+		/**
+		* @brief Default bytes of a chunk.
+		*/
+		static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] chunkSize Bytes of a chunk, larger requests get their own chunk.
+		*/
+		explicit LinearArena(size_t chunkSize = DefaultChunkSize);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		~LinearArena() override;
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		LinearArena(const LinearArena&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		/**
+		* @brief Release all allocations.
+		* Chunks are merged into one chunk of total capacity, so the same usage next time needs no upstream allocation.
+		*/
+		void Reset();
+
+		/**
+		* @brief Get bytes allocated since last Reset.
+		* @return Returns used bytes, including alignment padding.
+		*/
+		size_t GetUsed() const { return m_Used; }
+
+		/**
+		* @brief Get bytes of all chunks.
+		* @return Returns capacity bytes.
+		*/
+		size_t GetCapacity() const { return m_Capacity; }
+
+		/**
+		* @brief Get chunks count.
+		* @return Returns chunks count.
+		*/
+		size_t GetChunkCount() const { return m_Chunks.size(); }
+
+	private:
+
+		/**
+		* @brief The interface is inherited from std::pmr::memory_resource.
+		* @param[in] bytes Bytes.
+		* @param[in] alignment Alignment.
+		* @return Returns memory.
+		*/
+		void* do_allocate(size_t bytes, size_t alignment) override;
+
+		/**
+		* @brief The interface is inherited from std::pmr::memory_resource.
+		* Do nothing, memory is released by Reset.
+		*/
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override {}
+
+		/**
+		* @brief The interface is inherited from std::pmr::memory_resource.
+		* @param[in] other Other resource.
+		* @return Returns true if it is this arena.
+		*/
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		/**
+		* @brief Add a chunk and make it current.
+		* @param[in] bytes Bytes of chunk.
+		*/
+		void AddChunk(size_t bytes);
+
+		/**
+		* @brief Free all chunks.
+		*/
+		void FreeChunks();
+
+	private:
+
+		/**
+		* @brief A memory block from upstream.
+		*/
+		struct Chunk
+		{
+			std::byte* data  = nullptr;   /* @brief Begin of chunk.   */
+			size_t     bytes = 0;         /* @brief Bytes of chunk.   */
+		};
+
+		/**
+		* @brief Bytes of a new chunk.
+		*/
+		size_t m_ChunkSize;
+
+		/**
+		* @brief Chunks, last one is current.
+		*/
+		std::vector<Chunk> m_Chunks;
+
+		/**
+		* @brief Next free byte in current chunk.
+		*/
+		std::byte* m_Cursor = nullptr;
+
+		/**
+		* @brief End of current chunk.
+		*/
+		std::byte* m_End = nullptr;
+
+		/**
+		* @brief Bytes allocated since last Reset.
+		*/
+		size_t m_Used = 0;
+
+		/**
+		* @brief Bytes of all chunks.
+		*/
+		size_t m_Capacity = 0;
+	};
+
+	/**
+	* @brief Per frame, per thread linear allocator for transient data.
+	* Every thread owns one arena per frame in flight, an arena is reset the first time its thread
+	* uses it in a new frame, which is after the fence of that frame in flight was waited.
+	* So memory from it is valid until the same frame in flight begins again.
+	*/
+	class FrameAllocator
+	{
+	public:
+
+		/**
+		* @brief Maximum frames in flight supported.
+		*/
+		static constexpr uint32_t MaxFrames = 4;
+
+	public:
+
+		/**
+		* @brief Begin a frame, called once per frame on main thread.
+		* @param[in] frameIndex Frame in flight index.
+		*/
+		static void BeginFrame(uint32_t frameIndex);
+
+		/**
+		* @brief Get the arena of this thread and current frame.
+		* @return Returns the arena.
+		*/
+		static LinearArena& Get();
+
+		/**
+		* @brief Get the arena of this thread and current frame as memory resource, used by std::pmr containers.
+		* @return Returns the memory resource.
+		*/
+		static std::pmr::memory_resource* GetResource() { return &Get(); }
+
+		/**
+		* @brief Get current frame in flight index.
+		* @return Returns frame in flight index.
+		*/
+		static uint32_t GetFrameIndex() { return s_FrameIndex.load(std::memory_order_relaxed); }
+
+	private:
+
+		/**
+		* @brief Current frame in flight index.
+		*/
+		static std::atomic<uint32_t> s_FrameIndex;
+
+		/**
+		* @brief Frames begun count, an arena is reset when its epoch differs.
+		*/
+		static std::atomic<uint64_t> s_Epoch;
+	};
+
+	/**
+	* @brief Global heap allocations counter.
+	* Nothing calls it by default, a test overrides global operator new to call OnAllocate
+	* and asserts a steady state frame allocates nothing.
+	*/
+	class AllocationCounter
+	{
+	public:
+
+		/**
+		* @brief Count an allocation.
+		* @param[in] bytes Bytes.
+		*/
+		static void OnAllocate(size_t bytes) noexcept;
+
+		/**
+		* @brief Reset counters.
+		*/
+		static void Reset() noexcept;
+
+		/**
+		* @brief Get allocations count since last Reset.
+		* @return Returns allocations count.
+		*/
+		static uint64_t GetCount() noexcept { return s_Count.load(std::memory_order_relaxed); }
+
+		/**
+		* @brief Get allocated bytes since last Reset.
+		* @return Returns allocated bytes.
+		*/
+		static uint64_t GetBytes() noexcept { return s_Bytes.load(std::memory_order_relaxed); }
+
+	private:
+
+		/**
+		* @brief Allocations count.
+		*/
+		static std::atomic<uint64_t> s_Count;
+
+		/**
+		* @brief Allocated bytes.
+		*/
+		static std::atomic<uint64_t> s_Bytes;
+	};
+}
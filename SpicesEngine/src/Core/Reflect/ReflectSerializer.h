@@ -0,0 +1,515 @@
+/**
+* @file ReflectSerializer.h.
+* @brief The ReflectSerializer Class Definitions and Implementation.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "StaticReflect/ClassTraits.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Spices {
+
+	namespace detail {
+
+		/**
+		* @brief True if class_traits<T> is declared by UCLASS with UPROPERTYS.
+		* @note UCLASS must be visible before first use of T.
+		*/
+		template<typename T, typename = void>
+		struct is_reflected : std::false_type {};
+
+		template<typename T>
+		struct is_reflected<T, std::void_t<decltype(class_traits<T>::properties)>> : std::true_type {};
+
+		template<typename T>
+		constexpr bool is_reflected_v = is_reflected<T>::value;
+
+		/**
+		* @brief True if T is a std::vector.
+		*/
+		template<typename T>
+		struct is_vector : std::false_type {};
+
+		template<typename T, typename A>
+		struct is_vector<std::vector<T, A>> : std::true_type {};
+
+		template<typename T>
+		constexpr bool is_vector_v = is_vector<T>::value;
+
+		/**
+		* @brief True if T is written as raw bytes.
+		*/
+		template<typename T>
+		constexpr bool is_raw_v = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T>;
+	}
+
+	/**
+	* @brief Binary serializer driven by class_traits<T>::properties.
+	* Member properties are written in declaration order, runs of trivially copyable properties laid out
+	* back to back are written by one memcpy, computed at compile time.
+	* std::string, std::vector and reflected classes are written recursively,
+	* a std::vector of trivially copyable elements is one memcpy.
+	* A stream starts with the schema hash of T, hashed from names, types, offsets and sizes of properties recursively,
+	* so a stream is rejected once T changes.
+	* Static properties are ignored, pointer properties are not allowed.
+	*/
+	class ReflectSerializer
+	{
+	public:
+
+		/**
+		* @brief Get schema hash of a type.
+		* @tparam T Serialized type.
+		* @return Returns schema hash.
+		*/
+		template<typename T>
+		static constexpr uint64_t SchemaHash() { return TypeHash<T>(); }
+
+		/**
+		* @brief Append schema hash and data of a instance.
+		* @tparam T Reflected type.
+		* @param[in] inst The instance.
+		* @param[in,out] out Bytes appended to.
+		*/
+		template<typename T>
+		static void Serialize(const T& inst, std::vector<char>& out);
+
+		/**
+		* @brief Read a instance from bytes written by Serialize.
+		* @tparam T Reflected type.
+		* @param[in] data The bytes.
+		* @param[in] size Bytes count.
+		* @param[out] inst The instance.
+		* @param[out] outRead Bytes read, may be nullptr.
+		* @return Returns false if schema is different or bytes are truncated.
+		*/
+		template<typename T>
+		static bool Deserialize(const char* data, uint64_t size, T& inst, uint64_t* outRead = nullptr);
+
+	private:
+
+		/**
+		* @brief A member property.
+		*/
+		struct Field
+		{
+			uint64_t offset = 0;        /* @brief Offset in class.                          */
+			uint64_t size   = 0;        /* @brief Bytes of property.                        */
+			uint64_t run    = 0;        /* @brief Bytes of run starts here, 0 if none.      */
+			bool     isRaw  = false;    /* @brief True if trivially copyable.               */
+		};
+
+		/**
+		* @brief Properties tuple of a reflected class.
+		*/
+		template<typename T>
+		using Properties = std::decay_t<decltype(class_traits<T>::properties)>;
+
+		/**
+		* @brief Member properties of a reflected class, with runs.
+		* @tparam T Reflected type.
+		* @return Returns one Field per property, zeros for static properties.
+		*/
+		template<typename T>
+		static constexpr std::array<Field, std::tuple_size_v<Properties<T>>> BuildFields();
+
+		/**
+		* @brief FNV-1a mix.
+		*/
+		static constexpr uint64_t Mix(uint64_t hash, std::string_view str);
+		static constexpr uint64_t Mix(uint64_t hash, uint64_t value);
+
+		/**
+		* @brief Schema hash of a type.
+		*/
+		template<typename T>
+		static constexpr uint64_t TypeHash();
+
+		/**
+		* @brief Append bytes.
+		*/
+		static void WriteBytes(std::vector<char>& out, const void* data, uint64_t size);
+
+		/**
+		* @brief Bounded reader.
+		*/
+		struct Reader
+		{
+			const char* data;
+			uint64_t    size;
+			uint64_t    offset = 0;
+
+			bool Read(void* dst, uint64_t bytes);
+		};
+
+		/**
+		* @brief Write/Read a value.
+		*/
+		template<typename T>
+		static void WriteValue(std::vector<char>& out, const T& value);
+
+		template<typename T>
+		static bool ReadValue(Reader& reader, T& value);
+
+		/**
+		* @brief Write/Read member properties of a reflected class.
+		*/
+		template<typename T, size_t... I>
+		static void WriteFields(std::vector<char>& out, const T& inst, std::index_sequence<I...>);
+
+		template<typename T, size_t... I>
+		static bool ReadFields(Reader& reader, T& inst, std::index_sequence<I...>);
+
+		template<typename T, size_t I>
+		static void WriteField(std::vector<char>& out, const T& inst);
+
+		template<typename T, size_t I>
+		static bool ReadField(Reader& reader, T& inst);
+
+		/**
+		* @brief Traits of I-th property.
+		*/
+		template<typename T, size_t I>
+		using FieldTraits = typename std::tuple_element_t<I, Properties<T>>::traits;
+	};
+
+	template<typename T>
+	inline constexpr std::array<ReflectSerializer::Field, std::tuple_size_v<ReflectSerializer::Properties<T>>> ReflectSerializer::BuildFields()
+	{
+		constexpr size_t count = std::tuple_size_v<Properties<T>>;
+
+		std::array<Field, count> fields{};
+
+		/**
+		* @brief Offsets and sizes.
+		*/
+		size_t i = 0;
+		std::apply([&](const auto&... property) {
+			(([&] {
+				using P = typename std::decay_t<decltype(property)>::traits;
+				using M = typename P::Type;
+
+				if constexpr (P::is_member)
+				{
+					static_assert(!std::is_pointer_v<M> && !std::is_member_pointer_v<M>, "ReflectSerializer: pointer property is not serializable.");
+
+					fields[i].offset = property.offset;
+					fields[i].size   = sizeof(M);
+					fields[i].isRaw  = detail::is_raw_v<M>;
+				}
+				++i;
+			}()), ...);
+		}, class_traits<T>::properties);
+
+		/**
+		* @brief Merge properties laid out back to back into runs.
+		*/
+		for (size_t begin = 0; begin < count;)
+		{
+			if (!fields[begin].isRaw)
+			{
+				++begin;
+				continue;
+			}
+
+			size_t end = begin + 1;
+			uint64_t bytes = fields[begin].size;
+			while (end < count && fields[end].isRaw && fields[end].offset == fields[begin].offset + bytes)
+			{
+				bytes += fields[end].size;
+				++end;
+			}
+
+			fields[begin].run = bytes;
+			begin = end;
+		}
+
+		return fields;
+	}
+
+	inline constexpr uint64_t ReflectSerializer::Mix(uint64_t hash, std::string_view str)
+	{
+		for (size_t i = 0; i < str.size(); i++)
+		{
+			hash ^= static_cast<uint8_t>(str[i]);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	inline constexpr uint64_t ReflectSerializer::Mix(uint64_t hash, uint64_t value)
+	{
+		for (size_t i = 0; i < sizeof(value); i++)
+		{
+			hash ^= (value >> (i * 8)) & 0xFF;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	template<typename T>
+	inline constexpr uint64_t ReflectSerializer::TypeHash()
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		if constexpr (detail::is_reflected_v<T>)
+		{
+			hash = Mix(hash, "class");
+			hash = Mix(hash, sizeof(T));
+
+			std::apply([&](const auto&... property) {
+				(([&] {
+					using P = typename std::decay_t<decltype(property)>::traits;
+
+					if constexpr (P::is_member)
+					{
+						hash = Mix(hash, property.name);
+						hash = Mix(hash, property.offset);
+						hash = Mix(hash, TypeHash<typename P::Type>());
+					}
+				}()), ...);
+			}, class_traits<T>::properties);
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			hash = Mix(hash, "string");
+		}
+		else if constexpr (detail::is_vector_v<T>)
+		{
+			hash = Mix(hash, "vector");
+			hash = Mix(hash, TypeHash<typename T::value_type>());
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			hash = Mix(hash, "enum");
+			hash = Mix(hash, TypeHash<std::underlying_type_t<T>>());
+		}
+		else if constexpr (std::is_arithmetic_v<T>)
+		{
+			hash = Mix(hash, std::is_floating_point_v<T> ? "float" : std::is_signed_v<T> ? "int" : "uint");
+			hash = Mix(hash, sizeof(T));
+		}
+		else
+		{
+			static_assert(detail::is_raw_v<T>, "ReflectSerializer: type is not serializable, reflect it by UCLASS.");
+
+			hash = Mix(hash, "raw");
+			hash = Mix(hash, sizeof(T));
+			hash = Mix(hash, alignof(T));
+		}
+
+		return hash;
+	}
+
+	template<typename T>
+	inline void ReflectSerializer::Serialize(const T& inst, std::vector<char>& out)
+	{
+		SPICES_PROFILE_ZONE;
+
+		constexpr uint64_t schema = SchemaHash<T>();
+
+		WriteBytes(out, &schema, sizeof(schema));
+		WriteValue(out, inst);
+	}
+
+	template<typename T>
+	inline bool ReflectSerializer::Deserialize(const char* data, uint64_t size, T& inst, uint64_t* outRead)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Reader reader{ data, size };
+
+		uint64_t schema = 0;
+		if (!reader.Read(&schema, sizeof(schema)) || schema != SchemaHash<T>()) return false;
+		if (!ReadValue(reader, inst)) return false;
+
+		if (outRead) *outRead = reader.offset;
+
+		return true;
+	}
+
+	inline void ReflectSerializer::WriteBytes(std::vector<char>& out, const void* data, uint64_t size)
+	{
+		if (size == 0) return;
+
+		const size_t offset = out.size();
+		out.resize(offset + size);
+		std::memcpy(out.data() + offset, data, size);
+	}
+
+	inline bool ReflectSerializer::Reader::Read(void* dst, uint64_t bytes)
+	{
+		if (bytes > size - offset) return false;
+
+		if (bytes) std::memcpy(dst, data + offset, bytes);
+		offset += bytes;
+
+		return true;
+	}
+
+	template<typename T>
+	inline void ReflectSerializer::WriteValue(std::vector<char>& out, const T& value)
+	{
+		if constexpr (detail::is_raw_v<T>)
+		{
+			WriteBytes(out, &value, sizeof(T));
+		}
+		else if constexpr (detail::is_reflected_v<T>)
+		{
+			WriteFields(out, value, std::make_index_sequence<std::tuple_size_v<Properties<T>>>());
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			const uint64_t size = value.size();
+			WriteBytes(out, &size, sizeof(size));
+			WriteBytes(out, value.data(), size);
+		}
+		else if constexpr (detail::is_vector_v<T>)
+		{
+			using E = typename T::value_type;
+			static_assert(!std::is_same_v<E, bool>, "ReflectSerializer: std::vector<bool> is not serializable.");
+
+			const uint64_t size = value.size();
+			WriteBytes(out, &size, sizeof(size));
+
+			if constexpr (detail::is_raw_v<E>)
+			{
+				WriteBytes(out, value.data(), size * sizeof(E));
+			}
+			else
+			{
+				for (const auto& e : value) WriteValue(out, e);
+			}
+		}
+		else
+		{
+			static_assert(detail::is_raw_v<T>, "ReflectSerializer: type is not serializable, reflect it by UCLASS.");
+		}
+	}
+
+	template<typename T>
+	inline bool ReflectSerializer::ReadValue(Reader& reader, T& value)
+	{
+		if constexpr (detail::is_raw_v<T>)
+		{
+			return reader.Read(&value, sizeof(T));
+		}
+		else if constexpr (detail::is_reflected_v<T>)
+		{
+			return ReadFields(reader, value, std::make_index_sequence<std::tuple_size_v<Properties<T>>>());
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			uint64_t size = 0;
+			if (!reader.Read(&size, sizeof(size)) || size > reader.size - reader.offset) return false;
+
+			value.assign(reader.data + reader.offset, size);
+			reader.offset += size;
+
+			return true;
+		}
+		else if constexpr (detail::is_vector_v<T>)
+		{
+			using E = typename T::value_type;
+
+			uint64_t size = 0;
+			if (!reader.Read(&size, sizeof(size))) return false;
+
+			if constexpr (detail::is_raw_v<E>)
+			{
+				if (size > (reader.size - reader.offset) / sizeof(E)) return false;
+
+				value.resize(size);
+				return reader.Read(value.data(), size * sizeof(E));
+			}
+			else
+			{
+				/**
+				* @brief Every element takes at least a byte except empty classes, bound the count before resize.
+				*/
+				if (size > reader.size - reader.offset && !std::is_empty_v<E>) return false;
+
+				value.resize(size);
+				for (auto& e : value)
+				{
+					if (!ReadValue(reader, e)) return false;
+				}
+
+				return true;
+			}
+		}
+		else
+		{
+			static_assert(detail::is_raw_v<T>, "ReflectSerializer: type is not serializable, reflect it by UCLASS.");
+			return false;
+		}
+	}
+
+	template<typename T, size_t... I>
+	inline void ReflectSerializer::WriteFields(std::vector<char>& out, const T& inst, std::index_sequence<I...>)
+	{
+		(WriteField<T, I>(out, inst), ...);
+	}
+
+	template<typename T, size_t... I>
+	inline bool ReflectSerializer::ReadFields(Reader& reader, T& inst, std::index_sequence<I...>)
+	{
+		return (ReadField<T, I>(reader, inst) && ...);
+	}
+
+	template<typename T, size_t I>
+	inline void ReflectSerializer::WriteField(std::vector<char>& out, const T& inst)
+	{
+		if constexpr (FieldTraits<T, I>::is_member)
+		{
+			constexpr Field field = BuildFields<T>()[I];
+			const char* base = reinterpret_cast<const char*>(&inst) + field.offset;
+
+			if constexpr (field.isRaw)
+			{
+				/**
+				* @brief Properties inside a run are written by its first property.
+				*/
+				if constexpr (field.run > 0) WriteBytes(out, base, field.run);
+			}
+			else
+			{
+				WriteValue(out, *reinterpret_cast<const typename FieldTraits<T, I>::Type*>(base));
+			}
+		}
+	}
+
+	template<typename T, size_t I>
+	inline bool ReflectSerializer::ReadField(Reader& reader, T& inst)
+	{
+		if constexpr (FieldTraits<T, I>::is_member)
+		{
+			constexpr Field field = BuildFields<T>()[I];
+			char* base = reinterpret_cast<char*>(&inst) + field.offset;
+
+			if constexpr (field.isRaw)
+			{
+				if constexpr (field.run > 0) return reader.Read(base, field.run);
+				else                         return true;
+			}
+			else
+			{
+				return ReadValue(reader, *reinterpret_cast<typename FieldTraits<T, I>::Type*>(base));
+			}
+		}
+		else
+		{
+			return true;
+		}
+	}
+}
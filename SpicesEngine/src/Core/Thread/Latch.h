@@ -0,0 +1,93 @@
+/**
+* @file Latch.h
+* @brief The Latch Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <mutex>
+#include <condition_variable>
+
+namespace Spices {
+
+	/**
+	* @brief Downward counter, threads wait until it reaches zero.
+	* Same as C++20 std::latch, but can be Reset for next use once all waiters returned.
+	*/
+	class Latch
+	{
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] count Initial count.
+		*/
+		explicit Latch(uint32_t count = 0) : m_Count(count) {}
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~Latch() = default;
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		Latch(const Latch&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		Latch& operator=(const Latch&) = delete;
+
+		/**
+		* @brief Set count for next use.
+		* @param[in] count Count.
+		*/
+		void Reset(uint32_t count)
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Count = count;
+		}
+
+		/**
+		* @brief Decrement count, wakes waiters when it reaches zero.
+		*/
+		void CountDown()
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+
+			if (m_Count > 0 && --m_Count == 0)
+			{
+				m_Cond.notify_all();
+			}
+		}
+
+		/**
+		* @brief Block until count reaches zero.
+		*/
+		void Wait()
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Cond.wait(lock, [&]() { return m_Count == 0; });
+		}
+
+	private:
+
+		/**
+		* @brief Mutex of count.
+		*/
+		std::mutex m_Mutex;
+
+		/**
+		* @brief Notified when count reaches zero.
+		*/
+		std::condition_variable m_Cond;
+
+		/**
+		* @brief Remaining count.
+		*/
+		uint32_t m_Count;
+	};
+}
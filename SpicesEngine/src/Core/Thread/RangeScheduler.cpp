@@ -0,0 +1,189 @@
+/**
+* @file RangeScheduler.cpp
+* @brief The RangeScheduler Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "RangeScheduler.h"
+
+#include <chrono>
+
+namespace Spices {
+
+	RangeScheduler::RangeScheduler(uint32_t nWorkers, SubmitFunc submit)
+		: m_Submit(std::move(submit))
+	{
+		SPICES_PROFILE_ZONE;
+
+		nWorkers = std::max(nWorkers, 1u);
+
+		m_Ranges     .resize(nWorkers);
+		m_WorkerTimes.resize(nWorkers, 0.0);
+
+		for (uint32_t i = 0; i < nWorkers; i++)
+		{
+			std::stringstream ss;
+			ss << "Record Worker " << i << "(ms)";
+
+			m_PlotNames.push_back(ss.str());
+		}
+	}
+
+	void RangeScheduler::Run(uint32_t count, const RangeFunc& func)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Ranges = Split(count, GetWorkerCount());
+
+		Dispatch(func);
+	}
+
+	void RangeScheduler::Run(const std::vector<uint32_t>& costs, const RangeFunc& func)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Ranges = Split(costs, GetWorkerCount());
+
+		Dispatch(func);
+	}
+
+	std::vector<RangeScheduler::Range> RangeScheduler::Split(uint32_t count, uint32_t nWorkers)
+	{
+		nWorkers = std::max(nWorkers, 1u);
+
+		std::vector<Range> ranges(nWorkers);
+
+		const uint32_t base      = count / nWorkers;
+		const uint32_t remainder = count % nWorkers;
+
+		uint32_t begin = 0;
+		for (uint32_t i = 0; i < nWorkers; i++)
+		{
+			const uint32_t size = base + (i < remainder ? 1 : 0);
+
+			ranges[i] = { begin, begin + size };
+			begin += size;
+		}
+
+		return ranges;
+	}
+
+	std::vector<RangeScheduler::Range> RangeScheduler::Split(const std::vector<uint32_t>& costs, uint32_t nWorkers)
+	{
+		nWorkers = std::max(nWorkers, 1u);
+
+		const uint32_t count = static_cast<uint32_t>(costs.size());
+
+		uint64_t total = 0;
+		for (const uint32_t cost : costs)
+		{
+			total += cost;
+		}
+
+		if (total == 0)
+		{
+			return Split(count, nWorkers);
+		}
+
+		std::vector<Range> ranges(nWorkers);
+
+		/**
+		* @brief Each range ends where accumulated cost is closest to its share of total cost.
+		*/
+		uint32_t end         = 0;
+		uint64_t accumulated = 0;
+		for (uint32_t i = 0; i < nWorkers; i++)
+		{
+			const uint32_t begin = end;
+
+			if (i == nWorkers - 1)
+			{
+				end = count;
+			}
+			else
+			{
+				const uint64_t goal = total * (i + 1) / nWorkers;
+
+				while (end < count && accumulated + costs[end] <= goal)
+				{
+					accumulated += costs[end++];
+				}
+
+				if (end < count && accumulated < goal && goal - accumulated > accumulated + costs[end] - goal)
+				{
+					accumulated += costs[end++];
+				}
+
+				/**
+				* @brief Never leave a worker idle while items remain, so empty ranges are only at tail.
+				*/
+				if (end == begin && end < count)
+				{
+					accumulated += costs[end++];
+				}
+			}
+
+			ranges[i] = { begin, end };
+		}
+
+		return ranges;
+	}
+
+	double RangeScheduler::GetImbalance() const
+	{
+		double sum = 0.0;
+		double max = 0.0;
+
+		for (const double time : m_WorkerTimes)
+		{
+			sum += time;
+			max  = std::max(max, time);
+		}
+
+		return sum > 0.0 ? max * m_WorkerTimes.size() / sum : 1.0;
+	}
+
+	void RangeScheduler::Dispatch(const RangeFunc& func)
+	{
+		SPICES_PROFILE_ZONE;
+
+		uint32_t nRanges = 0;
+		for (const auto& range : m_Ranges)
+		{
+			if (range.begin < range.end) nRanges++;
+		}
+
+		std::fill(m_WorkerTimes.begin(), m_WorkerTimes.end(), 0.0);
+
+		if (nRanges == 0) return;
+
+		m_Done.Reset(nRanges);
+
+		for (uint32_t i = 0; i < nRanges; i++)
+		{
+			m_Submit(i, [this, &func, i]() {
+
+				SPICES_PROFILE_ZONEN("RangeScheduler::Worker");
+
+				const auto begin = std::chrono::steady_clock::now();
+
+				func(i, m_Ranges[i].begin, m_Ranges[i].end);
+
+				m_WorkerTimes[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+				m_Done.CountDown();
+			});
+		}
+
+		/**
+		* @brief The only join of this Run.
+		*/
+		m_Done.Wait();
+
+		for (uint32_t i = 0; i < GetWorkerCount(); i++)
+		{
+			SPICES_PROFILE_PLOT(m_PlotNames[i].c_str(), m_WorkerTimes[i]);
+		}
+	}
+}
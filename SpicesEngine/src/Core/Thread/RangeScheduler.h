@@ -0,0 +1,159 @@
+/**
+* @file RangeScheduler.h
+* @brief The RangeScheduler Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "Latch.h"
+
+namespace Spices {
+
+	/**
+	* @brief Contiguous ranges of a list executed on a thread pool's own threads.
+	* A list is split into one balanced contiguous range per worker, each range is handed once
+	* to its worker's thread by a submit function, and the caller joins once on a latch.
+	* Owns no thread, used for parallel command recording, worker index selects the worker's command buffer.
+	*/
+	class RangeScheduler
+	{
+	public:
+
+		/**
+		* @brief A contiguous range of items, [begin, end).
+		*/
+		struct Range
+		{
+			uint32_t begin = 0;     /* @brief First item.      */
+			uint32_t end   = 0;     /* @brief One past last.   */
+
+			bool operator==(const Range& other) const { return begin == other.begin && end == other.end; }
+		};
+
+		/**
+		* @brief Range function, called by a worker with its range, never called with an empty range.
+		*/
+		using RangeFunc = std::function<void(uint32_t worker, uint32_t begin, uint32_t end)>;
+
+		/**
+		* @brief Submit function, runs a task on the thread of a worker, e.g. ThreadPool_Basic::SubmitThreadTask_LightWeight.
+		*/
+		using SubmitFunc = std::function<void(uint32_t worker, std::function<void()> task)>;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] nWorkers Workers count.
+		* @param[in] submit Submit function, must run tasks of a worker on the same thread.
+		*/
+		RangeScheduler(uint32_t nWorkers, SubmitFunc submit);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~RangeScheduler() = default;
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		RangeScheduler(const RangeScheduler&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		RangeScheduler& operator=(const RangeScheduler&) = delete;
+
+		/**
+		* @brief Run items split evenly by count, blocks until all workers finished.
+		* @param[in] count Items count.
+		* @param[in] func Range function.
+		*/
+		void Run(uint32_t count, const RangeFunc& func);
+
+		/**
+		* @brief Run items split evenly by cost, blocks until all workers finished.
+		* @param[in] costs Cost of each item, e.g. meshlets count.
+		* @param[in] func Range function.
+		*/
+		void Run(const std::vector<uint32_t>& costs, const RangeFunc& func);
+
+		/**
+		* @brief Split items into balanced contiguous ranges by count.
+		* @param[in] count Items count.
+		* @param[in] nWorkers Workers count.
+		* @return Returns one range per worker, empty ranges are at the tail.
+		*/
+		static std::vector<Range> Split(uint32_t count, uint32_t nWorkers);
+
+		/**
+		* @brief Split items into balanced contiguous ranges by cost.
+		* @param[in] costs Cost of each item.
+		* @param[in] nWorkers Workers count.
+		* @return Returns one range per worker, empty ranges are at the tail.
+		*/
+		static std::vector<Range> Split(const std::vector<uint32_t>& costs, uint32_t nWorkers);
+
+		/**
+		* @brief Get workers count.
+		* @return Returns workers count.
+		*/
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_Ranges.size()); }
+
+		/**
+		* @brief Get ranges of last Run.
+		* @return Returns one range per worker.
+		*/
+		const std::vector<Range>& GetRanges() const { return m_Ranges; }
+
+		/**
+		* @brief Get time each worker spent in its range during last Run.
+		* @return Returns milliseconds per worker.
+		*/
+		const std::vector<double>& GetWorkerTimes() const { return m_WorkerTimes; }
+
+		/**
+		* @brief Get imbalance of last Run.
+		* @return Returns slowest worker time over mean worker time, 1 if balanced.
+		*/
+		double GetImbalance() const;
+
+	private:
+
+		/**
+		* @brief Submit non-empty ranges of m_Ranges and join on latch.
+		* @param[in] func Range function.
+		*/
+		void Dispatch(const RangeFunc& func);
+
+	private:
+
+		/**
+		* @brief Submit function.
+		*/
+		SubmitFunc m_Submit;
+
+		/**
+		* @brief Ranges of current Run, one per worker.
+		*/
+		std::vector<Range> m_Ranges;
+
+		/**
+		* @brief Milliseconds per worker of last Run.
+		*/
+		std::vector<double> m_WorkerTimes;
+
+		/**
+		* @brief Profiler plot name per worker.
+		*/
+		std::vector<std::string> m_PlotNames;
+
+		/**
+		* @brief Counted down once per non-empty range.
+		*/
+		Latch m_Done;
+	};
+}
@@ -6,6 +6,7 @@
 
 #include "Pchheader.h"
 #include "ThreadPool.h"
+#include "Latch.h"
 
 namespace Spices {
 
@@ -18,6 +19,44 @@ namespace Spices {
 		m_ThreadPool = nullptr;
 	}
 
+	void ThreadPool::ParallelFor(ThreadPool* threadPool, uint32_t count, const std::function<void(uint32_t)>& func)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (count == 0) return;
+
+		struct State
+		{
+			std::atomic<uint32_t>           next = 0;
+			Latch                           done;
+			std::function<void(uint32_t)>   func;
+		};
+
+		auto state = std::make_shared<State>();
+		state->done.Reset(count);
+		state->func = func;
+
+		const auto run = [state, count]() {
+			for (uint32_t i = state->next++; i < count; i = state->next++)
+			{
+				state->func(i);
+				state->done.CountDown();
+			}
+		};
+
+		if (threadPool && threadPool->IsPoolRunning())
+		{
+			const uint32_t nHelpers = std::min<uint32_t>(count - 1, static_cast<uint32_t>(threadPool->GetThreadsCount()));
+			for (uint32_t i = 0; i < nHelpers; i++)
+			{
+				threadPool->SubmitPoolTask(run);
+			}
+		}
+
+		run();
+		state->done.Wait();
+	}
+
 	void ThreadPool::Start(int initThreadSize)
 	{
 		SPICES_PROFILE_ZONE;
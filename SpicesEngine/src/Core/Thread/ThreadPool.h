@@ -29,6 +29,16 @@ namespace Spices {
 		*/
 		static std::shared_ptr<ThreadPool>& Get() { return m_ThreadPool; }
 
+		/**
+		* @brief Run func(0) ... func(count - 1), on pool threads and the calling thread.
+		* Returns when all are done, pool threads that start late find nothing to do,
+		* so it does not deadlock when called from a pool thread.
+		* @param[in] threadPool ThreadPool, may be nullptr.
+		* @param[in] count Count of items.
+		* @param[in] func Item function.
+		*/
+		static void ParallelFor(ThreadPool* threadPool, uint32_t count, const std::function<void(uint32_t)>& func);
+
 		/******************************************Must Implementation************************************************/
 
 		/**
@@ -9,6 +9,7 @@
 
 #include <future>
 #include <queue>
+#include <functional>
 
 namespace Spices {
 
@@ -412,7 +413,9 @@ namespace Spices {
 	template<typename ...Params>
 	inline ThreadPool_Basic<Params...>::ThreadPool_Basic()
 		: m_InitThreadSize(0)
+		, m_NThreads(0)
 		, m_IdleThreadSize(0)
+		, m_Tasks(0)
 		, m_PoolMode(PoolMode::MODE_FIXED)
 		, m_IsPoolRunning(false)
 		, m_ThreadIdleTimeOut(THREAD_MAX_IDLE_TIME)
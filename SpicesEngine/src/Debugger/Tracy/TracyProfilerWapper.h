@@ -84,6 +84,7 @@ namespace Spices {
 #define SPICES_PROFILE_FREE(ptr)                                         TracySecureFreeS(ptr, 20)
 #define SPICES_PROFILE_MARK(...)                                         TracyMessageL(__VA_ARGS__)
 #define SPICES_PROFILE_IMAGE(...)                                        FrameImage(__VA_ARGS__)
+#define SPICES_PROFILE_PLOT(name, value)                                 TracyPlot(name, value)
 
 #define SPICES_PROFILE_VK_CONTEXHOSTCALIBRATED(pd, d, qr, ctd, ct)       TracyVkContextHostCalibrated(pd, d, qr, ctd, ct)
 #define SPICES_PROFILE_VK_DESTROY                                        TracyVkDestroy(TracyGPUContext::Get().GetContext())                   
@@ -101,6 +102,7 @@ namespace Spices {
 #define SPICES_PROFILE_FREE(ptr)                                   
 #define SPICES_PROFILE_MARK(...)                                   
 #define SPICES_PROFILE_IMAGE(...)                                  
+#define SPICES_PROFILE_PLOT(name, value)                           
 
 #define SPICES_PROFILE_VK_CONTEXHOSTCALIBRATED(pd, d, qr, ctd, ct) 
 #define SPICES_PROFILE_VK_DESTROY                                  
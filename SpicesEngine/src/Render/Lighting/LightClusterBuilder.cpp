@@ -0,0 +1,324 @@
+/**
+* @file LightClusterBuilder.cpp.
+* @brief The LightClusterBuilder Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "LightClusterBuilder.h"
+#include "Core/Thread/ThreadPool.h"
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Number of clusters.
+		*/
+		constexpr uint32_t ClusterCount = LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z;
+
+		/**
+		* @brief Get screen tile of a ndc coordinate.
+		* @param[in] ndc Ndc coordinate.
+		* @param[in] n Tiles count.
+		* @return Returns tile.
+		*/
+		uint32_t NdcToTile(float ndc, uint32_t n)
+		{
+			const float t = (std::clamp(ndc, -1.0f, 1.0f) * 0.5f + 0.5f) * static_cast<float>(n);
+			return std::min(static_cast<uint32_t>(t), n - 1);
+		}
+	}
+
+	LightClusterBuilder::LightClusterBuilder(float cutoff)
+		: m_Cutoff(cutoff)
+		, m_SliceDepth(LIGHT_CLUSTER_Z + 1)
+		, m_Bounds(ClusterCount)
+		, m_SliceLights(LIGHT_CLUSTER_Z)
+		, m_Bins(ClusterCount)
+		, m_Clusters(ClusterCount)
+	{}
+
+	LightClusterBuilder::View LightClusterBuilder::MakeView(const glm::mat4& view, const glm::mat4& projection, float farPlane)
+	{
+		SPICES_PROFILE_ZONE;
+
+		View v;
+		v.view      = view;
+		v.xScale    = projection[0][0];
+		v.yScale    = projection[1][1];
+		v.nearPlane = projection[3][2];
+		v.farPlane  = std::max(farPlane, v.nearPlane * 2.0f);
+
+		return v;
+	}
+
+	float LightClusterBuilder::GetLightRange(const SpicesShader::PointLight& light, float cutoff)
+	{
+		const float peak = light.intensity * std::max({ light.color.x, light.color.y, light.color.z });
+		if (peak <= 0.0f) return 0.0f;
+		if (cutoff <= 0.0f) return std::numeric_limits<float>::infinity();
+
+		/**
+		* @brief Solve peak / (constantf + linear * d + quadratic * d * d) = cutoff.
+		*/
+		const float c = light.constantf - peak / cutoff;
+		if (c >= 0.0f) return 0.0f;
+
+		if (light.quadratic > 0.0f)
+		{
+			return (-light.linear + std::sqrt(light.linear * light.linear - 4.0f * light.quadratic * c)) / (2.0f * light.quadratic);
+		}
+
+		if (light.linear > 0.0f)
+		{
+			return -c / light.linear;
+		}
+
+		return std::numeric_limits<float>::infinity();
+	}
+
+	uint32_t LightClusterBuilder::GetCluster(const SpicesShader::LightClusterInfo& info, const View& view, const glm::vec3& position)
+	{
+		const float z = std::max(position.z, 1.0e-4f);
+
+		const uint32_t x = NdcToTile(position.x * view.xScale / z, LIGHT_CLUSTER_X);
+		const uint32_t y = NdcToTile(position.y * view.yScale / z, LIGHT_CLUSTER_Y);
+
+		const float    s = std::floor(std::log(z) * info.sliceScale - info.sliceBias);
+		const uint32_t k = static_cast<uint32_t>(std::clamp(s, 0.0f, static_cast<float>(LIGHT_CLUSTER_Z - 1)));
+
+		return GetClusterIndex(x, y, k);
+	}
+
+	void LightClusterBuilder::Build(
+		const View&                      view       ,
+		const SpicesShader::PointLight*  lights     ,
+		uint32_t                         count      ,
+		ThreadPool*                      threadPool
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		UpdateGrid(view);
+
+		/**
+		* @brief Light spheres in view space, bucketed by depth slices they overlap.
+		*/
+		m_Spheres.clear();
+		for (auto& slice : m_SliceLights)
+		{
+			slice.clear();
+		}
+
+		const float maxExtent = view.farPlane * std::sqrt(1.0f + 1.0f / (view.xScale * view.xScale) + 1.0f / (view.yScale * view.yScale));
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const SpicesShader::PointLight& light = lights[i];
+
+			float radius = GetLightRange(light, m_Cutoff);
+			if (radius <= 0.0f) continue;
+
+			const glm::vec3 center = glm::vec3(view.view * glm::vec4(light.position, 1.0f));
+
+			/**
+			* @brief Never fading light reaches every cluster.
+			*/
+			if (!std::isfinite(radius))
+			{
+				radius = glm::length(center) + maxExtent;
+			}
+
+			if (center.z + radius < view.nearPlane || center.z - radius > view.farPlane) continue;
+
+			const auto first = std::upper_bound(m_SliceDepth.begin(), m_SliceDepth.end(), center.z - radius);
+			const auto last  = std::upper_bound(m_SliceDepth.begin(), m_SliceDepth.end(), center.z + radius);
+
+			const uint32_t k0 = static_cast<uint32_t>(std::max<ptrdiff_t>(first - m_SliceDepth.begin() - 1, 0));
+			const uint32_t k1 = static_cast<uint32_t>(std::min<ptrdiff_t>(last  - m_SliceDepth.begin() - 1, LIGHT_CLUSTER_Z - 1));
+
+			const uint32_t sphere = static_cast<uint32_t>(m_Spheres.size());
+			m_Spheres.push_back({ center, radius, i });
+
+			for (uint32_t k = k0; k <= k1; k++)
+			{
+				m_SliceLights[k].push_back(sphere);
+			}
+		}
+
+		/**
+		* @brief Bin depth slices, each slice only writes its own clusters.
+		*/
+		if (threadPool && threadPool->GetThreadsCount() > 0)
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(LIGHT_CLUSTER_Z);
+
+			for (uint32_t k = 0; k < LIGHT_CLUSTER_Z; k++)
+			{
+				futures.push_back(threadPool->SubmitPoolTask([this, k]() { BinSlice(k); }));
+			}
+
+			for (auto& future : futures)
+			{
+				future.wait();
+			}
+		}
+		else
+		{
+			for (uint32_t k = 0; k < LIGHT_CLUSTER_Z; k++)
+			{
+				BinSlice(k);
+			}
+		}
+
+		/**
+		* @brief Compact bins into one index list.
+		*/
+		m_Indices.clear();
+
+		bool overflow = false;
+		for (uint32_t c = 0; c < ClusterCount; c++)
+		{
+			const auto& bin = m_Bins[c];
+
+			const uint32_t offset = static_cast<uint32_t>(m_Indices.size());
+			const uint32_t n      = std::min(static_cast<uint32_t>(bin.size()), LIGHT_CLUSTER_INDEX_MAXNUM - offset);
+
+			overflow |= n < bin.size();
+
+			m_Clusters[c] = { offset, n };
+			m_Indices.insert(m_Indices.end(), bin.begin(), bin.begin() + n);
+		}
+
+		if (overflow)
+		{
+			SPICES_CORE_WARN("LightClusterBuilder::Build: light indices out of LIGHT_CLUSTER_INDEX_MAXNUM, lights are dropped.");
+		}
+
+		m_Info.lightCount = static_cast<uint32_t>(m_Spheres.size());
+		m_Info.indexCount = static_cast<uint32_t>(m_Indices.size());
+	}
+
+	void LightClusterBuilder::UpdateGrid(const View& view)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (m_GridValid                       &&
+			m_View.xScale    == view.xScale    &&
+			m_View.yScale    == view.yScale    &&
+			m_View.nearPlane == view.nearPlane &&
+			m_View.farPlane  == view.farPlane)
+		{
+			m_View.view = view.view;
+			return;
+		}
+
+		m_View      = view;
+		m_GridValid = true;
+
+		/**
+		* @brief Exponential slices: z(k) = near * (far / near) ^ (k / LIGHT_CLUSTER_Z).
+		*/
+		const float logRatio = std::log(view.farPlane / view.nearPlane);
+
+		m_Info.sliceScale = LIGHT_CLUSTER_Z / logRatio;
+		m_Info.sliceBias  = LIGHT_CLUSTER_Z * std::log(view.nearPlane) / logRatio;
+
+		for (uint32_t k = 0; k <= LIGHT_CLUSTER_Z; k++)
+		{
+			m_SliceDepth[k] = view.nearPlane * std::exp(logRatio * k / LIGHT_CLUSTER_Z);
+		}
+
+		for (uint32_t k = 0; k < LIGHT_CLUSTER_Z; k++)
+		{
+			const float zn = m_SliceDepth[k];
+			const float zf = m_SliceDepth[k + 1];
+
+			for (uint32_t y = 0; y < LIGHT_CLUSTER_Y; y++)
+			{
+				const float y0 = -1.0f + 2.0f *  y      / LIGHT_CLUSTER_Y;
+				const float y1 = -1.0f + 2.0f * (y + 1) / LIGHT_CLUSTER_Y;
+
+				for (uint32_t x = 0; x < LIGHT_CLUSTER_X; x++)
+				{
+					const float x0 = -1.0f + 2.0f *  x      / LIGHT_CLUSTER_X;
+					const float x1 = -1.0f + 2.0f * (x + 1) / LIGHT_CLUSTER_X;
+
+					SpicesShader::AABB& bound = m_Bounds[GetClusterIndex(x, y, k)];
+
+					bound.min.x = std::min({ x0 * zn, x0 * zf, x1 * zn, x1 * zf }) / view.xScale;
+					bound.max.x = std::max({ x0 * zn, x0 * zf, x1 * zn, x1 * zf }) / view.xScale;
+					bound.min.y = std::min({ y0 * zn, y0 * zf, y1 * zn, y1 * zf }) / view.yScale;
+					bound.max.y = std::max({ y0 * zn, y0 * zf, y1 * zn, y1 * zf }) / view.yScale;
+					bound.min.z = zn;
+					bound.max.z = zf;
+				}
+			}
+		}
+	}
+
+	void LightClusterBuilder::BinSlice(uint32_t slice)
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (uint32_t i = 0; i < LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y; i++)
+		{
+			m_Bins[slice * LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y + i].clear();
+		}
+
+		const float zn = m_SliceDepth[slice];
+		const float zf = m_SliceDepth[slice + 1];
+
+		for (const auto s : m_SliceLights[slice])
+		{
+			const LightSphere& sphere = m_Spheres[s];
+
+			/**
+			* @brief Screen tiles covered by the sphere's box within this slice.
+			*/
+			const float zlo = std::max(sphere.center.z - sphere.radius, zn);
+			const float zhi = std::min(sphere.center.z + sphere.radius, zf);
+
+			const float ax = (sphere.center.x - sphere.radius) * m_View.xScale;
+			const float bx = (sphere.center.x + sphere.radius) * m_View.xScale;
+			const float ay = (sphere.center.y - sphere.radius) * m_View.yScale;
+			const float by = (sphere.center.y + sphere.radius) * m_View.yScale;
+
+			const float minX = std::min(ax / zlo, ax / zhi);
+			const float maxX = std::max(bx / zlo, bx / zhi);
+			const float minY = std::min(ay / zlo, ay / zhi);
+			const float maxY = std::max(by / zlo, by / zhi);
+
+			if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f) continue;
+
+			const uint32_t tx0 = NdcToTile(minX, LIGHT_CLUSTER_X);
+			const uint32_t tx1 = NdcToTile(maxX, LIGHT_CLUSTER_X);
+			const uint32_t ty0 = NdcToTile(minY, LIGHT_CLUSTER_Y);
+			const uint32_t ty1 = NdcToTile(maxY, LIGHT_CLUSTER_Y);
+
+			const float r2 = sphere.radius * sphere.radius;
+
+			for (uint32_t y = ty0; y <= ty1; y++)
+			{
+				for (uint32_t x = tx0; x <= tx1; x++)
+				{
+					const uint32_t index = GetClusterIndex(x, y, slice);
+					const SpicesShader::AABB& bound = m_Bounds[index];
+
+					/**
+					* @brief Sphere - AABB test.
+					*/
+					const glm::vec3 closest = glm::clamp(sphere.center, bound.min, bound.max);
+					const glm::vec3 d = sphere.center - closest;
+
+					if (glm::dot(d, d) <= r2)
+					{
+						m_Bins[index].push_back(sphere.index);
+					}
+				}
+			}
+		}
+	}
+}
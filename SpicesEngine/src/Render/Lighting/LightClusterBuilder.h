@@ -0,0 +1,214 @@
+/**
+* @file LightClusterBuilder.h.
+* @brief The LightClusterBuilder Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "../../../assets/Shaders/src/Header/ShaderCommon.h"
+
+namespace Spices {
+
+	/**
+	* @brief Forward declare.
+	*/
+	class ThreadPool;
+
+	/**
+	* @brief Clustered (froxel) PointLight binning on CPU.
+	* Splits the camera frustum into LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y screen tiles and LIGHT_CLUSTER_Z exponential depth slices,
+	* and assigns each PointLight to the clusters its range sphere intersects.
+	* Output is a LightCluster (offset, count) per cluster and a compact light index list, independent of Vulkan.
+	*/
+	class LightClusterBuilder
+	{
+	public:
+
+		/**
+		* @brief Camera data used for building cluster grid.
+		* View space looks along +z.
+		*/
+		struct View
+		{
+			glm::mat4 view      = glm::mat4(1.0f);   /* @brief World to view matrix.            */
+			float     xScale    = 1.0f;              /* @brief Projection [0][0].               */
+			float     yScale    = 1.0f;              /* @brief Projection [1][1].               */
+			float     nearPlane = 0.1f;              /* @brief Depth of the first slice.        */
+			float     farPlane  = 1000.0f;           /* @brief Depth of the end of last slice.  */
+		};
+
+		/**
+		* @brief Lights contribution below cutoff is treated as zero.
+		*/
+		static constexpr float DefaultCutoff = 0.01f;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] cutoff Lights contribution below cutoff is treated as zero.
+		*/
+		LightClusterBuilder(float cutoff = DefaultCutoff);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~LightClusterBuilder() = default;
+
+		/**
+		* @brief Make a View from engine camera matrices.
+		* @param[in] view World to view matrix.
+		* @param[in] projection Reverse z infinite projection, @see PerspectiveMatrixInverseZ.
+		* @param[in] farPlane Depth of the end of last slice, projection has no far plane.
+		* @return Returns View.
+		*/
+		static View MakeView(const glm::mat4& view, const glm::mat4& projection, float farPlane);
+
+		/**
+		* @brief Get the range of a PointLight.
+		* @param[in] light PointLight.
+		* @param[in] cutoff Lights contribution below cutoff is treated as zero.
+		* @return Returns distance where the light contribution reaches cutoff, infinity if never.
+		*/
+		static float GetLightRange(const SpicesShader::PointLight& light, float cutoff);
+
+		/**
+		* @brief Get cluster of a view space position, the same way shader does.
+		* @param[in] info Grid data.
+		* @param[in] view Camera data.
+		* @param[in] position View space position.
+		* @return Returns cluster index.
+		*/
+		static uint32_t GetCluster(const SpicesShader::LightClusterInfo& info, const View& view, const glm::vec3& position);
+
+		/**
+		* @brief Get cluster index.
+		* @param[in] x Tile x.
+		* @param[in] y Tile y.
+		* @param[in] z Depth slice.
+		* @return Returns cluster index.
+		*/
+		static uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) { return (z * LIGHT_CLUSTER_Y + y) * LIGHT_CLUSTER_X + x; }
+
+		/**
+		* @brief Bin lights to clusters.
+		* @param[in] view Camera data.
+		* @param[in] lights PointLights.
+		* @param[in] count Number of PointLights.
+		* @param[in] threadPool Bin depth slices parallel in it, serial if nullptr.
+		*/
+		void Build(
+			const View&                      view             ,
+			const SpicesShader::PointLight*  lights           ,
+			uint32_t                         count            ,
+			ThreadPool*                      threadPool = nullptr
+		);
+
+		/**
+		* @brief Get grid data.
+		* @return Returns grid data.
+		*/
+		const SpicesShader::LightClusterInfo& GetInfo() const { return m_Info; }
+
+		/**
+		* @brief Get clusters.
+		* @return Returns clusters, @see GetClusterIndex.
+		*/
+		const std::vector<SpicesShader::LightCluster>& GetClusters() const { return m_Clusters; }
+
+		/**
+		* @brief Get light indices.
+		* @return Returns compact light indices of all clusters.
+		*/
+		const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+
+		/**
+		* @brief Get view space bound of a cluster.
+		* @param[in] index Cluster index.
+		* @return Returns view space AABB.
+		*/
+		const SpicesShader::AABB& GetClusterBound(uint32_t index) const { return m_Bounds[index]; }
+
+	private:
+
+		/**
+		* @brief Rebuild cluster bounds if projection changed.
+		* @param[in] view Camera data.
+		*/
+		void UpdateGrid(const View& view);
+
+		/**
+		* @brief Bin lights of a depth slice.
+		* @param[in] slice Depth slice.
+		*/
+		void BinSlice(uint32_t slice);
+
+	private:
+
+		/**
+		* @brief Light range sphere in view space.
+		*/
+		struct LightSphere
+		{
+			glm::vec3 center;      /* @brief View space center. */
+			float     radius;      /* @brief Range.             */
+			uint32_t  index;       /* @brief PointLight index.  */
+		};
+
+		/**
+		* @brief Lights contribution below cutoff is treated as zero.
+		*/
+		float m_Cutoff;
+
+		/**
+		* @brief Camera data of last build.
+		*/
+		View m_View;
+
+		/**
+		* @brief Whether m_Bounds is built.
+		*/
+		bool m_GridValid = false;
+
+		/**
+		* @brief Grid data.
+		*/
+		SpicesShader::LightClusterInfo m_Info{};
+
+		/**
+		* @brief Depth of slices boundary, LIGHT_CLUSTER_Z + 1.
+		*/
+		std::vector<float> m_SliceDepth;
+
+		/**
+		* @brief View space bound per cluster.
+		*/
+		std::vector<SpicesShader::AABB> m_Bounds;
+
+		/**
+		* @brief Light spheres this build.
+		*/
+		std::vector<LightSphere> m_Spheres;
+
+		/**
+		* @brief Light spheres per depth slice.
+		*/
+		std::vector<std::vector<uint32_t>> m_SliceLights;
+
+		/**
+		* @brief Light indices per cluster, reused across builds.
+		*/
+		std::vector<std::vector<uint32_t>> m_Bins;
+
+		/**
+		* @brief Clusters.
+		*/
+		std::vector<SpicesShader::LightCluster> m_Clusters;
+
+		/**
+		* @brief Compact light indices.
+		*/
+		std::vector<uint32_t> m_Indices;
+	};
+}
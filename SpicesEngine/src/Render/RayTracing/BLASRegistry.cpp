@@ -0,0 +1,172 @@
+/**
+* @file BLASRegistry.cpp.
+* @brief The BLASRegistry Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "BLASRegistry.h"
+
+namespace Spices {
+
+	BLASRegistry::BLASRegistry(std::shared_ptr<BLASBuildBackend> backend, uint32_t freeLatency)
+		: m_Backend(backend)
+		, m_FreeLatency(freeLatency)
+	{}
+
+	BLASRegistry::~BLASRegistry()
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (const auto& [key, entry] : m_Entries)
+		{
+			m_Backend->Free(key);
+		}
+	}
+
+	bool BLASRegistry::Acquire(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Entry& entry = m_Entries[key];
+		if (entry.refCount++ > 0) return false;
+
+		switch (entry.state)
+		{
+			case State::Pending:
+			{
+				m_Pending.push_back(key);
+				return true;
+			}
+			case State::Retired:
+			{
+				/**
+				* @brief Still alive, revive it.
+				*/
+				m_Retired.erase(std::find(m_Retired.begin(), m_Retired.end(), key));
+				entry.state = State::Built;
+				m_BuiltCount++;
+				m_Generation++;
+				return false;
+			}
+			default:
+				return false;
+		}
+	}
+
+	void BLASRegistry::Release(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Entries.find(key);
+		if (it == m_Entries.end() || it->second.refCount == 0)
+		{
+			SPICES_CORE_WARN("BLASRegistry::Release: key is not acquired.");
+			return;
+		}
+
+		Entry& entry = it->second;
+		if (--entry.refCount > 0) return;
+
+		switch (entry.state)
+		{
+			case State::Pending:
+			{
+				m_Pending.erase(std::find(m_Pending.begin(), m_Pending.end(), key));
+				m_Entries.erase(it);
+				m_Backend->Free(key);
+				break;
+			}
+			case State::Built:
+			{
+				entry.state       = State::Retired;
+				entry.retireFrame = m_Frame;
+				m_Retired.push_back(key);
+				m_BuiltCount--;
+				m_Generation++;
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	uint32_t BLASRegistry::Tick(VkDeviceSize budget)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Frame++;
+
+		/**
+		* @brief Free BLAS no longer referenced by any frame in flight.
+		*/
+		while (!m_Retired.empty())
+		{
+			const uint64_t key = m_Retired.front();
+			if (m_Frame - m_Entries[key].retireFrame < m_FreeLatency) break;
+
+			m_Backend->Free(key);
+			m_Entries.erase(key);
+			m_Retired.pop_front();
+		}
+
+		/**
+		* @brief Collect a batch within budget.
+		*/
+		std::vector<uint64_t> batch;
+		VkDeviceSize batchSize = 0;
+		while (!m_Pending.empty())
+		{
+			const uint64_t key = m_Pending.front();
+			const VkDeviceSize size = m_Backend->GetBuildSize(key);
+
+			if (!batch.empty() && batchSize + size > budget) break;
+
+			batch.push_back(key);
+			batchSize += size;
+			m_Pending.pop_front();
+		}
+
+		if (batch.empty()) return 0;
+
+		m_Backend->Build(batch);
+
+		for (const auto key : batch)
+		{
+			Entry& entry  = m_Entries[key];
+			entry.state   = State::Built;
+			entry.address = m_Backend->GetAddress(key);
+		}
+
+		m_BuiltCount += static_cast<uint32_t>(batch.size());
+		m_Generation++;
+
+		return static_cast<uint32_t>(batch.size());
+	}
+
+	bool BLASRegistry::IsReady(uint64_t key) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Entries.find(key);
+		return it != m_Entries.end() && it->second.state == State::Built;
+	}
+
+	VkDeviceAddress BLASRegistry::GetAddress(uint64_t key) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Entries.find(key);
+		if (it == m_Entries.end() || it->second.state != State::Built) return 0;
+
+		return it->second.address;
+	}
+
+	uint32_t BLASRegistry::GetRefCount(uint64_t key) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Entries.find(key);
+		return it == m_Entries.end() ? 0 : it->second.refCount;
+	}
+}
@@ -0,0 +1,220 @@
+/**
+* @file BLASRegistry.h.
+* @brief The BLASRegistry Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+namespace Spices {
+
+	/**
+	* @brief Device side of BLASRegistry.
+	* Builds, compacts and frees BLAS by key, implemented by VulkanBLASBackend and by mocks in tests.
+	*/
+	class BLASBuildBackend
+	{
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		BLASBuildBackend() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~BLASBuildBackend() = default;
+
+		/**
+		* @brief Get the size a BLAS occupies while building, used for the build budget.
+		* @param[in] key MeshPack resource key.
+		* @return Returns bytes.
+		*/
+		virtual VkDeviceSize GetBuildSize(uint64_t key) = 0;
+
+		/**
+		* @brief Build (and compact) a batch of BLAS.
+		* @param[in] keys MeshPack resource keys.
+		*/
+		virtual void Build(const std::vector<uint64_t>& keys) = 0;
+
+		/**
+		* @brief Get device address of a built BLAS.
+		* @param[in] key MeshPack resource key.
+		* @return Returns device address.
+		*/
+		virtual VkDeviceAddress GetAddress(uint64_t key) = 0;
+
+		/**
+		* @brief Free a BLAS and the data registered for it.
+		* Also called for entries released before they were built.
+		* @param[in] key MeshPack resource key.
+		*/
+		virtual void Free(uint64_t key) = 0;
+	};
+
+	/**
+	* @brief Reference counted BLAS keyed by MeshPack resource key.
+	* MeshPacks sharing a resource (instanced from ResourcePool) share one BLAS.
+	* New entries are built in budgeted batches across frames,
+	* entries released by all users are freed after the frames in flight retired.
+	*/
+	class BLASRegistry
+	{
+	public:
+
+		/**
+		* @brief Entry state.
+		*/
+		enum class State
+		{
+			Pending = 0,   /* @brief Waiting to be built.                            */
+			Built   = 1,   /* @brief Built and in use.                               */
+			Retired = 2,   /* @brief No users, freed once frames in flight finished. */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] backend The device backend.
+		* @param[in] freeLatency Ticks a retired BLAS is kept alive.
+		*/
+		BLASRegistry(std::shared_ptr<BLASBuildBackend> backend, uint32_t freeLatency = 2);
+
+		/**
+		* @brief Destructor Function.
+		* Frees all entries.
+		*/
+		virtual ~BLASRegistry();
+
+		/**
+		* @brief Add a user of a BLAS, schedule a build for a new key.
+		* A retired key is revived without rebuilding.
+		* @param[in] key MeshPack resource key.
+		* @return Returns true if a build was scheduled.
+		*/
+		bool Acquire(uint64_t key);
+
+		/**
+		* @brief Remove a user of a BLAS.
+		* @param[in] key MeshPack resource key.
+		*/
+		void Release(uint64_t key);
+
+		/**
+		* @brief Free retired BLAS and build pending ones within budget.
+		* At least one pending BLAS is built per tick, so an entry larger than budget still progresses.
+		* @param[in] budget Bytes of BLAS to build this tick.
+		* @return Returns number of BLAS built.
+		*/
+		uint32_t Tick(VkDeviceSize budget);
+
+		/**
+		* @brief Whether the key is registered (in any state).
+		* @param[in] key MeshPack resource key.
+		* @return Returns true if registered.
+		*/
+		bool Contains(uint64_t key) const { return m_Entries.find(key) != m_Entries.end(); }
+
+		/**
+		* @brief Whether the BLAS is built and in use.
+		* @param[in] key MeshPack resource key.
+		* @return Returns true if ready.
+		*/
+		bool IsReady(uint64_t key) const;
+
+		/**
+		* @brief Get device address of a BLAS.
+		* @param[in] key MeshPack resource key.
+		* @return Returns 0 if not ready, an inactive TLAS instance.
+		*/
+		VkDeviceAddress GetAddress(uint64_t key) const;
+
+		/**
+		* @brief Get users count of a BLAS.
+		* @param[in] key MeshPack resource key.
+		* @return Returns users count.
+		*/
+		uint32_t GetRefCount(uint64_t key) const;
+
+		/**
+		* @brief Get the number of BLAS waiting to be built.
+		* @return Returns pending count.
+		*/
+		uint32_t GetPendingCount() const { return static_cast<uint32_t>(m_Pending.size()); }
+
+		/**
+		* @brief Get the number of BLAS waiting to be freed.
+		* @return Returns retired count.
+		*/
+		uint32_t GetRetiredCount() const { return static_cast<uint32_t>(m_Retired.size()); }
+
+		/**
+		* @brief Get the number of built BLAS in use.
+		* @return Returns built count.
+		*/
+		uint32_t GetBuiltCount() const { return m_BuiltCount; }
+
+		/**
+		* @brief Get generation, increased whenever an address returned by GetAddress changes.
+		* @return Returns generation.
+		*/
+		uint64_t GetGeneration() const { return m_Generation; }
+
+	private:
+
+		/**
+		* @brief BLAS entry.
+		*/
+		struct Entry
+		{
+			uint32_t        refCount    = 0;                  /* @brief Users count.          */
+			State           state       = State::Pending;     /* @brief State.                */
+			VkDeviceAddress address     = 0;                  /* @brief BLAS device address.  */
+			uint64_t        retireFrame = 0;                  /* @brief Tick of retirement.   */
+		};
+
+		/**
+		* @brief The device backend.
+		*/
+		std::shared_ptr<BLASBuildBackend> m_Backend;
+
+		/**
+		* @brief Ticks a retired BLAS is kept alive.
+		*/
+		uint32_t m_FreeLatency;
+
+		/**
+		* @brief All entries.
+		*/
+		std::unordered_map<uint64_t, Entry> m_Entries;
+
+		/**
+		* @brief Pending keys, built in FIFO order.
+		*/
+		std::deque<uint64_t> m_Pending;
+
+		/**
+		* @brief Retired keys, in retirement order.
+		*/
+		std::deque<uint64_t> m_Retired;
+
+		/**
+		* @brief Built entries count.
+		*/
+		uint32_t m_BuiltCount = 0;
+
+		/**
+		* @brief Ticks count.
+		*/
+		uint64_t m_Frame = 0;
+
+		/**
+		* @brief Addresses generation.
+		*/
+		uint64_t m_Generation = 0;
+	};
+}
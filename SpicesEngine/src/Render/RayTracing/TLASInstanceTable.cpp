@@ -0,0 +1,200 @@
+/**
+* @file TLASInstanceTable.cpp.
+* @brief The TLASInstanceTable Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "TLASInstanceTable.h"
+
+namespace Spices {
+
+	TLASInstanceTable::TLASInstanceTable(float rebuildThreshold)
+		: m_RebuildThreshold(rebuildThreshold)
+	{}
+
+	uint32_t TLASInstanceTable::Acquire(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (const auto it = m_Slots.find(key); it != m_Slots.end())
+		{
+			m_Epoch[it->second] = m_CurrentEpoch;
+			return it->second;
+		}
+
+		uint32_t slot;
+		if (!m_FreeSlots.empty())
+		{
+			slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+		}
+		else
+		{
+			slot = static_cast<uint32_t>(m_Instances.size());
+			m_Instances.emplace_back();
+			m_Dirty.push_back(0);
+			m_Epoch.push_back(0);
+		}
+
+		m_Instances[slot] = VkAccelerationStructureInstanceKHR{};
+		m_Epoch[slot]     = m_CurrentEpoch;
+		m_Slots[key]      = slot;
+
+		MarkDirty(slot);
+		m_StructureChanged = true;
+
+		return slot;
+	}
+
+	void TLASInstanceTable::Release(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Slots.find(key);
+		if (it == m_Slots.end()) return;
+
+		const uint32_t slot = it->second;
+		m_Slots.erase(it);
+
+		/**
+		* @brief Keep the slot as an inactive instance, a null reference is skipped by the builder.
+		*/
+		m_Instances[slot] = VkAccelerationStructureInstanceKHR{};
+		m_FreeSlots.push_back(slot);
+
+		MarkDirty(slot);
+		m_StructureChanged = true;
+	}
+
+	void TLASInstanceTable::BeginSync()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_CurrentEpoch++;
+	}
+
+	void TLASInstanceTable::EndSync()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::vector<uint64_t> stale;
+		for (const auto& [key, slot] : m_Slots)
+		{
+			if (m_Epoch[slot] != m_CurrentEpoch)
+			{
+				stale.push_back(key);
+			}
+		}
+
+		for (const auto key : stale)
+		{
+			Release(key);
+		}
+	}
+
+	uint32_t TLASInstanceTable::GetSlot(uint64_t key) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Slots.find(key);
+		return it == m_Slots.end() ? UINT32_MAX : it->second;
+	}
+
+	void TLASInstanceTable::SetInstance(uint32_t slot, const VkAccelerationStructureInstanceKHR& instance)
+	{
+		SPICES_PROFILE_ZONE;
+
+		assert(slot < m_Instances.size());
+
+		VkAccelerationStructureInstanceKHR& dst = m_Instances[slot];
+
+		if (dst.accelerationStructureReference          != instance.accelerationStructureReference         ||
+			dst.instanceShaderBindingTableRecordOffset  != instance.instanceShaderBindingTableRecordOffset ||
+			dst.instanceCustomIndex                     != instance.instanceCustomIndex                    ||
+			dst.mask                                    != instance.mask                                   ||
+			dst.flags                                   != instance.flags)
+		{
+			m_StructureChanged = true;
+		}
+		else if (memcmp(&dst.transform, &instance.transform, sizeof(VkTransformMatrixKHR)) == 0)
+		{
+			return;
+		}
+
+		dst = instance;
+		MarkDirty(slot);
+	}
+
+	void TLASInstanceTable::SetTransform(uint32_t slot, const glm::mat4& model)
+	{
+		SPICES_PROFILE_ZONE;
+
+		assert(slot < m_Instances.size());
+
+		/**
+		* @brief VkTransformMatrixKHR is row major 3x4, glm is column major.
+		*/
+		const glm::mat4 temp = glm::transpose(model);
+		if (memcmp(&m_Instances[slot].transform, &temp, sizeof(VkTransformMatrixKHR)) == 0) return;
+
+		memcpy(&m_Instances[slot].transform, &temp, sizeof(VkTransformMatrixKHR));
+		MarkDirty(slot);
+	}
+
+	std::vector<TLASInstanceTable::DirtyRange> TLASInstanceTable::GetDirtyRanges() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::vector<DirtyRange> ranges;
+		if (m_DirtyCount == 0) return ranges;
+
+		const uint32_t count = static_cast<uint32_t>(m_Dirty.size());
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (!m_Dirty[i]) continue;
+
+			if (!ranges.empty() && ranges.back().first + ranges.back().count == i)
+			{
+				ranges.back().count++;
+			}
+			else
+			{
+				ranges.push_back({ i, 1 });
+			}
+		}
+
+		return ranges;
+	}
+
+	TLASInstanceTable::BuildMode TLASInstanceTable::GetBuildMode() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (m_StructureChanged) return BuildMode::Rebuild;
+		if (m_DirtyCount == 0)  return BuildMode::None;
+
+		/**
+		* @brief Refit keeps the old hierarchy, quality decays when many instances move.
+		*/
+		const float moved = static_cast<float>(m_DirtyCount) / static_cast<float>(std::max<size_t>(m_Slots.size(), 1));
+		return moved > m_RebuildThreshold ? BuildMode::Rebuild : BuildMode::Refit;
+	}
+
+	void TLASInstanceTable::ClearDirty()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::fill(m_Dirty.begin(), m_Dirty.end(), static_cast<uint8_t>(0));
+		m_DirtyCount = 0;
+		m_StructureChanged = false;
+	}
+
+	void TLASInstanceTable::MarkDirty(uint32_t slot)
+	{
+		if (m_Dirty[slot]) return;
+
+		m_Dirty[slot] = 1;
+		m_DirtyCount++;
+	}
+}
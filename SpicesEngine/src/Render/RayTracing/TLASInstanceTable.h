@@ -0,0 +1,204 @@
+/**
+* @file TLASInstanceTable.h.
+* @brief The TLASInstanceTable Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+namespace Spices {
+
+	/**
+	* @brief CPU side persistent array of TLAS instances.
+	* Every MeshPack instance owns a stable slot, so a transform change only touches its slot,
+	* and only dirty ranges of the array need to be uploaded.
+	* Freed slots stay in the array as inactive instances (zero reference) and are reused first.
+	* This class does not touch the device, it can be tested without one.
+	*/
+	class TLASInstanceTable
+	{
+	public:
+
+		/**
+		* @brief How the TLAS should be built from the current state.
+		*/
+		enum class BuildMode
+		{
+			None    = 0,   /* @brief Nothing changed.                                   */
+			Refit   = 1,   /* @brief Only transforms changed, update in place.          */
+			Rebuild = 2,   /* @brief Structure changed or too many instances moved.     */
+		};
+
+		/**
+		* @brief A contiguous range of dirty slots.
+		*/
+		struct DirtyRange
+		{
+			uint32_t first = 0;   /* @brief First slot. */
+			uint32_t count = 0;   /* @brief Slot count. */
+
+			bool operator==(const DirtyRange& other) const {
+				return first == other.first && count == other.count;
+			}
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] rebuildThreshold Fraction of moved instances above which a rebuild is preferred to a refit.
+		*/
+		TLASInstanceTable(float rebuildThreshold = 0.25f);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~TLASInstanceTable() = default;
+
+		/**
+		* @brief Build the key of a MeshPack drawn by an entity.
+		* MeshPack can be shared by entities, so the entity is part of the key.
+		* @param[in] entity Entity id.
+		* @param[in] pack MeshPack index in Mesh.
+		* @return Returns instance key.
+		*/
+		static uint64_t MakeKey(uint32_t entity, uint32_t pack) { return (static_cast<uint64_t>(entity) << 32) | pack; }
+
+		/**
+		* @brief Get or allocate the slot of an instance.
+		* @param[in] key Instance key, see MakeKey.
+		* @return Returns the stable slot.
+		*/
+		uint32_t Acquire(uint64_t key);
+
+		/**
+		* @brief Free the slot of an instance.
+		* @param[in] key Instance key, see MakeKey.
+		*/
+		void Release(uint64_t key);
+
+		/**
+		* @brief Start a full walk of the world, every key acquired until EndSync is kept alive.
+		* Used after meshes were added or removed.
+		*/
+		void BeginSync();
+
+		/**
+		* @brief Release all slots not touched since BeginSync.
+		*/
+		void EndSync();
+
+		/**
+		* @brief Get slot of an instance.
+		* @param[in] key Instance key, see MakeKey.
+		* @return Returns the slot, UINT32_MAX if not found.
+		*/
+		uint32_t GetSlot(uint64_t key) const;
+
+		/**
+		* @brief Set the whole instance of a slot.
+		* A changed BLAS reference or shader binding table offset is a structural change.
+		* @param[in] slot Slot.
+		* @param[in] instance Instance data.
+		*/
+		void SetInstance(uint32_t slot, const VkAccelerationStructureInstanceKHR& instance);
+
+		/**
+		* @brief Set the transform of a slot.
+		* @param[in] slot Slot.
+		* @param[in] model Model matrix.
+		*/
+		void SetTransform(uint32_t slot, const glm::mat4& model);
+
+		/**
+		* @brief Get the instance array, uploaded as is.
+		* @return Returns the instance array.
+		*/
+		const std::vector<VkAccelerationStructureInstanceKHR>& GetInstances() const { return m_Instances; }
+
+		/**
+		* @brief Get the number of live (acquired) slots.
+		* @return Returns live slots count.
+		*/
+		uint32_t GetLiveCount() const { return static_cast<uint32_t>(m_Slots.size()); }
+
+		/**
+		* @brief Get the number of dirty slots.
+		* @return Returns dirty slots count.
+		*/
+		uint32_t GetDirtyCount() const { return m_DirtyCount; }
+
+		/**
+		* @brief Get coalesced dirty ranges in ascending order.
+		* @return Returns dirty ranges.
+		*/
+		std::vector<DirtyRange> GetDirtyRanges() const;
+
+		/**
+		* @brief Decide how the TLAS should be built for the current changes.
+		* @return Returns BuildMode.
+		*/
+		BuildMode GetBuildMode() const;
+
+		/**
+		* @brief Call after uploading and building.
+		*/
+		void ClearDirty();
+
+	private:
+
+		/**
+		* @brief Mark a slot dirty.
+		* @param[in] slot Slot.
+		*/
+		void MarkDirty(uint32_t slot);
+
+	private:
+
+		/**
+		* @brief Fraction of moved instances above which a rebuild is preferred.
+		*/
+		float m_RebuildThreshold;
+
+		/**
+		* @brief Persistent instance array.
+		*/
+		std::vector<VkAccelerationStructureInstanceKHR> m_Instances;
+
+		/**
+		* @brief Per slot dirty flag.
+		*/
+		std::vector<uint8_t> m_Dirty;
+
+		/**
+		* @brief Per slot sync epoch, used by BeginSync / EndSync.
+		*/
+		std::vector<uint32_t> m_Epoch;
+
+		/**
+		* @brief Instance key to slot.
+		*/
+		std::unordered_map<uint64_t, uint32_t> m_Slots;
+
+		/**
+		* @brief Freed slots, reused LIFO.
+		*/
+		std::vector<uint32_t> m_FreeSlots;
+
+		/**
+		* @brief Dirty slots count.
+		*/
+		uint32_t m_DirtyCount = 0;
+
+		/**
+		* @brief Current sync epoch.
+		*/
+		uint32_t m_CurrentEpoch = 0;
+
+		/**
+		* @brief True if instance count, activity or BLAS references changed.
+		*/
+		bool m_StructureChanged = false;
+	};
+}
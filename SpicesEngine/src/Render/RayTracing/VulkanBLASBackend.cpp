@@ -0,0 +1,85 @@
+/**
+* @file VulkanBLASBackend.cpp.
+* @brief The VulkanBLASBackend Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "VulkanBLASBackend.h"
+
+namespace Spices {
+
+	VulkanBLASBackend::VulkanBLASBackend(VulkanRayTracing& rayTracing, VkBuildAccelerationStructureFlagsKHR flags)
+		: BLASBuildBackend()
+		, m_RayTracing(rayTracing)
+		, m_Flags(flags)
+	{}
+
+	VulkanBLASBackend::~VulkanBLASBackend()
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (auto& [key, blas] : m_Blas)
+		{
+			m_RayTracing.DestroyBLAS(blas);
+		}
+	}
+
+	VkDeviceSize VulkanBLASBackend::GetBuildSize(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Inputs.find(key);
+		if (it == m_Inputs.end())
+		{
+			SPICES_CORE_ERROR("VulkanBLASBackend::GetBuildSize: input is not registered.");
+			return 0;
+		}
+
+		return m_RayTracing.GetBlasBuildSizes(it->second, m_Flags).accelerationStructureSize;
+	}
+
+	void VulkanBLASBackend::Build(const std::vector<uint64_t>& keys)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::vector<VulkanRayTracing::BlasInput> inputs;
+		inputs.reserve(keys.size());
+		for (const auto key : keys)
+		{
+			inputs.push_back(m_Inputs[key]);
+		}
+
+		/**
+		* @brief One batched build and compaction for all keys.
+		*/
+		auto blas = m_RayTracing.CreateBLAS(inputs, m_Flags);
+
+		for (size_t i = 0; i < keys.size(); i++)
+		{
+			m_Blas[keys[i]] = blas[i];
+		}
+	}
+
+	VkDeviceAddress VulkanBLASBackend::GetAddress(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Blas.find(key);
+		return it == m_Blas.end() ? 0 : m_RayTracing.GetDeviceAddress(it->second);
+	}
+
+	void VulkanBLASBackend::Free(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (const auto it = m_Blas.find(key); it != m_Blas.end())
+		{
+			m_RayTracing.DestroyBLAS(it->second);
+			m_Blas.erase(it);
+		}
+
+		m_Inputs.erase(key);
+		m_Owners.erase(key);
+	}
+}
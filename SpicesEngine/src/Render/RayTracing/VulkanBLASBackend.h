@@ -0,0 +1,101 @@
+/**
+* @file VulkanBLASBackend.h.
+* @brief The VulkanBLASBackend Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "BLASRegistry.h"
+#include "Render/Vulkan/VulkanRayTracing.h"
+
+namespace Spices {
+
+	/**
+	* @brief BLASBuildBackend building BLAS with VulkanRayTracing.
+	* Inputs are registered by key before the registry schedules them.
+	*/
+	class VulkanBLASBackend : public BLASBuildBackend
+	{
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] rayTracing VulkanRayTracing, must outlive this backend.
+		* @param[in] flags Build flags of all BLAS.
+		*/
+		VulkanBLASBackend(VulkanRayTracing& rayTracing, VkBuildAccelerationStructureFlagsKHR flags);
+
+		/**
+		* @brief Destructor Function.
+		* Frees all BLAS still alive.
+		*/
+		virtual ~VulkanBLASBackend() override;
+
+		/**
+		* @brief Register the geometry of a key.
+		* @param[in] key MeshPack resource key.
+		* @param[in] input Geometry used to build the BLAS.
+		* @param[in] owner Owner of the geometry buffers, kept alive until the key is freed,
+		* so the buffers outlive the build and the key is not reused by another resource meanwhile.
+		*/
+		void SetInput(uint64_t key, const VulkanRayTracing::BlasInput& input, std::shared_ptr<void> owner)
+		{
+			m_Inputs[key] = input;
+			m_Owners[key] = std::move(owner);
+		}
+
+		/**
+		* @brief The interface is inherited from BLASBuildBackend.
+		* @param[in] key MeshPack resource key.
+		* @return Returns acceleration structure size.
+		*/
+		virtual VkDeviceSize GetBuildSize(uint64_t key) override;
+
+		/**
+		* @brief The interface is inherited from BLASBuildBackend.
+		* @param[in] keys MeshPack resource keys.
+		*/
+		virtual void Build(const std::vector<uint64_t>& keys) override;
+
+		/**
+		* @brief The interface is inherited from BLASBuildBackend.
+		* @param[in] key MeshPack resource key.
+		* @return Returns device address.
+		*/
+		virtual VkDeviceAddress GetAddress(uint64_t key) override;
+
+		/**
+		* @brief The interface is inherited from BLASBuildBackend.
+		* @param[in] key MeshPack resource key.
+		*/
+		virtual void Free(uint64_t key) override;
+
+	private:
+
+		/**
+		* @brief VulkanRayTracing.
+		*/
+		VulkanRayTracing& m_RayTracing;
+
+		/**
+		* @brief Build flags.
+		*/
+		VkBuildAccelerationStructureFlagsKHR m_Flags;
+
+		/**
+		* @brief Registered inputs.
+		*/
+		std::unordered_map<uint64_t, VulkanRayTracing::BlasInput> m_Inputs;
+
+		/**
+		* @brief Owners of registered inputs.
+		*/
+		std::unordered_map<uint64_t, std::shared_ptr<void>> m_Owners;
+
+		/**
+		* @brief Built BLAS.
+		*/
+		std::unordered_map<uint64_t, VulkanRayTracing::AccelKHR> m_Blas;
+	};
+}
@@ -0,0 +1,472 @@
+/**
+* @file RenderGraph.cpp.
+* @brief The RenderGraph Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "RenderGraph.h"
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Vulkan usage of an access type.
+		*/
+		struct AccessInfo
+		{
+			VkImageLayout         layout;        /* @brief Image layout.        */
+			VkPipelineStageFlags  stages;        /* @brief Default stages.      */
+			VkAccessFlags         readAccess;    /* @brief Access of reads.     */
+			VkAccessFlags         writeAccess;   /* @brief Access of writes.    */
+		};
+
+		/**
+		* @brief Get Vulkan usage of an access type.
+		* @param[in] type Access type.
+		* @return Returns AccessInfo.
+		*/
+		AccessInfo GetAccessInfo(RenderGraph::AccessType type)
+		{
+			switch (type)
+			{
+			case RenderGraph::AccessType::ColorAttachment:
+				return {
+					VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+					VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+					VK_ACCESS_COLOR_ATTACHMENT_READ_BIT,
+					VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+				};
+			case RenderGraph::AccessType::DepthAttachment:
+				return {
+					VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+					VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+					VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+					VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+				};
+			case RenderGraph::AccessType::InputAttachment:
+				return {
+					VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+					VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+					VK_ACCESS_INPUT_ATTACHMENT_READ_BIT,
+					0
+				};
+			case RenderGraph::AccessType::SampledTexture:
+				return {
+					VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+					VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+					VK_ACCESS_SHADER_READ_BIT,
+					0
+				};
+			case RenderGraph::AccessType::StorageTexture:
+			default:
+				return {
+					VK_IMAGE_LAYOUT_GENERAL,
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+					VK_ACCESS_SHADER_READ_BIT,
+					VK_ACCESS_SHADER_WRITE_BIT
+				};
+			}
+		}
+
+		/**
+		* @brief Whether two lifetimes overlap.
+		* @param[in] a Lifetime.
+		* @param[in] b Lifetime.
+		* @return Returns true if overlap.
+		*/
+		bool IsOverlap(const RenderGraph::Lifetime& a, const RenderGraph::Lifetime& b)
+		{
+			return !(a.lastPass < b.firstPass || b.lastPass < a.firstPass);
+		}
+	}
+
+	uint32_t RenderGraph::AddPass(const std::string& name)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_PassIndex.find(name);
+		if (it != m_PassIndex.end()) return it->second;
+
+		const uint32_t index = static_cast<uint32_t>(m_Passes.size());
+
+		m_Passes.push_back({ name, {} });
+		m_PassIndex[name] = index;
+		m_IsCompiled = false;
+
+		return index;
+	}
+
+	uint32_t RenderGraph::AddResource(const std::string& name)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_ResourceIndex.find(name);
+		if (it != m_ResourceIndex.end()) return it->second;
+
+		const uint32_t index = static_cast<uint32_t>(m_Resources.size());
+
+		Resource resource;
+		resource.name = name;
+
+		m_Resources.push_back(resource);
+		m_ResourceIndex[name] = index;
+		m_IsCompiled = false;
+
+		return index;
+	}
+
+	uint32_t RenderGraph::FindPass(const std::string& name) const
+	{
+		const auto it = m_PassIndex.find(name);
+		return it != m_PassIndex.end() ? it->second : Invalid;
+	}
+
+	uint32_t RenderGraph::FindResource(const std::string& name) const
+	{
+		const auto it = m_ResourceIndex.find(name);
+		return it != m_ResourceIndex.end() ? it->second : Invalid;
+	}
+
+	void RenderGraph::SetResourceSize(uint32_t resource, VkDeviceSize size, VkDeviceSize alignment)
+	{
+		Resource& res = m_Resources[resource];
+
+		if (res.size == size && res.alignment == alignment) return;
+
+		res.size      = size;
+		res.alignment = std::max<VkDeviceSize>(alignment, 1);
+		m_IsCompiled  = false;
+	}
+
+	void RenderGraph::Export(uint32_t resource)
+	{
+		if (m_Resources[resource].isExported) return;
+
+		m_Resources[resource].isExported = true;
+		m_IsCompiled = false;
+	}
+
+	void RenderGraph::Access(
+		uint32_t              pass     ,
+		uint32_t              resource ,
+		AccessType            type     ,
+		bool                  read     ,
+		bool                  write    ,
+		VkPipelineStageFlags  stages
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (stages == 0)
+		{
+			stages = GetAccessInfo(type).stages;
+		}
+
+		m_IsCompiled = false;
+
+		/**
+		* @brief Merge with same access.
+		*/
+		for (auto& access : m_Passes[pass].accesses)
+		{
+			if (access.resource == resource && access.type == type)
+			{
+				access.read   |= read;
+				access.write  |= write;
+				access.stages |= stages;
+				return;
+			}
+		}
+
+		m_Passes[pass].accesses.push_back({ resource, type, read, write, stages });
+	}
+
+	void RenderGraph::Compile()
+	{
+		SPICES_PROFILE_ZONE;
+
+		ComputeLifetimes();
+		ComputeAliasing();
+		ComputeBarriers();
+
+		m_IsCompiled = true;
+	}
+
+	void RenderGraph::Clear()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Passes       .clear();
+		m_Resources    .clear();
+		m_PassIndex    .clear();
+		m_ResourceIndex.clear();
+		m_Lifetimes    .clear();
+		m_Blocks       .clear();
+		m_Barriers     .clear();
+
+		m_Stats      = Stats{};
+		m_IsCompiled = false;
+	}
+
+	VkPipelineStageFlags RenderGraph::ToPipelineStages(VkShaderStageFlags stages)
+	{
+		VkPipelineStageFlags flags = 0;
+
+		if (stages & VK_SHADER_STAGE_VERTEX_BIT)                  flags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+		if (stages & VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT)    flags |= VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT;
+		if (stages & VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT) flags |= VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT;
+		if (stages & VK_SHADER_STAGE_GEOMETRY_BIT)                flags |= VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT;
+		if (stages & VK_SHADER_STAGE_FRAGMENT_BIT)                flags |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		if (stages & VK_SHADER_STAGE_COMPUTE_BIT)                 flags |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		if (stages & VK_SHADER_STAGE_TASK_BIT_EXT)                flags |= VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT;
+		if (stages & VK_SHADER_STAGE_MESH_BIT_EXT)                flags |= VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT;
+
+		constexpr VkShaderStageFlags rayTracingStages =
+			VK_SHADER_STAGE_RAYGEN_BIT_KHR      | VK_SHADER_STAGE_ANY_HIT_BIT_KHR      |
+			VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR | VK_SHADER_STAGE_MISS_BIT_KHR         |
+			VK_SHADER_STAGE_INTERSECTION_BIT_KHR| VK_SHADER_STAGE_CALLABLE_BIT_KHR;
+
+		if (stages & rayTracingStages)                            flags |= VK_PIPELINE_STAGE_RAY_TRACING_SHADER_BIT_KHR;
+
+		return flags;
+	}
+
+	void RenderGraph::ComputeLifetimes()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Lifetimes.assign(m_Resources.size(), Lifetime{});
+
+		/**
+		* @brief Content is carried from last frame if the first access reads it.
+		*/
+		std::vector<uint8_t> isLoaded(m_Resources.size(), 0);
+
+		for (uint32_t p = 0; p < m_Passes.size(); p++)
+		{
+			for (const auto& access : m_Passes[p].accesses)
+			{
+				Lifetime& lifetime = m_Lifetimes[access.resource];
+
+				if (lifetime.firstPass == Invalid)
+				{
+					lifetime.firstPass         = p;
+					isLoaded[access.resource]  = access.read;
+				}
+
+				lifetime.lastPass = p;
+			}
+		}
+
+		for (uint32_t r = 0; r < m_Resources.size(); r++)
+		{
+			Lifetime& lifetime = m_Lifetimes[r];
+
+			lifetime.isTransient = lifetime.firstPass != Invalid && !isLoaded[r] && !m_Resources[r].isExported;
+		}
+	}
+
+	void RenderGraph::ComputeAliasing()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Blocks.clear();
+		m_Stats = Stats{};
+
+		std::vector<uint32_t> transients;
+		for (uint32_t r = 0; r < m_Resources.size(); r++)
+		{
+			m_Stats.unaliasedBytes += m_Resources[r].size;
+
+			if (m_Lifetimes[r].isTransient)
+			{
+				transients.push_back(r);
+			}
+			else
+			{
+				m_Stats.aliasedBytes += m_Resources[r].size;
+			}
+		}
+
+		/**
+		* @brief Largest first, each goes to the fitting block growing least.
+		*/
+		std::stable_sort(transients.begin(), transients.end(), [&](uint32_t a, uint32_t b) {
+			if (m_Resources[a].size != m_Resources[b].size) return m_Resources[a].size > m_Resources[b].size;
+			return m_Lifetimes[a].firstPass < m_Lifetimes[b].firstPass;
+		});
+
+		for (const auto r : transients)
+		{
+			const Resource& resource = m_Resources[r];
+
+			uint32_t     best       = Invalid;
+			VkDeviceSize bestGrowth = 0;
+
+			for (uint32_t b = 0; b < m_Blocks.size(); b++)
+			{
+				const MemoryBlock& block = m_Blocks[b];
+
+				const bool isFree = std::none_of(block.resources.begin(), block.resources.end(), [&](uint32_t other) {
+					return IsOverlap(m_Lifetimes[r], m_Lifetimes[other]);
+				});
+
+				if (!isFree) continue;
+
+				const VkDeviceSize growth = resource.size > block.size ? resource.size - block.size : 0;
+				if (best == Invalid || growth < bestGrowth)
+				{
+					best       = b;
+					bestGrowth = growth;
+				}
+			}
+
+			if (best == Invalid)
+			{
+				best = static_cast<uint32_t>(m_Blocks.size());
+				m_Blocks.emplace_back();
+			}
+
+			MemoryBlock& block = m_Blocks[best];
+			block.size         = std::max(block.size, resource.size);
+			block.alignment    = std::max(block.alignment, resource.alignment);
+			block.resources.push_back(r);
+
+			m_Lifetimes[r].block = best;
+		}
+
+		for (auto& block : m_Blocks)
+		{
+			std::sort(block.resources.begin(), block.resources.end(), [&](uint32_t a, uint32_t b) {
+				return m_Lifetimes[a].firstPass < m_Lifetimes[b].firstPass;
+			});
+
+			m_Stats.aliasedBytes += block.size;
+		}
+
+		m_Stats.transientCount = static_cast<uint32_t>(transients.size());
+		m_Stats.blockCount     = static_cast<uint32_t>(m_Blocks.size());
+	}
+
+	void RenderGraph::ComputeBarriers()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Barriers.clear();
+
+		/**
+		* @brief First frame gives the state persistent resources enter a frame with.
+		*/
+		std::vector<State> states(m_Resources.size());
+		Simulate(states, nullptr);
+
+		for (auto& state : states)
+		{
+			state.isAccessed = false;
+		}
+
+		Simulate(states, &m_Barriers);
+	}
+
+	void RenderGraph::Simulate(std::vector<State>& states, std::vector<Barrier>* barriers) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (uint32_t p = 0; p < m_Passes.size(); p++)
+		{
+			for (const auto& access : m_Passes[p].accesses)
+			{
+				const uint32_t   r        = access.resource;
+				const Lifetime&  lifetime = m_Lifetimes[r];
+				const AccessInfo info     = GetAccessInfo(access.type);
+
+				State& state = states[r];
+
+				Barrier barrier;
+				barrier.pass = p;
+				barrier.resource = r;
+
+				bool isNeeded = false;
+
+				/**
+				* @brief Transient content starts undefined, after the previous occupant of its block.
+				*/
+				if (!state.isAccessed && lifetime.isTransient)
+				{
+					state = State{};
+					isNeeded = true;
+
+					const auto& occupants = m_Blocks[lifetime.block].resources;
+					const auto  it        = std::find(occupants.begin(), occupants.end(), r);
+
+					if (it != occupants.begin())
+					{
+						const State& previous = states[*(it - 1)];
+
+						state.writeStages   = previous.writeStages | previous.readStages;
+						state.writeAccess   = previous.writeAccess;
+						barrier.isAliasing  = true;
+					}
+				}
+
+				state.isAccessed = true;
+
+				const bool isLayoutChange = state.layout != info.layout;
+				const bool isUnsynced     = state.writeStages != 0 && (access.write || (access.stages & ~state.synced) != 0);
+				const bool isWar          = access.write && state.readStages != 0;
+
+				isNeeded |= isLayoutChange || isUnsynced || isWar;
+
+				if (isNeeded)
+				{
+					barrier.oldLayout     = state.layout;
+					barrier.newLayout     = info.layout;
+					barrier.srcStageMask  = state.writeStages | state.readStages;
+					barrier.srcAccessMask = state.writeAccess;
+					barrier.dstStageMask  = access.stages;
+					barrier.dstAccessMask = (access.read ? info.readAccess : 0) | (access.write ? info.writeAccess : 0);
+
+					if (barrier.srcStageMask == 0)
+					{
+						barrier.srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+					}
+
+					if (barriers)
+					{
+						barriers->push_back(barrier);
+					}
+				}
+
+				state.layout = info.layout;
+
+				if (access.write)
+				{
+					state.writeStages = access.stages;
+					state.writeAccess = info.writeAccess;
+					state.readStages  = 0;
+					state.synced      = 0;
+				}
+				else if (isLayoutChange)
+				{
+					/**
+					* @brief A layout transition is a write other stages must wait.
+					*/
+					state.writeStages = access.stages;
+					state.writeAccess = 0;
+					state.readStages  = access.stages;
+					state.synced      = access.stages;
+				}
+				else
+				{
+					state.readStages |= access.stages;
+					if (isNeeded)
+					{
+						state.synced |= access.stages;
+					}
+				}
+			}
+		}
+	}
+}
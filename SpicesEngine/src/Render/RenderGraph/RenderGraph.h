@@ -0,0 +1,362 @@
+/**
+* @file RenderGraph.h.
+* @brief The RenderGraph Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace Spices {
+
+	/**
+	* @brief Frame graph of sub passes and the attachments they access.
+	* Passes are recorded in execution order, each with the resources it reads and writes.
+	* Compile computes resource lifetimes, a plan packing transient resources with disjoint lifetimes
+	* into memory blocks and the barriers between accesses.
+	* Pure CPU diagnostic, independent of Vulkan objects: no memory is shared and no barrier is issued from it.
+	*/
+	class RenderGraph
+	{
+	public:
+
+		/**
+		* @brief How a pass accesses a resource.
+		*/
+		enum class AccessType : uint8_t
+		{
+			ColorAttachment = 0,     /* @brief Color attachment.             */
+			DepthAttachment = 1,     /* @brief Depth stencil attachment.     */
+			InputAttachment = 2,     /* @brief Subpass input attachment.     */
+			SampledTexture  = 3,     /* @brief Sampled in shader.            */
+			StorageTexture  = 4,     /* @brief Storage image in shader.      */
+		};
+
+		/**
+		* @brief Lifetime of a resource in a frame.
+		*/
+		struct Lifetime
+		{
+			uint32_t firstPass   = ~0u;     /* @brief First pass accessing the resource.             */
+			uint32_t lastPass    = ~0u;     /* @brief Last pass accessing the resource.              */
+			bool     isTransient = false;   /* @brief Content does not live across frames.           */
+			uint32_t block       = ~0u;     /* @brief Memory block of a transient resource.          */
+		};
+
+		/**
+		* @brief Planned memory for transient resources with disjoint lifetimes, not allocated.
+		*/
+		struct MemoryBlock
+		{
+			VkDeviceSize          size      = 0;    /* @brief Bytes, the largest occupant.      */
+			VkDeviceSize          alignment = 1;    /* @brief The largest occupant alignment.   */
+			std::vector<uint32_t> resources;        /* @brief Occupants in lifetime order.      */
+		};
+
+		/**
+		* @brief Image barrier before an access.
+		*/
+		struct Barrier
+		{
+			uint32_t              pass          = 0;                           /* @brief Pass the barrier is issued before.                         */
+			uint32_t              resource      = 0;                           /* @brief Resource.                                                  */
+			VkImageLayout         oldLayout     = VK_IMAGE_LAYOUT_UNDEFINED;   /* @brief Layout before.                                             */
+			VkImageLayout         newLayout     = VK_IMAGE_LAYOUT_UNDEFINED;   /* @brief Layout after.                                              */
+			VkPipelineStageFlags  srcStageMask  = 0;                           /* @brief Stages to wait.                                            */
+			VkPipelineStageFlags  dstStageMask  = 0;                           /* @brief Stages to block.                                           */
+			VkAccessFlags         srcAccessMask = 0;                           /* @brief Writes to make available.                                  */
+			VkAccessFlags         dstAccessMask = 0;                           /* @brief Accesses to make visible.                                  */
+			bool                  isAliasing    = false;                       /* @brief Resource takes the memory block over from an earlier one.  */
+		};
+
+		/**
+		* @brief Memory statistics of the compiled graph.
+		*/
+		struct Stats
+		{
+			VkDeviceSize unaliasedBytes = 0;   /* @brief Bytes with one allocation per resource.   */
+			VkDeviceSize aliasedBytes   = 0;   /* @brief Bytes of the aliasing plan, not allocated. */
+			uint32_t     transientCount = 0;   /* @brief Number of transient resources.            */
+			uint32_t     blockCount     = 0;   /* @brief Number of memory blocks.                  */
+		};
+
+		/**
+		* @brief Invalid pass or resource index.
+		*/
+		static constexpr uint32_t Invalid = ~0u;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		RenderGraph() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~RenderGraph() = default;
+
+		/**
+		* @brief Add a pass after all passes added, or get the pass with the name.
+		* @param[in] name Pass name.
+		* @return Returns pass index.
+		*/
+		uint32_t AddPass(const std::string& name);
+
+		/**
+		* @brief Add a resource, or get the resource with the name.
+		* @param[in] name Resource name.
+		* @return Returns resource index.
+		*/
+		uint32_t AddResource(const std::string& name);
+
+		/**
+		* @brief Find a pass.
+		* @param[in] name Pass name.
+		* @return Returns pass index, Invalid if not found.
+		*/
+		uint32_t FindPass(const std::string& name) const;
+
+		/**
+		* @brief Find a resource.
+		* @param[in] name Resource name.
+		* @return Returns resource index, Invalid if not found.
+		*/
+		uint32_t FindResource(const std::string& name) const;
+
+		/**
+		* @brief Set resource memory requirements.
+		* @param[in] resource Resource index.
+		* @param[in] size Bytes.
+		* @param[in] alignment Memory alignment.
+		*/
+		void SetResourceSize(uint32_t resource, VkDeviceSize size, VkDeviceSize alignment = 1);
+
+		/**
+		* @brief Mark a resource read outside the graph, it is never aliased.
+		* @param[in] resource Resource index.
+		*/
+		void Export(uint32_t resource);
+
+		/**
+		* @brief Whether a resource is read outside the graph.
+		* @param[in] resource Resource index.
+		* @return Returns true if exported.
+		*/
+		bool IsExported(uint32_t resource) const { return m_Resources[resource].isExported; }
+
+		/**
+		* @brief Record a pass access to a resource.
+		* Accesses of the same type to the same resource in one pass are merged.
+		* @param[in] pass Pass index.
+		* @param[in] resource Resource index.
+		* @param[in] type Access type.
+		* @param[in] read True if previous content is read.
+		* @param[in] write True if content is written.
+		* @param[in] stages Pipeline stages accessing, 0 means default stages of type.
+		*/
+		void Access(
+			uint32_t              pass         ,
+			uint32_t              resource     ,
+			AccessType            type         ,
+			bool                  read         ,
+			bool                  write        ,
+			VkPipelineStageFlags  stages = 0
+		);
+
+		/**
+		* @brief Compute lifetimes, aliasing plan and barriers, for diagnostics only.
+		*/
+		void Compile();
+
+		/**
+		* @brief Remove all passes and resources.
+		*/
+		void Clear();
+
+		/**
+		* @brief Whether the graph is compiled after the last change.
+		* @return Returns true if compiled.
+		*/
+		bool IsCompiled() const { return m_IsCompiled; }
+
+		/**
+		* @brief Get number of passes.
+		* @return Returns number of passes.
+		*/
+		uint32_t GetPassCount() const { return static_cast<uint32_t>(m_Passes.size()); }
+
+		/**
+		* @brief Get number of resources.
+		* @return Returns number of resources.
+		*/
+		uint32_t GetResourceCount() const { return static_cast<uint32_t>(m_Resources.size()); }
+
+		/**
+		* @brief Get pass name.
+		* @param[in] pass Pass index.
+		* @return Returns pass name.
+		*/
+		const std::string& GetPassName(uint32_t pass) const { return m_Passes[pass].name; }
+
+		/**
+		* @brief Get resource name.
+		* @param[in] resource Resource index.
+		* @return Returns resource name.
+		*/
+		const std::string& GetResourceName(uint32_t resource) const { return m_Resources[resource].name; }
+
+		/**
+		* @brief Get resource lifetime.
+		* @param[in] resource Resource index.
+		* @return Returns lifetime.
+		*/
+		const Lifetime& GetLifetime(uint32_t resource) const { return m_Lifetimes[resource]; }
+
+		/**
+		* @brief Get memory blocks.
+		* @return Returns memory blocks.
+		*/
+		const std::vector<MemoryBlock>& GetBlocks() const { return m_Blocks; }
+
+		/**
+		* @brief Get barriers.
+		* @return Returns barriers in pass order.
+		*/
+		const std::vector<Barrier>& GetBarriers() const { return m_Barriers; }
+
+		/**
+		* @brief Get memory statistics.
+		* @return Returns statistics.
+		*/
+		const Stats& GetStats() const { return m_Stats; }
+
+		/**
+		* @brief Get pipeline stages running shaders of given stages.
+		* @param[in] stages VkShaderStageFlags.
+		* @return Returns VkPipelineStageFlags.
+		*/
+		static VkPipelineStageFlags ToPipelineStages(VkShaderStageFlags stages);
+
+	private:
+
+		/**
+		* @brief Resource declaration.
+		*/
+		struct Resource
+		{
+			std::string   name;                  /* @brief Resource name.                 */
+			VkDeviceSize  size       = 0;        /* @brief Bytes.                         */
+			VkDeviceSize  alignment  = 1;        /* @brief Memory alignment.              */
+			bool          isExported = false;    /* @brief Read outside the graph.        */
+		};
+
+		/**
+		* @brief One access of a pass.
+		*/
+		struct PassAccess
+		{
+			uint32_t              resource = 0;                          /* @brief Resource index.       */
+			AccessType            type     = AccessType::ColorAttachment; /* @brief Access type.          */
+			bool                  read     = false;                      /* @brief Reads content.        */
+			bool                  write    = false;                      /* @brief Writes content.       */
+			VkPipelineStageFlags  stages   = 0;                          /* @brief Stages accessing.     */
+		};
+
+		/**
+		* @brief Pass declaration.
+		*/
+		struct Pass
+		{
+			std::string              name;       /* @brief Pass name.         */
+			std::vector<PassAccess>  accesses;   /* @brief Accesses in order. */
+		};
+
+		/**
+		* @brief Synchronization state of a resource.
+		*/
+		struct State
+		{
+			VkImageLayout         layout      = VK_IMAGE_LAYOUT_UNDEFINED;  /* @brief Current layout.                        */
+			VkPipelineStageFlags  writeStages = 0;                          /* @brief Stages of last write.                 */
+			VkAccessFlags         writeAccess = 0;                          /* @brief Access of last write.                 */
+			VkPipelineStageFlags  readStages  = 0;                          /* @brief Stages read since last write.         */
+			VkPipelineStageFlags  synced      = 0;                          /* @brief Stages last write is visible to.      */
+			bool                  isAccessed  = false;                      /* @brief Accessed in this frame.               */
+		};
+
+		/**
+		* @brief Compute lifetimes and whether resources are transient.
+		*/
+		void ComputeLifetimes();
+
+		/**
+		* @brief Pack transient resources into memory blocks.
+		*/
+		void ComputeAliasing();
+
+		/**
+		* @brief Walk accesses in pass order and emit barriers.
+		*/
+		void ComputeBarriers();
+
+		/**
+		* @brief Walk one frame of accesses.
+		* @param[in,out] states Per resource state.
+		* @param[out] barriers Emitted barriers, nullptr if not needed.
+		*/
+		void Simulate(std::vector<State>& states, std::vector<Barrier>* barriers) const;
+
+	private:
+
+		/**
+		* @brief Passes in execution order.
+		*/
+		std::vector<Pass> m_Passes;
+
+		/**
+		* @brief Resources.
+		*/
+		std::vector<Resource> m_Resources;
+
+		/**
+		* @brief Name to pass index.
+		*/
+		std::unordered_map<std::string, uint32_t> m_PassIndex;
+
+		/**
+		* @brief Name to resource index.
+		*/
+		std::unordered_map<std::string, uint32_t> m_ResourceIndex;
+
+		/**
+		* @brief Compiled lifetimes.
+		*/
+		std::vector<Lifetime> m_Lifetimes;
+
+		/**
+		* @brief Compiled memory blocks.
+		*/
+		std::vector<MemoryBlock> m_Blocks;
+
+		/**
+		* @brief Compiled barriers.
+		*/
+		std::vector<Barrier> m_Barriers;
+
+		/**
+		* @brief Compiled statistics.
+		*/
+		Stats m_Stats;
+
+		/**
+		* @brief True if compiled after last change.
+		*/
+		bool m_IsCompiled = false;
+	};
+}
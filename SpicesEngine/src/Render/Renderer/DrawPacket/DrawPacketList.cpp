@@ -0,0 +1,337 @@
+/**
+* @file DrawPacketList.cpp.
+* @brief The DrawPacketList Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "DrawPacketList.h"
+#include "Core/Thread/ThreadPool.h"
+#include "Core/Memory/FrameAllocator.h"
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Radix sort digit.
+		*/
+		constexpr uint32_t DigitBits   = 8;
+		constexpr uint32_t DigitCount  = 1 << DigitBits;
+		constexpr uint32_t DigitPasses = 64 / DigitBits;
+
+		/**
+		* @brief Below this size sort runs on caller thread.
+		*/
+		constexpr size_t ParallelThreshold = 1 << 16;
+
+		/**
+		* @brief Histogram of a digit.
+		*/
+		using Histogram = std::array<uint32_t, DigitCount>;
+
+		/**
+		* @brief Run a function for each chunk, in parallel if threadPool is not nullptr.
+		* @param[in] threadPool ThreadPool.
+		* @param[in] nChunks Number of chunks.
+		* @param[in] func Function called with chunk index.
+		*/
+		template<typename F>
+		void ForEachChunk(ThreadPool* threadPool, uint32_t nChunks, F&& func)
+		{
+			if (!threadPool || nChunks == 1)
+			{
+				for (uint32_t c = 0; c < nChunks; c++)
+				{
+					func(c);
+				}
+				return;
+			}
+
+			std::pmr::vector<std::future<void>> futures(FrameAllocator::GetResource());
+			futures.reserve(nChunks);
+
+			for (uint32_t c = 0; c < nChunks; c++)
+			{
+				futures.push_back(threadPool->SubmitPoolTask([&func, c]() { func(c); }));
+			}
+
+			for (auto& future : futures)
+			{
+				future.wait();
+			}
+		}
+
+		/**
+		* @brief Get digit of a key.
+		* @param[in] key Key.
+		* @param[in] pass Digit index, 0 is lowest.
+		* @return Returns digit.
+		*/
+		inline uint32_t GetDigit(uint64_t key, uint32_t pass)
+		{
+			return static_cast<uint32_t>(key >> (pass * DigitBits)) & (DigitCount - 1);
+		}
+	}
+
+	uint64_t DrawPacketList::MakeKey(
+		uint32_t  pass          ,
+		uint32_t  pipeline      ,
+		uint32_t  material      ,
+		float     depth         ,
+		bool      isBackToFront
+	)
+	{
+		/**
+		* @brief Non negative floats compare as their bits.
+		*/
+		const float d = depth > 0.0f ? depth : 0.0f;
+
+		uint32_t depthBits = 0;
+		memcpy(&depthBits, &d, sizeof(float));
+
+		const uint64_t p = std::min<uint64_t>(pass, (1ull << PassBits) - 1);
+		const uint64_t s = pipeline & ((1ull << PipelineBits) - 1);
+		const uint64_t m = material & ((1ull << MaterialBits) - 1);
+
+		/**
+		* @brief Blended draws must keep depth order across pipelines, so depth goes above state.
+		*/
+		if (isBackToFront)
+		{
+			return p << 60 | static_cast<uint64_t>(~depthBits) << 28 | s << 16 | m;
+		}
+
+		return p << 60 | s << 48 | m << 32 | depthBits;
+	}
+
+	void DrawPacketList::RadixSort(
+		std::vector<uint64_t>&  keys       ,
+		std::vector<uint32_t>&  values     ,
+		ThreadPool*             threadPool
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const size_t n = keys.size();
+		if (n < 2) return;
+
+		const bool     isParallel = threadPool && threadPool->GetThreadsCount() > 0 && n >= ParallelThreshold;
+		const uint32_t nChunks    = isParallel ? static_cast<uint32_t>(threadPool->GetThreadsCount()) : 1;
+		const size_t   chunkSize  = (n + nChunks - 1) / nChunks;
+
+		auto chunkBegin = [&](uint32_t c) { return std::min(n, c * chunkSize); };
+		auto chunkEnd   = [&](uint32_t c) { return std::min(n, (c + 1) * chunkSize); };
+
+		ThreadPool* pool = isParallel ? threadPool : nullptr;
+
+		/**
+		* @brief Temporaries live in this thread's frame arena.
+		*/
+		std::pmr::memory_resource* resource = FrameAllocator::GetResource();
+
+		/**
+		* @brief Histograms of all digits, digits same for all keys are skipped.
+		*/
+		std::pmr::vector<std::array<Histogram, DigitPasses>> digitHistograms(nChunks, resource);
+
+		ForEachChunk(pool, nChunks, [&](uint32_t c) {
+			auto& histograms = digitHistograms[c];
+			for (auto& histogram : histograms) histogram.fill(0);
+
+			for (size_t i = chunkBegin(c); i < chunkEnd(c); i++)
+			{
+				for (uint32_t d = 0; d < DigitPasses; d++)
+				{
+					histograms[d][GetDigit(keys[i], d)]++;
+				}
+			}
+		});
+
+		std::pmr::vector<uint64_t> tmpKeys(n, resource);
+		std::pmr::vector<uint32_t> tmpValues(n, resource);
+
+		uint64_t* srcKeys   = keys.data();
+		uint32_t* srcValues = values.data();
+		uint64_t* dstKeys   = tmpKeys.data();
+		uint32_t* dstValues = tmpValues.data();
+
+		std::pmr::vector<Histogram> offsets(nChunks, resource);
+
+		for (uint32_t d = 0; d < DigitPasses; d++)
+		{
+			const uint32_t first = GetDigit(srcKeys[0], d);
+
+			uint64_t sameCount = 0;
+			for (uint32_t c = 0; c < nChunks; c++)
+			{
+				sameCount += digitHistograms[c][d][first];
+			}
+
+			if (sameCount == n) continue;
+
+			/**
+			* @brief Chunk histograms of this digit, keys are moved among chunks by previous passes.
+			*/
+			ForEachChunk(pool, nChunks, [&](uint32_t c) {
+				Histogram& histogram = offsets[c];
+				histogram.fill(0);
+
+				for (size_t i = chunkBegin(c); i < chunkEnd(c); i++)
+				{
+					histogram[GetDigit(srcKeys[i], d)]++;
+				}
+			});
+
+			/**
+			* @brief Each chunk writes its keys of a digit after lower chunks' keys of that digit.
+			*/
+			uint32_t running = 0;
+			for (uint32_t b = 0; b < DigitCount; b++)
+			{
+				for (uint32_t c = 0; c < nChunks; c++)
+				{
+					const uint32_t count = offsets[c][b];
+					offsets[c][b] = running;
+					running += count;
+				}
+			}
+
+			ForEachChunk(pool, nChunks, [&](uint32_t c) {
+				Histogram& offset = offsets[c];
+
+				for (size_t i = chunkBegin(c); i < chunkEnd(c); i++)
+				{
+					const uint32_t dst = offset[GetDigit(srcKeys[i], d)]++;
+
+					dstKeys[dst]   = srcKeys[i];
+					dstValues[dst] = srcValues[i];
+				}
+			});
+
+			std::swap(srcKeys,   dstKeys);
+			std::swap(srcValues, dstValues);
+		}
+
+		/**
+		* @brief Copy back instead of swap, so keys and values keep their own storage.
+		*/
+		if (srcKeys != keys.data())
+		{
+			std::copy(tmpKeys  .begin(), tmpKeys  .end(), keys  .begin());
+			std::copy(tmpValues.begin(), tmpValues.end(), values.begin());
+		}
+	}
+
+	uint32_t DrawPacketList::GetPipelineId(const std::string& name)
+	{
+		const auto it = m_PipelineIds.find(name);
+		if (it != m_PipelineIds.end()) return it->second;
+
+		const uint32_t id = static_cast<uint32_t>(m_PipelineNames.size());
+
+		if (id == 1u << PipelineBits)
+		{
+			SPICES_CORE_WARN("DrawPacketList::GetPipelineId: pipeline ids out of key bits, draws may not be grouped.");
+		}
+
+		m_PipelineNames.push_back(name);
+		m_PipelineIds[name] = id;
+
+		return id;
+	}
+
+	uint32_t DrawPacketList::GetMaterialId(uint64_t key)
+	{
+		if (key == 0) return 0;
+
+		const auto it = m_MaterialIds.find(key);
+		if (it != m_MaterialIds.end()) return it->second;
+
+		const uint32_t id = static_cast<uint32_t>(m_MaterialIds.size()) + 1;
+
+		if (id == 1u << MaterialBits)
+		{
+			SPICES_CORE_WARN("DrawPacketList::GetMaterialId: material ids out of key bits, draws may not be grouped.");
+		}
+
+		m_MaterialIds[key] = id;
+
+		return id;
+	}
+
+	void DrawPacketList::Clear()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Packets.clear();
+		m_Keys   .clear();
+		m_Order  .clear();
+
+		m_Stats = Stats{};
+	}
+
+	void DrawPacketList::Reserve(size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Packets.reserve(count);
+		m_Keys   .reserve(count);
+		m_Order  .reserve(count);
+	}
+
+	void DrawPacketList::Add(
+		uint32_t  pass          ,
+		uint32_t  pipeline      ,
+		uint32_t  material      ,
+		float     depth         ,
+		uint32_t  item          ,
+		bool      isBackToFront
+	)
+	{
+		m_Order  .push_back(static_cast<uint32_t>(m_Packets.size()));
+		m_Packets.push_back({ pipeline, material, item });
+		m_Keys   .push_back(MakeKey(pass, pipeline, material, depth, isBackToFront));
+	}
+
+	void DrawPacketList::Sort(ThreadPool* threadPool)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Stats.packets = static_cast<uint32_t>(m_Packets.size());
+		CountBinds(nullptr, m_Stats.unsortedPipelineBinds, m_Stats.unsortedMaterialBinds);
+
+		RadixSort(m_Keys, m_Order, threadPool);
+
+		CountBinds(&m_Order, m_Stats.pipelineBinds, m_Stats.materialBinds);
+	}
+
+	void DrawPacketList::CountBinds(const std::vector<uint32_t>* order, uint32_t& pipelineBinds, uint32_t& materialBinds) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		pipelineBinds = 0;
+		materialBinds = 0;
+
+		uint32_t pipeline = ~0u;
+		uint32_t material = ~0u;
+
+		for (size_t i = 0; i < m_Packets.size(); i++)
+		{
+			const Packet& packet = m_Packets[order ? (*order)[i] : i];
+
+			if (packet.pipeline != pipeline)
+			{
+				pipeline = packet.pipeline;
+				material = ~0u;
+				pipelineBinds++;
+			}
+
+			if (packet.material != material)
+			{
+				material = packet.material;
+				materialBinds++;
+			}
+		}
+	}
+}
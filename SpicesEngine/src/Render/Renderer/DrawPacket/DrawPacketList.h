@@ -0,0 +1,290 @@
+/**
+* @file DrawPacketList.h.
+* @brief The DrawPacketList Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+namespace Spices {
+
+	/**
+	* @brief Forward declare.
+	*/
+	class ThreadPool;
+
+	/**
+	* @brief List of draws sorted by a 64 bits key before recording.
+	* Key from high to low bits: pass, pipeline, material, depth.
+	* Sorting groups draws sharing state, Record only binds state changed from the previous draw.
+	*/
+	class DrawPacketList
+	{
+	public:
+
+		/**
+		* @brief Key bits.
+		*/
+		static constexpr uint32_t PassBits     = 4;
+		static constexpr uint32_t PipelineBits = 12;
+		static constexpr uint32_t MaterialBits = 16;
+		static constexpr uint32_t DepthBits    = 32;
+
+		/**
+		* @brief One draw.
+		*/
+		struct Packet
+		{
+			uint32_t pipeline = 0;    /* @brief Pipeline id.                   */
+			uint32_t material = 0;    /* @brief Material id, 0 if not used.    */
+			uint32_t item     = 0;    /* @brief Caller's index of the draw.    */
+		};
+
+		/**
+		* @brief State changes of recording.
+		*/
+		struct Stats
+		{
+			uint32_t packets               = 0;   /* @brief Number of draws.                               */
+			uint32_t pipelineBinds         = 0;   /* @brief Pipeline binds in sorted order.                */
+			uint32_t materialBinds         = 0;   /* @brief Material binds in sorted order.                */
+			uint32_t unsortedPipelineBinds = 0;   /* @brief Pipeline binds in submission order.            */
+			uint32_t unsortedMaterialBinds = 0;   /* @brief Material binds in submission order.            */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		DrawPacketList() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~DrawPacketList() = default;
+
+		/**
+		* @brief Build a sort key.
+		* @param[in] pass Pass or layer, lower draws first.
+		* @param[in] pipeline Pipeline id.
+		* @param[in] material Material id.
+		* @param[in] depth Distance to camera.
+		* @param[in] isBackToFront True for far to near, used by blended draws.
+		* @return Returns the key.
+		*/
+		static uint64_t MakeKey(
+			uint32_t  pass                  ,
+			uint32_t  pipeline              ,
+			uint32_t  material              ,
+			float     depth                 ,
+			bool      isBackToFront = false
+		);
+
+		/**
+		* @brief Sort keys and values together by key, stable.
+		* @param[in,out] keys Keys.
+		* @param[in,out] values Values.
+		* @param[in] threadPool Sort in parallel if not nullptr.
+		*/
+		static void RadixSort(
+			std::vector<uint64_t>&  keys                 ,
+			std::vector<uint32_t>&  values               ,
+			ThreadPool*             threadPool = nullptr
+		);
+
+		/**
+		* @brief Get a pipeline id by name.
+		* Ids are kept across frames.
+		* @param[in] name Pipeline name.
+		* @return Returns pipeline id.
+		*/
+		uint32_t GetPipelineId(const std::string& name);
+
+		/**
+		* @brief Get pipeline name of an id.
+		* @param[in] id Pipeline id.
+		* @return Returns pipeline name.
+		*/
+		const std::string& GetPipelineName(uint32_t id) const { return m_PipelineNames[id]; }
+
+		/**
+		* @brief Get a material id by a key identifying material, such as its address.
+		* Ids are kept across frames, 0 is no material.
+		* @param[in] key Material key, 0 if no material.
+		* @return Returns material id.
+		*/
+		uint32_t GetMaterialId(uint64_t key);
+
+		/**
+		* @brief Remove all packets.
+		*/
+		void Clear();
+
+		/**
+		* @brief Reserve packets.
+		* @param[in] count Number of packets.
+		*/
+		void Reserve(size_t count);
+
+		/**
+		* @brief Add a draw.
+		* @param[in] pass Pass or layer, lower draws first.
+		* @param[in] pipeline Pipeline id.
+		* @param[in] material Material id.
+		* @param[in] depth Distance to camera.
+		* @param[in] item Caller's index of the draw.
+		* @param[in] isBackToFront True for far to near, used by blended draws.
+		*/
+		void Add(
+			uint32_t  pass                  ,
+			uint32_t  pipeline              ,
+			uint32_t  material              ,
+			float     depth                 ,
+			uint32_t  item                  ,
+			bool      isBackToFront = false
+		);
+
+		/**
+		* @brief Sort packets by key.
+		* @param[in] threadPool Sort in parallel if not nullptr.
+		*/
+		void Sort(ThreadPool* threadPool = nullptr);
+
+		/**
+		* @brief Record sorted packets, skipping redundant binds.
+		* @param[in] bindPipeline Called with pipeline id when pipeline changes.
+		* @param[in] bindMaterial Called with material id when pipeline or material changes.
+		* @param[in] draw Called with packet for each draw.
+		*/
+		template<typename P, typename M, typename D>
+		void Record(P&& bindPipeline, M&& bindMaterial, D&& draw) const;
+
+		/**
+		* @brief Record a range of sorted packets, skipping redundant binds.
+		* State is bound again at range begin, so ranges can be recorded to different command buffers.
+		* @param[in] begin First sorted packet.
+		* @param[in] end One past last sorted packet.
+		* @param[in] bindPipeline Called with pipeline id when pipeline changes.
+		* @param[in] bindMaterial Called with material id when pipeline or material changes.
+		* @param[in] draw Called with packet for each draw.
+		*/
+		template<typename P, typename M, typename D>
+		void RecordRange(uint32_t begin, uint32_t end, P&& bindPipeline, M&& bindMaterial, D&& draw) const;
+
+		/**
+		* @brief Get number of packets.
+		* @return Returns number of packets.
+		*/
+		size_t GetCount() const { return m_Packets.size(); }
+
+		/**
+		* @brief Get sorted packet order.
+		* @return Returns packet indices in sorted order.
+		*/
+		const std::vector<uint32_t>& GetOrder() const { return m_Order; }
+
+		/**
+		* @brief Get packets in submission order.
+		* @return Returns packets.
+		*/
+		const std::vector<Packet>& GetPackets() const { return m_Packets; }
+
+		/**
+		* @brief Get statistics of last Sort.
+		* @return Returns statistics.
+		*/
+		const Stats& GetStats() const { return m_Stats; }
+
+	private:
+
+		/**
+		* @brief Count state changes of packets in an order.
+		* @param[in] order Packet indices, empty means submission order.
+		* @param[out] pipelineBinds Pipeline changes.
+		* @param[out] materialBinds Material changes.
+		*/
+		void CountBinds(const std::vector<uint32_t>* order, uint32_t& pipelineBinds, uint32_t& materialBinds) const;
+
+	private:
+
+		/**
+		* @brief Packets in submission order.
+		*/
+		std::vector<Packet> m_Packets;
+
+		/**
+		* @brief Keys, sorted after Sort.
+		*/
+		std::vector<uint64_t> m_Keys;
+
+		/**
+		* @brief Packet indices, sorted after Sort.
+		*/
+		std::vector<uint32_t> m_Order;
+
+		/**
+		* @brief Pipeline names by id.
+		*/
+		std::vector<std::string> m_PipelineNames;
+
+		/**
+		* @brief Pipeline name to id.
+		*/
+		std::unordered_map<std::string, uint32_t> m_PipelineIds;
+
+		/**
+		* @brief Material key to id.
+		*/
+		std::unordered_map<uint64_t, uint32_t> m_MaterialIds;
+
+		/**
+		* @brief Statistics of last Sort.
+		*/
+		Stats m_Stats;
+	};
+
+	template<typename P, typename M, typename D>
+	void DrawPacketList::Record(P&& bindPipeline, M&& bindMaterial, D&& draw) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		RecordRange(0, static_cast<uint32_t>(m_Order.size()), std::forward<P>(bindPipeline), std::forward<M>(bindMaterial), std::forward<D>(draw));
+	}
+
+	template<typename P, typename M, typename D>
+	void DrawPacketList::RecordRange(uint32_t begin, uint32_t end, P&& bindPipeline, M&& bindMaterial, D&& draw) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		uint32_t pipeline = ~0u;
+		uint32_t material = ~0u;
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			const Packet& packet = m_Packets[m_Order[i]];
+
+			if (packet.pipeline != pipeline)
+			{
+				pipeline = packet.pipeline;
+				material = ~0u;
+
+				bindPipeline(pipeline);
+			}
+
+			if (packet.material != material)
+			{
+				material = packet.material;
+
+				bindMaterial(material);
+			}
+
+			draw(packet);
+		}
+	}
+}
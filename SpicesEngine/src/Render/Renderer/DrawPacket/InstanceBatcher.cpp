@@ -0,0 +1,144 @@
+/**
+* @file InstanceBatcher.cpp.
+* @brief The InstanceBatcher Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "InstanceBatcher.h"
+
+namespace Spices {
+
+	InstanceBatcher::InstanceBatcher(uint32_t maxInstancesPerGroup)
+		: m_MaxInstancesPerGroup(std::max(maxInstancesPerGroup, 1u))
+	{
+		m_KeyIndices.emplace(&m_Arena);
+	}
+
+	uint32_t InstanceBatcher::MaxInstancesOfTasks(uint32_t maxTaskWorkGroupCountX, uint32_t nTasks)
+	{
+		return std::clamp(maxTaskWorkGroupCountX / std::max(nTasks, 1u), 1u, MaxInstancesPerGroup);
+	}
+
+	void InstanceBatcher::Clear()
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Map nodes live in m_Arena, destroy map before releasing them.
+		*/
+		m_KeyIndices.reset();
+		m_Arena     .Reset();
+		m_KeyIndices.emplace(&m_Arena);
+
+		m_Keys      .clear();
+		m_Entries   .clear();
+		m_Groups    .clear();
+		m_Instances .clear();
+
+		m_Stats = Stats{};
+	}
+
+	void InstanceBatcher::Reserve(size_t count)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Entries  .reserve(count);
+		m_Instances.reserve(count);
+	}
+
+	void InstanceBatcher::Add(
+		uint64_t          pack         ,
+		uint32_t          material     ,
+		uint32_t          item         ,
+		uint64_t          modelAddress ,
+		uint32_t          entityID     ,
+		float             depth        ,
+		uint32_t          maxInstances
+	)
+	{
+		const Key key{ pack, material };
+
+		auto it = m_KeyIndices->find(key);
+		if (it == m_KeyIndices->end())
+		{
+			it = m_KeyIndices->emplace(key, static_cast<uint32_t>(m_Keys.size())).first;
+			m_Keys.push_back({ key, item, std::clamp(maxInstances, 1u, m_MaxInstancesPerGroup) });
+		}
+
+		Entry entry;
+		entry.group                 = it->second;
+		entry.instance.modelAddress = modelAddress;
+		entry.instance.entityID     = entityID;
+		entry.instance.padding      = 0;
+		entry.depth                 = depth;
+
+		m_Entries.push_back(entry);
+	}
+
+	void InstanceBatcher::Build()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Groups   .clear();
+		m_Instances.resize(m_Entries.size());
+
+		std::pmr::memory_resource* resource = FrameAllocator::GetResource();
+
+		/**
+		* @brief Instances count of keys.
+		*/
+		std::pmr::vector<uint32_t> counts(m_Keys.size(), 0, resource);
+		for (const auto& entry : m_Entries)
+		{
+			counts[entry.group]++;
+		}
+
+		/**
+		* @brief First instance and first group of keys, a key is split into groups of at most its maxInstances.
+		*/
+		std::pmr::vector<uint32_t> offsets(m_Keys.size(), resource);
+		std::pmr::vector<uint32_t> firstGroups(m_Keys.size(), resource);
+
+		uint32_t instanceOffset = 0;
+		for (size_t k = 0; k < m_Keys.size(); k++)
+		{
+			offsets[k]     = instanceOffset;
+			firstGroups[k] = static_cast<uint32_t>(m_Groups.size());
+
+			const uint32_t maxInstances = m_Keys[k].maxInstances;
+
+			for (uint32_t first = 0; first < counts[k]; first += maxInstances)
+			{
+				Group group;
+				group.pack          = m_Keys[k].key.pack;
+				group.material      = m_Keys[k].key.material;
+				group.item          = m_Keys[k].item;
+				group.firstInstance = instanceOffset + first;
+				group.instanceCount = std::min(maxInstances, counts[k] - first);
+				group.depth         = std::numeric_limits<float>::max();
+
+				m_Groups.push_back(group);
+			}
+
+			instanceOffset += counts[k];
+		}
+
+		/**
+		* @brief Scatter instances by key, stable.
+		*/
+		std::pmr::vector<uint32_t> cursors(m_Keys.size(), 0, resource);
+		for (const auto& entry : m_Entries)
+		{
+			const uint32_t local = cursors[entry.group]++;
+
+			m_Instances[offsets[entry.group] + local] = entry.instance;
+
+			Group& group = m_Groups[firstGroups[entry.group] + local / m_Keys[entry.group].maxInstances];
+			group.depth  = std::min(group.depth, entry.depth);
+		}
+
+		m_Stats.instances = static_cast<uint32_t>(m_Entries.size());
+		m_Stats.groups    = static_cast<uint32_t>(m_Groups.size());
+	}
+}
@@ -0,0 +1,215 @@
+/**
+* @file InstanceBatcher.h.
+* @brief The InstanceBatcher Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "Core/Memory/FrameAllocator.h"
+#include "../../../../assets/Shaders/src/Header/ShaderCommon.h"
+
+#include <vector>
+#include <unordered_map>
+#include <optional>
+
+namespace Spices {
+
+	/**
+	* @brief Groups entities drawing the same mesh pack resource with the same material.
+	* Per instance model buffer address and entity id are packed contiguous by group into one array,
+	* so each group is drawn by one instanced draw or mesh task dispatch,
+	* and instances stay valid while entities move.
+	*/
+	class InstanceBatcher
+	{
+	public:
+
+		/**
+		* @brief Default maximum instances of a group, bound by maxTaskWorkGroupCount[1] of vkCmdDrawMeshTasksEXT.
+		*/
+		static constexpr uint32_t MaxInstancesPerGroup = 65535;
+
+		/**
+		* @brief Get maximum instances of a group drawn by one dgc mesh tasks command.
+		* Instances are dispatched in x with nTasks task groups each, so nTasks * instances must fit maxTaskWorkGroupCount[0].
+		* @param[in] maxTaskWorkGroupCountX Device limit maxTaskWorkGroupCount[0].
+		* @param[in] nTasks Task groups of a instance.
+		* @return Returns maximum instances of a group, at least 1.
+		*/
+		static uint32_t MaxInstancesOfTasks(uint32_t maxTaskWorkGroupCountX, uint32_t nTasks);
+
+		/**
+		* @brief One instanced draw.
+		*/
+		struct Group
+		{
+			uint64_t pack          = 0;      /* @brief Mesh pack resource key.                       */
+			uint32_t material      = 0;      /* @brief Material id.                                  */
+			uint32_t item          = 0;      /* @brief Caller's index of the first added instance.   */
+			uint32_t firstInstance = 0;      /* @brief First instance in instances array.            */
+			uint32_t instanceCount = 0;      /* @brief Number of instances.                          */
+			float    depth         = 0.0f;   /* @brief Nearest instance distance to camera.          */
+		};
+
+		/**
+		* @brief Statistics of last Build.
+		*/
+		struct Stats
+		{
+			uint32_t instances = 0;   /* @brief Number of added instances.            */
+			uint32_t groups    = 0;   /* @brief Number of draws after batching.       */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] maxInstancesPerGroup Groups larger than this are split.
+		*/
+		InstanceBatcher(uint32_t maxInstancesPerGroup = MaxInstancesPerGroup);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~InstanceBatcher() = default;
+
+		/**
+		* @brief Remove all instances and groups.
+		*/
+		void Clear();
+
+		/**
+		* @brief Reserve instances.
+		* @param[in] count Number of instances.
+		*/
+		void Reserve(size_t count);
+
+		/**
+		* @brief Add an instance.
+		* @param[in] pack Mesh pack resource key, same for packs sharing resources.
+		* @param[in] material Material id.
+		* @param[in] item Caller's index of the draw, the first one of a group is kept.
+		* @param[in] modelAddress Address of model matrix buffer.
+		* @param[in] entityID Entity id.
+		* @param[in] depth Distance to camera.
+		* @param[in] maxInstances Maximum instances of groups of this pack, the first added one of a key is kept.
+		*/
+		void Add(
+			uint64_t          pack                                 ,
+			uint32_t          material                             ,
+			uint32_t          item                                 ,
+			uint64_t          modelAddress                         ,
+			uint32_t          entityID                             ,
+			float             depth                                ,
+			uint32_t          maxInstances = MaxInstancesPerGroup
+		);
+
+		/**
+		* @brief Build groups and instances array.
+		* Groups keep the order of their first instance, instances keep submission order in a group.
+		*/
+		void Build();
+
+		/**
+		* @brief Get groups.
+		* @return Returns groups built.
+		*/
+		const std::vector<Group>& GetGroups() const { return m_Groups; }
+
+		/**
+		* @brief Get instances array.
+		* @return Returns instances ordered by group.
+		*/
+		const std::vector<SpicesShader::MeshInstance>& GetInstances() const { return m_Instances; }
+
+		/**
+		* @brief Get statistics of last Build.
+		* @return Returns statistics.
+		*/
+		const Stats& GetStats() const { return m_Stats; }
+
+	private:
+
+		/**
+		* @brief Group key.
+		*/
+		struct Key
+		{
+			uint64_t pack;
+			uint32_t material;
+
+			bool operator==(const Key& other) const { return pack == other.pack && material == other.material; }
+		};
+
+		/**
+		* @brief Group key hash.
+		*/
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const { return std::hash<uint64_t>()(key.pack ^ (static_cast<uint64_t>(key.material) << 48 | key.material)); }
+		};
+
+		/**
+		* @brief Key info.
+		*/
+		struct KeyInfo
+		{
+			Key      key;                            /* @brief Key.                                */
+			uint32_t item;                           /* @brief First item.                         */
+			uint32_t maxInstances;                   /* @brief Maximum instances of a group.       */
+		};
+
+		/**
+		* @brief Added instance.
+		*/
+		struct Entry
+		{
+			uint32_t group;                          /* @brief Key index.    */
+			SpicesShader::MeshInstance instance;     /* @brief Instance.     */
+			float    depth;                          /* @brief Depth.        */
+		};
+
+	private:
+
+		/**
+		* @brief Maximum instances of a group.
+		*/
+		uint32_t m_MaxInstancesPerGroup;
+
+		/**
+		* @brief Arena of m_KeyIndices nodes, reset by Clear.
+		*/
+		LinearArena m_Arena;
+
+		/**
+		* @brief Key to key index, recreated on m_Arena by Clear.
+		*/
+		std::optional<std::pmr::unordered_map<Key, uint32_t, KeyHash>> m_KeyIndices;
+
+		/**
+		* @brief Keys info by key index.
+		*/
+		std::vector<KeyInfo> m_Keys;
+
+		/**
+		* @brief Instances in submission order.
+		*/
+		std::vector<Entry> m_Entries;
+
+		/**
+		* @brief Groups built.
+		*/
+		std::vector<Group> m_Groups;
+
+		/**
+		* @brief Instances ordered by group.
+		*/
+		std::vector<SpicesShader::MeshInstance> m_Instances;
+
+		/**
+		* @brief Statistics of last Build.
+		*/
+		Stats m_Stats;
+	};
+}
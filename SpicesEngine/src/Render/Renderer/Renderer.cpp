@@ -31,16 +31,45 @@ namespace Spices {
 		, m_RendererName            (rendererName          )
 	    , m_IsLoadDefaultMaterial   (isLoadDefaultMaterial )
 		, m_IsRegistryDGCPipeline   (isRegistryDGCPipeline )
-	{}
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Cached secondaries are allocated from graphic command pool, which is created with reset bit.
+		*/
+		m_CmdCache = std::make_unique<SecondaryCmdCache>(
+			[&]() {
+				VkCommandBufferAllocateInfo       allocInfo{};
+				allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				allocInfo.level                 = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+				allocInfo.commandPool           = m_VulkanState.m_GraphicCommandPool;
+				allocInfo.commandBufferCount    = 1;
+
+				VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+				VK_CHECK(vkAllocateCommandBuffers(m_VulkanState.m_Device, &allocInfo, &cmdBuffer))
+
+				return cmdBuffer;
+			},
+			[&](VkCommandBuffer cmdBuffer) {
+				vkFreeCommandBuffers(m_VulkanState.m_Device, m_VulkanState.m_GraphicCommandPool, 1, &cmdBuffer);
+			}
+		);
+	}
 
 	void Renderer::OnSystemInitialize()
 	{
 		SPICES_PROFILE_ZONE;
 
+		/**
+		* @brief Drop cached secondaries.
+		*/
+		InvalidateCmdCache();
+
 		/**
 		* @brief Create renderpass.
 		*/
 		CreateRendererPass();
+		CacheSubPassNames();
 
 		/**
 		* @brief Create specific renderer descriptorset.
@@ -65,10 +94,16 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
+		/**
+		* @brief Drop cached secondaries.
+		*/
+		InvalidateCmdCache();
+
 		/**
 		* @brief Recreate RenderPass.
 		*/
 		CreateRendererPass();
+		CacheSubPassNames();
 
 		/**
 		* @brief Create descriptorSet again.
@@ -76,6 +111,37 @@ namespace Spices {
 		CreateDescriptorSet();
 	}
 
+	void Renderer::InvalidateCmdCache() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_CmdCache->Invalidate();
+	}
+
+	void Renderer::CacheSubPassNames()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Pass->GetSubPasses().for_each([&](const std::string& name, const std::shared_ptr<RendererSubPass>& subPass) {
+
+			if (m_SubPassNames.find(name) != m_SubPassNames.end()) return false;
+
+			SubPassNames names;
+			names.key         = m_RendererName + "." + name;
+			names.pipeline    = names.key + ".Default";
+			names.dgcPipeline = names.pipeline + ".DGC";
+
+			m_SubPassNames.emplace(name, std::move(names));
+
+			return false;
+		});
+	}
+
+	const Renderer::SubPassNames& Renderer::GetSubPassNames(const std::string& subpassName) const
+	{
+		return m_SubPassNames.at(subpassName);
+	}
+
 	void Renderer::RegistryMaterial(const std::string& materialName, const std::string& subpassName)
 	{
 		SPICES_PROFILE_ZONE;
@@ -191,6 +257,212 @@ namespace Spices {
 		m_Pipelines[ss.str()] = CreateDGCPipeline(ss.str(), materialName, pipelinelayout, subPass);
 	}
 
+	void Renderer::FillIndirectRenderData(const std::string& subpassName, const std::vector<DGCDraw>& draws)
+	{
+		SPICES_PROFILE_ZONE;
+
+		auto indirectPtr = m_IndirectData[subpassName];
+		auto& sequences  = indirectPtr->GetSequences(static_cast<uint32_t>(m_Device->GetDGCProperties().minIndirectCommandsBufferOffsetAlignment));
+
+		/**
+		* @brief Prepare ShaderGroup, group indices are kept so existing sequences stay valid.
+		*/
+		bool pipelinesChanged = false;
+		{
+			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Prepare ShaderGroup");
+
+			auto& shaderGroups = m_ShaderGroups[subpassName];
+
+			for (const auto& draw : draws)
+			{
+				auto it = shaderGroups.find(draw.pack->GetMaterial()->GetName());
+				if (it == shaderGroups.end())
+				{
+					it = shaderGroups.emplace(draw.pack->GetMaterial()->GetName(), static_cast<uint32_t>(shaderGroups.size())).first;
+					pipelinesChanged = true;
+				}
+
+				draw.pack->SetShaderGroupHandle(it->second);
+			}
+
+			auto& pipelinesRef = m_PipelinesRef[subpassName];
+			pipelinesRef.resize(shaderGroups.size(), VK_NULL_HANDLE);
+
+			for (auto& pair : shaderGroups)
+			{
+				const VkPipeline pipeline = m_Pipelines[pair.first]->GetPipeline();
+				if (pipelinesRef[pair.second] != pipeline)
+				{
+					pipelinesRef[pair.second] = pipeline;
+					pipelinesChanged = true;
+				}
+			}
+		}
+
+		/**
+		* @brief Patch Sequences, only changed tokens are marked dirty.
+		*/
+		{
+			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Patch Sequences");
+
+			auto& layoutTokens = indirectPtr->GetLayoutTokens();
+
+			sequences.BeginSync();
+
+			for (const auto& draw : draws)
+			{
+				const auto& v = draw.pack;
+
+				const uint32_t slot = sequences.Acquire(draw.key);
+
+				for (uint32_t i = 0; i < layoutTokens.size(); i++)
+				{
+					VkBindShaderGroupIndirectCommandNV  shader{};
+					VkBindVertexBufferIndirectCommandNV vbo{};
+					VkBindIndexBufferIndirectCommandNV  ibo{};
+					VkDeviceAddress                     push{};
+					VkDrawIndexedIndirectCommand        drawIndexed{};
+					VkDrawMeshTasksIndirectCommandNV    drawMesh{};
+
+					switch (layoutTokens[i].tokenType)
+					{
+					case VK_INDIRECT_COMMANDS_TOKEN_TYPE_SHADER_GROUP_NV:
+						shader.groupIndex = v->GetShaderGroupHandle() + 1;
+						sequences.SetToken(slot, i, &shader);
+						break;
+
+					case VK_INDIRECT_COMMANDS_TOKEN_TYPE_VERTEX_BUFFER_NV:
+						vbo.bufferAddress = v->GetResource().positions.buffer->GetAddress();
+						vbo.size          = sizeof(v->GetResource().positions.attributes);
+						vbo.stride        = sizeof(glm::vec3);
+						sequences.SetToken(slot, i, &vbo);
+						break;
+
+					case VK_INDIRECT_COMMANDS_TOKEN_TYPE_INDEX_BUFFER_NV:
+						ibo.bufferAddress = v->GetResource().primitivePoints.buffer->GetAddress();
+						ibo.size          = sizeof(v->GetResource().primitivePoints.attributes);
+						ibo.indexType     = VK_INDEX_TYPE_UINT32;
+						sequences.SetToken(slot, i, &ibo);
+						break;
+
+					case VK_INDIRECT_COMMANDS_TOKEN_TYPE_PUSH_CONSTANT_NV:
+						push              = draw.descAddress;
+						sequences.SetToken(slot, i, &push);
+						break;
+
+					case VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_INDEXED_NV:
+						drawIndexed.firstIndex     = 0;
+						drawIndexed.firstInstance  = 0;
+						drawIndexed.indexCount     = v->GetResource().primitivePoints.attributes->size();
+						drawIndexed.instanceCount  = draw.instanceCount;
+						drawIndexed.vertexOffset   = 0;
+						sequences.SetToken(slot, i, &drawIndexed);
+						break;
+
+					case VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_TASKS_NV:
+
+						/**
+						* @brief Instances are dispatched in x, callers clamp instanceCount by InstanceBatcher::MaxInstancesOfTasks.
+						*/
+						drawMesh            = v->GetDrawCommand();
+						drawMesh.taskCount *= draw.instanceCount;
+						sequences.SetToken(slot, i, &drawMesh);
+						break;
+
+					default:
+						SPICES_CORE_ERROR("Not Supported Token Type.");
+						break;
+					}
+				}
+			}
+
+			sequences.EndSync();
+
+			indirectPtr->SetSequenceCount(sequences.GetSequenceCount());
+		}
+
+		/**
+		* @brief Upload changed sequences, Fill in Streams if input buffer recreated.
+		*/
+		const bool inputRecreated = sequences.Commit();
+		if (inputRecreated)
+		{
+			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Fill in Streams");
+
+			const auto& offset = sequences.GetStreamOffsets();
+
+			std::vector<VkIndirectCommandsStreamNV> inputs;
+			inputs.resize(offset.size());
+			for (int i = 0; i < offset.size(); i++)
+			{
+				inputs[i].buffer = indirectPtr->GetInputBuffer()->Get();
+				inputs[i].offset = offset[i];
+			}
+			indirectPtr->SetInputStreams(inputs);
+		}
+
+		/**
+		* @brief Regenerate dgc pipeline only if its shader groups changed.
+		*/
+		if (pipelinesChanged)
+		{
+			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Regenerate dgc pipeline");
+
+			CreateDefaultMaterial();
+		}
+
+		/**
+		* @brief Create ProcessBuffer, sized for capacity so it follows input buffer growth.
+		*/
+		if (inputRecreated || pipelinesChanged)
+		{
+			SPICES_PROFILE_ZONEN("FillIndirectRenderData:: Create ProcessBuffer");
+
+			VkGeneratedCommandsMemoryRequirementsInfoNV     memInfo{};
+			memInfo.sType                                 = VK_STRUCTURE_TYPE_GENERATED_COMMANDS_MEMORY_REQUIREMENTS_INFO_NV;
+			memInfo.maxSequencesCount                     = sequences.GetCapacity();
+			memInfo.indirectCommandsLayout                = indirectPtr->GetCommandLayout();
+			memInfo.pipeline                              = m_Pipelines["BasePassRenderer.Mesh.Default.DGC"]->GetPipeline();
+			memInfo.pipelineBindPoint                     = VK_PIPELINE_BIND_POINT_GRAPHICS;
+
+			VkMemoryRequirements2                           memReqs{};
+			memReqs.sType                                 = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+
+			m_VulkanState.m_VkFunc.vkGetGeneratedCommandsMemoryRequirementsNV(m_VulkanState.m_Device, &memInfo, &memReqs);
+
+			indirectPtr->SetPreprocessSize(memReqs.memoryRequirements.size);
+			indirectPtr->CreatePreprocessBuffer(memReqs.memoryRequirements.size);
+
+			/**
+			* @brief Cached secondaries reference the old buffers and pipeline.
+			*/
+			InvalidateCmdCache();
+		}
+	}
+
+	void Renderer::SetIndirectSequenceOrder(const std::string& subpassName, uint32_t frameIndex, const std::vector<uint64_t>& keys)
+	{
+		SPICES_PROFILE_ZONE;
+
+		auto indirectPtr = m_IndirectData[subpassName];
+		auto& sequences  = indirectPtr->GetSequences(static_cast<uint32_t>(m_Device->GetDGCProperties().minIndirectCommandsBufferOffsetAlignment));
+
+		/**
+		* @brief Map keys to slots, slots move on Release so they are resolved every frame.
+		*/
+		std::vector<uint32_t> slots;
+		slots.reserve(keys.size());
+		for (const uint64_t key : keys)
+		{
+			const uint32_t slot = sequences.GetSlot(key);
+			if (slot == UINT32_MAX) continue;
+
+			slots.push_back(slot);
+		}
+
+		indirectPtr->SetSequenceOrder(frameIndex, slots);
+	}
+
 	std::shared_ptr<Material> Renderer::GetDefaultMaterial(const std::string& subpassName) const
 	{
 		SPICES_PROFILE_ZONE;
@@ -486,7 +758,7 @@ namespace Spices {
 		});
 	}
 
-	void Renderer::GetPointLight(FrameInfo& frameInfo, std::array<SpicesShader::PointLight, POINTLIGHT_BUFFER_MAXNUM>& pLightBuffer)
+	uint32_t Renderer::GetPointLight(FrameInfo& frameInfo, std::array<SpicesShader::PointLight, POINTLIGHT_BUFFER_MAXNUM>& pLightBuffer)
 	{
 		SPICES_PROFILE_ZONE;
 
@@ -506,15 +778,36 @@ namespace Spices {
 			pointLight.position = transComp.GetPosition();
 			pLightBuffer[index] = pointLight;
 			index++;
-			return false;
+
+			/**
+			* @brief Keep the last element for the end mark.
+			*/
+			return index >= POINTLIGHT_BUFFER_MAXNUM - 1;
 		});
 
 		/**
 		* @brief End of PointLightBuffer.
 		*/
 		pLightBuffer[index].intensity = -1000.0f;
+
+		return static_cast<uint32_t>(index);
 	}
 	
+	Renderer::RenderBehaveBuilder::~RenderBehaveBuilder()
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief One flush per buffer per frame, after all updates of this pass.
+		*/
+		if (!m_Renderer->m_Pass) return;
+
+		m_Renderer->m_Pass->GetSubPasses().for_each([](const std::string& name, const std::shared_ptr<RendererSubPass>& subPass) {
+			subPass->FlushBuffers();
+			return false;
+		});
+	}
+
 	void Renderer::RenderBehaveBuilder::Recording(const std::string& caption)
 	{
 		SPICES_PROFILE_ZONE;
@@ -547,6 +840,70 @@ namespace Spices {
 		});
 	}
 
+	uint64_t Renderer::RenderBehaveBuilder::HashPassState(uint64_t contentHash) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Viewport is recorded by func as dynamic state, hash its size as well.
+		*/
+		ContentHash hash;
+		hash.Add(contentHash);
+		hash.Add(m_Renderer->m_Pass->Get());
+		hash.Add(m_SubpassIndex);
+		hash.Add(m_Renderer->m_Device->GetSwapChainSupport().surfaceSize);
+
+		if (SlateSystem::GetRegister())
+		{
+			const ImVec2 viewPortSize = SlateSystem::GetRegister()->GetViewPort()->GetPanelSize();
+
+			hash.Add(viewPortSize.x);
+			hash.Add(viewPortSize.y);
+		}
+
+		return hash.Get();
+	}
+
+	void Renderer::RenderBehaveBuilder::BeginCachedSecondary(VkCommandBuffer cmdBuffer) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Framebuffer is left unknown, so the secondary is valid for all swapchain images.
+		*/
+		VkCommandBufferInheritanceInfo         inheritanceInfo {};
+		inheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.renderPass           = m_Renderer->m_Pass->Get();
+		inheritanceInfo.subpass              = m_SubpassIndex;
+		inheritanceInfo.framebuffer          = VK_NULL_HANDLE;
+
+		VkCommandBufferBeginInfo               cmdBufferBeginInfo {};
+		cmdBufferBeginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmdBufferBeginInfo.flags             = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		cmdBufferBeginInfo.pInheritanceInfo  = &inheritanceInfo;
+
+		VK_CHECK(vkBeginCommandBuffer(cmdBuffer, &cmdBufferBeginInfo))
+	}
+
+	void Renderer::RenderBehaveBuilder::HashDGC(ContentHash& hash) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).dgcPipeline;
+
+		const auto& input      = m_HandledIndirectData->GetInputBuffer();
+		const auto& preprocess = m_HandledIndirectData->GetPreprocessBuffer();
+		const auto& index      = m_HandledIndirectData->GetSequencesIndexBuffer();
+
+		hash.Add(m_Renderer->m_Pipelines[name]->GetPipeline());
+		hash.Add(m_HandledIndirectData->GetCommandLayout());
+		hash.Add(m_HandledIndirectData->GetSequenceCount());
+		hash.Add(input      ? input     ->Get() : VK_NULL_HANDLE);
+		hash.Add(preprocess ? preprocess->Get() : VK_NULL_HANDLE);
+		hash.Add(index      ? index     ->Get() : VK_NULL_HANDLE);
+		hash.Add(m_HandledIndirectData->GetOrderedCount());
+	}
+
 	void Renderer::RenderBehaveBuilder::BindPipeline(const std::string& materialName, VkCommandBuffer cmdBuffer, VkPipelineBindPoint  bindPoint)
 	{
 		SPICES_PROFILE_ZONE;
@@ -937,10 +1294,7 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default";
-
-		BindDescriptorSet(infos, ss.str(), cmdBuffer, bindPoint);
+		BindDescriptorSet(infos, m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).pipeline, cmdBuffer, bindPoint);
 	}
 
 	void Renderer::RenderBehaveBuilder::BindDescriptorSet(
@@ -974,10 +1328,7 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default";
-
-		BindDescriptorSetAsync(infos, ss.str(), bindPoint);
+		BindDescriptorSetAsync(infos, m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).pipeline, bindPoint);
 	}
 
 	void Renderer::RenderBehaveBuilder::BindDescriptorSetAsync(
@@ -1049,27 +1400,25 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default.DGC";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).dgcPipeline;
 
 		/**
 		* @brief Call vkCmdPreprocessGeneratedCommandsNV.
 		*/
-		m_HandledIndirectData->PreprocessDGC(cmdBuffer ? cmdBuffer : m_CommandBuffer, m_Renderer->m_Pipelines[ss.str()]->GetPipeline());
+		m_HandledIndirectData->PreprocessDGC(cmdBuffer ? cmdBuffer : m_CommandBuffer, m_Renderer->m_Pipelines[name]->GetPipeline());
 	}
 
 	void Renderer::RenderBehaveBuilder::PreprocessDGCAsync_NV()
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default.DGC";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).dgcPipeline;
 
 		/**
 		* @brief Call vkCmdPreprocessGeneratedCommandsNV.
 		*/
 		m_Renderer->SubmitCmdsParallel(m_CommandBuffer, m_SubpassIndex, [&](VkCommandBuffer& cmdBuffer) {
-			m_HandledIndirectData->PreprocessDGC(cmdBuffer, m_Renderer->m_Pipelines[ss.str()]->GetPipeline());
+			m_HandledIndirectData->PreprocessDGC(cmdBuffer, m_Renderer->m_Pipelines[name]->GetPipeline());
 		});
 	}
 
@@ -1077,27 +1426,25 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default.DGC";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).dgcPipeline;
 
 		/**
 		* @brief Call vkCmdExecuteGeneratedCommandsNV.
 		*/
-		m_HandledIndirectData->ExecuteDGC(cmdBuffer ? cmdBuffer : m_CommandBuffer, m_Renderer->m_Pipelines[ss.str()]->GetPipeline());
+		m_HandledIndirectData->ExecuteDGC(cmdBuffer ? cmdBuffer : m_CommandBuffer, m_Renderer->m_Pipelines[name]->GetPipeline());
 	}
 
 	void Renderer::RenderBehaveBuilder::ExecuteDGCAsync_NV()
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default.DGC";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).dgcPipeline;
 
 		/**
 		* @brief Call vkCmdExecuteGeneratedCommandsNV.
 		*/
 		m_Renderer->SubmitCmdsParallel(m_CommandBuffer, m_SubpassIndex, [&](VkCommandBuffer& cmdBuffer) {
-			m_HandledIndirectData->ExecuteDGC(cmdBuffer, m_Renderer->m_Pipelines[ss.str()]->GetPipeline());
+			m_HandledIndirectData->ExecuteDGC(cmdBuffer, m_Renderer->m_Pipelines[name]->GetPipeline());
 		});
 	}
 
@@ -1348,6 +1695,8 @@ namespace Spices {
 			imageInfo->imageLayout                   = VK_IMAGE_LAYOUT_GENERAL;
 
 			m_ImageInfos[set][binding].push_back(*imageInfo);
+
+			RecordTexture(textureNames[i], RenderGraph::AccessType::StorageTexture, stageFlags, true);
 		}
 
 		/**
@@ -1378,6 +1727,8 @@ namespace Spices {
 			const auto info = m_Renderer->m_RendererResourcePool->AccessResource(resinfo);
 
 			m_ImageInfos[set][binding].push_back(*info);
+
+			RecordTexture(textureNames[i], RenderGraph::AccessType::SampledTexture, stageFlags, false);
 		}
 
 		const auto descriptorSet = DescriptorSetManager::Registry(m_DescriptorSetId, set);
@@ -1405,6 +1756,8 @@ namespace Spices {
 			const auto info = m_Renderer->m_RendererResourcePool->AccessResource(resinfo);
 
 			m_ImageInfos[set][binding].push_back(*info);
+
+			RecordTexture(inputAttachmentNames[i], RenderGraph::AccessType::InputAttachment, stageFlags, false);
 		}
 
 		const auto descriptorSet = DescriptorSetManager::Registry(m_DescriptorSetId, set);
@@ -1461,6 +1814,23 @@ namespace Spices {
 		}
 	}
 
+	void Renderer::DescriptorSetBuilder::RecordTexture(
+		const std::string&       textureName ,
+		RenderGraph::AccessType  type        ,
+		VkShaderStageFlags       stageFlags  ,
+		bool                     isWrite
+	) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		RenderGraph& graph = m_Renderer->m_RendererResourcePool->GetRenderGraph();
+
+		const uint32_t pass     = graph.AddPass(m_Renderer->m_RendererName + "." + m_HandledSubPass->GetName());
+		const uint32_t resource = graph.AddResource(textureName);
+
+		graph.Access(pass, resource, type, true, isWrite, RenderGraph::ToPipelineStages(stageFlags));
+	}
+
 	Renderer::RendererPassBuilder::RendererPassBuilder(const std::string& rendererPassName, Renderer* renderer)
 		: m_RendererPassName(rendererPassName)
 		, m_Renderer(renderer)
@@ -1477,6 +1847,11 @@ namespace Spices {
 		const size_t size = m_Renderer->m_Pass->GetSubPasses().size();
 		m_HandledRendererSubPass = m_Renderer->m_Pass->AddSubPass(subPassName, static_cast<uint32_t>(size));
 
+		/**
+		* @brief Sub passes are added in execution order.
+		*/
+		m_GraphPass = m_Renderer->m_RendererResourcePool->GetRenderGraph().AddPass(m_Renderer->m_RendererName + "." + subPassName);
+
 		return *this;
 	}
 
@@ -1495,6 +1870,28 @@ namespace Spices {
 		return *this;
 	}
 
+	void Renderer::RendererPassBuilder::RecordAttachment(
+		const std::string&              attachmentName ,
+		RenderGraph::AccessType         type           ,
+		const VkAttachmentDescription&  description    ,
+		bool                            isEnableBlend
+	) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		RenderGraph& graph = m_Renderer->m_RendererResourcePool->GetRenderGraph();
+
+		const uint32_t resource = graph.AddResource(attachmentName);
+
+		/**
+		* @brief Loaded or blended attachment reads content, input attachment only reads.
+		*/
+		const bool isInput = type == RenderGraph::AccessType::InputAttachment;
+		const bool isRead  = isInput || isEnableBlend || description.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD;
+
+		graph.Access(m_GraphPass, resource, type, isRead, !isInput);
+	}
+
 	Renderer::RendererPassBuilder& Renderer::RendererPassBuilder::EndSubPass()
 	{
 		SPICES_PROFILE_ZONE;
@@ -1813,13 +2210,35 @@ namespace Spices {
 		return *this;
 	}
 
+	Renderer::DGCLayoutBuilder& Renderer::DGCLayoutBuilder::KeepSequenceOrder()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_IsOrdered = true;
+
+		return *this;
+	}
+
+	Renderer::DGCLayoutBuilder& Renderer::DGCLayoutBuilder::IndexSequences()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_IsIndexed = true;
+
+		return *this;
+	}
+
 	void Renderer::DGCLayoutBuilder::Build()
 	{
 		SPICES_PROFILE_ZONE;
 
+		VkIndirectCommandsLayoutUsageFlagsNV flags = 0;
+		flags |= m_IsOrdered ? 0 : VK_INDIRECT_COMMANDS_LAYOUT_USAGE_UNORDERED_SEQUENCES_BIT_NV;
+		flags |= m_IsIndexed ? VK_INDIRECT_COMMANDS_LAYOUT_USAGE_INDEXED_SEQUENCES_BIT_NV : 0;
+
 		/**
 		* @brief Create IndirectCommandsLayout.
 		*/
-		m_HandledIndirectData->BuildCommandLayout(m_InputInfos);
+		m_HandledIndirectData->BuildCommandLayout(m_InputInfos, flags);
 	}
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "DescriptorSetManager/DescriptorSetManager.h"
 #include "Render/Renderer/RendererPass/RendererPass.h"
 #include "Render/Vulkan/VulkanCmdThreadPool.h"
+#include "Render/RenderGraph/RenderGraph.h"
 #include "..\..\..\assets\Shaders\src\Header\ShaderCommon.h"
 #include "Debugger/Aftermath/NsightAftermathGpuCrashTracker.h"
 #include "Debugger/Perf/NsightPerfGPUProfilerReportGenerator.h"
@@ -26,6 +27,7 @@
 #include "Render/Vulkan/VulkanDescriptor.h"
 #include "Render/Vulkan/VulkanRenderPass.h"
 #include "Render/Vulkan/VulkanIndirectDrawNV.h"
+#include "Render/Vulkan/SecondaryCmdCache.h"
 /***************************************************************************************************/
 
 /******************************World Component Header***********************************************/
@@ -143,6 +145,18 @@ namespace Spices {
 		*/
 		virtual void OnMeshAddedWorld() {}
 
+		/**
+		* @brief Drop all cached secondary command buffers of this renderer.
+		* Called on world changed and on resize.
+		*/
+		void InvalidateCmdCache() const;
+
+		/**
+		* @brief Get cached secondary command buffers of this renderer.
+		* @return Returns SecondaryCmdCache.
+		*/
+		SecondaryCmdCache& GetCmdCache() const { return *m_CmdCache; }
+
 		/**
 		* @brief Registry material to Specific Renderer.
 		* @param[in] materialName Material Name.
@@ -164,13 +178,41 @@ namespace Spices {
 		);
 
 		/**
-		* @brief Fill in World Renderable data to IndirectBuffer.
+		* @brief A draw written to a DGC sequence.
+		*/
+		struct DGCDraw
+		{
+			uint64_t                  key;             /* @brief Sequence key, @see DGCSequenceTable::MakeKey. */
+			std::shared_ptr<MeshPack> pack;            /* @brief MeshPack drawn.                                */
+			VkDeviceAddress           descAddress;     /* @brief Address of MeshDesc pushed.                    */
+			uint32_t                  instanceCount;   /* @brief Num of instances drawn.                        */
+		};
+
+		/**
+		* @brief Fill in World Renderable data to IndirectBuffer, a draw per meshpack of entity.
 		* @tparam T Specific Component.
 		* @param[in] subpassName .
 		*/
 		template<typename T>
 		void FillIndirectRenderData(const std::string& subpassName);
 
+		/**
+		* @brief Fill in draws to IndirectBuffer, a sequence per draw key.
+		* Mesh tasks of instances are unrolled in task count, as dgc mesh tasks draws are one dimension.
+		* @param[in] subpassName .
+		* @param[in] draws Draws.
+		*/
+		void FillIndirectRenderData(const std::string& subpassName, const std::vector<DGCDraw>& draws);
+
+		/**
+		* @brief Set the order sequences of a subpass are executed in this frame, for layouts built with IndexSequences.
+		* Sequences keep their slots, only the index buffer of this frame is written.
+		* @param[in] subpassName .
+		* @param[in] frameIndex Frame in flight index.
+		* @param[in] keys Sequence keys in execution order, keys without a sequence are skipped.
+		*/
+		void SetIndirectSequenceOrder(const std::string& subpassName, uint32_t frameIndex, const std::vector<uint64_t>& keys);
+
 		/**
 		* @brief Get RendererPass.
 		* @return Returns the RendererPass.
@@ -209,6 +251,11 @@ namespace Spices {
 		*/
 		void CreateDefaultMaterial();
 
+		/**
+		* @brief Cache names of all sub pass, called after CreateRendererPass().
+		*/
+		void CacheSubPassNames();
+
 		/**
 		* @brief Create Pipeline Layout with material's descriptorset and renderer's descriptor set.
 		* @param[in] rowSetLayouts All descriptor set collected.
@@ -252,6 +299,23 @@ namespace Spices {
 
 		/******************************Renderer Help Function**********************************************/
 
+		/**
+		* @brief Names built from renderer name and sub pass name.
+		*/
+		struct SubPassNames
+		{
+			std::string key;           /* @brief Renderer.SubPass.                   */
+			std::string pipeline;      /* @brief Renderer.SubPass.Default.           */
+			std::string dgcPipeline;   /* @brief Renderer.SubPass.Default.DGC.       */
+		};
+
+		/**
+		* @brief Get cached names of a sub pass, no allocation during frame.
+		* @param[in] subpassName sub pass Name.
+		* @return Returns SubPassNames.
+		*/
+		const SubPassNames& GetSubPassNames(const std::string& subpassName) const;
+
 		/**
 		* @brief Submit a group of commands to secondary command buffer, and execute all of them.
 		* @param[in] primaryCmdBuffer The main Command Buffer.
@@ -262,14 +326,14 @@ namespace Spices {
 		void SubmitCmdsParallel(VkCommandBuffer primaryCmdBuffer, uint32_t subpass, F&& func);
 
 		/**
-		* @brief Iterator the specific Component in World Parallel.
-		* @tparam T The specific Component class.
-		* @param[in] frameInfo The current frame data.
+		* @brief Split a list into ranges recorded to secondary command buffers in parallel, and execute them in list order.
+		* @param[in] primaryCmdBuffer The main Command Buffer.
 		* @param[in] subpass subpass index.
-		* @param[in] func The function pointer that need to execute during this function.
+		* @param[in] count Items count.
+		* @param func Specific Commands, called with cmdBuffer, first item and one past last item.
 		*/
-		template<typename T, typename F>
-		inline void IterWorldCompSubmitCmdParallel(FrameInfo& frameInfo, uint32_t subpass, F func);
+		template<typename F>
+		void SubmitCmdsParallel(VkCommandBuffer primaryCmdBuffer, uint32_t subpass, uint32_t count, F&& func);
 
 		/**
 		* @brief Iterator the specific Component in World With break.
@@ -301,9 +365,10 @@ namespace Spices {
 		* @brief Get PointLightComponent's render data in World.
 		* @param[in] frameInfo The current frame data.
 		* @param[out] pLightBuffer PointLight Buffer.
+		* @return Returns the number of PointLight.
 		* @todo infinity pointlight.
 		*/
-		void GetPointLight(FrameInfo& frameInfo, std::array<SpicesShader::PointLight, POINTLIGHT_BUFFER_MAXNUM>& pLightBuffer);
+		uint32_t GetPointLight(FrameInfo& frameInfo, std::array<SpicesShader::PointLight, POINTLIGHT_BUFFER_MAXNUM>& pLightBuffer);
 
 		/***************************************************************************************************/
 
@@ -416,6 +481,22 @@ namespace Spices {
 			*/
 			void Build() const;
 
+		private:
+
+			/**
+			* @brief Record handled sub pass access to an attachment in RenderGraph.
+			* @param[in] attachmentName Attachment Name.
+			* @param[in] type Access type.
+			* @param[in] description VkAttachmentDescription.
+			* @param[in] isEnableBlend True if This Attachment is blend with content.
+			*/
+			void RecordAttachment(
+				const std::string&              attachmentName          ,
+				RenderGraph::AccessType         type                    ,
+				const VkAttachmentDescription&  description             ,
+				bool                            isEnableBlend = false
+			) const;
+
 		private:
 
 			/**
@@ -433,6 +514,11 @@ namespace Spices {
 			* @brief Handled Sub pass.
 			*/
 			std::shared_ptr<RendererSubPass> m_HandledRendererSubPass;
+
+			/**
+			* @brief Handled Sub pass index in RenderGraph.
+			*/
+			uint32_t m_GraphPass = RenderGraph::Invalid;
 		};
 
 		/**
@@ -612,6 +698,22 @@ namespace Spices {
 			*/
 			void Build(const VkAccelerationStructureKHR& accel = VK_NULL_HANDLE);
 
+		private:
+
+			/**
+			* @brief Record handled sub pass access to a texture in RenderGraph.
+			* @param[in] textureName Texture Name.
+			* @param[in] type Access type.
+			* @param[in] stageFlags Which shader stage access the texture.
+			* @param[in] isWrite True if the texture is written.
+			*/
+			void RecordTexture(
+				const std::string&       textureName ,
+				RenderGraph::AccessType  type        ,
+				VkShaderStageFlags       stageFlags  ,
+				bool                     isWrite
+			) const;
+
 		public:
 
 			/**
@@ -702,6 +804,20 @@ namespace Spices {
 			*/
 			DGCLayoutBuilder& AddDrawMeshTaskInput();
 
+			/**
+			* @brief Execute sequences in order, used by sequences sorted by state.
+			* Sequences are unordered by default.
+			* @return Returns this reference.
+			*/
+			DGCLayoutBuilder& KeepSequenceOrder();
+
+			/**
+			* @brief Execute sequences through an index buffer written each frame by SetIndirectSequenceOrder,
+			* so sequences are reordered without moving their slots.
+			* @return Returns this reference.
+			*/
+			DGCLayoutBuilder& IndexSequences();
+
 			/**
 			* @brief Create GDC Layout.
 			*/
@@ -726,6 +842,16 @@ namespace Spices {
 			*/
 			std::vector<VkIndirectCommandsLayoutTokenNV> m_InputInfos;
 
+			/**
+			* @brief True if sequences are executed in order.
+			*/
+			bool m_IsOrdered = false;
+
+			/**
+			* @brief True if sequences are executed through an index buffer.
+			*/
+			bool m_IsIndexed = false;
+
 			/**
 			* @brief Current Subpass IndirectData.
 			*/
@@ -763,8 +889,9 @@ namespace Spices {
 
 			/**
 			* @brief Destructor Function.
+			* Upload buffers updated by this builder.
 			*/
-			virtual ~RenderBehaveBuilder() = default;
+			virtual ~RenderBehaveBuilder();
 
 			/**
 			* @brief Recording all this behaver does.
@@ -783,6 +910,43 @@ namespace Spices {
 			*/
 			void Async(std::function<void(VkCommandBuffer& cmdBuffer)> func);
 
+			/**
+			* @brief Async Commands, reuse the secondary recorded in previous frames if content hash did not change.
+			* Render pass, framebuffer and subpass are hashed here, func must only record state covered by contentHash.
+			* @param[in] contentHash Hash of state bound by func.
+			* @param[in] func In Function Pointer
+			*/
+			template<typename F>
+			void AsyncCached(uint64_t contentHash, F&& func);
+
+			/**
+			* @brief Async Commands of a list, ranges of it are recorded to secondaries in parallel.
+			* Secondaries do not inherit state, func binds all state it uses in each range.
+			* @param[in] count Items count.
+			* @param[in] func In Function Pointer, called with cmdBuffer, first item and one past last item.
+			*/
+			template<typename F>
+			void AsyncParallel(uint32_t count, F&& func);
+
+			/**
+			* @brief Hash content with render pass, subpass and viewport state.
+			* @param[in] contentHash Hash of state bound by AsyncCached func.
+			* @return Returns hash of cached secondary.
+			*/
+			uint64_t HashPassState(uint64_t contentHash) const;
+
+			/**
+			* @brief Begin a cached secondary inheriting current render pass and subpass.
+			* @param[in] cmdBuffer The secondary.
+			*/
+			void BeginCachedSecondary(VkCommandBuffer cmdBuffer) const;
+
+			/**
+			* @brief Hash state recorded by RunDGC of current subpass.
+			* @param[in,out] hash ContentHash.
+			*/
+			void HashDGC(ContentHash& hash) const;
+
 			/**
 			* @brief Bind the pipeline created by CreatePipeline().
 			* Called on RenderBehaveBuilder instanced.
@@ -1402,6 +1566,21 @@ namespace Spices {
 		*/
 		std::unordered_map<std::string, std::shared_ptr<VulkanIndirectDrawNV>> m_IndirectData;
 
+		/**
+		* @brief Shader group index of material pipelines in DGC Pipeline, by subpass.
+		*/
+		std::unordered_map<std::string, std::unordered_map<std::string, uint32_t>> m_ShaderGroups;
+
+		/**
+		* @brief Cached secondary command buffers of static subpasses.
+		*/
+		std::unique_ptr<SecondaryCmdCache> m_CmdCache;
+
+		/**
+		* @brief Cached names by sub pass name, filled on render pass created, read only during frame.
+		*/
+		std::unordered_map<std::string, SubPassNames> m_SubPassNames;
+
 		/**
 		* @brief Allow this class access all data.
 		*/
@@ -1415,195 +1594,22 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		auto indirectPtr = m_IndirectData[subpassName];
-		indirectPtr->ResetInput();
+		std::vector<DGCDraw> draws;
 
-		/**
-		* @brief Prepare ShaderGroup
-		*/
-		uint32_t nSequences = 0;
 		auto view = FrameInfo::Get().m_World->GetRegistry().view<T>();
+		for (auto& e : view)
 		{
-			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Prepare ShaderGroup");
-
-			std::unordered_map<std::string, uint32_t> pipelineMap;
-
-			for (auto& e : view)
-			{
-				auto& meshComp = FrameInfo::Get().m_World->GetRegistry().get<T>(e);
-
-				meshComp.GetMesh()->GetPacks().for_each([&](const auto& k, const std::shared_ptr<MeshPack>& v) {
-
-					if (pipelineMap.find(v->GetMaterial()->GetName()) == pipelineMap.end())
-					{
-						pipelineMap[v->GetMaterial()->GetName()] = pipelineMap.size();
-					}
-
-					v->SetShaderGroupHandle(pipelineMap[v->GetMaterial()->GetName()]);
-					nSequences++;
-
-					return false;
-				});
-			}
-			indirectPtr->SetSequenceCount(nSequences);
-
-			m_PipelinesRef[subpassName].resize(pipelineMap.size());
-
-			for (auto& pair : pipelineMap)
-			{
-				m_PipelinesRef[subpassName][pair.second] = m_Pipelines[pair.first]->GetPipeline();
-			}
-		}
-
-		/**
-		* @brief Fill in Input Buffer
-		*/
-		std::vector<size_t> offset;
-		size_t totalSize = 0;
-		std::shared_ptr<VulkanBuffer> inputBuffer = nullptr;
-		{
-			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Fill in Input Buffer");
-
-			size_t alignSeqIndexMask = m_Device->GetDGCProperties().minSequencesIndexBufferOffsetAlignment - 1;
-			size_t alignMask         = m_Device->GetDGCProperties().minIndirectCommandsBufferOffsetAlignment - 1;
-
-			auto& inputStrides       = indirectPtr->GetInputStrides();
-			
-			for (int i = 0; i < inputStrides.size(); i++)
-			{
-				offset.push_back(totalSize);
-				totalSize += ((inputStrides[i] * nSequences + alignMask) & (~alignMask));
-			}
-
-			VulkanBuffer stagingBuffer(
-				m_VulkanState,
-				"StagingBuffer",
-				totalSize,
-				VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-				VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-			);
-
-			auto& layoutTokens = indirectPtr->GetLayoutTokens();
-
-			int index = 0;
-			for (auto& e : view)
-			{
-				auto& meshComp = FrameInfo::Get().m_World->GetRegistry().get<T>(e);
-
-				meshComp.GetMesh()->GetPacks().for_each([&](const auto& k, const std::shared_ptr<MeshPack>& v) {
-
-					for (int i = 0; i < layoutTokens.size(); i++)
-					{
-						VkBindShaderGroupIndirectCommandNV  shader;
-						VkBindVertexBufferIndirectCommandNV vbo;
-						VkBindIndexBufferIndirectCommandNV  ibo;
-						VkDeviceAddress                     push;
-						VkDrawIndexedIndirectCommand        drawIndexed;
-						VkDrawMeshTasksIndirectCommandNV    drawMesh;
-
-						switch (layoutTokens[i].tokenType)
-						{
-						case VK_INDIRECT_COMMANDS_TOKEN_TYPE_SHADER_GROUP_NV:
-							shader.groupIndex = v->GetShaderGroupHandle() + 1;
-							stagingBuffer.WriteToBuffer(&shader, inputStrides[i], index * inputStrides[i] + offset[i]);
-							break;
-
-						case VK_INDIRECT_COMMANDS_TOKEN_TYPE_VERTEX_BUFFER_NV:
-							vbo.bufferAddress = v->GetResource().positions.buffer->GetAddress();
-							vbo.size          = sizeof(v->GetResource().positions.attributes);
-							vbo.stride        = sizeof(glm::vec3);
-							stagingBuffer.WriteToBuffer(&vbo, inputStrides[i], index * inputStrides[i] + offset[i]);
-							break;
-
-						case VK_INDIRECT_COMMANDS_TOKEN_TYPE_INDEX_BUFFER_NV:
-							ibo.bufferAddress = v->GetResource().primitivePoints.buffer->GetAddress();
-							ibo.size          = sizeof(v->GetResource().primitivePoints.attributes);
-							ibo.indexType     = VK_INDEX_TYPE_UINT32;
-							stagingBuffer.WriteToBuffer(&ibo, inputStrides[i], index * inputStrides[i] + offset[i]);
-							break;
-
-						case VK_INDIRECT_COMMANDS_TOKEN_TYPE_PUSH_CONSTANT_NV:
-							push              = v->GetMeshDesc().GetBufferAddress();
-							stagingBuffer.WriteToBuffer(&push, inputStrides[i], index * inputStrides[i] + offset[i]);
-							break;
-
-						case VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_INDEXED_NV:
-							drawIndexed.firstIndex     = 0;
-							drawIndexed.firstInstance  = 0;
-							drawIndexed.indexCount     = v->GetResource().primitivePoints.attributes->size();
-							drawIndexed.instanceCount  = 1;
-							drawIndexed.vertexOffset   = 0;
-							stagingBuffer.WriteToBuffer(&drawIndexed, inputStrides[i], index* inputStrides[i] + offset[i]);
-							break;
-
-						case VK_INDIRECT_COMMANDS_TOKEN_TYPE_DRAW_TASKS_NV:
-							drawMesh = v->GetDrawCommand();
-							stagingBuffer.WriteToBuffer(&drawMesh, inputStrides[i], index * inputStrides[i] + offset[i]);
-							break;
-
-						default:
-							SPICES_CORE_ERROR("Not Supported Token Type.");
-							break;
-						}
-					}
-
-					index++;
-					return false;
-				});
-			}
-			stagingBuffer.Flush();
-
-			inputBuffer = indirectPtr->CreateInputBuffer(totalSize);
-			inputBuffer->CopyBuffer(stagingBuffer.Get(), inputBuffer->Get(), totalSize);
-		}
-
-		/**
-		* @brief Fill in Streams
-		*/
-		{
-			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Fill in Streams");
+			auto& meshComp = FrameInfo::Get().m_World->GetRegistry().get<T>(e);
 
-			std::vector<VkIndirectCommandsStreamNV> inputs;
-			inputs.resize(offset.size());
-			for (int i = 0; i < offset.size(); i++)
-			{
-				inputs[i].buffer = inputBuffer->Get();
-				inputs[i].offset = offset[i];
-			}
-			indirectPtr->SetInputStreams(inputs);
-		}
+			meshComp.GetMesh()->GetPacks().for_each([&](const auto& k, const std::shared_ptr<MeshPack>& v) {
 
-		/**
-		* @brief Regenerate dgc pipeline
-		*/
-		{
-			SPICES_PROFILE_ZONEN("FillIndirectRenderData::Regenerate dgc pipeline");
+				draws.push_back({ DGCSequenceTable::MakeKey(static_cast<uint32_t>(e), k), v, v->GetMeshDesc().GetBufferAddress(), 1 });
 
-			CreateDefaultMaterial();
+				return false;
+			});
 		}
 
-		/**
-		* @brief Create ProcessBuffer.
-		*/
-		{
-			SPICES_PROFILE_ZONEN("FillIndirectRenderData:: Create ProcessBuffer");
-
-			VkGeneratedCommandsMemoryRequirementsInfoNV     memInfo{};
-			memInfo.sType                                 = VK_STRUCTURE_TYPE_GENERATED_COMMANDS_MEMORY_REQUIREMENTS_INFO_NV;
-			memInfo.maxSequencesCount                     = nSequences;
-			memInfo.indirectCommandsLayout                = indirectPtr->GetCommandLayout();
-			memInfo.pipeline                              = m_Pipelines["BasePassRenderer.Mesh.Default.DGC"]->GetPipeline();
-			memInfo.pipelineBindPoint                     = VK_PIPELINE_BIND_POINT_GRAPHICS;
-
-			VkMemoryRequirements2                           memReqs{};
-			memReqs.sType                                 = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
-
-			m_VulkanState.m_VkFunc.vkGetGeneratedCommandsMemoryRequirementsNV(m_VulkanState.m_Device, &memInfo, &memReqs);
-
-			indirectPtr->SetPreprocessSize(memReqs.memoryRequirements.size);
-			indirectPtr->CreatePreprocessBuffer(memReqs.memoryRequirements.size);
-		}
+		FillIndirectRenderData(subpassName, draws);
 	}
 
 	template<typename F>
@@ -1611,34 +1617,16 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		VkCommandBufferInheritanceInfo         inheritanceInfo {};
-		inheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
-		inheritanceInfo.renderPass           = m_Pass->Get();
-		inheritanceInfo.subpass              = subpass;
-		inheritanceInfo.framebuffer          = m_Pass->GetFramebuffer(FrameInfo::Get().m_Imageindex);
-     
-		VkCommandBufferBeginInfo               cmdBufferBeginInfo {};
-		cmdBufferBeginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		cmdBufferBeginInfo.flags             = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
-		cmdBufferBeginInfo.pInheritanceInfo  = &inheritanceInfo;
-
-		std::future<VkCommandBuffer> cmdBuffer = m_CmdThreadPool->SubmitPoolTask<VkCommandBuffer>([&](VkCommandBuffer cmdBuffer) {
-
-			VK_CHECK(vkBeginCommandBuffer(cmdBuffer, &cmdBufferBeginInfo));
-
+		/**
+		* @brief A list of one, recorded by the first thread of pool and joined on its latch.
+		*/
+		SubmitCmdsParallel(primaryCmdBuffer, subpass, 1, [&](VkCommandBuffer cmdBuffer, uint32_t begin, uint32_t end) {
 			func(cmdBuffer);
-
-			VK_CHECK(vkEndCommandBuffer(cmdBuffer));
-
-			return cmdBuffer;
 		});
-
-		VkCommandBuffer buffer = cmdBuffer.get();
-		vkCmdExecuteCommands(primaryCmdBuffer, 1, &buffer);
 	}
 
-	template<typename T, typename F>
-	inline void Renderer::IterWorldCompSubmitCmdParallel(FrameInfo& frameInfo, uint32_t subpass, F func)
+	template<typename F>
+	inline void Renderer::SubmitCmdsParallel(VkCommandBuffer primaryCmdBuffer, uint32_t subpass, uint32_t count, F&& func)
 	{
 		SPICES_PROFILE_ZONE;
 
@@ -1646,60 +1634,26 @@ namespace Spices {
 		inheritanceInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
 		inheritanceInfo.renderPass           = m_Pass->Get();
 		inheritanceInfo.subpass              = subpass;
-		inheritanceInfo.framebuffer          = m_Pass->GetFramebuffer(frameInfo.m_Imageindex);
-						     
+		inheritanceInfo.framebuffer          = m_Pass->GetFramebuffer(FrameInfo::Get().m_Imageindex);
+     
 		VkCommandBufferBeginInfo               cmdBufferBeginInfo {};
 		cmdBufferBeginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		cmdBufferBeginInfo.flags             = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+		cmdBufferBeginInfo.flags             = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
 		cmdBufferBeginInfo.pInheritanceInfo  = &inheritanceInfo;
 
 		/**
-		* @brief Begin all Command Buffer.
-		*/
-		{
-			m_CmdThreadPool->SubmitThreadTask_LightWeight_ForEach([&](VkCommandBuffer cmdBuffer) {
-				VK_CHECK(vkBeginCommandBuffer(cmdBuffer, &cmdBufferBeginInfo));
-			});
-			m_CmdThreadPool->Wait();
-		}
-
-		/**
-		* @brief Iter use view, not group.
-		* @attention Group result nullptr here.
+		* @brief One range per thread of pool, joined on its latch.
 		*/
-		{
-			auto& view = frameInfo.m_World->GetRegistry().view<T>();
-			for (auto& e : view)
-			{
-				m_CmdThreadPool->SubmitPoolTask<VkCommandBuffer>([&](VkCommandBuffer cmdBuffer) {
-
-					auto& [tComp, transComp] = frameInfo.m_World->GetRegistry().get<T, TransformComponent>(e);
-
-					/**
-					* @brief This function defined how we use these components.
-					* @param[in] e entityid.
-					* @param[in] transComp TransformComponent.
-					* @param[in] tComp TComponent.
-					*/
-					func(cmdBuffer, static_cast<int>(e), transComp, tComp);
-
-					return cmdBuffer;
-				});
-			}
-			m_CmdThreadPool->Wait();
-		}
+		const std::vector<VkCommandBuffer> cmdBuffers = m_CmdThreadPool->RecordParallel(
+			FrameInfo::Get().m_FrameIndex  , 
+			cmdBufferBeginInfo             , 
+			count                          , 
+			std::forward<F>(func)
+		);
 
-		/**
-		* @brief End all Command Buffer.
-		*/
-		{
-			m_CmdThreadPool->SubmitThreadTask_LightWeight_ForEach([&](VkCommandBuffer cmdBuffer) {
-				VK_CHECK(vkEndCommandBuffer(cmdBuffer));
-			});
-			m_CmdThreadPool->Wait();
-		}
+		if (cmdBuffers.empty()) return;
 
-		vkCmdExecuteCommands(m_VulkanState.m_GraphicCommandBuffer[frameInfo.m_FrameIndex], m_CmdThreadPool->GetThreadsCount(), m_CmdThreadPool->GetCommandBuffers(frameInfo.m_FrameIndex).data());
+		vkCmdExecuteCommands(primaryCmdBuffer, static_cast<uint32_t>(cmdBuffers.size()), cmdBuffers.data());
 	}
 
 	template<typename T, typename F>
@@ -1727,6 +1681,36 @@ namespace Spices {
 		}
 	}
 
+	template<typename F>
+	void Renderer::RenderBehaveBuilder::AsyncCached(uint64_t contentHash, F&& func)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const std::string& key = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).key;
+
+		/**
+		* @brief Recorded only on a miss, a hit executes the secondary of a previous frame.
+		*/
+		const VkCommandBuffer buffer = m_Renderer->m_CmdCache->Get(key, m_CurrentFrame, HashPassState(contentHash), [&](VkCommandBuffer cmdBuffer) {
+
+			BeginCachedSecondary(cmdBuffer);
+
+			func(cmdBuffer);
+
+			VK_CHECK(vkEndCommandBuffer(cmdBuffer))
+		});
+
+		vkCmdExecuteCommands(m_CommandBuffer, 1, &buffer);
+	}
+
+	template<typename F>
+	void Renderer::RenderBehaveBuilder::AsyncParallel(uint32_t count, F&& func)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Renderer->SubmitCmdsParallel(m_CommandBuffer, m_SubpassIndex, count, std::forward<F>(func));
+	}
+
 	template<typename T, typename F>
 	void Renderer::RenderBehaveBuilder::UpdatePushConstant(F func, VkCommandBuffer cmdBuffer)
 	{
@@ -1743,15 +1727,14 @@ namespace Spices {
 		*/
 		func(push);
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).pipeline;
 
 		/**
 		* @breif Update PushConstants
 		*/
 		vkCmdPushConstants(
 			cmdBuffer ? cmdBuffer : m_CommandBuffer,
-			m_Renderer->m_Pipelines[ss.str()]->GetPipelineLayout(),
+			m_Renderer->m_Pipelines[name]->GetPipelineLayout(),
 			VK_SHADER_STAGE_ALL,
 			0,
 			sizeof(T),
@@ -1775,8 +1758,7 @@ namespace Spices {
 		*/
 		func(push);
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).pipeline;
 
 		/**
 		* @breif Update PushConstants
@@ -1784,7 +1766,7 @@ namespace Spices {
 		m_Renderer->SubmitCmdsParallel(m_CommandBuffer, m_SubpassIndex, [&](VkCommandBuffer& cmdBuffer) {
 			vkCmdPushConstants(
 				cmdBuffer,
-				m_Renderer->m_Pipelines[ss.str()]->GetPipelineLayout(),
+				m_Renderer->m_Pipelines[name]->GetPipelineLayout(),
 				VK_SHADER_STAGE_ALL,
 				0,
 				sizeof(T),
@@ -1842,15 +1824,14 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).pipeline;
 
 		/**
 		* @breif Update PushConstants
 		*/
 		vkCmdPushConstants(
 			cmdBuffer ? cmdBuffer : m_CommandBuffer,
-			m_Renderer->m_Pipelines[ss.str()]->GetPipelineLayout(),
+			m_Renderer->m_Pipelines[name]->GetPipelineLayout(),
 			VK_SHADER_STAGE_ALL,
 			0,
 			sizeof(T),
@@ -1863,16 +1844,15 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::stringstream ss;
-		ss << m_Renderer->m_RendererName << "." << m_HandledSubPass->GetName() << ".Default";
+		const std::string& name = m_Renderer->GetSubPassNames(m_HandledSubPass->GetName()).pipeline;
 
 		/**
 		* @breif Update PushConstants
 		*/
-		m_Renderer->SubmitCmdsParallel(m_CommandBuffer, [&](VkCommandBuffer& cmdBuffer) {
+		m_Renderer->SubmitCmdsParallel(m_CommandBuffer, m_SubpassIndex, [&](VkCommandBuffer& cmdBuffer) {
 			vkCmdPushConstants(
 				cmdBuffer,
-				m_Renderer->m_Pipelines[ss.str()]->GetPipelineLayout(),
+				m_Renderer->m_Pipelines[name]->GetPipelineLayout(),
 				VK_SHADER_STAGE_ALL,
 				0,
 				sizeof(T),
@@ -2114,6 +2094,8 @@ namespace Spices {
 
 		uint32_t index = m_Renderer->m_Pass->AddAttachment(attachmentName, attachmentDescription, clearValue, layers, view);
 
+		RecordAttachment(attachmentName, RenderGraph::AccessType::ColorAttachment, attachmentDescription, isEnableBlend);
+
 		/**
 		* @brief Instance a VkAttachmentReference.
 		*/
@@ -2192,6 +2174,8 @@ namespace Spices {
 
 		const uint32_t index = m_Renderer->m_Pass->AddAttachment(attachmentName, depthAttachment, clearValue, layers, view);
 
+		RecordAttachment(attachmentName, RenderGraph::AccessType::DepthAttachment, depthAttachment);
+
 		/**
 		* @brief Instance a VkAttachmentReference.
 		*/
@@ -2252,6 +2236,8 @@ namespace Spices {
 
 		const uint32_t index = m_Renderer->m_Pass->AddAttachment(attachmentName, attachmentDescription, clearValue, 1, view); /*todo: layer config */
 
+		RecordAttachment(attachmentName, RenderGraph::AccessType::InputAttachment, attachmentDescription);
+
 		/**
 		* @brief Instance a VkAttachmentReference.
 		*/
@@ -36,6 +36,26 @@ namespace Spices {
 			v->Render(ts, frameInfo);
 			return false;
 		});
+
+		/**
+		* @brief Report secondary command buffers recording time and time saved by cached ones.
+		*/
+		SecondaryCmdCache::Stats stats;
+		m_Identities.for_each([&](auto& k, auto& v) {
+			const auto& cacheStats = v->GetCmdCache().GetStats();
+
+			stats.hits     += cacheStats.hits;
+			stats.misses   += cacheStats.misses;
+			stats.recordMs += cacheStats.recordMs;
+			stats.savedMs  += cacheStats.savedMs;
+
+			v->GetCmdCache().ResetStats();
+			return false;
+		});
+
+		SPICES_PROFILE_PLOT("Secondary Cmd Recorded(ms)", stats.recordMs);
+		SPICES_PROFILE_PLOT("Secondary Cmd Saved(ms)",    stats.savedMs);
+		SPICES_PROFILE_PLOT("Secondary Cmd Hits",         static_cast<int64_t>(stats.hits));
 	}
 
 	void RendererManager::OnWindowResizeOver()
@@ -46,6 +66,7 @@ namespace Spices {
 		* @brief Iter all renderer in order.
 		*/
 		m_Identities.for_each([](auto& k, auto& v) {
+			v->InvalidateCmdCache();
 			v->OnWindowResizeOver();
 			return false;
 		});
@@ -72,6 +93,7 @@ namespace Spices {
 		* @brief Iter all renderer in order.
 		*/
 		m_Identities.for_each([](auto& k, auto& v) {
+			v->InvalidateCmdCache();
 			v->OnMeshAddedWorld();
 			return false;
 		});
@@ -111,7 +111,19 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		m_Buffers[i2]->WriteToBuffer(data, size, offset);
-		m_Buffers[i2]->Flush();
+		m_Buffers[i2]->UpdateBuffer(data, size, offset);
+	}
+
+	void RendererSubPass::FlushBuffers()
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (auto& [i2, buffer] : m_Buffers)
+		{
+			if (buffer)
+			{
+				buffer->FlushDirtyRanges();
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -151,6 +151,7 @@ namespace Spices
 
 		/**
 		* @brief Set Buffer data.
+		* Only parts differ from last upload become dirty, uploaded by FlushBuffers.
 		* @param[in] i2 The Buffer Index.
 		* @param[in] data The data copy from.
 		* @param[in] size The copy size.
@@ -163,6 +164,11 @@ namespace Spices
 			uint64_t     offset = 0
 		);
 
+		/**
+		* @brief Upload dirty ranges of all buffers, one flush per buffer.
+		*/
+		void FlushBuffers();
+
 		/**
 		* @brief Get sub pass index of pass.
 		*/
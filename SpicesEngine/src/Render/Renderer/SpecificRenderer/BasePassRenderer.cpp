@@ -6,6 +6,7 @@
 
 #include "Pchheader.h"
 #include "BasePassRenderer.h"
+#include "Core/Thread/ThreadPool.h"
 
 namespace Spices {
 
@@ -92,6 +93,8 @@ namespace Spices {
 		SPICES_PROFILE_ZONE;
 
 		DGCLayoutBuilder{ "Mesh", this }
+		.KeepSequenceOrder()
+		.IndexSequences()
 		.AddShaderGroupInput()
 		.AddPushConstantInput()
 		.AddDrawMeshTaskInput()
@@ -102,7 +105,32 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		FillIndirectRenderData<MeshComponent>("Mesh");	
+		SyncMembers(FrameInfo::Get());
+
+		RebuildBatches();
+
+		/**
+		* @brief A sequence per draw slot, pushing the MeshDesc pointing to its instances.
+		* Slots of unchanged batches are kept, so only sequences of changed batches are patched.
+		* Execution order is written each frame by SortDraws.
+		*/
+		std::vector<DGCDraw> draws;
+		draws.reserve(m_Draws.size());
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_Draws.size()); i++)
+		{
+			const auto& draw = m_Draws[i];
+			if (!draw.pack) continue;
+
+			DGCDraw dgcDraw{};
+			dgcDraw.key           = DGCSequenceTable::MakeKey(0, i);
+			dgcDraw.pack          = draw.pack;
+			dgcDraw.descAddress   = m_InstanceDescBuffer->GetAddress() + i * sizeof(SpicesShader::MeshDesc);
+			dgcDraw.instanceCount = draw.instanceCount;
+
+			draws.push_back(dgcDraw);
+		}
+
+		FillIndirectRenderData("Mesh", draws);
 	}
 
 	std::shared_ptr<VulkanPipeline> BasePassRenderer::CreatePipeline(
@@ -174,13 +202,45 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
+		/**
+		* @brief Free buffers replaced before the oldest frame in flight.
+		*/
+		m_FrameCount++;
+		m_RetiredBuffers.erase(std::remove_if(m_RetiredBuffers.begin(), m_RetiredBuffers.end(), [&](const auto& retired) {
+			return m_FrameCount >= retired.second + MaxFrameInFlight;
+		}), m_RetiredBuffers.end());
+
 		if(frameInfo.m_RendererType != RendererType::Rasterization) return;
+
+		SortDraws(frameInfo);
+
+		UploadInstances(frameInfo);
 		
 		RenderBehaveBuilder builder{ this ,frameInfo.m_FrameIndex, frameInfo.m_Imageindex };
 		
 		builder.BeginRenderPassAsync();
 
-		builder.Async([&](VkCommandBuffer& cmdBuffer) {
+#if 0    // Use DGC or not
+
+		/**
+		* @brief Instances refer to model buffers, the recording only depends on sorted packets.
+		*/
+		const uint64_t descAddress = m_InstanceDescBuffer ? m_InstanceDescBuffer->GetAddress() : 0;
+
+		ContentHash hash;
+		hash.Add(descAddress);
+		for (const uint32_t index : m_DrawPackets.GetOrder())
+		{
+			const auto& packet = m_DrawPackets.GetPackets()[index];
+			const auto& draw   = m_Draws[packet.item];
+
+			hash.Add(m_Pipelines[m_DrawPackets.GetPipelineName(packet.pipeline)]->GetPipeline());
+			hash.Add(packet.item);
+			hash.Add(draw.instanceCount);
+			hash.Add(draw.pack.get());
+		}
+
+		builder.AsyncCached(hash.Get(), [&](VkCommandBuffer& cmdBuffer) {
 
 			builder.SetViewPort(cmdBuffer);
 			
@@ -188,30 +248,49 @@ namespace Spices {
 			
 			builder.BindDescriptorSet(DescriptorSetManager::GetByName({ m_Pass->GetName(), "Mesh" }), cmdBuffer);
 
-#if 0    // Use DGC or not
-
-			IterWorldCompWithBreak<MeshComponent>(frameInfo, [&](int entityId, TransformComponent& transComp, MeshComponent& meshComp) {
-
-				meshComp.GetMesh()->DrawMeshTasks(cmdBuffer, [&](const uint32_t& meshpackId, const auto& meshPack) {
-
-					builder.BindPipeline(meshPack->GetMaterial()->GetName(), cmdBuffer);
+			/**
+			* @brief Pipeline is only bound when it changes, material parameters are fetched by mesh desc.
+			* One mesh tasks dispatch draws all instances of a group.
+			*/
+			m_DrawPackets.Record(
+				[&](uint32_t pipeline) {
+					builder.BindPipeline(m_DrawPackets.GetPipelineName(pipeline), cmdBuffer);
+				},
+				[&](uint32_t material) {},
+				[&](const DrawPacketList::Packet& packet) {
+					const auto& draw = m_Draws[packet.item];
 
 					builder.UpdatePushConstant<uint64_t>([&](auto& push) {
-						push = meshPack->GetMeshDesc().GetBufferAddress();
+						push = descAddress + packet.item * sizeof(SpicesShader::MeshDesc);
 					}, cmdBuffer);
-				});
 
-				return false;
-			});
+					draw.pack->OnDrawMeshTasks(cmdBuffer, draw.instanceCount);
+				}
+			);
+		});
 
 #else
 
-			builder.RunDGC(cmdBuffer);
+		/**
+		* @brief Sequences are patched in place and ordered by the index buffer of this frame,
+		* the recording only depends on dgc buffers and pipeline.
+		*/
+		ContentHash hash;
+		builder.HashDGC(hash);
 
-#endif
+		builder.AsyncCached(hash.Get(), [&](VkCommandBuffer& cmdBuffer) {
 
+			builder.SetViewPort(cmdBuffer);
+			
+			builder.BindDescriptorSet(DescriptorSetManager::GetByName("PreRenderer"), cmdBuffer);
+			
+			builder.BindDescriptorSet(DescriptorSetManager::GetByName({ m_Pass->GetName(), "Mesh" }), cmdBuffer);
+
+			builder.RunDGC(cmdBuffer);
 		});
 
+#endif
+
 		builder.BeginNextSubPass("SkyBox");
 
 		builder.SetViewPort();
@@ -236,4 +315,512 @@ namespace Spices {
 
 		builder.EndRenderPass();
 	}
-}
\ No newline at end of file
+
+	void BasePassRenderer::SyncMembers(FrameInfo& frameInfo)
+	{
+		SPICES_PROFILE_ZONE;
+
+		World& world = *frameInfo.m_World;
+
+		std::vector<uint32_t> changes = world.GetMeshChanges();
+
+		/**
+		* @brief Rebuild all members if world changed or the mark does not carry entities.
+		*/
+		if (m_SyncedWorld != &world || changes.empty())
+		{
+			m_SyncedWorld = &world;
+			m_Members.clear();
+
+			for (auto& pair : m_Batches)
+			{
+				pair.second.instances.clear();
+				pair.second.isDirty = true;
+			}
+
+			for (const auto e : world.GetRegistry().view<MeshComponent>())
+			{
+				AddMembers(world, static_cast<uint32_t>(e));
+			}
+
+			return;
+		}
+
+		std::sort(changes.begin(), changes.end());
+		changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+
+		for (const uint32_t entity : changes)
+		{
+			RemoveMembers(entity);
+			AddMembers(world, entity);
+		}
+	}
+
+	void BasePassRenderer::AddMembers(World& world, uint32_t entity)
+	{
+		SPICES_PROFILE_ZONE;
+
+		auto& registry = world.GetRegistry();
+		const auto e   = static_cast<entt::entity>(entity);
+
+		if (!registry.valid(e) || !registry.all_of<MeshComponent, TransformComponent>(e)) return;
+
+		const auto& mesh = registry.get<MeshComponent>(e).GetMesh();
+		if (!mesh) return;
+
+		const uint64_t modelAddress = registry.get<TransformComponent>(e).GetModelBufferAddress();
+
+		auto& members = m_Members[entity];
+
+		mesh->GetPacks().for_each([&](const uint32_t& k, const std::shared_ptr<MeshPack>& v) {
+
+			/**
+			* @brief A material has one pipeline, so a batch shares both.
+			*/
+			const BasePassR::BatchKey key{ v->GetResourceKey(), reinterpret_cast<uint64_t>(v->GetMaterial().get()) };
+
+			auto& batch = m_Batches[key];
+			if (!batch.pack) batch.pack = v;
+
+			SpicesShader::MeshInstance instance{};
+			instance.modelAddress = modelAddress;
+			instance.entityID     = entity;
+
+			members.push_back({ key, static_cast<uint32_t>(batch.instances.size()) });
+			batch.instances.push_back(instance);
+			batch.isDirty = true;
+
+			return false;
+		});
+	}
+
+	void BasePassRenderer::RemoveMembers(uint32_t entity)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Members.find(entity);
+		if (it == m_Members.end()) return;
+
+		std::vector<BasePassR::Member> members = std::move(it->second);
+		m_Members.erase(it);
+
+		/**
+		* @brief Instances are swap removed, the moved member gets the removed index.
+		*/
+		for (size_t i = 0; i < members.size(); i++)
+		{
+			auto& batch         = m_Batches[members[i].batch];
+			const uint32_t last = static_cast<uint32_t>(batch.instances.size()) - 1;
+
+			if (members[i].index != last)
+			{
+				batch.instances[members[i].index] = batch.instances[last];
+
+				const uint32_t moved = batch.instances[last].entityID;
+				auto& movedMembers   = moved == entity ? members : m_Members[moved];
+
+				for (auto& member : movedMembers)
+				{
+					if (member.batch == members[i].batch && member.index == last)
+					{
+						member.index = members[i].index;
+						break;
+					}
+				}
+			}
+
+			batch.instances.pop_back();
+			batch.isDirty = true;
+		}
+	}
+
+	void BasePassRenderer::RebuildBatches()
+	{
+		SPICES_PROFILE_ZONE;
+
+		auto freeDraws = [&](BasePassR::Batch& batch) {
+			for (const uint32_t slot : batch.draws)
+			{
+				m_Draws[slot] = BasePassR::Draw{};
+				m_FreeDraws.push_back(slot);
+			}
+			batch.draws.clear();
+		};
+
+		/**
+		* @brief Drop emptied batches.
+		*/
+		for (auto it = m_Batches.begin(); it != m_Batches.end();)
+		{
+			if (!it->second.instances.empty())
+			{
+				++it;
+				continue;
+			}
+
+			freeDraws(it->second);
+			if (it->second.range.valid()) m_InstanceAllocator->free(it->second.range);
+			it = m_Batches.erase(it);
+		}
+
+		AllocateRanges();
+
+		std::vector<BasePassR::Batch*> dirty;
+		for (auto& pair : m_Batches)
+		{
+			if (pair.second.isDirty) dirty.push_back(&pair.second);
+		}
+
+		/**
+		* @brief Grow instances buffer with allocator, the whole buffer is uploaded then.
+		*/
+		constexpr uint32_t stride = sizeof(SpicesShader::MeshInstance);
+
+		auto reserve = [&](std::unique_ptr<VulkanBuffer>& buffer, const std::string& name, VkDeviceSize size) {
+			if (buffer && buffer->GetSize() >= size) return false;
+
+			const VkDeviceSize capacity = buffer ? std::max(size, buffer->GetSize() * 2) : size;
+
+			Retire(buffer);
+
+			buffer = std::make_unique<VulkanBuffer>(
+				m_VulkanState,
+				name,
+				capacity,
+				VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
+				VK_BUFFER_USAGE_TRANSFER_DST_BIT          ,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+			);
+
+			return true;
+		};
+
+		const bool instancesRecreated = reserve(m_InstanceBuffer, "MeshInstancesBuffer", m_InstanceAllocator->capacity());
+		if (instancesRecreated)
+		{
+			m_DirtyInstances.clear();
+			m_DirtyInstances.push_back({ 0, 0, m_InstanceAllocator->capacity() });
+		}
+
+		if (dirty.empty() && !instancesRecreated) return;
+
+		/**
+		* @brief Split dirty batches into draws fitting task group limit.
+		*/
+		const uint32_t maxTaskGroupsX = VulkanDevice::GetMeshShaderProperties().maxTaskWorkGroupCount[0];
+
+		m_InstanceBatcher.Clear();
+		for (uint32_t i = 0; i < static_cast<uint32_t>(dirty.size()); i++)
+		{
+			auto& batch = *dirty[i];
+
+			freeDraws(batch);
+
+			const uint32_t material     = m_DrawPackets.GetMaterialId(reinterpret_cast<uint64_t>(batch.pack->GetMaterial().get()));
+			const uint32_t maxInstances = InstanceBatcher::MaxInstancesOfTasks(maxTaskGroupsX, batch.pack->GetNTasks());
+
+			for (const auto& instance : batch.instances)
+			{
+				m_InstanceBatcher.Add(batch.pack->GetResourceKey(), material, i, instance.modelAddress, instance.entityID, 0.0f, maxInstances);
+			}
+		}
+		m_InstanceBatcher.Build();
+
+		/**
+		* @brief Write instances to batch ranges and take a draw slot per group.
+		*/
+		const auto& instances = m_InstanceBatcher.GetInstances();
+		const auto& groups    = m_InstanceBatcher.GetGroups();
+
+		std::vector<uint32_t> cursors(dirty.size(), 0);
+		std::vector<uint32_t> newDraws;
+		for (const auto& group : groups)
+		{
+			auto& batch          = *dirty[group.item];
+			const uint32_t first = batch.range.offset / stride + cursors[group.item];
+
+			std::copy_n(instances.begin() + group.firstInstance, group.instanceCount, m_Instances.begin() + first);
+			cursors[group.item] += group.instanceCount;
+
+			uint32_t slot;
+			if (m_FreeDraws.empty())
+			{
+				slot = static_cast<uint32_t>(m_Draws.size());
+				m_Draws.emplace_back();
+			}
+			else
+			{
+				slot = m_FreeDraws.back();
+				m_FreeDraws.pop_back();
+			}
+
+			auto& draw         = m_Draws[slot];
+			draw.pack          = batch.pack;
+			draw.pipeline      = m_DrawPackets.GetPipelineId(batch.pack->GetMaterial()->GetName());
+			draw.material      = group.material;
+			draw.firstInstance = first;
+			draw.instanceCount = group.instanceCount;
+
+			batch.draws.push_back(slot);
+			newDraws.push_back(slot);
+		}
+
+		for (auto batch : dirty)
+		{
+			if (!instancesRecreated)
+			{
+				m_DirtyInstances.push_back({ 0, batch->range.offset, batch->instances.size() * stride });
+			}
+
+			batch->isDirty = false;
+		}
+
+		if (m_Draws.empty()) return;
+
+		/**
+		* @brief Each draw has a MeshDesc of its meshpack pointing to its instances,
+		* all are rewritten if a buffer moved.
+		*/
+		m_Descs.resize(m_Draws.size());
+
+		const bool descsRecreated = reserve(m_InstanceDescBuffer, "MeshInstanceDescsBuffer", sizeof(SpicesShader::MeshDesc) * m_Draws.size());
+
+		auto writeDesc = [&](uint32_t slot) {
+			const auto& draw = m_Draws[slot];
+
+			m_Descs[slot]                  = draw.pack->GetMeshDesc();
+			m_Descs[slot].instancesAddress = m_InstanceBuffer->GetAddress() + stride * draw.firstInstance;
+		};
+
+		if (instancesRecreated || descsRecreated)
+		{
+			for (uint32_t i = 0; i < static_cast<uint32_t>(m_Draws.size()); i++)
+			{
+				if (m_Draws[i].pack) writeDesc(i);
+			}
+
+			m_DirtyDescs.clear();
+			m_DirtyDescs.push_back({ 0, 0, sizeof(SpicesShader::MeshDesc) * m_Descs.size() });
+		}
+		else
+		{
+			for (const uint32_t slot : newDraws)
+			{
+				writeDesc(slot);
+
+				m_DirtyDescs.push_back({ 0, sizeof(SpicesShader::MeshDesc) * slot, sizeof(SpicesShader::MeshDesc) });
+			}
+		}
+	}
+
+	void BasePassRenderer::AllocateRanges()
+	{
+		SPICES_PROFILE_ZONE;
+
+		constexpr uint32_t stride = sizeof(SpicesShader::MeshInstance);
+
+		if (!m_InstanceAllocator)
+		{
+			m_InstanceAllocator = std::make_unique<scl::tlsf_allocator>(1024 * stride, stride);
+		}
+
+		for (;;)
+		{
+			bool isFull = false;
+
+			for (auto& pair : m_Batches)
+			{
+				auto& batch = pair.second;
+				if (!batch.isDirty) continue;
+
+				const uint32_t bytes = static_cast<uint32_t>(batch.instances.size()) * stride;
+				if (batch.range.valid() && m_InstanceAllocator->allocation_size(batch.range) >= bytes) continue;
+
+				if (batch.range.valid()) m_InstanceAllocator->free(batch.range);
+
+				/**
+				* @brief Ranges are rounded to power of two, so growing batches mostly stay in place.
+				*/
+				uint32_t size = stride;
+				while (size < bytes) size <<= 1;
+
+				batch.range = m_InstanceAllocator->allocate(size);
+				if (!batch.range.valid())
+				{
+					isFull = true;
+					break;
+				}
+			}
+
+			if (!isFull) break;
+
+			/**
+			* @brief Double the range, all batches are reallocated and rewritten.
+			*/
+			m_InstanceAllocator = std::make_unique<scl::tlsf_allocator>(m_InstanceAllocator->capacity() * 2, stride);
+
+			for (auto& pair : m_Batches)
+			{
+				pair.second.range   = scl::tlsf_allocator::allocation{};
+				pair.second.isDirty = true;
+			}
+		}
+
+		m_Instances.resize(m_InstanceAllocator->capacity() / stride);
+	}
+
+	void BasePassRenderer::SortDraws(FrameInfo& frameInfo)
+	{
+		SPICES_PROFILE_ZONE;
+
+		auto [ invViewMatrix, projectionMatrix, stableFrames, fov ] = GetActiveCameraMatrix(frameInfo);
+		const glm::vec3 camPos = glm::vec3(invViewMatrix[3][0], invViewMatrix[3][1], invViewMatrix[3][2]);
+
+		auto& registry = frameInfo.m_World->GetRegistry();
+
+		/**
+		* @brief Depth of a draw is its nearest instance, entities move so it is evaluated each frame.
+		*/
+		m_DrawPackets.Clear();
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_Draws.size()); i++)
+		{
+			const auto& draw = m_Draws[i];
+			if (!draw.pack) continue;
+
+			float depth = std::numeric_limits<float>::max();
+			for (uint32_t j = draw.firstInstance; j < draw.firstInstance + draw.instanceCount; j++)
+			{
+				const auto* transComp = registry.try_get<TransformComponent>(static_cast<entt::entity>(m_Instances[j].entityID));
+				if (!transComp) continue;
+
+				depth = std::min(depth, glm::length(transComp->GetPosition() - camPos));
+			}
+
+			m_DrawPackets.Add(0, draw.pipeline, draw.material, depth, i);
+		}
+
+		m_DrawPackets.Sort(ThreadPool::Get().get());
+
+		/**
+		* @brief Sequences keep their slots, only the execution order is written.
+		*/
+		std::vector<uint64_t> keys;
+		keys.reserve(m_DrawPackets.GetCount());
+		for (const uint32_t index : m_DrawPackets.GetOrder())
+		{
+			keys.push_back(DGCSequenceTable::MakeKey(0, m_DrawPackets.GetPackets()[index].item));
+		}
+
+		SetIndirectSequenceOrder("Mesh", frameInfo.m_FrameIndex, keys);
+	}
+
+	void BasePassRenderer::UploadInstances(FrameInfo& frameInfo)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (m_DirtyInstances.empty() && m_DirtyDescs.empty()) return;
+
+		/**
+		* @brief Merge adjacent ranges.
+		*/
+		auto merge = [](std::vector<VkBufferCopy>& regions) {
+			std::sort(regions.begin(), regions.end(), [](const VkBufferCopy& a, const VkBufferCopy& b) { return a.dstOffset < b.dstOffset; });
+
+			size_t n = 0;
+			for (size_t i = 0; i < regions.size(); i++)
+			{
+				if (n > 0 && regions[n - 1].dstOffset + regions[n - 1].size >= regions[i].dstOffset)
+				{
+					regions[n - 1].size = std::max(regions[n - 1].dstOffset + regions[n - 1].size, regions[i].dstOffset + regions[i].size) - regions[n - 1].dstOffset;
+				}
+				else
+				{
+					regions[n++] = regions[i];
+				}
+			}
+			regions.resize(n);
+		};
+
+		merge(m_DirtyInstances);
+		merge(m_DirtyDescs);
+
+		VkDeviceSize bytes = 0;
+		for (const auto& region : m_DirtyInstances) bytes += region.size;
+		for (const auto& region : m_DirtyDescs)     bytes += region.size;
+
+		/**
+		* @brief Staging buffer of this frame was last read by the frame whose fence was waited in BeginFrame.
+		*/
+		auto& stagingBuffer = m_StagingBuffers[frameInfo.m_FrameIndex];
+		if (!stagingBuffer || stagingBuffer->GetSize() < bytes)
+		{
+			stagingBuffer = std::make_unique<VulkanBuffer>(
+				m_VulkanState,
+				"MeshInstancesStagingBuffer",
+				stagingBuffer ? std::max(bytes, stagingBuffer->GetSize() * 2) : bytes,
+				VK_BUFFER_USAGE_TRANSFER_SRC_BIT     ,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT  |
+				VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			);
+		}
+
+		/**
+		* @brief Pack regions into staging buffer.
+		*/
+		VkDeviceSize srcOffset = 0;
+		auto pack = [&](std::vector<VkBufferCopy>& regions, const void* data) {
+			for (auto& region : regions)
+			{
+				stagingBuffer->WriteToBuffer(static_cast<const uint8_t*>(data) + region.dstOffset, region.size, srcOffset);
+
+				region.srcOffset = srcOffset;
+				srcOffset       += region.size;
+			}
+		};
+
+		pack(m_DirtyInstances, m_Instances.data());
+		pack(m_DirtyDescs,     m_Descs.data());
+
+		/**
+		* @brief Copies are recorded in the frame's command buffer before the pass,
+		* after shader reads of frames submitted earlier on graphic queue.
+		*/
+		VkCommandBuffer cmdBuffer = m_VulkanState.m_GraphicCommandBuffer[frameInfo.m_FrameIndex];
+
+		constexpr VkPipelineStageFlags shaderStages = VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+		VkMemoryBarrier                         barrier{};
+		barrier.sType                         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
+		barrier.dstAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(cmdBuffer, shaderStages, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		if (!m_DirtyInstances.empty())
+		{
+			vkCmdCopyBuffer(cmdBuffer, stagingBuffer->Get(), m_InstanceBuffer->Get(), static_cast<uint32_t>(m_DirtyInstances.size()), m_DirtyInstances.data());
+		}
+
+		if (!m_DirtyDescs.empty())
+		{
+			vkCmdCopyBuffer(cmdBuffer, stagingBuffer->Get(), m_InstanceDescBuffer->Get(), static_cast<uint32_t>(m_DirtyDescs.size()), m_DirtyDescs.data());
+		}
+
+		barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
+
+		vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, shaderStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+		m_DirtyInstances.clear();
+		m_DirtyDescs.clear();
+	}
+
+	void BasePassRenderer::Retire(std::unique_ptr<VulkanBuffer>& buffer)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!buffer) return;
+
+		m_RetiredBuffers.emplace_back(std::move(buffer), m_FrameCount);
+	}
+}
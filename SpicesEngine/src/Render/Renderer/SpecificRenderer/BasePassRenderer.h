@@ -7,6 +7,9 @@
 #pragma once
 #include "Core/Core.h"
 #include "Render/Renderer/Renderer.h"
+#include "Render/Renderer/DrawPacket/DrawPacketList.h"
+#include "Render/Renderer/DrawPacket/InstanceBatcher.h"
+#include "Core/Container/TLSFAllocator.h"
 
 namespace Spices {
 
@@ -16,6 +19,58 @@ namespace Spices {
 		{
 			std::vector<SpicesShader::MeshDesc> descs;
 		};
+
+		/**
+		* @brief Key of a batch, entities drawing the same mesh pack resource with the same material.
+		*/
+		struct BatchKey
+		{
+			uint64_t resource;                       /* @brief Mesh pack resource key.     */
+			uint64_t material;                       /* @brief Material.                   */
+
+			bool operator==(const BatchKey& other) const { return resource == other.resource && material == other.material; }
+		};
+
+		/**
+		* @brief Batch key hash.
+		*/
+		struct BatchKeyHash
+		{
+			size_t operator()(const BatchKey& key) const { return std::hash<uint64_t>()(key.resource ^ (key.material << 1)); }
+		};
+
+		/**
+		* @brief Instances of a batch, kept in a range of the instances buffer.
+		*/
+		struct Batch
+		{
+			std::shared_ptr<MeshPack>               pack;              /* @brief MeshPack of the first instance.         */
+			std::vector<SpicesShader::MeshInstance> instances;         /* @brief Instances.                              */
+			scl::tlsf_allocator::allocation         range;             /* @brief Range in instances buffer.              */
+			std::vector<uint32_t>                   draws;             /* @brief Draw slots, split by task group limit.  */
+			bool                                    isDirty = true;    /* @brief True if instances changed.              */
+		};
+
+		/**
+		* @brief An instance of an entity.
+		*/
+		struct Member
+		{
+			BatchKey batch;                          /* @brief Batch of the instance.      */
+			uint32_t index;                          /* @brief Index in batch instances.   */
+		};
+
+		/**
+		* @brief An instanced draw, its slot keys its dgc sequence.
+		*/
+		struct Draw
+		{
+			std::shared_ptr<MeshPack> pack;                /* @brief MeshPack, nullptr if slot is free.     */
+			uint32_t                  pipeline      = 0;   /* @brief Pipeline id.                           */
+			uint32_t                  material      = 0;   /* @brief Material id.                           */
+			uint32_t                  firstInstance = 0;   /* @brief First instance in instances buffer.    */
+			uint32_t                  instanceCount = 0;   /* @brief Number of instances.                   */
+		};
 	}
 
 	/**
@@ -108,6 +163,140 @@ namespace Spices {
 			VkPipelineLayout&                layout       ,
 			std::shared_ptr<RendererSubPass> subPass
 		) override;
+
+		/**
+		* @brief Update instances of entities whose MeshComponent changed, all entities if world changed.
+		* @param[in] frameInfo The current frame data.
+		*/
+		void SyncMembers(FrameInfo& frameInfo);
+
+		/**
+		* @brief Add instances of an entity to batches.
+		* @param[in] world World of the entity.
+		* @param[in] entity Entity id.
+		*/
+		void AddMembers(World& world, uint32_t entity);
+
+		/**
+		* @brief Remove instances of an entity from batches.
+		* @param[in] entity Entity id.
+		*/
+		void RemoveMembers(uint32_t entity);
+
+		/**
+		* @brief Rebuild ranges, draws and MeshDesc of dirty batches, other batches keep their draw slots.
+		*/
+		void RebuildBatches();
+
+		/**
+		* @brief Allocate instances ranges of dirty batches, grow allocator and buffer if full.
+		*/
+		void AllocateRanges();
+
+		/**
+		* @brief Sort draws by pipeline, material and nearest instance to camera, write dgc execution order of this frame.
+		* @param[in] frameInfo The current frame data.
+		*/
+		void SortDraws(FrameInfo& frameInfo);
+
+		/**
+		* @brief Record copies of changed instances and MeshDesc to the frame's command buffer.
+		* @param[in] frameInfo The current frame data.
+		*/
+		void UploadInstances(FrameInfo& frameInfo);
+
+		/**
+		* @brief Keep a buffer alive until frames in flight using it finished.
+		* @param[in] buffer The buffer.
+		*/
+		void Retire(std::unique_ptr<VulkanBuffer>& buffer);
+
+	private:
+
+		/**
+		* @brief Instanced draws sorted by state each frame, item is a draw slot.
+		*/
+		DrawPacketList m_DrawPackets;
+
+		/**
+		* @brief Splits dirty batches into instanced draws by task group limit.
+		*/
+		InstanceBatcher m_InstanceBatcher;
+
+		/**
+		* @brief Batches of instances.
+		*/
+		std::unordered_map<BasePassR::BatchKey, BasePassR::Batch, BasePassR::BatchKeyHash> m_Batches;
+
+		/**
+		* @brief Instances of each entity.
+		*/
+		std::unordered_map<uint32_t, std::vector<BasePassR::Member>> m_Members;
+
+		/**
+		* @brief Draws indexed by slot.
+		*/
+		std::vector<BasePassR::Draw> m_Draws;
+
+		/**
+		* @brief Free draw slots.
+		*/
+		std::vector<uint32_t> m_FreeDraws;
+
+		/**
+		* @brief World of synced members, members are rebuilt if it changed.
+		*/
+		World* m_SyncedWorld = nullptr;
+
+		/**
+		* @brief Instance ranges of batches.
+		*/
+		std::unique_ptr<scl::tlsf_allocator> m_InstanceAllocator;
+
+		/**
+		* @brief Host copy of instances buffer.
+		*/
+		std::vector<SpicesShader::MeshInstance> m_Instances;
+
+		/**
+		* @brief Host copy of MeshDesc buffer, indexed by draw slot.
+		*/
+		std::vector<SpicesShader::MeshDesc> m_Descs;
+
+		/**
+		* @brief Changed ranges of instances buffer, copied by next frame.
+		*/
+		std::vector<VkBufferCopy> m_DirtyInstances;
+
+		/**
+		* @brief Changed ranges of MeshDesc buffer, copied by next frame.
+		*/
+		std::vector<VkBufferCopy> m_DirtyDescs;
+
+		/**
+		* @brief MeshInstance buffer, instances refer to model buffer of entity so only changed batches are rewritten.
+		*/
+		std::unique_ptr<VulkanBuffer> m_InstanceBuffer;
+
+		/**
+		* @brief MeshDesc buffer of instanced draws, pushed by DGC sequences.
+		*/
+		std::unique_ptr<VulkanBuffer> m_InstanceDescBuffer;
+
+		/**
+		* @brief Staging buffer of each frame in flight, reused after the frame fence is waited.
+		*/
+		std::array<std::unique_ptr<VulkanBuffer>, MaxFrameInFlight> m_StagingBuffers;
+
+		/**
+		* @brief Replaced buffers and the frame they were replaced in.
+		*/
+		std::vector<std::pair<std::unique_ptr<VulkanBuffer>, uint64_t>> m_RetiredBuffers;
+
+		/**
+		* @brief Rendered frames.
+		*/
+		uint64_t m_FrameCount = 0;
 	};
 
 }
\ No newline at end of file
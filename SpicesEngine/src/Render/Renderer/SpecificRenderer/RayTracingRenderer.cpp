@@ -8,6 +8,7 @@
 #include "RayTracingRenderer.h"
 #include "PreRenderer.h"
 #include "Render/Vulkan/VulkanRayTracing.h"
+#include "Render/RayTracing/VulkanBLASBackend.h"
 #include "Core/Library/MemoryLibrary.h"
 
 namespace Spices {
@@ -25,6 +26,15 @@ namespace Spices {
 		SPICES_PROFILE_ZONE;
 
 		m_VulkanRayTracing = std::make_unique<VulkanRayTracing>(m_VulkanState);
+
+		m_BLASBackend = std::make_shared<VulkanBLASBackend>(
+			*m_VulkanRayTracing,
+			VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
+			VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR      |
+			VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR
+		);
+
+		m_BLASRegistry = std::make_unique<BLASRegistry>(m_BLASBackend, MaxFrameInFlight);
 	}
 
 	void RayTracingRenderer::CreateRendererPass()
@@ -58,9 +68,9 @@ namespace Spices {
 		SPICES_PROFILE_ZONE;
 
 		/**
-		* @brief Destroy old AS if created before.
+		* @brief Destroy old TLAS if created before, BLAS are kept by BLASRegistry.
 		*/
-		m_VulkanRayTracing->Destroy();
+		m_VulkanRayTracing->DestroyTLAS();
 
 		/**
 		* @brief Prepare RayTracing AC Structure ans SBT.
@@ -110,6 +120,11 @@ namespace Spices {
 		
 		if (m_VulkanRayTracing->GetAccelerationStructure() == VK_NULL_HANDLE) return;
 
+		/**
+		* @brief Build pending BLAS within budget, free retired ones.
+		*/
+		m_BLASRegistry->Tick(RayTracingR::BLASBuildBudget);
+
 		UpdateTopLevelAS(frameInfo);
 		
 		RayTracingRenderBehaveBuilder builder{ this , frameInfo.m_FrameIndex, frameInfo.m_Imageindex };
@@ -148,87 +163,231 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		/**
-		* @brief BLAS - Storing each primitive in a geometry.
-		*/
-		std::vector<VulkanRayTracing::BlasInput> allBlas;
 		m_HitGroups.clear();
-		
+
 		/**
-		* @brief Iter all MeshComponents.
+		* @brief Acquire BLAS of all instances in world before releasing the old ones,
+		* so BLAS still in use never drop to zero users.
+		* BLAS are keyed by resource, packs instanced from one resource share a BLAS.
 		*/
+		std::unordered_map<uint64_t, uint64_t> instanceBLAS;
 		auto view = frameInfo.m_World->GetRegistry().view<MeshComponent>();
 		for (auto& e : view)
 		{
 			auto& meshComp = frameInfo.m_World->GetRegistry().get<MeshComponent>(e);
 
-			auto blas = meshComp.GetMesh()->CreateMeshPackASInput();
-			allBlas.insert(allBlas.end(), blas.begin(), blas.end());
+			meshComp.GetMesh()->GetPacks().for_each([&](const uint32_t& k, const std::shared_ptr<MeshPack>& v) {
+
+				const uint64_t resource = v->GetResourceKey();
+				if (!m_BLASRegistry->Contains(resource))
+				{
+					m_BLASBackend->SetInput(resource, v->MeshPackToVkGeometryKHR(), v);
+				}
+
+				m_BLASRegistry->Acquire(resource);
+				instanceBLAS[TLASInstanceTable::MakeKey(static_cast<uint32_t>(e), k)] = resource;
+
+				return false;
+			});
 
 			meshComp.GetMesh()->AddMaterialToHitGroup(m_HitGroups);
 		}
 
-		/**
-		* @brief Build BLAS.
-		*/
-		m_VulkanRayTracing->BuildBLAS(allBlas, VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR);
+		for (const auto& [key, resource] : m_InstanceBLAS)
+		{
+			m_BLASRegistry->Release(resource);
+		}
+
+		m_InstanceBLAS.swap(instanceBLAS);
 	}
  
 	void RayTracingRenderer::CreateTopLevelAS(FrameInfo& frameInfo, bool update)
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::vector<VkAccelerationStructureInstanceKHR> tlas;
+		/**
+		* @brief Walk all MeshComponents, slots of vanished instances are released.
+		*/
+		GatherTLASInstances(frameInfo, true);
+
+		/**
+		* @brief Build TLAS.
+		*/
+		CommitTLASInstances(update);
+	}
+	
+	void RayTracingRenderer::UpdateTopLevelAS(FrameInfo& frameInfo, bool update)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const bool blasChanged = m_BLASRegistry->GetGeneration() != m_BLASGeneration;
+
+		if(!(frameInfo.m_World->GetMarker() & World::NeedUpdateTLAS) && !blasChanged) return;
+		frameInfo.m_World->ClearMarkerWithBits(World::NeedUpdateTLAS);
+
+		/**
+		* @brief Only entities marked by TransformComponent touch their slots.
+		*/
+		bool entityMarked = false;
+		auto view = frameInfo.m_World->GetRegistry().view<MeshComponent, TransformComponent>();
+		for (auto& e : view)
+		{
+			auto& tranComp = frameInfo.m_World->GetRegistry().get<TransformComponent>(e);
+			if (!(tranComp.GetMarker() & TransformComponent::NeedUpdateTLAS)) continue;
+
+			tranComp.ClearMarkerWithBits(TransformComponent::NeedUpdateTLAS);
+			entityMarked = true;
+
+			auto& meshComp = frameInfo.m_World->GetRegistry().get<MeshComponent>(e);
+			const glm::mat4& model = tranComp.GetModelMatrix();
+
+			meshComp.GetMesh()->GetPacks().for_each([&](const uint32_t& k, const std::shared_ptr<MeshPack>& v) {
+
+				const uint32_t slot = m_TLASInstances.GetSlot(TLASInstanceTable::MakeKey(static_cast<uint32_t>(e), k));
+				if (slot != UINT32_MAX)
+				{
+					m_TLASInstances.SetTransform(slot, model);
+				}
+				return false;
+			});
+		}
+
+		/**
+		* @brief BLAS built or freed, or world marked without any entity (material, display options), compare all instances.
+		*/
+		if (!entityMarked || blasChanged)
+		{
+			GatherTLASInstances(frameInfo, false);
+		}
+
+		CommitTLASInstances(update);
+	}
+
+	void RayTracingRenderer::GatherTLASInstances(FrameInfo& frameInfo, bool allocate)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_DescArray)
+		{
+			m_DescArray = std::make_unique<RayTracingR::MeshDescBuffer>();
+		}
+
+		if (allocate)
+		{
+			m_TLASInstances.BeginSync();
+		}
+
+		/**
+		* @brief Instances whose BLAS is not built yet stay inactive.
+		*/
+		m_BLASGeneration = m_BLASRegistry->GetGeneration();
 
-		int index = 0;
-		m_DescArray = std::make_unique<RayTracingR::MeshDescBuffer>();
 		auto view = frameInfo.m_World->GetRegistry().view<MeshComponent>();
 		for (auto& e : view)
 		{
-			MeshComponent meshComp;
-			TransformComponent tranComp;
+			auto& meshComp = frameInfo.m_World->GetRegistry().get<MeshComponent>(e);
+			auto& tranComp = frameInfo.m_World->GetRegistry().get<TransformComponent>(e);
 
-			std::tie(meshComp, tranComp) = frameInfo.m_World->GetRegistry().get<MeshComponent, TransformComponent>(e);
+			const glm::mat4& model = tranComp.GetModelMatrix();
+			tranComp.ClearMarkerWithBits(TransformComponent::NeedUpdateTLAS);
 
 			meshComp.GetMesh()->GetPacks().for_each([&](const uint32_t& k, const std::shared_ptr<MeshPack>& v) {
 
-				VkAccelerationStructureInstanceKHR                            rayInst{};
-				rayInst.transform                                           = ToVkTransformMatrixKHR(tranComp.GetModelMatrix());          // Position of the instance
-				rayInst.instanceCustomIndex                                 = index;                                                      // gl_InstanceCustomIndexEXT
-				rayInst.accelerationStructureReference                      = m_VulkanRayTracing->GetBlasDeviceAddress(index);
-				rayInst.flags                                               = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
-				rayInst.mask                                                = 0xFF;                                                       //  Only be hit if rayMask & instance.mask != 0
-				rayInst.instanceShaderBindingTableRecordOffset              = v->GetHitShaderHandle();                                    // We will use the same hit group for all objects
+				const uint64_t key  = TLASInstanceTable::MakeKey(static_cast<uint32_t>(e), k);
+				const uint32_t slot = allocate ? m_TLASInstances.Acquire(key) : m_TLASInstances.GetSlot(key);
+
+				if (slot != UINT32_MAX)
+				{
+					assert(slot < MESH_BUFFER_MAXNUM);
+
+					VkAccelerationStructureInstanceKHR                            rayInst{};
+					rayInst.transform                                           = ToVkTransformMatrixKHR(model);                              // Position of the instance
+					rayInst.instanceCustomIndex                                 = slot;                                                       // gl_InstanceCustomIndexEXT
+					rayInst.accelerationStructureReference                      = m_BLASRegistry->GetAddress(v->GetResourceKey());
+					rayInst.flags                                               = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
+					rayInst.mask                                                = 0xFF;                                                       //  Only be hit if rayMask & instance.mask != 0
+					rayInst.instanceShaderBindingTableRecordOffset              = v->GetHitShaderHandle();                                    // We will use the same hit group for all objects
 
-				tlas.push_back(rayInst);
+					m_TLASInstances.SetInstance(slot, rayInst);
 
-				m_DescArray->descs[index] = v->GetMeshDesc().GetBufferAddress();
+					m_DescArray->descs[slot] = v->GetMeshDesc().GetBufferAddress();
+				}
 
-				index += 1;
 				return false;
 			});
 		}
-		
+
+		if (allocate)
+		{
+			m_TLASInstances.EndSync();
+		}
+	}
+
+	void RayTracingRenderer::CommitTLASInstances(bool update)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto& instances = m_TLASInstances.GetInstances();
+		if (instances.empty()) return;
+
 		/**
-		* @brief Build TLAS.
+		* @brief A destroyed TLAS is always built from scratch.
+		*/
+		TLASInstanceTable::BuildMode mode = m_TLASInstances.GetBuildMode();
+		if (m_VulkanRayTracing->GetAccelerationStructure() == VK_NULL_HANDLE)
+		{
+			mode = TLASInstanceTable::BuildMode::Rebuild;
+		}
+		else if (mode == TLASInstanceTable::BuildMode::None)
+		{
+			return;
+		}
+		else if (!update)
+		{
+			mode = TLASInstanceTable::BuildMode::Rebuild;
+		}
+
+		/**
+		* @brief Upload only dirty ranges to the persistent instance buffer.
+		*/
+		constexpr VkDeviceSize stride = sizeof(VkAccelerationStructureInstanceKHR);
+		const VkDeviceSize size = stride * instances.size();
+
+		if (!m_TLASInstanceBuffer || m_TLASInstanceBuffer->GetSize() < size)
+		{
+			m_TLASInstanceBuffer = std::make_unique<VulkanBuffer>(
+				m_VulkanState,
+				"TLASInstancesBuffer",
+				size,
+				VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT                            |
+				VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR ,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT                                  |
+				VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			);
+
+			m_TLASInstanceBuffer->WriteToBuffer(instances.data(), size);
+		}
+		else
+		{
+			for (const auto& range : m_TLASInstances.GetDirtyRanges())
+			{
+				m_TLASInstanceBuffer->WriteToBuffer(&instances[range.first], stride * range.count, stride * range.first);
+			}
+		}
+
+		/**
+		* @brief Build TLAS, refit in place if only a few transforms changed.
 		*/
 		m_VulkanRayTracing->BuildTLAS(
-			tlas,
+			m_TLASInstanceBuffer->GetAddress(),
+			static_cast<uint32_t>(instances.size()),
 			VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
-			VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR |
+			VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR      |
 			VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR,
-			update
+			mode == TLASInstanceTable::BuildMode::Refit
 		);
-	}
-	
-	void RayTracingRenderer::UpdateTopLevelAS(FrameInfo& frameInfo, bool update)
-	{
-		SPICES_PROFILE_ZONE;
 
-		if(!(frameInfo.m_World->GetMarker() & World::NeedUpdateTLAS)) return;
-		frameInfo.m_World->ClearMarkerWithBits(World::NeedUpdateTLAS);
-		
-		CreateTopLevelAS(frameInfo, update);
+		m_TLASInstances.ClearDirty();
 	}
 
 	void RayTracingRenderer::CreateRTShaderBindingTable(FrameInfo& frameInfo)
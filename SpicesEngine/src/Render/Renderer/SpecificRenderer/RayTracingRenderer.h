@@ -7,10 +7,13 @@
 #pragma once
 #include "Core/Core.h"
 #include "Render/Renderer/Renderer.h"
+#include "Render/RayTracing/TLASInstanceTable.h"
+#include "Render/RayTracing/BLASRegistry.h"
 
 namespace Spices {
 
 	class VulkanRayTracing;
+	class VulkanBLASBackend;
 
 	namespace RayTracingR {
 		
@@ -33,6 +36,11 @@ namespace Spices {
 		{
 			int entityID;
 		};
+
+		/**
+		* @brief Bytes of BLAS built per frame.
+		*/
+		constexpr VkDeviceSize BLASBuildBudget = 64ull * 1024 * 1024;
 		
 	}
 
@@ -108,7 +116,8 @@ namespace Spices {
 	private:
 
 		/**
-		* @brief Create BottomLevelAS with all MeshComponents.
+		* @brief Acquire BottomLevelAS of all MeshComponents, release vanished ones.
+		* BLAS are built later by BLASRegistry within budget.
 		* @param[in] frameInfo FrameInfo.
 		*/
 		void CreateBottomLevelAS(FrameInfo& frameInfo);
@@ -128,6 +137,19 @@ namespace Spices {
 		*/
 		void UpdateTopLevelAS(FrameInfo& frameInfo, bool update = true);
 
+		/**
+		* @brief Walk all MeshComponents and write their instances to TLASInstanceTable.
+		* @param[in] frameInfo FrameInfo.
+		* @param[in] allocate True if slots can be acquired and released, false to only refresh existing slots.
+		*/
+		void GatherTLASInstances(FrameInfo& frameInfo, bool allocate);
+
+		/**
+		* @brief Upload dirty instances and build TopLevelAS.
+		* @param[in] update False to force a full build.
+		*/
+		void CommitTLASInstances(bool update);
+
 		/**
 		* @brief Create Shader Binding Table.
 		* @param[in] frameInfo FrameInfo.
@@ -141,6 +163,26 @@ namespace Spices {
 		*/
 		std::unique_ptr<VulkanRayTracing> m_VulkanRayTracing;
 
+		/**
+		* @brief BLAS backend, destroyed before VulkanRayTracing.
+		*/
+		std::shared_ptr<VulkanBLASBackend> m_BLASBackend;
+
+		/**
+		* @brief BLAS shared by MeshPack resource key.
+		*/
+		std::unique_ptr<BLASRegistry> m_BLASRegistry;
+
+		/**
+		* @brief TLAS instance key to MeshPack resource key acquired from BLASRegistry.
+		*/
+		std::unordered_map<uint64_t, uint64_t> m_InstanceBLAS;
+
+		/**
+		* @brief BLASRegistry generation the TLAS instances were gathered with.
+		*/
+		uint64_t m_BLASGeneration = 0;
+
 		std::unique_ptr<VulkanBuffer> m_RTSBTBuffer;
 		std::unordered_map<std::string, uint32_t> m_HitGroups;
 
@@ -150,5 +192,15 @@ namespace Spices {
 		VkStridedDeviceAddressRegionKHR m_CallRegion{};
 
 		std::unique_ptr<RayTracingR::MeshDescBuffer> m_DescArray;
+
+		/**
+		* @brief Persistent TLAS instances, slots are stable across frames.
+		*/
+		TLASInstanceTable m_TLASInstances;
+
+		/**
+		* @brief Persistent host visible TLAS instance buffer, patched by dirty ranges.
+		*/
+		std::unique_ptr<VulkanBuffer> m_TLASInstanceBuffer;
 	};
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "SceneComposeRenderer.h"
 #include "Systems/SlateSystem.h"
 #include "RayTracingRenderer.h"
+#include "Core/Thread/ThreadPool.h"
 
 namespace Spices {
 
@@ -18,6 +19,17 @@ namespace Spices {
 			SpicesShader::DirectionalLight directionalLight;
 			std::array<SpicesShader::PointLight, 1000> pointLights;
 		};
+
+		struct LightClusterBuffer
+		{
+			SpicesShader::LightClusterInfo info;
+			std::array<SpicesShader::LightCluster, LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z> clusters;
+		};
+
+		/**
+		* @brief Depth of the end of last light cluster slice.
+		*/
+		constexpr float LightClusterFar = 1000.0f;
 	}
 
 	SceneComposeRenderer::SceneComposeRenderer(
@@ -69,6 +81,8 @@ namespace Spices {
 		.AddInput(2, 0, VK_SHADER_STAGE_FRAGMENT_BIT, { "Albedo", "Normal", "Roughness", "Metallic", "Position" })
 		.AddStorageBuffer(3, 0, sizeof(RayTracingR::DirectionalLightBuffer), VK_SHADER_STAGE_FRAGMENT_BIT)                        /* @brief World Directional Light Buffer. */
 		.AddStorageBuffer(3, 1, sizeof(RayTracingR::PointLightBuffer), VK_SHADER_STAGE_FRAGMENT_BIT)                              /* @brief World PointLight Buffer.        */
+		.AddStorageBuffer(3, 2, sizeof(SceneCR::LightClusterBuffer), VK_SHADER_STAGE_FRAGMENT_BIT)                                /* @brief PointLight Cluster Buffer.      */
+		.AddStorageBuffer(3, 3, sizeof(uint32_t) * LIGHT_CLUSTER_INDEX_MAXNUM, VK_SHADER_STAGE_FRAGMENT_BIT)                      /* @brief PointLight Index Buffer.        */
 		.Build();
 	}
 
@@ -120,9 +134,32 @@ namespace Spices {
 		});
 
 		builder.UpdateStorageBuffer<RayTracingR::PointLightBuffer>(3, 1, [&](auto& ssbo) {
-			GetPointLight(frameInfo, ssbo.lights);
+			const uint32_t count = GetPointLight(frameInfo, ssbo.lights);
+
+			/**
+			* @brief Bin PointLights to clusters of active camera.
+			*/
+			auto [invViewMatrix, projectionMatrix, stableFrames, fov] = GetActiveCameraMatrix(frameInfo);
+			const auto view = LightClusterBuilder::MakeView(glm::inverse(invViewMatrix), projectionMatrix, SceneCR::LightClusterFar);
+
+			m_LightClusters.Build(view, ssbo.lights.data(), count, ThreadPool::Get().get());
 		});
 
+		/**
+		* @brief Upload used part of clusters and indices only.
+		*/
+		const auto& clusters = m_LightClusters.GetClusters();
+		const auto& indices  = m_LightClusters.GetIndices();
+
+		SpicesShader::LightClusterInfo info = m_LightClusters.GetInfo();
+		builder.UpdateStorageBuffer(3, 2, &info, sizeof(SpicesShader::LightClusterInfo), 0);
+		builder.UpdateStorageBuffer(3, 2, (void*)clusters.data(), sizeof(SpicesShader::LightCluster) * clusters.size(), offsetof(SceneCR::LightClusterBuffer, clusters));
+
+		if (!indices.empty())
+		{
+			builder.UpdateStorageBuffer(3, 3, (void*)indices.data(), sizeof(uint32_t) * indices.size(), 0);
+		}
+
 		builder.BindPipeline("SceneComposeRenderer.SceneCompose.Default");
 
 		builder.DrawFullScreenTriangle();
@@ -7,6 +7,7 @@
 #pragma once
 #include "Core/Core.h"
 #include "Render/Renderer/Renderer.h"
+#include "Render/Lighting/LightClusterBuilder.h"
 
 namespace Spices {
 
@@ -73,5 +74,12 @@ namespace Spices {
 			VkPipelineLayout&                layout    ,
 			std::shared_ptr<RendererSubPass> subPass
 		) override;
+
+	private:
+
+		/**
+		* @brief PointLight clusters of active camera.
+		*/
+		LightClusterBuilder m_LightClusters;
 	};
 }
\ No newline at end of file
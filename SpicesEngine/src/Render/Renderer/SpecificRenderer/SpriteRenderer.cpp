@@ -39,37 +39,68 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		RenderBehaveBuilder builder{ this ,frameInfo.m_FrameIndex, frameInfo.m_Imageindex };
-
-		builder.BeginRenderPass();
-
-		builder.BindDescriptorSet(DescriptorSetManager::GetByName("PreRenderer"));
-
-		builder.BindDescriptorSet(DescriptorSetManager::GetByName({ m_Pass->GetName(), "Sprite" }));
-		
 		auto [ invViewMatrix, projectionMatrix, stableFrames, fov ] = GetActiveCameraMatrix(frameInfo);
 		const glm::vec3 camPos = glm::vec3(invViewMatrix[3][0], invViewMatrix[3][1], invViewMatrix[3][2]);
 
-		std::map<float, int> sortedEntity;
+		/**
+		* @brief Blended sprites are drawn back to front, equal distances keep all sprites.
+		*/
+		m_DrawPackets.Clear();
+		m_DrawItems.clear();
+
 		IterWorldCompWithBreak<SpriteComponent>(frameInfo, [&](int entityId, TransformComponent& transComp, SpriteComponent& spriteComp) {
-			const glm::vec3 dis = transComp.GetPosition() - camPos;
-			sortedEntity[glm::dot(dis, dis)] = entityId;
+			const float depth = glm::length(transComp.GetPosition() - camPos);
+
+			spriteComp.GetMesh()->GetPacks().for_each([&](const uint32_t& k, const std::shared_ptr<MeshPack>& v) {
+				const uint32_t pipeline = m_DrawPackets.GetPipelineId(v->GetMaterial()->GetName());
+
+				m_DrawPackets.Add(0, pipeline, 0, depth, static_cast<uint32_t>(m_DrawItems.size()), true);
+				m_DrawItems.push_back(v);
+
+				return false;
+			});
 
 			return false;
 		});
 
-		for (auto it = sortedEntity.rbegin(); it != sortedEntity.rend(); ++it)
-		{
-			auto [transComp, spriteComp] = frameInfo.m_World->GetRegistry().get<TransformComponent, SpriteComponent>(static_cast<entt::entity>(it->second));
+		m_DrawPackets.Sort();
+
+		RenderBehaveBuilder builder{ this ,frameInfo.m_FrameIndex, frameInfo.m_Imageindex };
 
-			spriteComp.GetMesh()->Draw(m_VulkanState.m_GraphicCommandBuffer[frameInfo.m_FrameIndex], [&](uint32_t meshpackId, auto meshPack) {
-				builder.BindPipeline(meshPack->GetMaterial()->GetName());
+		builder.BeginRenderPassAsync();
 
-				builder.UpdatePushConstant<uint64_t>([&](auto& push) {
-					push = meshPack->GetMeshDesc().GetBufferAddress();
-				});
-			});
-		}
+		const auto& preRendererSet = DescriptorSetManager::GetByName("PreRenderer");
+		const auto& spriteSet      = DescriptorSetManager::GetByName({ m_Pass->GetName(), "Sprite" });
+
+		/**
+		* @brief Sorted packets are split into contiguous ranges recorded in parallel,
+		* secondaries execute in list order so blending order is kept.
+		*/
+		builder.AsyncParallel(static_cast<uint32_t>(m_DrawPackets.GetCount()), [&](VkCommandBuffer cmdBuffer, uint32_t begin, uint32_t end) {
+
+			builder.SetViewPort(cmdBuffer);
+
+			builder.BindDescriptorSet(preRendererSet, cmdBuffer);
+
+			builder.BindDescriptorSet(spriteSet, cmdBuffer);
+
+			m_DrawPackets.RecordRange(begin, end,
+				[&](uint32_t pipeline) {
+					builder.BindPipeline(m_DrawPackets.GetPipelineName(pipeline), cmdBuffer);
+				},
+				[&](uint32_t material) {},
+				[&](const DrawPacketList::Packet& packet) {
+					const auto& meshPack = m_DrawItems[packet.item];
+
+					builder.UpdatePushConstant<uint64_t>([&](auto& push) {
+						push = meshPack->GetMeshDesc().GetBufferAddress();
+					}, cmdBuffer);
+
+					meshPack->OnBind(cmdBuffer);
+					meshPack->OnDraw(cmdBuffer);
+				}
+			);
+		});
 
 		builder.EndRenderPass();
 	}
@@ -7,6 +7,7 @@
 #pragma once
 #include "Core/Core.h"
 #include "Render/Renderer/Renderer.h"
+#include "Render/Renderer/DrawPacket/DrawPacketList.h"
 
 namespace Spices {
 
@@ -64,6 +65,18 @@ namespace Spices {
 		* Create specific descriptor set for sub pass.
 		*/
 		virtual void CreateDescriptorSet() override;
+
+	private:
+
+		/**
+		* @brief Draws of MeshPacks sorted by state and depth.
+		*/
+		DrawPacketList m_DrawPackets;
+
+		/**
+		* @brief MeshPacks indexed by draw packet item.
+		*/
+		std::vector<std::shared_ptr<MeshPack>> m_DrawItems;
 	};
 
 }
\ No newline at end of file
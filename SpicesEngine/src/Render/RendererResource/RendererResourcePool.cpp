@@ -38,10 +38,66 @@ namespace Spices {
 		return m_RendererResource[info.name]->GetTexture()->GetResource<VulkanImage>()->GetImageInfo();
 	}
 
+	VkDescriptorImageInfo* RendererResourcePool::AccessExportedResource(const RendererResourceCreateInfo& info)
+	{
+		SPICES_PROFILE_ZONE;
+
+		ExportResource(info.name);
+
+		return AccessResource(info);
+	}
+
 	std::shared_ptr<VulkanImage> RendererResourcePool::AccessRowResource(const std::string& name)
 	{
 		SPICES_PROFILE_ZONE;
 
+		ExportResource(name);
+
 		return m_RendererResource[name]->GetTexture()->GetResource<VulkanImage>();
 	}
+
+	void RendererResourcePool::CompileRenderGraph()
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (uint32_t i = 0; i < m_RenderGraph.GetResourceCount(); i++)
+		{
+			const auto it = m_RendererResource.find(m_RenderGraph.GetResourceName(i));
+			if (it == m_RendererResource.end()) continue;
+
+			const VkMemoryRequirements requirements = it->second->GetTexture()->GetResource<VulkanImage>()->GetMemoryRequirements();
+			m_RenderGraph.SetResourceSize(i, requirements.size, requirements.alignment);
+		}
+
+		m_RenderGraph.Compile();
+
+		const auto& stats = m_RenderGraph.GetStats();
+		constexpr double MB = 1024.0 * 1024.0;
+
+		std::stringstream ss;
+		ss << "RenderGraph diagnostic: " << m_RenderGraph.GetPassCount() << " passes, " << stats.unaliasedBytes / MB << " MB of attachments, "
+		   << stats.transientCount << " transient attachments with disjoint lifetimes in " << stats.blockCount << " blocks (aliasing not implemented).";
+
+		SPICES_CORE_INFO(ss.str());
+	}
+
+	void RendererResourcePool::ExportResource(const std::string& name)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const uint32_t resource = m_RenderGraph.FindResource(name);
+		if (resource != RenderGraph::Invalid && m_RenderGraph.IsExported(resource)) return;
+
+		const bool isCompiled = m_RenderGraph.IsCompiled();
+
+		m_RenderGraph.Export(m_RenderGraph.AddResource(name));
+
+		/**
+		* @brief Exported after compiled, by a reader created later than renderers.
+		*/
+		if (isCompiled)
+		{
+			CompileRenderGraph();
+		}
+	}
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #pragma once
 #include "Core/Core.h"
 #include "RendererResource.h"
+#include "Render/RenderGraph/RenderGraph.h"
 
 #include <unordered_map>
 #include <memory>
@@ -60,17 +61,51 @@ namespace Spices {
 			const RendererResourceCreateInfo& info = RendererResourceCreateInfo{}
 		);
 
+		/**
+		* @brief Get Resource read outside renderers (viewport, visualizers), create it if it have not been created.
+		* The resource is exported from RenderGraph, so its content is kept across frames.
+		* @param[in] info The info used for create resource.
+		* @return Returns the view of the resource.
+		*/
+		VkDescriptorImageInfo* AccessExportedResource(const RendererResourceCreateInfo& info);
+
 		/**
 		* @brief Get Row Resource with specific name.
+		* The resource is exported from RenderGraph, as the image may be read outside renderers.
 		* @param[in] name The name of Resource/
 		*/
 		std::shared_ptr<VulkanImage> AccessRowResource(const std::string& name);
 
+		/**
+		* @brief Get RenderGraph of sub passes accessing resources in this pool.
+		* @return Returns the RenderGraph.
+		*/
+		RenderGraph& GetRenderGraph() { return m_RenderGraph; }
+
+		/**
+		* @brief Compile RenderGraph with current resource sizes and log attachment lifetimes.
+		* Diagnostic only: attachments own their memory and render passes their own barriers, nothing is aliased.
+		*/
+		void CompileRenderGraph();
+
+	private:
+
+		/**
+		* @brief Export a resource from RenderGraph, recompile it if it was compiled.
+		* @param[in] name The name of Resource.
+		*/
+		void ExportResource(const std::string& name);
+
 	private:
 
 		/**
 		* @brief The hashmap of all RendererResource.
 		*/
 		std::unordered_map<std::string, std::unique_ptr<RendererResource>> m_RendererResource;
+
+		/**
+		* @brief Passes and resources access of all Renderer.
+		*/
+		RenderGraph m_RenderGraph;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,169 @@
+/**
+* @file BufferUploadTracker.cpp.
+* @brief The BufferUploadTracker Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "BufferUploadTracker.h"
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Statistics of current frame.
+		*/
+		std::atomic<uint64_t> s_Bytes   { 0 };
+		std::atomic<uint64_t> s_Ranges  { 0 };
+		std::atomic<uint64_t> s_Flushes { 0 };
+
+		/**
+		* @brief Statistics of last frame.
+		*/
+		std::atomic<uint64_t> s_LastBytes   { 0 };
+		std::atomic<uint64_t> s_LastRanges  { 0 };
+		std::atomic<uint64_t> s_LastFlushes { 0 };
+	}
+
+	BufferUploadTracker::BufferUploadTracker(VkDeviceSize size, VkDeviceSize granularity, VkDeviceSize mergeGap)
+		: m_Size(size)
+		, m_Granularity(std::max<VkDeviceSize>(granularity, 1))
+		, m_MergeGap(mergeGap)
+		, m_Shadow(size, 0)
+	{
+		const size_t granules = static_cast<size_t>((size + m_Granularity - 1) / m_Granularity);
+
+		m_Dirty   .resize(granules, 0);
+		m_Uploaded.resize(granules, 0);
+	}
+
+	void BufferUploadTracker::Update(const void* data, VkDeviceSize size, VkDeviceSize offset)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Store(data, size, offset, true);
+	}
+
+	void BufferUploadTracker::Write(const void* data, VkDeviceSize size, VkDeviceSize offset)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Store(data, size, offset, false);
+	}
+
+	std::vector<BufferUploadTracker::Range> BufferUploadTracker::GetDirtyRanges() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::vector<Range> ranges;
+		if (m_DirtyCount == 0) return ranges;
+
+		for (size_t g = 0; g < m_Dirty.size(); g++)
+		{
+			if (!m_Dirty[g]) continue;
+
+			const VkDeviceSize begin = g * m_Granularity;
+			const VkDeviceSize end   = std::min(begin + m_Granularity, m_Size);
+
+			/**
+			* @brief Merge if the gap costs less than another range.
+			*/
+			if (!ranges.empty() && begin - (ranges.back().offset + ranges.back().size) <= m_MergeGap)
+			{
+				ranges.back().size = end - ranges.back().offset;
+			}
+			else
+			{
+				ranges.push_back({ begin, end - begin });
+			}
+		}
+
+		return ranges;
+	}
+
+	std::vector<BufferUploadTracker::Range> BufferUploadTracker::Commit()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::vector<Range> ranges = GetDirtyRanges();
+		if (ranges.empty()) return ranges;
+
+		uint64_t bytes = 0;
+		for (const auto& range : ranges)
+		{
+			const size_t g0 = static_cast<size_t>(range.offset / m_Granularity);
+			const size_t g1 = static_cast<size_t>((range.offset + range.size - 1) / m_Granularity);
+
+			std::fill(m_Uploaded.begin() + g0, m_Uploaded.begin() + g1 + 1, static_cast<uint8_t>(1));
+			bytes += range.size;
+		}
+
+		std::fill(m_Dirty.begin(), m_Dirty.end(), static_cast<uint8_t>(0));
+		m_DirtyCount = 0;
+
+		s_Bytes   += bytes;
+		s_Ranges  += ranges.size();
+		s_Flushes += 1;
+
+		return ranges;
+	}
+
+	void BufferUploadTracker::BeginFrame()
+	{
+		SPICES_PROFILE_ZONE;
+
+		s_LastBytes   = s_Bytes  .exchange(0);
+		s_LastRanges  = s_Ranges .exchange(0);
+		s_LastFlushes = s_Flushes.exchange(0);
+	}
+
+	BufferUploadTracker::Stats BufferUploadTracker::GetFrameStats()
+	{
+		return { s_LastBytes.load(), s_LastRanges.load(), s_LastFlushes.load() };
+	}
+
+	void BufferUploadTracker::Store(const void* data, VkDeviceSize size, VkDeviceSize offset, bool diff)
+	{
+		if (size == VK_WHOLE_SIZE)
+		{
+			size = m_Size - offset;
+		}
+
+		if (size == 0) return;
+
+		if (offset + size > m_Size)
+		{
+			SPICES_CORE_ERROR("BufferUploadTracker: write out of buffer range.");
+			return;
+		}
+
+		const uint8_t* src = static_cast<const uint8_t*>(data);
+
+		const size_t g0 = static_cast<size_t>(offset / m_Granularity);
+		const size_t g1 = static_cast<size_t>((offset + size - 1) / m_Granularity);
+
+		for (size_t g = g0; g <= g1; g++)
+		{
+			const VkDeviceSize begin = std::max<VkDeviceSize>(g * m_Granularity, offset);
+			const VkDeviceSize end   = std::min<VkDeviceSize>((g + 1) * m_Granularity, offset + size);
+
+			uint8_t*       dst = m_Shadow.data() + begin;
+			const uint8_t* in  = src + (begin - offset);
+			const size_t   n   = static_cast<size_t>(end - begin);
+
+			if (diff && m_Uploaded[g] && memcmp(dst, in, n) == 0) continue;
+
+			memcpy(dst, in, n);
+			MarkDirty(g);
+		}
+	}
+
+	void BufferUploadTracker::MarkDirty(size_t granule)
+	{
+		if (m_Dirty[granule]) return;
+
+		m_Dirty[granule] = 1;
+		m_DirtyCount++;
+	}
+}
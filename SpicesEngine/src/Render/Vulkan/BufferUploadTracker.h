@@ -0,0 +1,169 @@
+/**
+* @file BufferUploadTracker.h.
+* @brief The BufferUploadTracker Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+namespace Spices {
+
+	/**
+	* @brief Change tracked host copy of a buffer.
+	* Writes go to a shadow copy, either diffed against last uploaded data or marked dirty explicitly.
+	* Commit returns coalesced dirty ranges, copied and flushed together by VulkanBuffer::FlushDirtyRanges.
+	* Independent of Vulkan objects.
+	*/
+	class BufferUploadTracker
+	{
+	public:
+
+		/**
+		* @brief A byte range of the buffer.
+		*/
+		struct Range
+		{
+			VkDeviceSize offset = 0;     /* @brief First byte. */
+			VkDeviceSize size   = 0;     /* @brief Bytes.      */
+
+			bool operator==(const Range& other) const { return offset == other.offset && size == other.size; }
+		};
+
+		/**
+		* @brief Upload statistics.
+		*/
+		struct Stats
+		{
+			uint64_t bytes   = 0;        /* @brief Bytes uploaded.        */
+			uint64_t ranges  = 0;        /* @brief Ranges uploaded.       */
+			uint64_t flushes = 0;        /* @brief Buffer flushes issued. */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] size Buffer size.
+		* @param[in] granularity Bytes compared and uploaded as one unit, multiple of nonCoherentAtomSize (at most 256).
+		* @param[in] mergeGap Ranges separated by no more than this bytes are merged.
+		*/
+		BufferUploadTracker(VkDeviceSize size, VkDeviceSize granularity = 256, VkDeviceSize mergeGap = 1024);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~BufferUploadTracker() = default;
+
+		/**
+		* @brief Write data, only parts differ from last uploaded data become dirty.
+		* @param[in] data Source data.
+		* @param[in] size Bytes, VK_WHOLE_SIZE means to the end.
+		* @param[in] offset Buffer offset.
+		*/
+		void Update(const void* data, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+
+		/**
+		* @brief Write data, the whole range becomes dirty.
+		* @param[in] data Source data.
+		* @param[in] size Bytes, VK_WHOLE_SIZE means to the end.
+		* @param[in] offset Buffer offset.
+		*/
+		void Write(const void* data, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+
+		/**
+		* @brief Whether any range is waiting for upload.
+		* @return Returns true if dirty.
+		*/
+		bool IsDirty() const { return m_DirtyCount > 0; }
+
+		/**
+		* @brief Get coalesced dirty ranges.
+		* @return Returns ranges in ascending order.
+		*/
+		std::vector<Range> GetDirtyRanges() const;
+
+		/**
+		* @brief Take dirty ranges for upload, clear dirty and count statistics.
+		* @return Returns ranges in ascending order, read data from GetShadow().
+		*/
+		std::vector<Range> Commit();
+
+		/**
+		* @brief Get shadow copy.
+		* @return Returns shadow copy.
+		*/
+		const uint8_t* GetShadow() const { return m_Shadow.data(); }
+
+		/**
+		* @brief Get buffer size.
+		* @return Returns buffer size.
+		*/
+		VkDeviceSize GetSize() const { return m_Size; }
+
+		/**
+		* @brief Start statistics of a new frame.
+		*/
+		static void BeginFrame();
+
+		/**
+		* @brief Get statistics of last frame.
+		* @return Returns statistics.
+		*/
+		static Stats GetFrameStats();
+
+	private:
+
+		/**
+		* @brief Copy data to shadow copy.
+		* @param[in] data Source data.
+		* @param[in] size Bytes.
+		* @param[in] offset Buffer offset.
+		* @param[in] diff Only mark granules changed.
+		*/
+		void Store(const void* data, VkDeviceSize size, VkDeviceSize offset, bool diff);
+
+		/**
+		* @brief Mark a granule dirty.
+		* @param[in] granule Granule index.
+		*/
+		void MarkDirty(size_t granule);
+
+	private:
+
+		/**
+		* @brief Buffer size.
+		*/
+		VkDeviceSize m_Size;
+
+		/**
+		* @brief Bytes compared and uploaded as one unit.
+		*/
+		VkDeviceSize m_Granularity;
+
+		/**
+		* @brief Ranges separated by no more than this bytes are merged.
+		*/
+		VkDeviceSize m_MergeGap;
+
+		/**
+		* @brief Shadow copy.
+		*/
+		std::vector<uint8_t> m_Shadow;
+
+		/**
+		* @brief Dirty flag per granule.
+		*/
+		std::vector<uint8_t> m_Dirty;
+
+		/**
+		* @brief Uploaded once flag per granule, never uploaded granules are always dirty.
+		*/
+		std::vector<uint8_t> m_Uploaded;
+
+		/**
+		* @brief Dirty granules count.
+		*/
+		size_t m_DirtyCount = 0;
+	};
+}
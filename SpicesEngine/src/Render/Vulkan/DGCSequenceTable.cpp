@@ -0,0 +1,252 @@
+/**
+* @file DGCSequenceTable.cpp.
+* @brief The DGCSequenceTable Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "DGCSequenceTable.h"
+#include "Core/Memory/FrameAllocator.h"
+
+namespace Spices {
+
+	DGCSequenceTable::DGCSequenceTable(
+		DGCInputBuffer&               buffer      ,
+		const std::vector<uint32_t>&  strides     ,
+		uint32_t                      alignment   ,
+		uint32_t                      minCapacity
+	)
+		: m_Buffer(buffer)
+		, m_Strides(strides)
+		, m_Offsets(strides.size(), 0)
+		, m_Alignment(std::max(alignment, 1u))
+		, m_MinCapacity(std::max(minCapacity, 1u))
+	{}
+
+	uint32_t DGCSequenceTable::Acquire(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (const auto it = m_Slots.find(key); it != m_Slots.end())
+		{
+			m_Epoch[it->second] = m_CurrentEpoch;
+			return it->second;
+		}
+
+		const uint32_t slot = static_cast<uint32_t>(m_Keys.size());
+
+		/**
+		* @brief Grow geometrically, input buffer is recreated on next Commit.
+		*/
+		if (slot == m_Capacity)
+		{
+			Layout(std::max(m_MinCapacity, m_Capacity * 2));
+		}
+
+		m_Keys .push_back(key);
+		m_Dirty.push_back(0);
+		m_Epoch.push_back(m_CurrentEpoch);
+		m_Slots[key] = slot;
+
+		for (size_t i = 0; i < m_Strides.size(); i++)
+		{
+			memset(m_Data.data() + m_Offsets[i] + static_cast<size_t>(slot) * m_Strides[i], 0, m_Strides[i]);
+		}
+
+		MarkDirty(slot);
+
+		return slot;
+	}
+
+	void DGCSequenceTable::Release(uint64_t key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Slots.find(key);
+		if (it == m_Slots.end()) return;
+
+		const uint32_t slot = it->second;
+		const uint32_t last = static_cast<uint32_t>(m_Keys.size()) - 1;
+
+		m_Slots.erase(it);
+
+		/**
+		* @brief Move the last sequence into the hole, only that slot is patched.
+		*/
+		if (slot != last)
+		{
+			for (size_t i = 0; i < m_Strides.size(); i++)
+			{
+				memcpy(
+					m_Data.data() + m_Offsets[i] + static_cast<size_t>(slot) * m_Strides[i],
+					m_Data.data() + m_Offsets[i] + static_cast<size_t>(last) * m_Strides[i],
+					m_Strides[i]
+				);
+			}
+
+			m_Keys [slot]         = m_Keys[last];
+			m_Epoch[slot]         = m_Epoch[last];
+			m_Slots[m_Keys[slot]] = slot;
+
+			MarkDirty(slot);
+		}
+
+		if (m_Dirty[last])
+		{
+			m_DirtyCount--;
+		}
+
+		m_Keys .pop_back();
+		m_Dirty.pop_back();
+		m_Epoch.pop_back();
+	}
+
+	void DGCSequenceTable::BeginSync()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_CurrentEpoch++;
+	}
+
+	void DGCSequenceTable::EndSync()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::pmr::vector<uint64_t> stale(FrameAllocator::GetResource());
+		for (size_t slot = 0; slot < m_Keys.size(); slot++)
+		{
+			if (m_Epoch[slot] != m_CurrentEpoch)
+			{
+				stale.push_back(m_Keys[slot]);
+			}
+		}
+
+		for (const auto key : stale)
+		{
+			Release(key);
+		}
+	}
+
+	uint32_t DGCSequenceTable::GetSlot(uint64_t key) const
+	{
+		const auto it = m_Slots.find(key);
+		return it != m_Slots.end() ? it->second : std::numeric_limits<uint32_t>::max();
+	}
+
+	void DGCSequenceTable::SetToken(uint32_t slot, uint32_t stream, const void* data)
+	{
+		uint8_t* dst = m_Data.data() + m_Offsets[stream] + static_cast<size_t>(slot) * m_Strides[stream];
+
+		if (memcmp(dst, data, m_Strides[stream]) == 0) return;
+
+		memcpy(dst, data, m_Strides[stream]);
+		MarkDirty(slot);
+	}
+
+	bool DGCSequenceTable::Commit()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Stats = Stats{};
+
+		const uint32_t count = static_cast<uint32_t>(m_Keys.size());
+
+		std::vector<DGCInputBuffer::Region> regions;
+		const bool recreate = m_Recreate;
+
+		if (recreate)
+		{
+			m_Buffer.Create(m_Data.size());
+			m_Stats.creates   = 1;
+			m_Stats.sequences = count;
+
+			for (size_t i = 0; i < m_Strides.size(); i++)
+			{
+				if (count == 0) break;
+				regions.push_back({ m_Offsets[i], static_cast<size_t>(count) * m_Strides[i] });
+			}
+		}
+		else if (m_DirtyCount > 0)
+		{
+			/**
+			* @brief Coalesce dirty slots into ranges, each range is one region per stream.
+			*/
+			uint32_t slot = 0;
+			while (slot < count)
+			{
+				if (!m_Dirty[slot])
+				{
+					slot++;
+					continue;
+				}
+
+				const uint32_t first = slot;
+				while (slot < count && m_Dirty[slot]) slot++;
+
+				m_Stats.sequences += slot - first;
+
+				for (size_t i = 0; i < m_Strides.size(); i++)
+				{
+					regions.push_back({ m_Offsets[i] + static_cast<size_t>(first) * m_Strides[i], static_cast<size_t>(slot - first) * m_Strides[i] });
+				}
+			}
+		}
+
+		if (!regions.empty())
+		{
+			m_Buffer.Upload(m_Data.data(), regions);
+		}
+
+		for (const auto& region : regions)
+		{
+			m_Stats.bytes += region.size;
+		}
+		m_Stats.regions = static_cast<uint32_t>(regions.size());
+
+		std::fill(m_Dirty.begin(), m_Dirty.end(), 0);
+		m_DirtyCount = 0;
+		m_Recreate   = false;
+
+		return recreate;
+	}
+
+	void DGCSequenceTable::Layout(uint32_t capacity)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const size_t alignMask = m_Alignment - 1;
+
+		std::vector<size_t> offsets(m_Strides.size());
+		size_t totalSize = 0;
+
+		for (size_t i = 0; i < m_Strides.size(); i++)
+		{
+			offsets[i] = totalSize;
+			totalSize += (static_cast<size_t>(m_Strides[i]) * capacity + alignMask) & ~alignMask;
+		}
+
+		std::vector<uint8_t> data(totalSize, 0);
+
+		for (size_t i = 0; i < m_Strides.size(); i++)
+		{
+			const size_t live = m_Keys.size() * m_Strides[i];
+			if (live > 0)
+			{
+				memcpy(data.data() + offsets[i], m_Data.data() + m_Offsets[i], live);
+			}
+		}
+
+		m_Data.swap(data);
+		m_Offsets.swap(offsets);
+		m_Capacity = capacity;
+		m_Recreate = true;
+	}
+
+	void DGCSequenceTable::MarkDirty(uint32_t slot)
+	{
+		if (m_Dirty[slot]) return;
+
+		m_Dirty[slot] = 1;
+		m_DirtyCount++;
+	}
+}
@@ -0,0 +1,299 @@
+/**
+* @file DGCSequenceTable.h.
+* @brief The DGCSequenceTable Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+namespace Spices {
+
+	/**
+	* @brief Device side of DGCSequenceTable.
+	* Holds the device generated commands input streams, implemented by VulkanIndirectDrawNV and by mocks in tests.
+	*/
+	class DGCInputBuffer
+	{
+	public:
+
+		/**
+		* @brief A byte range, same offset in host data and device buffer.
+		*/
+		struct Region
+		{
+			size_t offset = 0;     /* @brief First byte. */
+			size_t size   = 0;     /* @brief Bytes.      */
+
+			bool operator==(const Region& other) const { return offset == other.offset && size == other.size; }
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		DGCInputBuffer() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~DGCInputBuffer() = default;
+
+		/**
+		* @brief Create a new input buffer, the old one is dropped.
+		* @param[in] size Buffer size.
+		*/
+		virtual void Create(size_t size) = 0;
+
+		/**
+		* @brief Upload regions of host data into the input buffer.
+		* @param[in] data Host data, laid out as the input buffer.
+		* @param[in] regions Regions to upload.
+		*/
+		virtual void Upload(const uint8_t* data, const std::vector<Region>& regions) = 0;
+	};
+
+	/**
+	* @brief Persistent device generated commands input streams.
+	* Every MeshPack drawn by an entity owns a sequence slot, slots are kept dense by moving the last
+	* sequence into a released slot, so sequence count is always the live count.
+	* Tokens are diffed against the host copy and only changed sequences are uploaded.
+	* Capacity grows geometrically, the input buffer is only recreated on growth.
+	*/
+	class DGCSequenceTable
+	{
+	public:
+
+		/**
+		* @brief Statistics of last Commit.
+		*/
+		struct Stats
+		{
+			uint32_t creates   = 0;     /* @brief Input buffer recreated.    */
+			uint32_t sequences = 0;     /* @brief Sequences uploaded.        */
+			uint32_t regions   = 0;     /* @brief Regions uploaded.          */
+			size_t   bytes     = 0;     /* @brief Bytes uploaded.            */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] buffer Input buffer, must outlive this table.
+		* @param[in] strides Stride of each stream.
+		* @param[in] alignment Stream offset alignment, minIndirectCommandsBufferOffsetAlignment.
+		* @param[in] minCapacity Sequences capacity of first allocation.
+		*/
+		DGCSequenceTable(
+			DGCInputBuffer&               buffer           ,
+			const std::vector<uint32_t>&  strides          ,
+			uint32_t                      alignment        ,
+			uint32_t                      minCapacity = 64
+		);
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~DGCSequenceTable() = default;
+
+		/**
+		* @brief Build the key of a MeshPack drawn by an entity.
+		* @param[in] entity Entity id.
+		* @param[in] pack MeshPack index in Mesh.
+		* @return Returns sequence key.
+		*/
+		static uint64_t MakeKey(uint32_t entity, uint32_t pack) { return (static_cast<uint64_t>(entity) << 32) | pack; }
+
+		/**
+		* @brief Get or allocate the slot of a sequence.
+		* @param[in] key Sequence key, see MakeKey.
+		* @return Returns the slot, valid until a Release.
+		*/
+		uint32_t Acquire(uint64_t key);
+
+		/**
+		* @brief Free the slot of a sequence, the last sequence moves into it.
+		* @param[in] key Sequence key, see MakeKey.
+		*/
+		void Release(uint64_t key);
+
+		/**
+		* @brief Start a full walk of the world, every key acquired until EndSync is kept alive.
+		*/
+		void BeginSync();
+
+		/**
+		* @brief Release all slots not touched since BeginSync.
+		*/
+		void EndSync();
+
+		/**
+		* @brief Get slot of a sequence.
+		* @param[in] key Sequence key, see MakeKey.
+		* @return Returns the slot, UINT32_MAX if not found.
+		*/
+		uint32_t GetSlot(uint64_t key) const;
+
+		/**
+		* @brief Set a token of a sequence, marks the sequence dirty only if it changed.
+		* @param[in] slot Slot.
+		* @param[in] stream Stream index.
+		* @param[in] data Token data, stride of the stream bytes.
+		*/
+		void SetToken(uint32_t slot, uint32_t stream, const void* data);
+
+		/**
+		* @brief Get a token of a sequence.
+		* @param[in] slot Slot.
+		* @param[in] stream Stream index.
+		* @return Returns token data.
+		*/
+		const uint8_t* GetToken(uint32_t slot, uint32_t stream) const { return m_Data.data() + m_Offsets[stream] + static_cast<size_t>(slot) * m_Strides[stream]; }
+
+		/**
+		* @brief Upload changed sequences, recreate input buffer if capacity grew.
+		* @return Returns true if input buffer was recreated, streams and preprocess buffer need rebind.
+		*/
+		bool Commit();
+
+		/**
+		* @brief Get sequences count.
+		* @return Returns sequences count.
+		*/
+		uint32_t GetSequenceCount() const { return static_cast<uint32_t>(m_Keys.size()); }
+
+		/**
+		* @brief Get sequences capacity of input buffer.
+		* @return Returns sequences capacity.
+		*/
+		uint32_t GetCapacity() const { return m_Capacity; }
+
+		/**
+		* @brief Get streams strides.
+		* @return Returns streams strides.
+		*/
+		const std::vector<uint32_t>& GetStrides() const { return m_Strides; }
+
+		/**
+		* @brief Get streams offsets in input buffer.
+		* @return Returns streams offsets.
+		*/
+		const std::vector<size_t>& GetStreamOffsets() const { return m_Offsets; }
+
+		/**
+		* @brief Get input buffer size.
+		* @return Returns bytes.
+		*/
+		size_t GetSize() const { return m_Data.size(); }
+
+		/**
+		* @brief Get host copy of input buffer.
+		* @return Returns host data.
+		*/
+		const std::vector<uint8_t>& GetData() const { return m_Data; }
+
+		/**
+		* @brief Get number of dirty sequences.
+		* @return Returns dirty sequences count.
+		*/
+		uint32_t GetDirtyCount() const { return m_DirtyCount; }
+
+		/**
+		* @brief Get statistics of last Commit.
+		* @return Returns statistics.
+		*/
+		const Stats& GetStats() const { return m_Stats; }
+
+	private:
+
+		/**
+		* @brief Lay out streams for a capacity, keeping live sequences.
+		* @param[in] capacity Sequences capacity.
+		*/
+		void Layout(uint32_t capacity);
+
+		/**
+		* @brief Mark a slot dirty.
+		* @param[in] slot Slot.
+		*/
+		void MarkDirty(uint32_t slot);
+
+	private:
+
+		/**
+		* @brief Input buffer.
+		*/
+		DGCInputBuffer& m_Buffer;
+
+		/**
+		* @brief Streams strides.
+		*/
+		std::vector<uint32_t> m_Strides;
+
+		/**
+		* @brief Streams offsets.
+		*/
+		std::vector<size_t> m_Offsets;
+
+		/**
+		* @brief Stream offset alignment.
+		*/
+		size_t m_Alignment;
+
+		/**
+		* @brief Sequences capacity of first allocation.
+		*/
+		uint32_t m_MinCapacity;
+
+		/**
+		* @brief Sequences capacity.
+		*/
+		uint32_t m_Capacity = 0;
+
+		/**
+		* @brief Host copy of input buffer.
+		*/
+		std::vector<uint8_t> m_Data;
+
+		/**
+		* @brief Key of slots.
+		*/
+		std::vector<uint64_t> m_Keys;
+
+		/**
+		* @brief Per slot dirty flag.
+		*/
+		std::vector<uint8_t> m_Dirty;
+
+		/**
+		* @brief Per slot sync epoch, used by BeginSync / EndSync.
+		*/
+		std::vector<uint32_t> m_Epoch;
+
+		/**
+		* @brief Sequence key to slot.
+		*/
+		std::unordered_map<uint64_t, uint32_t> m_Slots;
+
+		/**
+		* @brief Dirty slots count.
+		*/
+		uint32_t m_DirtyCount = 0;
+
+		/**
+		* @brief Current sync epoch.
+		*/
+		uint32_t m_CurrentEpoch = 0;
+
+		/**
+		* @brief True if input buffer needs to be recreated.
+		*/
+		bool m_Recreate = false;
+
+		/**
+		* @brief Statistics of last Commit.
+		*/
+		Stats m_Stats;
+	};
+}
@@ -0,0 +1,126 @@
+/**
+* @file SecondaryCmdCache.cpp.
+* @brief The SecondaryCmdCache Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "SecondaryCmdCache.h"
+
+namespace Spices {
+
+	ContentHash& ContentHash::AddBytes(const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+		for (size_t i = 0; i < size; i++)
+		{
+			m_Hash ^= bytes[i];
+			m_Hash *= 1099511628211ull;
+		}
+
+		return *this;
+	}
+
+	SecondaryCmdCache::SecondaryCmdCache(AllocateFunc allocate, FreeFunc free)
+		: m_Allocate(std::move(allocate))
+		, m_Free(std::move(free))
+	{}
+
+	SecondaryCmdCache::~SecondaryCmdCache()
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (auto& pair : m_Entries)
+		{
+			for (auto& entry : pair.second)
+			{
+				if (entry.cmd != VK_NULL_HANDLE)
+				{
+					m_Free(entry.cmd);
+				}
+			}
+		}
+	}
+
+	SecondaryCmdCache::Entry& SecondaryCmdCache::Find(const std::string& key, uint32_t frameIndex, uint64_t hash, bool& isHit)
+	{
+		auto& entries = m_Entries[key];
+		if (entries.size() <= frameIndex)
+		{
+			entries.resize(frameIndex + 1);
+		}
+
+		Entry& entry = entries[frameIndex];
+
+		isHit = entry.valid && entry.hash == hash;
+
+		if (isHit)
+		{
+			m_Stats.hits++;
+			m_Stats.savedMs += entry.recordMs;
+		}
+
+		return entry;
+	}
+
+	std::chrono::steady_clock::time_point SecondaryCmdCache::BeginRecord(Entry& entry)
+	{
+		if (entry.cmd == VK_NULL_HANDLE)
+		{
+			entry.cmd = m_Allocate();
+		}
+
+		return std::chrono::steady_clock::now();
+	}
+
+	void SecondaryCmdCache::EndRecord(Entry& entry, uint64_t hash, std::chrono::steady_clock::time_point begin)
+	{
+		entry.recordMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+		entry.hash     = hash;
+		entry.valid    = true;
+
+		m_Stats.misses++;
+		m_Stats.recordMs += entry.recordMs;
+	}
+
+	void SecondaryCmdCache::Invalidate()
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (auto& pair : m_Entries)
+		{
+			for (auto& entry : pair.second)
+			{
+				entry.valid = false;
+			}
+		}
+	}
+
+	void SecondaryCmdCache::Invalidate(const std::string& key)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto it = m_Entries.find(key);
+		if (it == m_Entries.end()) return;
+
+		for (auto& entry : it->second)
+		{
+			entry.valid = false;
+		}
+	}
+
+	size_t SecondaryCmdCache::GetCommandBufferCount() const
+	{
+		size_t count = 0;
+		for (const auto& pair : m_Entries)
+		{
+			for (const auto& entry : pair.second)
+			{
+				if (entry.cmd != VK_NULL_HANDLE) count++;
+			}
+		}
+
+		return count;
+	}
+}
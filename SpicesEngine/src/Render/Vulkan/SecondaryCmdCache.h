@@ -0,0 +1,269 @@
+/**
+* @file SecondaryCmdCache.h.
+* @brief The SecondaryCmdCache Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <functional>
+#include <type_traits>
+#include <chrono>
+
+namespace Spices {
+
+	/**
+	* @brief FNV-1a hash of the state bound by a recorded command buffer.
+	* Only add values whose bytes fully define them, padding bytes of structs are hashed as well.
+	*/
+	class ContentHash
+	{
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		ContentHash() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~ContentHash() = default;
+
+		/**
+		* @brief Add a trivially copyable value.
+		* @tparam T Value type.
+		* @param[in] value Value.
+		* @return Returns this.
+		*/
+		template<typename T>
+		ContentHash& Add(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "ContentHash only adds trivially copyable values.");
+
+			return AddBytes(&value, sizeof(T));
+		}
+
+		/**
+		* @brief Add a string, length is added as well.
+		* @param[in] value String.
+		* @return Returns this.
+		*/
+		ContentHash& Add(const std::string& value)
+		{
+			Add(value.size());
+			return AddBytes(value.data(), value.size());
+		}
+
+		/**
+		* @brief Add raw bytes.
+		* @param[in] data Bytes.
+		* @param[in] size Bytes count.
+		* @return Returns this.
+		*/
+		ContentHash& AddBytes(const void* data, size_t size);
+
+		/**
+		* @brief Get hash.
+		* @return Returns hash.
+		*/
+		uint64_t Get() const { return m_Hash; }
+
+	private:
+
+		/**
+		* @brief FNV-1a hash, starts from offset basis.
+		*/
+		uint64_t m_Hash = 14695981039346656037ull;
+	};
+
+	/**
+	* @brief Cache of recorded secondary command buffers.
+	* A subpass whose bound state did not change executes the secondary recorded in a previous frame
+	* instead of recording it again. Entries are kept per frame in flight, an entry is only re-recorded
+	* when the fence of its frame is signaled, so a command buffer in use by GPU is never reset.
+	* Command buffers are allocated and freed by callbacks, VkCommandBuffer is only a handle here.
+	*/
+	class SecondaryCmdCache
+	{
+	public:
+
+		/**
+		* @brief Statistics since last ResetStats.
+		*/
+		struct Stats
+		{
+			uint32_t hits      = 0;       /* @brief Cached command buffers executed.           */
+			uint32_t misses    = 0;       /* @brief Command buffers recorded.                  */
+			double   recordMs  = 0.0;     /* @brief CPU time spent recording.                  */
+			double   savedMs   = 0.0;     /* @brief CPU time hits would have spent recording.  */
+		};
+
+		/**
+		* @brief Allocate a secondary command buffer.
+		*/
+		using AllocateFunc = std::function<VkCommandBuffer()>;
+
+		/**
+		* @brief Free a secondary command buffer.
+		*/
+		using FreeFunc = std::function<void(VkCommandBuffer)>;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] allocate Allocate callback.
+		* @param[in] free Free callback.
+		*/
+		SecondaryCmdCache(AllocateFunc allocate, FreeFunc free);
+
+		/**
+		* @brief Destructor Function.
+		* Frees all command buffers.
+		*/
+		virtual ~SecondaryCmdCache();
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		SecondaryCmdCache(const SecondaryCmdCache&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		SecondaryCmdCache& operator=(const SecondaryCmdCache&) = delete;
+
+		/**
+		* @brief Get the command buffer of a key, record it only if hash changed or it was invalidated.
+		* @param[in] key Subpass key, e.g. Renderer.SubPass.
+		* @param[in] frameIndex Frame in flight index.
+		* @param[in] hash Content hash of bound state.
+		* @param[in] record Record callback, called with the command buffer, including begin and end.
+		* @return Returns the command buffer to execute.
+		*/
+		template<typename F>
+		VkCommandBuffer Get(
+			const std::string&  key        ,
+			uint32_t            frameIndex ,
+			uint64_t            hash       ,
+			F&&                 record
+		);
+
+		/**
+		* @brief Invalidate all entries, e.g. on world change or resize.
+		*/
+		void Invalidate();
+
+		/**
+		* @brief Invalidate entries of a key.
+		* @param[in] key Subpass key.
+		*/
+		void Invalidate(const std::string& key);
+
+		/**
+		* @brief Get statistics.
+		* @return Returns statistics.
+		*/
+		const Stats& GetStats() const { return m_Stats; }
+
+		/**
+		* @brief Reset statistics.
+		*/
+		void ResetStats() { m_Stats = Stats{}; }
+
+		/**
+		* @brief Get count of allocated command buffers.
+		* @return Returns command buffers count.
+		*/
+		size_t GetCommandBufferCount() const;
+
+	private:
+
+		/**
+		* @brief A recorded command buffer.
+		*/
+		struct Entry
+		{
+			VkCommandBuffer cmd      = VK_NULL_HANDLE;     /* @brief Command buffer.                */
+			uint64_t        hash     = 0;                  /* @brief Content hash when recorded.    */
+			bool            valid    = false;              /* @brief False if needs recording.      */
+			double          recordMs = 0.0;                /* @brief CPU time of last recording.    */
+		};
+
+		/**
+		* @brief Find the entry of a key and frame, counts a hit if it can be reused.
+		* @param[in] key Subpass key.
+		* @param[in] frameIndex Frame in flight index.
+		* @param[in] hash Content hash of bound state.
+		* @param[out] isHit True if entry can be reused.
+		* @return Returns the entry.
+		*/
+		Entry& Find(const std::string& key, uint32_t frameIndex, uint64_t hash, bool& isHit);
+
+		/**
+		* @brief Allocate the command buffer of an entry if needed.
+		* @param[in] entry Entry.
+		* @return Returns begin time of recording.
+		*/
+		std::chrono::steady_clock::time_point BeginRecord(Entry& entry);
+
+		/**
+		* @brief Mark an entry recorded and count a miss.
+		* @param[in] entry Entry.
+		* @param[in] hash Content hash of bound state.
+		* @param[in] begin Begin time of recording.
+		*/
+		void EndRecord(Entry& entry, uint64_t hash, std::chrono::steady_clock::time_point begin);
+
+		/**
+		* @brief Allocate callback.
+		*/
+		AllocateFunc m_Allocate;
+
+		/**
+		* @brief Free callback.
+		*/
+		FreeFunc m_Free;
+
+		/**
+		* @brief Entries of keys, indexed by frame in flight.
+		*/
+		std::unordered_map<std::string, std::vector<Entry>> m_Entries;
+
+		/**
+		* @brief Statistics.
+		*/
+		Stats m_Stats;
+	};
+
+	template<typename F>
+	VkCommandBuffer SecondaryCmdCache::Get(
+		const std::string&  key        ,
+		uint32_t            frameIndex ,
+		uint64_t            hash       ,
+		F&&                 record
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		bool isHit = false;
+		Entry& entry = Find(key, frameIndex, hash, isHit);
+
+		if (isHit) return entry.cmd;
+
+		/**
+		* @brief Record again, begin resets the command buffer implicitly.
+		*/
+		const auto begin = BeginRecord(entry);
+
+		record(entry.cmd);
+
+		EndRecord(entry, hash, begin);
+
+		return entry.cmd;
+	}
+}
@@ -239,6 +239,95 @@ namespace Spices {
 		
 	}
 
+	void VulkanBuffer::UpdateBuffer(const void* data, VkDeviceSize size, VkDeviceSize offset)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_UploadTracker)
+		{
+			m_UploadTracker = std::make_unique<BufferUploadTracker>(m_DeviceSize);
+		}
+
+		m_UploadTracker->Update(data, size, offset);
+	}
+
+	void VulkanBuffer::WriteDirtyRange(const void* data, VkDeviceSize size, VkDeviceSize offset)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_UploadTracker)
+		{
+			m_UploadTracker = std::make_unique<BufferUploadTracker>(m_DeviceSize);
+		}
+
+		m_UploadTracker->Write(data, size, offset);
+	}
+
+	void VulkanBuffer::FlushDirtyRanges()
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_UploadTracker || !m_UploadTracker->IsDirty()) return;
+
+		const auto ranges = m_UploadTracker->Commit();
+		const uint8_t* shadow = m_UploadTracker->GetShadow();
+
+#ifdef VMA_ALLOCATOR
+
+		void* mapped = nullptr;
+		VK_CHECK(vmaMapMemory(m_VulkanState.m_VmaAllocator, m_Alloc, &mapped))
+
+		std::vector<VmaAllocation> allocations(ranges.size(), m_Alloc);
+		std::vector<VkDeviceSize>  offsets;
+		std::vector<VkDeviceSize>  sizes;
+
+		for (const auto& range : ranges)
+		{
+			memcpy(static_cast<uint8_t*>(mapped) + range.offset, shadow + range.offset, range.size);
+
+			offsets.push_back(range.offset);
+			sizes  .push_back(range.size);
+		}
+
+		vmaUnmapMemory(m_VulkanState.m_VmaAllocator, m_Alloc);
+
+		/**
+		* @brief Flush all ranges in one call.
+		*/
+		VK_CHECK(vmaFlushAllocations(m_VulkanState.m_VmaAllocator, static_cast<uint32_t>(ranges.size()), allocations.data(), offsets.data(), sizes.data()))
+
+#else
+
+		if (!m_LocalMemory) { Map(); }
+
+		std::vector<VkMappedMemoryRange> mappedRanges;
+		mappedRanges.reserve(ranges.size());
+
+		for (const auto& range : ranges)
+		{
+			memcpy(static_cast<uint8_t*>(m_LocalMemory) + range.offset, shadow + range.offset, range.size);
+
+			/**
+			* @brief Ranges are aligned to nonCoherentAtomSize, except the last one reaching buffer end.
+			*/
+			VkMappedMemoryRange                             mappedRange {};
+			mappedRange.sType                             = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+			mappedRange.memory                            = m_BufferMemory;
+			mappedRange.offset                            = range.offset;
+			mappedRange.size                              = range.offset + range.size == m_DeviceSize ? VK_WHOLE_SIZE : range.size;
+
+			mappedRanges.push_back(mappedRange);
+		}
+
+		/**
+		* @brief Flush all ranges in one call.
+		*/
+		VK_CHECK(vkFlushMappedMemoryRanges(m_VulkanState.m_Device, static_cast<uint32_t>(mappedRanges.size()), mappedRanges.data()))
+
+#endif
+
+	}
+
 	void VulkanBuffer::CreateBuffer(
 		VulkanState&          vulkanState , 
 		const std::string&    name        , 
@@ -7,6 +7,7 @@
 #pragma once
 #include "Core/Core.h"
 #include "VulkanUtils.h"
+#include "BufferUploadTracker.h"
 
 namespace Spices {
 
@@ -119,6 +120,36 @@ namespace Spices {
 			VkDeviceSize offset = 0
 		) const;
 
+		/**
+		* @brief Write data to the buffer's shadow copy, only changed parts are uploaded by FlushDirtyRanges.
+		* Do not mix with WriteToBuffer on the same buffer.
+		* @param[in] data The data pointer.
+		* @param[in] size The data size.
+		* @param[in] offset The buffer video memory offset.
+		*/
+		void UpdateBuffer(
+			const void*  data                   ,
+			VkDeviceSize size   = VK_WHOLE_SIZE ,
+			VkDeviceSize offset = 0
+		);
+
+		/**
+		* @brief Write data to the buffer's shadow copy, the whole range is uploaded by FlushDirtyRanges.
+		* @param[in] data The data pointer.
+		* @param[in] size The data size.
+		* @param[in] offset The buffer video memory offset.
+		*/
+		void WriteDirtyRange(
+			const void*  data                   ,
+			VkDeviceSize size   = VK_WHOLE_SIZE ,
+			VkDeviceSize offset = 0
+		);
+
+		/**
+		* @brief Copy coalesced dirty ranges to video memory and flush them in one call.
+		*/
+		void FlushDirtyRanges();
+
 		/**
 		* @brief Get Buffer Size.
 		* @return Returns Buffer Size.
@@ -185,6 +216,11 @@ namespace Spices {
 		*/
 		VkDeviceAddress m_BufferAddress{};
 
+		/**
+		* @brief Shadow copy of tracked uploads, created on first UpdateBuffer / WriteDirtyRange.
+		*/
+		std::unique_ptr<BufferUploadTracker> m_UploadTracker;
+
 #ifdef VMA_ALLOCATOR
 
 		/**
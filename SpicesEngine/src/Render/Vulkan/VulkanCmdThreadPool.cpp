@@ -76,6 +76,13 @@ namespace Spices {
 			SetMode(PoolMode::MODE_FIXED);
 			Start(nCmdThreads);
 		}
+
+		/**
+		* @brief Init RecordParallel, range i runs on thread i, which owns CommandPool i.
+		*/
+		m_Scheduler = std::make_unique<RangeScheduler>(nCmdThreads, [this](uint32_t worker, std::function<void()> task) {
+			SubmitThreadTask_LightWeight(worker, [task](VkCommandBuffer) { task(); });
+		});
 	}
 
 	VulkanCmdThreadPool::~VulkanCmdThreadPool()
@@ -8,6 +8,7 @@
 #include "Core/Core.h"
 #include "VulkanUtils.h"
 #include "Core/Thread/ThreadPoolBasic.h"
+#include "Core/Thread/RangeScheduler.h"
 #include "VulkanCommandBuffer.h"
 #include "Render/FrameInfo.h"
 
@@ -65,6 +66,30 @@ namespace Spices {
 		*/
 		std::vector<VkCommandBuffer>& GetCommandBuffers(int frameIndex) { return m_CmdBuffers[frameIndex]; }
 
+		/**
+		* @brief Record a list in parallel, without pool task queue.
+		* The list is split into one contiguous range per thread, each range is a thread task recording
+		* into the thread's own secondary CommandBuffer of this frame, and all threads are joined once.
+		* @param[in] frameIndex FrameIndex in FrameInfo.
+		* @param[in] beginInfo Secondary CommandBuffer begin info.
+		* @param[in] count Items count.
+		* @param[in] func Record function, called with cmdBuffer, first item and one past last item.
+		* @return Returns recorded CommandBuffers in list order.
+		*/
+		template<typename F>
+		std::vector<VkCommandBuffer> RecordParallel(
+			uint32_t                         frameIndex , 
+			const VkCommandBufferBeginInfo&  beginInfo  , 
+			uint32_t                         count      , 
+			F&&                              func
+		);
+
+		/**
+		* @brief Get RangeScheduler used by RecordParallel.
+		* @return Returns RangeScheduler, with per worker recording time of last RecordParallel.
+		*/
+		const RangeScheduler& GetScheduler() const { return *m_Scheduler; }
+
 	private:
 
 		/**
@@ -76,8 +101,50 @@ namespace Spices {
 		* @brief Parallel Secondary CommandBuffers.
 		*/
 		std::array<std::vector<VkCommandBuffer>, MaxFrameInFlight> m_CmdBuffers;
+
+		/**
+		* @brief Splits RecordParallel lists over threads of this pool.
+		*/
+		std::unique_ptr<RangeScheduler> m_Scheduler;
 	};
 
+	template<typename F>
+	inline std::vector<VkCommandBuffer> VulkanCmdThreadPool::RecordParallel(
+		uint32_t                         frameIndex , 
+		const VkCommandBufferBeginInfo&  beginInfo  , 
+		uint32_t                         count      , 
+		F&&                              func
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Scheduler->Run(count, [&](uint32_t worker, uint32_t begin, uint32_t end) {
+
+			VkCommandBuffer cmdBuffer = m_CmdBuffers[frameIndex][worker];
+
+			VK_CHECK(vkBeginCommandBuffer(cmdBuffer, &beginInfo))
+
+			func(cmdBuffer, begin, end);
+
+			VK_CHECK(vkEndCommandBuffer(cmdBuffer))
+		});
+
+		/**
+		* @brief Empty ranges are not recorded, they are always at tail.
+		*/
+		std::vector<VkCommandBuffer> cmdBuffers;
+		const auto& ranges = m_Scheduler->GetRanges();
+		for (uint32_t i = 0; i < ranges.size(); i++)
+		{
+			if (ranges[i].begin < ranges[i].end)
+			{
+				cmdBuffers.push_back(m_CmdBuffers[frameIndex][i]);
+			}
+		}
+
+		return cmdBuffers;
+	}
+
 	template<typename RType, typename Func, typename ...Args>
 	inline auto VulkanCmdThreadPool::SubmitPoolTask(Func&& func, Args && ...args) -> std::future<RType>
 	{
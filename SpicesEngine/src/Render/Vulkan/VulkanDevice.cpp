@@ -14,6 +14,7 @@ namespace Spices {
 	VkPhysicalDeviceFeatures   VulkanDevice::m_DeviceFeatures{};
 	VkPhysicalDeviceRayTracingPipelinePropertiesKHR VulkanDevice::m_RayTracingProperties{};
 	VkPhysicalDeviceDeviceGeneratedCommandsPropertiesNV VulkanDevice::m_DGCProperties{};
+	VkPhysicalDeviceMeshShaderPropertiesEXT VulkanDevice::m_MeshShaderProperties{};
 
 	VulkanDevice::VulkanDevice(
 		VulkanState&  vulkanState
@@ -327,13 +328,12 @@ namespace Spices {
 		m_RayTracingProperties.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PIPELINE_PROPERTIES_KHR;
 		m_RayTracingProperties.pNext                = &m_DGCProperties;
 
-		VkPhysicalDeviceMeshShaderPropertiesEXT       meshShaderProperties{};
-		meshShaderProperties.sType                  = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
-		meshShaderProperties.pNext                  = &m_RayTracingProperties;
+		m_MeshShaderProperties.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
+		m_MeshShaderProperties.pNext                = &m_RayTracingProperties;
 		
 		VkPhysicalDeviceSubgroupProperties            subGroupProperties{};
 		subGroupProperties.sType                    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
-		subGroupProperties.pNext                    = &meshShaderProperties;
+		subGroupProperties.pNext                    = &m_MeshShaderProperties;
 
 		VkPhysicalDeviceProperties2                   prop2 {};
 		prop2.sType                                 = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
@@ -349,13 +349,19 @@ namespace Spices {
 
 		{
 			std::stringstream ss;
-			ss << "MeshShader : maxMeshOutputVertices = " << meshShaderProperties.maxMeshOutputVertices;
+			ss << "MeshShader : maxMeshOutputVertices = " << m_MeshShaderProperties.maxMeshOutputVertices;
 			SPICES_CORE_INFO(ss.str());
 		}
 
 		{
 			std::stringstream ss;
-			ss << "MeshShader : maxMeshOutputPrimitives = " << meshShaderProperties.maxMeshOutputPrimitives;
+			ss << "MeshShader : maxMeshOutputPrimitives = " << m_MeshShaderProperties.maxMeshOutputPrimitives;
+			SPICES_CORE_INFO(ss.str());
+		}
+
+		{
+			std::stringstream ss;
+			ss << "MeshShader : maxTaskWorkGroupCount = " << m_MeshShaderProperties.maxTaskWorkGroupCount[0] << ", " << m_MeshShaderProperties.maxTaskWorkGroupCount[1];
 			SPICES_CORE_INFO(ss.str());
 		}
 
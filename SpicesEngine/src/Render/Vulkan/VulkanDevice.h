@@ -166,6 +166,12 @@ namespace Spices {
 		*/
 		inline static VkPhysicalDeviceDeviceGeneratedCommandsPropertiesNV& GetDGCProperties() { return m_DGCProperties; };
 
+		/**
+		* @brief Get MeshShaderPropertiesEXT.
+		* @return Returns MeshShaderPropertiesEXT.
+		*/
+		inline static VkPhysicalDeviceMeshShaderPropertiesEXT& GetMeshShaderProperties() { return m_MeshShaderProperties; };
+
 		/**
 		* @brief Get VkPhysicalDeviceFeatures.
 		* @return Returns VkPhysicalDeviceFeatures.
@@ -264,6 +270,11 @@ namespace Spices {
 		*/
 		static VkPhysicalDeviceDeviceGeneratedCommandsPropertiesNV m_DGCProperties;
 
+		/**
+		* @brief Device MeshShader Properties.
+		*/
+		static VkPhysicalDeviceMeshShaderPropertiesEXT m_MeshShaderProperties;
+
 		/**
 		* @brief QueueHelper.
 		*/
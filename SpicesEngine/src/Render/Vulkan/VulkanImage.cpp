@@ -103,6 +103,16 @@ namespace Spices {
 		return &m_ImageInfo;
 	}
 
+	VkMemoryRequirements VulkanImage::GetMemoryRequirements() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		VkMemoryRequirements requirements{};
+		vkGetImageMemoryRequirements(m_VulkanState.m_Device, m_Image, &requirements);
+
+		return requirements;
+	}
+
 	void VulkanImage::TransitionImageLayout(
 		VkFormat      format    , 
 		VkImageLayout oldLayout , 
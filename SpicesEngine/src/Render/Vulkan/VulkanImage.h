@@ -90,6 +90,12 @@ namespace Spices {
 		*/
 		uint32_t GetLayers() const { return m_Layers; }
 
+		/**
+		* @brief Get memory requirements of this VkImage.
+		* @return Returns VkMemoryRequirements.
+		*/
+		VkMemoryRequirements GetMemoryRequirements() const;
+
 	public:
 
 		/**
@@ -6,6 +6,7 @@
 
 #include "Pchheader.h"
 #include "VulkanIndirectDrawNV.h"
+#include "VulkanCommandBuffer.h"
 
 namespace Spices {
 
@@ -20,6 +21,11 @@ namespace Spices {
 		, m_InputStrides{}
 		, m_LayoutTokens{}
 		, m_InputStreams{}
+		, m_Sequences(nullptr)
+		, m_IsIndexed(false)
+		, m_SequencesIndexBuffers{}
+		, m_OrderFrame(0)
+		, m_NOrdered(0)
 	{}
 
 	VulkanIndirectDrawNV::~VulkanIndirectDrawNV()
@@ -54,6 +60,9 @@ namespace Spices {
 		m_InputStreams.clear();
 		m_PreprocessBuffer  = nullptr;
 		m_PreprocessSize    = 0;
+		m_Sequences         = nullptr;
+		m_NOrdered          = 0;
+		m_SequencesIndexBuffers.fill(nullptr);
 	}
 
 	void VulkanIndirectDrawNV::AddInputStride(uint32_t stride)
@@ -64,7 +73,7 @@ namespace Spices {
 		m_Strides += stride;
 	}
 
-	std::shared_ptr<VulkanBuffer> VulkanIndirectDrawNV::CreateInputBuffer(uint32_t size)
+	void VulkanIndirectDrawNV::Create(size_t size)
 	{
 		SPICES_PROFILE_ZONE;
 
@@ -72,11 +81,122 @@ namespace Spices {
 			m_VulkanState,
 			"GDCInputBuffer",
 			size,
-			VK_BUFFER_USAGE_TRANSFER_DST_BIT    ,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT    |
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT ,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
 		);
+	}
+
+	void VulkanIndirectDrawNV::Upload(const uint8_t* data, const std::vector<Region>& regions)
+	{
+		SPICES_PROFILE_ZONE;
+
+		size_t totalSize = 0;
+		for (const auto& region : regions)
+		{
+			totalSize += region.size;
+		}
+
+		if (totalSize == 0) return;
+
+		VulkanBuffer stagingBuffer(
+			m_VulkanState,
+			"StagingBuffer",
+			totalSize,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+			VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		);
+
+		/**
+		* @brief Pack regions into staging buffer.
+		*/
+		std::vector<VkBufferCopy> copyRegions(regions.size());
+		VkDeviceSize srcOffset = 0;
+		for (size_t i = 0; i < regions.size(); i++)
+		{
+			stagingBuffer.WriteToBuffer(data + regions[i].offset, regions[i].size, srcOffset);
+
+			copyRegions[i].srcOffset = srcOffset;
+			copyRegions[i].dstOffset = regions[i].offset;
+			copyRegions[i].size      = regions[i].size;
 
-		return m_InputBuffer;
+			srcOffset += regions[i].size;
+		}
+		stagingBuffer.Flush();
+
+		/**
+		* @brief Input buffer is read by preprocess and execution of frames in flight, submitted earlier on graphic queue.
+		*/
+		constexpr VkPipelineStageFlags dgcStages   = VK_PIPELINE_STAGE_COMMAND_PREPROCESS_BIT_NV | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+		constexpr VkAccessFlags        dgcAccesses = VK_ACCESS_COMMAND_PREPROCESS_READ_BIT_NV    | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+		VkBufferMemoryBarrier                   bufferBarrier {};
+		bufferBarrier.sType                   = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		bufferBarrier.srcQueueFamilyIndex     = VK_QUEUE_FAMILY_IGNORED;
+		bufferBarrier.dstQueueFamilyIndex     = VK_QUEUE_FAMILY_IGNORED;
+		bufferBarrier.buffer                  = m_InputBuffer->Get();
+		bufferBarrier.offset                  = 0;
+		bufferBarrier.size                    = VK_WHOLE_SIZE;
+
+		/**
+		* @brief Copy all regions in one command, after reads of frames in flight and before reads of later frames.
+		*/
+		VulkanCommandBuffer::CustomGraphicCmd(m_VulkanState, [&](auto& commandBuffer) {
+
+			bufferBarrier.srcAccessMask       = dgcAccesses;
+			bufferBarrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+			vkCmdPipelineBarrier(commandBuffer, dgcStages, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+
+			vkCmdCopyBuffer(commandBuffer, stagingBuffer.Get(), m_InputBuffer->Get(), static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+			bufferBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+			bufferBarrier.dstAccessMask       = dgcAccesses;
+
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dgcStages, 0, 0, nullptr, 1, &bufferBarrier, 0, nullptr);
+		});
+	}
+
+	DGCSequenceTable& VulkanIndirectDrawNV::GetSequences(uint32_t alignment)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_Sequences || m_Sequences->GetStrides() != m_InputStrides)
+		{
+			m_Sequences = std::make_unique<DGCSequenceTable>(*this, m_InputStrides, alignment);
+		}
+
+		return *m_Sequences;
+	}
+
+	void VulkanIndirectDrawNV::SetSequenceOrder(uint32_t frameIndex, const std::vector<uint32_t>& slots)
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_OrderFrame = frameIndex;
+		m_NOrdered   = static_cast<uint32_t>(slots.size());
+
+		if (slots.empty()) return;
+
+		/**
+		* @brief Grow geometrically, the old buffer is only used by this frame which has finished.
+		*/
+		auto& buffer = m_SequencesIndexBuffers[frameIndex];
+		const VkDeviceSize size = sizeof(uint32_t) * slots.size();
+		if (!buffer || buffer->GetSize() < size)
+		{
+			buffer = std::make_shared<VulkanBuffer>(
+				m_VulkanState,
+				"GDCSequencesIndexBuffer",
+				buffer ? std::max(size, buffer->GetSize() * 2) : size,
+				VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT     ,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT     |
+				VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			);
+		}
+
+		buffer->WriteToBuffer(slots.data(), size);
 	}
 
 	std::shared_ptr<VulkanBuffer> VulkanIndirectDrawNV::CreatePreprocessBuffer(uint32_t size)
@@ -94,18 +214,19 @@ namespace Spices {
 		return m_PreprocessBuffer;
 	}
 
-	void VulkanIndirectDrawNV::BuildCommandLayout(const std::vector<VkIndirectCommandsLayoutTokenNV>& inputInfos)
+	void VulkanIndirectDrawNV::BuildCommandLayout(const std::vector<VkIndirectCommandsLayoutTokenNV>& inputInfos, VkIndirectCommandsLayoutUsageFlagsNV flags)
 	{
 		SPICES_PROFILE_ZONE;
 
 		m_LayoutTokens = inputInfos;
+		m_IsIndexed    = flags & VK_INDIRECT_COMMANDS_LAYOUT_USAGE_INDEXED_SEQUENCES_BIT_NV;
 
 		/**
 		* @brief Instance a VkIndirectCommandsLayoutCreateInfoNV.
 		*/
 		VkIndirectCommandsLayoutCreateInfoNV     genInfo{};
 		genInfo.sType                          = VK_STRUCTURE_TYPE_INDIRECT_COMMANDS_LAYOUT_CREATE_INFO_NV;
-		genInfo.flags                          = VK_INDIRECT_COMMANDS_LAYOUT_USAGE_UNORDERED_SEQUENCES_BIT_NV;
+		genInfo.flags                          = flags;
 		genInfo.tokenCount                     = static_cast<uint32_t>(inputInfos.size());
 		genInfo.pTokens                        = inputInfos.data();
 		genInfo.streamCount                    = static_cast<uint32_t>(m_InputStrides.size());
@@ -117,12 +238,30 @@ namespace Spices {
 		m_VulkanState.m_VkFunc.vkCreateIndirectCommandsLayoutNV(m_VulkanState.m_Device, &genInfo, NULL, &m_IndirectCmdsLayout);
 	}
 
+	bool VulkanIndirectDrawNV::FillSequences(VkGeneratedCommandsInfoNV& info) const
+	{
+		info.sequencesCount = m_NSequence;
+
+		/**
+		* @brief Indexed layouts execute the slots written by SetSequenceOrder of this frame.
+		*/
+		if (m_IsIndexed)
+		{
+			const auto& buffer = m_SequencesIndexBuffers[m_OrderFrame];
+			if (!buffer) return false;
+
+			info.sequencesCount        = std::min(m_NSequence, m_NOrdered);
+			info.sequencesIndexBuffer  = buffer->Get();
+			info.sequencesIndexOffset  = 0;
+		}
+
+		return info.sequencesCount != 0;
+	}
+
 	void VulkanIndirectDrawNV::PreprocessDGC(VkCommandBuffer cmdBuffer, VkPipeline pipeline)
 	{
 		SPICES_PROFILE_ZONE;
 
-		if (m_NSequence == 0) return;
-
 		/**
 		* @brief Instance a VkGeneratedCommandsInfoNV.
 		*/
@@ -131,12 +270,13 @@ namespace Spices {
 		info.pipeline                      = pipeline;
 		info.pipelineBindPoint             = VK_PIPELINE_BIND_POINT_GRAPHICS;
 		info.indirectCommandsLayout        = m_IndirectCmdsLayout;
-		info.sequencesCount                = m_NSequence;
 		info.streamCount                   = static_cast<uint32_t>(m_InputStreams.size());
 		info.pStreams                      = m_InputStreams.data();
-		info.preprocessBuffer              = m_PreprocessBuffer->Get();
+		info.preprocessBuffer              = m_PreprocessBuffer ? m_PreprocessBuffer->Get() : VK_NULL_HANDLE;
 		info.preprocessSize                = m_PreprocessSize;
 
+		if (!FillSequences(info)) return;
+
 		/**
 		* @brief Call vkCmdPreprocessGeneratedCommandsNV.
 		*/
@@ -147,8 +287,6 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		if (m_NSequence == 0) return;
-
 		/**
 		* @brief Instance a VkGeneratedCommandsInfoNV.
 		*/
@@ -157,12 +295,13 @@ namespace Spices {
 		info.pipeline                      = pipeline;
 		info.pipelineBindPoint             = VK_PIPELINE_BIND_POINT_GRAPHICS;
 		info.indirectCommandsLayout        = m_IndirectCmdsLayout;
-		info.sequencesCount                = m_NSequence;
 		info.streamCount                   = static_cast<uint32_t>(m_InputStreams.size());
 		info.pStreams                      = m_InputStreams.data();
-		info.preprocessBuffer              = m_PreprocessBuffer->Get();
+		info.preprocessBuffer              = m_PreprocessBuffer ? m_PreprocessBuffer->Get() : VK_NULL_HANDLE;
 		info.preprocessSize                = m_PreprocessSize;
 
+		if (!FillSequences(info)) return;
+
 		/**
 		* @brief Call vkCmdExecuteGeneratedCommandsNV.
 		*/
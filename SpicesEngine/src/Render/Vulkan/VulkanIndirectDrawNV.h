@@ -8,6 +8,7 @@
 #include "Core/Core.h"
 #include "VulkanUtils.h"
 #include "VulkanBuffer.h"
+#include "DGCSequenceTable.h"
 
 namespace Spices {
 
@@ -15,7 +16,7 @@ namespace Spices {
 	* @brief VulkanIndirectDrawNV Class.
 	* This class defines the VulkanIndirectDrawNV behaves.
 	*/
-	class VulkanIndirectDrawNV : public VulkanObject
+	class VulkanIndirectDrawNV : public VulkanObject, public DGCInputBuffer
 	{
 	public:
 
@@ -60,11 +61,32 @@ namespace Spices {
 		void SetInputStreams(const std::vector<VkIndirectCommandsStreamNV>& streams) { m_InputStreams = streams; }
 
 		/**
-		* @brief Create Input Buffer.
+		* @brief The interface is inherited from DGCInputBuffer.
+		* Create Input Buffer.
 		* @param[in] size Buffer Size.
+		*/
+		virtual void Create(size_t size) override;
+
+		/**
+		* @brief The interface is inherited from DGCInputBuffer.
+		* Upload regions through a staging buffer in one copy command.
+		* @param[in] data Host data.
+		* @param[in] regions Regions to upload.
+		*/
+		virtual void Upload(const uint8_t* data, const std::vector<Region>& regions) override;
+
+		/**
+		* @brief Get Input Buffer.
 		* @return Returns Input Buffer.
 		*/
-		std::shared_ptr<VulkanBuffer> CreateInputBuffer(uint32_t size);
+		std::shared_ptr<VulkanBuffer> GetInputBuffer() const { return m_InputBuffer; }
+
+		/**
+		* @brief Get persistent sequences, recreated if input strides changed.
+		* @param[in] alignment Stream offset alignment.
+		* @return Returns DGCSequenceTable.
+		*/
+		DGCSequenceTable& GetSequences(uint32_t alignment);
 
 		/**
 		* @brief Create Process Buffer.
@@ -84,11 +106,45 @@ namespace Spices {
 		*/
 		void SetSequenceCount(uint32_t nSequences) { m_NSequence = nSequences; }
 
+		/**
+		* @brief Get SequenceCount.
+		* @return Returns SequenceCount.
+		*/
+		uint32_t GetSequenceCount() const { return m_NSequence; }
+
+		/**
+		* @brief Write the order sequences are executed in a frame, used by layouts with indexed sequences.
+		* Sequence slots stay stable while the order changes, a frame in flight owns its index buffer,
+		* so it is written after the frame fence is waited.
+		* @param[in] frameIndex Frame in flight index.
+		* @param[in] slots Sequence slots in execution order.
+		*/
+		void SetSequenceOrder(uint32_t frameIndex, const std::vector<uint32_t>& slots);
+
+		/**
+		* @brief Get sequences index buffer of the frame set by last SetSequenceOrder.
+		* @return Returns sequences index buffer, nullptr if not indexed.
+		*/
+		std::shared_ptr<VulkanBuffer> GetSequencesIndexBuffer() const { return m_IsIndexed ? m_SequencesIndexBuffers[m_OrderFrame] : nullptr; }
+
+		/**
+		* @brief Get number of sequences executed in the order set by last SetSequenceOrder.
+		* @return Returns ordered sequences count.
+		*/
+		uint32_t GetOrderedCount() const { return m_NOrdered; }
+
+		/**
+		* @brief Get Preprocess Buffer.
+		* @return Returns Preprocess Buffer.
+		*/
+		std::shared_ptr<VulkanBuffer> GetPreprocessBuffer() const { return m_PreprocessBuffer; }
+
 		/**
 		* @brief Build CommandLayout.
 		* @param[in] inputInfos .
+		* @param[in] flags Layout usage flags.
 		*/
-		void BuildCommandLayout(const std::vector<VkIndirectCommandsLayoutTokenNV>& inputInfos);
+		void BuildCommandLayout(const std::vector<VkIndirectCommandsLayoutTokenNV>& inputInfos, VkIndirectCommandsLayoutUsageFlagsNV flags);
 
 		/**
 		* @brief Get Layout Tokens.
@@ -102,6 +158,13 @@ namespace Spices {
 		*/
 		VkIndirectCommandsLayoutNV GetCommandLayout() const { return m_IndirectCmdsLayout; }
 
+		/**
+		* @brief Fill in sequences count and index buffer of a VkGeneratedCommandsInfoNV.
+		* @param[in,out] info VkGeneratedCommandsInfoNV.
+		* @return Returns false if there is nothing to execute.
+		*/
+		bool FillSequences(VkGeneratedCommandsInfoNV& info) const;
+
 		/**
 		* @brief Preprocess with Indirect Command Buffer.
 		* @param[in] cmdBuffer VkCommandBuffer.
@@ -128,5 +191,11 @@ namespace Spices {
 		std::vector<VkIndirectCommandsStreamNV>      m_InputStreams;
 		std::shared_ptr<VulkanBuffer>                m_PreprocessBuffer;
 		uint32_t                                     m_PreprocessSize;
+		std::unique_ptr<DGCSequenceTable>            m_Sequences;
+
+		bool                                                      m_IsIndexed;
+		std::array<std::shared_ptr<VulkanBuffer>, MaxFrameInFlight> m_SequencesIndexBuffers;
+		uint32_t                                                  m_OrderFrame;
+		uint32_t                                                  m_NOrdered;
 	};
 }
@@ -25,40 +25,96 @@ namespace Spices {
 		*/
 		for (auto& it : m_blas)
 		{
-			it.FreeBuffer();
-			if (it.accel != VK_NULL_HANDLE)
-			{
-				m_VulkanState.m_VkFunc.vkDestroyAccelerationStructureKHR(m_VulkanState.m_Device, it.accel, nullptr);
-				it.accel = VK_NULL_HANDLE;
-			}
+			DestroyBLAS(it);
 		}
+		m_blas.clear();
 
 		/**
 		* @brief Destroy TLAS.
 		*/
+		DestroyTLAS();
+	}
+
+	void VulkanRayTracing::DestroyTLAS()
+	{
+		SPICES_PROFILE_ZONE;
+
 		if (m_tlas.accel != VK_NULL_HANDLE)
 		{
 			m_VulkanState.m_VkFunc.vkDestroyAccelerationStructureKHR(m_VulkanState.m_Device, m_tlas.accel, nullptr);
 			m_tlas.accel = VK_NULL_HANDLE;
 		}
 
-		m_blas.clear();
 		m_tlas.FreeBuffer();
 	}
 
+	void VulkanRayTracing::DestroyBLAS(AccelKHR& blas) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		blas.FreeBuffer();
+		if (blas.accel != VK_NULL_HANDLE)
+		{
+			m_VulkanState.m_VkFunc.vkDestroyAccelerationStructureKHR(m_VulkanState.m_Device, blas.accel, nullptr);
+			blas.accel = VK_NULL_HANDLE;
+		}
+	}
+
 	VkDeviceAddress VulkanRayTracing::GetBlasDeviceAddress(uint32_t blasId) const
 	{
 		SPICES_PROFILE_ZONE;
 
 		assert(static_cast<size_t>(blasId) < m_blas.size());
 
+		return GetDeviceAddress(m_blas[blasId]);
+	}
+
+	VkDeviceAddress VulkanRayTracing::GetDeviceAddress(const AccelKHR& accel) const
+	{
+		SPICES_PROFILE_ZONE;
+
 		VkAccelerationStructureDeviceAddressInfoKHR     addressInfo{};
 		addressInfo.sType                             = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
-		addressInfo.accelerationStructure             = m_blas[blasId].accel;
+		addressInfo.accelerationStructure             = accel.accel;
 
 		return m_VulkanState.m_VkFunc.vkGetAccelerationStructureDeviceAddressKHR(m_VulkanState.m_Device, &addressInfo);
 	}
 
+	VkAccelerationStructureBuildSizesInfoKHR VulkanRayTracing::GetBlasBuildSizes(
+		const BlasInput&                     input , 
+		VkBuildAccelerationStructureFlagsKHR flags
+	) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		VkAccelerationStructureBuildGeometryInfoKHR buildInfo{};
+		buildInfo.sType                            = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+		buildInfo.type                             = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+		buildInfo.mode                             = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+		buildInfo.flags                            = input.flags | flags;
+		buildInfo.geometryCount                    = static_cast<uint32_t>(input.asGeometry.size());
+		buildInfo.pGeometries                      = input.asGeometry.data();
+
+		std::vector<uint32_t> maxPrimCount(input.asBuildOffsetInfo.size());
+		for (size_t i = 0; i < input.asBuildOffsetInfo.size(); i++)
+		{
+			maxPrimCount[i] = input.asBuildOffsetInfo[i].primitiveCount;
+		}
+
+		VkAccelerationStructureBuildSizesInfoKHR sizeInfo{};
+		sizeInfo.sType                             = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
+
+		m_VulkanState.m_VkFunc.vkGetAccelerationStructureBuildSizesKHR(
+			m_VulkanState.m_Device, 
+			VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
+			&buildInfo, 
+			maxPrimCount.data(), 
+			&sizeInfo
+		);
+
+		return sizeInfo;
+	}
+
 	void VulkanRayTracing::BuildBLAS(
 		const std::vector<BlasInput>& input, 
 		VkBuildAccelerationStructureFlagsKHR flags
@@ -66,7 +122,20 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
+		auto blas = CreateBLAS(input, flags);
+		m_blas.insert(m_blas.end(), blas.begin(), blas.end());
+	}
+
+	std::vector<VulkanRayTracing::AccelKHR> VulkanRayTracing::CreateBLAS(
+		const std::vector<BlasInput>& input, 
+		VkBuildAccelerationStructureFlagsKHR flags
+	) const
+	{
+		SPICES_PROFILE_ZONE;
+
 		const auto       nbBlas         = static_cast<uint32_t>(input.size());
+		if (nbBlas == 0) return {};
+
 		VkDeviceSize     asTotalSize    = 0;     
 		uint32_t         nbCompactions  = 0;   
 		VkDeviceSize     maxScratchSize = 0;  
@@ -186,12 +255,16 @@ namespace Spices {
 		}
 
 		/**
-		* @brief Keeping all the created acceleration structures.
+		* @brief Return all the created acceleration structures.
 		*/ 
+		std::vector<AccelKHR> blas;
+		blas.reserve(nbBlas);
 		for (auto& b : buildAs)
 		{
-			m_blas.emplace_back(b.as);
+			blas.emplace_back(b.as);
 		}
+
+		return blas;
 	}
 
 	void VulkanRayTracing::UpdateBlas(uint32_t blasIdx, const BlasInput& blas, VkBuildAccelerationStructureFlagsKHR flags) const
@@ -259,6 +332,48 @@ namespace Spices {
 		});
 	}
 
+	void VulkanRayTracing::BuildTLAS(
+		VkDeviceAddress                       instBufferAddr   ,
+		uint32_t                              countInstance    ,
+		VkBuildAccelerationStructureFlagsKHR  flags            ,
+		bool                                  update
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Cannot update a TLAS not built yet.
+		*/
+		assert(m_tlas.accel != VK_NULL_HANDLE || !update);
+
+		std::unique_ptr<VulkanBuffer> scratchBuffer = nullptr;
+		VulkanCommandBuffer::CustomGraphicCmd(m_VulkanState, [&](VkCommandBuffer& commandBuffer) {
+
+			/**
+			* @brief Make sure host writes to the instance buffer are visible to the acceleration structure build.
+			*/
+			VkMemoryBarrier barrier{};
+			barrier.sType                        = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			barrier.srcAccessMask                = VK_ACCESS_HOST_WRITE_BIT;
+			barrier.dstAccessMask                = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+
+			vkCmdPipelineBarrier(
+				commandBuffer,
+				VK_PIPELINE_STAGE_HOST_BIT,
+				VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+				0,
+				1,
+				&barrier,
+				0,
+				nullptr,
+				0,
+				nullptr
+			);
+
+			CmdCreateTLAS(commandBuffer, countInstance, instBufferAddr, scratchBuffer, flags, update, false);
+		});
+	}
+
 #ifdef VK_NV_ray_tracing_motion_blur
 
 	void VulkanRayTracing::BuildTLAS(
@@ -331,9 +446,9 @@ namespace Spices {
 #endif
 
 		/**
-		* @brief Create TLAS.
+		* @brief Create TLAS, a built TLAS is rebuilt in place.
 		*/ 
-		if (update == false)
+		if (m_tlas.accel == VK_NULL_HANDLE)
 		{
 			VkAccelerationStructureCreateInfoKHR createInfo{};
 			createInfo.sType                       = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
@@ -51,9 +51,47 @@ namespace Spices {
 
 		void Destroy();
 
+		/**
+		* @brief Destroy TLAS only, BLAS are kept.
+		*/
+		void DestroyTLAS();
+
+		/**
+		* @brief Destroy a BLAS not owned by this class.
+		* @param[in] blas The BLAS created by CreateBLAS.
+		*/
+		void DestroyBLAS(AccelKHR& blas) const;
+
 		const VkAccelerationStructureKHR& GetAccelerationStructure() const { return m_tlas.accel; };
 		VkDeviceAddress GetBlasDeviceAddress(uint32_t blasId) const;
 
+		/**
+		* @brief Get device address of an acceleration structure.
+		* @param[in] accel AccelKHR.
+		* @return Returns device address.
+		*/
+		VkDeviceAddress GetDeviceAddress(const AccelKHR& accel) const;
+
+		/**
+		* @brief Query build sizes of a BLAS input.
+		* @param[in] input BlasInput.
+		* @param[in] flags Build flags.
+		* @return Returns build sizes.
+		*/
+		VkAccelerationStructureBuildSizesInfoKHR GetBlasBuildSizes(const BlasInput& input, VkBuildAccelerationStructureFlagsKHR flags) const;
+
+		/**
+		* @brief Build and compact BLAS from the vector of BlasInput, without keeping them.
+		* The caller owns the returned BLAS and frees them with DestroyBLAS.
+		* @param[in] input BlasInputs.
+		* @param[in] flags Build flags.
+		* @return Returns one BLAS per input.
+		*/
+		std::vector<AccelKHR> CreateBLAS(
+			const std::vector<BlasInput>&        input                                                             , 
+			VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR
+		) const;
+
 		/**
 		* @brief Create all the BLAS from the vector of BlasInput.
 		* There will be one BLAS per input-vector entry.
@@ -104,6 +142,20 @@ namespace Spices {
 			bool motion = false
 		);
 
+		/**
+		* @brief Build TLAS from instances already resident in a device buffer.
+		* Used by renderers keeping a persistent instance buffer, which patch only the instances that changed.
+		* The TLAS is created on the first call and built in place afterwards, so descriptors stay valid.
+		* countInstance must not exceed the count the TLAS was created with.
+		* update is to refit the Tlas with updated matrices, flag must have the 'allow_update'
+		*/
+		void BuildTLAS(
+			VkDeviceAddress                      instBufferAddr                                                    ,
+			uint32_t                             countInstance                                                     ,
+			VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR ,
+			bool                                 update = false
+		);
+
 		/**
 		* @brief Low level of Tlas creation.
 		*  Creating the TLAS, called by buildTlas.
@@ -147,7 +199,7 @@ namespace Spices {
 		) const;
 
 		void DestroyNonCompacted(const std::vector<uint32_t>& indices, std::vector<BuildAccelerationStructure>& buildAs) const;
-		bool hasFlag(VkFlags item, VkFlags flag) { return (item & flag) == flag; }
+		bool hasFlag(VkFlags item, VkFlags flag) const { return (item & flag) == flag; }
 		AccelKHR CreateAcceleration(VkAccelerationStructureCreateInfoKHR& accel) const;
 
 	private:
@@ -12,6 +12,7 @@
 #include "Debugger/Perf/NsightPerfGPUProfilerReportGenerator.h"
 #include "Debugger/Perf/NsightPerfGPUProfilerOneshotCollection.h"
 #include "Core/Timer/ScopeTimer.h"
+#include "BufferUploadTracker.h"
 
 #include "Render/RendererResource/RendererResourcePool.h"
 #include "Systems/SlateSystem.h"
@@ -129,6 +130,12 @@ namespace Spices {
 		    .Push<TestRenderer>             (m_VulkanState, m_VulkanDescriptorPool, m_VulkanDevice, m_RendererResourcePool, m_CmdThreadPool)
 			.Push<SlateRenderer>            (m_VulkanState, m_VulkanDescriptorPool, m_VulkanDevice, m_RendererResourcePool, m_CmdThreadPool);
 		}
+
+		/**
+		* @brief Compile RenderGraph of all Specific Renderer, a diagnostic of attachment lifetimes.
+		* Attachments read outside renderers are exported by their readers, see AccessExportedResource.
+		*/
+		m_RendererResourcePool->CompileRenderGraph();
 	}
 
 	VulkanRenderBackend::~VulkanRenderBackend()
@@ -228,6 +235,19 @@ namespace Spices {
 			*/
 			VK_CHECK(vkResetFences(m_VulkanState.m_Device, 2, fence));
 		}
+
+		{
+			SPICES_PROFILE_ZONEN("BeginFrame::BufferUploadStats");
+
+			/**
+			* @brief Roll buffer upload statistics of last frame.
+			*/
+			BufferUploadTracker::BeginFrame();
+
+			const BufferUploadTracker::Stats stats = BufferUploadTracker::GetFrameStats();
+			SPICES_PROFILE_PLOT("Buffer Upload Bytes",   static_cast<int64_t>(stats.bytes));
+			SPICES_PROFILE_PLOT("Buffer Upload Flushes", static_cast<int64_t>(stats.flushes));
+		}
 		
 		/**
 		* @brief Prepare Writing another SwapchainImage.
@@ -480,6 +500,11 @@ namespace Spices {
 		*/
 		RendererManager::Get().OnSlateResize();
 
+		/**
+		* @brief Recompile RenderGraph with resized resources.
+		*/
+		m_RendererResourcePool->CompileRenderGraph();
+
 		/**
 		* @brief Do not block the event.
 		*/
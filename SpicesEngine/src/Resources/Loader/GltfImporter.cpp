@@ -0,0 +1,888 @@
+/**
+* @file GltfImporter.cpp.
+* @brief The GltfImporter Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "GltfImporter.h"
+#include "Core/Thread/ThreadPool.h"
+
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief GLB chunk types.
+		*/
+		constexpr uint32_t chunkJSON = 0x4E4F534A;
+		constexpr uint32_t chunkBIN  = 0x004E4942;
+
+		/**
+		* @brief Accessor component types.
+		*/
+		constexpr uint32_t componentByte          = 5120;
+		constexpr uint32_t componentUnsignedByte  = 5121;
+		constexpr uint32_t componentShort         = 5122;
+		constexpr uint32_t componentUnsignedShort = 5123;
+		constexpr uint32_t componentUnsignedInt   = 5125;
+		constexpr uint32_t componentFloat         = 5126;
+
+		/**
+		* @brief Primitive modes.
+		*/
+		constexpr uint32_t modeTriangles     = 4;
+		constexpr uint32_t modeTriangleStrip = 5;
+		constexpr uint32_t modeTriangleFan   = 6;
+
+		/**
+		* @brief Max nesting of JSON values.
+		*/
+		constexpr uint32_t maxJsonDepth = 64;
+
+		/**
+		* @brief A JSON value, strings view the JSON chunk and keep their escapes.
+		*/
+		struct JsonValue
+		{
+			enum class Type
+			{
+				Null,
+				Bool,
+				Number,
+				String,
+				Array,
+				Object,
+			};
+
+			Type                          type    = Type::Null;     /* @brief Type.                              */
+			bool                          boolean = false;          /* @brief Bool value.                        */
+			double                        number  = 0.0;            /* @brief Number value.                      */
+			std::string_view              string;                   /* @brief String value.                      */
+			std::vector<std::string_view> keys;                     /* @brief Object keys.                       */
+			std::vector<JsonValue>        items;                    /* @brief Array items, or Object values.     */
+
+			/**
+			* @brief Find a member of Object.
+			* @return Returns nullptr if not found.
+			*/
+			const JsonValue* Find(std::string_view key) const
+			{
+				for (size_t i = 0; i < keys.size(); i++)
+				{
+					if (keys[i] == key) return &items[i];
+				}
+				return nullptr;
+			}
+
+			/**
+			* @brief Get a item of Array.
+			* @return Returns nullptr if out of range or not an Array.
+			*/
+			const JsonValue* At(uint64_t index) const
+			{
+				return type == Type::Array && index < items.size() ? &items[index] : nullptr;
+			}
+
+			/**
+			* @brief Get a number member of Object as an unsigned integer.
+			* @param[out] out The number, untouched if not found.
+			* @return Returns false if the member exists but is not a non negative integer.
+			*/
+			bool GetUInt(std::string_view key, uint64_t& out) const
+			{
+				const JsonValue* value = Find(key);
+				if (!value) return true;
+
+				if (value->type != Type::Number || value->number < 0.0 || value->number != std::floor(value->number) || value->number > 9.0e15) return false;
+
+				out = static_cast<uint64_t>(value->number);
+				return true;
+			}
+		};
+
+		/**
+		* @brief Recursive descent JSON parser.
+		*/
+		class JsonParser
+		{
+		public:
+
+			JsonParser(const char* data, uint64_t size)
+				: m_Ptr(data)
+				, m_End(data + size)
+			{}
+
+			/**
+			* @brief Parse the whole text as one value.
+			*/
+			bool Parse(JsonValue& out)
+			{
+				if (!ParseValue(out, 0)) return false;
+
+				/**
+				* @brief GLB pads JSON chunk with spaces.
+				*/
+				SkipBlank();
+				while (m_Ptr < m_End && *m_Ptr == '\0') m_Ptr++;
+
+				return m_Ptr == m_End;
+			}
+
+		private:
+
+			void SkipBlank()
+			{
+				while (m_Ptr < m_End && (*m_Ptr == ' ' || *m_Ptr == '\t' || *m_Ptr == '\n' || *m_Ptr == '\r')) m_Ptr++;
+			}
+
+			bool Match(const char* literal)
+			{
+				const size_t size = std::strlen(literal);
+				if (static_cast<size_t>(m_End - m_Ptr) < size || std::memcmp(m_Ptr, literal, size) != 0) return false;
+
+				m_Ptr += size;
+				return true;
+			}
+
+			bool ParseString(std::string_view& out)
+			{
+				if (m_Ptr >= m_End || *m_Ptr != '"') return false;
+
+				const char* begin = ++m_Ptr;
+				while (m_Ptr < m_End && *m_Ptr != '"')
+				{
+					m_Ptr += *m_Ptr == '\\' ? 2 : 1;
+				}
+				if (m_Ptr >= m_End) return false;
+
+				out = std::string_view(begin, m_Ptr - begin);
+				m_Ptr++;
+				return true;
+			}
+
+			bool ParseValue(JsonValue& out, uint32_t depth)
+			{
+				if (depth > maxJsonDepth) return false;
+
+				SkipBlank();
+				if (m_Ptr >= m_End) return false;
+
+				switch (*m_Ptr)
+				{
+				case '{':
+				{
+					out.type = JsonValue::Type::Object;
+					m_Ptr++;
+
+					SkipBlank();
+					if (m_Ptr < m_End && *m_Ptr == '}') { m_Ptr++; return true; }
+
+					for (;;)
+					{
+						SkipBlank();
+
+						std::string_view key;
+						if (!ParseString(key)) return false;
+
+						SkipBlank();
+						if (m_Ptr >= m_End || *m_Ptr++ != ':') return false;
+
+						out.keys.push_back(key);
+						out.items.emplace_back();
+						if (!ParseValue(out.items.back(), depth + 1)) return false;
+
+						SkipBlank();
+						if (m_Ptr >= m_End) return false;
+						if (*m_Ptr == ',') { m_Ptr++; continue; }
+						if (*m_Ptr == '}') { m_Ptr++; return true; }
+						return false;
+					}
+				}
+				case '[':
+				{
+					out.type = JsonValue::Type::Array;
+					m_Ptr++;
+
+					SkipBlank();
+					if (m_Ptr < m_End && *m_Ptr == ']') { m_Ptr++; return true; }
+
+					for (;;)
+					{
+						out.items.emplace_back();
+						if (!ParseValue(out.items.back(), depth + 1)) return false;
+
+						SkipBlank();
+						if (m_Ptr >= m_End) return false;
+						if (*m_Ptr == ',') { m_Ptr++; continue; }
+						if (*m_Ptr == ']') { m_Ptr++; return true; }
+						return false;
+					}
+				}
+				case '"':
+					out.type = JsonValue::Type::String;
+					return ParseString(out.string);
+				case 't':
+					out.type    = JsonValue::Type::Bool;
+					out.boolean = true;
+					return Match("true");
+				case 'f':
+					out.type    = JsonValue::Type::Bool;
+					out.boolean = false;
+					return Match("false");
+				case 'n':
+					out.type = JsonValue::Type::Null;
+					return Match("null");
+				default:
+				{
+					out.type = JsonValue::Type::Number;
+
+					const auto [ptr, ec] = std::from_chars(m_Ptr, m_End, out.number);
+					if (ec != std::errc() || ptr == m_Ptr) return false;
+
+					m_Ptr = ptr;
+					return true;
+				}
+				}
+			}
+
+		private:
+
+			const char* m_Ptr;      /* @brief Current byte.       */
+			const char* m_End;      /* @brief One past last byte. */
+		};
+
+		/**
+		* @brief Bytes of a component type, 0 if invalid.
+		*/
+		inline uint32_t ComponentSize(uint64_t componentType)
+		{
+			switch (componentType)
+			{
+			case componentByte:
+			case componentUnsignedByte:  return 1;
+			case componentShort:
+			case componentUnsignedShort: return 2;
+			case componentUnsignedInt:
+			case componentFloat:         return 4;
+			default:                     return 0;
+			}
+		}
+
+		/**
+		* @brief Components of an accessor type, 0 if not supported.
+		*/
+		inline uint32_t TypeComponents(std::string_view type)
+		{
+			if (type == "SCALAR") return 1;
+			if (type == "VEC2")   return 2;
+			if (type == "VEC3")   return 3;
+			if (type == "VEC4")   return 4;
+			return 0;
+		}
+
+		/**
+		* @brief Read a component as float.
+		*/
+		inline float ReadComponent(const char* p, uint32_t componentType, bool normalized)
+		{
+			switch (componentType)
+			{
+			case componentFloat:
+			{
+				float v;
+				std::memcpy(&v, p, sizeof(float));
+				return v;
+			}
+			case componentUnsignedByte:
+			{
+				const uint8_t v = static_cast<uint8_t>(*p);
+				return normalized ? v / 255.0f : static_cast<float>(v);
+			}
+			case componentByte:
+			{
+				const int8_t v = static_cast<int8_t>(*p);
+				return normalized ? std::max(v / 127.0f, -1.0f) : static_cast<float>(v);
+			}
+			case componentUnsignedShort:
+			{
+				uint16_t v;
+				std::memcpy(&v, p, sizeof(uint16_t));
+				return normalized ? v / 65535.0f : static_cast<float>(v);
+			}
+			case componentShort:
+			{
+				int16_t v;
+				std::memcpy(&v, p, sizeof(int16_t));
+				return normalized ? std::max(v / 32767.0f, -1.0f) : static_cast<float>(v);
+			}
+			case componentUnsignedInt:
+			{
+				uint32_t v;
+				std::memcpy(&v, p, sizeof(uint32_t));
+				return static_cast<float>(v);
+			}
+			default: return 0.0f;
+			}
+		}
+
+		/**
+		* @brief Read an unsigned integer component.
+		*/
+		inline uint32_t ReadIndex(const char* p, uint32_t componentType)
+		{
+			switch (componentType)
+			{
+			case componentUnsignedByte:
+				return static_cast<uint8_t>(*p);
+			case componentUnsignedShort:
+			{
+				uint16_t v;
+				std::memcpy(&v, p, sizeof(uint16_t));
+				return v;
+			}
+			default:
+			{
+				uint32_t v;
+				std::memcpy(&v, p, sizeof(uint32_t));
+				return v;
+			}
+			}
+		}
+
+		/**
+		* @brief An accessor resolved to BIN chunk pointers.
+		*/
+		struct Accessor
+		{
+			uint64_t    count             = 0;          /* @brief Elements.                                 */
+			uint32_t    componentType     = 0;          /* @brief Component type.                           */
+			uint32_t    componentSize     = 0;          /* @brief Bytes of a component.                     */
+			uint32_t    nComponents       = 0;          /* @brief Components of an element.                */
+			bool        normalized        = false;      /* @brief Integers are normalized.                  */
+			const char* data              = nullptr;    /* @brief First element, nullptr for zeros.         */
+			uint64_t    stride            = 0;          /* @brief Bytes between elements.                   */
+			uint64_t    sparseCount       = 0;          /* @brief Sparse elements.                          */
+			uint32_t    sparseIndexType   = 0;          /* @brief Component type of sparse indices.         */
+			const char* sparseIndices     = nullptr;    /* @brief Sparse indices.                           */
+			const char* sparseValues      = nullptr;    /* @brief Sparse values, tightly packed.            */
+
+			/**
+			* @brief Bytes read by this accessor.
+			*/
+			uint64_t Bytes() const
+			{
+				return (data ? count : 0) * nComponents * componentSize +
+				        sparseCount * (ComponentSize(sparseIndexType) + nComponents * componentSize);
+			}
+		};
+	}
+
+	struct GltfImporter::Document
+	{
+		JsonValue   root;                   /* @brief JSON chunk.               */
+		const char* bin      = nullptr;     /* @brief BIN chunk.                */
+		uint64_t    binSize  = 0;           /* @brief Bytes of BIN chunk.       */
+
+		/**
+		* @brief Resolve bytes of a buffer view.
+		* @param[in] index Buffer view index.
+		* @param[in] offset Bytes offset in buffer view.
+		* @param[in] size Bytes needed from offset.
+		* @param[out] outData First byte.
+		* @param[out] outStride Stride of buffer view, 0 if not set.
+		* @return Returns true if the range is in the BIN chunk.
+		*/
+		bool ResolveView(uint64_t index, uint64_t offset, uint64_t size, const char*& outData, uint64_t& outStride) const
+		{
+			const JsonValue* views = root.Find("bufferViews");
+			const JsonValue* view  = views ? views->At(index) : nullptr;
+			if (!view) return false;
+
+			uint64_t buffer     = 0;
+			uint64_t viewOffset = 0;
+			uint64_t viewSize   = 0;
+			uint64_t stride     = 0;
+
+			if (!view->GetUInt("buffer",     buffer    ) ||
+			    !view->GetUInt("byteOffset", viewOffset) ||
+			    !view->GetUInt("byteLength", viewSize  ) ||
+			    !view->GetUInt("byteStride", stride    ))
+			{
+				return false;
+			}
+
+			/**
+			* @brief Only GLB-stored buffer, which is buffer 0 without uri.
+			*/
+			const JsonValue* buffers = root.Find("buffers");
+			const JsonValue* b       = buffers ? buffers->At(buffer) : nullptr;
+			if (buffer != 0 || !b || b->Find("uri") || !bin) return false;
+
+			if (viewOffset > binSize || viewSize > binSize - viewOffset) return false;
+			if (offset > viewSize || size > viewSize - offset) return false;
+
+			outData   = bin + viewOffset + offset;
+			outStride = stride;
+			return true;
+		}
+
+		/**
+		* @brief Resolve an accessor.
+		* @param[in] index Accessor index.
+		* @param[out] out Resolved accessor.
+		* @return Returns true if succeed.
+		*/
+		bool ResolveAccessor(uint64_t index, Accessor& out) const
+		{
+			const JsonValue* accessors = root.Find("accessors");
+			const JsonValue* accessor  = accessors ? accessors->At(index) : nullptr;
+			if (!accessor) return false;
+
+			uint64_t componentType = 0;
+			uint64_t offset        = 0;
+			if (!accessor->GetUInt("count",         out.count    ) ||
+			    !accessor->GetUInt("componentType", componentType) ||
+			    !accessor->GetUInt("byteOffset",    offset       ))
+			{
+				return false;
+			}
+
+			const JsonValue* type       = accessor->Find("type");
+			const JsonValue* normalized = accessor->Find("normalized");
+
+			out.componentType = static_cast<uint32_t>(componentType);
+			out.componentSize = ComponentSize(componentType);
+			out.nComponents   = type && type->type == JsonValue::Type::String ? TypeComponents(type->string) : 0;
+			out.normalized    = normalized && normalized->boolean;
+
+			if (out.componentSize == 0 || out.nComponents == 0 || out.count > UINT32_MAX) return false;
+
+			const uint64_t elementSize = uint64_t(out.componentSize) * out.nComponents;
+
+			/**
+			* @brief Dense data, zeros if no buffer view.
+			*/
+			uint64_t view = 0;
+			if (accessor->Find("bufferView"))
+			{
+				if (!accessor->GetUInt("bufferView", view)) return false;
+
+				const char* probe = nullptr;
+				uint64_t stride   = 0;
+				if (!ResolveView(view, offset, 0, probe, stride)) return false;
+
+				out.stride = stride ? stride : elementSize;
+				if (out.stride < elementSize) return false;
+
+				const uint64_t size = out.count ? (out.count - 1) * out.stride + elementSize : 0;
+				if (!ResolveView(view, offset, size, out.data, stride)) return false;
+			}
+
+			/**
+			* @brief Sparse data.
+			*/
+			if (const JsonValue* sparse = accessor->Find("sparse"))
+			{
+				const JsonValue* indices = sparse->Find("indices");
+				const JsonValue* values  = sparse->Find("values");
+				if (!indices || !values) return false;
+
+				uint64_t indexView   = 0;
+				uint64_t indexOffset = 0;
+				uint64_t indexType   = 0;
+				uint64_t valueView   = 0;
+				uint64_t valueOffset = 0;
+
+				if (!sparse ->GetUInt("count",         out.sparseCount) ||
+				    !indices->GetUInt("bufferView",    indexView      ) ||
+				    !indices->GetUInt("byteOffset",    indexOffset    ) ||
+				    !indices->GetUInt("componentType", indexType      ) ||
+				    !values ->GetUInt("bufferView",    valueView      ) ||
+				    !values ->GetUInt("byteOffset",    valueOffset    ))
+				{
+					return false;
+				}
+
+				if (indexType != componentUnsignedByte && indexType != componentUnsignedShort && indexType != componentUnsignedInt) return false;
+				if (out.sparseCount > out.count) return false;
+
+				out.sparseIndexType = static_cast<uint32_t>(indexType);
+
+				uint64_t stride = 0;
+				if (!ResolveView(indexView, indexOffset, out.sparseCount * ComponentSize(indexType), out.sparseIndices, stride)) return false;
+				if (!ResolveView(valueView, valueOffset, out.sparseCount * elementSize,              out.sparseValues,  stride)) return false;
+
+				for (uint64_t i = 0; i < out.sparseCount; i++)
+				{
+					if (ReadIndex(out.sparseIndices + i * ComponentSize(indexType), out.sparseIndexType) >= out.count) return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		* @brief Read an accessor as floats.
+		* @param[in] accessor Resolved accessor.
+		* @param[in] n Floats per element in out, extra components are dropped, missing are zero.
+		* @param[out] out count * n floats.
+		*/
+		static void ReadFloats(const Accessor& accessor, uint32_t n, float* out)
+		{
+			const uint32_t m = std::min(n, accessor.nComponents);
+
+			if (!accessor.data)
+			{
+				std::fill(out, out + accessor.count * n, 0.0f);
+			}
+			else if (accessor.componentType == componentFloat && n == accessor.nComponents && accessor.stride == n * sizeof(float))
+			{
+				std::memcpy(out, accessor.data, accessor.count * n * sizeof(float));
+			}
+			else
+			{
+				for (uint64_t i = 0; i < accessor.count; i++)
+				{
+					const char* element = accessor.data + i * accessor.stride;
+					for (uint32_t c = 0; c < n; c++)
+					{
+						out[i * n + c] = c < m ? ReadComponent(element + c * accessor.componentSize, accessor.componentType, accessor.normalized) : 0.0f;
+					}
+				}
+			}
+
+			const uint32_t indexSize = ComponentSize(accessor.sparseIndexType);
+			for (uint64_t i = 0; i < accessor.sparseCount; i++)
+			{
+				const uint32_t index = ReadIndex(accessor.sparseIndices + i * indexSize, accessor.sparseIndexType);
+				const char* element  = accessor.sparseValues + i * accessor.nComponents * accessor.componentSize;
+
+				for (uint32_t c = 0; c < m; c++)
+				{
+					out[uint64_t(index) * n + c] = ReadComponent(element + c * accessor.componentSize, accessor.componentType, accessor.normalized);
+				}
+			}
+		}
+
+		/**
+		* @brief Read a scalar accessor as indices.
+		* @param[in] accessor Resolved accessor.
+		* @param[out] out count indices.
+		*/
+		static void ReadIndices(const Accessor& accessor, uint32_t* out)
+		{
+			if (!accessor.data)
+			{
+				std::fill(out, out + accessor.count, 0u);
+			}
+			else if (accessor.componentType == componentUnsignedInt && accessor.stride == sizeof(uint32_t))
+			{
+				std::memcpy(out, accessor.data, accessor.count * sizeof(uint32_t));
+			}
+			else
+			{
+				for (uint64_t i = 0; i < accessor.count; i++)
+				{
+					out[i] = ReadIndex(accessor.data + i * accessor.stride, accessor.componentType);
+				}
+			}
+
+			const uint32_t indexSize = ComponentSize(accessor.sparseIndexType);
+			for (uint64_t i = 0; i < accessor.sparseCount; i++)
+			{
+				const uint32_t index = ReadIndex(accessor.sparseIndices + i * indexSize, accessor.sparseIndexType);
+				out[index] = ReadIndex(accessor.sparseValues + i * accessor.componentSize, accessor.componentType);
+			}
+		}
+	};
+
+	GltfImporter::GltfImporter() = default;
+
+	GltfImporter::~GltfImporter()
+	{
+		Close();
+	}
+
+	bool GltfImporter::Open(const std::string& path)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Close();
+
+		MappedFileHandle file;
+		if (!FileLibrary::FileLibrary_Map(path.c_str(), &file)) return false;
+
+		const bool isSucceed = Open(file.data, file.size);
+
+		if (!isSucceed)
+		{
+			FileLibrary::FileLibrary_UnMap(&file);
+
+			std::stringstream ss;
+			ss << "GltfImporter: " << path << " is not a valid glb file.";
+
+			SPICES_CORE_ERROR(ss.str());
+
+			return false;
+		}
+
+		m_File = file;
+		m_Path = path;
+
+		return isSucceed;
+	}
+
+	bool GltfImporter::Open(const char* data, uint64_t size)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Close();
+
+		const auto readU32 = [&](uint64_t offset) {
+			uint32_t v;
+			std::memcpy(&v, data + offset, sizeof(uint32_t));
+			return v;
+		};
+
+		/**
+		* @brief Header and JSON chunk header.
+		*/
+		if (size < 20 || readU32(0) != Magic || readU32(4) != Version || readU32(8) > size || readU32(8) < 20) return false;
+
+		const uint64_t length   = readU32(8);
+		const uint64_t jsonSize = readU32(12);
+		if (readU32(16) != chunkJSON || jsonSize > length - 20) return false;
+
+		auto document = std::make_unique<Document>();
+
+		/**
+		* @brief BIN chunk follows the 4 bytes aligned JSON chunk.
+		*/
+		const uint64_t binHeader = 20 + ((jsonSize + 3) & ~3ull);
+		if (binHeader + 8 <= length && readU32(binHeader + 4) == chunkBIN)
+		{
+			const uint64_t binSize = readU32(binHeader);
+			if (binSize > length - binHeader - 8) return false;
+
+			document->bin     = data + binHeader + 8;
+			document->binSize = binSize;
+		}
+
+		JsonParser parser(data + 20, jsonSize);
+		if (!parser.Parse(document->root) || document->root.type != JsonValue::Type::Object) return false;
+
+		/**
+		* @brief List mesh primitives.
+		*/
+		std::vector<Primitive> primitives;
+		if (const JsonValue* meshes = document->root.Find("meshes"))
+		{
+			if (meshes->type != JsonValue::Type::Array) return false;
+
+			for (uint32_t i = 0; i < meshes->items.size(); i++)
+			{
+				const JsonValue& mesh           = meshes->items[i];
+				const JsonValue* name           = mesh.Find("name");
+				const JsonValue* meshPrimitives = mesh.Find("primitives");
+
+				if (!meshPrimitives || meshPrimitives->type != JsonValue::Type::Array) return false;
+
+				for (uint32_t j = 0; j < meshPrimitives->items.size(); j++)
+				{
+					Primitive primitive;
+					primitive.mesh           = name && name->type == JsonValue::Type::String ? std::string(name->string) : std::to_string(i);
+					primitive.meshIndex      = i;
+					primitive.primitiveIndex = j;
+
+					primitives.push_back(std::move(primitive));
+				}
+			}
+		}
+
+		m_Document   = std::move(document);
+		m_Primitives = std::move(primitives);
+
+		return true;
+	}
+
+	void GltfImporter::Close()
+	{
+		SPICES_PROFILE_ZONE;
+
+		m_Document = nullptr;
+		m_Primitives.clear();
+		m_Path.clear();
+
+		if (m_File.is_valid)
+		{
+			FileLibrary::FileLibrary_UnMap(&m_File);
+		}
+		m_File = MappedFileHandle{};
+	}
+
+	bool GltfImporter::Read(uint32_t index, const Output& output, Stats* outStats) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_Document || index >= m_Primitives.size()) return false;
+
+		const Document& document = *m_Document;
+		const Primitive& info    = m_Primitives[index];
+
+		const JsonValue& primitive  = document.root.Find("meshes")->items[info.meshIndex].Find("primitives")->items[info.primitiveIndex];
+		const JsonValue* attributes = primitive.Find("attributes");
+		if (!attributes) return false;
+
+		/**
+		* @brief Resolve accessors, POSITION is required, others must match its count.
+		*/
+		const auto resolve = [&](const JsonValue* object, std::string_view key, Accessor& out, bool& isFind) {
+			isFind = object->Find(key) != nullptr;
+			if (!isFind) return true;
+
+			uint64_t accessor = 0;
+			return object->GetUInt(key, accessor) && document.ResolveAccessor(accessor, out);
+		};
+
+		Accessor positions, normals, texCoords, colors, indices;
+		bool hasPositions = false, hasNormals = false, hasTexCoords = false, hasColors = false, hasIndices = false;
+
+		if (!resolve(attributes, "POSITION",   positions, hasPositions) || !hasPositions) return false;
+		if (!resolve(attributes, "NORMAL",     normals,   hasNormals  )) return false;
+		if (!resolve(attributes, "TEXCOORD_0", texCoords, hasTexCoords)) return false;
+		if (!resolve(attributes, "COLOR_0",    colors,    hasColors   )) return false;
+		if (!resolve(&primitive, "indices",    indices,   hasIndices  )) return false;
+
+		const uint64_t nVertices = positions.count;
+
+		if (positions.nComponents != 3)                                                                      return false;
+		if (hasNormals   && (normals.count   != nVertices || normals.nComponents   != 3))                    return false;
+		if (hasTexCoords && (texCoords.count != nVertices || texCoords.nComponents != 2))                    return false;
+		if (hasColors    && (colors.count    != nVertices || colors.nComponents    <  3))                    return false;
+		if (hasIndices   && (indices.nComponents != 1 || ComponentSize(indices.componentType) == 0 || indices.componentType == componentFloat)) return false;
+
+		uint64_t mode = modeTriangles;
+		if (!primitive.GetUInt("mode", mode)) return false;
+		if (mode != modeTriangles && mode != modeTriangleStrip && mode != modeTriangleFan) return false;
+
+		/**
+		* @brief Attributes.
+		*/
+		output.positions->resize(nVertices);
+		Document::ReadFloats(positions, 3, reinterpret_cast<float*>(output.positions->data()));
+
+		output.normals->resize(hasNormals ? nVertices : 0);
+		if (hasNormals) Document::ReadFloats(normals, 3, reinterpret_cast<float*>(output.normals->data()));
+
+		output.texCoords->resize(hasTexCoords ? nVertices : 0);
+		if (hasTexCoords) Document::ReadFloats(texCoords, 2, reinterpret_cast<float*>(output.texCoords->data()));
+
+		output.colors->assign(nVertices, glm::vec3(1.0f));
+		if (hasColors) Document::ReadFloats(colors, 3, reinterpret_cast<float*>(output.colors->data()));
+
+		for (auto& position : *output.positions) position.z = -position.z;
+		for (auto& normal   : *output.normals  ) normal.z   = -normal.z;
+
+		output.vertices->resize(nVertices);
+		for (uint32_t i = 0; i < nVertices; i++)
+		{
+			(*output.vertices)[i] = glm::uvec4(i, hasNormals ? i : 0, i, hasTexCoords ? i : 0);
+		}
+
+		/**
+		* @brief Indices, sequential if not indexed.
+		*/
+		std::vector<uint32_t> points(hasIndices ? indices.count : nVertices);
+		if (hasIndices)
+		{
+			Document::ReadIndices(indices, points.data());
+
+			for (const uint32_t point : points)
+			{
+				if (point >= nVertices) return false;
+			}
+		}
+		else
+		{
+			std::iota(points.begin(), points.end(), 0u);
+		}
+
+		/**
+		* @brief Triangles.
+		*/
+		auto& triangles = *output.primitiveVertices;
+		triangles.clear();
+
+		const uint64_t nPoints = points.size();
+		switch (mode)
+		{
+		case modeTriangles:
+			triangles.resize(nPoints / 3);
+			for (uint64_t i = 0; i < triangles.size(); i++)
+			{
+				triangles[i] = glm::uvec3(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]);
+			}
+			break;
+		case modeTriangleStrip:
+			triangles.resize(nPoints >= 3 ? nPoints - 2 : 0);
+			for (uint64_t i = 0; i < triangles.size(); i++)
+			{
+				triangles[i] = i % 2 == 0 ?
+					glm::uvec3(points[i], points[i + 1], points[i + 2]) :
+					glm::uvec3(points[i + 1], points[i], points[i + 2]);
+			}
+			break;
+		case modeTriangleFan:
+			triangles.resize(nPoints >= 3 ? nPoints - 2 : 0);
+			for (uint64_t i = 0; i < triangles.size(); i++)
+			{
+				triangles[i] = glm::uvec3(points[i + 1], points[i + 2], points[0]);
+			}
+			break;
+		}
+
+		if (outStats)
+		{
+			outStats->bytes     = positions.Bytes() +
+			                      (hasNormals   ? normals.Bytes()   : 0) +
+			                      (hasTexCoords ? texCoords.Bytes() : 0) +
+			                      (hasColors    ? colors.Bytes()    : 0) +
+			                      (hasIndices   ? indices.Bytes()   : 0);
+			outStats->vertices  = nVertices;
+			outStats->triangles = triangles.size();
+		}
+
+		return true;
+	}
+
+	bool GltfImporter::ReadAll(const std::vector<Output>& outputs, const std::function<void(uint32_t index)>& func, ThreadPool* threadPool) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (outputs.size() != m_Primitives.size()) return false;
+
+		std::atomic<bool> isSucceed = true;
+
+		ThreadPool::ParallelFor(threadPool, static_cast<uint32_t>(outputs.size()), [&](uint32_t i) {
+			if (!Read(i, outputs[i]))
+			{
+				std::stringstream ss;
+				ss << "GltfImporter: " << m_Path << " primitive " << i << " is not readable.";
+
+				SPICES_CORE_WARN(ss.str());
+
+				isSucceed = false;
+				return;
+			}
+
+			if (func) func(i);
+		});
+
+		return isSucceed;
+	}
+}
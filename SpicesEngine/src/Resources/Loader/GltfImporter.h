@@ -0,0 +1,179 @@
+/**
+* @file GltfImporter.h.
+* @brief The GltfImporter Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "Core/Library/FileLibrary.h"
+
+#include <glm/glm.hpp>
+#include <functional>
+
+namespace Spices {
+
+	/**
+	* @brief Forward declare.
+	*/
+	class ThreadPool;
+
+	/**
+	* @brief Binary glTF (.glb) reader.
+	* The file is mapped, the JSON chunk is parsed once into a tree of views into the mapping,
+	* and accessors are read straight from the BIN chunk into output arrays,
+	* tightly packed float accessors are copied in one memcpy.
+	* Strided buffer views, normalized integer components and sparse accessors are handled,
+	* an accessor without buffer view is zeros with its sparse values applied.
+	* Each mesh primitive is read independently, so primitives are read in parallel.
+	* Output matches ObjParser: z of positions and normals is negated, every position has a color (default white),
+	* a vertex is (position, normal, position, texcoord).
+	* Only triangles, triangle strips and triangle fans are read, buffers must be in the BIN chunk.
+	*/
+	class GltfImporter
+	{
+	public:
+
+		/**
+		* @brief Output arrays, all are overwritten.
+		*/
+		struct Output
+		{
+			std::vector<glm::vec3>*  positions         = nullptr;   /* @brief Positions.                  */
+			std::vector<glm::vec3>*  normals           = nullptr;   /* @brief Normals.                    */
+			std::vector<glm::vec3>*  colors            = nullptr;   /* @brief Colors, one per position.   */
+			std::vector<glm::vec2>*  texCoords         = nullptr;   /* @brief TexCoords.                  */
+			std::vector<glm::uvec4>* vertices          = nullptr;   /* @brief Vertices.                   */
+			std::vector<glm::uvec3>* primitiveVertices = nullptr;   /* @brief Triangles of vertices.      */
+		};
+
+		/**
+		* @brief A mesh primitive of the file.
+		*/
+		struct Primitive
+		{
+			std::string mesh;                   /* @brief Mesh name, mesh index if unnamed.     */
+			uint32_t    meshIndex      = 0;     /* @brief Index of mesh.                        */
+			uint32_t    primitiveIndex = 0;     /* @brief Index in mesh's primitives.           */
+		};
+
+		/**
+		* @brief Statistics of a Read.
+		*/
+		struct Stats
+		{
+			uint64_t bytes      = 0;    /* @brief Bytes read from BIN chunk.    */
+			uint64_t vertices   = 0;    /* @brief Vertices.                     */
+			uint64_t triangles  = 0;    /* @brief Triangles.                    */
+		};
+
+		/**
+		* @brief GLB sign, "glTF".
+		*/
+		static constexpr uint32_t Magic = 0x46546C67;
+
+		/**
+		* @brief GLB version.
+		*/
+		static constexpr uint32_t Version = 2;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		GltfImporter();
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~GltfImporter();
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		GltfImporter(const GltfImporter&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		GltfImporter& operator=(const GltfImporter&) = delete;
+
+		/**
+		* @brief Map a glb file and parse its JSON chunk.
+		* @param[in] path The file path.
+		* @return Returns true if succeed.
+		*/
+		bool Open(const std::string& path);
+
+		/**
+		* @brief Parse glb bytes, the bytes must outlive this importer.
+		* @param[in] data The bytes.
+		* @param[in] size Bytes count.
+		* @return Returns true if succeed.
+		*/
+		bool Open(const char* data, uint64_t size);
+
+		/**
+		* @brief UnMap the file.
+		*/
+		void Close();
+
+		/**
+		* @brief Get mesh primitives of the file, in mesh then primitive order.
+		* @return Returns mesh primitives.
+		*/
+		const std::vector<Primitive>& GetPrimitives() const { return m_Primitives; }
+
+		/**
+		* @brief Read a primitive, thread safe.
+		* @param[in] index Index in GetPrimitives().
+		* @param[in] output Output arrays.
+		* @param[out] outStats Statistics, may be nullptr.
+		* @return Returns true if succeed.
+		*/
+		bool Read(uint32_t index, const Output& output, Stats* outStats = nullptr) const;
+
+		/**
+		* @brief Read all primitives in parallel.
+		* @param[in] outputs Output arrays, one per primitive.
+		* @param[in] func Called on the reading thread after a primitive is read, may be nullptr.
+		* @param[in] threadPool ThreadPool reads primitives with the calling thread, nullptr for calling thread only.
+		* @return Returns true if all primitives succeed.
+		*/
+		bool ReadAll(
+			const std::vector<Output>&                     outputs    ,
+			const std::function<void(uint32_t index)>&     func       ,
+			ThreadPool*                                    threadPool = nullptr
+		) const;
+
+	private:
+
+		/**
+		* @brief Parsed JSON chunk, defined in cpp.
+		*/
+		struct Document;
+
+		/**
+		* @brief Mapped file, not valid if opened from memory.
+		*/
+		MappedFileHandle m_File;
+
+		/**
+		* @brief File path, for logs.
+		*/
+		std::string m_Path;
+
+		/**
+		* @brief Parsed JSON chunk.
+		*/
+		std::unique_ptr<Document> m_Document;
+
+		/**
+		* @brief Mesh primitives.
+		*/
+		std::vector<Primitive> m_Primitives;
+	};
+}
@@ -11,6 +11,10 @@
 #include "Utils/YamlUtils.h"
 #include "Resources/Material/Material.h"
 #include "Systems/ResourceSystem.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem.h"
+#include "Resources/Material/MaterialCache.h"
+
+#include <filesystem>
 
 namespace Spices {
 
@@ -71,10 +75,14 @@ namespace Spices {
 		if      (LoadFromSASSET(fileName, outMaterial))  return true;
 
 		/**
-		* @brief Load from .material file second.
+		* @brief Load from .material file second, and cook it for next load.
 		*/
-		else if (LoadFromMaterial(fileName, outMaterial)) return true;
-		
+		else if (LoadFromMaterial(fileName, outMaterial))
+		{
+			WriteSASSET(fileName, outMaterial);
+			return true;
+		}
+
 		else
 		{
 			std::stringstream ss;
@@ -89,30 +97,19 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		bool isFind = false;
-		std::string filePath;
-		for (auto& it : ResourceSystem::GetSearchFolder())
-		{
-			filePath = it + defaultMaterialPath + "Material." + fileName + ".material";
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				isFind = true;
-				break;
-			}
-		}
-		if (!isFind) return false;
+		VirtualFileSystem::Entry entry;
+		if (!VirtualFileSystem::Resolve(defaultMaterialPath + "Material." + fileName + ".material", entry)) return false;
 
 		/**
 		* @brief Read .material file as bytes.
 		*/
-		std::ifstream stream(filePath);
-		std::stringstream strStream;
-		strStream << stream.rdbuf();
+		VirtualFileSystem::Blob blob;
+		if (!VirtualFileSystem::Load(entry, blob)) return false;
 
 		/**
 		* @brief Explain bytes as a YAML::Node.
 		*/
-		YAML::Node data = YAML::Load(strStream.str());
+		YAML::Node data = YAML::Load(std::string(blob.data, blob.size));
 
 		/**
 		 * @brief Try get material name.
@@ -120,7 +117,7 @@ namespace Spices {
 		if (!data["Material"])
 		{
 			std::stringstream ss;
-			ss << filePath << ":  Not find a Material Node.";
+			ss << entry.path << ":  Not find a Material Node.";
 			
 			SPICES_CORE_ERROR(ss.str());
 			return false;
@@ -152,7 +149,7 @@ namespace Spices {
 		else
 		{
 			std::stringstream ss;
-			ss << filePath << ":  Not find a Shaders Node.";
+			ss << entry.path << ":  Not find a Shaders Node.";
 			
 			SPICES_CORE_ERROR(ss.str());
 			return false;
@@ -224,46 +221,174 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		bool isFind = false;
-		std::string filePath;
-		for (auto& it : ResourceSystem::GetSearchFolder())
+		VirtualFileSystem::Entry entry;
+		if (!VirtualFileSystem::Resolve(defaultBinMaterialPath + "Material." + fileName + ".sasset", entry)) return false;
+
+		/**
+		* @brief Stale if .material file is newer, a packed file is compared by its pak.
+		*/
+		VirtualFileSystem::Entry source;
+		if (VirtualFileSystem::Resolve(defaultMaterialPath + "Material." + fileName + ".material", source))
 		{
-			filePath = it + defaultBinMaterialPath + "Material." + fileName + ".sasset";
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				isFind = true;
-				break;
-			}
+			std::error_code sourceError, binError;
+			const auto sourceTime = std::filesystem::last_write_time(source.path, sourceError);
+			const auto binTime    = std::filesystem::last_write_time(entry.path, binError);
+
+			if (sourceError || binError || sourceTime > binTime) return false;
 		}
-		if (!isFind) return false;
 
-		FileHandle f;
-		FileLibrary::FileLibrary_Open(filePath.c_str(), FILE_MODE_READ, true, &f);
+		/**
+		* @brief Read .sasset file as bytes, the only read.
+		*/
+		VirtualFileSystem::Blob blob;
+		if (!VirtualFileSystem::Load(entry, blob)) return false;
 
-		uint64_t readed = 0;
+		BlobReader reader(blob);
 
 		char startSign[100];
-		FileLibrary::FileLibrary_Read(&f, sizeof(char) * 100, &startSign, &readed);
+		const bool isStartSign = reader.Read(sizeof(char) * 100, &startSign);
 
-		if (!StringLibrary::StringsEqual(startSign, LoaderSignSatrt))
+		if (!isStartSign || !StringLibrary::StringsEqual(startSign, LoaderSignSatrt) || reader.Remain() < sizeof(char) * 100)
 		{
-			FileLibrary::FileLibrary_Close(&f);
 			return false;
 		}
 
-		// TODO: ReadData
-
 		char overSign[100];
-		FileLibrary::FileLibrary_Read(&f, sizeof(char) * 100, &overSign, &readed);
+		std::memcpy(overSign, blob.data + blob.size - sizeof(char) * 100, sizeof(char) * 100);
 
 		if (!StringLibrary::StringsEqual(overSign, LoaderSignOver))
 		{
-			FileLibrary::FileLibrary_Close(&f);
 			return false;
 		}
 
+		/**
+		* @brief Cooked data lies between signs.
+		*/
+		MaterialCache::Data data;
+		if (!MaterialCache::Decode(blob.data + sizeof(char) * 100, reader.Remain() - sizeof(char) * 100, data))
+		{
+			std::stringstream ss;
+			ss << entry.path << ":  Cooked by another layout, cook again.";
+
+			SPICES_CORE_INFO(ss.str());
+			return false;
+		}
+
+		for (const auto& shader : data.shaders)
+		{
+			outMaterial->m_Shaders       [shader.stage].push_back(shader.path);
+			outMaterial->m_DefaultShaders[shader.stage].push_back(shader.path);
+		}
+
+		for (const auto& texture : data.textures)
+		{
+			TextureParam param;
+			param.textureType = texture.textureType;
+			param.texturePath = texture.texturePath;
+
+			outMaterial->m_TextureParams       .push_back(texture.name, param);
+			outMaterial->m_DefaultTextureParams.push_back(texture.name, param);
+		}
+
+		for (const auto& parameter : data.parameters)
+		{
+			ConstantParams constantParams;
+			constantParams.value.paramType  = parameter.paramType;
+			constantParams.value.paramValue = MaterialCache::GetValue(parameter, data.values);
+			constantParams.defaultValue     = constantParams.value;
+
+			if (parameter.hasMinValue)
+			{
+				constantParams.hasMinValue    = true;
+				constantParams.min.paramType  = parameter.paramType;
+				constantParams.min.paramValue = MaterialCache::GetValue(parameter, data.minValues);
+			}
+			if (parameter.hasMaxValue)
+			{
+				constantParams.hasMaxValue    = true;
+				constantParams.max.paramType  = parameter.paramType;
+				constantParams.max.paramValue = MaterialCache::GetValue(parameter, data.maxValues);
+			}
+
+			outMaterial->m_ConstantParams.push_back(parameter.name, constantParams);
+		}
+
+		return true;
+	}
+
+	bool MaterialLoader::WriteSASSET(const std::string& fileName, Material* material)
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Cook beside a loose .material file, packed materials are cooked when packing.
+		*/
+		VirtualFileSystem::Entry source;
+		if (!VirtualFileSystem::Resolve(defaultMaterialPath + "Material." + fileName + ".material", source) || source.IsPacked())
+		{
+			return false;
+		}
+
+		MaterialCache::Data data;
+		data.material = fileName;
+
+		for (const auto& [stage, paths] : material->m_Shaders)
+		{
+			for (const auto& path : paths)
+			{
+				data.shaders.push_back({ stage, path });
+			}
+		}
+
+		material->m_TextureParams.for_each([&](const std::string& k, const TextureParam& v) {
+			data.textures.push_back({ k, v.textureType, v.texturePath });
+			return false;
+		});
+
+		bool isSucceed = true;
+		material->m_ConstantParams.for_each([&](const std::string& k, const ConstantParams& v) {
+			isSucceed = MaterialCache::AddParameter(
+				data                                          ,
+				k                                             ,
+				v.value.paramType                             ,
+				v.value.paramValue                            ,
+				v.hasMinValue ? &v.min.paramValue : nullptr   ,
+				v.hasMaxValue ? &v.max.paramValue : nullptr
+			);
+			return !isSucceed;
+		});
+
+		if (!isSucceed)
+		{
+			std::stringstream ss;
+			ss << "MaterialLoader: " << fileName << " has a parameter can not be cooked, keep loading from .material file.";
+
+			SPICES_CORE_WARN(ss.str());
+			return false;
+		}
+
+		std::vector<char> bytes(LoaderSignSatrt, LoaderSignSatrt + 100);
+		MaterialCache::Encode(data, bytes);
+		bytes.insert(bytes.end(), LoaderSignOver, LoaderSignOver + 100);
+
+		const std::string logicalPath = defaultBinMaterialPath + "Material." + fileName + ".sasset";
+		const std::string filePath    = VirtualFileSystem::GetMountRoot(source.mount) + logicalPath;
+
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(filePath).parent_path(), ec);
+
+		FileHandle f;
+		if (!FileLibrary::FileLibrary_Open(filePath.c_str(), FILE_MODE_WRITE, true, &f)) return false;
+
+		uint64_t written = 0;
+		const bool isWrite = FileLibrary::FileLibrary_Write(&f, bytes.size(), bytes.data(), &written) && written == bytes.size();
+
 		FileLibrary::FileLibrary_Close(&f);
 
+		if (!isWrite) return false;
+
+		VirtualFileSystem::AddFile(source.mount, logicalPath);
+
 		return true;
 	}
 
@@ -66,14 +66,21 @@ namespace Spices {
 		static bool LoadFromMaterial(const std::string& fileName, Material* outMaterial);
 
 		/**
-		* @brief Load data from a .sasset file.
+		* @brief Load data from a cooked .sasset file with a single read.
 		* @param[in] fileName Material path in disk.
 		* @param[in,out] outMaterial Material pointer, only pass this to it.
-		* @return Returns true if load data successfully.
-		* @todo Finish it.
+		* @return Returns false if not cooked, cooked by another layout or the .material file is newer.
 		*/
 		static bool LoadFromSASSET(const std::string& fileName, Material* outMaterial);
 
+		/**
+		* @brief Cook a material loaded from .material file to a .sasset file beside it.
+		* @param[in] fileName Material path in disk.
+		* @param[in] material Material loaded from .material file.
+		* @return Returns true if written.
+		*/
+		static bool WriteSASSET(const std::string& fileName, Material* material);
+
 	public:
 
 		/**
@@ -10,9 +10,12 @@
 #include "Core/Library/FileLibrary.h"
 #include "Core/Library/StringLibrary.h"
 #include "Systems/ResourceSystem.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem.h"
 #include "Resources/Mesh/MeshProcessor.h"
-
-#include "tiny_obj_loader.h"
+#include "Core/Thread/ThreadPool.h"
+#include "ObjParser.h"
+#include "GltfImporter.h"
+#include "Resources/ResourcePool/ResourcePool.h"
 
 namespace Spices {
 
@@ -31,6 +34,11 @@ namespace Spices {
 	*/
 	const std::string defaultFBXMeshPath = "Meshes/src/fbx/";
 
+	/**
+	* @brief Const variable: GLB Mesh File Path.
+	*/
+	const std::string defaultGLBMeshPath = "Meshes/src/glb/";
+
 	/**
 	* @brief Const variable: Mesh File Confirm header staer.
 	*/
@@ -47,160 +55,163 @@ namespace Spices {
 
 		if      ( LoadFromSASSET(fileName, outMeshPack)) return true;
 		else if ( LoadFromOBJ(   fileName, outMeshPack)) return true;
+		else if ( LoadFromGLB(   fileName, outMeshPack)) return true;
 		else if ( LoadFromFBX(   fileName, outMeshPack)) return true;
 		else return false;
 	}
 
-	bool MeshLoader::LoadFromOBJ(const std::string& fileName, MeshPack* outMeshPack)
+	bool MeshLoader::ImportGLB(const std::string& fileName, std::vector<std::shared_ptr<MeshPack>>& outMeshPacks, bool isCreateBuffer)
 	{
 		SPICES_PROFILE_ZONE;
 
-		bool isFind = false;
-		std::string filePath;
-		int index = 0;
-		for (auto& it : ResourceSystem::GetSearchFolder())
+		outMeshPacks.clear();
+
+		VirtualFileSystem::Entry entry;
+		if (!VirtualFileSystem::Resolve(defaultGLBMeshPath + fileName + ".glb", entry)) return false;
+
+		/**
+		* @brief GLB is cooker input and mapped from disk, never packed.
+		*/
+		if (entry.IsPacked()) return false;
+
+		GltfImporter importer;
+		if (!importer.Open(entry.path)) return false;
+
+		const int index = static_cast<int>(entry.mount);
+		const uint32_t nPrimitives = static_cast<uint32_t>(importer.GetPrimitives().size());
+
+		std::vector<GltfImporter::Output> outputs(nPrimitives);
+		for (uint32_t i = 0; i < nPrimitives; i++)
 		{
-			filePath = it + defaultOBJMeshPath + fileName + ".obj";
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				isFind = true;
-				break;
-			}
-			index++;
-		}
-		if (!isFind) return false;
-		
-		if (!FileLibrary::FileLibrary_Exists(filePath.c_str())) {
-			return false;
+			auto pack = std::make_shared<FilePack>(fileName + "#" + std::to_string(i), false);
+			auto& resource = pack->m_MeshResource;
+
+			outputs[i].positions         = resource.positions.attributes.get();
+			outputs[i].normals           = resource.normals.attributes.get();
+			outputs[i].colors            = resource.colors.attributes.get();
+			outputs[i].texCoords         = resource.texCoords.attributes.get();
+			outputs[i].vertices          = resource.vertices.attributes.get();
+			outputs[i].primitiveVertices = resource.primitiveVertices.attributes.get();
+
+			outMeshPacks.push_back(std::move(pack));
 		}
-		
-		tinyobj::attrib_t attrib;
-		std::vector<tinyobj::shape_t> shapes;
-		std::vector<tinyobj::material_t> materials;
-		std::string warn, err;
-		
-		if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filePath.c_str()))
+
+		/**
+		* @brief Read and process primitives in parallel.
+		*/
+		const bool isSucceed = importer.ReadAll(outputs, [&](uint32_t i) {
+			MeshPack* pack = outMeshPacks[i].get();
+
+			FillDefaultAttributes(pack);
+			MeshProcessor::GenerateMeshLodClusterHierarchy(pack);
+			WriteSASSET(index, pack->m_MeshPackName, pack);
+		}, ThreadPool::Get().get());
+
+		if (!isSucceed)
 		{
+			outMeshPacks.clear();
 			return false;
 		}
-		
-		outMeshPack->m_MeshResource.positions.attributes->resize(attrib.vertices.size() / 3);
-		for (uint32_t i = 0; i < attrib.vertices.size() / 3; i++)
-		{
-			(*outMeshPack->m_MeshResource.positions.attributes)[i].x =  attrib.vertices[3 * i + 0];
-			(*outMeshPack->m_MeshResource.positions.attributes)[i].y =  attrib.vertices[3 * i + 1];
-			(*outMeshPack->m_MeshResource.positions.attributes)[i].z = -attrib.vertices[3 * i + 2];
-		}
-		if (attrib.vertices.size() == 0)
+
+		/**
+		* @brief Buffers are created on calling thread.
+		*/
+		for (auto& pack : outMeshPacks)
 		{
-			outMeshPack->m_MeshResource.positions.attributes->resize(1);
+			if (isCreateBuffer) pack->CreateBuffer();
 
-			(*outMeshPack->m_MeshResource.positions.attributes)[0].x = 0.0f;
-			(*outMeshPack->m_MeshResource.positions.attributes)[0].y = 0.0f;
-			(*outMeshPack->m_MeshResource.positions.attributes)[0].z = 0.0f;
+			ResourcePool<MeshPack>::Registry(pack->m_MeshPackName, pack);
 		}
 
-		outMeshPack->m_MeshResource.normals.attributes->resize(attrib.normals.size() / 3);
-		for (uint32_t i = 0; i < attrib.normals.size() / 3; i++)
-		{
-			(*outMeshPack->m_MeshResource.normals.attributes)[i].x =  attrib.normals[3 * i + 0];
-			(*outMeshPack->m_MeshResource.normals.attributes)[i].y =  attrib.normals[3 * i + 1];
-			(*outMeshPack->m_MeshResource.normals.attributes)[i].z = -attrib.normals[3 * i + 2];
-		}
-		if (attrib.normals.size() == 0)
-		{
-			outMeshPack->m_MeshResource.normals.attributes->resize(1);
+		return true;
+	}
 
-			(*outMeshPack->m_MeshResource.normals.attributes)[0].x = 0.0f;
-			(*outMeshPack->m_MeshResource.normals.attributes)[0].y = 1.0f;
-			(*outMeshPack->m_MeshResource.normals.attributes)[0].z = 0.0f;
-		}
+	bool MeshLoader::LoadFromOBJ(const std::string& fileName, MeshPack* outMeshPack)
+	{
+		SPICES_PROFILE_ZONE;
 
-		outMeshPack->m_MeshResource.colors.attributes->resize(attrib.colors.size() / 3);
-		for (uint32_t i = 0; i < attrib.colors.size() / 3; i++)
-		{
-			(*outMeshPack->m_MeshResource.colors.attributes)[i].x = attrib.colors[3 * i + 0];
-			(*outMeshPack->m_MeshResource.colors.attributes)[i].y = attrib.colors[3 * i + 1];
-			(*outMeshPack->m_MeshResource.colors.attributes)[i].z = attrib.colors[3 * i + 2];
-		}
-		if (attrib.colors.size() == 0)
-		{
-			outMeshPack->m_MeshResource.colors.attributes->resize(1);
+		VirtualFileSystem::Entry entry;
+		if (!VirtualFileSystem::Resolve(defaultOBJMeshPath + fileName + ".obj", entry)) return false;
 
-			(*outMeshPack->m_MeshResource.colors.attributes)[0].x = 1.0f;
-			(*outMeshPack->m_MeshResource.colors.attributes)[0].y = 1.0f;
-			(*outMeshPack->m_MeshResource.colors.attributes)[0].z = 1.0f;
-		}
+		/**
+		* @brief OBJ is cooker input and parsed from disk, never packed.
+		*/
+		if (entry.IsPacked()) return false;
 
-		outMeshPack->m_MeshResource.texCoords.attributes->resize(attrib.texcoords.size() / 2);
-		for (uint32_t i = 0; i < attrib.texcoords.size() / 2; i++)
-		{
-			(*outMeshPack->m_MeshResource.texCoords.attributes)[i].x =        attrib.texcoords[2 * i + 0];
-			(*outMeshPack->m_MeshResource.texCoords.attributes)[i].y = 1.0f - attrib.texcoords[2 * i + 1];
-		}
-		if (attrib.texcoords.size() == 0)
-		{
-			outMeshPack->m_MeshResource.texCoords.attributes->resize(1);
+		const std::string& filePath = entry.path;
+		const int index = static_cast<int>(entry.mount);
+		
+		auto& resource = outMeshPack->m_MeshResource;
 
-			(*outMeshPack->m_MeshResource.texCoords.attributes)[0].x = 0.0f;
-			(*outMeshPack->m_MeshResource.texCoords.attributes)[0].y = 0.0f;
-		}
+		ObjParser::Output output;
+		output.positions         = resource.positions.attributes.get();
+		output.normals           = resource.normals.attributes.get();
+		output.colors            = resource.colors.attributes.get();
+		output.texCoords         = resource.texCoords.attributes.get();
+		output.vertices          = resource.vertices.attributes.get();
+		output.primitiveVertices = resource.primitiveVertices.attributes.get();
 
-		std::unordered_map<glm::uvec4, uint32_t> verticesMap;
-		for (const auto& shape : shapes)
+		if (!ObjParser::Parse(filePath, output, ThreadPool::Get().get()))
 		{
-			uint32_t start = outMeshPack->m_MeshResource.primitiveVertices.attributes->size();
-			outMeshPack->m_MeshResource.primitiveVertices.attributes->resize(start + shape.mesh.indices.size() / 3);
-
-			for (uint32_t i = 0; i < shape.mesh.indices.size() / 3; i++)
-			{
-				std::array<glm::uvec4, 3> vertexArray;
-				for (uint32_t j = 0; j < 3; j++)
-				{
-					const auto& index = shape.mesh.indices[3 * i + j];
-
-					vertexArray[j] = glm::uvec4(
-						index.vertex_index   == -1 ? 0 : index.vertex_index,
-						index.normal_index   == -1 ? 0 : index.normal_index,
-						index.vertex_index   == -1 ? 0 : index.vertex_index,
-						index.texcoord_index == -1 ? 0 : index.texcoord_index
-					);
-
-					if (verticesMap.count(vertexArray[j]) == 0)
-					{
-						verticesMap[vertexArray[j]] = static_cast<uint32_t>(outMeshPack->m_MeshResource.vertices.attributes->size());
-						outMeshPack->m_MeshResource.vertices.attributes->push_back(vertexArray[j]);
-					}
-				}
-
-				(*outMeshPack->m_MeshResource.primitiveVertices.attributes)[start + i].x = verticesMap[vertexArray[0]];
-				(*outMeshPack->m_MeshResource.primitiveVertices.attributes)[start + i].y = verticesMap[vertexArray[1]];
-				(*outMeshPack->m_MeshResource.primitiveVertices.attributes)[start + i].z = verticesMap[vertexArray[2]];
-			}
+			return false;
 		}
 
+		FillDefaultAttributes(outMeshPack);
 		MeshProcessor::GenerateMeshLodClusterHierarchy(outMeshPack);
 		WriteSASSET(index, fileName, outMeshPack);
 
 		return true;
 	}
 
-	bool MeshLoader::LoadFromFBX(const std::string& fileName, MeshPack* outMeshPack)
+	bool MeshLoader::LoadFromGLB(const std::string& fileName, MeshPack* outMeshPack)
 	{
 		SPICES_PROFILE_ZONE;
 
-		bool isFind = false;
-		std::string filePath;
-		for (auto& it : ResourceSystem::GetSearchFolder())
+		/**
+		* @brief Split fileName#index.
+		*/
+		const size_t split = fileName.rfind('#');
+		const std::string glbName = fileName.substr(0, split);
+
+		uint32_t primitive = 0;
+		if (split != std::string::npos)
 		{
-			filePath = it + defaultFBXMeshPath + fileName + ".fbx";
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				isFind = true;
-				break;
-			}
+			const std::string number = fileName.substr(split + 1);
+			if (number.empty() || number.find_first_not_of("0123456789") != std::string::npos) return false;
+
+			primitive = static_cast<uint32_t>(std::stoul(number));
 		}
-		if (!isFind) return false;
+
+		/**
+		* @brief Import all primitives at once, the file is parsed once,
+		* later packs of the file load from sasset or copy from ResourcePool.
+		*/
+		std::vector<std::shared_ptr<MeshPack>> meshPacks;
+		if (!ImportGLB(glbName, meshPacks)) return false;
+		if (primitive >= meshPacks.size()) return false;
+
+		outMeshPack->m_MeshResource = meshPacks[primitive]->m_MeshResource;
+
+		/**
+		* @brief A pack named without index also gets its own sasset.
+		*/
+		if (split == std::string::npos)
+		{
+			VirtualFileSystem::Entry entry;
+			VirtualFileSystem::Resolve(defaultGLBMeshPath + glbName + ".glb", entry);
+
+			WriteSASSET(static_cast<int>(entry.mount), fileName, outMeshPack);
+		}
+
+		return true;
+	}
+
+	bool MeshLoader::LoadFromFBX(const std::string& fileName, MeshPack* outMeshPack)
+	{
+		SPICES_PROFILE_ZONE;
+
+		VirtualFileSystem::Entry entry;
+		if (!VirtualFileSystem::Resolve(defaultFBXMeshPath + fileName + ".fbx", entry)) return false;
 
 		// TODO: 
 		return false;
@@ -210,99 +221,81 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		bool isFind = false;
-		std::string filePath;
-		for (auto& it : ResourceSystem::GetSearchFolder())
-		{
-			filePath = it + defaultBinMeshPath + fileName + ".sasset";
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				isFind = true;
-				break;
-			}
-		}
-		if (!isFind) return false;
+		VirtualFileSystem::Entry entry;
+		if (!VirtualFileSystem::Resolve(defaultBinMeshPath + fileName + ".sasset", entry)) return false;
 
-		if (!FileLibrary::FileLibrary_Exists(filePath.c_str())) {
-			return false;
-		}
-
-		FileHandle f;
-		FileLibrary::FileLibrary_Open(filePath.c_str(), FILE_MODE_READ, true, &f);
+		VirtualFileSystem::Blob blob;
+		if (!VirtualFileSystem::Load(entry, blob)) return false;
 
-		uint64_t readed = 0;
+		BlobReader reader(blob);
 
 		char startSign[100];
-		FileLibrary::FileLibrary_Read(&f, sizeof(char) * 100, &startSign, &readed);
+		const bool isStartSign = reader.Read(sizeof(char) * 100, &startSign);
 
-		if (!StringLibrary::StringsEqual(startSign, MeshLoaderSignSatrt))
+		if (!isStartSign || !StringLibrary::StringsEqual(startSign, MeshLoaderSignSatrt))
 		{
-			FileLibrary::FileLibrary_Close(&f);
 			return false;
 		}
 
 		uint32_t positionsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &positionsCount, &readed);
+		reader.Read(sizeof(uint32_t), &positionsCount);
 		outMeshPack->m_MeshResource.positions.attributes->resize(positionsCount);
 		
 		uint32_t normalsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &normalsCount, &readed);
+		reader.Read(sizeof(uint32_t), &normalsCount);
 		outMeshPack->m_MeshResource.normals.attributes->resize(normalsCount);
 
 		uint32_t colorsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &colorsCount, &readed);
+		reader.Read(sizeof(uint32_t), &colorsCount);
 		outMeshPack->m_MeshResource.colors.attributes->resize(colorsCount);
 
 		uint32_t texCoordsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &texCoordsCount, &readed);
+		reader.Read(sizeof(uint32_t), &texCoordsCount);
 		outMeshPack->m_MeshResource.texCoords.attributes->resize(texCoordsCount);
 
 		uint32_t verticesCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &verticesCount, &readed);
+		reader.Read(sizeof(uint32_t), &verticesCount);
 		outMeshPack->m_MeshResource.vertices.attributes->resize(verticesCount);
 
 		uint32_t primitivePointsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &primitivePointsCount, &readed);
+		reader.Read(sizeof(uint32_t), &primitivePointsCount);
 		outMeshPack->m_MeshResource.primitivePoints.attributes->resize(primitivePointsCount);
 
 		uint32_t primitiveVerticesCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &primitiveVerticesCount, &readed);
+		reader.Read(sizeof(uint32_t), &primitiveVerticesCount);
 		outMeshPack->m_MeshResource.primitiveVertices.attributes->resize(primitiveVerticesCount);
 
 		uint32_t primitiveLocationsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &primitiveLocationsCount, &readed);
+		reader.Read(sizeof(uint32_t), &primitiveLocationsCount);
 		outMeshPack->m_MeshResource.primitiveLocations.attributes->resize(primitiveLocationsCount);
 
 		uint32_t meshletsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &meshletsCount, &readed);
+		reader.Read(sizeof(uint32_t), &meshletsCount);
 		outMeshPack->m_MeshResource.meshlets.attributes->resize(meshletsCount);
 
 		uint32_t lodsCount = 0;
-		FileLibrary::FileLibrary_Read(&f, sizeof(uint32_t), &lodsCount, &readed);
+		reader.Read(sizeof(uint32_t), &lodsCount);
 		outMeshPack->m_MeshResource.lods.attributes->resize(lodsCount);
 		
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::vec3)  * positionsCount          , outMeshPack->m_MeshResource.positions.attributes          ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::vec3)  * normalsCount            , outMeshPack->m_MeshResource.normals.attributes            ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::vec3)  * colorsCount             , outMeshPack->m_MeshResource.colors.attributes             ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::vec2)  * texCoordsCount          , outMeshPack->m_MeshResource.texCoords.attributes          ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::uvec4) * verticesCount           , outMeshPack->m_MeshResource.vertices.attributes           ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::uvec3) * primitivePointsCount    , outMeshPack->m_MeshResource.primitivePoints.attributes    ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::uvec3) * primitiveVerticesCount  , outMeshPack->m_MeshResource.primitiveVertices.attributes  ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(glm::uvec3) * primitiveLocationsCount , outMeshPack->m_MeshResource.primitiveLocations.attributes ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(Meshlet)    * meshletsCount           , outMeshPack->m_MeshResource.meshlets.attributes           ->data(), &readed);
-		FileLibrary::FileLibrary_Read(&f, sizeof(Lod)        * lodsCount               , outMeshPack->m_MeshResource.lods.attributes               ->data(), &readed);
+		reader.Read(sizeof(glm::vec3)  * positionsCount          , outMeshPack->m_MeshResource.positions.attributes          ->data());
+		reader.Read(sizeof(glm::vec3)  * normalsCount            , outMeshPack->m_MeshResource.normals.attributes            ->data());
+		reader.Read(sizeof(glm::vec3)  * colorsCount             , outMeshPack->m_MeshResource.colors.attributes             ->data());
+		reader.Read(sizeof(glm::vec2)  * texCoordsCount          , outMeshPack->m_MeshResource.texCoords.attributes          ->data());
+		reader.Read(sizeof(glm::uvec4) * verticesCount           , outMeshPack->m_MeshResource.vertices.attributes           ->data());
+		reader.Read(sizeof(glm::uvec3) * primitivePointsCount    , outMeshPack->m_MeshResource.primitivePoints.attributes    ->data());
+		reader.Read(sizeof(glm::uvec3) * primitiveVerticesCount  , outMeshPack->m_MeshResource.primitiveVertices.attributes  ->data());
+		reader.Read(sizeof(glm::uvec3) * primitiveLocationsCount , outMeshPack->m_MeshResource.primitiveLocations.attributes ->data());
+		reader.Read(sizeof(Meshlet)    * meshletsCount           , outMeshPack->m_MeshResource.meshlets.attributes           ->data());
+		reader.Read(sizeof(Lod)        * lodsCount               , outMeshPack->m_MeshResource.lods.attributes               ->data());
 
 		char overSign[100];
-		FileLibrary::FileLibrary_Read(&f, sizeof(char) * 100, &overSign, &readed);
+		const bool isOverSign = reader.Read(sizeof(char) * 100, &overSign);
 
-		if (!StringLibrary::StringsEqual(overSign, MeshLoaderSignOver))
+		if (!isOverSign || !StringLibrary::StringsEqual(overSign, MeshLoaderSignOver))
 		{
-			FileLibrary::FileLibrary_Close(&f);
 			return false;
 		}
 
-		FileLibrary::FileLibrary_Close(&f);
-
 		return true;
 	}
 
@@ -310,9 +303,10 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::string filePath = ResourceSystem::GetSearchFolder()[folderIndex] + defaultBinMeshPath + fileName + ".sasset";
+		const std::string logicalPath = defaultBinMeshPath + fileName + ".sasset";
+		const std::string filePath    = ResourceSystem::GetSearchFolder()[folderIndex] + logicalPath;
 
-		if (FileLibrary::FileLibrary_Exists(filePath.c_str())) {
+		if (VirtualFileSystem::Exists(logicalPath)) {
 			return false;
 		}
 
@@ -368,6 +362,32 @@ namespace Spices {
 
 		FileLibrary::FileLibrary_Close(&f);
 
+		VirtualFileSystem::AddFile(folderIndex, logicalPath);
+
 		return true;
 	}
+
+	void MeshLoader::FillDefaultAttributes(MeshPack* outMeshPack)
+	{
+		SPICES_PROFILE_ZONE;
+
+		auto& resource = outMeshPack->m_MeshResource;
+
+		if (resource.positions.attributes->empty())
+		{
+			resource.positions.attributes->push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+		}
+		if (resource.normals.attributes->empty())
+		{
+			resource.normals.attributes->push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+		}
+		if (resource.colors.attributes->empty())
+		{
+			resource.colors.attributes->push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+		}
+		if (resource.texCoords.attributes->empty())
+		{
+			resource.texCoords.attributes->push_back(glm::vec2(0.0f, 0.0f));
+		}
+	}
 }
\ No newline at end of file
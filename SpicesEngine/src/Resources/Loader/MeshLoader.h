@@ -38,6 +38,11 @@ namespace Spices {
 		* @brief binary type
 		*/
 		SASSET = 3,
+
+		/**
+		* @brief glb type
+		*/
+		GLB = 4,
 	};
 	
 	/**
@@ -57,6 +62,17 @@ namespace Spices {
 		*/
 		static bool Load(const std::string& fileName, MeshPack* outMeshPack);
 
+		/**
+		* @brief Import all primitives of a .glb file, primitives are read in parallel.
+		* Each primitive is emitted as a FilePack named fileName#index, written to sasset and registered to ResourcePool,
+		* so a later FilePack of the same name loads from sasset or copies from the pool.
+		* @param[in] fileName glb file name.
+		* @param[out] outMeshPacks One meshpack per primitive, in mesh then primitive order.
+		* @param[in] isCreateBuffer Whether it needs to create buffer.
+		* @return Returns true if all primitives are imported.
+		*/
+		static bool ImportGLB(const std::string& fileName, std::vector<std::shared_ptr<MeshPack>>& outMeshPacks, bool isCreateBuffer = true);
+
 	private:
 
 		/**
@@ -67,6 +83,14 @@ namespace Spices {
 		*/
 		static bool LoadFromOBJ(const std::string& fileName, MeshPack* outMeshPack);
 
+		/**
+		* @brief Load a primitive from a .glb file, by ImportGLB of all its primitives.
+		* @param[in] fileName glb file name, fileName#index selects a primitive, the first one if no index.
+		* @param[in,out] outMeshPack meshpack pointer, only pass this to it.
+		* @return Returns true if load data succssfully.
+		*/
+		static bool LoadFromGLB(const std::string& fileName, MeshPack* outMeshPack);
+
 		/**
 		* @brief Load data from a .fbx file.
 		* @param[in] filepath Mesh file path in disk.
@@ -91,5 +115,11 @@ namespace Spices {
 		* @return Returns true if write data succssfully.
 		*/
 		static bool WriteSASSET(int folderIndex, const std::string& fileName, MeshPack* outMeshPack);
+
+		/**
+		* @brief Add a default element to empty attributes, a vertex with missing index refers to the first one.
+		* @param[in,out] outMeshPack meshpack pointer, only pass this to it.
+		*/
+		static void FillDefaultAttributes(MeshPack* outMeshPack);
 	};
 }
\ No newline at end of file
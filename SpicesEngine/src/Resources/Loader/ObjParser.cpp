@@ -0,0 +1,602 @@
+/**
+* @file ObjParser.cpp.
+* @brief The ObjParser Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "ObjParser.h"
+#include "Core/Library/FileLibrary.h"
+#include "Core/Thread/ThreadPool.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Empty slot of dedup hash.
+		*/
+		constexpr uint32_t emptySlot = UINT32_MAX;
+
+		/**
+		* @brief Items per task of corner passes.
+		*/
+		constexpr uint64_t cornersPerTask = 1 << 20;
+
+		/**
+		* @brief A line aligned piece of the file.
+		*/
+		struct Chunk
+		{
+			const char*             begin        = nullptr;     /* @brief First byte.                      */
+			const char*             end          = nullptr;     /* @brief One past last byte.              */
+			uint64_t                positions    = 0;           /* @brief Count of v lines.                */
+			uint64_t                normals      = 0;           /* @brief Count of vn lines.               */
+			uint64_t                texCoords    = 0;           /* @brief Count of vt lines.               */
+			uint64_t                positionBase = 0;           /* @brief v lines before this chunk.       */
+			uint64_t                normalBase   = 0;           /* @brief vn lines before this chunk.      */
+			uint64_t                texCoordBase = 0;           /* @brief vt lines before this chunk.      */
+			std::vector<glm::uvec3> corners;                    /* @brief Face corners (v, vn, vt).        */
+			std::vector<uint32_t>   faces;                      /* @brief Corners count of faces.          */
+			uint64_t                triangles    = 0;           /* @brief Triangles of faces.              */
+			uint64_t                triangleBase = 0;           /* @brief Triangles before this chunk.     */
+			const char*             error        = nullptr;     /* @brief First invalid line.              */
+		};
+
+		/**
+		* @brief Type of a line.
+		*/
+		enum class LineType
+		{
+			Other,
+			Position,
+			Normal,
+			TexCoord,
+			Face,
+		};
+
+		inline bool IsBlank(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		inline void SkipBlank(const char*& p, const char* end)
+		{
+			while (p < end && (*p == ' ' || *p == '\t')) p++;
+		}
+
+		inline const char* FindLineEnd(const char* p, const char* end)
+		{
+			const void* lineEnd = std::memchr(p, '\n', static_cast<size_t>(end - p));
+			return lineEnd ? static_cast<const char*>(lineEnd) : end;
+		}
+
+		/**
+		* @brief Classify a line and move p after its keyword.
+		*/
+		inline LineType Classify(const char*& p, const char* end)
+		{
+			SkipBlank(p, end);
+
+			if (end - p < 2) return LineType::Other;
+
+			if (p[0] == 'v')
+			{
+				if (IsBlank(p[1])) { p += 2; return LineType::Position; }
+
+				if (end - p >= 3 && IsBlank(p[2]))
+				{
+					if (p[1] == 'n') { p += 3; return LineType::Normal;   }
+					if (p[1] == 't') { p += 3; return LineType::TexCoord; }
+				}
+			}
+			else if (p[0] == 'f' && IsBlank(p[1]))
+			{
+				p += 2;
+				return LineType::Face;
+			}
+
+			return LineType::Other;
+		}
+
+		/**
+		* @brief Parse a float with from_chars, locale independent and without strtod.
+		*/
+		inline bool ParseFloat(const char*& p, const char* end, float& out)
+		{
+			SkipBlank(p, end);
+
+			const char* begin = p < end && *p == '+' ? p + 1 : p;
+
+			const auto [ptr, ec] = std::from_chars(begin, end, out);
+			if (ec == std::errc::invalid_argument) return false;
+
+			p = ptr;
+			return true;
+		}
+
+		/**
+		* @brief Parse a signed index.
+		*/
+		inline bool ParseIndex(const char*& p, const char* end, int64_t& out)
+		{
+			bool isNegative = false;
+			if (p < end && (*p == '-' || *p == '+'))
+			{
+				isNegative = *p == '-';
+				p++;
+			}
+
+			if (p >= end || *p < '0' || *p > '9') return false;
+
+			int64_t value = 0;
+			for (; p < end && *p >= '0' && *p <= '9'; p++)
+			{
+				value = std::min<int64_t>(value * 10 + (*p - '0'), INT64_MAX / 16);
+			}
+
+			out = isNegative ? -value : value;
+			return true;
+		}
+
+		/**
+		* @brief Resolve a 1 based or negative relative index to a 0 based one.
+		* @param[in] index OBJ index.
+		* @param[in] before Count of items before the line.
+		* @param[in] total Count of items in file.
+		* @param[in] isAllowZero Zero is a missing index, resolved to 0 as tinyobj path does.
+		* @param[out] out Resolved index.
+		*/
+		inline bool Resolve(int64_t index, uint64_t before, uint64_t total, bool isAllowZero, uint32_t& out)
+		{
+			int64_t resolved = 0;
+
+			if      (index > 0) resolved = index - 1;
+			else if (index < 0) resolved = static_cast<int64_t>(before) + index;
+			else
+			{
+				out = 0;
+				return isAllowZero;
+			}
+
+			if (resolved < 0 || static_cast<uint64_t>(resolved) >= total) return false;
+
+			out = static_cast<uint32_t>(resolved);
+			return true;
+		}
+
+		inline uint64_t HashCorner(const glm::uvec3& corner)
+		{
+			uint64_t h = corner.x * 0x9E3779B97F4A7C15ull ^ corner.y * 0xC2B2AE3D27D4EB4Full ^ corner.z * 0x165667B19E3779F9ull;
+			h ^= h >> 29;
+			h *= 0xBF58476D1CE4E5B9ull;
+			h ^= h >> 32;
+			return h;
+		}
+
+		/**
+		* @brief Split [0, count) into parts, returns part i.
+		*/
+		inline std::pair<uint64_t, uint64_t> SplitRange(uint64_t count, uint32_t parts, uint32_t i)
+		{
+			return { count * i / parts, count * (i + 1) / parts };
+		}
+	}
+
+	bool ObjParser::Parse(const std::string& path, const Output& output, ThreadPool* threadPool, Stats* outStats)
+	{
+		SPICES_PROFILE_ZONE;
+
+		MappedFileHandle file;
+		if (!FileLibrary::FileLibrary_Map(path.c_str(), &file)) return false;
+
+		const bool isSucceed = Parse(file.data, file.size, output, threadPool, outStats);
+
+		FileLibrary::FileLibrary_UnMap(&file);
+
+		if (!isSucceed)
+		{
+			std::stringstream ss;
+			ss << "ObjParser: " << path << " is not a valid obj file.";
+
+			SPICES_CORE_ERROR(ss.str());
+		}
+
+		return isSucceed;
+	}
+
+	bool ObjParser::Parse(const char* data, uint64_t size, const Output& output, ThreadPool* threadPool, Stats* outStats)
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Split into line aligned chunks.
+		*/
+		const uint32_t nChunks = static_cast<uint32_t>(std::clamp<uint64_t>(size / ChunkSize, 1, 4096));
+
+		std::vector<Chunk> chunks(nChunks);
+		{
+			const char* end = data + size;
+			const char* p   = data;
+
+			for (uint32_t i = 0; i < nChunks; i++)
+			{
+				const char* split = i + 1 == nChunks ? end : std::max(p, data + size * (i + 1) / nChunks);
+				if (split < end)
+				{
+					split = FindLineEnd(split, end);
+					split = split < end ? split + 1 : end;
+				}
+
+				chunks[i].begin = p;
+				chunks[i].end   = split;
+				p = split;
+			}
+		}
+
+		/**
+		* @brief Count pass, find where each chunk writes.
+		*/
+		ThreadPool::ParallelFor(threadPool, nChunks, [&](uint32_t i) {
+			Chunk& chunk = chunks[i];
+
+			for (const char* p = chunk.begin; p < chunk.end;)
+			{
+				const char* lineEnd = FindLineEnd(p, chunk.end);
+
+				switch (Classify(p, lineEnd))
+				{
+					case LineType::Position: chunk.positions++; break;
+					case LineType::Normal:   chunk.normals++;   break;
+					case LineType::TexCoord: chunk.texCoords++; break;
+					default:                                    break;
+				}
+
+				p = lineEnd + 1;
+			}
+		});
+
+		uint64_t nPositions = 0;
+		uint64_t nNormals   = 0;
+		uint64_t nTexCoords = 0;
+
+		for (auto& chunk : chunks)
+		{
+			chunk.positionBase = nPositions;
+			chunk.normalBase   = nNormals;
+			chunk.texCoordBase = nTexCoords;
+
+			nPositions += chunk.positions;
+			nNormals   += chunk.normals;
+			nTexCoords += chunk.texCoords;
+		}
+
+		output.positions->resize(nPositions);
+		output.colors   ->resize(nPositions);
+		output.normals  ->resize(nNormals);
+		output.texCoords->resize(nTexCoords);
+
+		/**
+		* @brief Parse pass, attributes are written in place, faces are kept per chunk.
+		*/
+		ThreadPool::ParallelFor(threadPool, nChunks, [&](uint32_t i) {
+			Chunk& chunk = chunks[i];
+
+			glm::vec3* positions = output.positions->data() + chunk.positionBase;
+			glm::vec3* colors    = output.colors   ->data() + chunk.positionBase;
+			glm::vec3* normals   = output.normals  ->data() + chunk.normalBase;
+			glm::vec2* texCoords = output.texCoords->data() + chunk.texCoordBase;
+
+			uint64_t position = 0;
+			uint64_t normal   = 0;
+			uint64_t texCoord = 0;
+
+			std::vector<glm::uvec3> face;
+
+			for (const char* p = chunk.begin; p < chunk.end && !chunk.error;)
+			{
+				const char* line    = p;
+				const char* lineEnd = FindLineEnd(p, chunk.end);
+
+				switch (Classify(p, lineEnd))
+				{
+					case LineType::Position:
+					{
+						float x = 0.0f, y = 0.0f, z = 0.0f;
+						ParseFloat(p, lineEnd, x);
+						ParseFloat(p, lineEnd, y);
+						ParseFloat(p, lineEnd, z);
+
+						/**
+						* @brief Vertex color extension, x y z r g b.
+						*/
+						float c[3] = { 1.0f, 1.0f, 1.0f };
+						uint32_t n = 0;
+						for (; n < 3 && ParseFloat(p, lineEnd, c[n]); n++) {}
+
+						positions[position] = glm::vec3(x, y, -z);
+						colors[position]    = n == 3 ? glm::vec3(c[0], c[1], c[2]) : glm::vec3(1.0f);
+						position++;
+						break;
+					}
+					case LineType::Normal:
+					{
+						float x = 0.0f, y = 0.0f, z = 0.0f;
+						ParseFloat(p, lineEnd, x);
+						ParseFloat(p, lineEnd, y);
+						ParseFloat(p, lineEnd, z);
+
+						normals[normal++] = glm::vec3(x, y, -z);
+						break;
+					}
+					case LineType::TexCoord:
+					{
+						float u = 0.0f, v = 0.0f;
+						ParseFloat(p, lineEnd, u);
+						ParseFloat(p, lineEnd, v);
+
+						texCoords[texCoord++] = glm::vec2(u, 1.0f - v);
+						break;
+					}
+					case LineType::Face:
+					{
+						face.clear();
+
+						bool isValid = true;
+						for (;;)
+						{
+							SkipBlank(p, lineEnd);
+							if (p >= lineEnd || *p == '\r' || *p == '#') break;
+
+							/**
+							* @brief v, v/vt, v//vn or v/vt/vn.
+							*/
+							glm::uvec3 corner(0);
+							int64_t    index = 0;
+
+							isValid = ParseIndex(p, lineEnd, index) && Resolve(index, chunk.positionBase + position, nPositions, false, corner.x);
+
+							if (isValid && p < lineEnd && *p == '/')
+							{
+								p++;
+								if (p < lineEnd && *p != '/')
+								{
+									isValid = ParseIndex(p, lineEnd, index) && Resolve(index, chunk.texCoordBase + texCoord, nTexCoords, true, corner.z);
+								}
+
+								if (isValid && p < lineEnd && *p == '/')
+								{
+									p++;
+									if (ParseIndex(p, lineEnd, index))
+									{
+										isValid = Resolve(index, chunk.normalBase + normal, nNormals, true, corner.y);
+									}
+								}
+							}
+
+							isValid = isValid && (p >= lineEnd || IsBlank(*p));
+							if (!isValid) break;
+
+							face.push_back(corner);
+						}
+
+						if (!isValid)
+						{
+							chunk.error = line;
+							break;
+						}
+
+						/**
+						* @brief Degenerated face is skipped, same as tinyobj.
+						*/
+						if (face.size() < 3) break;
+
+						chunk.corners.insert(chunk.corners.end(), face.begin(), face.end());
+						chunk.faces.push_back(static_cast<uint32_t>(face.size()));
+						chunk.triangles += face.size() - 2;
+						break;
+					}
+					default: break;
+				}
+
+				p = lineEnd + 1;
+			}
+		});
+
+		uint64_t nFaces     = 0;
+		uint64_t nTriangles = 0;
+
+		for (auto& chunk : chunks)
+		{
+			if (chunk.error)
+			{
+				const char* lineEnd = FindLineEnd(chunk.error, chunk.end);
+
+				std::stringstream ss;
+				ss << "ObjParser: invalid line at byte " << chunk.error - data << ": " << std::string(chunk.error, std::min<ptrdiff_t>(lineEnd - chunk.error, 80));
+
+				SPICES_CORE_ERROR(ss.str());
+				return false;
+			}
+
+			chunk.triangleBase = nTriangles;
+
+			nFaces     += chunk.faces.size();
+			nTriangles += chunk.triangles;
+		}
+
+		const uint64_t nCorners = nTriangles * 3;
+		if (nCorners >= emptySlot)
+		{
+			SPICES_CORE_ERROR("ObjParser: too many triangles.");
+			return false;
+		}
+
+		/**
+		* @brief Triangulate pass.
+		*/
+		std::vector<glm::uvec3> corners(nCorners);
+
+		ThreadPool::ParallelFor(threadPool, nChunks, [&](uint32_t i) {
+			Chunk& chunk = chunks[i];
+
+			glm::uvec3*       out = corners.data() + chunk.triangleBase * 3;
+			const glm::uvec3* in  = chunk.corners.data();
+
+			for (const uint32_t n : chunk.faces)
+			{
+				if (n == 4)
+				{
+					/**
+					* @brief Split quad on the shorter diagonal, same as tinyobj.
+					*/
+					const glm::vec3 e02 = (*output.positions)[in[2].x] - (*output.positions)[in[0].x];
+					const glm::vec3 e13 = (*output.positions)[in[3].x] - (*output.positions)[in[1].x];
+
+					if (glm::dot(e02, e02) < glm::dot(e13, e13))
+					{
+						*out++ = in[0]; *out++ = in[1]; *out++ = in[2];
+						*out++ = in[0]; *out++ = in[2]; *out++ = in[3];
+					}
+					else
+					{
+						*out++ = in[0]; *out++ = in[1]; *out++ = in[3];
+						*out++ = in[1]; *out++ = in[2]; *out++ = in[3];
+					}
+				}
+				else
+				{
+					for (uint32_t k = 1; k + 1 < n; k++)
+					{
+						*out++ = in[0]; *out++ = in[k]; *out++ = in[k + 1];
+					}
+				}
+
+				in += n;
+			}
+
+			std::vector<glm::uvec3>().swap(chunk.corners);
+			std::vector<uint32_t>  ().swap(chunk.faces);
+		});
+
+		/**
+		* @brief Dedup pass, slot keeps the first corner of a key,
+		* so vertices are numbered in order of first use as serial dedup does.
+		*/
+		uint64_t nSlots = 1;
+		while (nSlots < nCorners * 2) nSlots <<= 1;
+
+		const uint64_t mask = nSlots - 1;
+		std::unique_ptr<std::atomic<uint32_t>[]> slots(new std::atomic<uint32_t>[nSlots]);
+
+		const uint32_t nSlotTasks   = static_cast<uint32_t>(std::max<uint64_t>(1, nSlots / cornersPerTask));
+		const uint32_t nCornerTasks = static_cast<uint32_t>(std::max<uint64_t>(1, (nCorners + cornersPerTask - 1) / cornersPerTask));
+
+		ThreadPool::ParallelFor(threadPool, nSlotTasks, [&](uint32_t i) {
+			const auto [begin, end] = SplitRange(nSlots, nSlotTasks, i);
+			for (uint64_t s = begin; s < end; s++) slots[s].store(emptySlot, std::memory_order_relaxed);
+		});
+
+		const auto find = [&](uint32_t c) -> std::atomic<uint32_t>& {
+			for (uint64_t s = HashCorner(corners[c]) & mask;; s = (s + 1) & mask)
+			{
+				const uint32_t cur = slots[s].load(std::memory_order_acquire);
+				if (cur == emptySlot || corners[cur] == corners[c]) return slots[s];
+			}
+		};
+
+		ThreadPool::ParallelFor(threadPool, nCornerTasks, [&](uint32_t i) {
+			const auto [begin, end] = SplitRange(nCorners, nCornerTasks, i);
+
+			for (uint64_t c = begin; c < end; c++)
+			{
+				const uint32_t corner = static_cast<uint32_t>(c);
+
+				/**
+				* @brief A slot's key never changes once set, only lowered to a prior corner of the same key.
+				*/
+				for (uint64_t s = HashCorner(corners[c]) & mask;; s = (s + 1) & mask)
+				{
+					uint32_t cur = slots[s].load(std::memory_order_acquire);
+
+					if (cur == emptySlot && slots[s].compare_exchange_strong(cur, corner, std::memory_order_acq_rel)) break;
+					if (corners[cur] != corners[c]) continue;
+
+					while (corner < cur && !slots[s].compare_exchange_weak(cur, corner, std::memory_order_acq_rel)) {}
+					break;
+				}
+			}
+		});
+
+		/**
+		* @brief Number first corners by prefix sum of task counts.
+		*/
+		std::vector<uint32_t> firsts(nCorners);
+		std::vector<uint64_t> taskVertices(nCornerTasks, 0);
+
+		ThreadPool::ParallelFor(threadPool, nCornerTasks, [&](uint32_t i) {
+			const auto [begin, end] = SplitRange(nCorners, nCornerTasks, i);
+
+			for (uint64_t c = begin; c < end; c++)
+			{
+				firsts[c] = find(static_cast<uint32_t>(c)).load(std::memory_order_relaxed);
+				if (firsts[c] == c) taskVertices[i]++;
+			}
+		});
+
+		uint64_t nVertices = 0;
+		for (auto& count : taskVertices)
+		{
+			const uint64_t base = nVertices;
+			nVertices += count;
+			count = base;
+		}
+
+		slots.reset();
+
+		output.vertices         ->resize(nVertices);
+		output.primitiveVertices->resize(nTriangles);
+
+		std::vector<uint32_t> vertexIds(nCorners);
+
+		ThreadPool::ParallelFor(threadPool, nCornerTasks, [&](uint32_t i) {
+			const auto [begin, end] = SplitRange(nCorners, nCornerTasks, i);
+
+			uint64_t vertex = taskVertices[i];
+			for (uint64_t c = begin; c < end; c++)
+			{
+				if (firsts[c] != c) continue;
+
+				vertexIds[c] = static_cast<uint32_t>(vertex);
+				(*output.vertices)[vertex++] = glm::uvec4(corners[c].x, corners[c].y, corners[c].x, corners[c].z);
+			}
+		});
+
+		ThreadPool::ParallelFor(threadPool, nCornerTasks, [&](uint32_t i) {
+			const auto [begin, end] = SplitRange(nTriangles, nCornerTasks, i);
+
+			for (uint64_t t = begin; t < end; t++)
+			{
+				(*output.primitiveVertices)[t] = glm::uvec3(
+					vertexIds[firsts[3 * t + 0]],
+					vertexIds[firsts[3 * t + 1]],
+					vertexIds[firsts[3 * t + 2]]
+				);
+			}
+		});
+
+		if (outStats)
+		{
+			outStats->bytes     = size;
+			outStats->chunks    = nChunks;
+			outStats->faces     = nFaces;
+			outStats->triangles = nTriangles;
+			outStats->vertices  = nVertices;
+		}
+
+		return true;
+	}
+}
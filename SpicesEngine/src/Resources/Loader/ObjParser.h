@@ -0,0 +1,87 @@
+/**
+* @file ObjParser.h.
+* @brief The ObjParser Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <glm/glm.hpp>
+
+namespace Spices {
+
+	/**
+	* @brief Forward declare.
+	*/
+	class ThreadPool;
+
+	/**
+	* @brief Parallel OBJ reader.
+	* The file is mapped and split into line aligned chunks, chunks are parsed in parallel,
+	* each chunk writes its v, vn, vt lines directly into output arrays at offsets found by a counting pass.
+	* Faces are triangulated (quads split on the shorter diagonal, larger polygons fanned)
+	* and corners are deduplicated by a parallel open-addressing hash.
+	* Output matches MeshLoader's tinyobj path: z of positions and normals is negated, v of texcoords is flipped,
+	* every position has a color (default white), a vertex is (position, normal, position, texcoord),
+	* and vertices are numbered in order of first use.
+	* Only v, vn, vt and f lines are read, groups and materials are ignored.
+	*/
+	class ObjParser
+	{
+	public:
+
+		/**
+		* @brief Output arrays, all are overwritten.
+		*/
+		struct Output
+		{
+			std::vector<glm::vec3>*  positions         = nullptr;   /* @brief Positions.                  */
+			std::vector<glm::vec3>*  normals           = nullptr;   /* @brief Normals.                    */
+			std::vector<glm::vec3>*  colors            = nullptr;   /* @brief Colors, one per position.   */
+			std::vector<glm::vec2>*  texCoords         = nullptr;   /* @brief TexCoords.                  */
+			std::vector<glm::uvec4>* vertices          = nullptr;   /* @brief Deduplicated vertices.      */
+			std::vector<glm::uvec3>* primitiveVertices = nullptr;   /* @brief Triangles of vertices.      */
+		};
+
+		/**
+		* @brief Statistics.
+		*/
+		struct Stats
+		{
+			uint64_t bytes     = 0;     /* @brief File bytes.             */
+			uint64_t chunks    = 0;     /* @brief Parsed chunks.          */
+			uint64_t faces     = 0;     /* @brief Faces.                  */
+			uint64_t triangles = 0;     /* @brief Triangles.              */
+			uint64_t vertices  = 0;     /* @brief Unique vertices.        */
+		};
+
+		/**
+		* @brief Target bytes of a chunk.
+		*/
+		static constexpr uint64_t ChunkSize = 4 * 1024 * 1024;
+
+	public:
+
+		/**
+		* @brief Map an OBJ file and parse it.
+		* @param[in] path The file path.
+		* @param[in] output Output arrays.
+		* @param[in] threadPool ThreadPool runs chunks with the calling thread, nullptr for calling thread only.
+		* @param[out] outStats Statistics, may be nullptr.
+		* @return Returns true if succeed.
+		*/
+		static bool Parse(const std::string& path, const Output& output, ThreadPool* threadPool = nullptr, Stats* outStats = nullptr);
+
+		/**
+		* @brief Parse OBJ text.
+		* @param[in] data The text.
+		* @param[in] size Bytes of the text.
+		* @param[in] output Output arrays.
+		* @param[in] threadPool ThreadPool runs chunks with the calling thread, nullptr for calling thread only.
+		* @param[out] outStats Statistics, may be nullptr.
+		* @return Returns true if succeed.
+		*/
+		static bool Parse(const char* data, uint64_t size, const Output& output, ThreadPool* threadPool = nullptr, Stats* outStats = nullptr);
+	};
+}
@@ -7,6 +7,7 @@
 #include "Pchheader.h"
 #include "ShaderLoader.h"
 #include "Systems/ResourceSystem.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem.h"
 #include "Core/Library/FileLibrary.h"
 #include "Resources/Shader/Shader.h"
 #include "Resources/Shader/ShaderCompiler.h"
@@ -25,18 +26,8 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		bool isFind = false;
-		std::string filePath;
-		for (auto& it : ResourceSystem::GetSearchFolder())
-		{
-			filePath = it + defaultShaderPath + "Shader." + fileName + "." + ShaderHelper::ToString(stage);
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				isFind = true;
-				break;
-			}
-		}
-		if (!isFind)
+		VirtualFileSystem::Entry entry;
+		if (!VirtualFileSystem::Resolve(defaultShaderPath + "Shader." + fileName + "." + ShaderHelper::ToString(stage), entry))
 		{
 			std::stringstream ss;
 			ss << "Shader: " << fileName << "file is not finded";
@@ -49,20 +40,19 @@ namespace Spices {
 		/**
 		* @brief Read file as bytes.
 		*/
-		std::ifstream stream(filePath);
-		std::stringstream strStream;
-		strStream << stream.rdbuf();
+		VirtualFileSystem::Blob blob;
+		if (!VirtualFileSystem::Load(entry, blob)) return false;
 
 		/**
 		* @brief Compile to spv.
 		*/
 		std::vector<uint8_t> spirv;
-		ShaderCompiler::CompileToSPV(strStream.str(), stage, fileName, spirv);
+		ShaderCompiler::CompileToSPV(std::string(blob.data, blob.size), stage, fileName, spirv);
 		
 		/**
 		* @brief Create shader module.
 		*/
-		outShader->m_ShaderModule = std::make_shared<VulkanShaderModule>(VulkanRenderBackend::GetState(), fileName, stage, spirv, filePath);
+		outShader->m_ShaderModule = std::make_shared<VulkanShaderModule>(VulkanRenderBackend::GetState(), fileName, stage, spirv, entry.path);
 
 		return true;
 	}
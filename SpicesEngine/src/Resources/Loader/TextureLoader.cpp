@@ -10,6 +10,7 @@
 #include "Render/Vulkan/VulkanRenderBackend.h"
 #include "Core/Library/FileLibrary.h"
 #include "Systems/ResourceSystem.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem.h"
 #include "Resources/Texture/Transcoder.h"
 
 #include <stb_image.h>
@@ -25,17 +26,45 @@ namespace Spices {
 	const std::string defaultTexturePath = "Textures/src/";
 	const std::string binTexturePath     = "Textures/bin/";
 
+	namespace {
+
+		/**
+		* @brief A file read by TextureLoader::Prefetch.
+		*/
+		struct Prefetched
+		{
+			bool                    isDone    = false;     /* @brief True if read completed.   */
+			bool                    isSucceed = false;     /* @brief True if read succeed.     */
+			VirtualFileSystem::Blob blob;                  /* @brief The bytes.                */
+		};
+
+		/**
+		* @brief Prefetched files not taken yet, key: file path.
+		*/
+		std::unordered_map<std::string, std::shared_ptr<Prefetched>> prefetches;
+
+		/**
+		* @brief Mutex of prefetches.
+		*/
+		std::mutex prefetchMutex;
+
+		/**
+		* @brief Notified when a prefetch completed.
+		*/
+		std::condition_variable prefetchCond;
+	}
+
 	void TextureLoader::Load(const std::string& fileName, Texture2D* outTexture)
 	{
 		SPICES_PROFILE_ZONE;
 
 		SearchFile(
 		fileName, 
-		[&](const std::string& it) {
-			LoadBin(fileName, it, outTexture);
+		[&](const VirtualFileSystem::Entry& entry) {
+			LoadBin(fileName, entry, outTexture);
 		}, 
-		[&](const std::string& it) {
-			LoadSrc(fileName, it, outTexture);
+		[&](const VirtualFileSystem::Entry& entry) {
+			LoadSrc(fileName, entry, outTexture);
 		}
 		);
 	}
@@ -45,33 +74,91 @@ namespace Spices {
 
 	}
 
+	void TextureLoader::Prefetch(const std::vector<std::string>& fileNames)
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (const auto& fileName : fileNames)
+		{
+			std::vector<std::string> splitString = StringLibrary::SplitString(fileName, '.');
+
+			VirtualFileSystem::Entry entry;
+			if (!VirtualFileSystem::Resolve(binTexturePath + splitString[0] + ".ktx", entry) && 
+			    !VirtualFileSystem::Resolve(defaultTexturePath + fileName, entry)) continue;
+
+			/**
+			* @brief Packed file is a view of mapping, nothing to read.
+			*/
+			if (entry.IsPacked()) continue;
+
+			auto prefetched = std::make_shared<Prefetched>();
+			{
+				std::unique_lock<std::mutex> lock(prefetchMutex);
+
+				if (!prefetches.emplace(entry.path, prefetched).second) continue;
+			}
+
+			VirtualFileSystem::LoadAsync(entry, IOPriority::High, [prefetched](bool isSucceed, const VirtualFileSystem::Blob& blob) {
+				{
+					std::unique_lock<std::mutex> lock(prefetchMutex);
+
+					prefetched->isDone    = true;
+					prefetched->isSucceed = isSucceed;
+					prefetched->blob      = blob;
+				}
+
+				prefetchCond.notify_all();
+			});
+		}
+	}
+
+	bool TextureLoader::ReadFile(const VirtualFileSystem::Entry& entry, VirtualFileSystem::Blob& outBlob)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::shared_ptr<Prefetched> prefetched;
+		{
+			std::unique_lock<std::mutex> lock(prefetchMutex);
+
+			auto it = prefetches.find(entry.path);
+			if (it != prefetches.end())
+			{
+				prefetched = it->second;
+				prefetches.erase(it);
+
+				prefetchCond.wait(lock, [&]() { return prefetched->isDone; });
+			}
+		}
+
+		if (prefetched && prefetched->isSucceed)
+		{
+			outBlob = std::move(prefetched->blob);
+			return true;
+		}
+
+		return VirtualFileSystem::Load(entry, outBlob);
+	}
+
 	bool TextureLoader::SearchFile(
 		const std::string& fileName, 
-		std::function<void(const std::string&)> binF, 
-		std::function<void(const std::string&)> srcF
+		std::function<void(const VirtualFileSystem::Entry&)> binF, 
+		std::function<void(const VirtualFileSystem::Entry&)> srcF
 	)
 	{
 		SPICES_PROFILE_ZONE;
 
 		std::vector<std::string> splitString = StringLibrary::SplitString(fileName, '.');
 
-		for (auto& it : ResourceSystem::GetSearchFolder())
+		VirtualFileSystem::Entry entry;
+		if (VirtualFileSystem::Resolve(binTexturePath + splitString[0] + ".ktx", entry))
 		{
-			std::string filePath = it + binTexturePath + splitString[0] + ".ktx";
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				binF(it);
-				return true;
-			}
+			binF(entry);
+			return true;
 		}
-		for (auto& it : ResourceSystem::GetSearchFolder())
+		if (VirtualFileSystem::Resolve(defaultTexturePath + fileName, entry))
 		{
-			std::string filePath = it + defaultTexturePath + fileName;
-			if (FileLibrary::FileLibrary_Exists(filePath.c_str()))
-			{
-				srcF(it);
-				return true;
-			}
+			srcF(entry);
+			return true;
 		}
 
 		std::stringstream ss;
@@ -81,15 +168,15 @@ namespace Spices {
 		return false;
 	}
 
-	bool TextureLoader::LoadBin(const std::string& fileName, const std::string& it, Texture2D* outTexture)
+	bool TextureLoader::LoadBin(const std::string& fileName, const VirtualFileSystem::Entry& entry, Texture2D* outTexture)
 	{
 		SPICES_PROFILE_ZONE;
 
-		std::vector<std::string> splitString = StringLibrary::SplitString(fileName, '.');
-		std::string binPath = it + binTexturePath + splitString[0] + ".ktx";
+		VirtualFileSystem::Blob blob;
+		if (!ReadFile(entry, blob)) return false;
 
 		ktxTexture2* texture = nullptr;
-		Transcoder::LoadFromKTX(binPath, texture);
+		Transcoder::LoadFromKTX(blob.data, blob.size, texture);
 
 		/**
 		* @brief Instance the VulkanImage as Texture2D Resource.
@@ -240,13 +327,16 @@ namespace Spices {
 		return true;
 	}
 
-	bool TextureLoader::LoadSrc(const std::string& fileName, const std::string& it, Texture2D* outTexture)
+	bool TextureLoader::LoadSrc(const std::string& fileName, const VirtualFileSystem::Entry& entry, Texture2D* outTexture)
 	{
 		SPICES_PROFILE_ZONE;
 
 		std::vector<std::string> splitString = StringLibrary::SplitString(fileName, '.');
-		std::string filePath = it + defaultTexturePath + fileName;
-		std::string binPath  = it + binTexturePath + splitString[0] + ".ktx";
+		std::string binLogicalPath = binTexturePath + splitString[0] + ".ktx";
+		std::string binPath        = VirtualFileSystem::GetMountRoot(entry.mount) + binLogicalPath;
+
+		VirtualFileSystem::Blob blob;
+		if (!ReadFile(entry, blob)) return false;
 
 		/**
 		* @brief Load Texture data.
@@ -254,7 +344,7 @@ namespace Spices {
 		int width;
 		int height;
 		int texChannels;
-		stbi_uc* pixels = stbi_load(filePath.c_str(), &width, &height, &texChannels, STBI_rgb_alpha);
+		stbi_uc* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(blob.data), static_cast<int>(blob.size), &width, &height, &texChannels, STBI_rgb_alpha);
 		if (!pixels)
 		{
 			SPICES_CORE_ERROR("Failed to load texture image!");
@@ -451,6 +541,7 @@ namespace Spices {
 		* @brief Save to disk.
 		*/
 		Transcoder::SaveToDisk(ktxTexture, binPath);
+		VirtualFileSystem::AddFile(entry.mount, binLogicalPath);
 
 		return true;
 	}
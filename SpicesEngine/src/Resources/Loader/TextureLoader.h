@@ -6,6 +6,7 @@
 
 #pragma once
 #include "Core/Core.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem.h"
 
 namespace Spices {
 
@@ -46,8 +47,23 @@ namespace Spices {
 		*/
 		static void Load(const std::string& fileName, Texture2DCube* outTexture);
 
+		/**
+		* @brief Read image files of textures by AsyncIOService, so disk reads overlap decoding of textures loaded before them.
+		* A prefetched file is taken by the next Load of it, do not prefetch textures already in ResourcePool.
+		* @param[in] fileNames Image paths.
+		*/
+		static void Prefetch(const std::vector<std::string>& fileNames);
+
 	private:
 
+		/**
+		* @brief Get bytes of a resolved file, waits for it if prefetched.
+		* @param[in] entry Resolved file.
+		* @param[out] outBlob The bytes.
+		* @return Returns true if succeed.
+		*/
+		static bool ReadFile(const VirtualFileSystem::Entry& entry, VirtualFileSystem::Blob& outBlob);
+
 		/**
 		* @brief Search texture file and load.
 		* @param[in] fileName .
@@ -57,27 +73,27 @@ namespace Spices {
 		*/
 		static bool SearchFile(
 			const std::string& fileName, 
-			std::function<void(const std::string&)> binF, 
-			std::function<void(const std::string&)> srcF
+			std::function<void(const VirtualFileSystem::Entry&)> binF, 
+			std::function<void(const VirtualFileSystem::Entry&)> srcF
 		);
 
 		/**
 		* @brief Function of load a ktx file.
 		* @param[in] fileName ktx filenme.
-		* @param[in] it file directfolder.
+		* @param[in] entry Resolved ktx file.
 		* @param[in] outTexture Pointer of texture.
 		* @return Returns true if load file succeed.
 		*/
-		static bool LoadBin(const std::string& fileName, const std::string& it, Texture2D* outTexture);
+		static bool LoadBin(const std::string& fileName, const VirtualFileSystem::Entry& entry, Texture2D* outTexture);
 
 		/**
 		* @brief Function of load a src file.
 		* @param[in] fileName src filenme.
-		* @param[in] it file directfolder.
+		* @param[in] entry Resolved src file.
 		* @param[in] outTexture Pointer of texture.
 		* @return Returns true if load file succeed.
 		*/
-		static bool LoadSrc(const std::string& fileName, const std::string& it, Texture2D* outTexture);
+		static bool LoadSrc(const std::string& fileName, const VirtualFileSystem::Entry& entry, Texture2D* outTexture);
 
 	};
 }
\ No newline at end of file
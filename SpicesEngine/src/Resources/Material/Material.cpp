@@ -7,13 +7,13 @@
 #include "Pchheader.h"
 #include "Material.h"
 #include "Render/Vulkan/VulkanRenderBackend.h"
-#include "Core/Reflect/TypeReflect.h"
 #include "Render/Renderer/DescriptorSetManager/DescriptorSetManager.h"
 #include "Render/Renderer/RendererManager.h"
 #include "Core/Library/StringLibrary.h"
 #include "Render/Renderer/Renderer.h"
 #include "Render/Renderer/DescriptorSetManager/BindLessTextureManager.h"
 #include "Resources/Shader/Shader.h"
+#include "Resources/Loader/TextureLoader.h"
 
 namespace Spices {
 
@@ -46,6 +46,11 @@ namespace Spices {
 			}
 		}
 
+		/**
+		* @brief Return Material Parameter range.
+		*/
+		MaterialParameterArena::Free(m_ParameterHandle);
+
 	}
 
 	void Material::Serialize()
@@ -90,8 +95,7 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
-		if(m_MaterialParameterBuffer == nullptr) return 0;
-		else return m_MaterialParameterBuffer->GetAddress();
+		return MaterialParameterArena::GetAddress(m_ParameterHandle);
 	}
 
 	void Material::BuildMaterial(bool isAutoRegistry)
@@ -122,28 +126,19 @@ namespace Spices {
 		{
 			SPICES_PROFILE_ZONEN("BuildMaterial::Clean Up old descripotrset");
 
-			m_MaterialParameterBuffer  = nullptr;
+			MaterialParameterArena::Free(m_ParameterHandle);
 			m_Buffermemoryblocks       = scl::runtime_memory_block();
 		}
 
 		/**
-		* @brief Iter the constantParams and fill it's data to memoryblock.
+		* @brief Build local parameter block from compiled layout.
 		*/
-		{
-			SPICES_PROFILE_ZONEN("BuildMaterial::Build Local ConstantParameter Block");
-
-			m_ConstantParams.for_each([&](const std::string& k, const ConstantParams& v) {
-				m_Buffermemoryblocks.add_element(k, v.value.paramType);
-				return false;
-			});
-
-			m_Buffermemoryblocks.build();
-		}
+		BuildParameterBlock();
 
 		/**
 		* @brief Return if not valid textureParameter or constantParameter.
 		*/
-		uint64_t size = m_TextureParams.size() * sizeof(unsigned int) + m_Buffermemoryblocks.get_bytes();
+		uint64_t size = m_Buffermemoryblocks.get_bytes();
 		if (size == 0)
 		{
 			std::vector<std::string> sv = StringLibrary::SplitString(m_MaterialPath, '.');
@@ -154,20 +149,9 @@ namespace Spices {
 		}
 
 		/**
-		* @brief Create Material Parameter to store all address and index.
+		* @brief Allocate Material Parameter range to store all address and index.
 		*/
-		{
-			SPICES_PROFILE_ZONEN("BuildMaterial::Create Material Parameter Buffer");
-
-			m_MaterialParameterBuffer = std::make_unique<VulkanBuffer>(
-				VulkanRenderBackend::GetState(),
-				"MaterialParameterBuffer",
-				size,
-				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
-				VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-			);
-		}
+		m_ParameterHandle = MaterialParameterArena::Allocate(static_cast<uint32_t>(size));
 
 		/**
 		* @brief Registry texture to both ResourcePool, BindLessTextureManager, DescriptorSetManager and MaterialParameterBuffer.
@@ -175,7 +159,9 @@ namespace Spices {
 		{
 			SPICES_PROFILE_ZONEN("BuildMaterial::Registry texture");
 
-			int tindex = 0;
+			PrefetchTextures();
+
+			uint32_t tindex = 0;
 			m_TextureParams.for_each([&](const std::string& k, TextureParam& v) {
 
 				/**
@@ -206,8 +192,7 @@ namespace Spices {
 					*/
 					vkUpdateDescriptorSets(VulkanRenderBackend::GetState().m_Device, 1, &write, 0, nullptr);
 
-					m_MaterialParameterBuffer->WriteToBuffer(&v.index, sizeof(unsigned int), tindex * sizeof(unsigned int));
-					m_MaterialParameterBuffer->Flush();
+					m_Buffermemoryblocks.set_value(tindex, v.index);
 				}
 
 				/**
@@ -224,62 +209,10 @@ namespace Spices {
 		}
 
 		/**
-		* @brief Create ConstantParameter Buffer .
+		* @brief Fill in constant parameters and upload the whole block.
 		*/
-		{
-			SPICES_PROFILE_ZONEN("BuildMaterial::Add ConstantParameter Buffer");
-
-			m_Buffermemoryblocks.for_each([&](const std::string& name, void* pt) {
-				ConstantParam& ref = m_ConstantParams.find_value(name)->value;
-				size_t size = m_TextureParams.size() * sizeof(unsigned int) + m_Buffermemoryblocks.item_location(name);
-				
-				/**
-				* @brief Fill in data to memory block.
-				*/
-				if      (ref.paramType == "float4")
-				{
-					*static_cast<glm::vec4*>(pt)     = std::any_cast<glm::vec4>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(glm::vec4), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "float3")
-				{
-					*static_cast<glm::vec3*>(pt)     = std::any_cast<glm::vec3>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(glm::vec3), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "float2")
-				{
-					*static_cast<glm::vec2*>(pt)     = std::any_cast<glm::vec2>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(glm::vec2), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "float")
-				{
-					*static_cast<float*>(pt)         = std::any_cast<float>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(float), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "int")
-				{
-					*static_cast<int*>(pt)           = std::any_cast<int>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(int), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "bool")
-				{
-					*static_cast<bool*>(pt)          = std::any_cast<bool>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(bool), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else
-				{
-					SPICES_CORE_ERROR("Material::BuildMaterial(): Invalid paramType.");
-				}
-	
-				return false;
-			});
-		}
+		WriteConstantParams();
+		UploadParameterBlock();
 
 		/**
 		* @brief Create PipelineLayout.
@@ -297,20 +230,9 @@ namespace Spices {
 		SPICES_PROFILE_ZONE;
 
 		/**
-		* @brief Iter the constantParams and fill it's data to memoryblock.
+		* @brief Parameters layout is not changed, the block built by BuildMaterial is reused.
 		*/
-		{
-			SPICES_PROFILE_ZONEN("BuildMaterial::Build Local ConstantParameter Block");
-
-			m_Buffermemoryblocks = scl::runtime_memory_block();
-
-			m_ConstantParams.for_each([&](const std::string& k, const ConstantParams& v) {
-				m_Buffermemoryblocks.add_element(k, v.value.paramType);
-				return false;
-			});
-
-			m_Buffermemoryblocks.build();
-		}
+		if (!m_ParameterHandle.IsValid()) return;
 
 		/**
 		* @brief Registry texture to both ResourcePool, BindLessTextureManager, DescriptorSetManager and MaterialParameterBuffer.
@@ -318,7 +240,9 @@ namespace Spices {
 		{
 			SPICES_PROFILE_ZONEN("BuildMaterial::Registry texture");
 
-			int tindex = 0;
+			PrefetchTextures();
+
+			uint32_t tindex = 0;
 			m_TextureParams.for_each([&](const std::string& k, TextureParam& v) {
 
 				/**
@@ -349,8 +273,7 @@ namespace Spices {
 					*/
 					vkUpdateDescriptorSets(VulkanRenderBackend::GetState().m_Device, 1, &write, 0, nullptr);
 
-					m_MaterialParameterBuffer->WriteToBuffer(&v.index, sizeof(unsigned int), tindex * sizeof(unsigned int));
-					m_MaterialParameterBuffer->Flush();
+					m_Buffermemoryblocks.set_value(tindex, v.index);
 				}
 
 				/**
@@ -367,61 +290,116 @@ namespace Spices {
 		}
 
 		/**
-		* @brief Create ConstantParameter Buffer .
+		* @brief Fill in constant parameters and upload the whole block.
 		*/
-		{
-			SPICES_PROFILE_ZONEN("BuildMaterial::Add ConstantParameter Buffer");
+		WriteConstantParams();
+		UploadParameterBlock();
+	}
 
-			m_Buffermemoryblocks.for_each([&](const std::string& name, void* pt) {
-				ConstantParam& ref = m_ConstantParams.find_value(name)->value;
-				size_t size = m_TextureParams.size() * sizeof(unsigned int) + m_Buffermemoryblocks.item_location(name);
-				
-				/**
-				* @brief Fill in data to memory block.
-				*/
-				if      (ref.paramType == "float4")
-				{
-					*static_cast<glm::vec4*>(pt)     = std::any_cast<glm::vec4>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(glm::vec4), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "float3")
-				{
-					*static_cast<glm::vec3*>(pt)     = std::any_cast<glm::vec3>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(glm::vec3), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "float2")
-				{
-					*static_cast<glm::vec2*>(pt)     = std::any_cast<glm::vec2>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(glm::vec2), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "float")
-				{
-					*static_cast<float*>(pt)         = std::any_cast<float>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(float), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "int")
-				{
-					*static_cast<int*>(pt)           = std::any_cast<int>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(int), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else if (ref.paramType == "bool")
-				{
-					*static_cast<bool*>(pt)           = std::any_cast<bool>(ref.paramValue);
-					m_MaterialParameterBuffer->WriteToBuffer(pt, sizeof(bool), size);
-					m_MaterialParameterBuffer->Flush();
-				}
-				else
-				{
-					SPICES_CORE_ERROR("Material::BuildMaterial(): Invalid paramType.");
-				}
-	
-				return false;
-			});
-		}
+	void Material::PrefetchTextures()
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Read textures not loaded yet in background, decoding one overlaps reading the next.
+		*/
+		std::vector<std::string> fileNames;
+		m_TextureParams.for_each([&](const std::string& k, const TextureParam& v) {
+			if (v.textureType == "Texture2D" && !ResourcePool<Texture>::Has(v.texturePath))
+			{
+				fileNames.push_back(v.texturePath);
+			}
+			return false;
+		});
+
+		TextureLoader::Prefetch(fileNames);
+	}
+
+	void Material::BuildParameterBlock()
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Texture indices first, then constant parameters, same as MaterialParameter struct in shader.
+		* Same parameters compile to the same layout, shared by all materials of a template.
+		*/
+		scl::runtime_memory_layout_compiler compiler(scl::memory_layout_rule::Scalar);
+
+		m_TextureParams.for_each([&](const std::string& k, const TextureParam& v) {
+			compiler.add(k, scl::memory_field_type::UInt);
+			return false;
+		});
+
+		std::vector<bool> isAdded;
+		m_ConstantParams.for_each([&](const std::string& k, const ConstantParams& v) {
+			isAdded.push_back(compiler.add(k, v.value.paramType));
+			if (!isAdded.back())
+			{
+				std::stringstream ss;
+				ss << "Material: " << m_MaterialPath << " : Invalid paramType: " << v.value.paramType;
+
+				SPICES_CORE_ERROR(ss.str());
+			}
+			return false;
+		});
+
+		m_Buffermemoryblocks = scl::runtime_memory_block(compiler.compile());
+
+		/**
+		* @brief Field of each constant parameter by name, rejected ones are not written.
+		*/
+		const scl::runtime_memory_layout& layout = *m_Buffermemoryblocks.get_layout();
+
+		m_ConstantFields.clear();
+		m_ConstantParams.for_each([&](const std::string& k, const ConstantParams& v) {
+			const bool added = isAdded[m_ConstantFields.size()];
+			m_ConstantFields.push_back(added ? layout.find(k) : scl::runtime_memory_layout::npos);
+			return false;
+		});
+	}
+
+	void Material::WriteConstantParams()
+	{
+		SPICES_PROFILE_ZONE;
+
+		const scl::runtime_memory_layout& layout = *m_Buffermemoryblocks.get_layout();
+
+		uint32_t param = 0;
+		m_ConstantParams.for_each([&](const std::string& k, const ConstantParams& v) {
+
+			if (param >= m_ConstantFields.size()) return true;
+
+			const uint32_t index = m_ConstantFields[param++];
+			if (index == scl::runtime_memory_layout::npos) return false;
+
+			const std::any& value = v.value.paramValue;
+
+			/**
+			* @brief Fill in data to memory block by field index.
+			*/
+			switch (layout.field(index).type)
+			{
+				case scl::memory_field_type::Float4: m_Buffermemoryblocks.set_value(index, std::any_cast<glm::vec4>(value));                        break;
+				case scl::memory_field_type::Float3: m_Buffermemoryblocks.set_value(index, std::any_cast<glm::vec3>(value));                        break;
+				case scl::memory_field_type::Float2: m_Buffermemoryblocks.set_value(index, std::any_cast<glm::vec2>(value));                        break;
+				case scl::memory_field_type::Float:  m_Buffermemoryblocks.set_value(index, std::any_cast<float>(value));                            break;
+				case scl::memory_field_type::Int:    m_Buffermemoryblocks.set_value(index, std::any_cast<int>(value));                              break;
+				case scl::memory_field_type::UInt:   m_Buffermemoryblocks.set_value(index, std::any_cast<uint32_t>(value));                         break;
+				case scl::memory_field_type::Bool:   m_Buffermemoryblocks.set_value(index, static_cast<uint32_t>(std::any_cast<bool>(value)));      break;
+				default: SPICES_CORE_ERROR("Material::WriteConstantParams(): Invalid paramType.");                                                  break;
+			}
+
+			return false;
+		});
+	}
+
+	void Material::UploadParameterBlock() const
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Uploaded with all materials by MaterialParameterArena::Flush on next frame.
+		*/
+		MaterialParameterArena::Update(m_ParameterHandle, m_Buffermemoryblocks.get_addr(), static_cast<uint32_t>(m_Buffermemoryblocks.get_bytes()));
 	}
-}
\ No newline at end of file
+}
@@ -14,6 +14,7 @@
 #include "Core/Container/RuntimeMemoryBlock.h"
 #include "Core/Container/LinkedUnorderedMap.h"
 #include "Render/Vulkan/VulkanBuffer.h"
+#include "MaterialParameterArena.h"
 #include "MaterialProperties.h"
 #include <glm/glm.hpp>
 #include <unordered_map>
@@ -171,6 +172,28 @@ namespace Spices {
 		*/
 		friend class MeshPack;
 
+	private:
+
+		/**
+		* @brief Read image files of textures not in ResourcePool in background before they are loaded.
+		*/
+		void PrefetchTextures();
+
+		/**
+		* @brief Compile parameters layout and create m_Buffermemoryblocks.
+		*/
+		void BuildParameterBlock();
+
+		/**
+		* @brief Fill in constant parameters to m_Buffermemoryblocks by m_ConstantFields.
+		*/
+		void WriteConstantParams();
+
+		/**
+		* @brief Upload whole m_Buffermemoryblocks to m_ParameterHandle.
+		*/
+		void UploadParameterBlock() const;
+
 	protected:
 
 		/**
@@ -199,15 +222,21 @@ namespace Spices {
 		scl::linked_unordered_map<std::string, ConstantParams> m_ConstantParams;
 
 		/**
-		* @brief m_Buffers's c++ data container.
-		* Key: set, Value: scl::runtime_memory_block.
+		* @brief m_ParameterHandle's c++ data container.
+		* Texture indices and constant parameters, built from a compiled layout.
 		*/
 		scl::runtime_memory_block m_Buffermemoryblocks;
 
+		/**
+		* @brief Field index of each constant parameter in m_Buffermemoryblocks, in m_ConstantParams order.
+		* npos if rejected by layout compiler.
+		*/
+		std::vector<uint32_t> m_ConstantFields;
+
 		/*
-		* @brief Buffer takes all textures index and all constant params buffer address. 
+		* @brief Range in MaterialParameterArena takes all textures index and all constant params.
 		*/
-		std::unique_ptr<VulkanBuffer> m_MaterialParameterBuffer;
+		MaterialParameterHandle m_ParameterHandle;
 
 		/**
 		* @brief Properties of render options.
@@ -0,0 +1,215 @@
+/**
+* @file MaterialCache.cpp.
+* @brief The MaterialCache Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "MaterialCache.h"
+#include "Core/Reflect/ReflectSerializer.h"
+
+#include <glm/glm.hpp>
+#include <cstring>
+
+namespace Spices {
+
+#ifdef CLASS_SCOPE
+#undef CLASS_SCOPE
+#endif
+#define CLASS_SCOPE MaterialCache::Shader
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(stage),
+		UPROPERTY(path)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+#define CLASS_SCOPE MaterialCache::Texture
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(name),
+		UPROPERTY(textureType),
+		UPROPERTY(texturePath)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+#define CLASS_SCOPE MaterialCache::Parameter
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(name),
+		UPROPERTY(paramType),
+		UPROPERTY(type),
+		UPROPERTY(offset),
+		UPROPERTY(hasMinValue),
+		UPROPERTY(hasMaxValue)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+#define CLASS_SCOPE MaterialCache::Data
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(material),
+		UPROPERTY(shaders),
+		UPROPERTY(textures),
+		UPROPERTY(parameters),
+		UPROPERTY(values),
+		UPROPERTY(minValues),
+		UPROPERTY(maxValues)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+
+	namespace {
+
+		/**
+		* @brief Write a value to block in GPU representation.
+		* @param[in] type Field type.
+		* @param[in] value The value.
+		* @param[out] dst Field bytes in block.
+		* @return Returns false if value is not the type.
+		*/
+		bool PutValue(scl::memory_field_type type, const std::any& value, char* dst)
+		{
+			const auto put = [&](auto v) {
+				using T = decltype(v);
+
+				const T* ptr = std::any_cast<T>(&value);
+				if (!ptr) return false;
+
+				std::memcpy(dst, ptr, sizeof(T));
+				return true;
+			};
+
+			switch (type)
+			{
+				case scl::memory_field_type::Float4: return put(glm::vec4());
+				case scl::memory_field_type::Float3: return put(glm::vec3());
+				case scl::memory_field_type::Float2: return put(glm::vec2());
+				case scl::memory_field_type::Float:  return put(float());
+				case scl::memory_field_type::Int:    return put(int());
+				case scl::memory_field_type::UInt:   return put(uint32_t());
+				case scl::memory_field_type::Bool:
+				{
+					const bool* ptr = std::any_cast<bool>(&value);
+					if (!ptr) return false;
+
+					const uint32_t v = *ptr ? 1 : 0;
+					std::memcpy(dst, &v, sizeof(v));
+					return true;
+				}
+				default: return false;
+			}
+		}
+	}
+
+	bool MaterialCache::AddParameter(
+		Data&              data      ,
+		const std::string& name      ,
+		const std::string& paramType ,
+		const std::any&    value     ,
+		const std::any*    minValue  ,
+		const std::any*    maxValue
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Parameter parameter;
+		parameter.name        = name;
+		parameter.paramType   = paramType;
+		parameter.type        = scl::to_memory_field_type(paramType);
+		parameter.offset      = static_cast<uint32_t>(data.values.size());
+		parameter.hasMinValue = minValue != nullptr;
+		parameter.hasMaxValue = maxValue != nullptr;
+
+		const uint32_t size = scl::memory_field_size(parameter.type);
+		if (size == 0) return false;
+
+		/**
+		* @brief Scalar layout, fields are 4 bytes aligned and packed.
+		*/
+		data.values   .resize(parameter.offset + size, 0);
+		data.minValues.resize(parameter.offset + size, 0);
+		data.maxValues.resize(parameter.offset + size, 0);
+
+		bool isSucceed = PutValue(parameter.type, value, data.values.data() + parameter.offset);
+		if (minValue) isSucceed &= PutValue(parameter.type, *minValue, data.minValues.data() + parameter.offset);
+		if (maxValue) isSucceed &= PutValue(parameter.type, *maxValue, data.maxValues.data() + parameter.offset);
+
+		if (!isSucceed)
+		{
+			data.values   .resize(parameter.offset);
+			data.minValues.resize(parameter.offset);
+			data.maxValues.resize(parameter.offset);
+
+			return false;
+		}
+
+		data.parameters.push_back(std::move(parameter));
+
+		return true;
+	}
+
+	std::any MaterialCache::GetValue(const Parameter& parameter, const std::vector<char>& block)
+	{
+		const char* src = block.data() + parameter.offset;
+
+		const auto get = [&](auto v) {
+			std::memcpy(&v, src, sizeof(v));
+			return std::any(v);
+		};
+
+		switch (parameter.type)
+		{
+			case scl::memory_field_type::Float4: return get(glm::vec4());
+			case scl::memory_field_type::Float3: return get(glm::vec3());
+			case scl::memory_field_type::Float2: return get(glm::vec2());
+			case scl::memory_field_type::Float:  return get(float());
+			case scl::memory_field_type::Int:    return get(int());
+			case scl::memory_field_type::UInt:   return get(uint32_t());
+			case scl::memory_field_type::Bool:
+			{
+				uint32_t v = 0;
+				std::memcpy(&v, src, sizeof(v));
+				return std::any(v != 0);
+			}
+			default: return std::any();
+		}
+	}
+
+	void MaterialCache::Encode(const Data& data, std::vector<char>& out)
+	{
+		SPICES_PROFILE_ZONE;
+
+		ReflectSerializer::Serialize(data, out);
+	}
+
+	bool MaterialCache::Decode(const char* bytes, uint64_t size, Data& outData)
+	{
+		SPICES_PROFILE_ZONE;
+
+		uint64_t read = 0;
+		if (!ReflectSerializer::Deserialize(bytes, size, outData, &read) || read != size) return false;
+
+		/**
+		* @brief Parameters must lie in value blocks.
+		*/
+		if (outData.minValues.size() != outData.values.size() || outData.maxValues.size() != outData.values.size()) return false;
+
+		for (const auto& parameter : outData.parameters)
+		{
+			const uint32_t fieldSize = scl::memory_field_size(parameter.type);
+
+			if (fieldSize == 0 || uint64_t(parameter.offset) + fieldSize > outData.values.size()) return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,127 @@
+/**
+* @file MaterialCache.h.
+* @brief The MaterialCache Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "Core/Container/RuntimeMemoryLayout.h"
+
+#include <any>
+
+namespace Spices {
+
+	/**
+	* @brief Cooked binary form of a .material file, the data between signs of Materials/bin/Material.*.sasset.
+	* Parameter values are packed into blocks in GPU representation (scalar layout, bool is 4 bytes),
+	* the same bytes the compiled parameter block holds, so a cooked material is decoded from one read
+	* without parsing YAML or type strings.
+	* Encoded by ReflectSerializer, a file cooked with another layout of Data fails its schema hash and is cooked again.
+	*/
+	class MaterialCache
+	{
+	public:
+
+		/**
+		* @brief A shader of a stage.
+		*/
+		struct Shader
+		{
+			std::string stage;                 /* @brief Shader stage.              */
+			std::string path;                  /* @brief Shader path(short path).   */
+		};
+
+		/**
+		* @brief A texture parameter.
+		*/
+		struct Texture
+		{
+			std::string name;                  /* @brief Parameter name.            */
+			std::string textureType;           /* @brief Texture type.              */
+			std::string texturePath;           /* @brief Texture path.              */
+		};
+
+		/**
+		* @brief A constant parameter, its values are at offset of value blocks.
+		*/
+		struct Parameter
+		{
+			std::string            name;                                           /* @brief Parameter name.          */
+			std::string            paramType;                                      /* @brief Type string.             */
+			scl::memory_field_type type        = scl::memory_field_type::Count;    /* @brief Field type.              */
+			uint32_t               offset      = 0;                                /* @brief Offset in value blocks.  */
+			bool                   hasMinValue = false;                            /* @brief Is have Min Value.       */
+			bool                   hasMaxValue = false;                            /* @brief Is have Max Value.       */
+		};
+
+		/**
+		* @brief A cooked material.
+		*/
+		struct Data
+		{
+			std::string            material;       /* @brief Material name.                      */
+			std::vector<Shader>    shaders;        /* @brief Shaders in file order.              */
+			std::vector<Texture>   textures;       /* @brief Textures in file order.             */
+			std::vector<Parameter> parameters;     /* @brief Parameters in file order.           */
+			std::vector<char>      values;         /* @brief Value block.                        */
+			std::vector<char>      minValues;      /* @brief Min Value block, zeros if none.     */
+			std::vector<char>      maxValues;      /* @brief Max Value block, zeros if none.     */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		MaterialCache() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~MaterialCache() = default;
+
+		/**
+		* @brief Append a constant parameter.
+		* @param[in,out] data The cooked material.
+		* @param[in] name Parameter name.
+		* @param[in] paramType Type string.
+		* @param[in] value Value.
+		* @param[in] minValue Min Value, may be nullptr.
+		* @param[in] maxValue Max Value, may be nullptr.
+		* @return Returns false if paramType is not supported or a value is not paramType.
+		*/
+		static bool AddParameter(
+			Data&              data      ,
+			const std::string& name      ,
+			const std::string& paramType ,
+			const std::any&    value     ,
+			const std::any*    minValue  = nullptr ,
+			const std::any*    maxValue  = nullptr
+		);
+
+		/**
+		* @brief Read a value from a value block.
+		* @param[in] parameter The parameter.
+		* @param[in] block One of value blocks.
+		* @return Returns the value, in the same type YAML path produces.
+		*/
+		static std::any GetValue(const Parameter& parameter, const std::vector<char>& block);
+
+		/**
+		* @brief Encode a cooked material.
+		* @param[in] data The cooked material.
+		* @param[in,out] out Bytes appended to.
+		*/
+		static void Encode(const Data& data, std::vector<char>& out);
+
+		/**
+		* @brief Decode a cooked material.
+		* @param[in] bytes The bytes.
+		* @param[in] size Bytes count, must be exactly one encoded material.
+		* @param[out] outData The cooked material.
+		* @return Returns false if bytes are not a valid cooked material of this layout.
+		*/
+		static bool Decode(const char* bytes, uint64_t size, Data& outData);
+	};
+}
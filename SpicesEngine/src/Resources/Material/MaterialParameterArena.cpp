@@ -0,0 +1,159 @@
+/**
+* @file MaterialParameterArena.cpp.
+* @brief The MaterialParameterArena Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "MaterialParameterArena.h"
+#include "Render/Vulkan/VulkanRenderBackend.h"
+
+namespace Spices {
+
+	std::vector<std::unique_ptr<MaterialParameterArena::Page>> MaterialParameterArena::m_Pages;
+	std::mutex                                                 MaterialParameterArena::m_Mutex;
+
+	MaterialParameterHandle MaterialParameterArena::Allocate(uint32_t bytes)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		MaterialParameterHandle handle;
+
+		/**
+		* @brief Try pages in order, keeps materials packed in first pages.
+		*/
+		for (uint32_t i = 0; i < m_Pages.size(); i++)
+		{
+			handle.alloc = m_Pages[i]->allocator.allocate(bytes);
+			if (handle.alloc.valid())
+			{
+				handle.page = i;
+				return handle;
+			}
+		}
+
+		/**
+		* @brief Add a page, larger than PageSize if needed.
+		*/
+		const uint32_t size = std::max(PageSize, (bytes + Alignment - 1) / Alignment * Alignment);
+
+		auto page = std::make_unique<Page>(size);
+
+		std::stringstream ss;
+		ss << "MaterialParameterArena" << m_Pages.size();
+
+		page->buffer = std::make_unique<VulkanBuffer>(
+			VulkanRenderBackend::GetState(),
+			ss.str(),
+			size,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+			VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+		);
+
+		handle.alloc = page->allocator.allocate(bytes);
+		handle.page  = static_cast<uint32_t>(m_Pages.size());
+
+		m_Pages.push_back(std::move(page));
+
+		return handle;
+	}
+
+	void MaterialParameterArena::Free(MaterialParameterHandle& handle)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!handle.IsValid()) return;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		/**
+		* @brief Pages are gone if released after Destroy.
+		*/
+		if (handle.page < m_Pages.size())
+		{
+			m_Pages[handle.page]->allocator.free(handle.alloc);
+		}
+
+		handle = MaterialParameterHandle{};
+	}
+
+	void MaterialParameterArena::Update(const MaterialParameterHandle& handle, const void* data, uint32_t bytes)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!handle.IsValid()) return;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		Page& page = *m_Pages[handle.page];
+
+		assert(bytes <= page.allocator.allocation_size(handle.alloc));
+
+		page.buffer->UpdateBuffer(data, bytes, handle.alloc.offset);
+		page.isDirty = true;
+	}
+
+	uint64_t MaterialParameterArena::GetAddress(const MaterialParameterHandle& handle)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!handle.IsValid()) return 0;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		return m_Pages[handle.page]->buffer->GetAddress() + handle.alloc.offset;
+	}
+
+	void MaterialParameterArena::Flush()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		uint64_t used = 0;
+		for (auto& page : m_Pages)
+		{
+			if (page->isDirty)
+			{
+				page->buffer->FlushDirtyRanges();
+				page->isDirty = false;
+			}
+
+			used += page->allocator.used();
+		}
+
+		SPICES_PROFILE_PLOT("Material Parameter Arena Pages", static_cast<int64_t>(m_Pages.size()));
+		SPICES_PROFILE_PLOT("Material Parameter Arena Bytes", static_cast<int64_t>(used));
+	}
+
+	void MaterialParameterArena::Destroy()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		m_Pages.clear();
+	}
+
+	MaterialParameterArena::Stats MaterialParameterArena::GetStats()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+
+		Stats stats;
+		stats.pages = static_cast<uint32_t>(m_Pages.size());
+
+		for (const auto& page : m_Pages)
+		{
+			stats.allocations += page->allocator.allocation_count();
+			stats.used        += page->allocator.used();
+			stats.capacity    += page->allocator.capacity();
+		}
+
+		return stats;
+	}
+}
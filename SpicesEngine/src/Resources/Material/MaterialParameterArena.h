@@ -0,0 +1,136 @@
+/**
+* @file MaterialParameterArena.h.
+* @brief The MaterialParameterArena Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "Core/Container/TLSFAllocator.h"
+#include "Render/Vulkan/VulkanBuffer.h"
+
+#include <mutex>
+
+namespace Spices {
+
+	/**
+	* @brief A material's range in MaterialParameterArena.
+	*/
+	struct MaterialParameterHandle
+	{
+		uint32_t                        page = UINT32_MAX;     /* @brief Page index.          */
+		scl::tlsf_allocator::allocation alloc;                 /* @brief Range in the page.   */
+
+		bool IsValid() const { return page != UINT32_MAX; }
+	};
+
+	/**
+	* @brief Parameters of all materials in a few large buffers, sub-allocated by scl::tlsf_allocator.
+	* Writes are kept in each page's shadow copy and uploaded together by Flush once per frame.
+	*/
+	class MaterialParameterArena
+	{
+	public:
+
+		/**
+		* @brief Bytes of a page buffer.
+		*/
+		static constexpr uint32_t PageSize = 256 * 1024;
+
+		/**
+		* @brief Alignment of a range, not less than buffer_reference_align of MaterialParameters.
+		*/
+		static constexpr uint32_t Alignment = 16;
+
+		/**
+		* @brief Arena statistics.
+		*/
+		struct Stats
+		{
+			uint32_t pages       = 0;     /* @brief Page buffers.         */
+			uint32_t allocations = 0;     /* @brief Live ranges.          */
+			uint64_t used        = 0;     /* @brief Bytes of live ranges. */
+			uint64_t capacity    = 0;     /* @brief Bytes of all pages.   */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		MaterialParameterArena() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~MaterialParameterArena() = default;
+
+		/**
+		* @brief Allocate a range, a page is added if none fits.
+		* @param[in] bytes Bytes of the range.
+		* @return Returns the handle.
+		*/
+		static MaterialParameterHandle Allocate(uint32_t bytes);
+
+		/**
+		* @brief Free a range, handle is reset.
+		* @param[in] handle The handle.
+		*/
+		static void Free(MaterialParameterHandle& handle);
+
+		/**
+		* @brief Write data to a range, uploaded by next Flush.
+		* @param[in] handle The handle.
+		* @param[in] data The data.
+		* @param[in] bytes Bytes of data, not more than the range.
+		*/
+		static void Update(const MaterialParameterHandle& handle, const void* data, uint32_t bytes);
+
+		/**
+		* @brief Get gpu address of a range.
+		* @param[in] handle The handle.
+		* @return Returns the gpu address, 0 if handle is invalid.
+		*/
+		static uint64_t GetAddress(const MaterialParameterHandle& handle);
+
+		/**
+		* @brief Upload changed ranges of all pages, called once per frame.
+		*/
+		static void Flush();
+
+		/**
+		* @brief Release all pages, called on shut down after all materials are released.
+		*/
+		static void Destroy();
+
+		/**
+		* @brief Get arena statistics.
+		* @return Returns arena statistics.
+		*/
+		static Stats GetStats();
+
+	private:
+
+		/**
+		* @brief A page buffer and its allocator.
+		*/
+		struct Page
+		{
+			std::unique_ptr<VulkanBuffer> buffer;              /* @brief The buffer.                 */
+			scl::tlsf_allocator           allocator;           /* @brief Ranges of the buffer.       */
+			bool                          isDirty = false;     /* @brief Has writes not uploaded.    */
+
+			Page(uint32_t size) : allocator(size, Alignment) {}
+		};
+
+		/**
+		* @brief Pages.
+		*/
+		static std::vector<std::unique_ptr<Page>> m_Pages;
+
+		/**
+		* @brief Mutex of pages, materials may build on worker threads.
+		*/
+		static std::mutex m_Mutex;
+	};
+}
@@ -64,6 +64,7 @@ namespace Spices {
 		primitiveLocationsAddress   = 0;
 		materialParameterAddress    = 0;
 		meshletsAddress             = 0;
+		instancesAddress            = 0;
 		nMeshlets                   = 0;
 		entityID                    = 0;
 
@@ -124,11 +125,14 @@ namespace Spices {
 		vkCmdDrawIndexed(commandBuffer, lod0.nPrimitives * 3, 1, lod0.primVertexOffset * 3, 0, 0);
 	}
 	
-	void MeshPack::OnDrawMeshTasks(VkCommandBuffer& commandBuffer) const
+	void MeshPack::OnDrawMeshTasks(VkCommandBuffer& commandBuffer, uint32_t instanceCount) const
 	{
 		SPICES_PROFILE_ZONE;
 
-		VulkanRenderBackend::GetState().m_VkFunc.vkCmdDrawMeshTasksEXT(commandBuffer, m_NTasks, 1, 1);
+		/**
+		* @brief Workgroup y is instance index.
+		*/
+		VulkanRenderBackend::GetState().m_VkFunc.vkCmdDrawMeshTasksEXT(commandBuffer, m_NTasks, instanceCount, 1);
 	}
 
 	bool MeshPack::OnCreatePack(bool isCreateBuffer)
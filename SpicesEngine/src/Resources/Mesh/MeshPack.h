@@ -184,6 +184,7 @@ namespace Spices {
 		Update_F(primitiveLocationsAddress      )
 		Update_F(materialParameterAddress       )
 		Update_F(meshletsAddress                )
+		Update_F(instancesAddress               )
 		Update_F(nMeshlets                      )
 		Update_F(entityID                       )
 		
@@ -289,8 +290,9 @@ namespace Spices {
 		/**
 		* @brief Draw Mesh Tasks.
 		* @param[in] commandBuffer Which command buffer we will submit commands.
+		* @param[in] instanceCount Number of instances, read from MeshDesc instancesAddress if not 0.
 		*/
-		void OnDrawMeshTasks(VkCommandBuffer& commandBuffer) const;
+		void OnDrawMeshTasks(VkCommandBuffer& commandBuffer, uint32_t instanceCount = 1) const;
 
 		/**
 		* @brief Get Meshlets array.
@@ -316,6 +318,12 @@ namespace Spices {
 		*/
 		const VkDrawMeshTasksIndirectCommandNV& GetDrawCommand() const { return m_MeshTaskIndirectDrawCommand; }
 
+		/**
+		* @brief Get MeshPack Name.
+		* @return Returns the MeshPack Name.
+		*/
+		const std::string& GetName() const { return m_MeshPackName; }
+
 		/**
 		* @brief Get Pack Type.
 		* @return Returns the Pack Type.
@@ -334,6 +342,12 @@ namespace Spices {
 		*/
 		const MeshResource& GetResource() const { return m_MeshResource; }
 
+		/**
+		* @brief Get Resource Key, same for meshpacks sharing resources copied from ResourcePool.
+		* @return Returns the Resource Key.
+		*/
+		uint64_t GetResourceKey() const { return reinterpret_cast<uint64_t>(m_MeshResource.positions.attributes.get()); }
+
 	protected:
 
 		/**
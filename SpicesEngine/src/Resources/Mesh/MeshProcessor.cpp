@@ -66,6 +66,11 @@ namespace Spices {
 			const uint32_t nextStart   = meshPack->m_MeshResource.meshlets.attributes->size();
 			meshletStart               = nextStart;
 			auto groups                = GroupMeshlets(meshPack, meshlets);
+
+			/**
+			* @brief Nodes of all groups' kd_tree, a destroyed tree's nodes are reused by the next one.
+			*/
+			scl::block_pool kdTreeNodePool(sizeof(VertexKDTree::Node), alignof(VertexKDTree::Node));
 			
 			for (const auto& group : groups)
 			{
@@ -85,7 +90,7 @@ namespace Spices {
 				/**
 				* @brief Build KDTree.
 				*/
-				scl::kd_tree<6> kdTree;
+				VertexKDTree kdTree{ scl::pool_allocator<VertexKDTree::item>(&kdTreeNodePool) };
 				BuildKDTree(meshPack, groupPrimVertices, kdTree);
 
 				/**
@@ -504,7 +509,7 @@ namespace Spices {
 	bool MeshProcessor::MergeByDistance(
 		MeshPack*                meshPack      ,
 		std::vector<glm::uvec3>& primVertices  ,
-		scl::kd_tree<6>&         kdTree        , 
+		VertexKDTree&            kdTree        , 
 		float                    maxDistance   , 
 		float                    maxUVDistance
 	)
@@ -555,7 +560,7 @@ namespace Spices {
 				/**
 				* @brief Find near vertex.
 				*/
-				scl::kd_tree<6>::item item = { 
+				VertexKDTree::item item = { 
 					positions[vertex.x].x, 
 					positions[vertex.x].y, 
 					positions[vertex.x].z, 
@@ -575,7 +580,7 @@ namespace Spices {
 				/**
 				* @brief Only allow near merge.
 				*/
-				std::vector<scl::kd_tree<6>::item> nearVts;
+				std::vector<VertexKDTree::item> nearVts;
 				for (auto& vt : rangeVts)
 				{
 					uint32_t pt = vertices[(uint32_t)vt[5]].x;
@@ -763,7 +768,7 @@ namespace Spices {
 	bool MeshProcessor::BuildKDTree(
 		MeshPack*                      meshPack     , 
 		const std::vector<glm::uvec3>& primVertices ,
-		scl::kd_tree<6>&               kdTree
+		VertexKDTree&                  kdTree
 	)
 	{
 		SPICES_PROFILE_ZONE;
@@ -780,7 +785,7 @@ namespace Spices {
 		auto& texCoords = *meshPack->m_MeshResource.texCoords.attributes;
 		auto& vertices  = *meshPack->m_MeshResource.vertices .attributes;
 
-		std::vector<scl::kd_tree<6>::item> items;
+		std::vector<VertexKDTree::item> items;
 		items.resize(primVerticesMap.size());
 
 		uint32_t i = 0;
@@ -8,6 +8,7 @@
 #include "Core/Core.h"
 #include "Vertex.h"
 #include "Core/Container/KDTree.h"
+#include "Core/Container/BlockPool.h"
 
 namespace Spices {
 
@@ -31,6 +32,11 @@ namespace Spices {
 	{
 	public:
 
+		/**
+		* @brief kd_tree of vertices, rebuilt per MeshletGroup with nodes from a block_pool.
+		*/
+		using VertexKDTree = scl::kd_tree<6, scl::pool_allocator<std::array<float, 6>>>;
+
 		/**
 		* @brief Generate Mesh Lod Resources.
 		* @param[in] meshPack MeshPack.
@@ -75,7 +81,7 @@ namespace Spices {
 		static bool MergeByDistance(
 			MeshPack*                meshPack      ,
 			std::vector<glm::uvec3>& primVertices  ,
-			scl::kd_tree<6>&         kdTree        , 
+			VertexKDTree&            kdTree        , 
 			float                    maxDistance   , 
 			float                    maxUVDistance
 		);
@@ -112,7 +118,7 @@ namespace Spices {
 		static bool BuildKDTree(
 			MeshPack*                      meshPack     ,
 			const std::vector<glm::uvec3>& primVertices ,
-			scl::kd_tree<6>&               kdTree
+			VertexKDTree&                  kdTree
 		);
 
 		/**
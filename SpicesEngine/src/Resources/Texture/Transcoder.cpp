@@ -199,6 +199,22 @@ namespace Spices {
 		return true;
 	}
 
+	bool Transcoder::LoadFromKTX(const char* data, uint64_t size, ktxTexture2*& texture)
+	{
+		SPICES_PROFILE_ZONE;
+
+		KTX_CHECK(ktxTexture2_CreateFromMemory(reinterpret_cast<const ktx_uint8_t*>(data), size, KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &texture))
+
+		if (ktxTexture2_NeedsTranscoding(texture))
+		{
+			ktx_transcode_fmt_e tf = GetAvailableTargetFormats();
+
+			KTX_CHECK(ktxTexture2_TranscodeBasis(texture, tf, 0))
+		}
+
+		return true;
+	}
+
 	bool Transcoder::DestroyktxTexture2(ktxTexture2* texture)
 	{
 		SPICES_PROFILE_ZONE;
@@ -66,6 +66,15 @@ namespace Spices {
 		*/
 		static bool LoadFromKTX(const std::string& filePath, ktxTexture2*& texture);
 
+		/**
+		* @brief Load a ktx file from memory.
+		* @param[in] data ktx file bytes.
+		* @param[in] size Count of bytes.
+		* @param[in,out] texture ktx file.
+		* @return Returns true if finish all task.
+		*/
+		static bool LoadFromKTX(const char* data, uint64_t size, ktxTexture2*& texture);
+
 		/**
 		* @brief Destroy a ktx file.
 		* @param[in] ktx file.
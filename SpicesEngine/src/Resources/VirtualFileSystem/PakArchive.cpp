@@ -0,0 +1,301 @@
+/**
+* @file PakArchive.cpp.
+* @brief The PakArchive Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "PakArchive.h"
+#include "VirtualFileSystem.h"
+
+#include <cstring>
+
+namespace Spices {
+
+	const std::vector<std::string> PakWriter::CookedFolders = {
+		"Meshes/bin"    ,
+		"Textures/bin"  ,
+		"Materials/bin" ,
+		"Materials/src" ,
+		"Shaders/src"   ,
+	};
+
+	PakArchive::~PakArchive()
+	{
+		Close();
+	}
+
+	bool PakArchive::Open(const std::string& path)
+	{
+		SPICES_PROFILE_ZONE;
+
+		Close();
+
+		if (!FileLibrary::FileLibrary_Map(path.c_str(), &m_File)) return false;
+
+		m_Path = path;
+
+		/**
+		* @brief Check header, TOC and names are in the file.
+		*/
+		const auto isInFile = [&](uint64_t offset, uint64_t size) {
+			return offset <= m_File.size && size <= m_File.size - offset;
+		};
+
+		bool isValid = isInFile(0, sizeof(Header));
+		if (isValid)
+		{
+			m_Header = reinterpret_cast<const Header*>(m_File.data);
+
+			isValid = std::memcmp(m_Header->magic, Magic, sizeof(Magic)) == 0      &&
+			          m_Header->version == Version                                  &&
+			          m_Header->tocOffset % alignof(TocEntry) == 0                  &&
+			          isInFile(m_Header->tocOffset, uint64_t(m_Header->fileCount) * sizeof(TocEntry)) &&
+			          isInFile(m_Header->namesOffset, m_Header->namesSize);
+		}
+
+		if (isValid)
+		{
+			m_Toc   = reinterpret_cast<const TocEntry*>(m_File.data + m_Header->tocOffset);
+			m_Names = m_File.data + m_Header->namesOffset;
+
+			for (uint32_t i = 0; i < m_Header->fileCount && isValid; i++)
+			{
+				isValid = isInFile(m_Toc[i].offset, m_Toc[i].size) &&
+				          uint64_t(m_Toc[i].nameOffset) + m_Toc[i].nameSize <= m_Header->namesSize;
+			}
+		}
+
+		if (!isValid)
+		{
+			std::stringstream ss;
+			ss << "PakArchive: " << path << " is not a valid pak file.";
+
+			SPICES_CORE_ERROR(ss.str());
+
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void PakArchive::Close()
+	{
+		SPICES_PROFILE_ZONE;
+
+		FileLibrary::FileLibrary_UnMap(&m_File);
+
+		m_Path  .clear();
+		m_Header = nullptr;
+		m_Toc    = nullptr;
+		m_Names  = nullptr;
+	}
+
+	uint32_t PakArchive::Find(const std::string& key) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (!m_Header) return npos;
+
+		const uint64_t hash = Hash(key);
+
+		const TocEntry* end = m_Toc + m_Header->fileCount;
+		const TocEntry* it  = std::lower_bound(m_Toc, end, hash, [](const TocEntry& entry, uint64_t value) {
+			return entry.hash < value;
+		});
+
+		for (; it != end && it->hash == hash; ++it)
+		{
+			const uint32_t index = static_cast<uint32_t>(it - m_Toc);
+			if (GetName(index) == key) return index;
+		}
+
+		return npos;
+	}
+
+	std::string_view PakArchive::GetName(uint32_t index) const
+	{
+		return std::string_view(m_Names + m_Toc[index].nameOffset, m_Toc[index].nameSize);
+	}
+
+	const char* PakArchive::GetData(uint32_t index) const
+	{
+		return m_File.data + m_Toc[index].offset;
+	}
+
+	uint64_t PakArchive::Hash(std::string_view key)
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		for (const char c : key)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	void PakWriter::AddFile(const std::string& logicalPath, const std::string& filePath)
+	{
+		m_Files[VirtualFileSystem::ToKey(logicalPath)] = filePath;
+	}
+
+	uint32_t PakWriter::AddFolder(const std::string& root, const std::string& folder)
+	{
+		SPICES_PROFILE_ZONE;
+
+		const std::filesystem::path rootPath(root);
+
+		std::error_code ec;
+		if (!std::filesystem::is_directory(rootPath / folder, ec)) return 0;
+
+		uint32_t count = 0;
+		for (auto it = std::filesystem::recursive_directory_iterator(rootPath / folder, std::filesystem::directory_options::skip_permission_denied, ec);
+			!ec && it != std::filesystem::recursive_directory_iterator();
+			it.increment(ec))
+		{
+			if (!it->is_regular_file(ec)) continue;
+
+			AddFile(it->path().lexically_relative(rootPath).generic_string(), it->path().generic_string());
+			count++;
+		}
+
+		return count;
+	}
+
+	bool PakWriter::Write(const std::string& pakPath) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		const auto alignUp = [](uint64_t value) {
+			return (value + PakArchive::Alignment - 1) / PakArchive::Alignment * PakArchive::Alignment;
+		};
+
+		/**
+		* @brief Build TOC sorted by hash, names in same order.
+		*/
+		std::vector<std::pair<PakArchive::TocEntry, const std::pair<const std::string, std::string>*>> files;
+		files.reserve(m_Files.size());
+
+		for (const auto& file : m_Files)
+		{
+			std::error_code ec;
+			const uint64_t size = std::filesystem::file_size(file.second, ec);
+			if (ec)
+			{
+				std::stringstream ss;
+				ss << "PakWriter: " << file.second << " can not be read.";
+
+				SPICES_CORE_ERROR(ss.str());
+				return false;
+			}
+
+			PakArchive::TocEntry entry{};
+			entry.hash = PakArchive::Hash(file.first);
+			entry.size = size;
+
+			files.emplace_back(entry, &file);
+		}
+
+		std::sort(files.begin(), files.end(), [](const auto& l, const auto& r) {
+			return l.first.hash != r.first.hash ? l.first.hash < r.first.hash : l.second->first < r.second->first;
+		});
+
+		PakArchive::Header header{};
+		std::memcpy(header.magic, PakArchive::Magic, sizeof(header.magic));
+		header.version     = PakArchive::Version;
+		header.fileCount   = static_cast<uint32_t>(files.size());
+		header.alignment   = PakArchive::Alignment;
+		header.tocOffset   = sizeof(PakArchive::Header);
+		header.namesOffset = header.tocOffset + files.size() * sizeof(PakArchive::TocEntry);
+
+		std::string names;
+		for (auto& [entry, file] : files)
+		{
+			entry.nameOffset = static_cast<uint32_t>(names.size());
+			entry.nameSize   = static_cast<uint32_t>(file->first.size());
+			names += file->first;
+		}
+		header.namesSize = names.size();
+
+		uint64_t offset = alignUp(header.namesOffset + header.namesSize);
+		for (auto& [entry, file] : files)
+		{
+			entry.offset = offset;
+			offset = alignUp(offset + entry.size);
+		}
+
+		/**
+		* @brief Write header, TOC, names and blobs.
+		*/
+		std::ofstream stream(pakPath, std::ios::binary | std::ios::trunc);
+		if (!stream)
+		{
+			std::stringstream ss;
+			ss << "PakWriter: " << pakPath << " can not be written.";
+
+			SPICES_CORE_ERROR(ss.str());
+			return false;
+		}
+
+		const auto pad = [&](uint64_t to) {
+			static const char zeros[PakArchive::Alignment] = {};
+			const uint64_t at = static_cast<uint64_t>(stream.tellp());
+			stream.write(zeros, static_cast<std::streamsize>(to - at));
+		};
+
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const auto& [entry, file] : files)
+		{
+			stream.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+		}
+		stream.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+		std::vector<char> bytes;
+		for (const auto& [entry, file] : files)
+		{
+			pad(entry.offset);
+
+			bytes.resize(entry.size);
+
+			std::ifstream in(file->second, std::ios::binary);
+			in.read(bytes.data(), static_cast<std::streamsize>(entry.size));
+			if (static_cast<uint64_t>(in.gcount()) != entry.size)
+			{
+				std::stringstream ss;
+				ss << "PakWriter: " << file->second << " changed while packing.";
+
+				SPICES_CORE_ERROR(ss.str());
+				return false;
+			}
+
+			stream.write(bytes.data(), static_cast<std::streamsize>(entry.size));
+		}
+		pad(offset);
+
+		stream.close();
+		if (!stream) return false;
+
+		std::stringstream ss;
+		ss << "PakWriter: packed " << files.size() << " files to " << pakPath << ", " << offset << " bytes.";
+
+		SPICES_CORE_INFO(ss.str());
+
+		return true;
+	}
+
+	bool PakWriter::Cook(const std::string& root, const std::string& pakPath)
+	{
+		SPICES_PROFILE_ZONE;
+
+		PakWriter writer;
+		for (const auto& folder : CookedFolders)
+		{
+			writer.AddFolder(root, folder);
+		}
+
+		return writer.Write(pakPath);
+	}
+}
@@ -0,0 +1,243 @@
+/**
+* @file PakArchive.h.
+* @brief The PakArchive Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "Core/Library/FileLibrary.h"
+
+#include <string_view>
+
+namespace Spices {
+
+	/**
+	* @brief A pak file packs many asset files in one file.
+	* Layout: Header, TOC sorted by key hash, key names, then file blobs each aligned to Alignment.
+	* TOC and names are at front of the file, so opening touches only the first pages of the mapping.
+	* Keys are VirtualFileSystem logical path keys.
+	*/
+	class PakArchive
+	{
+	public:
+
+		/**
+		* @brief Pak file sign.
+		*/
+		static constexpr char Magic[4] = { 'S', 'P', 'A', 'K' };
+
+		/**
+		* @brief Pak file version.
+		*/
+		static constexpr uint32_t Version = 1;
+
+		/**
+		* @brief Alignment of file blobs, a page.
+		*/
+		static constexpr uint32_t Alignment = 4096;
+
+		/**
+		* @brief Invalid file index.
+		*/
+		static constexpr uint32_t npos = UINT32_MAX;
+
+		/**
+		* @brief Pak file header.
+		*/
+		struct Header
+		{
+			char     magic[4];        /* @brief Magic.                  */
+			uint32_t version;         /* @brief Version.                */
+			uint32_t fileCount;       /* @brief Count of files.         */
+			uint32_t alignment;       /* @brief Alignment of blobs.     */
+			uint64_t tocOffset;       /* @brief Offset of TOC.          */
+			uint64_t namesOffset;     /* @brief Offset of names.        */
+			uint64_t namesSize;       /* @brief Bytes of names.         */
+		};
+
+		/**
+		* @brief A file of TOC.
+		*/
+		struct TocEntry
+		{
+			uint64_t hash;            /* @brief Hash of key.            */
+			uint64_t offset;          /* @brief Offset of blob.         */
+			uint64_t size;            /* @brief Bytes of blob.          */
+			uint32_t nameOffset;      /* @brief Offset of key in names. */
+			uint32_t nameSize;        /* @brief Bytes of key.           */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		PakArchive() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~PakArchive();
+
+		/**
+		* @brief Copy Constructor Function.
+		* @note This Class not allowed copy behaves.
+		*/
+		PakArchive(const PakArchive&) = delete;
+
+		/**
+		* @brief Copy Assignment Operation.
+		* @note This Class not allowed copy behaves.
+		*/
+		PakArchive& operator=(const PakArchive&) = delete;
+
+		/**
+		* @brief Map a pak file and check its TOC.
+		* @param[in] path The pak file path.
+		* @return Returns true if succeed.
+		*/
+		bool Open(const std::string& path);
+
+		/**
+		* @brief UnMap the pak file.
+		*/
+		void Close();
+
+		/**
+		* @brief Find a file by key.
+		* @param[in] key VirtualFileSystem logical path key.
+		* @return Returns file index, npos if not found.
+		*/
+		uint32_t Find(const std::string& key) const;
+
+		/**
+		* @brief Get count of files.
+		* @return Returns count of files.
+		*/
+		uint32_t GetFileCount() const { return m_Header ? m_Header->fileCount : 0; }
+
+		/**
+		* @brief Get key of a file.
+		* @param[in] index File index.
+		* @return Returns the key.
+		*/
+		std::string_view GetName(uint32_t index) const;
+
+		/**
+		* @brief Get bytes of a file, a view of the mapping.
+		* @param[in] index File index.
+		* @return Returns the bytes.
+		*/
+		const char* GetData(uint32_t index) const;
+
+		/**
+		* @brief Get size of a file.
+		* @param[in] index File index.
+		* @return Returns bytes of the file.
+		*/
+		uint64_t GetSize(uint32_t index) const { return m_Toc[index].size; }
+
+		/**
+		* @brief Get the pak file path.
+		* @return Returns the pak file path.
+		*/
+		const std::string& GetPath() const { return m_Path; }
+
+		/**
+		* @brief Hash of a key, FNV-1a.
+		* @param[in] key The key.
+		* @return Returns the hash.
+		*/
+		static uint64_t Hash(std::string_view key);
+
+	private:
+
+		/**
+		* @brief The pak file path.
+		*/
+		std::string m_Path;
+
+		/**
+		* @brief The mapped pak file.
+		*/
+		MappedFileHandle m_File;
+
+		/**
+		* @brief Header in the mapping.
+		*/
+		const Header* m_Header = nullptr;
+
+		/**
+		* @brief TOC in the mapping.
+		*/
+		const TocEntry* m_Toc = nullptr;
+
+		/**
+		* @brief Names in the mapping.
+		*/
+		const char* m_Names = nullptr;
+	};
+
+	/**
+	* @brief Writes a pak file, used by cooker.
+	*/
+	class PakWriter
+	{
+	public:
+
+		/**
+		* @brief Folders of cooked assets, packed by Cook.
+		*/
+		static const std::vector<std::string> CookedFolders;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		PakWriter() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~PakWriter() = default;
+
+		/**
+		* @brief Add a file, replaces a same logical path added before.
+		* @param[in] logicalPath Logical path in pak.
+		* @param[in] filePath Physical path of the file.
+		*/
+		void AddFile(const std::string& logicalPath, const std::string& filePath);
+
+		/**
+		* @brief Add all files in a folder recursively.
+		* @param[in] root Mount folder, logical paths are relative to it.
+		* @param[in] folder Folder relative to root.
+		* @return Returns count of added files.
+		*/
+		uint32_t AddFolder(const std::string& root, const std::string& folder);
+
+		/**
+		* @brief Write the pak file.
+		* @param[in] pakPath The pak file path.
+		* @return Returns true if succeed.
+		*/
+		bool Write(const std::string& pakPath) const;
+
+		/**
+		* @brief Pack CookedFolders of a resource folder.
+		* @param[in] root The resource folder.
+		* @param[in] pakPath The pak file path, mount it at root of a resource folder to use it.
+		* @return Returns true if succeed.
+		*/
+		static bool Cook(const std::string& root, const std::string& pakPath);
+
+	private:
+
+		/**
+		* @brief Files, key: logical path key, value: physical path.
+		*/
+		std::map<std::string, std::string> m_Files;
+	};
+}
@@ -0,0 +1,410 @@
+/**
+* @file VirtualFileSystem.cpp.
+* @brief The VirtualFileSystem Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "VirtualFileSystem.h"
+#include "Core/Library/FileLibrary.h"
+
+namespace Spices {
+
+	std::vector<std::string>                                         VirtualFileSystem::m_Mounts;
+	std::unordered_map<std::string, VirtualFileSystem::Entry>        VirtualFileSystem::m_Index;
+	std::unordered_map<std::string, std::filesystem::file_time_type> VirtualFileSystem::m_Directories;
+	uint64_t                                                         VirtualFileSystem::m_Archives = 0;
+	std::shared_mutex                                                VirtualFileSystem::m_Mutex;
+	std::thread                                                      VirtualFileSystem::m_Watcher;
+	std::condition_variable                                          VirtualFileSystem::m_WatcherCV;
+	std::mutex                                                       VirtualFileSystem::m_WatcherMutex;
+	bool                                                             VirtualFileSystem::m_WatcherStop = false;
+
+	namespace {
+
+		/**
+		* @brief Serializes scans and AddFile, so a file added during a scan is not lost on swap.
+		*/
+		std::mutex scanMutex;
+
+		/**
+		* @brief Statistics counters, Resolve is called concurrently.
+		*/
+		std::atomic<uint64_t> scanCount      = 0;
+		std::atomic<uint64_t> resolveCount   = 0;
+		std::atomic<uint64_t> missCount      = 0;
+		std::atomic<uint64_t> watchStatCount = 0;
+	}
+
+	uint32_t VirtualFileSystem::Mount(const std::string& root)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::string folder = std::filesystem::path(root).generic_string();
+		if (!folder.empty() && folder.back() != '/') folder += '/';
+
+		uint32_t mount = 0;
+		{
+			std::unique_lock<std::shared_mutex> lock(m_Mutex);
+
+			for (; mount < m_Mounts.size(); mount++)
+			{
+				if (m_Mounts[mount] == folder) return mount;
+			}
+
+			m_Mounts.push_back(folder);
+		}
+
+		Rescan();
+
+		return mount;
+	}
+
+	void VirtualFileSystem::UnMountAll()
+	{
+		SPICES_PROFILE_ZONE;
+
+		StopWatch();
+
+		std::unique_lock<std::mutex>        scanLock(scanMutex);
+		std::unique_lock<std::shared_mutex> lock(m_Mutex);
+
+		m_Mounts     .clear();
+		m_Index      .clear();
+		m_Directories.clear();
+		m_Archives = 0;
+	}
+
+	bool VirtualFileSystem::Resolve(const std::string& logicalPath, Entry& outEntry)
+	{
+		SPICES_PROFILE_ZONE;
+
+		resolveCount.fetch_add(1, std::memory_order_relaxed);
+
+		const std::string key = ToKey(logicalPath);
+
+		std::shared_lock<std::shared_mutex> lock(m_Mutex);
+
+		const auto it = m_Index.find(key);
+		if (it == m_Index.end())
+		{
+			missCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		outEntry = it->second;
+		return true;
+	}
+
+	bool VirtualFileSystem::Exists(const std::string& logicalPath)
+	{
+		Entry entry;
+		return Resolve(logicalPath, entry);
+	}
+
+	bool VirtualFileSystem::Load(const Entry& entry, Blob& outBlob)
+	{
+		SPICES_PROFILE_ZONE;
+
+		outBlob = Blob{};
+
+		if (entry.IsPacked())
+		{
+			outBlob.data   = entry.archive->GetData(entry.file);
+			outBlob.size   = entry.archive->GetSize(entry.file);
+			outBlob.holder = entry.archive;
+
+			return true;
+		}
+
+		FileHandle f;
+		if (!FileLibrary::FileLibrary_Open(entry.path.c_str(), FILE_MODE_READ, true, &f)) return false;
+
+		uint64_t size = 0;
+		FileLibrary::FileLibrary_Size(&f, &size);
+
+		auto bytes = std::make_shared<std::vector<char>>(size);
+
+		uint64_t readed = 0;
+		const bool isRead = size == 0 || FileLibrary::FileLibrary_Read(&f, size, bytes->data(), &readed);
+
+		FileLibrary::FileLibrary_Close(&f);
+
+		if (!isRead) return false;
+
+		outBlob.data   = bytes->data();
+		outBlob.size   = size;
+		outBlob.holder = std::move(bytes);
+
+		return true;
+	}
+
+	void VirtualFileSystem::LoadAsync(const Entry& entry, IOPriority priority, std::function<void(bool isSucceed, const Blob& blob)> callback)
+	{
+		SPICES_PROFILE_ZONE;
+
+		if (entry.IsPacked())
+		{
+			Blob blob;
+			const bool isSucceed = Load(entry, blob);
+
+			callback(isSucceed, blob);
+			return;
+		}
+
+		IORequest request;
+		request.path     = entry.path;
+		request.priority = priority;
+		request.callback = [callback = std::move(callback)](IOResult& result) {
+
+			Blob blob;
+
+			if (result.isSucceed)
+			{
+				auto bytes = std::make_shared<std::vector<char>>(std::move(result.data));
+
+				blob.data   = bytes->data();
+				blob.size   = bytes->size();
+				blob.holder = std::move(bytes);
+			}
+
+			callback(result.isSucceed, blob);
+		};
+
+		AsyncIOService::Get()->Submit(std::move(request));
+	}
+
+	void VirtualFileSystem::AddFile(uint32_t mount, const std::string& logicalPath)
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex>        scanLock(scanMutex);
+		std::unique_lock<std::shared_mutex> lock(m_Mutex);
+
+		if (mount >= m_Mounts.size()) return;
+
+		Entry& entry = m_Index[ToKey(logicalPath)];
+
+		/**
+		* @brief Keep the file of a prior mount, a loose file wins over a packed one of same mount.
+		*/
+		if (!entry.path.empty() && entry.mount < mount) return;
+
+		entry.path    = m_Mounts[mount] + std::filesystem::path(logicalPath).generic_string();
+		entry.mount   = mount;
+		entry.archive = nullptr;
+		entry.file    = PakArchive::npos;
+	}
+
+	std::string VirtualFileSystem::GetMountRoot(uint32_t mount)
+	{
+		std::shared_lock<std::shared_mutex> lock(m_Mutex);
+
+		return mount < m_Mounts.size() ? m_Mounts[mount] : std::string();
+	}
+
+	bool VirtualFileSystem::Refresh()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::vector<std::pair<std::string, std::filesystem::file_time_type>> directories;
+		{
+			std::shared_lock<std::shared_mutex> lock(m_Mutex);
+
+			directories.assign(m_Directories.begin(), m_Directories.end());
+		}
+
+		/**
+		* @brief A directory's write time changes when a child is added, removed or renamed.
+		*/
+		bool isChanged = false;
+		for (const auto& [directory, time] : directories)
+		{
+			std::error_code ec;
+			const auto now = std::filesystem::last_write_time(directory, ec);
+
+			watchStatCount.fetch_add(1, std::memory_order_relaxed);
+
+			if (ec || now != time)
+			{
+				isChanged = true;
+				break;
+			}
+		}
+
+		if (isChanged) Rescan();
+
+		return isChanged;
+	}
+
+	void VirtualFileSystem::StartWatch(std::chrono::milliseconds interval)
+	{
+		SPICES_PROFILE_ZONE;
+
+		StopWatch();
+
+		{
+			std::unique_lock<std::mutex> lock(m_WatcherMutex);
+			m_WatcherStop = false;
+		}
+
+		m_Watcher = std::thread([interval]() {
+
+			std::unique_lock<std::mutex> lock(m_WatcherMutex);
+
+			while (!m_WatcherCV.wait_for(lock, interval, []() { return m_WatcherStop; }))
+			{
+				lock.unlock();
+				Refresh();
+				lock.lock();
+			}
+		});
+	}
+
+	void VirtualFileSystem::StopWatch()
+	{
+		SPICES_PROFILE_ZONE;
+
+		{
+			std::unique_lock<std::mutex> lock(m_WatcherMutex);
+			m_WatcherStop = true;
+		}
+
+		m_WatcherCV.notify_all();
+
+		if (m_Watcher.joinable()) m_Watcher.join();
+	}
+
+	VirtualFileSystem::Stats VirtualFileSystem::GetStats()
+	{
+		std::shared_lock<std::shared_mutex> lock(m_Mutex);
+
+		Stats stats;
+		stats.files       = m_Index.size();
+		stats.directories = m_Directories.size();
+		stats.archives    = m_Archives;
+		stats.scans       = scanCount     .load(std::memory_order_relaxed);
+		stats.resolves    = resolveCount  .load(std::memory_order_relaxed);
+		stats.misses      = missCount     .load(std::memory_order_relaxed);
+		stats.watchStats  = watchStatCount.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	std::string VirtualFileSystem::ToKey(const std::string& logicalPath)
+	{
+		std::string key = logicalPath;
+
+		for (char& c : key)
+		{
+			if (c == '\\') c = '/';
+			else           c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+
+		return key;
+	}
+
+	void VirtualFileSystem::Scan(
+		const std::vector<std::string>&                                   mounts         ,
+		std::unordered_map<std::string, Entry>&                           outIndex       ,
+		std::unordered_map<std::string, std::filesystem::file_time_type>& outDirectories ,
+		uint64_t&                                                         outArchives
+	)
+	{
+		SPICES_PROFILE_ZONE;
+
+		for (uint32_t mount = 0; mount < mounts.size(); mount++)
+		{
+			const std::filesystem::path root(mounts[mount]);
+
+			std::error_code ec;
+			if (!std::filesystem::is_directory(root, ec)) continue;
+
+			outDirectories[root.generic_string()] = std::filesystem::last_write_time(root, ec);
+
+			std::vector<std::filesystem::path> paks;
+
+			for (auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, ec);
+				!ec && it != std::filesystem::recursive_directory_iterator();
+				it.increment(ec))
+			{
+				const auto& entry = *it;
+
+				if (entry.is_directory(ec))
+				{
+					outDirectories[entry.path().generic_string()] = entry.last_write_time(ec);
+				}
+				else if (entry.is_regular_file(ec))
+				{
+					if (it.depth() == 0 && entry.path().extension() == ".pak")
+					{
+						paks.push_back(entry.path());
+						continue;
+					}
+
+					const std::string relative = entry.path().lexically_relative(root).generic_string();
+
+					/**
+					* @brief First mount wins.
+					*/
+					outIndex.try_emplace(ToKey(relative), Entry{ entry.path().generic_string(), mount });
+				}
+			}
+
+			/**
+			* @brief Paks after loose files, in name order.
+			*/
+			std::sort(paks.begin(), paks.end());
+
+			for (const auto& pak : paks)
+			{
+				auto archive = std::make_shared<PakArchive>();
+				if (!archive->Open(pak.generic_string())) continue;
+
+				outDirectories[pak.generic_string()] = std::filesystem::last_write_time(pak, ec);
+				outArchives++;
+
+				for (uint32_t i = 0; i < archive->GetFileCount(); i++)
+				{
+					outIndex.try_emplace(std::string(archive->GetName(i)), Entry{ archive->GetPath(), mount, archive, i });
+				}
+			}
+		}
+	}
+
+	void VirtualFileSystem::Rescan()
+	{
+		SPICES_PROFILE_ZONE;
+
+		std::unique_lock<std::mutex> scanLock(scanMutex);
+
+		std::vector<std::string> mounts;
+		{
+			std::shared_lock<std::shared_mutex> lock(m_Mutex);
+			mounts = m_Mounts;
+		}
+
+		std::unordered_map<std::string, Entry>                           index;
+		std::unordered_map<std::string, std::filesystem::file_time_type> directories;
+		uint64_t                                                         archives = 0;
+
+		Scan(mounts, index, directories, archives);
+
+		const size_t files = index.size();
+
+		scanCount.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			std::unique_lock<std::shared_mutex> lock(m_Mutex);
+
+			m_Index      .swap(index);
+			m_Directories.swap(directories);
+			m_Archives = archives;
+		}
+
+		std::stringstream ss;
+		ss << "VirtualFileSystem: indexed " << files << " files in " << mounts.size() << " mounts, " << archives << " paks.";
+
+		SPICES_CORE_INFO(ss.str());
+	}
+}
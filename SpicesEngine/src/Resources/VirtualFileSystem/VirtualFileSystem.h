@@ -0,0 +1,290 @@
+/**
+* @file VirtualFileSystem.h.
+* @brief The VirtualFileSystem Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+#include "PakArchive.h"
+#include "Core/Library/AsyncIOService.h"
+
+#include <shared_mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <cstring>
+
+namespace Spices {
+
+	/**
+	* @brief Index of files under mounted folders, resolves a logical path to a physical file without file stat.
+	* A logical path is relative to a mount folder, such as "Meshes/src/Cube.obj", matched case-insensitive.
+	* Mount folders are scanned once, a watcher rescans them when a folder's write time changes.
+	* If two mounts have a same logical path, the first mounted wins, same as ResourceSystem search order.
+	* Pak files at root of a mount are indexed as part of it, a loose file of the mount wins over a packed one.
+	*/
+	class VirtualFileSystem
+	{
+	public:
+
+		/**
+		* @brief A resolved file.
+		*/
+		struct Entry
+		{
+			std::string                       path;                       /* @brief Physical path, the pak path if packed.     */
+			uint32_t                          mount   = 0;                /* @brief Mount index, same as search folder index.  */
+			std::shared_ptr<const PakArchive> archive;                    /* @brief The pak, nullptr if loose.                 */
+			uint32_t                          file    = PakArchive::npos; /* @brief File index in the pak.                     */
+
+			bool IsPacked() const { return archive != nullptr; }
+		};
+
+		/**
+		* @brief Bytes of a file, a view of pak mapping or a copy of loose file.
+		*/
+		struct Blob
+		{
+			const char*                 data = nullptr;     /* @brief Bytes.                           */
+			uint64_t                    size = 0;           /* @brief Count of bytes.                  */
+			std::shared_ptr<const void> holder;             /* @brief Keeps pak or copy alive.         */
+		};
+
+		/**
+		* @brief Statistics.
+		*/
+		struct Stats
+		{
+			uint64_t files         = 0;     /* @brief Indexed files.                 */
+			uint64_t directories   = 0;     /* @brief Watched directories and paks.  */
+			uint64_t archives      = 0;     /* @brief Mapped paks.                   */
+			uint64_t scans         = 0;     /* @brief Full scans.                    */
+			uint64_t resolves      = 0;     /* @brief Resolve calls.                 */
+			uint64_t misses        = 0;     /* @brief Resolve calls not found.       */
+			uint64_t watchStats    = 0;     /* @brief Directory time checks.         */
+		};
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		VirtualFileSystem() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~VirtualFileSystem() = default;
+
+		/**
+		* @brief Mount a folder and rescan.
+		* @param[in] root The folder.
+		* @return Returns mount index, the index of first mount if mounted before.
+		*/
+		static uint32_t Mount(const std::string& root);
+
+		/**
+		* @brief Stop watcher and clear all mounts.
+		*/
+		static void UnMountAll();
+
+		/**
+		* @brief Resolve a logical path.
+		* @param[in] logicalPath The logical path.
+		* @param[out] outEntry The resolved file.
+		* @return Returns true if found.
+		*/
+		static bool Resolve(const std::string& logicalPath, Entry& outEntry);
+
+		/**
+		* @brief Determine whether a logical path is a file.
+		* @param[in] logicalPath The logical path.
+		* @return Returns true if found.
+		*/
+		static bool Exists(const std::string& logicalPath);
+
+		/**
+		* @brief Get bytes of a resolved file.
+		* Packed file is read by offset of mapped pak, loose file is read into a copy.
+		* @param[in] entry The resolved file.
+		* @param[out] outBlob The bytes.
+		* @return Returns true if succeed.
+		*/
+		static bool Load(const Entry& entry, Blob& outBlob);
+
+		/**
+		* @brief Get bytes of a resolved file in background.
+		* Packed file is a view of mapping and completes on the calling thread,
+		* loose file is read by AsyncIOService and completes on its completion pool.
+		* @param[in] entry The resolved file.
+		* @param[in] priority Read priority.
+		* @param[in] callback Called with the bytes, or an empty blob if failed.
+		*/
+		static void LoadAsync(const Entry& entry, IOPriority priority, std::function<void(bool isSucceed, const Blob& blob)> callback);
+
+		/**
+		* @brief Add a file written by engine, visible before watcher notices it.
+		* @param[in] mount Mount index.
+		* @param[in] logicalPath The logical path.
+		*/
+		static void AddFile(uint32_t mount, const std::string& logicalPath);
+
+		/**
+		* @brief Get a mount folder.
+		* @param[in] mount Mount index.
+		* @return Returns the folder.
+		*/
+		static std::string GetMountRoot(uint32_t mount);
+
+		/**
+		* @brief Check write time of all indexed directories, rescan if any changed.
+		* @return Returns true if rescanned.
+		*/
+		static bool Refresh();
+
+		/**
+		* @brief Start watcher thread calling Refresh.
+		* @param[in] interval Time between two checks.
+		*/
+		static void StartWatch(std::chrono::milliseconds interval = std::chrono::milliseconds(500));
+
+		/**
+		* @brief Stop watcher thread.
+		*/
+		static void StopWatch();
+
+		/**
+		* @brief Get statistics.
+		* @return Returns statistics.
+		*/
+		static Stats GetStats();
+
+		/**
+		* @brief Logical path to index key, '/' separated and lower case.
+		* @param[in] logicalPath The logical path.
+		* @return Returns the key.
+		*/
+		static std::string ToKey(const std::string& logicalPath);
+
+	private:
+
+		/**
+		* @brief Scan all mounts.
+		* @param[in] mounts Mount folders.
+		* @param[out] outIndex Files, key: logical path key.
+		* @param[out] outDirectories Directories and paks and their write time.
+		* @param[out] outArchives Count of mapped paks.
+		*/
+		static void Scan(
+			const std::vector<std::string>&                                       mounts         ,
+			std::unordered_map<std::string, Entry>&                               outIndex       ,
+			std::unordered_map<std::string, std::filesystem::file_time_type>&     outDirectories ,
+			uint64_t&                                                             outArchives
+		);
+
+		/**
+		* @brief Scan all mounts and replace index.
+		*/
+		static void Rescan();
+
+	private:
+
+		/**
+		* @brief Mount folders, '/' ended.
+		*/
+		static std::vector<std::string> m_Mounts;
+
+		/**
+		* @brief Files, key: logical path key.
+		*/
+		static std::unordered_map<std::string, Entry> m_Index;
+
+		/**
+		* @brief Directories and paks and their write time when scanned.
+		*/
+		static std::unordered_map<std::string, std::filesystem::file_time_type> m_Directories;
+
+		/**
+		* @brief Count of mapped paks.
+		*/
+		static uint64_t m_Archives;
+
+		/**
+		* @brief Mutex of mounts and index.
+		*/
+		static std::shared_mutex m_Mutex;
+
+		/**
+		* @brief Watcher thread.
+		*/
+		static std::thread m_Watcher;
+
+		/**
+		* @brief Wakes watcher on stop.
+		*/
+		static std::condition_variable m_WatcherCV;
+
+		/**
+		* @brief Mutex of m_WatcherCV.
+		*/
+		static std::mutex m_WatcherMutex;
+
+		/**
+		* @brief True if watcher should exit.
+		*/
+		static bool m_WatcherStop;
+	};
+
+	/**
+	* @brief Reads a Blob in order, used as FileLibrary_Read of a FileHandle.
+	*/
+	class BlobReader
+	{
+	public:
+
+		/**
+		* @brief Constructor Function.
+		* @param[in] blob The blob, must outlive this reader.
+		*/
+		explicit BlobReader(const VirtualFileSystem::Blob& blob) : m_Blob(blob) {}
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~BlobReader() = default;
+
+		/**
+		* @brief Read Specific size of data, and move cursor the same size.
+		* @param[in] size How much bytes we want read.
+		* @param[out] outData The data we read.
+		* @return Returns false if not enough bytes left, nothing is read.
+		*/
+		bool Read(uint64_t size, void* outData)
+		{
+			if (size > m_Blob.size - m_Cursor) return false;
+
+			std::memcpy(outData, m_Blob.data + m_Cursor, size);
+			m_Cursor += size;
+
+			return true;
+		}
+
+		/**
+		* @brief Get bytes not read.
+		* @return Returns bytes not read.
+		*/
+		uint64_t Remain() const { return m_Blob.size - m_Cursor; }
+
+	private:
+
+		/**
+		* @brief The blob.
+		*/
+		const VirtualFileSystem::Blob& m_Blob;
+
+		/**
+		* @brief Bytes read.
+		*/
+		uint64_t m_Cursor = 0;
+	};
+}
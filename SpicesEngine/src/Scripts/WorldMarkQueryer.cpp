@@ -20,6 +20,7 @@ namespace Spices {
 			Event::GetEventCallbackFn()(event);
 
 			FrameInfo::Get().m_World->ClearMarkerWithBits(World::MeshAddedToWorld);
+			FrameInfo::Get().m_World->ClearMeshChanges();
 		}
 
 		if (mark & World::FrushStableFrame)
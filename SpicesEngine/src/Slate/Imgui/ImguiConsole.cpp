@@ -14,6 +14,37 @@
 
 namespace Spices {
 
+	namespace {
+
+		/**
+		* @brief Icon and color of a level.
+		*/
+		struct LevelStyle
+		{
+			const char* icon;
+			ImVec4      color;
+		};
+
+		/**
+		* @brief Get Icon and color of a level.
+		* @param[in] level Log level.
+		* @return Returns Icon and color.
+		*/
+		const LevelStyle& GetLevelStyle(spdlog::level::level_enum level)
+		{
+			static const LevelStyle styles[ConsoleStore::LevelCount] = {
+				{ ICON_MD_EMERGENCY     , ImVec4(0.83f , 0.83f , 0.83f, 1.0f) },    /* @brief trace.     */
+				{ ICON_MD_EMERGENCY     , ImVec4(0.83f , 0.83f , 0.83f, 1.0f) },    /* @brief debug.     */
+				{ ICON_MD_ERROR_OUTLINE , ImVec4(0.574f, 0.829f, 1.0f , 1.0f) },    /* @brief info.      */
+				{ ICON_MD_WARNING_AMBER , ImVec4(0.974f, 0.896f, 0.39f, 1.0f) },    /* @brief warn.      */
+				{ ICON_MD_NEARBY_ERROR  , ImVec4(1.0f  , 0.641f, 0.59f, 1.0f) },    /* @brief error.     */
+				{ ICON_MD_NEARBY_ERROR  , ImVec4(1.0f  , 0.0f  , 0.0f , 1.0f) },    /* @brief critical.  */
+			};
+
+			return styles[std::min<uint32_t>(level, ConsoleStore::LevelCount - 1)];
+		}
+	}
+
 	ImguiConsole::ImguiConsole(
 		const std::string&       panelName , 
 		FrameInfo&               frameInfo , 
@@ -21,6 +52,7 @@ namespace Spices {
 	)
 		: ImguiSlate(panelName, frameInfo)
 		, m_Console(console)
+		, m_Filter(console->GetStore())
 	{}
 
 	void ImguiConsole::OnRender()
@@ -34,6 +66,18 @@ namespace Spices {
 
 		ImGui::Spacing();
 
+		/**
+		* @brief Num of warnings and errors.
+		*/
+		uint64_t nWarns  = 0;
+		uint64_t nErrors = 0;
+		{
+			auto lock = m_Console->Lock();
+
+			nWarns  = m_Console->GetStore().GetLevelCount(spdlog::level::warn);
+			nErrors = m_Console->GetStore().GetLevelCount(spdlog::level::err) + m_Console->GetStore().GetLevelCount(spdlog::level::critical);
+		}
+
 		/**
 		* @brief Render ClearConsoleIcon.
 		*/
@@ -128,7 +172,7 @@ namespace Spices {
 
 			ImGui::SameLine();
 			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.83f, 0.83f, 0.83f, 1.0f));
-			if (ImGui::Button(ICON_MD_EMERGENCY, ImGuiH::GetLineItemSize())) m_Level = 0;
+			if (ImGui::Button(ICON_MD_EMERGENCY, ImGuiH::GetLineItemSize())) { m_LevelMask = ConsoleFilter::AllLevels; UpdateQuery(); }
 			ImGui::PopStyleColor();
 			ImGui::SetItemTooltip("Verbose");
 		}
@@ -141,7 +185,7 @@ namespace Spices {
 
 			ImGui::SameLine();
 			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.574f, 0.829f, 1.0f, 1.0f));
-			if (ImGui::Button(ICON_MD_ERROR_OUTLINE, ImGuiH::GetLineItemSize())) m_Level = 1;
+			if (ImGui::Button(ICON_MD_ERROR_OUTLINE, ImGuiH::GetLineItemSize())) { m_LevelMask = 1u << spdlog::level::info; UpdateQuery(); }
 			ImGui::PopStyleColor();
 			ImGui::SetItemTooltip("Info");
 		}
@@ -154,12 +198,12 @@ namespace Spices {
 
 			ImGui::SameLine();
 			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.974f, 0.896f, 0.39f, 1.0f));
-			if (ImGui::Button(ICON_MD_WARNING_AMBER, ImGuiH::GetLineItemSize())) m_Level = 2;
+			if (ImGui::Button(ICON_MD_WARNING_AMBER, ImGuiH::GetLineItemSize())) { m_LevelMask = 1u << spdlog::level::warn; UpdateQuery(); }
 			ImGui::PopStyleColor();
 			ImGui::SetItemTooltip("Warning");
 			ImGui::SameLine();
 			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.974f, 0.896f, 0.39f, 1.0f));
-			ImGui::Text(std::to_string(m_Console->GetInfos().m_WarnLogInfos.size()).c_str());
+			ImGui::Text(std::to_string(nWarns).c_str());
 			ImGui::PopStyleColor();
 		}
 
@@ -171,21 +215,15 @@ namespace Spices {
 
 			ImGui::SameLine();
 			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.641f, 0.59f, 1.0f));
-			if (ImGui::Button(ICON_MD_NEARBY_ERROR, ImGuiH::GetLineItemSize())) m_Level = 3;
+			if (ImGui::Button(ICON_MD_NEARBY_ERROR, ImGuiH::GetLineItemSize())) { m_LevelMask = 1u << spdlog::level::err | 1u << spdlog::level::critical; UpdateQuery(); }
 			ImGui::PopStyleColor();
 			ImGui::SetItemTooltip("Error");
 			ImGui::SameLine();
 			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.641f, 0.59f, 1.0f));
-			ImGui::Text(std::to_string(m_Console->GetInfos().m_ErrorLogInfos.size()).c_str());
+			ImGui::Text(std::to_string(nErrors).c_str());
 			ImGui::PopStyleColor();
 		}
 
-		/**
-		* @brief Search String.
-		*/
-		static std::string searchString;
-		static bool isEnableSearch = false;
-
 		/**
 		* @brief Render Search Input Text.
 		*/
@@ -194,12 +232,9 @@ namespace Spices {
 
 			ImGui::SameLine();
 			ImGui::PushItemWidth(200);
-			static char search[128] = "";
-			if (ImGui::InputTextWithHint("##", ICON_TEXT(ICON_MD_SEARCH, Search), search, 128)) 
+			if (ImGui::InputTextWithHint("##", ICON_TEXT(ICON_MD_SEARCH, Search), m_Search, IM_ARRAYSIZE(m_Search))) 
 			{
-				searchString = std::string(search);
-				if (searchString.size() == 0) isEnableSearch = false;
-				else isEnableSearch = true;
+				UpdateQuery();
 			}
 			ImGui::PopItemWidth();
 			ImGui::Spacing();
@@ -223,97 +258,60 @@ namespace Spices {
 			{
 				ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4, 1));
 
-				bool isFiltered = m_Filter.IsActive();
-
-				switch (m_Level)
-				{
-				default:
-					break;
-				case 0:
-					for (auto it = m_Console->GetInfos().m_TraceLogInfos.rbegin(); it != m_Console->GetInfos().m_TraceLogInfos.rend(); ++it)
-					{
-						const InfoLevelHelper& helper = *it;
-
-						if (isEnableSearch)
-						{
-							if (helper.str.find(searchString) == std::string::npos) continue;
-						}
-
-						ImGui::PushStyleColor(ImGuiCol_Text, { helper.color.x,  helper.color.y,  helper.color.z,  helper.color.w });
-						if (helper.level == "trace")
-						{
-							std::stringstream ss;
-							ss << ICON_MD_EMERGENCY << " " << helper.str;
-
-							ImGui::Selectable(ss.str().c_str(), false);
-						}
-						ImGui::PopStyleColor();
-					}
-					break;
-				case 1:
-					for (auto it = m_Console->GetInfos().m_InfoLogInfos.rbegin(); it != m_Console->GetInfos().m_InfoLogInfos.rend(); ++it)
-					{
-						const InfoLevelHelper& helper = *it;
-
-						if (isEnableSearch)
-						{
-							if (helper.str.find(searchString) == std::string::npos) continue;
-						}
-
-						ImGui::PushStyleColor(ImGuiCol_Text, { helper.color.x,  helper.color.y,  helper.color.z,  helper.color.w });
-						if (helper.level == "info")
-						{
-							std::stringstream ss;
-							ss << ICON_MD_ERROR_OUTLINE << " " << helper.str;
+				auto lock = m_Console->Lock();
+				const ConsoleStore& store = m_Console->GetStore();
 
-							ImGui::Selectable(ss.str().c_str(), false);
-						}
-						ImGui::PopStyleColor();
-					}
-					break;
-				case 2:
-					for (auto it = m_Console->GetInfos().m_WarnLogInfos.rbegin(); it != m_Console->GetInfos().m_WarnLogInfos.rend(); ++it)
-					{
-						const InfoLevelHelper& helper = *it;
+				/**
+				* @brief Test lines pushed since last frame, continue rebuilding index.
+				*/
+				m_Filter.Update();
 
-						if (isEnableSearch)
-						{
-							if (helper.str.find(searchString) == std::string::npos) continue;
-						}
+				if (!m_Filter.IsComplete())
+				{
+					ImGui::TextDisabled("%s Searching...", ICON_MD_SEARCH);
+				}
 
-						ImGui::PushStyleColor(ImGuiCol_Text, { helper.color.x,  helper.color.y,  helper.color.z,  helper.color.w });
-						if (helper.level == "warn")
-						{
-							std::stringstream ss;
-							ss << ICON_MD_WARNING_AMBER << " " << helper.str;
+				/**
+				* @brief Only visible rows are formatted, newest first.
+				*/
+				const uint64_t nRows = std::min<uint64_t>(m_Filter.GetRowCount(), std::numeric_limits<int>::max());
 
-							ImGui::Selectable(ss.str().c_str(), false);
-						}
-						ImGui::PopStyleColor();
-					}
-					break;
-				case 3:
-					for (auto it = m_Console->GetInfos().m_ErrorLogInfos.rbegin(); it != m_Console->GetInfos().m_ErrorLogInfos.rend(); ++it)
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(nRows));
+				while (clipper.Step())
+				{
+					for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
 					{
-						const InfoLevelHelper& helper = *it;
-
-						if (isEnableSearch)
+						const uint64_t line = m_Filter.GetRow(m_Filter.GetRowCount() - 1 - row);
+						const LevelStyle& style = GetLevelStyle(store.GetLevel(line));
+
+						m_Row.clear();
+						m_Row += style.icon;
+						m_Row += ' ';
+						store.Format(line, m_Row);
+
+						/**
+						* @brief Rows must be of the same height, multi-line messages show the first line.
+						*/
+						const size_t lineEnd = m_Row.find('\n');
+
+						ImGui::PushID(row);
+						ImGui::PushStyleColor(ImGuiCol_Text, style.color);
+						if (lineEnd == std::string::npos)
 						{
-							if (helper.str.find(searchString) == std::string::npos) continue;
+							ImGui::Selectable(m_Row.c_str(), false);
 						}
-
-						ImGui::PushStyleColor(ImGuiCol_Text, { helper.color.x,  helper.color.y,  helper.color.z,  helper.color.w });
-						if (helper.level == "error")
+						else
 						{
-							std::stringstream ss;
-							ss << ICON_MD_NEARBY_ERROR << " " << helper.str;
-
-							ImGui::Selectable(ss.str().c_str(), false);
+							const std::string firstLine = m_Row.substr(0, lineEnd) + " ...";
+							ImGui::Selectable(firstLine.c_str(), false);
+							ImGui::SetItemTooltip("%s", m_Row.c_str());
 						}
 						ImGui::PopStyleColor();
+						ImGui::PopID();
 					}
-					break;
 				}
+				clipper.End();
 
 				ImGui::PopStyleVar();
 			}
@@ -361,6 +359,15 @@ namespace Spices {
 		End();
 	}
 
+	void ImguiConsole::UpdateQuery()
+	{
+		SPICES_PROFILE_ZONE;
+
+		auto lock = m_Console->Lock();
+
+		m_Filter.SetQuery(m_LevelMask, m_Search);
+	}
+
 	int ImguiConsole::TextEditCallbackStub(ImGuiInputTextCallbackData* data)
 	{
 		SPICES_CORE_INFO(data->Buf);
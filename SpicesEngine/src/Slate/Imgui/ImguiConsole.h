@@ -7,6 +7,7 @@
 #pragma once
 #include "Core/Core.h"
 #include "ImguiUtils.h"
+#include "Core/Log/ConsoleFilter.h"
 
 namespace Spices {
 
@@ -66,6 +67,11 @@ namespace Spices {
 
 	private:
 
+		/**
+		* @brief Set query of m_Filter from m_LevelMask and m_Search.
+		*/
+		void UpdateQuery();
+
 		/**
 		* @brief The shared pointer of Console.
 		*/
@@ -74,12 +80,22 @@ namespace Spices {
 		/**
 		* @brief The Filter of console.
 		*/
-		ImGuiTextFilter m_Filter;
+		ConsoleFilter m_Filter;
+
+		/**
+		* @brief The information levels that console show.
+		*/
+		uint32_t m_LevelMask = ConsoleFilter::AllLevels;
+
+		/**
+		* @brief The Search String.
+		*/
+		char m_Search[128] = "";
 
 		/**
-		* @brief The information level that console show.
+		* @brief Text of the row in rendering, reused.
 		*/
-		int m_Level = 0;
+		std::string m_Row;
 
 		/**
 		* @brief The boolean of enable Cmd Input.
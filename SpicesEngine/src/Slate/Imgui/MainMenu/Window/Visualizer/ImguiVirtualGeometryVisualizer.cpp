@@ -106,8 +106,8 @@ namespace Spices {
     {
         SPICES_PROFILE_ZONE;
 
-        VkDescriptorImageInfo* triangleID       = VulkanRenderBackend::GetRendererResourcePool()->AccessResource({ "TriangleID" });
-        VkDescriptorImageInfo* meshletID        = VulkanRenderBackend::GetRendererResourcePool()->AccessResource({ "MeshletID" });
+        VkDescriptorImageInfo* triangleID       = VulkanRenderBackend::GetRendererResourcePool()->AccessExportedResource({ "TriangleID" });
+        VkDescriptorImageInfo* meshletID        = VulkanRenderBackend::GetRendererResourcePool()->AccessExportedResource({ "MeshletID" });
 
         m_BufferID.TriangleID       = ImGui_ImplVulkan_AddTexture(triangleID->sampler, triangleID->imageView, triangleID->imageLayout);
         m_BufferID.MeshletID        = ImGui_ImplVulkan_AddTexture(meshletID->sampler, meshletID->imageView, meshletID->imageLayout);
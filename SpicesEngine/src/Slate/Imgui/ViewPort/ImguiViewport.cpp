@@ -29,7 +29,7 @@ namespace Spices {
             /**
             * @brief Get SceneColor Info.
             */
-            VkDescriptorImageInfo* info = VulkanRenderBackend::GetRendererResourcePool()->AccessResource({ "SceneColor" });
+            VkDescriptorImageInfo* info = VulkanRenderBackend::GetRendererResourcePool()->AccessExportedResource({ "SceneColor" });
 
             /**
             * @brief Create SceneColor DescriptorSet.
@@ -158,7 +158,7 @@ namespace Spices {
         /**
         * @brief Get SceneColor Info again.
         */
-        VkDescriptorImageInfo* info = VulkanRenderBackend::GetRendererResourcePool()->AccessResource({ "SceneColor" });
+        VkDescriptorImageInfo* info = VulkanRenderBackend::GetRendererResourcePool()->AccessExportedResource({ "SceneColor" });
 
         /**
         * @brief Create SceneColor DescriptorSet.
@@ -183,7 +183,7 @@ namespace Spices {
         /**
         * @brief Get SceneColor Info again.
         */
-        VkDescriptorImageInfo* info = VulkanRenderBackend::GetRendererResourcePool()->AccessResource({ "SceneColor" });
+        VkDescriptorImageInfo* info = VulkanRenderBackend::GetRendererResourcePool()->AccessExportedResource({ "SceneColor" });
 
         /**
         * @brief Create SceneColor DescriptorSet.
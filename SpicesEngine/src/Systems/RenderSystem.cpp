@@ -7,6 +7,8 @@
 #include "Pchheader.h"
 #include "RenderSystem.h"
 #include "Resources/Mesh/Mesh.h"
+#include "Core/Memory/FrameAllocator.h"
+#include "Resources/Material/MaterialParameterArena.h"
 
 namespace Spices {
 
@@ -27,10 +29,22 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
+		static_assert(MaxFrameInFlight <= FrameAllocator::MaxFrames, "FrameAllocator needs one arena per frame in flight.");
+
+		/**
+		* @brief Transient allocations of this frame index from previous use are released.
+		*/
+		FrameAllocator::BeginFrame(FrameInfo::Get().m_FrameIndex);
+
 		/**
 		* @brief Begin Render this frame.
 		*/
 		m_RenderFrontend->BeginFrame(FrameInfo::Get());
+
+		/**
+		* @brief Upload material parameters changed since last frame.
+		*/
+		MaterialParameterArena::Flush();
 		
 		/**
 		* @brief Render this frame.
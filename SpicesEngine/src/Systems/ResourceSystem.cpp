@@ -8,6 +8,7 @@
 #include "ResourceSystem.h"
 #include "Resources/ResourcePool/ResourcePool.h"
 #include "Resources/Texture/Transcoder.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem.h"
 
 #include "Resources/Texture/Texture.h"
 #include "Resources/Material/Material.h"
@@ -21,6 +22,15 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
+		/**
+		* @brief Index all search folders in order, loaders resolve files from the index.
+		*/
+		for (auto& it : m_ResourceSearchFolder)
+		{
+			VirtualFileSystem::Mount(it);
+		}
+		VirtualFileSystem::StartWatch();
+
 		/**
 		* @brief Create Default Resource in different ResourccePool.
 		*/
@@ -41,6 +51,16 @@ namespace Spices {
 		ResourcePool<Texture>  ::Destroy();
 		ResourcePool<Material> ::Destroy();
 		ResourcePool<MeshPack> ::Destroy();
+
+		/**
+		* @brief Release Material Parameter pages after all materials.
+		*/
+		MaterialParameterArena::Destroy();
+
+		/**
+		* @brief Stop watcher and release index.
+		*/
+		VirtualFileSystem::UnMountAll();
 	}
 
 	void ResourceSystem::OnSystemUpdate(TimeStep& ts)
@@ -54,6 +74,8 @@ namespace Spices {
 	void ResourceSystem::RegistryResourceFolder(const std::string& folder)
 	{
 		m_ResourceSearchFolder.push_back(folder);
+
+		VirtualFileSystem::Mount(folder);
 	}
 
 }
\ No newline at end of file
@@ -292,8 +292,8 @@ namespace Spices {
 		});
 
 		/**
-		* @brief Mark World with MeshAddedToWorld bits.
+		* @brief Mark World with MeshAddedToWorld bits and record the entity.
 		*/
-		FrameInfo::Get().m_World->Mark(World::WorldMarkBits::MeshAddedToWorld);
+		FrameInfo::Get().m_World->MarkMeshChanged(static_cast<uint32_t>(m_Owner));
 	}
 }
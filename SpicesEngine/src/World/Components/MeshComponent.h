@@ -58,7 +58,7 @@ namespace Spices {
 		* @brief Get the Mesh variable.
 		* @return Returns the Mesh variable.
 		*/
-		std::shared_ptr<Mesh> GetMesh() { return m_Mesh; }
+		std::shared_ptr<Mesh> GetMesh() const { return m_Mesh; }
 		
 	protected:
 		
@@ -69,7 +69,7 @@ namespace Spices {
 		* @brief Get the tags variable.
 		* @return Returns the tags variable.
 		*/
-		const std::set<std::string>& GetTag() { return m_Tags; }
+		const std::set<std::string>& GetTag() const { return m_Tags; }
 
 	private:
 
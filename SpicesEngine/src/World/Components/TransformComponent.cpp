@@ -127,6 +127,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##X", &m_Transform.position.x, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -135,6 +136,7 @@ namespace Spices {
 				{ 
 					m_Transform.position.x = 0.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::SameLine();
@@ -155,6 +157,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##Y", &m_Transform.position.y, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -163,6 +166,7 @@ namespace Spices {
 				{
 					m_Transform.position.y = 0.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::SameLine();
@@ -183,6 +187,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##Z", &m_Transform.position.z, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -191,6 +196,7 @@ namespace Spices {
 				{ 
 					m_Transform.position.z = 0.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopID();
@@ -274,6 +280,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##X", &m_Transform.rotation.x, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -282,6 +289,7 @@ namespace Spices {
 				{ 
 					m_Transform.rotation.x = 0.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::SameLine();
@@ -302,6 +310,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##Y", &m_Transform.rotation.y, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -310,6 +319,7 @@ namespace Spices {
 				{ 
 					m_Transform.rotation.y = 0.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				};
 				ImGui::SameLine();
@@ -330,6 +340,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##Z", &m_Transform.rotation.z, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -338,6 +349,7 @@ namespace Spices {
 				{ 
 					m_Transform.rotation.z = 0.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopID();
@@ -413,6 +425,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##X", &m_Transform.scale.x, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -421,6 +434,7 @@ namespace Spices {
 				{ 
 					m_Transform.scale.x = 1.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::SameLine();
@@ -441,6 +455,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##Y", &m_Transform.scale.y, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -449,6 +464,7 @@ namespace Spices {
 				{ 
 					m_Transform.scale.y = 1.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::SameLine();
@@ -469,6 +485,7 @@ namespace Spices {
 				if(ImGui::DragFloat("##Z", &m_Transform.scale.z, 0.1f, 0.0f, 0.0f, "%.2f"))
 				{
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopItemWidth();
@@ -477,6 +494,7 @@ namespace Spices {
 				{ 
 					m_Transform.scale.z = 1.0f;
 					CalMatrix();
+					Mark(NeedUpdateTLAS);
 					FrameInfo::Get().m_World->Mark(World::FrushStableFrame | World::NeedUpdateTLAS);
 				}
 				ImGui::PopID();
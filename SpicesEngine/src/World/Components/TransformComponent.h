@@ -72,45 +72,45 @@ namespace Spices {
 
 		/**
 		* @brief Set the position this component handled.
-		* Call CalMatrix() during this API.
+		* Call CalMatrix() during this API and mark NeedUpdateTLAS.
 		* @param[in] position The entity's world position.
 		*/
-		void SetPosition(const glm::vec3& position) { m_Transform.position = position; CalMatrix(); }
+		void SetPosition(const glm::vec3& position) { m_Transform.position = position; CalMatrix(); Mark(NeedUpdateTLAS); }
 
 		/**
 		* @brief Set the rotation this component handled.
-		* Call CalMatrix() during this API.
+		* Call CalMatrix() during this API and mark NeedUpdateTLAS.
 		* @param[in] rotation The entity's world rotation.
 		*/
-		void SetRotation(const glm::vec3& rotation) { m_Transform.rotation = rotation; CalMatrix(); }
+		void SetRotation(const glm::vec3& rotation) { m_Transform.rotation = rotation; CalMatrix(); Mark(NeedUpdateTLAS); }
 
 		/**
 		* @brief Set the scale this component handled.
-		* Call CalMatrix() during this API.
+		* Call CalMatrix() during this API and mark NeedUpdateTLAS.
 		* @param[in] scale The entity's world scale.
 		*/
-		void SetScale(const glm::vec3& scale) { m_Transform.scale = scale; CalMatrix(); }
+		void SetScale(const glm::vec3& scale) { m_Transform.scale = scale; CalMatrix(); Mark(NeedUpdateTLAS); }
 
 		/**
 		* @brief Add the position to this component handled.
-		* Call CalMatrix() during this API.
+		* Call CalMatrix() during this API and mark NeedUpdateTLAS.
 		* @param[in] position The entity's world position.
 		*/
-		void AddPosition(const glm::vec3& position) { m_Transform.position += position; CalMatrix(); }
+		void AddPosition(const glm::vec3& position) { m_Transform.position += position; CalMatrix(); Mark(NeedUpdateTLAS); }
 
 		/**
 		* @brief Add the rotation to this component handled.
-		* Call CalMatrix() during this API.
+		* Call CalMatrix() during this API and mark NeedUpdateTLAS.
 		* @param[in] rotation The entity's world rotation.
 		*/
-		void AddRotation(const glm::vec3& rotation) { m_Transform.rotation += rotation; CalMatrix(); }
+		void AddRotation(const glm::vec3& rotation) { m_Transform.rotation += rotation; CalMatrix(); Mark(NeedUpdateTLAS); }
 
 		/**
 		* @brief Add the scale to this component handled.
-		* Call CalMatrix() during this API.
+		* Call CalMatrix() during this API and mark NeedUpdateTLAS.
 		* @param[in] scale The entity's world scale.
 		*/
-		void AddScale(const glm::vec3& scale) { m_Transform.scale += scale; CalMatrix(); }
+		void AddScale(const glm::vec3& scale) { m_Transform.scale += scale; CalMatrix(); Mark(NeedUpdateTLAS); }
 
 		/**
 		* @brief Get the modelMatrix variable.
@@ -128,7 +128,7 @@ namespace Spices {
 		* @brief Get the position variable.
 		* @return Returns the position variable.
 		*/
-		const glm::vec3& GetPosition() const { return m_Transform.scale; }
+		const glm::vec3& GetPosition() const { return m_Transform.position; }
 
 		/**
 		* @brief Get the rotation variable.
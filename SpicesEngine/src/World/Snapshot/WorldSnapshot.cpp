@@ -0,0 +1,374 @@
+/**
+* @file WorldSnapshot.cpp.
+* @brief The WorldSnapshot Class Implementation.
+* @author Spices.
+*/
+
+#include "Pchheader.h"
+#include "WorldSnapshot.h"
+#include "Core/Library/FileLibrary.h"
+
+#include <cstring>
+
+namespace Spices {
+
+	namespace {
+
+		/**
+		* @brief Column id, FNV-1a of name then record size.
+		*/
+		uint64_t ColumnId(const std::string& name, uint32_t recordSize)
+		{
+			uint64_t hash = 14695981039346656037ull;
+
+			const auto mix = [&](const void* data, size_t size) {
+				for (size_t i = 0; i < size; i++)
+				{
+					hash ^= static_cast<const uint8_t*>(data)[i];
+					hash *= 1099511628211ull;
+				}
+			};
+
+			mix(name.data(), name.size());
+			mix(&recordSize, sizeof(recordSize));
+
+			return hash;
+		}
+
+		/**
+		* @brief Round up to WorldSnapshot::Alignment.
+		*/
+		inline uint64_t AlignUp(uint64_t offset)
+		{
+			return (offset + WorldSnapshot::Alignment - 1) & ~(WorldSnapshot::Alignment - 1);
+		}
+
+		/**
+		* @brief Sequential writer tracking file offset.
+		*/
+		class Writer
+		{
+		public:
+
+			explicit Writer(FileHandle* file)
+				: m_File(file)
+			{}
+
+			bool Write(const void* data, uint64_t size)
+			{
+				if (size == 0) return m_IsSucceed;
+
+				uint64_t written = 0;
+				m_IsSucceed &= FileLibrary::FileLibrary_Write(m_File, size, data, &written) && written == size;
+				m_Offset += size;
+
+				return m_IsSucceed;
+			}
+
+			bool PadTo(uint64_t offset)
+			{
+				static const char zeros[WorldSnapshot::Alignment] = {};
+
+				while (m_Offset < offset)
+				{
+					Write(zeros, std::min<uint64_t>(offset - m_Offset, sizeof(zeros)));
+				}
+
+				return m_IsSucceed;
+			}
+
+			uint64_t GetOffset() const { return m_Offset; }
+
+			bool IsSucceed() const { return m_IsSucceed; }
+
+		private:
+
+			FileHandle* m_File;
+			uint64_t    m_Offset    = 0;
+			bool        m_IsSucceed = true;
+		};
+	}
+
+	uint32_t WorldSnapshot::StringTable::Intern(std::string_view str)
+	{
+		const auto [it, isInsert] = m_Ids.try_emplace(std::string(str), static_cast<uint32_t>(m_Strings.size()));
+		if (isInsert)
+		{
+			m_Strings.push_back(it->first);
+		}
+
+		return it->second;
+	}
+
+	void WorldSnapshot::AddColumn(Column&& column)
+	{
+		SPICES_PROFILE_ZONE;
+
+		column.id = ColumnId(column.name, column.recordSize);
+
+		for (auto& c : m_Columns)
+		{
+			if (c.name == column.name)
+			{
+				c = std::move(column);
+				return;
+			}
+		}
+
+		m_Columns.push_back(std::move(column));
+	}
+
+	bool WorldSnapshot::Save(const entt::registry& registry, const std::string& path, Stats* outStats) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		/**
+		* @brief Number alive entities in storage order.
+		*/
+		const auto* entityStorage = registry.storage<entt::entity>();
+
+		std::vector<uint32_t> indices;
+		uint32_t nEntities = 0;
+		for (const auto [entity] : entityStorage->each())
+		{
+			const auto id = entt::to_entity(entity);
+			if (id >= indices.size()) indices.resize(static_cast<size_t>(id) + 1, UINT32_MAX);
+
+			indices[id] = nEntities++;
+		}
+
+		/**
+		* @brief Gather columns.
+		*/
+		struct Gathered
+		{
+			std::vector<uint32_t> entities;
+			std::vector<char>     records;
+		};
+
+		StringTable strings;
+		std::vector<Gathered> gathered(m_Columns.size());
+		for (size_t i = 0; i < m_Columns.size(); i++)
+		{
+			m_Columns[i].save(registry, indices, gathered[i].entities, gathered[i].records, strings);
+		}
+
+		/**
+		* @brief Layout.
+		*/
+		Header header{};
+		std::memcpy(header.magic, Magic, sizeof(Magic));
+		header.version           = Version;
+		header.entityCount       = nEntities;
+		header.columnCount       = static_cast<uint32_t>(m_Columns.size());
+		header.stringCount       = strings.Size();
+		header.columnsOffset     = AlignUp(sizeof(Header));
+		header.stringsOffset     = AlignUp(header.columnsOffset + sizeof(ColumnHeader) * m_Columns.size());
+		header.stringBytesOffset = AlignUp(header.stringsOffset + sizeof(uint64_t) * (uint64_t(strings.Size()) + 1));
+
+		std::vector<uint64_t> stringOffsets(strings.Size() + 1, 0);
+		for (uint32_t i = 0; i < strings.Size(); i++)
+		{
+			stringOffsets[i + 1] = stringOffsets[i] + strings.m_Strings[i].size();
+		}
+		header.stringBytesSize = stringOffsets.back();
+
+		std::vector<ColumnHeader> columns(m_Columns.size());
+		uint64_t offset = AlignUp(header.stringBytesOffset + header.stringBytesSize);
+		for (size_t i = 0; i < m_Columns.size(); i++)
+		{
+			columns[i].id             = m_Columns[i].id;
+			columns[i].count          = gathered[i].entities.size();
+			columns[i].recordSize     = m_Columns[i].recordSize;
+			columns[i].reserved       = 0;
+			columns[i].entitiesOffset = offset;
+			columns[i].recordsOffset  = AlignUp(offset + sizeof(uint32_t) * columns[i].count);
+
+			offset = AlignUp(columns[i].recordsOffset + gathered[i].records.size());
+		}
+
+		/**
+		* @brief Write.
+		*/
+		FileHandle f;
+		if (!FileLibrary::FileLibrary_Open(path.c_str(), FILE_MODE_WRITE, true, &f))
+		{
+			std::stringstream ss;
+			ss << "WorldSnapshot: Failed to open file: " << path;
+
+			SPICES_CORE_ERROR(ss.str());
+			return false;
+		}
+
+		Writer writer(&f);
+
+		writer.Write(&header, sizeof(Header));
+		writer.PadTo(header.columnsOffset);
+		writer.Write(columns.data(), sizeof(ColumnHeader) * columns.size());
+		writer.PadTo(header.stringsOffset);
+		writer.Write(stringOffsets.data(), sizeof(uint64_t) * stringOffsets.size());
+		writer.PadTo(header.stringBytesOffset);
+		for (const auto& str : strings.m_Strings)
+		{
+			writer.Write(str.data(), str.size());
+		}
+
+		for (size_t i = 0; i < columns.size(); i++)
+		{
+			writer.PadTo(columns[i].entitiesOffset);
+			writer.Write(gathered[i].entities.data(), sizeof(uint32_t) * gathered[i].entities.size());
+			writer.PadTo(columns[i].recordsOffset);
+			writer.Write(gathered[i].records.data(), gathered[i].records.size());
+		}
+		writer.PadTo(offset);
+
+		FileLibrary::FileLibrary_Close(&f);
+
+		if (!writer.IsSucceed())
+		{
+			std::stringstream ss;
+			ss << "WorldSnapshot: Failed to write file: " << path;
+
+			SPICES_CORE_ERROR(ss.str());
+			return false;
+		}
+
+		if (outStats)
+		{
+			*outStats          = Stats{};
+			outStats->entities = nEntities;
+			outStats->columns  = columns.size();
+			outStats->strings  = strings.Size();
+			outStats->bytes    = writer.GetOffset();
+
+			for (const auto& column : columns) outStats->components += column.count;
+		}
+
+		return true;
+	}
+
+	bool WorldSnapshot::Load(entt::registry& registry, const std::string& path, std::vector<entt::entity>* outEntities, Stats* outStats) const
+	{
+		SPICES_PROFILE_ZONE;
+
+		MappedFileHandle file;
+		if (!FileLibrary::FileLibrary_Map(path.c_str(), &file)) return false;
+
+		const auto isInFile = [&](uint64_t offset, uint64_t size) {
+			return offset <= file.size && size <= file.size - offset;
+		};
+
+		const auto fail = [&](const char* reason) {
+			FileLibrary::FileLibrary_UnMap(&file);
+
+			std::stringstream ss;
+			ss << "WorldSnapshot: " << path << " " << reason;
+
+			SPICES_CORE_ERROR(ss.str());
+			return false;
+		};
+
+		/**
+		* @brief Check header, column headers and strings.
+		*/
+		if (!isInFile(0, sizeof(Header))) return fail("is not a snapshot file.");
+
+		const Header* header = reinterpret_cast<const Header*>(file.data);
+		if (std::memcmp(header->magic, Magic, sizeof(Magic)) != 0) return fail("is not a snapshot file.");
+		if (header->version != Version)                            return fail("has a different version.");
+		if (header->entityCount > UINT32_MAX)                      return fail("has too many entities.");
+
+		if (header->columnsOffset % alignof(ColumnHeader) != 0 || header->stringsOffset % alignof(uint64_t) != 0 ||
+		    !isInFile(header->columnsOffset, sizeof(ColumnHeader) * uint64_t(header->columnCount)) ||
+		    !isInFile(header->stringsOffset, sizeof(uint64_t) * (uint64_t(header->stringCount) + 1)) ||
+		    !isInFile(header->stringBytesOffset, header->stringBytesSize))
+		{
+			return fail("is truncated.");
+		}
+
+		const ColumnHeader* columns       = reinterpret_cast<const ColumnHeader*>(file.data + header->columnsOffset);
+		const uint64_t*     stringOffsets = reinterpret_cast<const uint64_t*>(file.data + header->stringsOffset);
+		const char*         stringBytes   = file.data + header->stringBytesOffset;
+
+		StringTable strings;
+		strings.m_Strings.resize(header->stringCount);
+		for (uint32_t i = 0; i < header->stringCount; i++)
+		{
+			if (stringOffsets[i] > stringOffsets[i + 1] || stringOffsets[i + 1] > header->stringBytesSize) return fail("has invalid strings.");
+
+			strings.m_Strings[i] = std::string_view(stringBytes + stringOffsets[i], stringOffsets[i + 1] - stringOffsets[i]);
+		}
+
+		/**
+		* @brief Check columns before touching registry.
+		*/
+		std::vector<const Column*> matched(header->columnCount, nullptr);
+		for (uint32_t i = 0; i < header->columnCount; i++)
+		{
+			const ColumnHeader& column = columns[i];
+
+			if (column.entitiesOffset % alignof(uint32_t) != 0 || column.recordsOffset % Alignment != 0 ||
+			    !isInFile(column.entitiesOffset, sizeof(uint32_t) * column.count) ||
+			    column.count > header->entityCount ||
+			    !isInFile(column.recordsOffset, column.count * column.recordSize))
+			{
+				return fail("has invalid columns.");
+			}
+
+			for (const auto& c : m_Columns)
+			{
+				if (c.id == column.id && c.recordSize == column.recordSize) matched[i] = &c;
+			}
+			if (!matched[i]) continue;
+
+			const uint32_t* indices = reinterpret_cast<const uint32_t*>(file.data + column.entitiesOffset);
+			for (uint64_t j = 0; j < column.count; j++)
+			{
+				if (indices[j] >= header->entityCount) return fail("has invalid entity indices.");
+			}
+		}
+
+		/**
+		* @brief Create all entities at once, then insert columns.
+		*/
+		std::vector<entt::entity> entities(header->entityCount);
+		registry.create(entities.begin(), entities.end());
+
+		Stats stats;
+		stats.entities = header->entityCount;
+		stats.strings  = header->stringCount;
+		stats.bytes    = file.size;
+
+		std::vector<entt::entity> owners;
+		for (uint32_t i = 0; i < header->columnCount; i++)
+		{
+			const ColumnHeader& column = columns[i];
+
+			if (!matched[i])
+			{
+				++stats.skipped;
+				continue;
+			}
+
+			const uint32_t* indices = reinterpret_cast<const uint32_t*>(file.data + column.entitiesOffset);
+
+			owners.resize(column.count);
+			for (uint64_t j = 0; j < column.count; j++)
+			{
+				owners[j] = entities[indices[j]];
+			}
+
+			matched[i]->load(registry, owners.data(), column.count, file.data + column.recordsOffset, strings);
+
+			++stats.columns;
+			stats.components += column.count;
+		}
+
+		FileLibrary::FileLibrary_UnMap(&file);
+
+		if (outEntities) *outEntities = std::move(entities);
+		if (outStats)    *outStats    = stats;
+
+		return true;
+	}
+}
@@ -0,0 +1,329 @@
+/**
+* @file WorldSnapshot.h.
+* @brief The WorldSnapshot Class Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include "Core/Core.h"
+
+#include <entt.hpp>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace Spices {
+
+	/**
+	* @brief Binary snapshot of a entt registry.
+	* Each registered component type is written as one column: the entity indices owning it, then its records,
+	* both contiguous and aligned, so a column is loaded by creating all entities at once and bulk inserting records.
+	* Trivially copyable components are their own records and are inserted straight from the mapped file.
+	* Other components convert to a trivially copyable record, strings (names, asset references) are interned
+	* into a string table and referred by id.
+	* Layout: Header, ColumnHeader array, string offsets, string bytes, columns.
+	* Columns are matched by an id hashed from name and record size, columns not registered on load are skipped.
+	*/
+	class WorldSnapshot
+	{
+	public:
+
+		/**
+		* @brief Snapshot file sign.
+		*/
+		static constexpr char Magic[4] = { 'S', 'W', 'L', 'D' };
+
+		/**
+		* @brief Snapshot file version.
+		*/
+		static constexpr uint32_t Version = 1;
+
+		/**
+		* @brief Alignment of arrays in file.
+		*/
+		static constexpr uint64_t Alignment = 64;
+
+		/**
+		* @brief Snapshot file header.
+		*/
+		struct Header
+		{
+			char     magic[4];              /* @brief Magic.                          */
+			uint32_t version;               /* @brief Version.                        */
+			uint64_t entityCount;           /* @brief Count of entities.              */
+			uint32_t columnCount;           /* @brief Count of columns.               */
+			uint32_t stringCount;           /* @brief Count of strings.               */
+			uint64_t columnsOffset;         /* @brief Offset of ColumnHeader array.   */
+			uint64_t stringsOffset;         /* @brief Offset of string offsets.       */
+			uint64_t stringBytesOffset;     /* @brief Offset of string bytes.         */
+			uint64_t stringBytesSize;       /* @brief Bytes of strings.               */
+		};
+
+		/**
+		* @brief A component column.
+		*/
+		struct ColumnHeader
+		{
+			uint64_t id;                    /* @brief Hash of name and record size.   */
+			uint64_t count;                 /* @brief Count of components.            */
+			uint64_t entitiesOffset;        /* @brief Offset of entity indices.       */
+			uint64_t recordsOffset;         /* @brief Offset of records.              */
+			uint32_t recordSize;            /* @brief Bytes of a record.              */
+			uint32_t reserved;              /* @brief Reserved.                       */
+		};
+
+		/**
+		* @brief Interned strings, referred by id.
+		*/
+		class StringTable
+		{
+		public:
+
+			/**
+			* @brief Intern a string.
+			* @param[in] str The string.
+			* @return Returns the string id.
+			*/
+			uint32_t Intern(std::string_view str);
+
+			/**
+			* @brief Get a string.
+			* @param[in] id The string id.
+			* @return Returns the string, empty if id is invalid.
+			*/
+			std::string_view Get(uint32_t id) const { return id < m_Strings.size() ? m_Strings[id] : std::string_view(); }
+
+			/**
+			* @brief Get count of strings.
+			* @return Returns count of strings.
+			*/
+			uint32_t Size() const { return static_cast<uint32_t>(m_Strings.size()); }
+
+		private:
+
+			/**
+			* @brief Strings, view interned keys on save or the mapped file on load.
+			*/
+			std::vector<std::string_view> m_Strings;
+
+			/**
+			* @brief Interned strings, key: string, value: id.
+			*/
+			std::unordered_map<std::string, uint32_t> m_Ids;
+
+			/**
+			* @brief Allow WorldSnapshot access all data.
+			*/
+			friend class WorldSnapshot;
+		};
+
+		/**
+		* @brief Statistics of a Save or Load.
+		*/
+		struct Stats
+		{
+			uint64_t entities   = 0;    /* @brief Entities.                       */
+			uint64_t columns    = 0;    /* @brief Columns written or loaded.      */
+			uint64_t skipped    = 0;    /* @brief Columns not registered.         */
+			uint64_t components = 0;    /* @brief Components.                     */
+			uint64_t strings    = 0;    /* @brief Strings.                        */
+			uint64_t bytes      = 0;    /* @brief File bytes.                     */
+		};
+
+		/**
+		* @brief Converts a component to a record.
+		*/
+		template<typename T, typename Record>
+		using SaveFunc = std::function<Record(const T& component, StringTable& strings)>;
+
+		/**
+		* @brief Adds a component to entity from a record.
+		*/
+		template<typename Record>
+		using LoadFunc = std::function<void(entt::registry& registry, entt::entity entity, const Record& record, const StringTable& strings)>;
+
+	public:
+
+		/**
+		* @brief Constructor Function.
+		*/
+		WorldSnapshot() = default;
+
+		/**
+		* @brief Destructor Function.
+		*/
+		virtual ~WorldSnapshot() = default;
+
+		/**
+		* @brief Register a trivially copyable component, it is its own record.
+		* @tparam T Component type.
+		* @param[in] name Column name.
+		*/
+		template<typename T>
+		void Register(const std::string& name);
+
+		/**
+		* @brief Register a component converted to a trivially copyable record.
+		* @tparam T Component type.
+		* @tparam Record Record type.
+		* @param[in] name Column name.
+		* @param[in] save Converts a component to a record.
+		* @param[in] load Adds a component to entity from a record.
+		*/
+		template<typename T, typename Record>
+		void Register(const std::string& name, SaveFunc<T, Record> save, LoadFunc<Record> load);
+
+		/**
+		* @brief Write all entities and registered components of registry.
+		* @param[in] registry The registry.
+		* @param[in] path Snapshot file path.
+		* @param[out] outStats Statistics, may be nullptr.
+		* @return Returns true if succeed.
+		*/
+		bool Save(const entt::registry& registry, const std::string& path, Stats* outStats = nullptr) const;
+
+		/**
+		* @brief Map a snapshot file, create its entities in registry and insert registered components.
+		* @param[in] registry The registry.
+		* @param[in] path Snapshot file path.
+		* @param[out] outEntities Created entities in saved order, may be nullptr.
+		* @param[out] outStats Statistics, may be nullptr.
+		* @return Returns true if succeed.
+		*/
+		bool Load(entt::registry& registry, const std::string& path, std::vector<entt::entity>* outEntities = nullptr, Stats* outStats = nullptr) const;
+
+	private:
+
+		/**
+		* @brief A registered column.
+		*/
+		struct Column
+		{
+			/**
+			* @brief Append entity indices and records of a registry.
+			*/
+			using Save = std::function<void(
+				const entt::registry&           registry   ,
+				const std::vector<uint32_t>&    indices    ,
+				std::vector<uint32_t>&          outEntities,
+				std::vector<char>&              outRecords ,
+				StringTable&                    strings
+			)>;
+
+			/**
+			* @brief Insert records to entities.
+			*/
+			using Load = std::function<void(
+				entt::registry&                 registry   ,
+				const entt::entity*             entities   ,
+				uint64_t                        count      ,
+				const char*                     records    ,
+				const StringTable&              strings
+			)>;
+
+			std::string name;                   /* @brief Column name.                    */
+			uint64_t    id          = 0;        /* @brief Hash of name and record size.   */
+			uint32_t    recordSize  = 0;        /* @brief Bytes of a record.              */
+			Save        save;                   /* @brief Save function.                  */
+			Load        load;                   /* @brief Load function.                  */
+		};
+
+		/**
+		* @brief Add a column, replaces a column of the same name.
+		* @param[in] column The column.
+		*/
+		void AddColumn(Column&& column);
+
+	private:
+
+		/**
+		* @brief Registered columns.
+		*/
+		std::vector<Column> m_Columns;
+	};
+
+	template<typename T>
+	inline void WorldSnapshot::Register(const std::string& name)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Register<T> needs a trivially copyable component, use Register<T, Record> instead.");
+
+		Column column;
+		column.name       = name;
+		column.recordSize = std::is_empty_v<T> ? 0 : static_cast<uint32_t>(sizeof(T));
+
+		column.save = [](const entt::registry& registry, const std::vector<uint32_t>& indices, std::vector<uint32_t>& outEntities, std::vector<char>& outRecords, StringTable&) {
+			const auto* storage = registry.storage<T>();
+			if (!storage) return;
+
+			outEntities.reserve(storage->size());
+
+			if constexpr (std::is_empty_v<T>)
+			{
+				for (const auto entity : *storage)
+				{
+					outEntities.push_back(indices[entt::to_entity(entity)]);
+				}
+			}
+			else
+			{
+				outRecords.resize(storage->size() * sizeof(T));
+
+				T* records = reinterpret_cast<T*>(outRecords.data());
+				for (const auto [entity, component] : storage->each())
+				{
+					outEntities.push_back(indices[entt::to_entity(entity)]);
+					*records++ = component;
+				}
+			}
+		};
+
+		column.load = [](entt::registry& registry, const entt::entity* entities, uint64_t count, const char* records, const StringTable&) {
+			if constexpr (std::is_empty_v<T>)
+			{
+				registry.insert<T>(entities, entities + count);
+			}
+			else
+			{
+				registry.insert<T>(entities, entities + count, reinterpret_cast<const T*>(records));
+			}
+		};
+
+		AddColumn(std::move(column));
+	}
+
+	template<typename T, typename Record>
+	inline void WorldSnapshot::Register(const std::string& name, SaveFunc<T, Record> save, LoadFunc<Record> load)
+	{
+		static_assert(std::is_trivially_copyable_v<Record>, "Record must be trivially copyable.");
+		static_assert(alignof(Record) <= Alignment, "Record alignment is larger than snapshot alignment.");
+
+		Column column;
+		column.name       = name;
+		column.recordSize = static_cast<uint32_t>(sizeof(Record));
+
+		column.save = [save](const entt::registry& registry, const std::vector<uint32_t>& indices, std::vector<uint32_t>& outEntities, std::vector<char>& outRecords, StringTable& strings) {
+			const auto* storage = registry.storage<T>();
+			if (!storage) return;
+
+			outEntities.reserve(storage->size());
+			outRecords.resize(storage->size() * sizeof(Record));
+
+			Record* records = reinterpret_cast<Record*>(outRecords.data());
+			for (const auto [entity, component] : storage->each())
+			{
+				outEntities.push_back(indices[entt::to_entity(entity)]);
+				*records++ = save(component, strings);
+			}
+		};
+
+		column.load = [load](entt::registry& registry, const entt::entity* entities, uint64_t count, const char* records, const StringTable& strings) {
+			const Record* begin = reinterpret_cast<const Record*>(records);
+			for (uint64_t i = 0; i < count; i++)
+			{
+				load(registry, entities[i], begin[i], strings);
+			}
+		};
+
+		AddColumn(std::move(column));
+	}
+}
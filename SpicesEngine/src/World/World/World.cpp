@@ -7,6 +7,9 @@
 #include "Pchheader.h"
 #include "World.h"
 #include "World/Entity.h"
+#include "World/Snapshot/WorldSnapshot.h"
+#include "Resources/Mesh/MeshPack.h"
+#include "Resources/Material/Material.h"
 
 namespace Spices {
 
@@ -46,6 +49,11 @@ namespace Spices {
 	{
 		SPICES_PROFILE_ZONE;
 
+		if (m_Registry.all_of<MeshComponent>(entity))
+		{
+			MarkMeshChanged(static_cast<uint32_t>(entity));
+		}
+
 		m_Registry.destroy(entity);
 		m_EntityMap.erase(entity.GetUUID());
 	}
@@ -66,4 +74,190 @@ namespace Spices {
 			m_Marker ^= flags;
 		}
 	}
+
+	bool World::SaveSnapshot(const std::string& path)
+	{
+		SPICES_PROFILE_ZONE;
+
+		WorldSnapshot snapshot;
+		RegisterSnapshotComponents(snapshot);
+
+		WorldSnapshot::Stats stats;
+		if (!snapshot.Save(m_Registry, path, &stats)) return false;
+
+		std::stringstream ss;
+		ss << "World: Saved " << stats.entities << " entities, " << stats.components << " components to " << path;
+
+		SPICES_CORE_INFO(ss.str());
+
+		return true;
+	}
+
+	bool World::LoadSnapshot(const std::string& path)
+	{
+		SPICES_PROFILE_ZONE;
+
+		WorldSnapshot snapshot;
+		RegisterSnapshotComponents(snapshot);
+
+		WorldSnapshot::Stats stats;
+		if (!snapshot.Load(m_Registry, path, nullptr, &stats)) return false;
+
+		std::stringstream ss;
+		ss << "World: Loaded " << stats.entities << " entities, " << stats.components << " components from " << path;
+
+		SPICES_CORE_INFO(ss.str());
+
+		return true;
+	}
+
+	void World::RegisterSnapshotComponents(WorldSnapshot& snapshot)
+	{
+		SPICES_PROFILE_ZONE;
+
+		using Strings = WorldSnapshot::StringTable;
+
+		/**
+		* @brief UUID.
+		*/
+		snapshot.Register<UUIDComponent, uint64_t>("UUID",
+			[](const UUIDComponent& component, Strings&) {
+				return static_cast<uint64_t>(component.GetUUID());
+			},
+			[this](entt::registry&, entt::entity entity, const uint64_t& record, const Strings&) {
+				Entity e(entity, this);
+				e.AddComponent<UUIDComponent>().SetUUID(record);
+				m_EntityMap[UUID(record)] = entity;
+			}
+		);
+
+		/**
+		* @brief Transform.
+		*/
+		snapshot.Register<TransformComponent, Transform>("Transform",
+			[](const TransformComponent& component, Strings&) {
+				return Transform{ component.GetPosition(), component.GetRotation(), component.GetScale() };
+			},
+			[this](entt::registry&, entt::entity entity, const Transform& record, const Strings&) {
+				Entity e(entity, this);
+				auto& component = e.AddComponent<TransformComponent>();
+				component.SetPosition(record.position);
+				component.SetRotation(record.rotation);
+				component.SetScale(record.scale);
+			}
+		);
+
+		/**
+		* @brief Tag, tags are joined by line.
+		*/
+		snapshot.Register<TagComponent, uint32_t>("Tag",
+			[](const TagComponent& component, Strings& strings) {
+				std::string tags;
+				for (const auto& tag : component.GetTag())
+				{
+					if (!tags.empty()) tags += '\n';
+					tags += tag;
+				}
+				return strings.Intern(tags);
+			},
+			[this](entt::registry&, entt::entity entity, const uint32_t& record, const Strings& strings) {
+				Entity e(entity, this);
+				auto& component = e.AddComponent<TagComponent>();
+
+				std::string_view tags = strings.Get(record);
+				while (!tags.empty())
+				{
+					const size_t split = tags.find('\n');
+					component.AddTag(std::string(tags.substr(0, split)));
+					tags = split == std::string_view::npos ? std::string_view() : tags.substr(split + 1);
+				}
+			}
+		);
+
+		/**
+		* @brief Mesh, FilePacks are referred by name and material, one line per pack.
+		*/
+		snapshot.Register<MeshComponent, uint32_t>("Mesh",
+			[](const MeshComponent& component, Strings& strings) {
+				std::string packs;
+				if (auto mesh = component.GetMesh())
+				{
+					mesh->GetPacks().for_each([&](const uint32_t& k, const std::shared_ptr<MeshPack>& v) {
+						if (v->GetPackType() != "FilePack")
+						{
+							std::stringstream ss;
+							ss << "World: Snapshot skips " << v->GetPackType() << " " << v->GetName() << ", only FilePack is serializable.";
+
+							SPICES_CORE_WARN(ss.str());
+							return false;
+						}
+
+						packs += v->GetName() + '\t' + (v->GetMaterial() ? v->GetMaterial()->GetName() : std::string()) + '\n';
+						return false;
+					});
+				}
+				return strings.Intern(packs);
+			},
+			[this](entt::registry&, entt::entity entity, const uint32_t& record, const Strings& strings) {
+				Entity e(entity, this);
+				auto& component = e.AddComponent<MeshComponent>();
+
+				Mesh::Builder builder;
+				bool isEmpty = true;
+
+				std::string_view packs = strings.Get(record);
+				while (!packs.empty())
+				{
+					const size_t lineEnd = packs.find('\n');
+					const std::string_view line = packs.substr(0, lineEnd);
+					packs = lineEnd == std::string_view::npos ? std::string_view() : packs.substr(lineEnd + 1);
+
+					const size_t split = line.find('\t');
+					auto pack = std::make_shared<FilePack>(std::string(line.substr(0, split)));
+
+					if (split != std::string_view::npos && split + 1 < line.size())
+					{
+						pack->SetMaterial(std::string(line.substr(split + 1)));
+					}
+
+					builder.AddPack(pack);
+					isEmpty = false;
+				}
+
+				if (!isEmpty) component.SetMesh(builder.Build());
+			}
+		);
+
+		/**
+		* @brief DirectionalLight, rotation follows Transform.
+		*/
+		struct DirectionalLightRecord
+		{
+			glm::vec3 color;
+			float     intensity;
+		};
+
+		snapshot.Register<DirectionalLightComponent, DirectionalLightRecord>("DirectionalLight",
+			[](const DirectionalLightComponent& component, Strings&) {
+				return DirectionalLightRecord{ component.GetLight().color, component.GetLight().intensity };
+			},
+			[this](entt::registry&, entt::entity entity, const DirectionalLightRecord& record, const Strings&) {
+				Entity e(entity, this);
+				e.AddComponent<DirectionalLightComponent>(record.color, record.intensity);
+			}
+		);
+
+		/**
+		* @brief PointLight.
+		*/
+		snapshot.Register<PointLightComponent, SpicesShader::PointLight>("PointLight",
+			[](const PointLightComponent& component, Strings&) {
+				return component.GetLight();
+			},
+			[this](entt::registry&, entt::entity entity, const SpicesShader::PointLight& record, const Strings&) {
+				Entity e(entity, this);
+				e.AddComponent<PointLightComponent>(record);
+			}
+		);
+	}
 }
@@ -27,6 +27,7 @@ namespace Spices {
 	* Forward Declare
 	*/
 	class Entity;
+	class WorldSnapshot;
 
 	/**
 	* @brief World Class.
@@ -130,9 +131,48 @@ namespace Spices {
 		* @param[in] flags In flags.
 		*/
 		void ClearMarkerWithBits(WorldMarkFlags flags);
+
+		/**
+		* @brief Record an entity whose mesh is set or removed, and mark MeshAddedToWorld.
+		* @param[in] entity Entity id.
+		*/
+		void MarkMeshChanged(uint32_t entity) { m_MeshChanges.push_back(entity); Mark(MeshAddedToWorld); }
+
+		/**
+		* @brief Get entities whose mesh changed since last MeshAddedToWorld handled, may repeat.
+		* Empty if MeshAddedToWorld was marked without entities, listeners should walk the whole world.
+		* @return Returns entities ids.
+		*/
+		const std::vector<uint32_t>& GetMeshChanges() const { return m_MeshChanges; }
+
+		/**
+		* @brief Clear entities whose mesh changed, called after MeshAddedToWorld handled.
+		*/
+		void ClearMeshChanges() { m_MeshChanges.clear(); }
+
+		/**
+		* @brief Write all entities and their serializable components to a binary snapshot.
+		* Serialized: UUID, Transform, Tag, Mesh (FilePack names and materials), DirectionalLight, PointLight.
+		* @param[in] path Snapshot file path.
+		* @return Returns true if succeed.
+		*/
+		bool SaveSnapshot(const std::string& path);
+
+		/**
+		* @brief Map a binary snapshot and add its entities to this world.
+		* @param[in] path Snapshot file path.
+		* @return Returns true if succeed.
+		*/
+		bool LoadSnapshot(const std::string& path);
 		
 	private:
 
+		/**
+		* @brief Register serializable components to a snapshot.
+		* @param[in] snapshot WorldSnapshot.
+		*/
+		void RegisterSnapshotComponents(WorldSnapshot& snapshot);
+
 		/**
 		* @brief Called On any Component Added to this world.
 		* @param[in] entity Entity row pointer.
@@ -174,6 +214,11 @@ namespace Spices {
 		* @brief World State this frame.
 		*/
 		WorldMarkFlags m_Marker = WorldMarkBits::Clean;
+
+		/**
+		* @brief Entities whose mesh changed since last MeshAddedToWorld handled.
+		*/
+		std::vector<uint32_t> m_MeshChanges;
 	};
 
 	template<typename T>
@@ -0,0 +1,298 @@
+/**
+* @file BlockPool_test.h.
+* @brief The BlockPool_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Container/BlockPool.h>
+#include <Core/Container/KDTree.h>
+#include "Instrumentor.h"
+
+#include <random>
+#include <set>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for block_pool.
+	*/
+	class block_pool_test : public testing::Test
+	{
+	protected:
+
+		using tree       = scl::kd_tree<3>;
+		using pool_tree  = scl::kd_tree<3, scl::pool_allocator<std::array<float, 3>>>;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			std::mt19937 random(3);
+			std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+
+			m_Points.resize(20000);
+			for (auto& point : m_Points)
+			{
+				point = { distribution(random), distribution(random), distribution(random) };
+			}
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Points of kd_tree.
+		*/
+		std::vector<std::array<float, 3>> m_Points;
+	};
+
+	/**
+	* @brief Testing if blocks are aligned, unique and reused.
+	*/
+	TEST_F(block_pool_test, AllocateDeallocate) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::block_pool pool(24, 32, 64);
+
+		EXPECT_EQ(pool.block_size(),  32u);
+		EXPECT_EQ(pool.block_align(), 32u);
+
+		std::set<void*> blocks;
+		for (int i = 0; i < 1000; i++)
+		{
+			void* p = pool.allocate();
+
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 32, 0u);
+			EXPECT_TRUE(blocks.insert(p).second);
+		}
+
+		EXPECT_EQ(pool.size(), 1000u);
+
+		const size_t capacity = pool.capacity();
+		EXPECT_GE(capacity, 1000u);
+
+		for (void* p : blocks) pool.deallocate(p);
+		EXPECT_EQ(pool.size(), 0u);
+
+		/**
+		* @brief Freed blocks are reused, no page is added.
+		*/
+		std::set<void*> reused;
+		for (int i = 0; i < 1000; i++)
+		{
+			EXPECT_TRUE(reused.insert(pool.allocate()).second);
+		}
+
+		EXPECT_EQ(pool.size(),     1000u);
+		EXPECT_EQ(pool.capacity(), capacity);
+	}
+
+	/**
+	* @brief Testing if reset frees all blocks at once and keeps pages.
+	*/
+	TEST_F(block_pool_test, Reset) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::block_pool pool(16);
+
+		std::set<void*> blocks;
+		for (int i = 0; i < 500; i++) blocks.insert(pool.allocate());
+
+		const size_t pages = pool.page_count();
+
+		pool.reset();
+
+		EXPECT_EQ(pool.size(), 0u);
+		EXPECT_EQ(pool.page_count(), pages);
+
+		for (int i = 0; i < 500; i++)
+		{
+			EXPECT_EQ(blocks.count(pool.allocate()), 1u);
+		}
+
+		EXPECT_EQ(pool.page_count(), pages);
+
+		pool.release();
+
+		EXPECT_EQ(pool.page_count(), 0u);
+	}
+
+	/**
+	* @brief Testing if threads allocate and free concurrently, blocks freed by other threads.
+	*/
+	TEST_F(block_pool_test, MultiThread) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::block_pool pool(sizeof(uint64_t));
+
+		const int nThreads = 4;
+		const int nBlocks  = 10000;
+
+		std::vector<std::vector<uint64_t*>> blocks(nThreads);
+		std::vector<std::thread> threads;
+
+		for (int t = 0; t < nThreads; t++)
+		{
+			threads.emplace_back([&, t]() {
+				for (int i = 0; i < nBlocks; i++)
+				{
+					uint64_t* p = static_cast<uint64_t*>(pool.allocate());
+					*p = static_cast<uint64_t>(t) * nBlocks + i;
+					blocks[t].push_back(p);
+
+					if (i % 3 == 0)
+					{
+						pool.deallocate(blocks[t].back());
+						blocks[t].pop_back();
+					}
+				}
+			});
+		}
+		for (auto& thread : threads) thread.join();
+		threads.clear();
+
+		std::set<uint64_t*> unique;
+		for (int t = 0; t < nThreads; t++)
+		{
+			for (uint64_t* p : blocks[t])
+			{
+				EXPECT_TRUE(unique.insert(p).second);
+				EXPECT_EQ(*p / nBlocks, static_cast<uint64_t>(t));
+			}
+		}
+
+		EXPECT_EQ(pool.size(), unique.size());
+
+		/**
+		* @brief Free on other threads.
+		*/
+		for (int t = 0; t < nThreads; t++)
+		{
+			threads.emplace_back([&, t]() {
+				for (uint64_t* p : blocks[(t + 1) % nThreads]) pool.deallocate(p);
+			});
+		}
+		for (auto& thread : threads) thread.join();
+
+		EXPECT_EQ(pool.size(), 0u);
+	}
+
+	/**
+	* @brief Testing if kd_tree allocates nodes by pool_allocator.
+	*/
+	TEST_F(block_pool_test, KDTreeAllocator) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::block_pool pool(sizeof(pool_tree::Node), alignof(pool_tree::Node));
+
+		{
+			pool_tree kdTree{ scl::pool_allocator<pool_tree::item>(&pool) };
+			kdTree.insert(m_Points);
+
+			EXPECT_EQ(kdTree.size(), m_Points.size());
+			EXPECT_EQ(pool.size(),   m_Points.size());
+
+			for (int i = 0; i < 100; i++)
+			{
+				EXPECT_TRUE(kdTree.search(m_Points[i * 37]));
+			}
+		}
+
+		EXPECT_EQ(pool.size(), 0u);
+	}
+
+	/**
+	* @brief Benchmark of kd_tree build and destroy cycles, new and delete against block_pool.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(block_pool_test, DISABLED_Benchmark) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const int nCycles = 10;
+
+		auto time = [](auto&& func) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			func();
+			const auto end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<double, std::milli>(end - start).count();
+		};
+
+		/**
+		* @brief Node allocation only.
+		*/
+		const size_t nNodes = 100000;
+		std::vector<tree::Node*> nodes(nNodes);
+
+		const double newNodesMs = time([&]() {
+			for (int c = 0; c < nCycles; c++)
+			{
+				for (auto& node : nodes) node = new tree::Node(m_Points[0]);
+				for (auto& node : nodes) delete node;
+			}
+		});
+
+		scl::block_pool nodePool(sizeof(tree::Node), alignof(tree::Node));
+		scl::pool_allocator<tree::Node> nodeAllocator(&nodePool);
+
+		const double poolNodesMs = time([&]() {
+			for (int c = 0; c < nCycles; c++)
+			{
+				for (auto& node : nodes) node = new (nodeAllocator.allocate(1)) tree::Node(m_Points[0]);
+				for (auto& node : nodes) { node->~Node(); nodeAllocator.deallocate(node, 1); }
+			}
+		});
+
+		const double resetNodesMs = time([&]() {
+			for (int c = 0; c < nCycles; c++)
+			{
+				for (auto& node : nodes) node = new (nodeAllocator.allocate(1)) tree::Node(m_Points[0]);
+				nodePool.reset();
+			}
+		});
+
+		/**
+		* @brief Whole kd_tree build and destroy.
+		*/
+		size_t newSize = 0;
+		const double newTreeMs = time([&]() {
+			for (int c = 0; c < nCycles; c++)
+			{
+				std::srand(c);
+				tree kdTree;
+				kdTree.insert(m_Points);
+				newSize += kdTree.size();
+			}
+		});
+
+		scl::block_pool treePool(sizeof(pool_tree::Node), alignof(pool_tree::Node));
+
+		size_t poolSize = 0;
+		const double poolTreeMs = time([&]() {
+			for (int c = 0; c < nCycles; c++)
+			{
+				std::srand(c);
+				pool_tree kdTree{ scl::pool_allocator<pool_tree::item>(&treePool) };
+				kdTree.insert(m_Points);
+				poolSize += kdTree.size();
+			}
+		});
+
+		std::cout << "block_pool: " << nCycles << " cycles of " << nNodes << " nodes: new/delete " << newNodesMs << " ms, pool " << poolNodesMs << " ms, pool reset " << resetNodesMs << " ms." << std::endl;
+		std::cout << "block_pool: " << nCycles << " kd_tree builds of " << m_Points.size() << " points: new/delete " << newTreeMs << " ms, pool " << poolTreeMs << " ms." << std::endl;
+
+		EXPECT_EQ(newSize, poolSize);
+		EXPECT_EQ(treePool.size(), 0u);
+		EXPECT_EQ(treePool.page_count() * 256, treePool.capacity());
+	}
+}
@@ -118,4 +118,33 @@ namespace SpicesTest {
 		*/
 		EXPECT_EQ(m_Nodes.size(), 3);
 	}
+
+	/**
+	* @brief Testing if nodes owned by graph are created by node allocator and executed.
+	*/
+	TEST_F(directed_acyclic_graph_test, EmplaceNode) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::block_pool pool(sizeof(scl::directed_acyclic_node), alignof(scl::directed_acyclic_node));
+
+		std::vector<std::string> order;
+
+		{
+			scl::directed_acyclic_graph dag{ scl::pool_allocator<scl::directed_acyclic_node>(&pool) };
+
+			dag.emplace_node("A", { "C" }, [&]() { order.push_back("A"); });
+			dag.emplace_node("B", { "A" }, [&]() { order.push_back("B"); });
+			dag.emplace_node("C", {},      [&]() { order.push_back("C"); });
+
+			EXPECT_EQ(dag.size(),  3);
+			EXPECT_EQ(pool.size(), 3u);
+
+			dag.execute();
+		}
+
+		EXPECT_EQ(pool.size(), 0u);
+		EXPECT_LT(std::find(order.begin(), order.end(), "C"), std::find(order.begin(), order.end(), "A"));
+		EXPECT_LT(std::find(order.begin(), order.end(), "A"), std::find(order.begin(), order.end(), "B"));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,255 @@
+/**
+* @file RuntimeMemoryLayout_test.h.
+* @brief The RuntimeMemoryLayout_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Container/RuntimeMemoryLayout.h>
+#include <Core/Container/RuntimeMemoryBlock.h>
+#include "Instrumentor.h"
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for runtime_memory_layout.
+	* Expected offsets are the GLSL MaterialParameter structs, read by buffer_reference with scalar layout.
+	*/
+	class runtime_memory_layout_test : public testing::Test
+	{
+	protected:
+
+		using field_type = scl::memory_field_type;
+		using rule       = scl::memory_layout_rule;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Compile fields of Shader.ViewportGridRenderer.ViewportGrid.Default.frag.
+		* @param[in] layoutRule The layout rule.
+		* @return Returns the layout.
+		*/
+		static std::shared_ptr<const scl::runtime_memory_layout> ViewportGrid(rule layoutRule)
+		{
+			scl::runtime_memory_layout_compiler compiler(layoutRule);
+
+			compiler.add("axisSpacing",           "float" );
+			compiler.add("gridViewAdaptionRatio", "float" );
+			compiler.add("fontSize",              "float2");
+			compiler.add("gridWidthScale",        "float" );
+			compiler.add("gridColor",             "float3");
+			compiler.add("viewFade",              "float" );
+			compiler.add("upFade",                "float" );
+			compiler.add("xAxisColor",            "float3");
+			compiler.add("yAxisColor",            "float3");
+			compiler.add("enable",                "bool"  );
+
+			return compiler.compile();
+		}
+
+		/**
+		* @brief Get offsets of all fields.
+		* @param[in] layout The layout.
+		* @return Returns offsets.
+		*/
+		static std::vector<uint32_t> Offsets(const scl::runtime_memory_layout& layout)
+		{
+			std::vector<uint32_t> offsets;
+			for (const auto& field : layout.fields()) offsets.push_back(field.offset);
+
+			return offsets;
+		}
+	};
+
+	/**
+	* @brief Testing if layout matches Shader.BasePassRenderer.Mesh.PBRConstParameter.frag.
+	*/
+	TEST_F(runtime_memory_layout_test, PBRConstParameter) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief vec3 albedo; float roughness; float metallic; int maxRayDepth; int maxLightDepth; int maxShadowDepth;
+		*/
+		scl::runtime_memory_layout_compiler compiler;
+
+		EXPECT_TRUE(compiler.add("albedo",         "float3"));
+		EXPECT_TRUE(compiler.add("roughness",      "float" ));
+		EXPECT_TRUE(compiler.add("metallic",       "float" ));
+		EXPECT_TRUE(compiler.add("maxRayDepth",    "int"   ));
+		EXPECT_TRUE(compiler.add("maxLightDepth",  "int"   ));
+		EXPECT_TRUE(compiler.add("maxShadowDepth", "int"   ));
+
+		auto layout = compiler.compile();
+
+		EXPECT_EQ(layout->size(),  6u);
+		EXPECT_EQ(layout->bytes(), 32u);
+		EXPECT_EQ(Offsets(*layout), std::vector<uint32_t>({ 0, 12, 16, 20, 24, 28 }));
+
+		EXPECT_EQ(layout->field(0).type, field_type::Float3);
+		EXPECT_EQ(layout->field(0).size, 12u);
+		EXPECT_EQ(layout->find("maxRayDepth"), 3u);
+		EXPECT_EQ(layout->find("emission"),    scl::runtime_memory_layout::npos);
+	}
+
+	/**
+	* @brief Testing if layout matches Shader.BasePassRenderer.Mesh.PBRTexture.frag, texture indices first.
+	*/
+	TEST_F(runtime_memory_layout_test, PBRTexture) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::runtime_memory_layout_compiler compiler;
+
+		compiler.add("albedoTexture",    field_type::UInt);
+		compiler.add("normalTexture",    field_type::UInt);
+		compiler.add("roughnessTexture", field_type::UInt);
+		compiler.add("metallicTexture",  field_type::UInt);
+		compiler.add("maxRayDepth",      "int");
+		compiler.add("maxLightDepth",    "int");
+		compiler.add("maxShadowDepth",   "int");
+
+		auto layout = compiler.compile();
+
+		EXPECT_EQ(layout->bytes(), 28u);
+		EXPECT_EQ(Offsets(*layout), std::vector<uint32_t>({ 0, 4, 8, 12, 16, 20, 24 }));
+	}
+
+	/**
+	* @brief Testing if layout matches Shader.ViewportGridRenderer.ViewportGrid.Default.frag with scalar and std430.
+	*/
+	TEST_F(runtime_memory_layout_test, ViewportGrid) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief Scalar, vec3 is packed and bool is 4 bytes.
+		*/
+		auto scalar = ViewportGrid(rule::Scalar);
+
+		EXPECT_EQ(Offsets(*scalar), std::vector<uint32_t>({ 0, 4, 8, 16, 20, 32, 36, 40, 52, 64 }));
+		EXPECT_EQ(scalar->bytes(),     68u);
+		EXPECT_EQ(scalar->alignment(), 4u);
+
+		/**
+		* @brief std430, vec2 aligns to 8, vec3 aligns to 16, struct pads to 16.
+		*/
+		auto std430 = ViewportGrid(rule::Std430);
+
+		EXPECT_EQ(Offsets(*std430), std::vector<uint32_t>({ 0, 4, 8, 16, 32, 44, 48, 64, 80, 92 }));
+		EXPECT_EQ(std430->bytes(),     96u);
+		EXPECT_EQ(std430->alignment(), 16u);
+		EXPECT_EQ(std430->rule(),      rule::Std430);
+	}
+
+	/**
+	* @brief Testing if invalid fields are rejected.
+	*/
+	TEST_F(runtime_memory_layout_test, InvalidField) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::runtime_memory_layout_compiler compiler;
+
+		EXPECT_TRUE (compiler.add("a", "float"   ));
+		EXPECT_FALSE(compiler.add("a", "float2"  ));
+		EXPECT_FALSE(compiler.add("b", "float4x4"));
+
+		EXPECT_EQ(compiler.compile()->size(), 1u);
+	}
+
+	/**
+	* @brief Testing if same fields compile to one shared layout.
+	*/
+	TEST_F(runtime_memory_layout_test, SharedLayout) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const size_t cached = scl::runtime_memory_layout_compiler::cache_size();
+
+		{
+			auto a = ViewportGrid(rule::Scalar);
+			auto b = ViewportGrid(rule::Scalar);
+			auto c = ViewportGrid(rule::Std430);
+
+			EXPECT_EQ(a, b);
+			EXPECT_NE(a, c);
+			EXPECT_EQ(scl::runtime_memory_layout_compiler::cache_size(), cached + 2);
+		}
+
+		/**
+		* @brief Layouts are released with last user.
+		*/
+		EXPECT_EQ(scl::runtime_memory_layout_compiler::cache_size(), cached);
+	}
+
+	/**
+	* @brief Testing if runtime_memory_block is written by field index.
+	*/
+	TEST_F(runtime_memory_layout_test, IndexedWrite) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::runtime_memory_block block(ViewportGrid(rule::Scalar));
+
+		EXPECT_EQ(block.get_bytes(), 68u);
+		EXPECT_EQ(block.size(),      10u);
+		EXPECT_NE(block.get_addr(),  nullptr);
+
+		/**
+		* @brief Zeroed after build.
+		*/
+		EXPECT_EQ(block.get_value<glm::vec3>(4), glm::vec3(0.0f));
+
+		block.set_value(2, glm::vec2(8.0f, 15.0f));
+		block.set_value(4, glm::vec3(0.2f));
+		block.set_value(9, static_cast<uint32_t>(true));
+
+		const char* data = static_cast<const char*>(block.get_addr());
+
+		EXPECT_EQ(*reinterpret_cast<const glm::vec2*>(data + 8),  glm::vec2(8.0f, 15.0f));
+		EXPECT_EQ(*reinterpret_cast<const glm::vec3*>(data + 20), glm::vec3(0.2f));
+		EXPECT_EQ(*reinterpret_cast<const uint32_t*>(data + 64), 1u);
+
+		/**
+		* @brief By name access is kept.
+		*/
+		EXPECT_EQ(block.item_location("gridColor"), 20u);
+		EXPECT_EQ(block.get_value<glm::vec3>("gridColor"), glm::vec3(0.2f));
+
+		/**
+		* @brief Wrong bytes or index throws, layout is immutable.
+		*/
+		EXPECT_THROW(block.set_value(4, 1.0f), std::runtime_error);
+		EXPECT_THROW(block.set_value(10, 1.0f), std::runtime_error);
+
+		block.add_element("extra", "float");
+		EXPECT_EQ(block.size(), 10u);
+	}
+
+	/**
+	* @brief Testing if add_element places bool with 4 bytes as GLSL.
+	*/
+	TEST_F(runtime_memory_layout_test, AddElementBool) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::runtime_memory_block block;
+
+		block.add_element("enable", "bool");
+		block.add_element("scale",  "float");
+
+		EXPECT_EQ(block.item_location("scale"), 4u);
+		EXPECT_EQ(block.get_bytes(),            8u);
+	}
+}
@@ -0,0 +1,253 @@
+/**
+* @file TLSFAllocator_test.h.
+* @brief The TLSFAllocator_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Container/TLSFAllocator.h>
+#include "Instrumentor.h"
+
+#include <random>
+#include <map>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for tlsf_allocator.
+	*/
+	class tlsf_allocator_test : public testing::Test
+	{
+	protected:
+
+		using allocation = scl::tlsf_allocator::allocation;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Check live allocations are aligned, inside the range and not overlapped.
+		* @param[in] allocator The allocator.
+		* @param[in] live Live allocations, key: offset.
+		*/
+		static void Validate(const scl::tlsf_allocator& allocator, const std::map<uint32_t, allocation>& live)
+		{
+			uint32_t end  = 0;
+			uint32_t used = 0;
+
+			for (const auto& [offset, alloc] : live)
+			{
+				const uint32_t size = allocator.allocation_size(alloc);
+
+				ASSERT_EQ(offset % allocator.granularity(), 0u);
+				ASSERT_GE(offset, end);
+				ASSERT_LE(offset + size, allocator.capacity());
+
+				end   = offset + size;
+				used += size;
+			}
+
+			ASSERT_EQ(allocator.used(),             used);
+			ASSERT_EQ(allocator.allocation_count(), live.size());
+		}
+	};
+
+	/**
+	* @brief Testing if allocations are aligned and packed.
+	*/
+	TEST_F(tlsf_allocator_test, Allocate) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::tlsf_allocator allocator(1024, 16);
+
+		EXPECT_EQ(allocator.capacity(),           1024u);
+		EXPECT_EQ(allocator.free_block_count(),   1u);
+		EXPECT_EQ(allocator.largest_free_block(), 1024u);
+
+		const allocation a = allocator.allocate(1);
+		const allocation b = allocator.allocate(32);
+		const allocation c = allocator.allocate(40);
+
+		EXPECT_EQ(a.offset, 0u);
+		EXPECT_EQ(b.offset, 16u);
+		EXPECT_EQ(c.offset, 48u);
+
+		EXPECT_EQ(allocator.allocation_size(a), 16u);
+		EXPECT_EQ(allocator.allocation_size(c), 48u);
+		EXPECT_EQ(allocator.used(),             96u);
+
+		/**
+		* @brief Too large fails.
+		*/
+		EXPECT_FALSE(allocator.allocate(1024).valid());
+		EXPECT_TRUE (allocator.allocate(1024 - 96).valid());
+		EXPECT_FALSE(allocator.allocate(1).valid());
+		EXPECT_EQ(allocator.free_block_count(), 0u);
+	}
+
+	/**
+	* @brief Testing if freed blocks merge with free neighbours.
+	*/
+	TEST_F(tlsf_allocator_test, Merge) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::tlsf_allocator allocator(4096, 16);
+
+		std::vector<allocation> allocs;
+		for (int i = 0; i < 8; i++) allocs.push_back(allocator.allocate(64));
+
+		/**
+		* @brief Holes do not merge.
+		*/
+		allocator.free(allocs[1]);
+		allocator.free(allocs[3]);
+		EXPECT_EQ(allocator.free_block_count(), 3u);
+
+		/**
+		* @brief Left and right merge.
+		*/
+		allocator.free(allocs[2]);
+		EXPECT_EQ(allocator.free_block_count(), 2u);
+
+		const allocation merged = allocator.allocate(192);
+		EXPECT_EQ(merged.offset, allocs[1].offset);
+
+		allocator.free(merged);
+		for (int i : { 0, 4, 5, 6, 7 }) allocator.free(allocs[i]);
+
+		EXPECT_EQ(allocator.free_block_count(),   1u);
+		EXPECT_EQ(allocator.largest_free_block(), 4096u);
+		EXPECT_EQ(allocator.used(),               0u);
+	}
+
+	/**
+	* @brief Testing if reset frees all at once.
+	*/
+	TEST_F(tlsf_allocator_test, Reset) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		scl::tlsf_allocator allocator(1 << 20, 256);
+
+		for (int i = 0; i < 100; i++) allocator.allocate(1000);
+		EXPECT_EQ(allocator.allocation_count(), 100u);
+
+		allocator.reset();
+
+		EXPECT_EQ(allocator.allocation_count(),   0u);
+		EXPECT_EQ(allocator.free_block_count(),   1u);
+		EXPECT_EQ(allocator.largest_free_block(), 1u << 20);
+	}
+
+	/**
+	* @brief Random allocate and free, checked against a shadow map.
+	*/
+	TEST_F(tlsf_allocator_test, Fuzz) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (uint32_t seed = 0; seed < 8; seed++)
+		{
+			std::mt19937 random(seed);
+
+			const uint32_t granularity = 1u << (random() % 6 + 2);
+			const uint32_t capacity    = (random() % 64 + 1) * 4096;
+
+			scl::tlsf_allocator allocator(capacity, granularity);
+			std::map<uint32_t, allocation> live;
+
+			std::uniform_int_distribution<uint32_t> smallSize(1, 256);
+			std::uniform_int_distribution<uint32_t> largeSize(1, capacity / 4);
+
+			for (int step = 0; step < 20000; step++)
+			{
+				const bool doAllocate = live.empty() || random() % 100 < 55;
+
+				if (doAllocate)
+				{
+					const uint32_t bytes = random() % 10 ? smallSize(random) : largeSize(random);
+					const allocation alloc = allocator.allocate(bytes);
+
+					if (!alloc.valid())
+					{
+						/**
+						* @brief Fails only if no free block fits.
+						*/
+						ASSERT_LT(allocator.largest_free_block(), (bytes + granularity - 1) / granularity * granularity);
+						continue;
+					}
+
+					ASSERT_GE(allocator.allocation_size(alloc), bytes);
+					ASSERT_TRUE(live.emplace(alloc.offset, alloc).second);
+				}
+				else
+				{
+					auto it = live.begin();
+					std::advance(it, random() % live.size());
+
+					allocator.free(it->second);
+					live.erase(it);
+				}
+
+				if (step % 97 == 0) Validate(allocator, live);
+			}
+
+			Validate(allocator, live);
+
+			for (const auto& [offset, alloc] : live) allocator.free(alloc);
+
+			EXPECT_EQ(allocator.used(),               0u);
+			EXPECT_EQ(allocator.free_block_count(),   1u);
+			EXPECT_EQ(allocator.largest_free_block(), capacity);
+		}
+	}
+
+	/**
+	* @brief Testing if a request succeeds exactly when a large enough free block exists.
+	*/
+	TEST_F(tlsf_allocator_test, GoodFit) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::mt19937 random(7);
+
+		scl::tlsf_allocator allocator(1 << 16, 16);
+		std::vector<allocation> live;
+
+		for (int step = 0; step < 5000; step++)
+		{
+			if (live.empty() || random() % 2)
+			{
+				const uint32_t bytes = random() % 2048 + 1;
+
+				/**
+				* @brief Bins above the request are searched first, then the bin of the request itself.
+				*/
+				const uint32_t largest = allocator.largest_free_block();
+				const allocation alloc = allocator.allocate(bytes);
+
+				EXPECT_EQ(alloc.valid(), largest >= (bytes + 15) / 16 * 16);
+				if (alloc.valid()) live.push_back(alloc);
+			}
+			else
+			{
+				const size_t i = random() % live.size();
+
+				allocator.free(live[i]);
+				live[i] = live.back();
+				live.pop_back();
+			}
+		}
+	}
+}
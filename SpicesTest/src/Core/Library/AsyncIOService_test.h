@@ -0,0 +1,369 @@
+/**
+* @file AsyncIOService_test.h.
+* @brief The AsyncIOService_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Library/AsyncIOService.h>
+#include <Core/Library/FileLibrary.h>
+#include <Core/Thread/ThreadPool.h>
+#include <Core/Thread/Latch.h>
+#include "Instrumentor.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for AsyncIOService.
+	*/
+	class AsyncIOService_test : public testing::Test
+	{
+	protected:
+
+		using IO = Spices::AsyncIOService;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override
+		{
+			m_Root = (std::filesystem::temp_directory_path() / "SpicesAsyncIOServiceTest").generic_string() + "/";
+			std::filesystem::remove_all(m_Root);
+			std::filesystem::create_directories(m_Root);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override
+		{
+			m_IO.Stop();
+			std::filesystem::remove_all(m_Root);
+		}
+
+		/**
+		* @brief Create a file of deterministic bytes.
+		* @param[in] name File name.
+		* @param[in] size File size.
+		* @return Returns the file path.
+		*/
+		std::string WriteFile(const std::string& name, uint64_t size)
+		{
+			std::string data(size, '\0');
+			for (uint64_t i = 0; i < size; i++)
+			{
+				data[i] = static_cast<char>((i * 131 + name.size()) & 0xFF);
+			}
+
+			const std::string path = m_Root + name;
+			std::ofstream(path, std::ios::binary) << data;
+			m_Files[path] = std::move(data);
+
+			return path;
+		}
+
+		/**
+		* @brief Read files with FileLibrary on this thread.
+		* @param[in] paths Files.
+		* @return Returns read bytes.
+		*/
+		static uint64_t ReadSync(const std::vector<std::string>& paths)
+		{
+			uint64_t bytes = 0;
+
+			for (const auto& path : paths)
+			{
+				Spices::FileHandle f;
+				EXPECT_TRUE(Spices::FileLibrary::FileLibrary_Open(path.c_str(), Spices::FILE_MODE_READ, true, &f));
+
+				uint64_t size = 0;
+				EXPECT_TRUE(Spices::FileLibrary::FileLibrary_Size(&f, &size));
+
+				std::vector<char> data(size);
+				uint64_t readed = 0;
+				EXPECT_TRUE(size == 0 || Spices::FileLibrary::FileLibrary_Read(&f, size, data.data(), &readed));
+
+				Spices::FileLibrary::FileLibrary_Close(&f);
+
+				bytes += size;
+			}
+
+			return bytes;
+		}
+
+		/**
+		* @brief Read files with the service.
+		* @param[in] paths Files.
+		* @return Returns read bytes.
+		*/
+		uint64_t ReadAsync(const std::vector<std::string>& paths)
+		{
+			std::atomic<uint64_t> bytes = 0;
+
+			std::vector<Spices::IORequest> requests(paths.size());
+			for (size_t i = 0; i < paths.size(); i++)
+			{
+				requests[i].path     = paths[i];
+				requests[i].callback = [&](Spices::IOResult& result) {
+					EXPECT_TRUE(result.isSucceed);
+					bytes += result.data.size();
+				};
+			}
+
+			m_IO.Submit(requests);
+			m_IO.Wait();
+
+			return bytes;
+		}
+
+		std::string m_Root;                                 /* @brief Temp folder.                 */
+		std::map<std::string, std::string> m_Files;         /* @brief Written files, key: path.    */
+		IO m_IO;                                            /* @brief Tested service.              */
+	};
+
+	/**
+	* @brief Testing whole file and ranged reads on both backends.
+	*/
+	TEST_F(AsyncIOService_test, Read) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string large = WriteFile("Large.bin", 3 * 1024 * 1024 + 7);
+		const std::string small = WriteFile("Small.bin", 100);
+		const std::string empty = WriteFile("Empty.bin", 0);
+
+		for (const bool isUseIoUring : { false, true })
+		{
+			m_IO.Start(2, nullptr, isUseIoUring);
+
+			std::mutex mutex;
+			std::map<std::string, Spices::IOResult> results;
+
+			const auto submit = [&](const std::string& name, const std::string& path, uint64_t offset, uint64_t size) {
+				Spices::IORequest request;
+				request.path     = path;
+				request.offset   = offset;
+				request.size     = size;
+				request.callback = [&, name](Spices::IOResult& result) {
+					std::unique_lock<std::mutex> lock(mutex);
+					results[name] = std::move(result);
+				};
+
+				m_IO.Submit(std::move(request));
+			};
+
+			submit("Large",     large,            0,        Spices::IORequest::WholeFile);
+			submit("Range",     large,            1000,     5000                        );
+			submit("Tail",      large,            1 << 20,  Spices::IORequest::WholeFile);
+			submit("Small",     small,            0,        Spices::IORequest::WholeFile);
+			submit("Empty",     empty,            0,        Spices::IORequest::WholeFile);
+			submit("PastEnd",   small,            90,       20                          );
+			submit("None",      m_Root + "None",  0,        Spices::IORequest::WholeFile);
+
+			m_IO.Wait();
+
+			const std::string& bytes = m_Files[large];
+
+			EXPECT_TRUE(results["Large"].isSucceed);
+			EXPECT_TRUE(std::string(results["Large"].data.begin(), results["Large"].data.end()) == bytes);
+			EXPECT_TRUE(results["Range"].isSucceed);
+			EXPECT_TRUE(std::string(results["Range"].data.begin(), results["Range"].data.end()) == bytes.substr(1000, 5000));
+			EXPECT_EQ  (results["Range"].offset, 1000);
+			EXPECT_TRUE(std::string(results["Tail"].data.begin(), results["Tail"].data.end()) == bytes.substr(1 << 20));
+			EXPECT_EQ  (std::string(results["Small"].data.begin(), results["Small"].data.end()), m_Files[small]);
+			EXPECT_TRUE(results["Empty"].isSucceed);
+			EXPECT_TRUE(results["Empty"].data.empty());
+			EXPECT_FALSE(results["PastEnd"].isSucceed);
+			EXPECT_FALSE(results["None"].isSucceed);
+
+			const IO::Stats stats = m_IO.GetStats();
+			EXPECT_EQ(stats.submitted, stats.completed + stats.failed);
+
+			m_IO.Stop();
+		}
+	}
+
+	/**
+	* @brief Testing high priority requests are read first.
+	*/
+	TEST_F(AsyncIOService_test, Priority) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string path = WriteFile("Small.bin", 16);
+
+		m_IO.Start(1, nullptr, false);
+
+		/**
+		* @brief Block the only IO thread in a callback while requests are queued.
+		*/
+		Spices::Latch blocked(1);
+		Spices::Latch release(1);
+
+		Spices::IORequest blocker;
+		blocker.path     = path;
+		blocker.callback = [&](Spices::IOResult&) {
+			blocked.CountDown();
+			release.Wait();
+		};
+		m_IO.Submit(std::move(blocker));
+		blocked.Wait();
+
+		std::vector<Spices::IOPriority> order;
+
+		std::vector<Spices::IORequest> requests;
+		for (const auto priority : { Spices::IOPriority::Low, Spices::IOPriority::Normal, Spices::IOPriority::High, Spices::IOPriority::Low, Spices::IOPriority::High })
+		{
+			Spices::IORequest request;
+			request.path     = path;
+			request.priority = priority;
+			request.callback = [&order, priority](Spices::IOResult&) { order.push_back(priority); };
+
+			requests.push_back(std::move(request));
+		}
+		m_IO.Submit(requests);
+
+		release.CountDown();
+		m_IO.Wait();
+
+		EXPECT_THAT(order, testing::ElementsAre(
+			Spices::IOPriority::High   ,
+			Spices::IOPriority::High   ,
+			Spices::IOPriority::Normal ,
+			Spices::IOPriority::Low    ,
+			Spices::IOPriority::Low
+		));
+	}
+
+	/**
+	* @brief Testing callbacks on a ThreadPool, and reads on calling thread if not running.
+	*/
+	TEST_F(AsyncIOService_test, Completion) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string path = WriteFile("Small.bin", 64);
+
+		/**
+		* @brief Not running.
+		*/
+		{
+			std::thread::id id;
+
+			Spices::IORequest request;
+			request.path     = path;
+			request.callback = [&](Spices::IOResult&) { id = std::this_thread::get_id(); };
+			m_IO.Submit(std::move(request));
+
+			EXPECT_EQ(id, std::this_thread::get_id());
+		}
+
+		Spices::ThreadPool pool;
+		pool.SetMode(Spices::PoolMode::MODE_FIXED);
+		pool.Start(2);
+
+		m_IO.Start(1, &pool);
+
+		const std::thread::id caller = std::this_thread::get_id();
+
+		std::atomic<uint32_t> count      = 0;
+		std::atomic<bool>     isOnCaller = false;
+
+		for (int i = 0; i < 100; i++)
+		{
+			Spices::IORequest request;
+			request.path     = path;
+			request.callback = [&](Spices::IOResult& result) {
+				EXPECT_EQ(result.data.size(), 64);
+				if (std::this_thread::get_id() == caller) isOnCaller = true;
+				++count;
+			};
+			m_IO.Submit(std::move(request));
+		}
+
+		m_IO.Wait();
+		EXPECT_EQ(count, 100);
+		EXPECT_FALSE(isOnCaller);
+
+		m_IO.Stop();
+	}
+
+	/**
+	* @brief Testing FileLibrary_Size and FileLibrary_Seek.
+	*/
+	TEST_F(AsyncIOService_test, FileLibrary) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string path = WriteFile("Small.bin", 1000);
+
+		Spices::FileHandle f;
+		EXPECT_TRUE(Spices::FileLibrary::FileLibrary_Open(path.c_str(), Spices::FILE_MODE_READ, true, &f));
+
+		uint64_t size = 0;
+		EXPECT_TRUE(Spices::FileLibrary::FileLibrary_Size(&f, &size));
+		EXPECT_EQ(size, 1000);
+
+		char data[10] = {};
+		uint64_t readed = 0;
+		EXPECT_TRUE(Spices::FileLibrary::FileLibrary_Seek(&f, 990));
+		EXPECT_TRUE(Spices::FileLibrary::FileLibrary_Read(&f, 10, data, &readed));
+		EXPECT_EQ(std::string(data, 10), m_Files[path].substr(990));
+		EXPECT_FALSE(Spices::FileLibrary::FileLibrary_Read(&f, 1, data, &readed));
+
+		Spices::FileLibrary::FileLibrary_Close(&f);
+	}
+
+	/**
+	* @brief Throughput of many small files and few large files, FileLibrary on one thread against the service.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(AsyncIOService_test, DISABLED_Throughput) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::vector<std::string> smalls;
+		for (int i = 0; i < 1024; i++)
+		{
+			smalls.push_back(WriteFile("Small" + std::to_string(i) + ".bin", 4 * 1024));
+		}
+
+		std::vector<std::string> larges;
+		for (int i = 0; i < 4; i++)
+		{
+			larges.push_back(WriteFile("Large" + std::to_string(i) + ".bin", 16 * 1024 * 1024));
+		}
+
+		for (const auto* paths : { &smalls, &larges })
+		{
+			const uint64_t bytes = paths->size() * m_Files[paths->front()].size();
+
+			const auto run = [&](const char* name, const std::function<uint64_t()>& func) {
+				const auto start = std::chrono::high_resolution_clock::now();
+				EXPECT_EQ(func(), bytes);
+				const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+				std::cout << "AsyncIOService " << name << ": " << paths->size() << " files, " << ms << " ms, "
+				          << bytes / (1024.0 * 1024.0) / (ms / 1000.0) << " MB/s." << std::endl;
+			};
+
+			run("FileLibrary", [&]() { return ReadSync(*paths); });
+
+			m_IO.Start(4, nullptr, false);
+			run("IO threads", [&]() { return ReadAsync(*paths); });
+			m_IO.Stop();
+
+			m_IO.Start(4, nullptr, true);
+			if (m_IO.GetBackend() == IO::Backend::IoUring)
+			{
+				run("io_uring", [&]() { return ReadAsync(*paths); });
+			}
+			m_IO.Stop();
+		}
+	}
+}
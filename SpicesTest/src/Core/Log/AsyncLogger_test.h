@@ -0,0 +1,369 @@
+/**
+* @file AsyncLogger_test.h.
+* @brief The AsyncLogger_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Log/AsyncLogger.h>
+#include "Instrumentor.h"
+
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <chrono>
+#include <filesystem>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Sink collecting records.
+	*/
+	class CollectSink : public spdlog::sinks::base_sink<std::mutex>
+	{
+	public:
+
+		/**
+		* @brief A collected record.
+		*/
+		struct Item
+		{
+			std::string               logger;
+			spdlog::level::level_enum level;
+			std::string               payload;
+		};
+
+		/**
+		* @brief Get collected records.
+		* @return Returns records.
+		*/
+		std::vector<Item> Items()
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			return m_Items;
+		}
+
+		/**
+		* @brief Block sink_it_ until Release.
+		*/
+		void Hold() { m_IsHeld.store(true); }
+
+		/**
+		* @brief Release sink_it_.
+		*/
+		void Release() { m_IsHeld.store(false); }
+
+	protected:
+
+		void sink_it_(const spdlog::details::log_msg& msg) override
+		{
+			while (m_IsHeld.load()) std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+			m_Items.push_back({ std::string(msg.logger_name.data(), msg.logger_name.size()), msg.level, std::string(msg.payload.data(), msg.payload.size()) });
+		}
+
+		void flush_() override {}
+
+	private:
+
+		std::vector<Item> m_Items;
+		std::atomic<bool> m_IsHeld { false };
+	};
+
+	/**
+	* @brief Unit Test for AsyncLogger.
+	*/
+	class AsyncLogger_test : public testing::Test
+	{
+	protected:
+
+		using AsyncLogger = Spices::AsyncLogger;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override
+		{
+			m_Sink = std::make_shared<CollectSink>();
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief p99 of latencies.
+		* @param[in] latencies Latencies, sorted.
+		* @return Returns p99.
+		*/
+		static double P99(std::vector<double>& latencies)
+		{
+			std::sort(latencies.begin(), latencies.end());
+			return latencies[latencies.size() * 99 / 100];
+		}
+
+		/**
+		* @brief Call a log function from worker threads, measuring each call.
+		* @param[in] nThreads Worker threads.
+		* @param[in] nCalls Calls per thread.
+		* @param[in] fn Log function, called with thread and call index.
+		* @return Returns latencies in nanoseconds.
+		*/
+		template<typename F>
+		static std::vector<double> MeasureLatency(uint32_t nThreads, uint32_t nCalls, F&& fn)
+		{
+			using Clock = std::chrono::steady_clock;
+
+			std::vector<std::vector<double>> perThread(nThreads);
+			std::vector<std::thread> threads;
+
+			for (uint32_t t = 0; t < nThreads; t++)
+			{
+				threads.emplace_back([&, t]() {
+					auto& latencies = perThread[t];
+					latencies.reserve(nCalls);
+
+					for (uint32_t i = 0; i < nCalls; i++)
+					{
+						const auto start = Clock::now();
+						fn(t, i);
+						latencies.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+					}
+				});
+			}
+
+			for (auto& thread : threads) thread.join();
+
+			std::vector<double> latencies;
+			for (auto& l : perThread) latencies.insert(latencies.end(), l.begin(), l.end());
+
+			return latencies;
+		}
+
+	protected:
+
+		std::shared_ptr<CollectSink> m_Sink;
+	};
+
+	/**
+	* @brief Testing if records are formatted on background thread as fmt does.
+	*/
+	TEST_F(AsyncLogger_test, Format) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		enum class Stage { Init = 3 };
+
+		{
+			AsyncLogger logger({ m_Sink });
+
+			const std::string fmt = "copied {}";
+			const char* cstr = "cstr";
+
+			EXPECT_TRUE(logger.Log("Engine", spdlog::level::info, "{} {} {:.2f} {}", 1, -2ll, 0.5, true));
+			EXPECT_TRUE(logger.Log("Engine", spdlog::level::warn, "{}-{}-{}", std::string("temp"), std::string_view("view"), cstr));
+			EXPECT_TRUE(logger.Log("Game",   spdlog::level::err, fmt, 'c'));
+			EXPECT_TRUE(logger.Log("Game",   spdlog::level::info, std::string("no args {}")));
+			EXPECT_TRUE(logger.Log("Game",   spdlog::level::info, "stage {}", Stage::Init));
+			EXPECT_TRUE(logger.Log("Game",   spdlog::level::info, "{} {}", 1));
+
+			logger.Flush();
+
+			const auto items = m_Sink->Items();
+			ASSERT_EQ(items.size(), 6);
+
+			EXPECT_EQ(items[0].payload, "1 -2 0.50 true");
+			EXPECT_EQ(items[0].logger, "Engine");
+			EXPECT_EQ(items[0].level, spdlog::level::info);
+			EXPECT_EQ(items[1].payload, "temp-view-cstr");
+			EXPECT_EQ(items[1].level, spdlog::level::warn);
+			EXPECT_EQ(items[2].payload, "copied c");
+			EXPECT_EQ(items[2].logger, "Game");
+			EXPECT_EQ(items[3].payload, "no args {}");
+			EXPECT_EQ(items[4].payload, "stage 3");
+			EXPECT_THAT(items[5].payload, testing::StartsWith("{} {} [format error"));
+		}
+
+		EXPECT_EQ(m_Sink->Items().size(), 6);
+	}
+
+	/**
+	* @brief Testing if records of all threads are written in order, without drop if blocking.
+	*/
+	TEST_F(AsyncLogger_test, Order) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nThreads = 4;
+		constexpr uint32_t nRecords = 20000;
+
+		AsyncLogger logger({ m_Sink }, 4096, AsyncLogger::OverflowPolicy::Block);
+
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < nThreads; t++)
+		{
+			threads.emplace_back([&, t]() {
+				for (uint32_t i = 0; i < nRecords; i++)
+				{
+					logger.Log("Engine", spdlog::level::info, "{} {} {}", t, i, std::string(i % 64, 'x'));
+				}
+			});
+		}
+
+		for (auto& thread : threads) thread.join();
+
+		logger.Flush();
+
+		const auto items = m_Sink->Items();
+		ASSERT_EQ(items.size(), nThreads * nRecords);
+
+		std::vector<uint32_t> next(nThreads, 0);
+		for (const auto& item : items)
+		{
+			std::stringstream ss(item.payload);
+			uint32_t t = 0, i = 0;
+			std::string tail;
+			ss >> t >> i;
+			std::getline(ss, tail);
+
+			ASSERT_LT(t, nThreads);
+			ASSERT_EQ(i, next[t]);
+			ASSERT_EQ(tail.size(), 1 + i % 64);
+			next[t]++;
+		}
+
+		const auto stats = logger.GetStats();
+		EXPECT_EQ(stats.pushed,  nThreads * nRecords);
+		EXPECT_EQ(stats.written, nThreads * nRecords);
+		EXPECT_EQ(stats.dropped, 0);
+		EXPECT_GT(stats.blocked, 0);
+	}
+
+	/**
+	* @brief Testing if records are dropped and reported if ring is full.
+	*/
+	TEST_F(AsyncLogger_test, Drop) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nRecords = 1000;
+
+		AsyncLogger logger({ m_Sink }, 4096, AsyncLogger::OverflowPolicy::Drop);
+
+		m_Sink->Hold();
+
+		uint32_t nPushed = 0;
+		for (uint32_t i = 0; i < nRecords; i++)
+		{
+			nPushed += logger.Log("Engine", spdlog::level::info, "record {}", i);
+		}
+
+		/**
+		* @brief Larger than a quarter of ring.
+		*/
+		EXPECT_FALSE(logger.Log("Engine", spdlog::level::info, "{}", std::string(2048, 'x')));
+
+		m_Sink->Release();
+		logger.Flush();
+
+		const auto stats = logger.GetStats();
+		EXPECT_LT(nPushed, nRecords);
+		EXPECT_EQ(stats.pushed,  nPushed);
+		EXPECT_EQ(stats.dropped, nRecords - nPushed + 1);
+		EXPECT_EQ(stats.written, nPushed);
+
+		const auto items = m_Sink->Items();
+
+		uint64_t nReported = 0;
+		for (const auto& item : items)
+		{
+			if (item.logger != "AsyncLogger") continue;
+
+			EXPECT_EQ(item.level, spdlog::level::warn);
+
+			std::stringstream ss(item.payload);
+			std::string word;
+			uint64_t n = 0;
+			ss >> word >> word >> n;
+			nReported += n;
+		}
+		EXPECT_EQ(nReported, stats.dropped);
+		EXPECT_GT(items.size(), nPushed);
+	}
+
+	/**
+	* @brief Testing if records under level are filtered on calling thread.
+	*/
+	TEST_F(AsyncLogger_test, Level) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		AsyncLogger logger({ m_Sink });
+		logger.SetLevel(spdlog::level::warn);
+
+		EXPECT_FALSE(logger.Log("Engine", spdlog::level::info, "{}", 1));
+		EXPECT_TRUE (logger.Log("Engine", spdlog::level::warn, "{}", 2));
+
+		logger.Flush();
+
+		const auto items = m_Sink->Items();
+		ASSERT_EQ(items.size(), 1);
+		EXPECT_EQ(items[0].payload, "2");
+		EXPECT_EQ(logger.GetStats().pushed, 1);
+	}
+
+	/**
+	* @brief Testing p99 latency of a log call from worker threads, spdlog logger and AsyncLogger writing the same file sink.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(AsyncLogger_test, DISABLED_Latency) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nThreads = 4;
+		constexpr uint32_t nCalls   = 20000;
+
+		const auto path = std::filesystem::temp_directory_path() / "AsyncLogger_test.log";
+
+		double syncP99  = 0.0;
+		double asyncP99 = 0.0;
+
+		{
+			auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path.string(), true);
+			spdlog::logger logger("Engine", sink);
+
+			auto latencies = MeasureLatency(nThreads, nCalls, [&](uint32_t t, uint32_t i) {
+				logger.info("thread {} call {} value {:.3f} {}", t, i, i * 0.5, "Renderer");
+			});
+
+			syncP99 = P99(latencies);
+			logger.flush();
+		}
+
+		uint64_t dropped = 0;
+
+		{
+			auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path.string(), true);
+			AsyncLogger logger({ sink }, 4 << 20, AsyncLogger::OverflowPolicy::Drop);
+
+			auto latencies = MeasureLatency(nThreads, nCalls, [&](uint32_t t, uint32_t i) {
+				logger.Log("Engine", spdlog::level::info, "thread {} call {} value {:.3f} {}", t, i, i * 0.5, "Renderer");
+			});
+
+			asyncP99 = P99(latencies);
+			logger.Flush();
+
+			dropped = logger.GetStats().dropped;
+		}
+
+		std::filesystem::remove(path);
+
+		std::cout << "AsyncLogger: p99 of a log call from " << nThreads << " threads, spdlog " << syncP99
+			<< " ns, async " << asyncP99 << " ns" << std::endl;
+
+		EXPECT_EQ(dropped, 0);
+		EXPECT_LT(asyncP99, syncP99);
+	}
+}
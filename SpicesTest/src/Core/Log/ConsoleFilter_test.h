@@ -0,0 +1,295 @@
+/**
+* @file ConsoleFilter_test.h.
+* @brief The ConsoleFilter_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Log/ConsoleFilter.h>
+#include "Instrumentor.h"
+
+#include <chrono>
+#include <random>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for ConsoleFilter.
+	*/
+	class ConsoleFilter_test : public testing::Test
+	{
+	protected:
+
+		using Store  = Spices::ConsoleStore;
+		using Filter = Spices::ConsoleFilter;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Push lines of random levels and words.
+		* @param[in] store The store.
+		* @param[in] nLines Num of lines.
+		* @param[in] seed Random seed.
+		*/
+		static void PushLines(Store& store, uint32_t nLines, uint32_t seed)
+		{
+			static const char* words[] = { "render", "renderer", "mesh", "material", "texture", "shader", "frame", "vulkan" };
+
+			std::mt19937 rng(seed);
+			for (uint32_t i = 0; i < nLines; i++)
+			{
+				std::string text = words[rng() % 8];
+				text += ' ';
+				text += words[rng() % 8];
+				text += ' ';
+				text += std::to_string(rng() % 1000);
+
+				store.Push(static_cast<spdlog::level::level_enum>(rng() % Store::LevelCount), rng() % 4 ? "Engine" : "Game", 0, text);
+			}
+		}
+
+		/**
+		* @brief Lines passing a query, by testing every line.
+		*/
+		static std::vector<uint64_t> Expected(const Store& store, uint32_t levelMask, const std::vector<std::string>& includes, const std::vector<std::string>& excludes)
+		{
+			std::vector<uint64_t> lines;
+			for (uint64_t line = store.GetBegin(); line < store.GetEnd(); line++)
+			{
+				const auto view = store.GetLine(line);
+				const auto contains = [&](const std::string& token) {
+					return view.text.find(token) != std::string_view::npos || view.logger.find(token) != std::string_view::npos;
+				};
+
+				if (!(levelMask & (1u << view.level))) continue;
+				if (!std::all_of(includes.begin(), includes.end(), contains)) continue;
+				if (std::any_of(excludes.begin(), excludes.end(), contains)) continue;
+
+				lines.push_back(line);
+			}
+
+			return lines;
+		}
+
+		/**
+		* @brief Rows of a filter.
+		*/
+		static std::vector<uint64_t> Rows(const Filter& filter)
+		{
+			std::vector<uint64_t> rows;
+			for (uint64_t row = 0; row < filter.GetRowCount(); row++) rows.push_back(filter.GetRow(row));
+
+			return rows;
+		}
+	};
+
+	/**
+	* @brief Testing if rows are the lines passing queries.
+	*/
+	TEST_F(ConsoleFilter_test, Query) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Store store;
+		PushLines(store, 5000, 1);
+
+		Filter filter(store);
+
+		const uint32_t warn = 1u << spdlog::level::warn;
+		const uint32_t err  = 1u << spdlog::level::err | 1u << spdlog::level::critical;
+
+		filter.Update();
+		EXPECT_TRUE(filter.IsComplete());
+		EXPECT_EQ(Rows(filter), Expected(store, Filter::AllLevels, {}, {}));
+
+		filter.SetQuery(warn, "");
+		EXPECT_TRUE(filter.IsComplete());
+		EXPECT_EQ(Rows(filter), Expected(store, warn, {}, {}));
+
+		filter.SetQuery(err, "");
+		filter.Update();
+		EXPECT_EQ(Rows(filter), Expected(store, err, {}, {}));
+
+		filter.SetQuery(Filter::AllLevels, "render mesh");
+		filter.Update();
+		EXPECT_TRUE(filter.IsComplete());
+		EXPECT_EQ(Rows(filter), Expected(store, Filter::AllLevels, { "render", "mesh" }, {}));
+
+		filter.SetQuery(warn, "render -renderer Game");
+		filter.Update();
+		EXPECT_EQ(Rows(filter), Expected(store, warn, { "render", "Game" }, { "renderer" }));
+
+		filter.SetQuery(Filter::AllLevels, "nothing");
+		filter.Update();
+		EXPECT_EQ(filter.GetRowCount(), 0);
+		EXPECT_TRUE(filter.IsMatch(0) == false);
+	}
+
+	/**
+	* @brief Testing if index is right when updated within budget, narrowed, and lines pushed and dropped.
+	*/
+	TEST_F(ConsoleFilter_test, Incremental) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Store store(20000, 1000);
+		PushLines(store, 15000, 2);
+
+		Filter filter(store);
+		filter.SetQuery(Filter::AllLevels, "ma");
+
+		filter.Update(1000);
+		EXPECT_FALSE(filter.IsComplete());
+
+		/**
+		* @brief Newest lines first.
+		*/
+		const auto partial = Rows(filter);
+		ASSERT_FALSE(partial.empty());
+		EXPECT_GE(partial.front(), 14000);
+
+		/**
+		* @brief Narrowing while rebuilding.
+		*/
+		filter.SetQuery(Filter::AllLevels & ~(1u << spdlog::level::trace), "mat -shader");
+		filter.Update(3000);
+
+		PushLines(store, 3000, 3);
+		filter.Update(3000);
+
+		/**
+		* @brief Drops oldest chunks.
+		*/
+		PushLines(store, 4000, 4);
+		EXPECT_EQ(store.GetBegin(), 2000);
+
+		uint32_t nUpdates = 0;
+		while (!filter.IsComplete())
+		{
+			filter.Update(1000);
+			nUpdates++;
+		}
+		EXPECT_LE(nUpdates, 20);
+
+		EXPECT_EQ(Rows(filter), Expected(store, Filter::AllLevels & ~(1u << spdlog::level::trace), { "mat" }, { "shader" }));
+
+		/**
+		* @brief Not narrowing, rebuilt.
+		*/
+		filter.SetQuery(Filter::AllLevels, "frame");
+		while (!filter.IsComplete()) filter.Update(5000);
+		EXPECT_EQ(Rows(filter), Expected(store, Filter::AllLevels, { "frame" }, {}));
+
+		/**
+		* @brief Lines pushed after cleared.
+		*/
+		store.Clear();
+		PushLines(store, 100, 5);
+		filter.Update();
+		EXPECT_EQ(Rows(filter), Expected(store, Filter::AllLevels, { "frame" }, {}));
+	}
+
+	/**
+	* @brief Testing if cost of a frame does not grow with lines, up to 10M lines.
+	* A frame tests new lines within budget and formats visible rows.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(ConsoleFilter_test, DISABLED_Scale) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		using Clock = std::chrono::steady_clock;
+
+		constexpr uint32_t nVisible = 60;
+		constexpr uint64_t nBudget  = 1 << 18;
+
+		/**
+		* @brief Seconds of a frame: update filter, log 1000 lines, format visible rows newest first.
+		*/
+		const auto frame = [&](Store& store, Filter& filter, uint32_t seed) {
+			const auto start = Clock::now();
+
+			for (uint32_t i = 0; i < 1000; i++)
+			{
+				store.Push(spdlog::level::info, "Engine", 0, "mesh frame " + std::to_string(seed + i));
+			}
+
+			filter.Update(nBudget);
+
+			std::string row;
+			const uint64_t nRows = filter.GetRowCount();
+			for (uint64_t r = 0; r < std::min<uint64_t>(nVisible, nRows); r++)
+			{
+				row.clear();
+				store.Format(filter.GetRow(nRows - 1 - r), row);
+			}
+
+			return std::chrono::duration<double>(Clock::now() - start).count();
+		};
+
+		/**
+		* @brief Average seconds of frames of a query.
+		*/
+		const auto measure = [&](Store& store, uint32_t levelMask, const std::string& query) {
+			Filter filter(store);
+			filter.SetQuery(levelMask, query);
+			while (!filter.IsComplete()) filter.Update(nBudget);
+
+			double seconds = 0.0;
+			for (uint32_t i = 0; i < 20; i++) seconds += frame(store, filter, i * 1000);
+
+			return seconds / 20;
+		};
+
+		Store small;
+		Store large(10000000);
+
+		PushLines(small, 100000, 6);
+		PushLines(large, 10000000, 6);
+
+		ASSERT_EQ(large.GetSize(), 10000000);
+
+		const uint32_t warn = 1u << spdlog::level::warn;
+
+		const double smallAll   = measure(small, Filter::AllLevels, "");
+		const double largeAll   = measure(large, Filter::AllLevels, "");
+		const double smallLevel = measure(small, warn, "");
+		const double largeLevel = measure(large, warn, "");
+		const double smallIndex = measure(small, Filter::AllLevels, "mesh -vulkan");
+		const double largeIndex = measure(large, Filter::AllLevels, "mesh -vulkan");
+
+		/**
+		* @brief A rebuild of 10M lines is spread over frames of bounded cost.
+		*/
+		Filter filter(large);
+		filter.SetQuery(Filter::AllLevels, "texture shader");
+
+		uint32_t nFrames    = 0;
+		double   maxSeconds = 0.0;
+		while (!filter.IsComplete())
+		{
+			maxSeconds = std::max(maxSeconds, frame(large, filter, nFrames * 1000));
+			nFrames++;
+		}
+
+		std::cout << "ConsoleFilter: frame of 100K / 10M lines, all " << smallAll * 1e3 << " / " << largeAll * 1e3
+			<< " ms, level " << smallLevel * 1e3 << " / " << largeLevel * 1e3
+			<< " ms, indexed " << smallIndex * 1e3 << " / " << largeIndex * 1e3
+			<< " ms, rebuild of 10M in " << nFrames << " frames, max " << maxSeconds * 1e3 << " ms" << std::endl;
+
+		EXPECT_LT(largeAll,   smallAll   * 4 + 1e-3);
+		EXPECT_LT(largeLevel, smallLevel * 4 + 1e-3);
+		EXPECT_LT(largeIndex, smallIndex * 4 + 1e-3);
+		EXPECT_LE(nFrames, 10000000 / nBudget + 2);
+	}
+}
@@ -0,0 +1,120 @@
+/**
+* @file ConsoleStore_test.h.
+* @brief The ConsoleStore_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Log/ConsoleStore.h>
+#include "Instrumentor.h"
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for ConsoleStore.
+	*/
+	class ConsoleStore_test : public testing::Test
+	{
+	protected:
+
+		using Store = Spices::ConsoleStore;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Log time of now.
+		*/
+		static int64_t Now() { return spdlog::log_clock::now().time_since_epoch().count(); }
+	};
+
+	/**
+	* @brief Testing if lines are kept and formatted.
+	*/
+	TEST_F(ConsoleStore_test, Push) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Store store;
+
+		EXPECT_EQ(store.Push(spdlog::level::info, "Engine", Now(), "first"), 0);
+		EXPECT_EQ(store.Push(spdlog::level::warn, "Game",   Now(), ""), 1);
+		EXPECT_EQ(store.Push(spdlog::level::err,  "Engine", Now(), "third line"), 2);
+
+		EXPECT_EQ(store.GetBegin(), 0);
+		EXPECT_EQ(store.GetEnd(), 3);
+		EXPECT_EQ(store.GetSize(), 3);
+
+		const auto line = store.GetLine(2);
+		EXPECT_EQ(line.text, "third line");
+		EXPECT_EQ(line.logger, "Engine");
+		EXPECT_EQ(line.level, spdlog::level::err);
+		EXPECT_EQ(store.GetLine(1).text, "");
+		EXPECT_EQ(store.GetLine(1).logger, "Game");
+		EXPECT_EQ(store.GetLevel(0), spdlog::level::info);
+
+		std::string str = "> ";
+		store.Format(2, str);
+		EXPECT_THAT(str, testing::StartsWith("> ["));
+		EXPECT_THAT(str, testing::EndsWith("] [Engine] [error] third line"));
+
+		EXPECT_EQ(store.GetLevelCount(spdlog::level::warn), 1);
+		EXPECT_EQ(store.GetLevelCount(spdlog::level::trace), 0);
+		EXPECT_THAT(store.GetLevelLines(spdlog::level::err), testing::ElementsAre(2));
+	}
+
+	/**
+	* @brief Testing if the oldest chunk is dropped once full, numbers of lines are kept.
+	*/
+	TEST_F(ConsoleStore_test, Ring) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief 3 chunks of 4 lines.
+		*/
+		Store store(10, 4);
+
+		for (uint32_t i = 0; i < 20; i++)
+		{
+			store.Push(static_cast<spdlog::level::level_enum>(i % 3), "Engine", Now(), std::to_string(i));
+		}
+
+		EXPECT_EQ(store.GetBegin(), 8);
+		EXPECT_EQ(store.GetEnd(), 20);
+
+		for (uint64_t line = store.GetBegin(); line < store.GetEnd(); line++)
+		{
+			EXPECT_EQ(store.GetLine(line).text, std::to_string(line));
+		}
+
+		uint64_t nLevelLines = 0;
+		for (uint32_t level = 0; level < Store::LevelCount; level++)
+		{
+			for (uint64_t line : store.GetLevelLines(static_cast<spdlog::level::level_enum>(level)))
+			{
+				EXPECT_GE(line, store.GetBegin());
+				EXPECT_EQ(line % 3, level);
+				nLevelLines++;
+			}
+		}
+		EXPECT_EQ(nLevelLines, store.GetSize());
+
+		store.Clear();
+		EXPECT_EQ(store.GetBegin(), 20);
+		EXPECT_EQ(store.GetSize(), 0);
+		EXPECT_EQ(store.GetLevelCount(spdlog::level::trace), 0);
+
+		EXPECT_EQ(store.Push(spdlog::level::info, "Game", Now(), "after clear"), 20);
+		EXPECT_EQ(store.GetLine(20).text, "after clear");
+	}
+}
@@ -0,0 +1,272 @@
+/**
+* @file BatchMath_test.h.
+* @brief The BatchMath_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Math/BatchMath.h>
+#include <random>
+#include <vector>
+#include "Instrumentor.h"
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for BatchMath.
+	* Every compiled and supported instruction set is compared against the Scalar reference.
+	* Element count is not a multiple of any lane width so tails are covered too.
+	*/
+	class batch_math_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			std::mt19937 gen(7);
+			std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+			std::uniform_real_distribution<float> scl(0.1f, 4.0f);
+
+			auto fill = [&](std::vector<float>& v, std::uniform_real_distribution<float>& d) {
+				v.resize(m_Count);
+				for (auto& f : v) f = d(gen);
+			};
+
+			fill(px, pos); fill(py, pos); fill(pz, pos);
+			fill(qx, unit); fill(qy, unit); fill(qz, unit); fill(qw, unit);
+			fill(sx, scl); fill(sy, scl); fill(sz, scl);
+
+			/**
+			* @brief Normalize quaternions.
+			*/
+			for (size_t i = 0; i < m_Count; i++)
+			{
+				const float len = std::sqrt(qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i] + qw[i] * qw[i]);
+				qx[i] /= len; qy[i] /= len; qz[i] /= len; qw[i] /= len;
+			}
+
+			m_TRS = { px.data(), py.data(), pz.data(), qx.data(), qy.data(), qz.data(), qw.data(), sx.data(), sy.data(), sz.data() };
+
+			m_Matrices.resize(m_Count);
+			Scalar()->ComposeTRS(m_TRS, m_Matrices.data(), m_Count);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Get Scalar reference kernels.
+		*/
+		static const Spices::BatchMathKernels* Scalar() { return Spices::BatchMath::GetKernels(Spices::SIMDInstructionSet::Scalar); }
+
+		/**
+		* @brief Get all kernels supported on this machine.
+		*/
+		static std::vector<const Spices::BatchMathKernels*> Supported()
+		{
+			std::vector<const Spices::BatchMathKernels*> kernels;
+			for (int i = 0; i < static_cast<int>(Spices::SIMDInstructionSet::Count); i++)
+			{
+				if (auto k = Spices::BatchMath::GetKernels(static_cast<Spices::SIMDInstructionSet>(i)))
+				{
+					kernels.push_back(k);
+				}
+			}
+			return kernels;
+		}
+
+		/**
+		* @brief Compare matrices with relative tolerance.
+		*/
+		static void ExpectNear(const glm::mat4& a, const glm::mat4& b, float tol)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				for (int r = 0; r < 4; r++)
+				{
+					EXPECT_NEAR(a[c][r], b[c][r], tol * std::max(1.0f, std::abs(b[c][r])));
+				}
+			}
+		}
+
+		const size_t m_Count = 1027;                        /* @brief Element count.      */
+		std::vector<float> px, py, pz, qx, qy, qz, qw;      /* @brief Input streams.      */
+		std::vector<float> sx, sy, sz;                      /* @brief Input streams.      */
+		Spices::TRSSoA m_TRS;                               /* @brief Input view.         */
+		std::vector<glm::mat4> m_Matrices;                  /* @brief Reference matrices. */
+	};
+
+	/**
+	* @brief Testing if Scalar and active kernels are always available.
+	*/
+	TEST_F(batch_math_test, Availability) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		EXPECT_NE(Scalar(), nullptr);
+		EXPECT_NE(Spices::BatchMath::GetKernels(Spices::BatchMath::GetActiveInstructionSet()), nullptr);
+	}
+
+	/**
+	* @brief Testing if ComposeTRS matches Scalar reference.
+	*/
+	TEST_F(batch_math_test, ComposeTRS) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (auto k : Supported())
+		{
+			std::vector<glm::mat4> out(m_Count);
+			k->ComposeTRS(m_TRS, out.data(), m_Count);
+
+			for (size_t i = 0; i < m_Count; i++)
+			{
+				ExpectNear(out[i], m_Matrices[i], 1e-5f);
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if MulMat4 matches Scalar reference, including in place.
+	*/
+	TEST_F(batch_math_test, MulMat4) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::vector<glm::mat4> b(m_Matrices.rbegin(), m_Matrices.rend());
+		std::vector<glm::mat4> ref(m_Count);
+		Scalar()->MulMat4(m_Matrices.data(), b.data(), ref.data(), m_Count);
+
+		for (auto k : Supported())
+		{
+			std::vector<glm::mat4> out(m_Matrices);
+			k->MulMat4(out.data(), b.data(), out.data(), m_Count);
+
+			for (size_t i = 0; i < m_Count; i++)
+			{
+				ExpectNear(out[i], ref[i], 1e-4f);
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if InverseAffine produces identity when multiplied back.
+	*/
+	TEST_F(batch_math_test, InverseAffine) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (auto k : Supported())
+		{
+			std::vector<glm::mat4> inv(m_Count);
+			k->InverseAffine(m_Matrices.data(), inv.data(), m_Count);
+
+			for (size_t i = 0; i < m_Count; i++)
+			{
+				ExpectNear(m_Matrices[i] * inv[i], glm::mat4(1.0f), 1e-3f);
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if TransformSpheres and TransformAABBs match Scalar reference.
+	*/
+	TEST_F(batch_math_test, TransformBounds) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::vector<float> x(px), y(py), z(pz), r(sx);
+		std::vector<float> maxX(m_Count), maxY(m_Count), maxZ(m_Count);
+		for (size_t i = 0; i < m_Count; i++)
+		{
+			maxX[i] = x[i] + sx[i]; maxY[i] = y[i] + sy[i]; maxZ[i] = z[i] + sz[i];
+		}
+
+		const Spices::SphereSoA sphere { x.data(), y.data(), z.data(), r.data() };
+		const Spices::AABBSoA   box    { x.data(), y.data(), z.data(), maxX.data(), maxY.data(), maxZ.data() };
+
+		std::vector<float> rs[4], rb[6];
+		for (auto& v : rs) v.resize(m_Count);
+		for (auto& v : rb) v.resize(m_Count);
+		Scalar()->TransformSpheres(m_Matrices.data(), sphere, { rs[0].data(), rs[1].data(), rs[2].data(), rs[3].data() }, m_Count);
+		Scalar()->TransformAABBs(m_Matrices.data(), box, { rb[0].data(), rb[1].data(), rb[2].data(), rb[3].data(), rb[4].data(), rb[5].data() }, m_Count);
+
+		for (auto k : Supported())
+		{
+			std::vector<float> os[4], ob[6];
+			for (auto& v : os) v.resize(m_Count);
+			for (auto& v : ob) v.resize(m_Count);
+			k->TransformSpheres(m_Matrices.data(), sphere, { os[0].data(), os[1].data(), os[2].data(), os[3].data() }, m_Count);
+			k->TransformAABBs(m_Matrices.data(), box, { ob[0].data(), ob[1].data(), ob[2].data(), ob[3].data(), ob[4].data(), ob[5].data() }, m_Count);
+
+			for (size_t i = 0; i < m_Count; i++)
+			{
+				for (int c = 0; c < 4; c++) EXPECT_NEAR(os[c][i], rs[c][i], 1e-3f);
+				for (int c = 0; c < 6; c++) EXPECT_NEAR(ob[c][i], rb[c][i], 1e-3f);
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if frustum extraction and sphere culling match Scalar reference.
+	*/
+	TEST_F(batch_math_test, FrustumCulling) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief Camera at origin looking along +z, reverse z infinite projection as the engine uses.
+		*/
+		glm::mat4 proj(0.0f);
+		proj[0][0] = 1.0f;
+		proj[1][1] = 1.0f;
+		proj[2][3] = 1.0f;
+		proj[3][2] = 0.1f;
+
+		std::vector<glm::mat4> viewProjections(m_Count);
+		for (size_t i = 0; i < m_Count; i++)
+		{
+			viewProjections[i] = proj * m_Matrices[i];
+		}
+
+		std::vector<Spices::FrustumPlanes> ref(m_Count);
+		Scalar()->ExtractFrustumPlanes(viewProjections.data(), ref.data(), m_Count);
+
+		std::vector<float> r(m_Count, 1.0f);
+		const Spices::SphereSoA spheres { px.data(), py.data(), pz.data(), r.data() };
+
+		std::vector<uint8_t> refVisible(m_Count);
+		const uint32_t refCount = Scalar()->CullSpheres(ref[0], spheres, refVisible.data(), m_Count);
+		EXPECT_GT(refCount, 0u);
+		EXPECT_LT(refCount, m_Count);
+
+		for (auto k : Supported())
+		{
+			std::vector<Spices::FrustumPlanes> out(m_Count);
+			k->ExtractFrustumPlanes(viewProjections.data(), out.data(), m_Count);
+
+			for (size_t i = 0; i < m_Count; i++)
+			{
+				for (int p = 0; p < 6; p++)
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						EXPECT_NEAR(out[i].planes[p][c], ref[i].planes[p][c], 1e-3f * std::max(1.0f, std::abs(ref[i].planes[p][c])));
+					}
+				}
+			}
+
+			std::vector<uint8_t> visible(m_Count);
+			EXPECT_EQ(k->CullSpheres(ref[0], spheres, visible.data(), m_Count), refCount);
+			EXPECT_EQ(visible, refVisible);
+		}
+	}
+}
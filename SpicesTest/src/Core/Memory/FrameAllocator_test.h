@@ -0,0 +1,209 @@
+/**
+* @file FrameAllocator_test.h.
+* @brief The FrameAllocator_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Memory/FrameAllocator.h>
+#include <Render/Renderer/DrawPacket/InstanceBatcher.h>
+#include <Render/Renderer/DrawPacket/DrawPacketList.h>
+#include "Instrumentor.h"
+
+#include <cstdlib>
+#include <new>
+
+/**
+* @brief Global heap allocations are counted by AllocationCounter.
+* SpicesTest is one translation unit, so it is defined once.
+*/
+void* operator new(size_t size)
+{
+	Spices::AllocationCounter::OnAllocate(size);
+
+	if (void* p = std::malloc(size ? size : 1)) return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t size) noexcept
+{
+	std::free(p);
+}
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for FrameAllocator.
+	*/
+	class frame_allocator_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+	};
+
+	/**
+	* @brief Testing if arena allocations are aligned and chunks are merged on Reset.
+	*/
+	TEST_F(frame_allocator_test, LinearArena) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::LinearArena arena(1024);
+
+		for (size_t alignment : { 1, 2, 4, 8, 16, 64, 256 })
+		{
+			void* p = arena.allocate(3, alignment);
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % alignment, 0u);
+		}
+
+		EXPECT_EQ(arena.GetChunkCount(), 1u);
+
+		/**
+		* @brief Larger than a chunk gets its own chunk.
+		*/
+		arena.allocate(4096, 16);
+		arena.allocate(512,  16);
+
+		EXPECT_GE(arena.GetChunkCount(), 2u);
+		EXPECT_GE(arena.GetUsed(), 4096u + 512u);
+
+		const size_t capacity = arena.GetCapacity();
+
+		arena.Reset();
+
+		EXPECT_EQ(arena.GetChunkCount(), 1u);
+		EXPECT_EQ(arena.GetCapacity(),   capacity);
+		EXPECT_EQ(arena.GetUsed(),       0u);
+
+		/**
+		* @brief Same usage after Reset needs no upstream allocation.
+		*/
+		Spices::AllocationCounter::Reset();
+
+		arena.allocate(4096, 16);
+		arena.allocate(512,  16);
+
+		EXPECT_EQ(Spices::AllocationCounter::GetCount(), 0u);
+		EXPECT_EQ(arena.GetChunkCount(), 1u);
+
+		/**
+		* @brief Global heap is counted.
+		*/
+		auto heap = std::make_unique<std::vector<int>>(16);
+
+		EXPECT_EQ(Spices::AllocationCounter::GetCount(), 2u);
+		EXPECT_EQ(Spices::AllocationCounter::GetBytes(), sizeof(std::vector<int>) + 16 * sizeof(int));
+	}
+
+	/**
+	* @brief Testing if memory of a frame in flight stays valid until the same frame index begins again.
+	*/
+	TEST_F(frame_allocator_test, FramesInFlight) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::FrameAllocator::BeginFrame(0);
+		Spices::LinearArena& frame0 = Spices::FrameAllocator::Get();
+		frame0.allocate(128, 8);
+
+		EXPECT_EQ(&Spices::FrameAllocator::Get(), &frame0);
+		EXPECT_GE(frame0.GetUsed(), 128u);
+
+		Spices::FrameAllocator::BeginFrame(1);
+		Spices::LinearArena& frame1 = Spices::FrameAllocator::Get();
+
+		EXPECT_NE(&frame1, &frame0);
+		EXPECT_GE(frame0.GetUsed(), 128u);
+
+		Spices::FrameAllocator::BeginFrame(0);
+
+		EXPECT_EQ(&Spices::FrameAllocator::Get(), &frame0);
+		EXPECT_EQ(frame0.GetUsed(), 0u);
+
+		/**
+		* @brief Other threads own other arenas.
+		*/
+		Spices::LinearArena* other = nullptr;
+		std::thread([&]() { other = &Spices::FrameAllocator::Get(); }).join();
+
+		EXPECT_NE(other, &frame0);
+	}
+
+	/**
+	* @brief Testing if a steady state frame does no global heap allocation.
+	*/
+	TEST_F(frame_allocator_test, SteadyStateFrame) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::InstanceBatcher batcher;
+		Spices::DrawPacketList  packets;
+
+		const uint32_t pipeline = packets.GetPipelineId("BasePassRenderer.Mesh.Default");
+
+		/**
+		* @brief A frame of the base pass, transient lists live in frame arena.
+		*/
+		auto frame = [&](uint32_t frameIndex) {
+
+			Spices::FrameAllocator::BeginFrame(frameIndex);
+
+			batcher.Clear();
+			packets.Clear();
+
+			for (uint32_t i = 0; i < 1000; i++)
+			{
+				batcher.Add(i % 17, i % 5, i, 0x10000 + static_cast<uint64_t>(i) * sizeof(glm::mat4), i, static_cast<float>(i % 31));
+			}
+
+			batcher.Build();
+
+			for (const auto& group : batcher.GetGroups())
+			{
+				packets.Add(0, pipeline, group.material, group.depth, group.item);
+			}
+
+			packets.Sort();
+
+			std::pmr::vector<uint32_t> visible(Spices::FrameAllocator::GetResource());
+			for (uint32_t i = 0; i < 1000; i += 3) visible.push_back(i);
+
+			std::pmr::string name(Spices::FrameAllocator::GetResource());
+			name = "BasePassRenderer.Mesh.Default.DGC";
+
+			return batcher.GetGroups().size() + visible.size() + name.size();
+		};
+
+		/**
+		* @brief Warm up every frame in flight.
+		*/
+		for (uint32_t i = 0; i < 4; i++) frame(i % 2);
+
+		Spices::AllocationCounter::Reset();
+
+		size_t result = 0;
+		for (uint32_t i = 0; i < 100; i++) result += frame(i % 2);
+
+		EXPECT_EQ(Spices::AllocationCounter::GetCount(), 0u);
+		EXPECT_EQ(Spices::AllocationCounter::GetBytes(), 0u);
+		EXPECT_EQ(batcher.GetStats().groups, 85u);
+		EXPECT_GT(result, 0u);
+	}
+}
@@ -0,0 +1,477 @@
+/**
+* @file ReflectSerializer_test.h.
+* @brief The ReflectSerializer_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Reflect/ReflectSerializer.h>
+#include "Instrumentor.h"
+
+#include <yaml-cpp/yaml.h>
+#include <glm/glm.hpp>
+#include <chrono>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Texture parameter of a material.
+	*/
+	struct SerializerTexture
+	{
+		std::string textureType;
+		std::string texturePath;
+		uint32_t    index = 0;
+	};
+
+	/**
+	* @brief Material data, same shape as a .material file.
+	*/
+	struct SerializerMaterial
+	{
+		std::string                    name;
+		std::vector<std::string>       shaders;
+		std::vector<SerializerTexture> textures;
+		glm::vec4                      baseColor;
+		glm::vec3                      emissive;
+		float                          roughness = 0.0f;
+		float                          metallic  = 0.0f;
+		int                            mode      = 0;
+		bool                           twoSided  = false;
+	};
+
+	/**
+	* @brief Transform component data, trivially copyable.
+	*/
+	struct SerializerTransform
+	{
+		glm::vec3 position;
+		glm::vec3 rotation;
+		glm::vec3 scale;
+	};
+
+	/**
+	* @brief Entity component data.
+	*/
+	struct SerializerEntity
+	{
+		uint64_t                    uuid = 0;
+		std::string                 tag;
+		SerializerTransform         transform;
+		glm::vec3                   color;
+		float                       intensity = 0.0f;
+		std::vector<float>          weights;
+		static int                  count;
+	};
+
+	int SerializerEntity::count = 0;
+}
+
+namespace Spices {
+
+#ifdef CLASS_SCOPE
+#undef CLASS_SCOPE
+#endif
+#define CLASS_SCOPE SpicesTest::SerializerTexture
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(textureType),
+		UPROPERTY(texturePath),
+		UPROPERTY(index)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+#define CLASS_SCOPE SpicesTest::SerializerMaterial
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(name),
+		UPROPERTY(shaders),
+		UPROPERTY(textures),
+		UPROPERTY(baseColor),
+		UPROPERTY(emissive),
+		UPROPERTY(roughness),
+		UPROPERTY(metallic),
+		UPROPERTY(mode),
+		UPROPERTY(twoSided)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+#define CLASS_SCOPE SpicesTest::SerializerTransform
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(position),
+		UPROPERTY(rotation),
+		UPROPERTY(scale)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+#define CLASS_SCOPE SpicesTest::SerializerEntity
+
+	UCLASS()
+	UPROPERTYS(
+		UPROPERTY(uuid),
+		UPROPERTY(tag),
+		UPROPERTY(transform),
+		UPROPERTY(color),
+		UPROPERTY(intensity),
+		UPROPERTY(weights),
+		UPROPERTY_S(count)
+	)
+	END_CLASS
+
+#undef CLASS_SCOPE
+}
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for ReflectSerializer.
+	*/
+	class ReflectSerializer_test : public testing::Test
+	{
+	protected:
+
+		using Serializer = Spices::ReflectSerializer;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Create a material.
+		* @param[in] i Seed.
+		* @return Returns the material.
+		*/
+		static SerializerMaterial MakeMaterial(uint32_t i)
+		{
+			SerializerMaterial material;
+			material.name      = "Material.Test" + std::to_string(i);
+			material.shaders   = { "vertShader:MeshRenderer", "fragShader:MeshRenderer", "rchitShader:RayTracing" };
+			material.textures  = {
+				{ "Texture2D", "stone_tile/Albedo_" + std::to_string(i) + ".jpg", 0 },
+				{ "Texture2D", "stone_tile/Normal_" + std::to_string(i) + ".jpg", 1 },
+				{ "Texture2D", "stone_tile/Specular_" + std::to_string(i) + ".jpg", 2 },
+			};
+			material.baseColor = glm::vec4(0.1f * i, 0.5f, 0.25f, 1.0f);
+			material.emissive  = glm::vec3(0.0f, 0.0f, 0.1f * i);
+			material.roughness = 0.5f;
+			material.metallic  = 1.0f / (i + 1);
+			material.mode      = int(i % 4);
+			material.twoSided  = i % 2;
+
+			return material;
+		}
+
+		/**
+		* @brief Create a entity.
+		* @param[in] i Seed.
+		* @return Returns the entity.
+		*/
+		static SerializerEntity MakeEntity(uint32_t i)
+		{
+			SerializerEntity entity;
+			entity.uuid      = 0x9E3779B97F4A7C15ull * (i + 1);
+			entity.tag       = "Entity" + std::to_string(i);
+			entity.transform = { glm::vec3(float(i), 1.0f, 2.0f), glm::vec3(0.0f, 90.0f, 0.0f), glm::vec3(1.0f) };
+			entity.color     = glm::vec3(1.0f, 0.5f, 0.0f);
+			entity.intensity = 10.0f + i;
+			entity.weights   = { 0.25f, 0.5f, float(i) };
+
+			return entity;
+		}
+
+		/**
+		* @brief YAML path of material, same as MaterialLoader.
+		*/
+		static std::string EmitYaml(const SerializerMaterial& material)
+		{
+			YAML::Emitter out;
+			out << YAML::BeginMap;
+			out << YAML::Key << "Material" << YAML::Value << material.name;
+
+			out << YAML::Key << "Shaders" << YAML::Value << YAML::BeginSeq;
+			for (const auto& shader : material.shaders) out << shader;
+			out << YAML::EndSeq;
+
+			out << YAML::Key << "Textures" << YAML::Value << YAML::BeginSeq;
+			for (const auto& texture : material.textures)
+			{
+				out << YAML::BeginMap;
+				out << YAML::Key << "TextureType" << YAML::Value << texture.textureType;
+				out << YAML::Key << "TexturePath" << YAML::Value << texture.texturePath;
+				out << YAML::Key << "Index"       << YAML::Value << texture.index;
+				out << YAML::EndMap;
+			}
+			out << YAML::EndSeq;
+
+			const auto& c = material.baseColor;
+			const auto& e = material.emissive;
+			out << YAML::Key << "BaseColor" << YAML::Value << YAML::Flow << std::vector<float>{ c.x, c.y, c.z, c.w };
+			out << YAML::Key << "Emissive"  << YAML::Value << YAML::Flow << std::vector<float>{ e.x, e.y, e.z };
+			out << YAML::Key << "Roughness" << YAML::Value << material.roughness;
+			out << YAML::Key << "Metallic"  << YAML::Value << material.metallic;
+			out << YAML::Key << "Mode"      << YAML::Value << material.mode;
+			out << YAML::Key << "TwoSided"  << YAML::Value << material.twoSided;
+			out << YAML::EndMap;
+
+			return out.c_str();
+		}
+
+		/**
+		* @brief YAML path of material, same as MaterialLoader.
+		*/
+		static SerializerMaterial ParseYaml(const std::string& text)
+		{
+			YAML::Node data = YAML::Load(text);
+
+			SerializerMaterial material;
+			material.name = data["Material"].as<std::string>();
+
+			for (const auto& shader : data["Shaders"]) material.shaders.push_back(shader.as<std::string>());
+
+			for (const auto& texture : data["Textures"])
+			{
+				material.textures.push_back({
+					texture["TextureType"].as<std::string>(),
+					texture["TexturePath"].as<std::string>(),
+					texture["Index"].as<uint32_t>()
+				});
+			}
+
+			const auto c = data["BaseColor"].as<std::vector<float>>();
+			const auto e = data["Emissive"].as<std::vector<float>>();
+			material.baseColor = glm::vec4(c[0], c[1], c[2], c[3]);
+			material.emissive  = glm::vec3(e[0], e[1], e[2]);
+			material.roughness = data["Roughness"].as<float>();
+			material.metallic  = data["Metallic"].as<float>();
+			material.mode      = data["Mode"].as<int>();
+			material.twoSided  = data["TwoSided"].as<bool>();
+
+			return material;
+		}
+
+		/**
+		* @brief Compare materials.
+		*/
+		static void ExpectEqual(const SerializerMaterial& a, const SerializerMaterial& b)
+		{
+			EXPECT_EQ(a.name, b.name);
+			EXPECT_EQ(a.shaders, b.shaders);
+			ASSERT_EQ(a.textures.size(), b.textures.size());
+			for (size_t i = 0; i < a.textures.size(); i++)
+			{
+				EXPECT_EQ(a.textures[i].textureType, b.textures[i].textureType);
+				EXPECT_EQ(a.textures[i].texturePath, b.textures[i].texturePath);
+				EXPECT_EQ(a.textures[i].index,       b.textures[i].index);
+			}
+			EXPECT_EQ(a.baseColor, b.baseColor);
+			EXPECT_EQ(a.emissive,  b.emissive);
+			EXPECT_EQ(a.roughness, b.roughness);
+			EXPECT_EQ(a.metallic,  b.metallic);
+			EXPECT_EQ(a.mode,      b.mode);
+			EXPECT_EQ(a.twoSided,  b.twoSided);
+		}
+	};
+
+	/**
+	* @brief Testing if reflected classes round trip.
+	*/
+	TEST_F(ReflectSerializer_test, RoundTrip) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::vector<char> bytes;
+		Serializer::Serialize(MakeMaterial(3), bytes);
+		Serializer::Serialize(MakeEntity(7), bytes);
+
+		SerializerMaterial material;
+		SerializerEntity   entity;
+		uint64_t read0 = 0, read1 = 0;
+
+		EXPECT_TRUE(Serializer::Deserialize(bytes.data(), bytes.size(), material, &read0));
+		EXPECT_TRUE(Serializer::Deserialize(bytes.data() + read0, bytes.size() - read0, entity, &read1));
+		EXPECT_EQ(read0 + read1, bytes.size());
+
+		ExpectEqual(material, MakeMaterial(3));
+
+		const auto expect = MakeEntity(7);
+		EXPECT_EQ(entity.uuid,               expect.uuid);
+		EXPECT_EQ(entity.tag,                expect.tag);
+		EXPECT_EQ(entity.transform.position, expect.transform.position);
+		EXPECT_EQ(entity.transform.rotation, expect.transform.rotation);
+		EXPECT_EQ(entity.transform.scale,    expect.transform.scale);
+		EXPECT_EQ(entity.color,              expect.color);
+		EXPECT_EQ(entity.intensity,          expect.intensity);
+		EXPECT_EQ(entity.weights,            expect.weights);
+	}
+
+	/**
+	* @brief Testing if trivially copyable runs are written without padding and static properties are skipped.
+	*/
+	TEST_F(ReflectSerializer_test, Layout) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief Transform is one run.
+		*/
+		std::vector<char> bytes;
+		Serializer::Serialize(MakeEntity(1).transform, bytes);
+		EXPECT_EQ(bytes.size(), sizeof(uint64_t) + sizeof(SerializerTransform));
+
+		/**
+		* @brief uuid, tag, transform + color + intensity run, weights.
+		*/
+		const auto entity = MakeEntity(1);
+
+		bytes.clear();
+		Serializer::Serialize(entity, bytes);
+		EXPECT_EQ(bytes.size(),
+			sizeof(uint64_t) +
+			sizeof(uint64_t) +
+			sizeof(uint64_t) + entity.tag.size() +
+			sizeof(SerializerTransform) + sizeof(glm::vec3) + sizeof(float) +
+			sizeof(uint64_t) + entity.weights.size() * sizeof(float)
+		);
+	}
+
+	/**
+	* @brief Testing if schema hash rejects other types and truncated bytes are rejected.
+	*/
+	TEST_F(ReflectSerializer_test, Invalid) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint64_t materialHash = Serializer::SchemaHash<SerializerMaterial>();
+		constexpr uint64_t entityHash   = Serializer::SchemaHash<SerializerEntity>();
+		constexpr uint64_t textureHash  = Serializer::SchemaHash<SerializerTexture>();
+
+		EXPECT_NE(materialHash, entityHash);
+		EXPECT_NE(materialHash, textureHash);
+		EXPECT_NE(entityHash,   textureHash);
+
+		std::vector<char> bytes;
+		Serializer::Serialize(MakeMaterial(1), bytes);
+
+		SerializerEntity entity;
+		EXPECT_FALSE(Serializer::Deserialize(bytes.data(), bytes.size(), entity));
+
+		for (size_t size = 0; size < bytes.size(); size++)
+		{
+			SerializerMaterial material;
+			EXPECT_FALSE(Serializer::Deserialize(bytes.data(), size, material)) << size;
+		}
+
+		/**
+		* @brief A huge count must not allocate.
+		*/
+		std::vector<char> corrupt = bytes;
+		const uint64_t nameSize = MakeMaterial(1).name.size();
+		const uint64_t huge     = UINT64_MAX / 2;
+		std::memcpy(corrupt.data() + sizeof(uint64_t) * 2 + nameSize, &huge, sizeof(huge));
+
+		SerializerMaterial material;
+		EXPECT_FALSE(Serializer::Deserialize(corrupt.data(), corrupt.size(), material));
+	}
+
+	/**
+	* @brief Testing ReflectSerializer against yaml-cpp on material and entity data.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(ReflectSerializer_test, DISABLED_Throughput) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nMaterials = 5000;
+
+		std::vector<SerializerMaterial> materials;
+		for (uint32_t i = 0; i < nMaterials; i++) materials.push_back(MakeMaterial(i));
+
+		using Clock = std::chrono::high_resolution_clock;
+		const auto ms = [](Clock::time_point a, Clock::time_point b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+		/**
+		* @brief YAML.
+		*/
+		auto start = Clock::now();
+		std::vector<std::string> texts;
+		texts.reserve(nMaterials);
+		for (const auto& material : materials) texts.push_back(EmitYaml(material));
+		auto middle = Clock::now();
+		std::vector<SerializerMaterial> yaml;
+		yaml.reserve(nMaterials);
+		for (const auto& text : texts) yaml.push_back(ParseYaml(text));
+		auto end = Clock::now();
+
+		const double yamlWrite = ms(start, middle);
+		const double yamlRead  = ms(middle, end);
+
+		/**
+		* @brief Binary.
+		*/
+		start = Clock::now();
+		std::vector<char> bytes;
+		for (const auto& material : materials) Serializer::Serialize(material, bytes);
+		middle = Clock::now();
+		std::vector<SerializerMaterial> binary(nMaterials);
+		uint64_t offset = 0;
+		for (auto& material : binary)
+		{
+			uint64_t read = 0;
+			EXPECT_TRUE(Serializer::Deserialize(bytes.data() + offset, bytes.size() - offset, material, &read));
+			offset += read;
+		}
+		end = Clock::now();
+
+		const double binaryWrite = ms(start, middle);
+		const double binaryRead  = ms(middle, end);
+
+		for (uint32_t i = 0; i < nMaterials; i += 997)
+		{
+			ExpectEqual(yaml[i],   materials[i]);
+			ExpectEqual(binary[i], materials[i]);
+		}
+
+		/**
+		* @brief Entities.
+		*/
+		std::vector<SerializerEntity> entities;
+		for (uint32_t i = 0; i < nMaterials * 10; i++) entities.push_back(MakeEntity(i));
+
+		start = Clock::now();
+		bytes.clear();
+		for (const auto& entity : entities) Serializer::Serialize(entity, bytes);
+		offset = 0;
+		for (auto& entity : entities)
+		{
+			uint64_t read = 0;
+			EXPECT_TRUE(Serializer::Deserialize(bytes.data() + offset, bytes.size() - offset, entity, &read));
+			offset += read;
+		}
+		end = Clock::now();
+
+		size_t yamlBytes = 0;
+		for (const auto& text : texts) yamlBytes += text.size();
+
+		std::cout << "ReflectSerializer: " << nMaterials << " materials" << std::endl;
+		std::cout << "  yaml   write " << yamlWrite   << " ms, read " << yamlRead   << " ms, " << yamlBytes / 1024 << " KB" << std::endl;
+		std::cout << "  binary write " << binaryWrite << " ms, read " << binaryRead << " ms" << std::endl;
+		std::cout << "  " << entities.size() << " entities round trip " << ms(start, end) << " ms" << std::endl;
+
+		EXPECT_LT(binaryRead, yamlRead);
+	}
+}
@@ -0,0 +1,258 @@
+/**
+* @file RangeScheduler_test.h.
+* @brief The RangeScheduler_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Core/Thread/RangeScheduler.h>
+#include <Core/Thread/ThreadPool.h>
+#include "Instrumentor.h"
+
+#include <random>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for RangeScheduler.
+	*/
+	class range_scheduler_test : public testing::Test
+	{
+	protected:
+
+		using Range = Spices::RangeScheduler::Range;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+			m_ThreadPool.SetMode(Spices::PoolMode::MODE_FIXED);
+			m_ThreadPool.Start(4);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Check ranges are contiguous, cover all items and empty ones are at tail.
+		* @param[in] ranges Ranges.
+		* @param[in] count Items count.
+		*/
+		static void ExpectCovers(const std::vector<Range>& ranges, uint32_t count)
+		{
+			uint32_t next  = 0;
+			bool     empty = false;
+
+			for (const auto& range : ranges)
+			{
+				if (range.begin == range.end)
+				{
+					empty = true;
+					continue;
+				}
+
+				ASSERT_FALSE(empty);
+				ASSERT_EQ(range.begin, next);
+				next = range.end;
+			}
+
+			ASSERT_EQ(next, count);
+		}
+
+		/**
+		* @brief Submit function running range of worker i on thread i of pool.
+		*/
+		Spices::RangeScheduler::SubmitFunc Submit()
+		{
+			return [this](uint32_t worker, std::function<void()> task) {
+				m_ThreadPool.SubmitThreadTask_LightWeight(worker, task);
+			};
+		}
+
+		/**
+		* @brief The pool running ranges.
+		*/
+		Spices::ThreadPool m_ThreadPool;
+	};
+
+	/**
+	* @brief Testing if items are split evenly by count.
+	*/
+	TEST_F(range_scheduler_test, SplitCount) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		EXPECT_EQ(Spices::RangeScheduler::Split(10, 4), std::vector<Range>({ { 0, 3 }, { 3, 6 }, { 6, 8 }, { 8, 10 } }));
+		EXPECT_EQ(Spices::RangeScheduler::Split(2,  4), std::vector<Range>({ { 0, 1 }, { 1, 2 }, { 2, 2 }, { 2, 2 } }));
+		EXPECT_EQ(Spices::RangeScheduler::Split(0,  2), std::vector<Range>({ { 0, 0 }, { 0, 0 } }));
+
+		for (uint32_t count = 0; count < 50; count++)
+		{
+			ExpectCovers(Spices::RangeScheduler::Split(count, 3), count);
+		}
+	}
+
+	/**
+	* @brief Testing if items are split evenly by cost.
+	*/
+	TEST_F(range_scheduler_test, SplitCost) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief A heavy item at front takes a worker alone.
+		*/
+		EXPECT_EQ(
+			Spices::RangeScheduler::Split(std::vector<uint32_t>{ 30, 10, 10, 10, 10, 10, 10, 10 }, 2),
+			std::vector<Range>({ { 0, 3 }, { 3, 8 } })
+		);
+
+		EXPECT_EQ(
+			Spices::RangeScheduler::Split(std::vector<uint32_t>{ 100, 1, 1, 1 }, 2),
+			std::vector<Range>({ { 0, 1 }, { 1, 4 } })
+		);
+
+		/**
+		* @brief No worker is idle while items remain.
+		*/
+		EXPECT_EQ(
+			Spices::RangeScheduler::Split(std::vector<uint32_t>{ 100, 1, 1, 1 }, 4),
+			std::vector<Range>({ { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 } })
+		);
+
+		EXPECT_EQ(
+			Spices::RangeScheduler::Split(std::vector<uint32_t>{ 5, 5 }, 4),
+			std::vector<Range>({ { 0, 1 }, { 1, 2 }, { 2, 2 }, { 2, 2 } })
+		);
+
+		EXPECT_EQ(
+			Spices::RangeScheduler::Split(std::vector<uint32_t>{ 0, 0, 0, 0 }, 2),
+			std::vector<Range>({ { 0, 2 }, { 2, 4 } })
+		);
+
+		/**
+		* @brief No range is heavier than its share plus one item.
+		*/
+		std::mt19937 random(5);
+		for (int i = 0; i < 100; i++)
+		{
+			std::vector<uint32_t> costs(random() % 200);
+			uint64_t total = 0;
+			uint32_t heaviest = 0;
+			for (auto& cost : costs)
+			{
+				cost      = random() % 64;
+				total    += cost;
+				heaviest  = std::max(heaviest, cost);
+			}
+
+			const uint32_t nWorkers = 1 + random() % 8;
+			const auto     ranges   = Spices::RangeScheduler::Split(costs, nWorkers);
+
+			ASSERT_EQ(ranges.size(), nWorkers);
+			ExpectCovers(ranges, static_cast<uint32_t>(costs.size()));
+
+			for (const auto& range : ranges)
+			{
+				uint64_t cost = 0;
+				for (uint32_t j = range.begin; j < range.end; j++) cost += costs[j];
+
+				ASSERT_LE(cost, total / nWorkers + 2 * heaviest);
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if every item is run once by the worker owning its range, over many runs,
+	* and a worker always runs on the same pool thread.
+	*/
+	TEST_F(range_scheduler_test, Run) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::RangeScheduler scheduler(4, Submit());
+		EXPECT_EQ(scheduler.GetWorkerCount(), 4u);
+
+		std::vector<std::thread::id> threads(scheduler.GetWorkerCount());
+		const std::thread::id        main = std::this_thread::get_id();
+
+		for (uint32_t count : { 0u, 1u, 3u, 4u, 1000u })
+		{
+			for (int run = 0; run < 50; run++)
+			{
+				std::vector<uint32_t> visits(count, 0);
+				std::vector<uint32_t> owners(count, ~0u);
+				std::vector<uint32_t> calls(scheduler.GetWorkerCount(), 0);
+
+				scheduler.Run(count, [&](uint32_t worker, uint32_t begin, uint32_t end) {
+					if (threads[worker] == std::thread::id()) threads[worker] = std::this_thread::get_id();
+
+					EXPECT_EQ(threads[worker], std::this_thread::get_id());
+					EXPECT_NE(threads[worker], main);
+
+					calls[worker]++;
+					for (uint32_t i = begin; i < end; i++)
+					{
+						visits[i]++;
+						owners[i] = worker;
+					}
+				});
+
+				ASSERT_EQ(std::count(visits.begin(), visits.end(), 1u), count);
+
+				const auto& ranges = scheduler.GetRanges();
+				for (uint32_t worker = 0; worker < ranges.size(); worker++)
+				{
+					ASSERT_EQ(calls[worker], ranges[worker].begin < ranges[worker].end ? 1u : 0u);
+
+					for (uint32_t i = ranges[worker].begin; i < ranges[worker].end; i++)
+					{
+						ASSERT_EQ(owners[i], worker);
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if per worker recording time shows imbalance.
+	*/
+	TEST_F(range_scheduler_test, WorkerTimes) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::RangeScheduler scheduler(2, Submit());
+
+		/**
+		* @brief Item cost is its sleeping time, split by count the first worker sleeps longer.
+		*/
+		const std::vector<uint32_t> costs = { 8, 8, 1, 1 };
+
+		const auto func = [&](uint32_t worker, uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(costs[i]));
+			}
+		};
+
+		scheduler.Run(static_cast<uint32_t>(costs.size()), func);
+
+		EXPECT_GE(scheduler.GetWorkerTimes()[0], 16.0);
+		EXPECT_GT(scheduler.GetWorkerTimes()[0], scheduler.GetWorkerTimes()[1]);
+		EXPECT_GT(scheduler.GetImbalance(), 1.3);
+
+		const double countImbalance = scheduler.GetImbalance();
+
+		/**
+		* @brief Split by cost balances it.
+		*/
+		scheduler.Run(costs, func);
+
+		EXPECT_EQ(scheduler.GetRanges()[0], Range({ 0, 1 }));
+		EXPECT_LT(scheduler.GetImbalance(), countImbalance);
+	}
+}
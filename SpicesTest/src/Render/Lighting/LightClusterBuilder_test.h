@@ -0,0 +1,241 @@
+/**
+* @file LightClusterBuilder_test.h.
+* @brief The LightClusterBuilder_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/Lighting/LightClusterBuilder.h>
+#include <Core/Thread/ThreadPool.h>
+#include "Instrumentor.h"
+
+#include <chrono>
+#include <random>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for LightClusterBuilder.
+	*/
+	class light_cluster_builder_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			/**
+			* @brief 60 degree fov, 16:9, camera at origin looking along +z.
+			*/
+			const float tanHalfFovy = std::tan(glm::radians(30.0f));
+
+			m_View.view      = glm::mat4(1.0f);
+			m_View.xScale    = 1.0f / (16.0f / 9.0f * tanHalfFovy);
+			m_View.yScale    = 1.0f / tanHalfFovy;
+			m_View.nearPlane = 0.1f;
+			m_View.farPlane  = 200.0f;
+
+			m_ThreadPool.SetMode(Spices::PoolMode::MODE_FIXED);
+			m_ThreadPool.Start(4);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Random lights in front of camera.
+		* @param[in] count Number of lights.
+		* @return Returns lights.
+		*/
+		std::vector<SpicesShader::PointLight> RandomLights(uint32_t count)
+		{
+			std::uniform_real_distribution<float> xy(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> z(-10.0f, 220.0f);
+			std::uniform_real_distribution<float> intensity(0.1f, 5.0f);
+
+			std::vector<SpicesShader::PointLight> lights(count);
+			for (auto& light : lights)
+			{
+				light.position  = { xy(m_Random), xy(m_Random), z(m_Random) };
+				light.color     = glm::vec3(1.0f);
+				light.intensity = intensity(m_Random);
+				light.constantf = 1.0f;
+				light.linear    = 0.35f;
+				light.quadratic = 0.44f;
+			}
+
+			return lights;
+		}
+
+		/**
+		* @brief Get lights of a cluster.
+		* @param[in] index Cluster index.
+		* @return Returns light indices.
+		*/
+		std::vector<uint32_t> GetLights(const Spices::LightClusterBuilder& builder, uint32_t index)
+		{
+			const auto& cluster = builder.GetClusters()[index];
+			const auto& indices = builder.GetIndices();
+
+			return std::vector<uint32_t>(indices.begin() + cluster.offset, indices.begin() + cluster.offset + cluster.count);
+		}
+
+		Spices::LightClusterBuilder::View m_View;          /* @brief Camera data.     */
+		Spices::ThreadPool                m_ThreadPool;    /* @brief ThreadPool.      */
+		std::mt19937                      m_Random{ 7 };   /* @brief Random engine.   */
+	};
+
+	/**
+	* @brief Testing if light range is where contribution reaches cutoff.
+	*/
+	TEST_F(light_cluster_builder_test, LightRange) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		SpicesShader::PointLight light{};
+		light.color     = glm::vec3(0.5f, 1.0f, 0.2f);
+		light.intensity = 2.0f;
+		light.constantf = 1.0f;
+		light.linear    = 0.35f;
+		light.quadratic = 0.44f;
+
+		const float d = Spices::LightClusterBuilder::GetLightRange(light, 0.01f);
+		EXPECT_NEAR(2.0f / (1.0f + 0.35f * d + 0.44f * d * d), 0.01f, 1.0e-4f);
+
+		light.quadratic = 0.0f;
+		EXPECT_NEAR(Spices::LightClusterBuilder::GetLightRange(light, 0.01f), 199.0f / 0.35f, 1.0e-2f);
+
+		light.linear = 0.0f;
+		EXPECT_TRUE(std::isinf(Spices::LightClusterBuilder::GetLightRange(light, 0.01f)));
+
+		light.intensity = 0.0f;
+		EXPECT_EQ(Spices::LightClusterBuilder::GetLightRange(light, 0.01f), 0.0f);
+	}
+
+	/**
+	* @brief Testing if clusters are compact, and only hold lights intersecting their bound, in light order.
+	* Lights touching a bound but outside the frustum are culled, so the result is a subset of brute force.
+	*/
+	TEST_F(light_cluster_builder_test, BruteForce) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const auto lights = RandomLights(300);
+
+		Spices::LightClusterBuilder builder;
+		builder.Build(m_View, lights.data(), static_cast<uint32_t>(lights.size()));
+
+		const uint32_t nClusters = LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z;
+		ASSERT_EQ(builder.GetClusters().size(), nClusters);
+
+		uint32_t total = 0;
+		for (uint32_t c = 0; c < nClusters; c++)
+		{
+			const auto& bound = builder.GetClusterBound(c);
+
+			std::vector<uint32_t> expect;
+			for (uint32_t i = 0; i < lights.size(); i++)
+			{
+				const float r = Spices::LightClusterBuilder::GetLightRange(lights[i], Spices::LightClusterBuilder::DefaultCutoff);
+				const glm::vec3 d = lights[i].position - glm::clamp(lights[i].position, bound.min, bound.max);
+
+				if (r > 0.0f && glm::dot(d, d) <= r * r)
+				{
+					expect.push_back(i);
+				}
+			}
+
+			const auto clusterLights = GetLights(builder, c);
+			EXPECT_TRUE(std::is_sorted(clusterLights.begin(), clusterLights.end()));
+			EXPECT_TRUE(std::includes(expect.begin(), expect.end(), clusterLights.begin(), clusterLights.end()));
+
+			EXPECT_EQ(builder.GetClusters()[c].offset, total);
+			total += builder.GetClusters()[c].count;
+		}
+
+		EXPECT_EQ(builder.GetInfo().indexCount, total);
+		EXPECT_GT(total, 0u);
+	}
+
+	/**
+	* @brief Testing if a position receives every light reaching it, and parallel build equals serial build.
+	*/
+	TEST_F(light_cluster_builder_test, Shading) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const auto lights = RandomLights(1000);
+
+		Spices::LightClusterBuilder serial;
+		serial.Build(m_View, lights.data(), static_cast<uint32_t>(lights.size()));
+
+		Spices::LightClusterBuilder parallel;
+		parallel.Build(m_View, lights.data(), static_cast<uint32_t>(lights.size()), &m_ThreadPool);
+
+		EXPECT_EQ(serial.GetIndices(), parallel.GetIndices());
+
+		std::uniform_real_distribution<float> ndc(-0.99f, 0.99f);
+		std::uniform_real_distribution<float> depth(0.2f, 190.0f);
+
+		for (int i = 0; i < 2000; i++)
+		{
+			const float z = depth(m_Random);
+			const glm::vec3 position = { ndc(m_Random) * z / m_View.xScale, ndc(m_Random) * z / m_View.yScale, z };
+
+			const auto clusterLights = GetLights(serial, Spices::LightClusterBuilder::GetCluster(serial.GetInfo(), m_View, position));
+
+			for (uint32_t l = 0; l < lights.size(); l++)
+			{
+				const float r = Spices::LightClusterBuilder::GetLightRange(lights[l], Spices::LightClusterBuilder::DefaultCutoff);
+				if (glm::length(lights[l].position - position) >= r) continue;
+
+				EXPECT_TRUE(std::binary_search(clusterLights.begin(), clusterLights.end(), l));
+			}
+		}
+	}
+
+	/**
+	* @brief Testing binning time for 1k / 10k lights.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(light_cluster_builder_test, DISABLED_Benchmark) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (const uint32_t count : { 1000u, 10000u })
+		{
+			const auto lights = RandomLights(count);
+
+			Spices::LightClusterBuilder builder;
+
+			for (const bool useThreads : { false, true })
+			{
+				Spices::ThreadPool* threadPool = useThreads ? &m_ThreadPool : nullptr;
+
+				/**
+				* @brief Warm up, bins are reused afterwards.
+				*/
+				builder.Build(m_View, lights.data(), count, threadPool);
+
+				const int nRuns = 20;
+				const auto start = std::chrono::high_resolution_clock::now();
+				for (int i = 0; i < nRuns; i++)
+				{
+					builder.Build(m_View, lights.data(), count, threadPool);
+				}
+				const auto end = std::chrono::high_resolution_clock::now();
+
+				const double ms = std::chrono::duration<double, std::milli>(end - start).count() / nRuns;
+				std::cout << "LightClusterBuilder: " << count << " lights, " << (useThreads ? "parallel" : "serial") << ": " << ms << " ms, " << builder.GetInfo().indexCount << " indices." << std::endl;
+
+				EXPECT_LE(builder.GetInfo().indexCount, static_cast<uint32_t>(LIGHT_CLUSTER_INDEX_MAXNUM));
+			}
+		}
+	}
+}
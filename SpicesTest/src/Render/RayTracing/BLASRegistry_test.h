@@ -0,0 +1,215 @@
+/**
+* @file BLASRegistry_test.h.
+* @brief The BLASRegistry_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/RayTracing/BLASRegistry.h>
+#include "Instrumentor.h"
+
+namespace SpicesTest {
+
+	/**
+	* @brief Mock of BLASBuildBackend.
+	*/
+	class MockBLASBuildBackend : public Spices::BLASBuildBackend
+	{
+	public:
+
+		MOCK_METHOD(VkDeviceSize,    GetBuildSize, (uint64_t key),                    (override));
+		MOCK_METHOD(void,            Build,        (const std::vector<uint64_t>& keys), (override));
+		MOCK_METHOD(VkDeviceAddress, GetAddress,   (uint64_t key),                    (override));
+		MOCK_METHOD(void,            Free,         (uint64_t key),                    (override));
+	};
+
+	/**
+	* @brief Unit Test for BLASRegistry.
+	*/
+	class blas_registry_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			m_Backend = std::make_shared<testing::NiceMock<MockBLASBuildBackend>>();
+
+			/**
+			* @brief Every BLAS is 10 bytes, address is key + 0x1000.
+			*/
+			ON_CALL(*m_Backend, GetBuildSize(testing::_)).WillByDefault(testing::Return(10));
+			ON_CALL(*m_Backend, GetAddress(testing::_)).WillByDefault([](uint64_t key) { return key + 0x1000; });
+
+			m_Registry = std::make_unique<Spices::BLASRegistry>(m_Backend, 2);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {
+
+			m_Registry.reset();
+		}
+
+		std::shared_ptr<testing::NiceMock<MockBLASBuildBackend>> m_Backend;     /* @brief The mock backend. */
+		std::unique_ptr<Spices::BLASRegistry>                    m_Registry;    /* @brief The registry.     */
+	};
+
+	/**
+	* @brief Testing if entities sharing a MeshPack share one BLAS.
+	*/
+	TEST_F(blas_registry_test, Sharing) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		EXPECT_TRUE (m_Registry->Acquire(1));
+		EXPECT_FALSE(m_Registry->Acquire(1));
+		EXPECT_FALSE(m_Registry->Acquire(1));
+		EXPECT_EQ(m_Registry->GetRefCount(1), 3u);
+		EXPECT_EQ(m_Registry->GetPendingCount(), 1u);
+		EXPECT_EQ(m_Registry->GetAddress(1), 0u);
+
+		EXPECT_CALL(*m_Backend, Build(std::vector<uint64_t>{ 1 })).Times(1);
+		EXPECT_EQ(m_Registry->Tick(1000), 1u);
+
+		EXPECT_TRUE(m_Registry->IsReady(1));
+		EXPECT_EQ(m_Registry->GetAddress(1), 0x1001u);
+		EXPECT_EQ(m_Registry->GetBuiltCount(), 1u);
+	}
+
+	/**
+	* @brief Testing if MeshPacks instanced from one resource end up with a single BLAS.
+	* Keys are made the way MeshPack::GetResourceKey does, from the shared positions attribute.
+	*/
+	TEST_F(blas_registry_test, SharedResource) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		auto shared = std::make_shared<std::vector<float>>(9);
+		auto unique = std::make_shared<std::vector<float>>(9);
+
+		const uint64_t packA = reinterpret_cast<uint64_t>(shared.get());
+		const uint64_t packB = reinterpret_cast<uint64_t>(shared.get());
+		const uint64_t packC = reinterpret_cast<uint64_t>(unique.get());
+
+		EXPECT_TRUE (m_Registry->Acquire(packA));
+		EXPECT_FALSE(m_Registry->Acquire(packB));
+		EXPECT_TRUE (m_Registry->Acquire(packC));
+		EXPECT_EQ(m_Registry->GetPendingCount(), 2u);
+
+		EXPECT_CALL(*m_Backend, Build(std::vector<uint64_t>{ packA, packC })).Times(1);
+		EXPECT_EQ(m_Registry->Tick(1000), 2u);
+
+		EXPECT_EQ(m_Registry->GetBuiltCount(), 2u);
+		EXPECT_EQ(m_Registry->GetRefCount(packA), 2u);
+		EXPECT_EQ(m_Registry->GetAddress(packA), m_Registry->GetAddress(packB));
+		EXPECT_NE(m_Registry->GetAddress(packA), m_Registry->GetAddress(packC));
+
+		/**
+		* @brief The BLAS stays alive until the last pack sharing it is released.
+		*/
+		m_Registry->Release(packA);
+		EXPECT_TRUE(m_Registry->IsReady(packB));
+		m_Registry->Release(packB);
+		EXPECT_FALSE(m_Registry->IsReady(packB));
+	}
+
+	/**
+	* @brief Testing if builds are split by budget across ticks.
+	*/
+	TEST_F(blas_registry_test, Budget) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (uint64_t i = 0; i < 5; i++)
+		{
+			m_Registry->Acquire(i);
+		}
+
+		{
+			testing::InSequence seq;
+			EXPECT_CALL(*m_Backend, Build(std::vector<uint64_t>{ 0, 1 })).Times(1);
+			EXPECT_CALL(*m_Backend, Build(std::vector<uint64_t>{ 2, 3 })).Times(1);
+			EXPECT_CALL(*m_Backend, Build(std::vector<uint64_t>{ 4 })).Times(1);
+		}
+
+		const uint64_t generation = m_Registry->GetGeneration();
+		EXPECT_EQ(m_Registry->Tick(25), 2u);
+		EXPECT_NE(m_Registry->GetGeneration(), generation);
+		EXPECT_EQ(m_Registry->Tick(25), 2u);
+		EXPECT_EQ(m_Registry->Tick(25), 1u);
+		EXPECT_EQ(m_Registry->Tick(25), 0u);
+		EXPECT_EQ(m_Registry->GetBuiltCount(), 5u);
+
+		/**
+		* @brief An entry over budget is still built alone.
+		*/
+		m_Registry->Acquire(9);
+		EXPECT_CALL(*m_Backend, Build(std::vector<uint64_t>{ 9 })).Times(1);
+		EXPECT_EQ(m_Registry->Tick(1), 1u);
+	}
+
+	/**
+	* @brief Testing if BLAS are freed after the free latency on last release.
+	*/
+	TEST_F(blas_registry_test, DeferredFree) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		m_Registry->Acquire(1);
+		m_Registry->Acquire(1);
+		m_Registry->Tick(1000);
+
+		EXPECT_CALL(*m_Backend, Free(testing::_)).Times(0);
+		m_Registry->Release(1);
+		EXPECT_TRUE(m_Registry->IsReady(1));
+		m_Registry->Release(1);
+		EXPECT_FALSE(m_Registry->IsReady(1));
+		EXPECT_EQ(m_Registry->GetAddress(1), 0u);
+		EXPECT_EQ(m_Registry->GetRetiredCount(), 1u);
+
+		m_Registry->Tick(1000);
+		testing::Mock::VerifyAndClearExpectations(m_Backend.get());
+
+		EXPECT_CALL(*m_Backend, Free(1)).Times(1);
+		m_Registry->Tick(1000);
+		EXPECT_FALSE(m_Registry->Contains(1));
+		EXPECT_EQ(m_Registry->GetRetiredCount(), 0u);
+	}
+
+	/**
+	* @brief Testing if a retired BLAS is revived without rebuild, and a pending one is dropped without build.
+	*/
+	TEST_F(blas_registry_test, ReviveAndCancel) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		m_Registry->Acquire(1);
+		m_Registry->Tick(1000);
+		m_Registry->Release(1);
+
+		EXPECT_CALL(*m_Backend, Build(testing::_)).Times(0);
+		EXPECT_CALL(*m_Backend, Free(1)).Times(0);
+		EXPECT_FALSE(m_Registry->Acquire(1));
+		EXPECT_TRUE(m_Registry->IsReady(1));
+		EXPECT_EQ(m_Registry->GetAddress(1), 0x1001u);
+
+		m_Registry->Tick(1000);
+		m_Registry->Tick(1000);
+		m_Registry->Tick(1000);
+		testing::Mock::VerifyAndClearExpectations(m_Backend.get());
+
+		EXPECT_CALL(*m_Backend, Build(testing::_)).Times(0);
+		EXPECT_CALL(*m_Backend, Free(2)).Times(1);
+		m_Registry->Acquire(2);
+		m_Registry->Release(2);
+		EXPECT_EQ(m_Registry->GetPendingCount(), 0u);
+		EXPECT_EQ(m_Registry->Tick(1000), 0u);
+		testing::Mock::VerifyAndClearExpectations(m_Backend.get());
+	}
+}
@@ -0,0 +1,169 @@
+/**
+* @file TLASInstanceTable_test.h.
+* @brief The TLASInstanceTable_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/RayTracing/TLASInstanceTable.h>
+#include "Instrumentor.h"
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for TLASInstanceTable.
+	*/
+	class tlas_instance_table_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			for (uint32_t i = 0; i < m_Count; i++)
+			{
+				const uint32_t slot = m_Table.Acquire(Spices::TLASInstanceTable::MakeKey(i, 0));
+
+				VkAccelerationStructureInstanceKHR instance{};
+				instance.instanceCustomIndex            = slot;
+				instance.accelerationStructureReference = 0x1000 + i;
+				instance.mask                           = 0xFF;
+				m_Table.SetInstance(slot, instance);
+				m_Table.SetTransform(slot, glm::mat4(1.0f));
+			}
+
+			m_Table.ClearDirty();
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Build a translation matrix.
+		*/
+		static glm::mat4 Translate(float x)
+		{
+			glm::mat4 m(1.0f);
+			m[3][0] = x;
+			return m;
+		}
+
+		const uint32_t m_Count = 16;                          /* @brief Instance count. */
+		Spices::TLASInstanceTable m_Table{ 0.25f };           /* @brief The table.      */
+	};
+
+	/**
+	* @brief Testing if slots are stable and freed slots are reused.
+	*/
+	TEST_F(tlas_instance_table_test, SlotStability) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		EXPECT_EQ(m_Table.GetLiveCount(), m_Count);
+		EXPECT_EQ(m_Table.GetBuildMode(), Spices::TLASInstanceTable::BuildMode::None);
+
+		for (uint32_t i = 0; i < m_Count; i++)
+		{
+			EXPECT_EQ(m_Table.GetSlot(Spices::TLASInstanceTable::MakeKey(i, 0)), i);
+			EXPECT_EQ(m_Table.Acquire(Spices::TLASInstanceTable::MakeKey(i, 0)), i);
+		}
+
+		m_Table.Release(Spices::TLASInstanceTable::MakeKey(5, 0));
+		EXPECT_EQ(m_Table.GetSlot(Spices::TLASInstanceTable::MakeKey(5, 0)), UINT32_MAX);
+		EXPECT_EQ(m_Table.GetInstances()[5].accelerationStructureReference, 0u);
+		EXPECT_EQ(m_Table.GetInstances().size(), m_Count);
+		EXPECT_EQ(m_Table.GetBuildMode(), Spices::TLASInstanceTable::BuildMode::Rebuild);
+
+		EXPECT_EQ(m_Table.Acquire(Spices::TLASInstanceTable::MakeKey(100, 0)), 5u);
+		EXPECT_EQ(m_Table.GetInstances().size(), m_Count);
+		EXPECT_EQ(m_Table.GetSlot(Spices::TLASInstanceTable::MakeKey(6, 0)), 6u);
+	}
+
+	/**
+	* @brief Testing if a sync walk releases keys not visited.
+	*/
+	TEST_F(tlas_instance_table_test, Sync) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		m_Table.BeginSync();
+		for (uint32_t i = 0; i < m_Count; i += 2)
+		{
+			m_Table.Acquire(Spices::TLASInstanceTable::MakeKey(i, 0));
+		}
+		m_Table.EndSync();
+
+		EXPECT_EQ(m_Table.GetLiveCount(), m_Count / 2);
+		for (uint32_t i = 0; i < m_Count; i++)
+		{
+			EXPECT_EQ(m_Table.GetSlot(Spices::TLASInstanceTable::MakeKey(i, 0)), i % 2 ? UINT32_MAX : i);
+		}
+	}
+
+	/**
+	* @brief Testing if dirty slots are coalesced into ranges.
+	*/
+	TEST_F(tlas_instance_table_test, DirtyRanges) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		m_Table.SetTransform(2, Translate(1.0f));
+		m_Table.SetTransform(3, Translate(1.0f));
+		m_Table.SetTransform(4, Translate(1.0f));
+		m_Table.SetTransform(9, Translate(1.0f));
+		m_Table.SetTransform(3, Translate(2.0f));
+
+		/**
+		* @brief Same transform is not a change.
+		*/
+		m_Table.SetTransform(7, glm::mat4(1.0f));
+
+		using Range = Spices::TLASInstanceTable::DirtyRange;
+		EXPECT_EQ(m_Table.GetDirtyCount(), 4u);
+		EXPECT_EQ(m_Table.GetDirtyRanges(), std::vector<Range>({ { 2, 3 }, { 9, 1 } }));
+
+		/**
+		* @brief Transform is stored row major 3x4.
+		*/
+		EXPECT_FLOAT_EQ(m_Table.GetInstances()[3].transform.matrix[0][3], 2.0f);
+		EXPECT_FLOAT_EQ(m_Table.GetInstances()[3].transform.matrix[0][0], 1.0f);
+
+		m_Table.ClearDirty();
+		EXPECT_EQ(m_Table.GetDirtyCount(), 0u);
+		EXPECT_TRUE(m_Table.GetDirtyRanges().empty());
+	}
+
+	/**
+	* @brief Testing if build mode switches from refit to rebuild.
+	*/
+	TEST_F(tlas_instance_table_test, BuildMode) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		m_Table.SetTransform(0, Translate(1.0f));
+		m_Table.SetTransform(1, Translate(1.0f));
+		EXPECT_EQ(m_Table.GetBuildMode(), Spices::TLASInstanceTable::BuildMode::Refit);
+
+		for (uint32_t i = 0; i < m_Count; i++)
+		{
+			m_Table.SetTransform(i, Translate(1.0f));
+		}
+		EXPECT_EQ(m_Table.GetBuildMode(), Spices::TLASInstanceTable::BuildMode::Rebuild);
+		m_Table.ClearDirty();
+
+		/**
+		* @brief A new BLAS reference needs a rebuild even if only one instance changed.
+		*/
+		VkAccelerationStructureInstanceKHR instance = m_Table.GetInstances()[0];
+		instance.accelerationStructureReference = 0x9000;
+		m_Table.SetInstance(0, instance);
+		EXPECT_EQ(m_Table.GetDirtyCount(), 1u);
+		EXPECT_EQ(m_Table.GetBuildMode(), Spices::TLASInstanceTable::BuildMode::Rebuild);
+	}
+}
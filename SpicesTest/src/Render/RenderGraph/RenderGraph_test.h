@@ -0,0 +1,325 @@
+/**
+* @file RenderGraph_test.h.
+* @brief The RenderGraph_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/RenderGraph/RenderGraph.h>
+#include "Instrumentor.h"
+
+#include <random>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for RenderGraph.
+	*/
+	class render_graph_test : public testing::Test
+	{
+	protected:
+
+		using AccessType = Spices::RenderGraph::AccessType;
+		using Barrier    = Spices::RenderGraph::Barrier;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		* A: written by P0, read by P1.
+		* B: written by P1, sampled by P2.
+		* C: written by P2, read by P3.
+		* D: storage image accumulated in P0.
+		* E: written by P0, exported.
+		*/
+		void SetUp() override {
+
+			for (const char* name : { "P0", "P1", "P2", "P3" })
+			{
+				m_Graph.AddPass(name);
+			}
+
+			m_A = m_Graph.AddResource("A");
+			m_B = m_Graph.AddResource("B");
+			m_C = m_Graph.AddResource("C");
+			m_D = m_Graph.AddResource("D");
+			m_E = m_Graph.AddResource("E");
+
+			m_Graph.SetResourceSize(m_A, 100, 16);
+			m_Graph.SetResourceSize(m_B, 100, 16);
+			m_Graph.SetResourceSize(m_C, 80,  64);
+			m_Graph.SetResourceSize(m_D, 30);
+			m_Graph.SetResourceSize(m_E, 20);
+
+			m_Graph.Access(0, m_A, AccessType::ColorAttachment, false, true );
+			m_Graph.Access(1, m_A, AccessType::InputAttachment, true,  false);
+			m_Graph.Access(1, m_B, AccessType::ColorAttachment, false, true );
+			m_Graph.Access(2, m_B, AccessType::SampledTexture,  true,  false);
+			m_Graph.Access(2, m_C, AccessType::DepthAttachment, false, true );
+			m_Graph.Access(3, m_C, AccessType::DepthAttachment, true,  true );
+			m_Graph.Access(0, m_D, AccessType::StorageTexture,  true,  true );
+			m_Graph.Access(0, m_E, AccessType::ColorAttachment, false, true );
+			m_Graph.Export(m_E);
+
+			m_Graph.Compile();
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Get barriers of a resource.
+		* @param[in] resource Resource index.
+		* @return Returns barriers in pass order.
+		*/
+		std::vector<Barrier> GetBarriers(uint32_t resource) const
+		{
+			std::vector<Barrier> barriers;
+			for (const auto& barrier : m_Graph.GetBarriers())
+			{
+				if (barrier.resource == resource)
+				{
+					barriers.push_back(barrier);
+				}
+			}
+			return barriers;
+		}
+
+		Spices::RenderGraph m_Graph;                              /* @brief The graph.      */
+		uint32_t m_A = 0, m_B = 0, m_C = 0, m_D = 0, m_E = 0;     /* @brief Resources.      */
+	};
+
+	/**
+	* @brief Testing if lifetimes span first to last access, and carried or exported content is not transient.
+	*/
+	TEST_F(render_graph_test, Lifetimes) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		EXPECT_EQ(m_Graph.GetLifetime(m_A).firstPass, 0u);
+		EXPECT_EQ(m_Graph.GetLifetime(m_A).lastPass,  1u);
+		EXPECT_EQ(m_Graph.GetLifetime(m_C).firstPass, 2u);
+		EXPECT_EQ(m_Graph.GetLifetime(m_C).lastPass,  3u);
+
+		EXPECT_TRUE (m_Graph.GetLifetime(m_A).isTransient);
+		EXPECT_TRUE (m_Graph.GetLifetime(m_B).isTransient);
+		EXPECT_TRUE (m_Graph.GetLifetime(m_C).isTransient);
+		EXPECT_FALSE(m_Graph.GetLifetime(m_D).isTransient);
+		EXPECT_FALSE(m_Graph.GetLifetime(m_E).isTransient);
+
+		/**
+		* @brief Never accessed resource has no lifetime.
+		*/
+		const uint32_t unused = m_Graph.AddResource("Unused");
+		m_Graph.Compile();
+		EXPECT_EQ(m_Graph.GetLifetime(unused).firstPass, Spices::RenderGraph::Invalid);
+		EXPECT_FALSE(m_Graph.GetLifetime(unused).isTransient);
+	}
+
+	/**
+	* @brief Testing if disjoint transient resources share blocks and bytes are counted.
+	*/
+	TEST_F(render_graph_test, Aliasing) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		ASSERT_EQ(m_Graph.GetBlocks().size(), 2u);
+		EXPECT_EQ(m_Graph.GetLifetime(m_A).block, m_Graph.GetLifetime(m_C).block);
+		EXPECT_NE(m_Graph.GetLifetime(m_A).block, m_Graph.GetLifetime(m_B).block);
+
+		const auto& shared = m_Graph.GetBlocks()[m_Graph.GetLifetime(m_A).block];
+		EXPECT_EQ(shared.size,      100u);
+		EXPECT_EQ(shared.alignment, 64u);
+		EXPECT_EQ(shared.resources, std::vector<uint32_t>({ m_A, m_C }));
+
+		const auto& stats = m_Graph.GetStats();
+		EXPECT_EQ(stats.unaliasedBytes, 330u);
+		EXPECT_EQ(stats.aliasedBytes,   250u);
+		EXPECT_EQ(stats.transientCount, 3u);
+		EXPECT_EQ(stats.blockCount,     2u);
+
+		/**
+		* @brief A new resource goes to the block it fits without growing.
+		*/
+		const uint32_t f = m_Graph.AddResource("F");
+		m_Graph.SetResourceSize(f, 50);
+		m_Graph.Access(0, f, AccessType::ColorAttachment, false, true);
+		m_Graph.Access(3, f, AccessType::SampledTexture,  true,  false);
+		m_Graph.Compile();
+		EXPECT_EQ(m_Graph.GetBlocks().size(), 3u);
+
+		m_Graph.Export(f);
+		m_Graph.Compile();
+		EXPECT_EQ(m_Graph.GetBlocks().size(), 2u);
+		EXPECT_EQ(m_Graph.GetStats().aliasedBytes, 300u);
+	}
+
+	/**
+	* @brief Testing if barriers transition layouts and synchronize hazards.
+	*/
+	TEST_F(render_graph_test, Barriers) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief A: undefined to color, then color write to input read.
+		*/
+		auto a = GetBarriers(m_A);
+		ASSERT_EQ(a.size(), 2u);
+		EXPECT_EQ(a[0].pass,          0u);
+		EXPECT_EQ(a[0].oldLayout,     VK_IMAGE_LAYOUT_UNDEFINED);
+		EXPECT_EQ(a[0].newLayout,     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		EXPECT_EQ(a[0].srcStageMask,  static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT));
+		EXPECT_FALSE(a[0].isAliasing);
+
+		EXPECT_EQ(a[1].pass,          1u);
+		EXPECT_EQ(a[1].oldLayout,     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		EXPECT_EQ(a[1].newLayout,     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		EXPECT_EQ(a[1].srcStageMask,  static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT));
+		EXPECT_EQ(a[1].srcAccessMask, static_cast<VkAccessFlags>(VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+		EXPECT_EQ(a[1].dstStageMask,  static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT));
+		EXPECT_EQ(a[1].dstAccessMask, static_cast<VkAccessFlags>(VK_ACCESS_INPUT_ATTACHMENT_READ_BIT));
+
+		/**
+		* @brief C takes the block over after A's last read, then depth read write without layout change.
+		*/
+		auto c = GetBarriers(m_C);
+		ASSERT_EQ(c.size(), 2u);
+		EXPECT_TRUE(c[0].isAliasing);
+		EXPECT_EQ(c[0].oldLayout,     VK_IMAGE_LAYOUT_UNDEFINED);
+		EXPECT_EQ(c[0].newLayout,     VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+		EXPECT_EQ(c[0].srcStageMask,  static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT));
+
+		EXPECT_EQ(c[1].pass,          3u);
+		EXPECT_EQ(c[1].oldLayout,     c[1].newLayout);
+		EXPECT_EQ(c[1].srcAccessMask, static_cast<VkAccessFlags>(VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT));
+
+		/**
+		* @brief D keeps its layout across frames, and each frame waits for last frame's write.
+		*/
+		auto d = GetBarriers(m_D);
+		ASSERT_EQ(d.size(), 1u);
+		EXPECT_EQ(d[0].oldLayout,     VK_IMAGE_LAYOUT_GENERAL);
+		EXPECT_EQ(d[0].newLayout,     VK_IMAGE_LAYOUT_GENERAL);
+		EXPECT_EQ(d[0].srcAccessMask, static_cast<VkAccessFlags>(VK_ACCESS_SHADER_WRITE_BIT));
+
+		/**
+		* @brief Reads in synchronized stages need no more barrier.
+		*/
+		m_Graph.Access(3, m_B, AccessType::SampledTexture, true, false);
+		m_Graph.Compile();
+		EXPECT_EQ(GetBarriers(m_B).size(), 2u);
+
+		m_Graph.Access(3, m_B, AccessType::SampledTexture, true, false, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT);
+		m_Graph.Compile();
+		EXPECT_EQ(GetBarriers(m_B).size(), 3u);
+	}
+
+	/**
+	* @brief Testing if random graphs never alias overlapping lifetimes.
+	*/
+	TEST_F(render_graph_test, Random) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::mt19937 random(11);
+
+		for (int round = 0; round < 50; round++)
+		{
+			Spices::RenderGraph graph;
+
+			const uint32_t nPasses    = 1 + random() % 20;
+			const uint32_t nResources = 1 + random() % 30;
+
+			for (uint32_t p = 0; p < nPasses;    p++) graph.AddPass("P" + std::to_string(p));
+			for (uint32_t r = 0; r < nResources; r++)
+			{
+				graph.SetResourceSize(graph.AddResource("R" + std::to_string(r)), 1 + random() % 1000);
+			}
+
+			for (uint32_t i = 0; i < nPasses * 3; i++)
+			{
+				graph.Access(random() % nPasses, random() % nResources, static_cast<AccessType>(random() % 5), random() % 2, random() % 2);
+			}
+
+			graph.Compile();
+
+			for (const auto& block : graph.GetBlocks())
+			{
+				for (size_t i = 1; i < block.resources.size(); i++)
+				{
+					EXPECT_LT(graph.GetLifetime(block.resources[i - 1]).lastPass, graph.GetLifetime(block.resources[i]).firstPass);
+				}
+			}
+
+			EXPECT_LE(graph.GetStats().aliasedBytes, graph.GetStats().unaliasedBytes);
+		}
+	}
+
+	/**
+	* @brief Testing VRAM saved on the default deferred stack at 1920x1080.
+	*/
+	TEST_F(render_graph_test, DefaultStack) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::RenderGraph graph;
+
+		const VkDeviceSize pixels = 1920 * 1080;
+
+		auto resource = [&](const char* name, VkDeviceSize bytesPerPixel) {
+			const uint32_t r = graph.AddResource(name);
+			graph.SetResourceSize(r, pixels * bytesPerPixel, 65536);
+			return r;
+		};
+
+		const uint32_t albedo = resource("Albedo",       4);
+		const uint32_t normal = resource("Normal",       4);
+		const uint32_t rough  = resource("Roughness",    4);
+		const uint32_t metal  = resource("Metallic",     4);
+		const uint32_t pos    = resource("Position",     16);
+		const uint32_t id     = resource("EntityID",     4);
+		const uint32_t depth  = resource("Depth",        4);
+		const uint32_t color  = resource("SceneColor",   4);
+		const uint32_t select = resource("SelectBuffer", 4);
+
+		const uint32_t base    = graph.AddPass("BasePass.Mesh");
+		const uint32_t compose = graph.AddPass("SceneCompose.SceneCompose");
+		const uint32_t grid    = graph.AddPass("ViewportGrid.ViewportGrid");
+		const uint32_t pick    = graph.AddPass("WorldPick.WorldPick");
+		const uint32_t pick2   = graph.AddPass("WorldPickStage2.WorldPickStage2");
+
+		for (const auto r : { albedo, normal, rough, metal, pos, id })
+		{
+			graph.Access(base, r, AccessType::ColorAttachment, false, true);
+		}
+		graph.Access(base, depth, AccessType::DepthAttachment, false, true);
+
+		for (const auto r : { albedo, normal, rough, metal, pos })
+		{
+			graph.Access(compose, r, AccessType::InputAttachment, true, false);
+		}
+		graph.Access(compose, color, AccessType::ColorAttachment, false, true);
+		graph.Access(grid,    color, AccessType::ColorAttachment, true,  true);
+		graph.Access(grid,    depth, AccessType::DepthAttachment, true,  true);
+		graph.Access(pick,    select, AccessType::ColorAttachment, false, true);
+		graph.Access(pick2,   select, AccessType::SampledTexture,  true,  false);
+		graph.Access(pick2,   color,  AccessType::ColorAttachment, true,  true);
+
+		/**
+		* @brief Viewport, picking and visualizers read these outside the graph.
+		*/
+		graph.Export(color);
+		graph.Export(id);
+
+		graph.Compile();
+
+		const auto& stats = graph.GetStats();
+		std::cout << "RenderGraph: default stack " << stats.unaliasedBytes / (1024 * 1024) << " MB, aliasing plan " << stats.aliasedBytes / (1024 * 1024) << " MB." << std::endl;
+
+		EXPECT_LT(stats.aliasedBytes, stats.unaliasedBytes);
+		EXPECT_EQ(graph.GetLifetime(select).block, graph.GetLifetime(pos).block);
+	}
+}
@@ -0,0 +1,250 @@
+/**
+* @file DrawPacketList_test.h.
+* @brief The DrawPacketList_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/Renderer/DrawPacket/DrawPacketList.h>
+#include <Core/Thread/ThreadPool.h>
+#include "Instrumentor.h"
+
+#include <chrono>
+#include <random>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for DrawPacketList.
+	*/
+	class draw_packet_list_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			m_ThreadPool.SetMode(Spices::PoolMode::MODE_FIXED);
+			m_ThreadPool.Start(4);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Fill a list with random draws.
+		* @param[in] list DrawPacketList.
+		* @param[in] count Number of draws.
+		* @param[in] nPipelines Number of pipelines.
+		* @param[in] nMaterials Number of materials.
+		*/
+		void RandomPackets(Spices::DrawPacketList& list, uint32_t count, uint32_t nPipelines, uint32_t nMaterials)
+		{
+			std::uniform_int_distribution<uint32_t> pipeline(0, nPipelines - 1);
+			std::uniform_int_distribution<uint32_t> material(0, nMaterials - 1);
+			std::uniform_real_distribution<float>   depth(0.1f, 1000.0f);
+
+			list.Clear();
+			list.Reserve(count);
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				list.Add(0, pipeline(m_Random), material(m_Random), depth(m_Random), i);
+			}
+		}
+
+		Spices::ThreadPool m_ThreadPool;     /* @brief ThreadPool.     */
+		std::mt19937       m_Random{ 5 };    /* @brief Random engine.  */
+	};
+
+	/**
+	* @brief Testing if keys order by pass, pipeline, material then depth.
+	*/
+	TEST_F(draw_packet_list_test, MakeKey) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		using List = Spices::DrawPacketList;
+
+		EXPECT_LT(List::MakeKey(0, 9, 9, 999.0f), List::MakeKey(1, 0, 0, 0.0f));
+		EXPECT_LT(List::MakeKey(0, 1, 9, 999.0f), List::MakeKey(0, 2, 0, 0.0f));
+		EXPECT_LT(List::MakeKey(0, 1, 1, 999.0f), List::MakeKey(0, 1, 2, 0.0f));
+		EXPECT_LT(List::MakeKey(0, 1, 1, 1.0f),   List::MakeKey(0, 1, 1, 2.0f));
+
+		/**
+		* @brief Negative depth is clamped.
+		*/
+		EXPECT_EQ(List::MakeKey(0, 1, 1, -5.0f),  List::MakeKey(0, 1, 1, 0.0f));
+
+		/**
+		* @brief Back to front keeps far first across pipelines.
+		*/
+		EXPECT_LT(List::MakeKey(0, 5, 0, 2.0f, true), List::MakeKey(0, 1, 0, 1.0f, true));
+		EXPECT_LT(List::MakeKey(0, 1, 0, 2.0f, true), List::MakeKey(0, 5, 0, 2.0f, true));
+	}
+
+	/**
+	* @brief Testing if radix sort equals stable sort, serial and parallel.
+	*/
+	TEST_F(draw_packet_list_test, RadixSort) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (const size_t n : { 0, 1, 7, 1000, 200000 })
+		{
+			for (const bool useThreads : { false, true })
+			{
+				std::vector<uint64_t> keys(n);
+				std::vector<uint32_t> values(n);
+
+				for (size_t i = 0; i < n; i++)
+				{
+					/**
+					* @brief Few distinct keys to test stability, full range to test all digits.
+					*/
+					keys[i]   = (i % 2) ? m_Random() % 16 : (static_cast<uint64_t>(m_Random()) << 32 | m_Random());
+					values[i] = static_cast<uint32_t>(i);
+				}
+
+				std::vector<std::pair<uint64_t, uint32_t>> expect(n);
+				for (size_t i = 0; i < n; i++) expect[i] = { keys[i], values[i] };
+				std::stable_sort(expect.begin(), expect.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+				Spices::DrawPacketList::RadixSort(keys, values, useThreads ? &m_ThreadPool : nullptr);
+
+				for (size_t i = 0; i < n; i++)
+				{
+					ASSERT_EQ(keys[i],   expect[i].first);
+					ASSERT_EQ(values[i], expect[i].second);
+				}
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if Record only binds changed state.
+	*/
+	TEST_F(draw_packet_list_test, Record) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::DrawPacketList list;
+
+		const uint32_t a = list.GetPipelineId("A");
+		const uint32_t b = list.GetPipelineId("B");
+		EXPECT_EQ(list.GetPipelineId("A"), a);
+		EXPECT_EQ(list.GetPipelineName(b), "B");
+
+		EXPECT_EQ(list.GetMaterialId(0), 0u);
+		EXPECT_EQ(list.GetMaterialId(0x1000), 1u);
+		EXPECT_EQ(list.GetMaterialId(0x2000), 2u);
+		EXPECT_EQ(list.GetMaterialId(0x1000), 1u);
+
+		list.Add(0, a, 0, 3.0f, 0);
+		list.Add(0, b, 0, 1.0f, 1);
+		list.Add(0, a, 1, 2.0f, 2);
+		list.Add(0, b, 0, 2.0f, 3);
+		list.Add(0, a, 0, 1.0f, 4);
+		list.Sort();
+
+		std::vector<std::string> commands;
+		list.Record(
+			[&](uint32_t pipeline) { commands.push_back("P" + list.GetPipelineName(pipeline)); },
+			[&](uint32_t material) { commands.push_back("M" + std::to_string(material)); },
+			[&](const Spices::DrawPacketList::Packet& packet) { commands.push_back("D" + std::to_string(packet.item)); }
+		);
+
+		EXPECT_EQ(commands, std::vector<std::string>({ "PA", "M0", "D4", "D0", "M1", "D2", "PB", "M0", "D1", "D3" }));
+
+		const auto& stats = list.GetStats();
+		EXPECT_EQ(stats.packets,               5u);
+		EXPECT_EQ(stats.pipelineBinds,         2u);
+		EXPECT_EQ(stats.materialBinds,         3u);
+		EXPECT_EQ(stats.unsortedPipelineBinds, 5u);
+		EXPECT_EQ(stats.unsortedMaterialBinds, 5u);
+	}
+
+	/**
+	* @brief Testing if ranges bind their own state and together draw as Record.
+	*/
+	TEST_F(draw_packet_list_test, RecordRange) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::DrawPacketList list;
+
+		const uint32_t a = list.GetPipelineId("A");
+		const uint32_t b = list.GetPipelineId("B");
+
+		list.Add(0, a, 0, 3.0f, 0);
+		list.Add(0, b, 0, 1.0f, 1);
+		list.Add(0, a, 1, 2.0f, 2);
+		list.Add(0, b, 0, 2.0f, 3);
+		list.Add(0, a, 0, 1.0f, 4);
+		list.Sort();
+
+		std::vector<std::string> commands;
+		std::vector<uint32_t>    draws;
+
+		auto bindPipeline = [&](uint32_t pipeline) { commands.push_back("P" + list.GetPipelineName(pipeline)); };
+		auto bindMaterial = [&](uint32_t material) { commands.push_back("M" + std::to_string(material)); };
+		auto draw         = [&](const Spices::DrawPacketList::Packet& packet) { commands.push_back("D" + std::to_string(packet.item)); draws.push_back(packet.item); };
+
+		list.RecordRange(0, 1, bindPipeline, bindMaterial, draw);
+		list.RecordRange(1, 3, bindPipeline, bindMaterial, draw);
+		list.RecordRange(3, 3, bindPipeline, bindMaterial, draw);
+		list.RecordRange(3, 5, bindPipeline, bindMaterial, draw);
+
+		EXPECT_EQ(commands, std::vector<std::string>({ "PA", "M0", "D4", "PA", "M0", "D0", "M1", "D2", "PB", "M0", "D1", "D3" }));
+		EXPECT_EQ(draws,    std::vector<uint32_t>({ 4, 0, 2, 1, 3 }));
+	}
+
+	/**
+	* @brief Testing key build and sort time of 1M packets, and state changes saved.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(draw_packet_list_test, DISABLED_Benchmark) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const uint32_t count = 1000000;
+
+		Spices::DrawPacketList list;
+
+		for (const bool useThreads : { false, true })
+		{
+			Spices::ThreadPool* threadPool = useThreads ? &m_ThreadPool : nullptr;
+
+			const int nRuns = 5;
+			double buildMs = 0.0;
+			double sortMs  = 0.0;
+
+			for (int i = 0; i < nRuns; i++)
+			{
+				const auto start = std::chrono::high_resolution_clock::now();
+				RandomPackets(list, count, 64, 1024);
+				const auto mid = std::chrono::high_resolution_clock::now();
+				list.Sort(threadPool);
+				const auto end = std::chrono::high_resolution_clock::now();
+
+				buildMs += std::chrono::duration<double, std::milli>(mid - start).count() / nRuns;
+				sortMs  += std::chrono::duration<double, std::milli>(end - mid  ).count() / nRuns;
+			}
+
+			const auto& stats = list.GetStats();
+			std::cout << "DrawPacketList: " << count << " packets, " << (useThreads ? "parallel" : "serial") << ": build " << buildMs << " ms, sort " << sortMs << " ms, "
+			          << "pipeline binds " << stats.unsortedPipelineBinds << " -> " << stats.pipelineBinds << ", "
+			          << "material binds " << stats.unsortedMaterialBinds << " -> " << stats.materialBinds << "." << std::endl;
+
+			EXPECT_EQ(stats.pipelineBinds, 64u);
+			EXPECT_LE(stats.materialBinds, 64u * 1024u);
+			EXPECT_LT(stats.materialBinds, stats.unsortedMaterialBinds);
+		}
+	}
+}
@@ -0,0 +1,237 @@
+/**
+* @file InstanceBatcher_test.h.
+* @brief The InstanceBatcher_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/Renderer/DrawPacket/InstanceBatcher.h>
+#include "Instrumentor.h"
+
+#include <random>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for InstanceBatcher.
+	*/
+	class instance_batcher_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief Make a model buffer address identified by entity.
+		* @param[in] entity Entity id.
+		* @return Returns model buffer address.
+		*/
+		static uint64_t Model(uint32_t entity)
+		{
+			return 0x10000 + static_cast<uint64_t>(entity) * sizeof(glm::mat4);
+		}
+	};
+
+	/**
+	* @brief Testing if instances are grouped by pack and material in first seen order.
+	*/
+	TEST_F(instance_batcher_test, Group) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::InstanceBatcher batcher;
+
+		batcher.Add(100, 0, 0, Model(0), 0, 5.0f);
+		batcher.Add(200, 0, 1, Model(1), 1, 1.0f);
+		batcher.Add(100, 0, 2, Model(2), 2, 3.0f);
+		batcher.Add(100, 1, 3, Model(3), 3, 2.0f);
+		batcher.Add(200, 0, 4, Model(4), 4, 4.0f);
+		batcher.Add(100, 0, 5, Model(5), 5, 9.0f);
+		batcher.Build();
+
+		const auto& groups    = batcher.GetGroups();
+		const auto& instances = batcher.GetInstances();
+
+		ASSERT_EQ(groups.size(),    3u);
+		ASSERT_EQ(instances.size(), 6u);
+
+		EXPECT_EQ(groups[0].pack,          100u);
+		EXPECT_EQ(groups[0].material,      0u);
+		EXPECT_EQ(groups[0].item,          0u);
+		EXPECT_EQ(groups[0].firstInstance, 0u);
+		EXPECT_EQ(groups[0].instanceCount, 3u);
+		EXPECT_EQ(groups[0].depth,         3.0f);
+
+		EXPECT_EQ(groups[1].pack,          200u);
+		EXPECT_EQ(groups[1].item,          1u);
+		EXPECT_EQ(groups[1].firstInstance, 3u);
+		EXPECT_EQ(groups[1].instanceCount, 2u);
+		EXPECT_EQ(groups[1].depth,         1.0f);
+
+		EXPECT_EQ(groups[2].pack,          100u);
+		EXPECT_EQ(groups[2].material,      1u);
+		EXPECT_EQ(groups[2].item,          3u);
+		EXPECT_EQ(groups[2].firstInstance, 5u);
+		EXPECT_EQ(groups[2].instanceCount, 1u);
+
+		/**
+		* @brief Instances keep submission order in a group and carry their own transform.
+		*/
+		const std::vector<uint32_t> expect = { 0, 2, 5, 1, 4, 3 };
+		for (size_t i = 0; i < expect.size(); i++)
+		{
+			EXPECT_EQ(instances[i].entityID,    expect[i]);
+			EXPECT_EQ(instances[i].modelAddress, Model(expect[i]));
+		}
+
+		EXPECT_EQ(batcher.GetStats().instances, 6u);
+		EXPECT_EQ(batcher.GetStats().groups,    3u);
+
+		batcher.Clear();
+		batcher.Build();
+
+		EXPECT_TRUE(batcher.GetGroups().empty());
+		EXPECT_TRUE(batcher.GetInstances().empty());
+	}
+
+	/**
+	* @brief Testing if groups larger than limit are split.
+	*/
+	TEST_F(instance_batcher_test, Split) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::InstanceBatcher batcher(4);
+
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			batcher.Add(7, 0, i, Model(i), i, static_cast<float>(10 - i));
+		}
+		batcher.Build();
+
+		const auto& groups = batcher.GetGroups();
+
+		ASSERT_EQ(groups.size(), 3u);
+
+		EXPECT_EQ(groups[0].firstInstance, 0u);
+		EXPECT_EQ(groups[0].instanceCount, 4u);
+		EXPECT_EQ(groups[0].depth,         7.0f);
+		EXPECT_EQ(groups[1].firstInstance, 4u);
+		EXPECT_EQ(groups[1].instanceCount, 4u);
+		EXPECT_EQ(groups[1].depth,         3.0f);
+		EXPECT_EQ(groups[2].firstInstance, 8u);
+		EXPECT_EQ(groups[2].instanceCount, 2u);
+		EXPECT_EQ(groups[2].depth,         1.0f);
+	}
+
+	/**
+	* @brief Testing if groups are clamped so nTasks * instanceCount fits maxTaskWorkGroupCount[0].
+	*/
+	TEST_F(instance_batcher_test, TaskClamp) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const uint32_t maxTaskGroupsX = 65535;
+		const uint32_t nTasks         = 1000;
+
+		EXPECT_EQ(Spices::InstanceBatcher::MaxInstancesOfTasks(maxTaskGroupsX, nTasks),   65u);
+		EXPECT_EQ(Spices::InstanceBatcher::MaxInstancesOfTasks(maxTaskGroupsX, 1),        Spices::InstanceBatcher::MaxInstancesPerGroup);
+		EXPECT_EQ(Spices::InstanceBatcher::MaxInstancesOfTasks(maxTaskGroupsX, 0),        Spices::InstanceBatcher::MaxInstancesPerGroup);
+		EXPECT_EQ(Spices::InstanceBatcher::MaxInstancesOfTasks(maxTaskGroupsX, 100000),   1u);
+
+		/**
+		* @brief A dense pack is clamped, a light pack in the same batcher keeps the default limit.
+		*/
+		Spices::InstanceBatcher batcher;
+
+		const uint32_t dense = Spices::InstanceBatcher::MaxInstancesOfTasks(maxTaskGroupsX, nTasks);
+		const uint32_t light = Spices::InstanceBatcher::MaxInstancesOfTasks(maxTaskGroupsX, 1);
+
+		for (uint32_t i = 0; i < 200; i++)
+		{
+			batcher.Add(1, 0, i, Model(i), i, 1.0f, dense);
+			batcher.Add(2, 0, i, Model(i), i, 1.0f, light);
+		}
+		batcher.Build();
+
+		const auto& groups = batcher.GetGroups();
+
+		ASSERT_EQ(groups.size(), 5u);
+
+		uint32_t denseInstances = 0;
+		for (const auto& group : groups)
+		{
+			if (group.pack == 1)
+			{
+				EXPECT_LE(group.instanceCount * nTasks, maxTaskGroupsX);
+				denseInstances += group.instanceCount;
+			}
+			else
+			{
+				EXPECT_EQ(group.instanceCount, 200u);
+			}
+		}
+		EXPECT_EQ(denseInstances, 200u);
+	}
+
+	/**
+	* @brief Testing a level of many entities sharing a few meshpacks.
+	*/
+	TEST_F(instance_batcher_test, Foliage) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const uint32_t nEntities = 20000;
+		const uint32_t nPacks    = 6;
+		const uint32_t nMaterial = 3;
+
+		std::mt19937 random(3);
+		std::uniform_int_distribution<uint32_t> pack(0, nPacks - 1);
+		std::uniform_int_distribution<uint32_t> material(0, nMaterial - 1);
+
+		Spices::InstanceBatcher batcher;
+		batcher.Reserve(nEntities);
+
+		std::vector<std::pair<uint64_t, uint32_t>> keys(nEntities);
+		for (uint32_t i = 0; i < nEntities; i++)
+		{
+			keys[i] = { pack(random), material(random) };
+			batcher.Add(keys[i].first, keys[i].second, i, Model(i), i, 1.0f);
+		}
+		batcher.Build();
+
+		const auto& groups    = batcher.GetGroups();
+		const auto& instances = batcher.GetInstances();
+
+		EXPECT_LE(groups.size(), nPacks * nMaterial);
+		ASSERT_EQ(instances.size(), nEntities);
+
+		/**
+		* @brief Every instance lies in the group of its key.
+		*/
+		uint32_t covered = 0;
+		for (const auto& group : groups)
+		{
+			EXPECT_EQ(group.firstInstance, covered);
+			covered += group.instanceCount;
+
+			for (uint32_t i = group.firstInstance; i < group.firstInstance + group.instanceCount; i++)
+			{
+				const auto& key = keys[instances[i].entityID];
+				ASSERT_EQ(key.first,  group.pack);
+				ASSERT_EQ(key.second, group.material);
+			}
+		}
+		EXPECT_EQ(covered, nEntities);
+	}
+}
@@ -0,0 +1,150 @@
+/**
+* @file BufferUploadTracker_test.h.
+* @brief The BufferUploadTracker_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/Vulkan/BufferUploadTracker.h>
+#include "Instrumentor.h"
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for BufferUploadTracker.
+	*/
+	class buffer_upload_tracker_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			m_Data.resize(m_Size / sizeof(float));
+			for (size_t i = 0; i < m_Data.size(); i++)
+			{
+				m_Data[i] = static_cast<float>(i);
+			}
+
+			/**
+			* @brief First upload is the whole written range.
+			*/
+			m_Tracker.Update(m_Data.data());
+			EXPECT_EQ(m_Tracker.Commit(), std::vector<Range>({ { 0, m_Size } }));
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		using Range = Spices::BufferUploadTracker::Range;
+
+		const VkDeviceSize               m_Size = 4096 + 100;                  /* @brief Buffer size.    */
+		std::vector<float>               m_Data;                               /* @brief Source data.    */
+		Spices::BufferUploadTracker      m_Tracker{ m_Size, 256, 256 };        /* @brief The tracker.    */
+	};
+
+	/**
+	* @brief Testing if only changed granules become dirty.
+	*/
+	TEST_F(buffer_upload_tracker_test, Diff) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		m_Tracker.Update(m_Data.data());
+		EXPECT_FALSE(m_Tracker.IsDirty());
+		EXPECT_TRUE(m_Tracker.Commit().empty());
+
+		m_Data[1] = -1.0f;
+		m_Data[3000 / sizeof(float)] = -1.0f;
+		m_Tracker.Update(m_Data.data());
+
+		EXPECT_EQ(m_Tracker.GetDirtyRanges(), std::vector<Range>({ { 0, 256 }, { 2816, 256 } }));
+		EXPECT_EQ(memcmp(m_Tracker.GetShadow(), m_Data.data(), m_Size), 0);
+
+		/**
+		* @brief Last granule is clamped to buffer size.
+		*/
+		m_Tracker.Commit();
+		m_Data.back() = -1.0f;
+		m_Tracker.Update(m_Data.data());
+		EXPECT_EQ(m_Tracker.GetDirtyRanges(), std::vector<Range>({ { 4096, 100 } }));
+	}
+
+	/**
+	* @brief Testing if close ranges are merged and partial writes are tracked.
+	*/
+	TEST_F(buffer_upload_tracker_test, Coalesce) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const float value = -1.0f;
+
+		m_Tracker.Update(&value, sizeof(float), 10);
+		m_Tracker.Update(&value, sizeof(float), 300);
+		m_Tracker.Update(&value, sizeof(float), 800);
+		m_Tracker.Update(&value, sizeof(float), 2000);
+
+		/**
+		* @brief 0 and 256 are adjacent, 768 is one granule away, 1792 is too far.
+		*/
+		EXPECT_EQ(m_Tracker.GetDirtyRanges(), std::vector<Range>({ { 0, 1024 }, { 1792, 256 } }));
+
+		/**
+		* @brief A write straddling granules dirties both.
+		*/
+		m_Tracker.Commit();
+		const double d = -1.0;
+		m_Tracker.Update(&d, sizeof(double), 1020);
+		EXPECT_EQ(m_Tracker.GetDirtyRanges(), std::vector<Range>({ { 768, 512 } }));
+	}
+
+	/**
+	* @brief Testing if explicit writes are uploaded even when unchanged.
+	*/
+	TEST_F(buffer_upload_tracker_test, ExplicitWrite) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		m_Tracker.Write(m_Data.data() + 64, 256, 256);
+		EXPECT_EQ(m_Tracker.GetDirtyRanges(), std::vector<Range>({ { 256, 256 } }));
+
+		/**
+		* @brief Out of range write is rejected.
+		*/
+		m_Tracker.Commit();
+		m_Tracker.Write(m_Data.data(), 256, m_Size - 100);
+		EXPECT_FALSE(m_Tracker.IsDirty());
+	}
+
+	/**
+	* @brief Testing if statistics count bytes, ranges and flushes per frame.
+	*/
+	TEST_F(buffer_upload_tracker_test, Stats) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::BufferUploadTracker::BeginFrame();
+
+		const float value = -1.0f;
+		m_Tracker.Update(&value, sizeof(float), 0);
+		m_Tracker.Update(&value, sizeof(float), 2000);
+		m_Tracker.Commit();
+		m_Tracker.Commit();
+
+		Spices::BufferUploadTracker::BeginFrame();
+
+		const auto stats = Spices::BufferUploadTracker::GetFrameStats();
+		EXPECT_EQ(stats.bytes,   512u);
+		EXPECT_EQ(stats.ranges,  2u);
+		EXPECT_EQ(stats.flushes, 1u);
+
+		Spices::BufferUploadTracker::BeginFrame();
+		EXPECT_EQ(Spices::BufferUploadTracker::GetFrameStats().bytes, 0u);
+	}
+}
@@ -0,0 +1,290 @@
+/**
+* @file DGCSequenceTable_test.h.
+* @brief The DGCSequenceTable_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/Vulkan/DGCSequenceTable.h>
+#include "Instrumentor.h"
+
+#include <random>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Mock of DGCInputBuffer.
+	*/
+	class MockDGCInputBuffer : public Spices::DGCInputBuffer
+	{
+	public:
+
+		MOCK_METHOD(void, Create, (size_t size),                                          (override));
+		MOCK_METHOD(void, Upload, (const uint8_t* data, const std::vector<Region>& regions), (override));
+	};
+
+	/**
+	* @brief Unit Test for DGCSequenceTable.
+	*/
+	class dgc_sequence_table_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			/**
+			* @brief The mock keeps a device copy, written only by Create and Upload.
+			*/
+			ON_CALL(m_Buffer, Create(testing::_)).WillByDefault([this](size_t size) {
+				m_Device.assign(size, 0xCD);
+			});
+
+			ON_CALL(m_Buffer, Upload(testing::_, testing::_)).WillByDefault([this](const uint8_t* data, const std::vector<Spices::DGCInputBuffer::Region>& regions) {
+				for (const auto& region : regions)
+				{
+					ASSERT_LE(region.offset + region.size, m_Device.size());
+					memcpy(m_Device.data() + region.offset, data + region.offset, region.size);
+				}
+			});
+
+			/**
+			* @brief Shader group, push constant and mesh task streams.
+			*/
+			m_Table = std::make_unique<Spices::DGCSequenceTable>(m_Buffer, std::vector<uint32_t>{ 4, 8, 8 }, 16, 4);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {
+
+			m_Table.reset();
+		}
+
+		/**
+		* @brief Write all tokens of a sequence from a value.
+		* @param[in] slot Slot.
+		* @param[in] value Token value.
+		*/
+		void SetSequence(uint32_t slot, uint64_t value)
+		{
+			const uint32_t group = static_cast<uint32_t>(value);
+			m_Table->SetToken(slot, 0, &group);
+			m_Table->SetToken(slot, 1, &value);
+			m_Table->SetToken(slot, 2, &value);
+		}
+
+		/**
+		* @brief Read push constant token of a sequence from device copy.
+		* @param[in] slot Slot.
+		* @return Returns token value.
+		*/
+		uint64_t GetDeviceSequence(uint32_t slot) const
+		{
+			uint64_t value = 0;
+			memcpy(&value, m_Device.data() + m_Table->GetStreamOffsets()[1] + slot * 8, 8);
+			return value;
+		}
+
+		/**
+		* @brief Check if live sequences on device equal host copy.
+		*/
+		void ExpectDeviceEqualsHost() const
+		{
+			const uint32_t count = m_Table->GetSequenceCount();
+			for (size_t i = 0; i < m_Table->GetStrides().size(); i++)
+			{
+				const size_t offset = m_Table->GetStreamOffsets()[i];
+				const size_t size   = static_cast<size_t>(count) * m_Table->GetStrides()[i];
+
+				ASSERT_EQ(memcmp(m_Device.data() + offset, m_Table->GetData().data() + offset, size), 0);
+			}
+		}
+
+		testing::NiceMock<MockDGCInputBuffer>        m_Buffer;    /* @brief The mock input buffer.  */
+		std::vector<uint8_t>                         m_Device;    /* @brief Device copy.            */
+		std::unique_ptr<Spices::DGCSequenceTable>    m_Table;     /* @brief The table.              */
+	};
+
+	/**
+	* @brief Testing if streams are laid out aligned and grown geometrically.
+	*/
+	TEST_F(dgc_sequence_table_test, Grow) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		EXPECT_CALL(m_Buffer, Create(testing::_)).Times(3);
+
+		std::vector<uint32_t> capacities;
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			const uint32_t slot = m_Table->Acquire(Spices::DGCSequenceTable::MakeKey(i, 0));
+			EXPECT_EQ(slot, i);
+
+			SetSequence(slot, 100 + i);
+
+			if (m_Table->Commit())
+			{
+				capacities.push_back(m_Table->GetCapacity());
+			}
+		}
+
+		EXPECT_EQ(capacities, std::vector<uint32_t>({ 4, 8, 16 }));
+
+		const auto& offsets = m_Table->GetStreamOffsets();
+		EXPECT_EQ(offsets[0], 0u);
+		EXPECT_EQ(offsets[1], 64u);
+		EXPECT_EQ(offsets[2], 192u);
+		EXPECT_EQ(m_Table->GetSize(), 320u);
+
+		ExpectDeviceEqualsHost();
+		for (uint32_t i = 0; i < 10; i++)
+		{
+			EXPECT_EQ(GetDeviceSequence(i), 100 + i);
+		}
+	}
+
+	/**
+	* @brief Testing if only changed sequences are uploaded.
+	*/
+	TEST_F(dgc_sequence_table_test, Patch) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			SetSequence(m_Table->Acquire(i), i);
+		}
+		EXPECT_TRUE(m_Table->Commit());
+
+		/**
+		* @brief Same tokens upload nothing.
+		*/
+		EXPECT_CALL(m_Buffer, Upload(testing::_, testing::_)).Times(0);
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			SetSequence(m_Table->GetSlot(i), i);
+		}
+		EXPECT_EQ(m_Table->GetDirtyCount(), 0u);
+		EXPECT_FALSE(m_Table->Commit());
+		testing::Mock::VerifyAndClearExpectations(&m_Buffer);
+
+		/**
+		* @brief Changed sequences 3, 4 and 9 upload two ranges of each stream.
+		*/
+		SetSequence(3, 1003);
+		SetSequence(4, 1004);
+		SetSequence(9, 1009);
+
+		EXPECT_FALSE(m_Table->Commit());
+		EXPECT_EQ(m_Table->GetStats().creates,   0u);
+		EXPECT_EQ(m_Table->GetStats().sequences, 3u);
+		EXPECT_EQ(m_Table->GetStats().regions,   6u);
+		EXPECT_EQ(m_Table->GetStats().bytes,     3u * (4 + 8 + 8));
+
+		ExpectDeviceEqualsHost();
+		EXPECT_EQ(GetDeviceSequence(9), 1009u);
+	}
+
+	/**
+	* @brief Testing if released slots are filled by the last sequence.
+	*/
+	TEST_F(dgc_sequence_table_test, Release) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (uint32_t i = 0; i < 8; i++)
+		{
+			SetSequence(m_Table->Acquire(i), i);
+		}
+		m_Table->Commit();
+
+		m_Table->Release(2);
+		m_Table->Release(42);
+
+		EXPECT_EQ(m_Table->GetSequenceCount(), 7u);
+		EXPECT_EQ(m_Table->GetSlot(7), 2u);
+		EXPECT_EQ(m_Table->GetSlot(2), UINT32_MAX);
+
+		m_Table->Commit();
+		EXPECT_EQ(m_Table->GetStats().sequences, 1u);
+		EXPECT_EQ(GetDeviceSequence(2), 7u);
+
+		/**
+		* @brief Releasing the last slot patches nothing.
+		*/
+		m_Table->Release(6);
+		m_Table->Commit();
+		EXPECT_EQ(m_Table->GetStats().sequences, 0u);
+		EXPECT_EQ(m_Table->GetSequenceCount(), 6u);
+
+		/**
+		* @brief Sync releases untouched keys.
+		*/
+		m_Table->BeginSync();
+		for (const uint64_t key : { 0, 1, 3 })
+		{
+			m_Table->Acquire(key);
+		}
+		m_Table->EndSync();
+
+		EXPECT_EQ(m_Table->GetSequenceCount(), 3u);
+		m_Table->Commit();
+		ExpectDeviceEqualsHost();
+
+		std::vector<uint64_t> values;
+		for (uint32_t slot = 0; slot < 3; slot++) values.push_back(GetDeviceSequence(slot));
+		std::sort(values.begin(), values.end());
+		EXPECT_EQ(values, std::vector<uint64_t>({ 0, 1, 3 }));
+	}
+
+	/**
+	* @brief Testing random spawn, despawn and edits against a reference.
+	*/
+	TEST_F(dgc_sequence_table_test, Random) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::mt19937 random(11);
+		std::unordered_map<uint64_t, uint64_t> reference;
+
+		for (int frame = 0; frame < 300; frame++)
+		{
+			const int nOps = random() % 20;
+			for (int op = 0; op < nOps; op++)
+			{
+				const uint64_t key = random() % 200;
+
+				switch (random() % 3)
+				{
+				case 0:
+					m_Table->Release(key);
+					reference.erase(key);
+					break;
+				default:
+					const uint64_t value = random();
+					SetSequence(m_Table->Acquire(key), value);
+					reference[key] = value;
+					break;
+				}
+			}
+
+			m_Table->Commit();
+
+			ASSERT_EQ(m_Table->GetSequenceCount(), reference.size());
+			ExpectDeviceEqualsHost();
+
+			for (const auto& [key, value] : reference)
+			{
+				const uint32_t slot = m_Table->GetSlot(key);
+				ASSERT_LT(slot, m_Table->GetSequenceCount());
+				ASSERT_EQ(GetDeviceSequence(slot), value);
+			}
+		}
+	}
+}
@@ -0,0 +1,195 @@
+/**
+* @file SecondaryCmdCache_test.h.
+* @brief The SecondaryCmdCache_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Render/Vulkan/SecondaryCmdCache.h>
+#include "Instrumentor.h"
+
+#include <thread>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for SecondaryCmdCache.
+	*/
+	class secondary_cmd_cache_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {
+
+			/**
+			* @brief Command buffers are fake handles counted from 1.
+			*/
+			m_Cache = std::make_unique<Spices::SecondaryCmdCache>(
+				[this]() {
+					m_Allocated++;
+					return reinterpret_cast<VkCommandBuffer>(m_Allocated);
+				},
+				[this](VkCommandBuffer cmdBuffer) {
+					m_Freed.push_back(reinterpret_cast<uintptr_t>(cmdBuffer));
+				}
+			);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {
+
+			m_Cache.reset();
+		}
+
+		/**
+		* @brief Get a command buffer, counts recordings.
+		* @param[in] key Subpass key.
+		* @param[in] frameIndex Frame in flight index.
+		* @param[in] hash Content hash.
+		* @return Returns the command buffer.
+		*/
+		VkCommandBuffer Get(const std::string& key, uint32_t frameIndex, uint64_t hash)
+		{
+			return m_Cache->Get(key, frameIndex, hash, [&](VkCommandBuffer cmdBuffer) {
+				m_Recorded++;
+			});
+		}
+
+		std::unique_ptr<Spices::SecondaryCmdCache>  m_Cache;              /* @brief The cache.                */
+		uintptr_t                                   m_Allocated = 0;      /* @brief Allocated buffers count.  */
+		std::vector<uintptr_t>                      m_Freed;              /* @brief Freed buffers.            */
+		uint32_t                                    m_Recorded  = 0;      /* @brief Recordings count.         */
+	};
+
+	/**
+	* @brief Testing if ContentHash depends on values and order.
+	*/
+	TEST_F(secondary_cmd_cache_test, ContentHash) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const uint64_t a = Spices::ContentHash().Add(1u).Add(2u).Get();
+		const uint64_t b = Spices::ContentHash().Add(1u).Add(2u).Get();
+		const uint64_t c = Spices::ContentHash().Add(2u).Add(1u).Get();
+		const uint64_t d = Spices::ContentHash().Add(std::string("ab")).Add(std::string("c")).Get();
+		const uint64_t e = Spices::ContentHash().Add(std::string("a")).Add(std::string("bc")).Get();
+
+		EXPECT_EQ(a, b);
+		EXPECT_NE(a, c);
+		EXPECT_NE(d, e);
+		EXPECT_NE(Spices::ContentHash().Get(), a);
+	}
+
+	/**
+	* @brief Testing if a command buffer is recorded once per frame in flight and reused.
+	*/
+	TEST_F(secondary_cmd_cache_test, Reuse) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const VkCommandBuffer frame0 = Get("BasePassRenderer.Mesh", 0, 42);
+		const VkCommandBuffer frame1 = Get("BasePassRenderer.Mesh", 1, 42);
+
+		EXPECT_NE(frame0, frame1);
+		EXPECT_EQ(m_Recorded, 2u);
+
+		for (int i = 0; i < 10; i++)
+		{
+			EXPECT_EQ(Get("BasePassRenderer.Mesh", i % 2, 42), i % 2 ? frame1 : frame0);
+		}
+
+		EXPECT_EQ(m_Recorded,                  2u);
+		EXPECT_EQ(m_Cache->GetStats().hits,    10u);
+		EXPECT_EQ(m_Cache->GetStats().misses,  2u);
+
+		/**
+		* @brief Changed hash records again into the same command buffer.
+		*/
+		EXPECT_EQ(Get("BasePassRenderer.Mesh", 0, 43), frame0);
+		EXPECT_EQ(m_Recorded, 3u);
+		EXPECT_EQ(Get("BasePassRenderer.Mesh", 1, 43), frame1);
+		EXPECT_EQ(m_Recorded, 4u);
+
+		/**
+		* @brief Other key owns its command buffers.
+		*/
+		EXPECT_NE(Get("BasePassRenderer.SkyBox", 0, 43), frame0);
+		EXPECT_EQ(m_Cache->GetCommandBufferCount(), 3u);
+	}
+
+	/**
+	* @brief Testing if invalidated entries are recorded again and buffers are freed.
+	*/
+	TEST_F(secondary_cmd_cache_test, Invalidate) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Get("A", 0, 1);
+		Get("B", 0, 1);
+		EXPECT_EQ(m_Recorded, 2u);
+
+		m_Cache->Invalidate("A");
+		Get("A", 0, 1);
+		Get("B", 0, 1);
+		EXPECT_EQ(m_Recorded, 3u);
+
+		m_Cache->Invalidate();
+		Get("A", 0, 1);
+		Get("B", 0, 1);
+		EXPECT_EQ(m_Recorded, 5u);
+
+		m_Cache->Invalidate("C");
+		EXPECT_EQ(m_Cache->GetCommandBufferCount(), 2u);
+
+		m_Cache.reset();
+
+		std::sort(m_Freed.begin(), m_Freed.end());
+		EXPECT_EQ(m_Freed, std::vector<uintptr_t>({ 1, 2 }));
+	}
+
+	/**
+	* @brief Testing recording time saved in a static scene.
+	*/
+	TEST_F(secondary_cmd_cache_test, StaticScene) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const uint32_t nFrames         = 100;
+		const uint32_t nFramesInFlight = 2;
+
+		for (uint32_t frame = 0; frame < nFrames; frame++)
+		{
+			m_Cache->Get("BasePassRenderer.Mesh", frame % nFramesInFlight, 7, [&](VkCommandBuffer cmdBuffer) {
+				std::this_thread::sleep_for(std::chrono::microseconds(500));
+			});
+		}
+
+		const auto& stats = m_Cache->GetStats();
+
+		EXPECT_EQ(stats.misses, nFramesInFlight);
+		EXPECT_EQ(stats.hits,   nFrames - nFramesInFlight);
+
+		/**
+		* @brief Every hit saves the recording time of its frame in flight, hits are even among frames.
+		*/
+		const double expectSaved = stats.recordMs * (nFrames - nFramesInFlight) / nFramesInFlight;
+
+		EXPECT_NEAR(stats.savedMs, expectSaved, 1e-6);
+		EXPECT_GE(stats.recordMs, 1.0);
+		EXPECT_GT(stats.savedMs, stats.recordMs * 10.0);
+
+		std::stringstream ss;
+		ss << "Static scene: " << stats.recordMs << " ms recorded, " << stats.savedMs << " ms saved.";
+		std::cout << ss.str() << std::endl;
+
+		m_Cache->ResetStats();
+		EXPECT_EQ(m_Cache->GetStats().hits, 0u);
+	}
+}
@@ -0,0 +1,508 @@
+/**
+* @file GltfImporter_test.h.
+* @brief The GltfImporter_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Resources/Loader/GltfImporter.h>
+#include <Resources/Loader/ObjParser.h>
+#include <Core/Thread/ThreadPool.h>
+#include "Instrumentor.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for GltfImporter.
+	*/
+	class GltfImporter_test : public testing::Test
+	{
+	protected:
+
+		using Importer = Spices::GltfImporter;
+
+		/**
+		* @brief Read arrays.
+		*/
+		struct Mesh
+		{
+			std::vector<glm::vec3>  positions;
+			std::vector<glm::vec3>  normals;
+			std::vector<glm::vec3>  colors;
+			std::vector<glm::vec2>  texCoords;
+			std::vector<glm::uvec4> vertices;
+			std::vector<glm::uvec3> primitiveVertices;
+
+			Importer::Output GetOutput()
+			{
+				return Importer::Output{ &positions, &normals, &colors, &texCoords, &vertices, &primitiveVertices };
+			}
+		};
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override
+		{
+			m_Root = (std::filesystem::temp_directory_path() / "SpicesGltfImporterTest").generic_string() + "/";
+			std::filesystem::remove_all(m_Root);
+			std::filesystem::create_directories(m_Root);
+
+			m_ThreadPool.SetMode(Spices::PoolMode::MODE_FIXED);
+			m_ThreadPool.Start(4);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_Root);
+		}
+
+		/**
+		* @brief Append a buffer view to BIN chunk.
+		* @param[in] data View bytes.
+		* @param[in] size Bytes count.
+		* @param[in] stride Byte stride, 0 for none.
+		* @return Returns the view index.
+		*/
+		uint32_t AddView(const void* data, size_t size, uint32_t stride = 0)
+		{
+			while (m_Bin.size() % 4) m_Bin.push_back('\0');
+
+			std::stringstream ss;
+			ss << "{\"buffer\":0,\"byteOffset\":" << m_Bin.size() << ",\"byteLength\":" << size;
+			if (stride) ss << ",\"byteStride\":" << stride;
+			ss << "}";
+
+			m_Bin.append(static_cast<const char*>(data), size);
+			m_Views.push_back(ss.str());
+
+			return static_cast<uint32_t>(m_Views.size() - 1);
+		}
+
+		/**
+		* @brief Append a vector as a buffer view.
+		*/
+		template<typename T>
+		uint32_t AddView(const std::vector<T>& data, uint32_t stride = 0)
+		{
+			return AddView(data.data(), data.size() * sizeof(T), stride);
+		}
+
+		/**
+		* @brief Append an accessor.
+		* @param[in] json Accessor JSON.
+		* @return Returns the accessor index.
+		*/
+		uint32_t AddAccessor(const std::string& json)
+		{
+			m_Accessors.push_back(json);
+			return static_cast<uint32_t>(m_Accessors.size() - 1);
+		}
+
+		/**
+		* @brief Build a glb from added views and accessors.
+		* @param[in] meshes Meshes JSON array.
+		* @return Returns the glb bytes.
+		*/
+		std::string Build(const std::string& meshes) const
+		{
+			const auto join = [](const std::vector<std::string>& items) {
+				std::string s;
+				for (size_t i = 0; i < items.size(); i++) s += (i ? "," : "") + items[i];
+				return s;
+			};
+
+			std::string json =
+				"{\"asset\":{\"version\":\"2.0\"},"
+				"\"buffers\":[{\"byteLength\":" + std::to_string(m_Bin.size()) + "}],"
+				"\"bufferViews\":[" + join(m_Views) + "],"
+				"\"accessors\":[" + join(m_Accessors) + "],"
+				"\"meshes\":" + meshes + "}";
+			while (json.size() % 4) json.push_back(' ');
+
+			std::string bin = m_Bin;
+			while (bin.size() % 4) bin.push_back('\0');
+
+			std::string glb;
+			const auto u32 = [&](uint32_t v) { glb.append(reinterpret_cast<const char*>(&v), sizeof(uint32_t)); };
+
+			u32(Importer::Magic);
+			u32(Importer::Version);
+			u32(static_cast<uint32_t>(12 + 8 + json.size() + 8 + bin.size()));
+			u32(static_cast<uint32_t>(json.size()));
+			u32(0x4E4F534A);
+			glb += json;
+			u32(static_cast<uint32_t>(bin.size()));
+			u32(0x004E4942);
+			glb += bin;
+
+			return glb;
+		}
+
+		/**
+		* @brief Write a file.
+		* @param[in] name File name.
+		* @param[in] data File data.
+		* @return Returns the file path.
+		*/
+		std::string WriteFile(const std::string& name, const std::string& data) const
+		{
+			const std::string path = m_Root + name;
+			std::ofstream(path, std::ios::binary) << data;
+			return path;
+		}
+
+		/**
+		* @brief Add a n * n quads grid primitive.
+		* @return Returns the primitive JSON.
+		*/
+		std::string AddGrid(uint32_t n)
+		{
+			std::vector<glm::vec3> positions;
+			std::vector<glm::vec3> normals;
+			std::vector<glm::vec2> texCoords;
+			std::vector<uint32_t>  indices;
+
+			for (uint32_t y = 0; y <= n; y++)
+			{
+				for (uint32_t x = 0; x <= n; x++)
+				{
+					positions.push_back(glm::vec3(float(x), float(y), 0.0f));
+					normals  .push_back(glm::vec3(0.0f, 0.0f, 1.0f));
+					texCoords.push_back(glm::vec2(x / float(n), y / float(n)));
+				}
+			}
+			for (uint32_t y = 0; y < n; y++)
+			{
+				for (uint32_t x = 0; x < n; x++)
+				{
+					const uint32_t i = y * (n + 1) + x;
+					for (const uint32_t index : { i, i + 1, i + n + 2, i, i + n + 2, i + n + 1 }) indices.push_back(index);
+				}
+			}
+
+			const std::string count  = std::to_string(positions.size());
+			const uint32_t position  = AddAccessor("{\"bufferView\":" + std::to_string(AddView(positions)) + ",\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC3\"}");
+			const uint32_t normal    = AddAccessor("{\"bufferView\":" + std::to_string(AddView(normals))   + ",\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC3\"}");
+			const uint32_t texCoord  = AddAccessor("{\"bufferView\":" + std::to_string(AddView(texCoords)) + ",\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC2\"}");
+			const uint32_t index     = AddAccessor("{\"bufferView\":" + std::to_string(AddView(indices))   + ",\"componentType\":5125,\"count\":" + std::to_string(indices.size()) + ",\"type\":\"SCALAR\"}");
+
+			return "{\"attributes\":{\"POSITION\":" + std::to_string(position) + ",\"NORMAL\":" + std::to_string(normal) +
+			       ",\"TEXCOORD_0\":" + std::to_string(texCoord) + "},\"indices\":" + std::to_string(index) + "}";
+		}
+
+		std::string m_Root;                         /* @brief Temp folder.                  */
+		std::string m_Bin;                          /* @brief BIN chunk being built.        */
+		std::vector<std::string> m_Views;           /* @brief Buffer views JSON.            */
+		std::vector<std::string> m_Accessors;       /* @brief Accessors JSON.               */
+		Spices::ThreadPool m_ThreadPool;            /* @brief ThreadPool.                   */
+	};
+
+	/**
+	* @brief Testing a tightly packed indexed primitive.
+	*/
+	TEST_F(GltfImporter_test, Read) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::vector<glm::vec3> positions = { { 0, 0, 1 }, { 1, 0, 2 }, { 1, 1, 3 }, { 0, 1, 4 } };
+		const std::vector<glm::vec3> normals   = { { 0, 0, 1 }, { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, -1 } };
+		const std::vector<glm::vec2> texCoords = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+		const std::vector<uint16_t>  indices   = { 0, 1, 2, 0, 2, 3 };
+
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(positions)) + ",\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"}");
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(normals))   + ",\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"}");
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(texCoords)) + ",\"componentType\":5126,\"count\":4,\"type\":\"VEC2\"}");
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(indices))   + ",\"componentType\":5123,\"count\":6,\"type\":\"SCALAR\"}");
+
+		const std::string glb = Build("[{\"name\":\"Quad\",\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3,\"mode\":4}]}]");
+
+		Importer importer;
+		EXPECT_TRUE(importer.Open(glb.data(), glb.size()));
+		EXPECT_EQ(importer.GetPrimitives().size(), 1);
+		EXPECT_EQ(importer.GetPrimitives()[0].mesh, "Quad");
+
+		Mesh mesh;
+		Importer::Stats stats;
+		EXPECT_TRUE(importer.Read(0, mesh.GetOutput(), &stats));
+
+		EXPECT_THAT(mesh.positions, testing::ElementsAre(glm::vec3(0, 0, -1), glm::vec3(1, 0, -2), glm::vec3(1, 1, -3), glm::vec3(0, 1, -4)));
+		EXPECT_THAT(mesh.normals,   testing::ElementsAre(glm::vec3(0, 0, -1), glm::vec3(0, 1,  0), glm::vec3(1, 0,  0), glm::vec3(0, 0,  1)));
+		EXPECT_EQ  (mesh.texCoords, texCoords);
+		EXPECT_EQ  (mesh.colors,    std::vector<glm::vec3>(4, glm::vec3(1.0f)));
+		EXPECT_THAT(mesh.vertices,  testing::ElementsAre(glm::uvec4(0, 0, 0, 0), glm::uvec4(1, 1, 1, 1), glm::uvec4(2, 2, 2, 2), glm::uvec4(3, 3, 3, 3)));
+		EXPECT_THAT(mesh.primitiveVertices, testing::ElementsAre(glm::uvec3(0, 1, 2), glm::uvec3(0, 2, 3)));
+
+		EXPECT_EQ(stats.vertices,  4);
+		EXPECT_EQ(stats.triangles, 2);
+		EXPECT_EQ(stats.bytes,     4 * 12 + 4 * 12 + 4 * 8 + 6 * 2);
+	}
+
+	/**
+	* @brief Testing strided views, normalized integers, sparse accessors and accessors without view.
+	*/
+	TEST_F(GltfImporter_test, Accessors) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		/**
+		* @brief Interleaved position and a padding float.
+		*/
+		const std::vector<float> interleaved = {
+			0, 0, 0, 9,
+			1, 0, 0, 9,
+			0, 1, 0, 9,
+		};
+
+		const std::vector<uint8_t>  texCoords      = { 0, 0, 0, 0, 255, 0, 0, 0, 0, 255, 0, 0 };
+		const std::vector<uint8_t>  colors         = { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255 };
+		const std::vector<uint8_t>  sparseIndices  = { 2 };
+		const std::vector<float>    sparseValues   = { 5, 6, 7 };
+		const std::vector<uint16_t> normalIndices  = { 0, 2 };
+		const std::vector<int16_t>  normalValues   = { 0, 32767, 0, 0, 0, -32768 };
+
+		const uint32_t positionView = AddView(interleaved, 16);
+		const uint32_t texCoordView = AddView(texCoords, 4);
+		const uint32_t colorView    = AddView(colors);
+		const uint32_t indexView    = AddView(sparseIndices);
+		const uint32_t valueView    = AddView(sparseValues);
+		const uint32_t nIndexView   = AddView(normalIndices);
+		const uint32_t nValueView   = AddView(normalValues);
+
+		AddAccessor("{\"bufferView\":" + std::to_string(positionView) + ",\"componentType\":5126,\"count\":3,\"type\":\"VEC3\","
+		            "\"sparse\":{\"count\":1,\"indices\":{\"bufferView\":" + std::to_string(indexView) + ",\"componentType\":5121},"
+		            "\"values\":{\"bufferView\":" + std::to_string(valueView) + "}}}");
+		AddAccessor("{\"componentType\":5122,\"normalized\":true,\"count\":3,\"type\":\"VEC3\","
+		            "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":" + std::to_string(nIndexView) + ",\"componentType\":5123},"
+		            "\"values\":{\"bufferView\":" + std::to_string(nValueView) + "}}}");
+		AddAccessor("{\"bufferView\":" + std::to_string(texCoordView) + ",\"componentType\":5121,\"normalized\":true,\"count\":3,\"type\":\"VEC2\"}");
+		AddAccessor("{\"bufferView\":" + std::to_string(colorView)    + ",\"componentType\":5121,\"normalized\":true,\"count\":3,\"type\":\"VEC4\"}");
+
+		const std::string glb = Build("[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2,\"COLOR_0\":3}}]}]");
+
+		Importer importer;
+		EXPECT_TRUE(importer.Open(glb.data(), glb.size()));
+		EXPECT_EQ(importer.GetPrimitives()[0].mesh, "0");
+
+		Mesh mesh;
+		EXPECT_TRUE(importer.Read(0, mesh.GetOutput()));
+
+		EXPECT_THAT(mesh.positions, testing::ElementsAre(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(5, 6, -7)));
+		EXPECT_THAT(mesh.normals,   testing::ElementsAre(glm::vec3(0, 1, 0), glm::vec3(0, 0, 0), glm::vec3(0, 0, 1)));
+		EXPECT_THAT(mesh.texCoords, testing::ElementsAre(glm::vec2(0, 0), glm::vec2(1, 0), glm::vec2(0, 1)));
+		EXPECT_THAT(mesh.colors,    testing::ElementsAre(glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, 1)));
+		EXPECT_THAT(mesh.primitiveVertices, testing::ElementsAre(glm::uvec3(0, 1, 2)));
+	}
+
+	/**
+	* @brief Testing triangle strips and fans.
+	*/
+	TEST_F(GltfImporter_test, Modes) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::vector<glm::vec3> positions(5, glm::vec3(0.0f));
+		const std::vector<uint8_t>   indices = { 4, 3, 2, 1, 0 };
+
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(positions)) + ",\"componentType\":5126,\"count\":5,\"type\":\"VEC3\"}");
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(indices))   + ",\"componentType\":5121,\"count\":5,\"type\":\"SCALAR\"}");
+
+		const std::string glb = Build("[{\"primitives\":["
+			"{\"attributes\":{\"POSITION\":0},\"mode\":5},"
+			"{\"attributes\":{\"POSITION\":0},\"mode\":6,\"indices\":1}"
+		"]}]");
+
+		Importer importer;
+		EXPECT_TRUE(importer.Open(glb.data(), glb.size()));
+		EXPECT_EQ(importer.GetPrimitives().size(), 2);
+
+		Mesh strip;
+		EXPECT_TRUE(importer.Read(0, strip.GetOutput()));
+		EXPECT_THAT(strip.primitiveVertices, testing::ElementsAre(glm::uvec3(0, 1, 2), glm::uvec3(2, 1, 3), glm::uvec3(2, 3, 4)));
+		EXPECT_TRUE(strip.normals.empty());
+		EXPECT_TRUE(strip.texCoords.empty());
+
+		Mesh fan;
+		EXPECT_TRUE(importer.Read(1, fan.GetOutput()));
+		EXPECT_THAT(fan.primitiveVertices, testing::ElementsAre(glm::uvec3(3, 2, 4), glm::uvec3(2, 1, 4), glm::uvec3(1, 0, 4)));
+	}
+
+	/**
+	* @brief Testing primitives of many meshes read in parallel from a file.
+	*/
+	TEST_F(GltfImporter_test, Meshes) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		std::string meshes = "[";
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			meshes += (i ? "," : "") + std::string("{\"name\":\"Grid") + std::to_string(i) + "\",\"primitives\":[" + AddGrid(i + 1) + "," + AddGrid(2 * i + 1) + "]}";
+		}
+		meshes += "]";
+
+		const std::string path = WriteFile("Meshes.glb", Build(meshes));
+
+		Importer importer;
+		EXPECT_TRUE(importer.Open(path));
+		EXPECT_EQ(importer.GetPrimitives().size(), 32);
+		EXPECT_EQ(importer.GetPrimitives()[5].mesh,           "Grid2");
+		EXPECT_EQ(importer.GetPrimitives()[5].meshIndex,      2);
+		EXPECT_EQ(importer.GetPrimitives()[5].primitiveIndex, 1);
+
+		std::vector<Mesh> meshs(32);
+		std::vector<Importer::Output> outputs;
+		for (auto& mesh : meshs) outputs.push_back(mesh.GetOutput());
+
+		std::atomic<uint32_t> count = 0;
+		EXPECT_TRUE(importer.ReadAll(outputs, [&](uint32_t) { ++count; }, &m_ThreadPool));
+		EXPECT_EQ(count, 32);
+
+		for (uint32_t i = 0; i < 32; i++)
+		{
+			const uint32_t quads = i % 2 == 0 ? i / 2 + 1 : i;
+			EXPECT_EQ(meshs[i].primitiveVertices.size(), 2 * quads * quads);
+			EXPECT_EQ(meshs[i].positions.size(), (quads + 1) * (quads + 1));
+		}
+	}
+
+	/**
+	* @brief Testing invalid files are rejected.
+	*/
+	TEST_F(GltfImporter_test, Invalid) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::vector<glm::vec3> positions(3, glm::vec3(0.0f));
+		const std::vector<uint32_t>  indices = { 0, 1, 3 };
+
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(positions)) + ",\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}");
+		AddAccessor("{\"bufferView\":" + std::to_string(AddView(indices))   + ",\"componentType\":5125,\"count\":3,\"type\":\"SCALAR\"}");
+		AddAccessor("{\"bufferView\":0,\"byteOffset\":4,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}");
+		AddAccessor("{\"bufferView\":9,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}");
+
+		const std::string glb = Build("[{\"primitives\":["
+			"{\"attributes\":{\"POSITION\":0}},"
+			"{\"attributes\":{\"POSITION\":0},\"indices\":1},"
+			"{\"attributes\":{\"POSITION\":2}},"
+			"{\"attributes\":{\"POSITION\":3}},"
+			"{\"attributes\":{\"POSITION\":0},\"mode\":0},"
+			"{\"attributes\":{\"NORMAL\":0}}"
+		"]}]");
+
+		Importer importer;
+		EXPECT_TRUE(importer.Open(glb.data(), glb.size()));
+
+		Mesh mesh;
+		EXPECT_TRUE (importer.Read(0, mesh.GetOutput()));
+		EXPECT_FALSE(importer.Read(1, mesh.GetOutput()));
+		EXPECT_FALSE(importer.Read(2, mesh.GetOutput()));
+		EXPECT_FALSE(importer.Read(3, mesh.GetOutput()));
+		EXPECT_FALSE(importer.Read(4, mesh.GetOutput()));
+		EXPECT_FALSE(importer.Read(5, mesh.GetOutput()));
+		EXPECT_FALSE(importer.Read(6, mesh.GetOutput()));
+
+		std::string badMagic = glb;
+		badMagic[0] = 'x';
+		EXPECT_FALSE(importer.Open(badMagic.data(), badMagic.size()));
+
+		EXPECT_FALSE(importer.Open(glb.data(), glb.size() - 4));
+		EXPECT_FALSE(importer.Open(glb.data(), 16));
+
+		std::string badJson = glb;
+		badJson[20] = '[';
+		EXPECT_FALSE(importer.Open(badJson.data(), badJson.size()));
+
+		EXPECT_FALSE(importer.Open(m_Root + "None.glb"));
+		EXPECT_TRUE(importer.GetPrimitives().empty());
+	}
+
+	/**
+	* @brief Throughput of grids, GltfImporter against ObjParser of the same geometry.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(GltfImporter_test, DISABLED_Throughput) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nMeshes = 16;
+		constexpr uint32_t n       = 256;
+
+		std::string meshes = "[";
+		for (uint32_t i = 0; i < nMeshes; i++)
+		{
+			meshes += (i ? "," : "") + std::string("{\"primitives\":[") + AddGrid(n) + "]}";
+		}
+		meshes += "]";
+
+		const std::string glbPath = WriteFile("Benchmark.glb", Build(meshes));
+
+		std::stringstream obj;
+		for (uint32_t i = 0; i < nMeshes; i++)
+		{
+			const uint32_t base = i * (n + 1) * (n + 1) + 1;
+			for (uint32_t y = 0; y <= n; y++)
+			{
+				for (uint32_t x = 0; x <= n; x++)
+				{
+					obj << "v " << x << " " << y << " 0\nvn 0 0 1\nvt " << x / float(n) << " " << y / float(n) << "\n";
+				}
+			}
+			for (uint32_t y = 0; y < n; y++)
+			{
+				for (uint32_t x = 0; x < n; x++)
+				{
+					const uint32_t c = base + y * (n + 1) + x;
+					obj << "f " << c << "/" << c << "/" << c << " " << c + 1 << "/" << c + 1 << "/" << c + 1 << " "
+					    << c + n + 2 << "/" << c + n + 2 << "/" << c + n + 2 << " " << c + n + 1 << "/" << c + n + 1 << "/" << c + n + 1 << "\n";
+				}
+			}
+		}
+		const std::string objPath = WriteFile("Benchmark.obj", obj.str());
+
+		const auto run = [&](const char* name, const std::string& path, const std::function<void()>& func) {
+			const uint64_t bytes = std::filesystem::file_size(path);
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			func();
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+			std::cout << "GltfImporter " << name << ": " << bytes / (1024.0 * 1024.0) << " MB, " << ms << " ms, "
+			          << nMeshes * n * n * 2 / (ms / 1000.0) / 1.0e6 << " M triangles/s." << std::endl;
+		};
+
+		run("ObjParser 4 threads", objPath, [&]() {
+			Mesh mesh;
+			const Spices::ObjParser::Output output{ &mesh.positions, &mesh.normals, &mesh.colors, &mesh.texCoords, &mesh.vertices, &mesh.primitiveVertices };
+			EXPECT_TRUE(Spices::ObjParser::Parse(objPath, output, &m_ThreadPool));
+			EXPECT_EQ(mesh.primitiveVertices.size(), nMeshes * n * n * 2);
+		});
+
+		for (auto* pool : { static_cast<Spices::ThreadPool*>(nullptr), &m_ThreadPool })
+		{
+			run(pool ? "glb 4 threads" : "glb 1 thread", glbPath, [&]() {
+				Importer importer;
+				EXPECT_TRUE(importer.Open(glbPath));
+
+				std::vector<Mesh> meshs(nMeshes);
+				std::vector<Importer::Output> outputs;
+				for (auto& mesh : meshs) outputs.push_back(mesh.GetOutput());
+
+				EXPECT_TRUE(importer.ReadAll(outputs, nullptr, pool));
+
+				uint64_t triangles = 0;
+				for (auto& mesh : meshs) triangles += mesh.primitiveVertices.size();
+				EXPECT_EQ(triangles, nMeshes * n * n * 2);
+			});
+		}
+	}
+}
@@ -0,0 +1,381 @@
+/**
+* @file ObjParser_test.h.
+* @brief The ObjParser_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Resources/Loader/ObjParser.h>
+#include <Core/Thread/ThreadPool.h>
+#include "Instrumentor.h"
+
+#include <tiny_obj_loader.h>
+#include <filesystem>
+#include <fstream>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for ObjParser.
+	*/
+	class ObjParser_test : public testing::Test
+	{
+	protected:
+
+		/**
+		* @brief Parsed arrays.
+		*/
+		struct Mesh
+		{
+			std::vector<glm::vec3>  positions;
+			std::vector<glm::vec3>  normals;
+			std::vector<glm::vec3>  colors;
+			std::vector<glm::vec2>  texCoords;
+			std::vector<glm::uvec4> vertices;
+			std::vector<glm::uvec3> primitiveVertices;
+
+			Spices::ObjParser::Output GetOutput()
+			{
+				return Spices::ObjParser::Output{ &positions, &normals, &colors, &texCoords, &vertices, &primitiveVertices };
+			}
+		};
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override
+		{
+			m_Root = (std::filesystem::temp_directory_path() / "SpicesObjParserTest").generic_string() + "/";
+			std::filesystem::remove_all(m_Root);
+			std::filesystem::create_directories(m_Root);
+
+			m_ThreadPool.SetMode(Spices::PoolMode::MODE_FIXED);
+			m_ThreadPool.Start(4);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_Root);
+		}
+
+		/**
+		* @brief Write a file.
+		* @param[in] name File name.
+		* @param[in] data File data.
+		* @return Returns the file path.
+		*/
+		std::string WriteFile(const std::string& name, const std::string& data) const
+		{
+			const std::string path = m_Root + name;
+			std::ofstream(path, std::ios::binary) << data;
+			return path;
+		}
+
+		/**
+		* @brief A grid of quads with shared corners.
+		* @param[in] n Quads per side.
+		* @return Returns OBJ text.
+		*/
+		static std::string Grid(uint32_t n)
+		{
+			std::stringstream ss;
+			ss << "# grid\no grid\n";
+
+			for (uint32_t y = 0; y <= n; y++)
+			{
+				for (uint32_t x = 0; x <= n; x++)
+				{
+					ss << "v " << x * 0.125f << " " << (x ^ y) % 7 * 0.25f << " " << y * -0.5f << "\n";
+					ss << "vt " << x / float(n) << " " << y / float(n) << "\n";
+				}
+			}
+			ss << "vn 0 1 0\nvn 0.5 0.5 -0.25\n";
+
+			for (uint32_t y = 0; y < n; y++)
+			{
+				for (uint32_t x = 0; x < n; x++)
+				{
+					const uint32_t i = y * (n + 1) + x + 1;
+					const uint32_t j = i + n + 1;
+
+					ss << "f " << i << "/" << i << "/" << 1 + (x & 1) << " " << i + 1 << "/" << i + 1 << "/1 "
+					   << j + 1 << "/" << j + 1 << "/2 " << j << "/" << j << "/1\n";
+				}
+			}
+
+			return ss.str();
+		}
+
+		/**
+		* @brief Load with tinyobj, same as MeshLoader did before ObjParser.
+		* @param[in] path The file path.
+		* @param[out] outMesh Arrays.
+		* @return Returns true if succeed.
+		*/
+		static bool LoadTinyObj(const std::string& path, Mesh& outMesh)
+		{
+			tinyobj::attrib_t attrib;
+			std::vector<tinyobj::shape_t> shapes;
+			std::vector<tinyobj::material_t> materials;
+			std::string warn, err;
+
+			if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str())) return false;
+
+			for (size_t i = 0; i < attrib.vertices.size() / 3; i++)
+			{
+				outMesh.positions.emplace_back(attrib.vertices[3 * i], attrib.vertices[3 * i + 1], -attrib.vertices[3 * i + 2]);
+			}
+			for (size_t i = 0; i < attrib.normals.size() / 3; i++)
+			{
+				outMesh.normals.emplace_back(attrib.normals[3 * i], attrib.normals[3 * i + 1], -attrib.normals[3 * i + 2]);
+			}
+			for (size_t i = 0; i < attrib.colors.size() / 3; i++)
+			{
+				outMesh.colors.emplace_back(attrib.colors[3 * i], attrib.colors[3 * i + 1], attrib.colors[3 * i + 2]);
+			}
+			for (size_t i = 0; i < attrib.texcoords.size() / 2; i++)
+			{
+				outMesh.texCoords.emplace_back(attrib.texcoords[2 * i], 1.0f - attrib.texcoords[2 * i + 1]);
+			}
+
+			struct Hash
+			{
+				size_t operator()(const glm::uvec4& v) const { return std::hash<uint64_t>()((uint64_t(v.x) << 40) ^ (uint64_t(v.y) << 20) ^ v.w); }
+			};
+
+			std::unordered_map<glm::uvec4, uint32_t, Hash> verticesMap;
+			for (const auto& shape : shapes)
+			{
+				for (size_t i = 0; i < shape.mesh.indices.size() / 3; i++)
+				{
+					glm::uvec3 primitive;
+					for (int j = 0; j < 3; j++)
+					{
+						const auto& index = shape.mesh.indices[3 * i + j];
+
+						const glm::uvec4 vertex(
+							index.vertex_index   == -1 ? 0 : index.vertex_index,
+							index.normal_index   == -1 ? 0 : index.normal_index,
+							index.vertex_index   == -1 ? 0 : index.vertex_index,
+							index.texcoord_index == -1 ? 0 : index.texcoord_index
+						);
+
+						auto it = verticesMap.find(vertex);
+						if (it == verticesMap.end())
+						{
+							it = verticesMap.emplace(vertex, static_cast<uint32_t>(outMesh.vertices.size())).first;
+							outMesh.vertices.push_back(vertex);
+						}
+
+						primitive[j] = it->second;
+					}
+
+					outMesh.primitiveVertices.push_back(primitive);
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		* @brief Compare two meshes, floats differ by parsing.
+		*/
+		static void ExpectEqual(const Mesh& l, const Mesh& r)
+		{
+			const auto near = [](const auto& a, const auto& b) {
+				ASSERT_EQ(a.size(), b.size());
+				for (size_t i = 0; i < a.size(); i++)
+				{
+					for (int k = 0; k < a[i].length(); k++)
+					{
+						ASSERT_NEAR(a[i][k], b[i][k], 1e-5f * std::max(1.0f, std::abs(a[i][k])));
+					}
+				}
+			};
+
+			near(l.positions, r.positions);
+			near(l.normals,   r.normals  );
+			near(l.colors,    r.colors   );
+			near(l.texCoords, r.texCoords);
+
+			EXPECT_TRUE(l.vertices          == r.vertices         );
+			EXPECT_TRUE(l.primitiveVertices == r.primitiveVertices);
+		}
+
+		std::string m_Root;                      /* @brief Temp folder.    */
+		Spices::ThreadPool m_ThreadPool;         /* @brief ThreadPool.     */
+	};
+
+	/**
+	* @brief Testing same output as tinyobj path.
+	*/
+	TEST_F(ObjParser_test, MatchTinyObj) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string obj =
+			"# comment\r\n"
+			"v 0 0 0 1 0 0\n"
+			"v 1.5 0 -2e-1 0 1 0\n"
+			"v  1 1 0 0 0 1\n"
+			"\tv 0 1 +3 0.5 0.5 0.5\r\n"
+			"v -1 2 1 1 1 1\n"
+			"vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+			"vn 0 0 1\nvn 0 1 0\n"
+			"\n"
+			"o a\n"
+			"usemtl none\n"
+			"f 1/1/1 2/2/1 3/3/1\n"
+			"f 1/1/1 2/2/1 3/3/1 4/4/2\r\n"
+			"g b\n"
+			"f -5/-4/-2 -4/-3/-2 -2/-1/-1\n"
+			"f 1//2 3//2 5//1\n"
+			"f 2/3 3/4 5/1\n"
+			"f 1 2 5\n"
+			"f 1 2\n"
+			"s off\n"
+			"f 3/3/1 4/4/1 2/2/1 1/1/2\n";
+
+		const std::string path = WriteFile("Match.obj", obj);
+
+		Mesh expected;
+		EXPECT_TRUE(LoadTinyObj(path, expected));
+
+		for (Spices::ThreadPool* threadPool : { static_cast<Spices::ThreadPool*>(nullptr), &m_ThreadPool })
+		{
+			Mesh mesh;
+			Spices::ObjParser::Stats stats;
+
+			EXPECT_TRUE(Spices::ObjParser::Parse(path, mesh.GetOutput(), threadPool, &stats));
+			ExpectEqual(mesh, expected);
+
+			EXPECT_EQ(stats.faces,     7);
+			EXPECT_EQ(stats.triangles, 9);
+			EXPECT_EQ(stats.vertices,  mesh.vertices.size());
+		}
+
+		EXPECT_FLOAT_EQ(expected.colors[1].y, 1.0f);
+		EXPECT_FLOAT_EQ(expected.positions[3].z, -3.0f);
+	}
+
+	/**
+	* @brief Testing large polygon fan and empty file.
+	*/
+	TEST_F(ObjParser_test, Polygon) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string obj = "v 0 0 0\nv 1 0 0\nv 2 1 0\nv 1 2 0\nv 0 1 0\nf 1 2 3 4 5";
+
+		Mesh mesh;
+		EXPECT_TRUE(Spices::ObjParser::Parse(obj.data(), obj.size(), mesh.GetOutput()));
+		EXPECT_THAT(mesh.primitiveVertices, testing::ElementsAre(glm::uvec3(0, 1, 2), glm::uvec3(0, 2, 3), glm::uvec3(0, 3, 4)));
+		EXPECT_EQ(mesh.colors.size(), 5);
+		EXPECT_TRUE(mesh.normals.empty());
+
+		EXPECT_TRUE(Spices::ObjParser::Parse(nullptr, 0, mesh.GetOutput(), &m_ThreadPool));
+		EXPECT_TRUE(mesh.positions.empty());
+		EXPECT_TRUE(mesh.primitiveVertices.empty());
+	}
+
+	/**
+	* @brief Testing invalid face indices.
+	*/
+	TEST_F(ObjParser_test, Invalid) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		for (const std::string obj : {
+			"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n",
+			"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 0 1 2\n",
+			"v 0 0 0\nv 1 0 0\nv 0 1 0\nf -4 1 2\n",
+			"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1/2 2/1 3/1\n",
+			"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 x\n",
+			"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3x\n",
+		})
+		{
+			Mesh mesh;
+			EXPECT_FALSE(Spices::ObjParser::Parse(obj.data(), obj.size(), mesh.GetOutput()));
+		}
+
+		Mesh mesh;
+		EXPECT_FALSE(Spices::ObjParser::Parse(m_Root + "None.obj", mesh.GetOutput()));
+	}
+
+	/**
+	* @brief Testing many chunks, same as single chunk and as tinyobj.
+	*/
+	TEST_F(ObjParser_test, Chunks) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string obj  = Grid(512);
+		const std::string path = WriteFile("Grid.obj", obj);
+
+		EXPECT_GT(obj.size(), 2 * Spices::ObjParser::ChunkSize);
+
+		Mesh expected;
+		EXPECT_TRUE(LoadTinyObj(path, expected));
+
+		Mesh mesh;
+		Spices::ObjParser::Stats stats;
+		EXPECT_TRUE(Spices::ObjParser::Parse(path, mesh.GetOutput(), &m_ThreadPool, &stats));
+
+		EXPECT_GT(stats.chunks, 1);
+		EXPECT_EQ(stats.triangles, 2 * 512 * 512);
+		ExpectEqual(mesh, expected);
+	}
+
+	/**
+	* @brief Throughput against tinyobj, file size in MB by SPICES_OBJ_BENCHMARK_MB, default 64.
+	* Run with SPICES_OBJ_BENCHMARK_MB=1024 for the 1 GB case.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(ObjParser_test, DISABLED_Throughput) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		uint64_t megaBytes = 64;
+		if (const char* env = std::getenv("SPICES_OBJ_BENCHMARK_MB")) megaBytes = std::max(1, std::atoi(env));
+
+		/**
+		* @brief Grid text is about 112 bytes per quad.
+		*/
+		const uint32_t n = static_cast<uint32_t>(std::sqrt(megaBytes * 1024 * 1024 / 112.0));
+		const std::string path = WriteFile("Benchmark.obj", Grid(n));
+		const uint64_t bytes   = std::filesystem::file_size(path);
+
+		const auto run = [&](const char* name, const std::function<void()>& func) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			func();
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+			std::cout << "ObjParser " << name << ": " << bytes / (1024.0 * 1024.0) << " MB, " << ms << " ms, "
+			          << bytes / (1024.0 * 1024.0) / (ms / 1000.0) << " MB/s." << std::endl;
+		};
+
+		uint64_t expected = 0;
+		run("tinyobj", [&]() {
+			Mesh mesh;
+			EXPECT_TRUE(LoadTinyObj(path, mesh));
+			expected = mesh.vertices.size();
+		});
+
+		run("ObjParser 1 thread", [&]() {
+			Mesh mesh;
+			EXPECT_TRUE(Spices::ObjParser::Parse(path, mesh.GetOutput()));
+			EXPECT_EQ(mesh.vertices.size(), expected);
+		});
+
+		run("ObjParser 4 threads", [&]() {
+			Mesh mesh;
+			EXPECT_TRUE(Spices::ObjParser::Parse(path, mesh.GetOutput(), &m_ThreadPool));
+			EXPECT_EQ(mesh.vertices.size(), expected);
+		});
+	}
+}
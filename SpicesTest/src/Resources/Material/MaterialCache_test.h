@@ -0,0 +1,276 @@
+/**
+* @file MaterialCache_test.h.
+* @brief The MaterialCache_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Resources/Material/MaterialCache.h>
+#include "Instrumentor.h"
+
+#include <yaml-cpp/yaml.h>
+#include <glm/glm.hpp>
+#include <chrono>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for MaterialCache.
+	*/
+	class MaterialCache_test : public testing::Test
+	{
+	protected:
+
+		using Cache = Spices::MaterialCache;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override {}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override {}
+
+		/**
+		* @brief A .material file in the format of assets.
+		* @param[in] i Seed.
+		* @return Returns the file text.
+		*/
+		static std::string MakeMaterialText(uint32_t i)
+		{
+			std::stringstream ss;
+			ss << "Material: BasePassRenderer.Mesh." << i << "\n";
+			ss << "Shaders:\n";
+			ss << "  - Stage: task\n    Path: BasePassRenderer.Mesh.Default\n";
+			ss << "  - Stage: mesh\n    Path: BasePassRenderer.Mesh.Default\n";
+			ss << "  - Stage: frag\n    Path: BasePassRenderer.Mesh.PBR\n";
+			ss << "  - Stage: rchit\n    Path: BasePassRenderer.Mesh.PBR\n";
+			ss << "Textures:\n";
+			ss << "  - Name: albedoTexture\n    Value: [Texture2D, stone_tile/Albedo_" << i << ".jpg]\n";
+			ss << "  - Name: normalTexture\n    Value: [Texture2D, stone_tile/Normal_" << i << ".jpg]\n";
+			ss << "Parameters:\n";
+			ss << "  - Name: albedo\n    Value: [float3, [0.8, 0.8, " << i % 10 * 0.1f << "]]\n";
+			ss << "  - Name: emissive\n    Value: [float4, [0.0, 0.0, 0.0, 1.0]]\n";
+			ss << "  - Name: uvScale\n    Value: [float2, [1.0, 2.0]]\n";
+			ss << "  - Name: roughness\n    Value: [float, 0.9]\n    MinValue: [float, 0.0]\n    MaxValue: [float, 1.0]\n";
+			ss << "  - Name: metallic\n    Value: [float, 0.0]\n";
+			ss << "  - Name: maxRayDepth\n    Value: [int, " << i % 8 << "]\n";
+			ss << "  - Name: twoSided\n    Value: [bool, true]\n";
+
+			return ss.str();
+		}
+
+		/**
+		* @brief Value of a [type, value] node, same types as YAML path of MaterialLoader.
+		*/
+		static std::any ParseValue(const YAML::Node& node, std::string& outType)
+		{
+			outType = node[0].as<std::string>();
+
+			if (outType == "float4" || outType == "float3" || outType == "float2")
+			{
+				const auto v = node[1].as<std::vector<float>>();
+
+				if (outType == "float4") return glm::vec4(v[0], v[1], v[2], v[3]);
+				if (outType == "float3") return glm::vec3(v[0], v[1], v[2]);
+				return glm::vec2(v[0], v[1]);
+			}
+			if (outType == "float") return node[1].as<float>();
+			if (outType == "int")   return node[1].as<int>();
+			if (outType == "bool")  return node[1].as<bool>();
+
+			return std::any();
+		}
+
+		/**
+		* @brief YAML path: parse a .material text as MaterialLoader::LoadFromMaterial does.
+		*/
+		static bool ParseYaml(const std::string& text, Cache::Data& outData)
+		{
+			YAML::Node data = YAML::Load(text);
+			if (!data["Material"]) return false;
+
+			outData.material = data["Material"].as<std::string>();
+
+			for (const auto& shader : data["Shaders"])
+			{
+				outData.shaders.push_back({ shader["Stage"].as<std::string>(), shader["Path"].as<std::string>() });
+			}
+
+			for (const auto& texture : data["Textures"])
+			{
+				const auto value = texture["Value"];
+				outData.textures.push_back({ texture["Name"].as<std::string>(), value[0].as<std::string>(), value[1].as<std::string>() });
+			}
+
+			for (const auto& parameter : data["Parameters"])
+			{
+				std::string type, minType, maxType;
+				const std::any value = ParseValue(parameter["Value"], type);
+				const std::any min   = parameter["MinValue"].IsDefined() ? ParseValue(parameter["MinValue"], minType) : std::any();
+				const std::any max   = parameter["MaxValue"].IsDefined() ? ParseValue(parameter["MaxValue"], maxType) : std::any();
+
+				if (!Cache::AddParameter(outData, parameter["Name"].as<std::string>(), type, value, min.has_value() ? &min : nullptr, max.has_value() ? &max : nullptr))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	};
+
+	/**
+	* @brief Testing if parameters round trip in GPU representation.
+	*/
+	TEST_F(MaterialCache_test, RoundTrip) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Cache::Data data;
+		EXPECT_TRUE(ParseYaml(MakeMaterialText(3), data));
+
+		EXPECT_EQ(data.parameters.size(), 7);
+		EXPECT_EQ(data.values.size(), 12 + 16 + 8 + 4 + 4 + 4 + 4);
+
+		std::vector<char> bytes;
+		Cache::Encode(data, bytes);
+
+		Cache::Data decoded;
+		EXPECT_TRUE(Cache::Decode(bytes.data(), bytes.size(), decoded));
+
+		EXPECT_EQ(decoded.material, "BasePassRenderer.Mesh.3");
+		ASSERT_EQ(decoded.shaders.size(), 4);
+		EXPECT_EQ(decoded.shaders[2].stage, "frag");
+		EXPECT_EQ(decoded.shaders[2].path, "BasePassRenderer.Mesh.PBR");
+		ASSERT_EQ(decoded.textures.size(), 2);
+		EXPECT_EQ(decoded.textures[1].name, "normalTexture");
+		EXPECT_EQ(decoded.textures[1].textureType, "Texture2D");
+		EXPECT_EQ(decoded.textures[1].texturePath, "stone_tile/Normal_3.jpg");
+		ASSERT_EQ(decoded.parameters.size(), 7);
+
+		const auto& p = decoded.parameters;
+		EXPECT_EQ(std::any_cast<glm::vec3>(Cache::GetValue(p[0], decoded.values)), glm::vec3(0.8f, 0.8f, 0.3f));
+		EXPECT_EQ(std::any_cast<glm::vec4>(Cache::GetValue(p[1], decoded.values)), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+		EXPECT_EQ(std::any_cast<glm::vec2>(Cache::GetValue(p[2], decoded.values)), glm::vec2(1.0f, 2.0f));
+		EXPECT_EQ(std::any_cast<float>    (Cache::GetValue(p[3], decoded.values)), 0.9f);
+		EXPECT_EQ(std::any_cast<float>    (Cache::GetValue(p[3], decoded.minValues)), 0.0f);
+		EXPECT_EQ(std::any_cast<float>    (Cache::GetValue(p[3], decoded.maxValues)), 1.0f);
+		EXPECT_EQ(std::any_cast<int>      (Cache::GetValue(p[5], decoded.values)), 3);
+		EXPECT_EQ(std::any_cast<bool>     (Cache::GetValue(p[6], decoded.values)), true);
+
+		EXPECT_TRUE (p[3].hasMinValue && p[3].hasMaxValue);
+		EXPECT_FALSE(p[4].hasMinValue || p[4].hasMaxValue);
+		EXPECT_EQ(p[6].paramType, "bool");
+		EXPECT_EQ(p[6].type, scl::memory_field_type::Bool);
+
+		/**
+		* @brief bool is 4 bytes on GPU.
+		*/
+		uint32_t gpuBool = 0;
+		std::memcpy(&gpuBool, decoded.values.data() + p[6].offset, sizeof(gpuBool));
+		EXPECT_EQ(gpuBool, 1);
+	}
+
+	/**
+	* @brief Testing if invalid parameters and bytes are rejected.
+	*/
+	TEST_F(MaterialCache_test, Invalid) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Cache::Data data;
+		EXPECT_FALSE(Cache::AddParameter(data, "a", "double", std::any(1.0)));
+		EXPECT_FALSE(Cache::AddParameter(data, "b", "float3", std::any(1.0f)));
+
+		const std::any min(0);
+		EXPECT_FALSE(Cache::AddParameter(data, "c", "float", std::any(1.0f), &min));
+		EXPECT_TRUE(data.parameters.empty());
+		EXPECT_TRUE(data.values.empty());
+
+		EXPECT_TRUE(ParseYaml(MakeMaterialText(1), data));
+
+		std::vector<char> bytes;
+		Cache::Encode(data, bytes);
+
+		Cache::Data decoded;
+		for (size_t size = 0; size < bytes.size(); size++)
+		{
+			EXPECT_FALSE(Cache::Decode(bytes.data(), size, decoded)) << size;
+		}
+
+		std::vector<char> trailing = bytes;
+		trailing.push_back(0);
+		EXPECT_FALSE(Cache::Decode(trailing.data(), trailing.size(), decoded));
+
+		/**
+		* @brief A parameter out of value blocks.
+		*/
+		Cache::Data outside = data;
+		outside.parameters.back().offset = static_cast<uint32_t>(outside.values.size());
+
+		bytes.clear();
+		Cache::Encode(outside, bytes);
+		EXPECT_FALSE(Cache::Decode(bytes.data(), bytes.size(), decoded));
+	}
+
+	/**
+	* @brief Testing materials per second of YAML path and cooked path.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(MaterialCache_test, DISABLED_Throughput) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nMaterials = 2000;
+
+		std::vector<std::string> texts;
+		for (uint32_t i = 0; i < nMaterials; i++) texts.push_back(MakeMaterialText(i));
+
+		using Clock = std::chrono::high_resolution_clock;
+
+		/**
+		* @brief YAML path.
+		*/
+		auto start = Clock::now();
+		std::vector<Cache::Data> yaml(nMaterials);
+		for (uint32_t i = 0; i < nMaterials; i++)
+		{
+			EXPECT_TRUE(ParseYaml(texts[i], yaml[i]));
+		}
+		auto end = Clock::now();
+
+		const double yamlSeconds = std::chrono::duration<double>(end - start).count();
+
+		/**
+		* @brief Cooked path, one blob per material.
+		*/
+		std::vector<std::vector<char>> blobs(nMaterials);
+		for (uint32_t i = 0; i < nMaterials; i++) Cache::Encode(yaml[i], blobs[i]);
+
+		start = Clock::now();
+		std::vector<Cache::Data> cooked(nMaterials);
+		for (uint32_t i = 0; i < nMaterials; i++)
+		{
+			EXPECT_TRUE(Cache::Decode(blobs[i].data(), blobs[i].size(), cooked[i]));
+		}
+		end = Clock::now();
+
+		const double cookedSeconds = std::chrono::duration<double>(end - start).count();
+
+		for (uint32_t i = 0; i < nMaterials; i += 331)
+		{
+			EXPECT_EQ(cooked[i].material, yaml[i].material);
+			EXPECT_EQ(cooked[i].values,   yaml[i].values);
+		}
+
+		std::cout << "MaterialCache: yaml " << uint64_t(nMaterials / yamlSeconds) << " materials/s, cooked "
+			<< uint64_t(nMaterials / cookedSeconds) << " materials/s" << std::endl;
+
+		EXPECT_LT(cookedSeconds, yamlSeconds);
+	}
+}
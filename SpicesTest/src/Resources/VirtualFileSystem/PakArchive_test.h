@@ -0,0 +1,286 @@
+/**
+* @file PakArchive_test.h.
+* @brief The PakArchive_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Resources/VirtualFileSystem/PakArchive.h>
+#include <Resources/VirtualFileSystem/VirtualFileSystem.h>
+#include "Instrumentor.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for PakArchive.
+	*/
+	class PakArchive_test : public testing::Test
+	{
+	protected:
+
+		using VFS = Spices::VirtualFileSystem;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override
+		{
+			m_Root = (std::filesystem::temp_directory_path() / "SpicesPakArchiveTest").generic_string() + "/";
+			std::filesystem::remove_all(m_Root);
+
+			for (int i = 0; i < 64; i++)
+			{
+				std::stringstream ss;
+				ss << "Meshes/bin/Mesh" << i << ".sasset";
+
+				AddAsset(ss.str(), std::string(i * 97 + 1, static_cast<char>('a' + i % 26)));
+			}
+
+			AddAsset("Shaders/src/Shader.Mesh.vert", "#version 460");
+			AddAsset("Materials/src/Material.Basic.material", "Material: Basic");
+			AddAsset("Materials/bin/Material.Empty.sasset", "");
+			WriteFile(m_Root + "Meshes/src/obj/Cube.obj", "v 0 0 0");
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override
+		{
+			VFS::UnMountAll();
+			std::filesystem::remove_all(m_Root);
+		}
+
+		/**
+		* @brief Create a file and its folders.
+		* @param[in] path File path.
+		* @param[in] data File data.
+		*/
+		static void WriteFile(const std::string& path, const std::string& data)
+		{
+			std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+			std::ofstream(path, std::ios::binary) << data;
+		}
+
+		/**
+		* @brief Create a cooked file.
+		* @param[in] logicalPath Logical path.
+		* @param[in] data File data.
+		*/
+		void AddAsset(const std::string& logicalPath, const std::string& data)
+		{
+			WriteFile(m_Root + logicalPath, data);
+			m_Assets[VFS::ToKey(logicalPath)] = data;
+		}
+
+		/**
+		* @brief Read a file.
+		* @param[in] path File path.
+		* @return Returns file data.
+		*/
+		static std::string ReadFile(const std::string& path)
+		{
+			std::ifstream stream(path, std::ios::binary);
+			return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		}
+
+		std::string m_Root;                               /* @brief Temp resource folder.          */
+		std::map<std::string, std::string> m_Assets;      /* @brief Cooked files, key: logical key. */
+	};
+
+	/**
+	* @brief Testing Cook and read back.
+	*/
+	TEST_F(PakArchive_test, RoundTrip) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string pakPath = m_Root + "Assets.pak";
+		EXPECT_TRUE(Spices::PakWriter::Cook(m_Root, pakPath));
+
+		Spices::PakArchive archive;
+		EXPECT_TRUE(archive.Open(pakPath));
+		EXPECT_EQ(archive.GetFileCount(), 67);
+
+		/**
+		* @brief Sorted TOC, aligned blobs, same bytes.
+		*/
+		for (uint32_t i = 0; i < archive.GetFileCount(); i++)
+		{
+			const std::string name(archive.GetName(i));
+
+			EXPECT_EQ(archive.Find(name), i);
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(archive.GetData(i)) % Spices::PakArchive::Alignment, 0);
+			EXPECT_TRUE(std::string(archive.GetData(i), archive.GetSize(i)) == m_Assets.at(name));
+
+			if (i > 0)
+			{
+				EXPECT_LE(Spices::PakArchive::Hash(archive.GetName(i - 1)), Spices::PakArchive::Hash(archive.GetName(i)));
+			}
+		}
+
+		/**
+		* @brief Keys are lower case, src meshes are not cooked.
+		*/
+		EXPECT_NE(archive.Find("meshes/bin/mesh7.sasset"),              Spices::PakArchive::npos);
+		EXPECT_EQ(archive.Find("Meshes/bin/Mesh7.sasset"),              Spices::PakArchive::npos);
+		EXPECT_EQ(archive.Find("meshes/src/obj/cube.obj"),              Spices::PakArchive::npos);
+		EXPECT_EQ(archive.GetSize(archive.Find("materials/bin/material.empty.sasset")), 0);
+
+		archive.Close();
+		EXPECT_EQ(archive.GetFileCount(), 0);
+		EXPECT_EQ(archive.Find("meshes/bin/mesh7.sasset"), Spices::PakArchive::npos);
+	}
+
+	/**
+	* @brief Testing invalid pak files.
+	*/
+	TEST_F(PakArchive_test, Invalid) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		Spices::PakArchive archive;
+
+		EXPECT_FALSE(archive.Open(m_Root + "None.pak"));
+
+		WriteFile(m_Root + "Bad.pak", "SPAK");
+		EXPECT_FALSE(archive.Open(m_Root + "Bad.pak"));
+
+		/**
+		* @brief Truncated pak.
+		*/
+		EXPECT_TRUE(Spices::PakWriter::Cook(m_Root, m_Root + "Assets.pak"));
+		const std::string bytes = ReadFile(m_Root + "Assets.pak");
+
+		WriteFile(m_Root + "Truncated.pak", bytes.substr(0, bytes.size() / 2));
+		EXPECT_FALSE(archive.Open(m_Root + "Truncated.pak"));
+		EXPECT_EQ(archive.GetFileCount(), 0);
+
+		EXPECT_TRUE(archive.Open(m_Root + "Assets.pak"));
+	}
+
+	/**
+	* @brief Testing pak mounted by VirtualFileSystem.
+	*/
+	TEST_F(PakArchive_test, Mount) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string pakRoot = (std::filesystem::path(m_Root) / "Pak").generic_string() + "/";
+		std::filesystem::create_directories(pakRoot);
+
+		EXPECT_TRUE(Spices::PakWriter::Cook(m_Root, pakRoot + "Assets.pak"));
+
+		/**
+		* @brief A loose file overrides packed one.
+		*/
+		WriteFile(pakRoot + "Shaders/src/Shader.Mesh.vert", "#version 450");
+
+		EXPECT_EQ(VFS::Mount(pakRoot), 0);
+		EXPECT_EQ(VFS::GetStats().archives, 1);
+
+		VFS::Entry entry;
+		VFS::Blob  blob;
+
+		EXPECT_TRUE(VFS::Resolve("Meshes/bin/Mesh5.sasset", entry));
+		EXPECT_TRUE(entry.IsPacked());
+		EXPECT_EQ(entry.path, pakRoot + "Assets.pak");
+		EXPECT_TRUE(VFS::Load(entry, blob));
+		EXPECT_TRUE(std::string(blob.data, blob.size) == m_Assets.at("meshes/bin/mesh5.sasset"));
+
+		EXPECT_TRUE(VFS::Resolve("Shaders/src/Shader.Mesh.vert", entry));
+		EXPECT_FALSE(entry.IsPacked());
+		EXPECT_TRUE(VFS::Load(entry, blob));
+		EXPECT_EQ(std::string(blob.data, blob.size), "#version 450");
+
+		EXPECT_FALSE(VFS::Exists("Assets.pak"));
+		EXPECT_FALSE(VFS::Exists("Meshes/src/obj/Cube.obj"));
+
+		/**
+		* @brief Blob keeps pak mapped after unmount.
+		*/
+		EXPECT_TRUE(VFS::Resolve("Materials/src/Material.Basic.material", entry));
+		EXPECT_TRUE(VFS::Load(entry, blob));
+		entry = VFS::Entry{};
+		VFS::UnMountAll();
+
+		{
+			Spices::BlobReader reader(blob);
+
+			char data[8] = {};
+			EXPECT_TRUE (reader.Read(8, data));
+			EXPECT_EQ   (std::string(data, 8), "Material");
+			EXPECT_EQ   (reader.Remain(), 7);
+			EXPECT_FALSE(reader.Read(8, data));
+			EXPECT_TRUE (reader.Read(7, data));
+			EXPECT_EQ   (reader.Remain(), 0);
+		}
+	}
+
+	/**
+	* @brief Testing load all cooked files from loose files and from pak.
+	*/
+	TEST_F(PakArchive_test, LoadCompare) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const std::string pakRoot = (std::filesystem::path(m_Root) / "Pak").generic_string() + "/";
+		std::filesystem::create_directories(pakRoot);
+
+		EXPECT_TRUE(Spices::PakWriter::Cook(m_Root, pakRoot + "Assets.pak"));
+
+		std::vector<std::string> names;
+		{
+			Spices::PakArchive archive;
+			EXPECT_TRUE(archive.Open(pakRoot + "Assets.pak"));
+
+			for (uint32_t i = 0; i < archive.GetFileCount(); i++)
+			{
+				names.emplace_back(archive.GetName(i));
+			}
+		}
+
+		uint64_t looseBytes = 0;
+		uint64_t pakBytes   = 0;
+
+		EXPECT_EQ(VFS::Mount(m_Root), 0);
+		{
+			SPICESTEST_PROFILE_SCOPE("LooseFiles");
+
+			for (const auto& name : names)
+			{
+				VFS::Entry entry;
+				VFS::Blob  blob;
+
+				EXPECT_TRUE(VFS::Resolve(name, entry) && VFS::Load(entry, blob));
+				EXPECT_FALSE(entry.IsPacked());
+
+				looseBytes += blob.size;
+			}
+		}
+		VFS::UnMountAll();
+
+		EXPECT_EQ(VFS::Mount(pakRoot), 0);
+		{
+			SPICESTEST_PROFILE_SCOPE("PakArchive");
+
+			for (const auto& name : names)
+			{
+				VFS::Entry entry;
+				VFS::Blob  blob;
+
+				EXPECT_TRUE(VFS::Resolve(name, entry) && VFS::Load(entry, blob));
+				EXPECT_TRUE(entry.IsPacked());
+
+				pakBytes += blob.size;
+			}
+		}
+
+		EXPECT_EQ(looseBytes, pakBytes);
+	}
+}
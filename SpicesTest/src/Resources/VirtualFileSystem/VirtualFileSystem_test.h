@@ -0,0 +1,242 @@
+/**
+* @file VirtualFileSystem_test.h.
+* @brief The VirtualFileSystem_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <Resources/VirtualFileSystem/VirtualFileSystem.h>
+#include <Core/Library/FileLibrary.h>
+#include "Instrumentor.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for VirtualFileSystem.
+	*/
+	class VirtualFileSystem_test : public testing::Test
+	{
+	protected:
+
+		using VFS = Spices::VirtualFileSystem;
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override
+		{
+			m_Root = std::filesystem::temp_directory_path() / "SpicesVirtualFileSystemTest";
+			std::filesystem::remove_all(m_Root);
+
+			m_Game   = (m_Root / "Game").generic_string()   + "/";
+			m_Engine = (m_Root / "Engine").generic_string() + "/";
+
+			WriteFile(m_Game   + "Meshes/src/obj/Chair.obj"          );
+			WriteFile(m_Engine + "Meshes/src/obj/Chair.obj"          );
+			WriteFile(m_Engine + "Meshes/src/obj/Cube.obj"           );
+			WriteFile(m_Engine + "Shaders/src/Shader.Mesh.vert"      );
+			WriteFile(m_Engine + "Textures/src/default.jpg"          );
+
+			EXPECT_EQ(VFS::Mount(m_Game),   0);
+			EXPECT_EQ(VFS::Mount(m_Engine), 1);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override
+		{
+			VFS::UnMountAll();
+			std::filesystem::remove_all(m_Root);
+		}
+
+		/**
+		* @brief Create a file and its folders.
+		* @param[in] path File path.
+		*/
+		static void WriteFile(const std::string& path)
+		{
+			std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+			std::ofstream(path) << "Spices";
+		}
+
+		std::filesystem::path m_Root;     /* @brief Temp folder.          */
+		std::string m_Game;               /* @brief First mount folder.   */
+		std::string m_Engine;             /* @brief Second mount folder.  */
+	};
+
+	/**
+	* @brief Testing Resolve.
+	*/
+	TEST_F(VirtualFileSystem_test, Resolve) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		VFS::Entry entry;
+
+		EXPECT_TRUE(VFS::Resolve("Meshes/src/obj/Cube.obj", entry));
+		EXPECT_EQ(entry.path, m_Engine + "Meshes/src/obj/Cube.obj");
+		EXPECT_EQ(entry.mount, 1);
+
+		EXPECT_TRUE(VFS::Resolve("Shaders/src/Shader.Mesh.vert", entry));
+		EXPECT_EQ(entry.path, m_Engine + "Shaders/src/Shader.Mesh.vert");
+
+		EXPECT_FALSE(VFS::Resolve("Meshes/src/obj/Sphere.obj", entry));
+		EXPECT_FALSE(VFS::Resolve("Meshes/src/obj", entry));
+		EXPECT_FALSE(VFS::Exists("Textures/src/default.png"));
+		EXPECT_TRUE (VFS::Exists("Textures/src/default.jpg"));
+	}
+
+	/**
+	* @brief Testing first mount wins.
+	*/
+	TEST_F(VirtualFileSystem_test, MountPriority) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		VFS::Entry entry;
+
+		EXPECT_TRUE(VFS::Resolve("Meshes/src/obj/Chair.obj", entry));
+		EXPECT_EQ(entry.path, m_Game + "Meshes/src/obj/Chair.obj");
+		EXPECT_EQ(entry.mount, 0);
+
+		EXPECT_EQ(VFS::Mount(m_Engine), 1);
+		EXPECT_EQ(VFS::GetMountRoot(0), m_Game);
+		EXPECT_EQ(VFS::GetMountRoot(1), m_Engine);
+		EXPECT_EQ(VFS::GetMountRoot(2), "");
+	}
+
+	/**
+	* @brief Testing case and separator insensitive Resolve.
+	*/
+	TEST_F(VirtualFileSystem_test, CaseInsensitive) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		VFS::Entry entry;
+
+		EXPECT_TRUE(VFS::Resolve("meshes/SRC/obj/cube.OBJ", entry));
+		EXPECT_EQ(entry.path, m_Engine + "Meshes/src/obj/Cube.obj");
+
+		EXPECT_TRUE(VFS::Resolve("Meshes\\src\\obj\\Cube.obj", entry));
+		EXPECT_EQ(entry.mount, 1);
+	}
+
+	/**
+	* @brief Testing Resolve makes no file stat.
+	*/
+	TEST_F(VirtualFileSystem_test, NoStat) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		const uint64_t statCount = Spices::FileLibrary::FileLibrary_StatCount();
+		const VFS::Stats before  = VFS::GetStats();
+
+		for (int i = 0; i < 100; i++)
+		{
+			EXPECT_TRUE (VFS::Exists("Meshes/src/obj/Cube.obj"));
+			EXPECT_FALSE(VFS::Exists("Meshes/bin/Cube.sasset"));
+		}
+
+		const VFS::Stats after = VFS::GetStats();
+
+		EXPECT_EQ(Spices::FileLibrary::FileLibrary_StatCount(), statCount);
+		EXPECT_EQ(after.resolves - before.resolves, 200);
+		EXPECT_EQ(after.misses   - before.misses,   100);
+		EXPECT_EQ(after.scans, before.scans);
+		EXPECT_EQ(after.files, 4);
+	}
+
+	/**
+	* @brief Testing AddFile.
+	*/
+	TEST_F(VirtualFileSystem_test, AddFile) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		VFS::Entry entry;
+
+		/**
+		* @brief Visible without rescan.
+		*/
+		VFS::AddFile(1, "Meshes/bin/Cube.sasset");
+		EXPECT_TRUE(VFS::Resolve("Meshes/bin/Cube.sasset", entry));
+		EXPECT_EQ(entry.path, m_Engine + "Meshes/bin/Cube.sasset");
+		EXPECT_EQ(entry.mount, 1);
+
+		/**
+		* @brief Prior mount replaces, later mount does not.
+		*/
+		VFS::AddFile(0, "Meshes/bin/Cube.sasset");
+		EXPECT_TRUE(VFS::Resolve("Meshes/bin/Cube.sasset", entry));
+		EXPECT_EQ(entry.mount, 0);
+
+		VFS::AddFile(1, "Meshes/src/obj/Chair.obj");
+		EXPECT_TRUE(VFS::Resolve("Meshes/src/obj/Chair.obj", entry));
+		EXPECT_EQ(entry.mount, 0);
+
+		/**
+		* @brief Invalid mount is ignored.
+		*/
+		VFS::AddFile(2, "Meshes/bin/Plane.sasset");
+		EXPECT_FALSE(VFS::Exists("Meshes/bin/Plane.sasset"));
+	}
+
+	/**
+	* @brief Testing Refresh.
+	*/
+	TEST_F(VirtualFileSystem_test, Refresh) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		EXPECT_FALSE(VFS::Refresh());
+
+		WriteFile(m_Engine + "Meshes/src/obj/Sphere.obj");
+		EXPECT_TRUE(VFS::Refresh());
+		EXPECT_TRUE(VFS::Exists("Meshes/src/obj/Sphere.obj"));
+
+		/**
+		* @brief Removing the prior file exposes the later one.
+		*/
+		std::filesystem::remove(m_Game + "Meshes/src/obj/Chair.obj");
+		EXPECT_TRUE(VFS::Refresh());
+
+		VFS::Entry entry;
+		EXPECT_TRUE(VFS::Resolve("Meshes/src/obj/Chair.obj", entry));
+		EXPECT_EQ(entry.mount, 1);
+
+		std::filesystem::remove_all(m_Engine + "Shaders");
+		EXPECT_TRUE(VFS::Refresh());
+		EXPECT_FALSE(VFS::Exists("Shaders/src/Shader.Mesh.vert"));
+
+		EXPECT_FALSE(VFS::Refresh());
+	}
+
+	/**
+	* @brief Testing watcher thread.
+	*/
+	TEST_F(VirtualFileSystem_test, Watch) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		VFS::StartWatch(std::chrono::milliseconds(1));
+
+		WriteFile(m_Engine + "Textures/src/Brick.png");
+
+		bool isFind = false;
+		for (int i = 0; i < 2000 && !isFind; i++)
+		{
+			isFind = VFS::Exists("Textures/src/Brick.png");
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		EXPECT_TRUE(isFind);
+
+		VFS::StopWatch();
+	}
+}
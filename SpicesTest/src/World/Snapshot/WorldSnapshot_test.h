@@ -0,0 +1,349 @@
+/**
+* @file WorldSnapshot_test.h.
+* @brief The WorldSnapshot_test Definitions.
+* @author Spices.
+*/
+
+#pragma once
+#include <gmock/gmock.h>
+#include <World/Snapshot/WorldSnapshot.h>
+#include "Instrumentor.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace SpicesTest {
+
+	/**
+	* @brief Unit Test for WorldSnapshot.
+	* Uses plain components, engine components allocate gpu resources.
+	*/
+	class WorldSnapshot_test : public testing::Test
+	{
+	protected:
+
+		using Snapshot = Spices::WorldSnapshot;
+
+		/**
+		* @brief Trivially copyable component.
+		*/
+		struct Position
+		{
+			float x, y, z;
+		};
+
+		/**
+		* @brief Trivially copyable component.
+		*/
+		struct Id
+		{
+			uint64_t id;
+		};
+
+		/**
+		* @brief Empty component.
+		*/
+		struct Static {};
+
+		/**
+		* @brief Component converted by a record.
+		*/
+		struct Name
+		{
+			std::string name;
+		};
+
+		/**
+		* @brief The interface is inherited from testing::Test.
+		* Registry on Initialize.
+		*/
+		void SetUp() override
+		{
+			m_Root = (std::filesystem::temp_directory_path() / "SpicesWorldSnapshotTest").generic_string() + "/";
+			std::filesystem::remove_all(m_Root);
+			std::filesystem::create_directories(m_Root);
+		}
+
+		/**
+		* @brief Testing class TearDown function.
+		*/
+		void TearDown() override
+		{
+			std::filesystem::remove_all(m_Root);
+		}
+
+		/**
+		* @brief Register all test components.
+		* @param[in] snapshot The snapshot.
+		* @param[in] isName Register Name.
+		*/
+		static void RegisterAll(Snapshot& snapshot, bool isName = true)
+		{
+			snapshot.Register<Position>("Position");
+			snapshot.Register<Id>("Id");
+			snapshot.Register<Static>("Static");
+
+			if (!isName) return;
+
+			snapshot.Register<Name, uint32_t>("Name",
+				[](const Name& component, Snapshot::StringTable& strings) {
+					return strings.Intern(component.name);
+				},
+				[](entt::registry& registry, entt::entity entity, const uint32_t& record, const Snapshot::StringTable& strings) {
+					registry.emplace<Name>(entity, Name{ std::string(strings.Get(record)) });
+				}
+			);
+		}
+
+		/**
+		* @brief Fill a registry, entity i has Position and Id, every 3rd is Static, every 5th has a Name.
+		* @param[in] registry The registry.
+		* @param[in] count Count of entities.
+		* @param[in] isName Add Name.
+		*/
+		static void Fill(entt::registry& registry, uint32_t count, bool isName = true)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const auto e = registry.create();
+
+				registry.emplace<Position>(e, Position{ float(i), float(i) * 2.0f, -float(i) });
+				registry.emplace<Id>(e, Id{ 1000000007ull * i });
+
+				if (i % 3 == 0)           registry.emplace<Static>(e);
+				if (isName && i % 5 == 0) registry.emplace<Name>(e, Name{ "Entity" + std::to_string(i % 20) });
+			}
+		}
+
+	protected:
+
+		/**
+		* @brief Temp directory.
+		*/
+		std::string m_Root;
+	};
+
+	/**
+	* @brief Testing if components round trip.
+	*/
+	TEST_F(WorldSnapshot_test, RoundTrip) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		entt::registry src;
+		Fill(src, 1000);
+
+		/**
+		* @brief Holes in entity ids.
+		*/
+		std::vector<entt::entity> destroyed;
+		for (const auto [e] : src.storage<entt::entity>().each())
+		{
+			if (entt::to_entity(e) % 7 == 1) destroyed.push_back(e);
+		}
+		src.destroy(destroyed.begin(), destroyed.end());
+
+		Snapshot snapshot;
+		RegisterAll(snapshot);
+
+		Snapshot::Stats saved;
+		EXPECT_TRUE(snapshot.Save(src, m_Root + "world.swld", &saved));
+		EXPECT_EQ(saved.entities, 1000 - destroyed.size());
+		EXPECT_EQ(saved.columns, 4);
+		EXPECT_EQ(saved.strings, 4);
+
+		entt::registry dst;
+		std::vector<entt::entity> entities;
+		Snapshot::Stats loaded;
+		EXPECT_TRUE(snapshot.Load(dst, m_Root + "world.swld", &entities, &loaded));
+		EXPECT_EQ(loaded.entities, saved.entities);
+		EXPECT_EQ(loaded.components, saved.components);
+		EXPECT_EQ(loaded.skipped, 0);
+		EXPECT_EQ(entities.size(), saved.entities);
+
+		/**
+		* @brief Match entities by Id.
+		*/
+		std::unordered_map<uint64_t, entt::entity> srcById;
+		for (const auto [e, id] : src.view<Id>().each()) srcById[id.id] = e;
+
+		EXPECT_EQ(dst.storage<Id>().size(), srcById.size());
+		for (const auto [e, id] : dst.view<Id>().each())
+		{
+			ASSERT_TRUE(srcById.count(id.id));
+			const auto s = srcById[id.id];
+
+			const auto& a = src.get<Position>(s);
+			const auto& b = dst.get<Position>(e);
+			EXPECT_EQ(a.x, b.x);
+			EXPECT_EQ(a.y, b.y);
+			EXPECT_EQ(a.z, b.z);
+
+			EXPECT_EQ(src.all_of<Static>(s), dst.all_of<Static>(e));
+			EXPECT_EQ(src.all_of<Name>(s), dst.all_of<Name>(e));
+			if (src.all_of<Name>(s))
+			{
+				EXPECT_EQ(src.get<Name>(s).name, dst.get<Name>(e).name);
+			}
+		}
+	}
+
+	/**
+	* @brief Testing if columns not registered are skipped.
+	*/
+	TEST_F(WorldSnapshot_test, Skipped) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		entt::registry src;
+		Fill(src, 100);
+
+		Snapshot writer;
+		RegisterAll(writer);
+		EXPECT_TRUE(writer.Save(src, m_Root + "world.swld"));
+
+		Snapshot reader;
+		RegisterAll(reader, false);
+
+		entt::registry dst;
+		Snapshot::Stats stats;
+		EXPECT_TRUE(reader.Load(dst, m_Root + "world.swld", nullptr, &stats));
+		EXPECT_EQ(stats.entities, 100);
+		EXPECT_EQ(stats.columns, 3);
+		EXPECT_EQ(stats.skipped, 1);
+		EXPECT_EQ(dst.storage<Position>().size(), 100);
+		EXPECT_EQ(dst.storage<Static>().size(), 34);
+		EXPECT_EQ(dst.storage<Name>().size(), 0);
+
+		/**
+		* @brief A column of same name but different record is not matched.
+		*/
+		Snapshot changed;
+		changed.Register<Id>("Position");
+
+		entt::registry other;
+		EXPECT_TRUE(changed.Load(other, m_Root + "world.swld", nullptr, &stats));
+		EXPECT_EQ(stats.columns, 0);
+		EXPECT_EQ(other.storage<Id>().size(), 0);
+	}
+
+	/**
+	* @brief Testing if invalid files are rejected without touching registry.
+	*/
+	TEST_F(WorldSnapshot_test, Invalid) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		entt::registry src;
+		Fill(src, 100);
+
+		Snapshot snapshot;
+		RegisterAll(snapshot);
+		EXPECT_TRUE(snapshot.Save(src, m_Root + "world.swld"));
+
+		std::string bytes;
+		{
+			std::ifstream in(m_Root + "world.swld", std::ios::binary);
+			bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		const auto write = [&](const std::string& name, const std::string& data) {
+			std::ofstream out(m_Root + name, std::ios::binary);
+			out.write(data.data(), data.size());
+		};
+
+		write("truncated.swld", bytes.substr(0, bytes.size() / 2));
+		write("header.swld",    bytes.substr(0, sizeof(Snapshot::Header) - 1));
+
+		std::string magic = bytes;
+		magic[0] = 'X';
+		write("magic.swld", magic);
+
+		std::string version = bytes;
+		reinterpret_cast<Snapshot::Header*>(version.data())->version = Snapshot::Version + 1;
+		write("version.swld", version);
+
+		std::string index = bytes;
+		{
+			const auto* header = reinterpret_cast<const Snapshot::Header*>(index.data());
+			const auto* column = reinterpret_cast<const Snapshot::ColumnHeader*>(index.data() + header->columnsOffset);
+			*reinterpret_cast<uint32_t*>(index.data() + column->entitiesOffset) = 100;
+		}
+		write("index.swld", index);
+
+		for (const char* name : { "truncated.swld", "header.swld", "magic.swld", "version.swld", "index.swld", "missing.swld" })
+		{
+			entt::registry dst;
+			EXPECT_FALSE(snapshot.Load(dst, m_Root + name)) << name;
+			EXPECT_EQ(dst.storage<entt::entity>().size(), 0) << name;
+		}
+	}
+
+	/**
+	* @brief Testing if counts of many entities are kept.
+	*/
+	TEST_F(WorldSnapshot_test, Count) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nEntities = 50000;
+
+		entt::registry src;
+		Fill(src, nEntities, false);
+
+		Snapshot snapshot;
+		RegisterAll(snapshot);
+
+		Snapshot::Stats saved;
+		EXPECT_TRUE(snapshot.Save(src, m_Root + "world.swld", &saved));
+
+		entt::registry dst;
+		Snapshot::Stats loaded;
+		EXPECT_TRUE(snapshot.Load(dst, m_Root + "world.swld", nullptr, &loaded));
+
+		EXPECT_EQ(saved.entities, nEntities);
+		EXPECT_EQ(loaded.entities, nEntities);
+		EXPECT_EQ(loaded.components, saved.components);
+		EXPECT_EQ(dst.storage<Position>().size(), src.storage<Position>().size());
+	}
+
+	/**
+	* @brief Testing load time of 1M entities.
+	* Disabled by default, run with --gtest_also_run_disabled_tests.
+	*/
+	TEST_F(WorldSnapshot_test, DISABLED_Throughput) {
+
+		SPICESTEST_PROFILE_FUNCTION();
+
+		constexpr uint32_t nEntities = 1000000;
+
+		entt::registry src;
+		Fill(src, nEntities, false);
+
+		Snapshot snapshot;
+		RegisterAll(snapshot);
+
+		Snapshot::Stats saved;
+		EXPECT_TRUE(snapshot.Save(src, m_Root + "world.swld", &saved));
+
+		entt::registry dst;
+		Snapshot::Stats loaded;
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		EXPECT_TRUE(snapshot.Load(dst, m_Root + "world.swld", nullptr, &loaded));
+		const auto end = std::chrono::high_resolution_clock::now();
+
+		const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+		std::cout << "WorldSnapshot: " << loaded.entities << " entities, " << loaded.components << " components, "
+			<< saved.bytes / 1024 / 1024 << " MB loaded in " << ms << " ms" << std::endl;
+
+		EXPECT_EQ(loaded.entities, nEntities);
+		EXPECT_EQ(dst.storage<Position>().size(), nEntities);
+
+#ifdef NDEBUG
+		EXPECT_LT(ms, 1000.0);
+#endif
+	}
+}
@@ -8,17 +8,28 @@
 #include "Instrumentor.h"
 
 /* Container */
+#include "Core/Container/BlockPool_test.h"
 #include "Core/Container/DirectedAcyclicGraph_test.h"
 #include "Core/Container/KDTree_test.h"
 #include "Core/Container/LinkedUnorderedMap_test.h"
 #include "Core/Container/RuntimeMemoryBlock_test.h"
+#include "Core/Container/RuntimeMemoryLayout_test.h"
+#include "Core/Container/TLSFAllocator_test.h"
 #include "Core/Container/Tuple_test.h"
 
+/* Memory */
+#include "Core/Memory/FrameAllocator_test.h"
+
+/* Math */
+#include "Core/Math/BatchMath_test.h"
+
 /* Thread */
 //#include "Core/Thread/ThreadPoolFixed_test.h"
 //#include "Core/Thread/ThreadPoolCached_test.h"
+#include "Core/Thread/RangeScheduler_test.h"
 
 /* Library */
+#include "Core/Library/AsyncIOService_test.h"
 #include "Core/Library/ClassLibrary_test.h"
 #include "Core/Library/FileLibrary_test.h"
 #include "Core/Library/MemoryLibrary_test.h"
@@ -28,6 +39,11 @@
 /* Delegate */
 #include "Core/Delegate/Delegate_test.h"
 
+/* Log */
+#include "Core/Log/AsyncLogger_test.h"
+#include "Core/Log/ConsoleStore_test.h"
+#include "Core/Log/ConsoleFilter_test.h"
+
 /* Reflect */
 #include "Core/Reflect/StaticReflect/VariableTraits_test.h"
 #include "Core/Reflect/StaticReflect/FunctionTraits_test.h"
@@ -37,8 +53,36 @@
 #include "Core/Reflect/StaticReflect/IsConst_test.h"
 #include "Core/Reflect/StaticReflect/RemovePointer_test.h"
 #include "Core/Reflect/StaticReflect/IsPointer_test.h"
+#include "Core/Reflect/ReflectSerializer_test.h"
+
+/* Resources */
+#include "Resources/Loader/ObjParser_test.h"
+#include "Resources/Loader/GltfImporter_test.h"
+#include "Resources/Material/MaterialCache_test.h"
+#include "Resources/VirtualFileSystem/PakArchive_test.h"
+#include "Resources/VirtualFileSystem/VirtualFileSystem_test.h"
+
+/* World */
+#include "World/Snapshot/WorldSnapshot_test.h"
+
+/* RayTracing */
+#include "Render/RayTracing/TLASInstanceTable_test.h"
+#include "Render/RayTracing/BLASRegistry_test.h"
+
+/* Lighting */
+#include "Render/Lighting/LightClusterBuilder_test.h"
+
+/* Renderer */
+#include "Render/Renderer/DrawPacket/DrawPacketList_test.h"
+#include "Render/Renderer/DrawPacket/InstanceBatcher_test.h"
+
+/* RenderGraph */
+#include "Render/RenderGraph/RenderGraph_test.h"
 
 /* Vulkan */
+#include "Render/Vulkan/BufferUploadTracker_test.h"
+#include "Render/Vulkan/DGCSequenceTable_test.h"
+#include "Render/Vulkan/SecondaryCmdCache_test.h"
 //#include "RenderAPI/Vulkan/VulkanImage_test.h"
 
 /**